@@ -66,9 +66,11 @@ compile_all="$compile_all \"$src_path/BinBoosting.cpp\""
 compile_all="$compile_all \"$src_path/BinInteraction.cpp\""
 compile_all="$compile_all \"$src_path/BinningQuantile.cpp\""
 compile_all="$compile_all \"$src_path/BinningUniform.cpp\""
+compile_all="$compile_all \"$src_path/BinningCoarse.cpp\""
 compile_all="$compile_all \"$src_path/BinningWinsorized.cpp\""
 compile_all="$compile_all \"$src_path/Booster.cpp\""
 compile_all="$compile_all \"$src_path/CalculateInteractionScore.cpp\""
+compile_all="$compile_all \"$src_path/CategoricalEncoder.cpp\""
 compile_all="$compile_all \"$src_path/CutRandom.cpp\""
 compile_all="$compile_all \"$src_path/DataSetBoosting.cpp\""
 compile_all="$compile_all \"$src_path/DataSetInteraction.cpp\""
@@ -77,16 +79,20 @@ compile_all="$compile_all \"$src_path/Discretization.cpp\""
 compile_all="$compile_all \"$src_path/FeatureGroup.cpp\""
 compile_all="$compile_all \"$src_path/FindBestBoostingSplitsPairs.cpp\""
 compile_all="$compile_all \"$src_path/FindBestInteractionGainPairs.cpp\""
+compile_all="$compile_all \"$src_path/FindBestInteractionGainTriples.cpp\""
 compile_all="$compile_all \"$src_path/GenerateModelUpdate.cpp\""
 compile_all="$compile_all \"$src_path/GrowDecisionTree.cpp\""
 compile_all="$compile_all \"$src_path/InitializeResiduals.cpp\""
 compile_all="$compile_all \"$src_path/InteractionDetector.cpp\""
 compile_all="$compile_all \"$src_path/InterpretableNumerics.cpp\""
 compile_all="$compile_all \"$src_path/Logging.cpp\""
+compile_all="$compile_all \"$src_path/ParallelWork.cpp\""
+compile_all="$compile_all \"$src_path/QuantileSketch.cpp\""
 compile_all="$compile_all \"$src_path/RandomExternal.cpp\""
 compile_all="$compile_all \"$src_path/RandomStream.cpp\""
 compile_all="$compile_all \"$src_path/SamplingSet.cpp\""
 compile_all="$compile_all \"$src_path/SegmentedTensor.cpp\""
+compile_all="$compile_all \"$src_path/StreamingBinning.cpp\""
 compile_all="$compile_all \"$src_path/SumHistogramBuckets.cpp\""
 compile_all="$compile_all \"$src_path/TensorTotalsBuild.cpp\""
 compile_all="$compile_all \"$src_path/ThreadStateBoosting.cpp\""
@@ -105,6 +111,7 @@ compile_all="$compile_all -fvisibility=hidden -fvisibility-inlines-hidden"
 compile_all="$compile_all -fno-math-errno -fno-trapping-math"
 compile_all="$compile_all -march=core2"
 compile_all="$compile_all -fpic"
+compile_all="$compile_all -pthread"
 compile_all="$compile_all -DEBM_NATIVE_EXPORTS"
 
 if [ "$os_type" = "Darwin" ]; then
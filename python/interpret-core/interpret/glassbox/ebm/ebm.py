@@ -128,7 +128,7 @@ class EBMPreprocessor(BaseEstimator, TransformerMixin):
     """ Transformer that preprocesses data to be ready before EBM. """
 
     def __init__(
-        self, feature_names=None, feature_types=None, max_bins=256, binning="quantile", missing_str=str(np.nan)
+        self, feature_names=None, feature_types=None, max_bins=256, binning="quantile", missing_str=str(np.nan), min_samples_bin=1
     ):
         """ Initializes EBM preprocessor.
 
@@ -138,12 +138,14 @@ class EBMPreprocessor(BaseEstimator, TransformerMixin):
             max_bins: Max number of bins to process numeric features.
             binning: Strategy to compute bins: "quantile", "quantile_humanized", "uniform". 
             missing_str: By default np.nan values are missing for all datatypes. Setting this parameter changes the string representation for missing
+            min_samples_bin: Min number of samples the quantile and coarse binning should try to keep in each continuous bin.
         """
         self.feature_names = feature_names
         self.feature_types = feature_types
         self.max_bins = max_bins
         self.binning = binning
         self.missing_str = missing_str
+        self.min_samples_bin = min_samples_bin
 
     def fit(self, X):
         """ Fits transformer to provided samples.
@@ -178,6 +180,40 @@ class EBMPreprocessor(BaseEstimator, TransformerMixin):
         if self.max_bins < 2:
             raise ValueError("max_bins must be 2 or higher.  One bin is required for missing, and annother for non-missing values.")
 
+        is_humanized = 1 if self.binning == 'quantile_humanized' else 0
+
+        # the continuous columns are copied once into a column-major float array, which is cut and then binned in one native 
+        # call each.  Slicing a column out of it is a contiguous view, so nothing below copies them again
+        continuous_idxs = [
+            col_idx for col_idx, col_name in enumerate(schema.keys()) 
+            if schema[col_name]["type"] == "continuous"
+        ]
+        X_cols = np.empty((X.shape[0], len(continuous_idxs)), dtype=np.float64, order="F")
+        for i, col_idx in enumerate(continuous_idxs):
+            X_cols[:, i] = X[:, col_idx]
+
+        if 0 < len(continuous_idxs):
+            if self.binning == 'quantile' or self.binning == 'quantile_humanized':
+                # sorted and cut in parallel
+                cut_results = native.generate_quantile_cuts_batch(
+                    X_cols,
+                    self.min_samples_bin,
+                    is_humanized,
+                    self.max_bins - 2, # one bin for missing, and # of cuts is one less again
+                )
+            elif self.binning == "uniform":
+                cut_results = [
+                    native.generate_uniform_cuts(
+                        X_cols[:, i], 
+                        self.max_bins - 2, # one bin for missing, and # of cuts is one less again
+                    )
+                    for i in range(len(continuous_idxs))
+                ]
+            else:
+                raise ValueError(f"Unrecognized bin type: {self.binning}")
+
+            X_cols_binned = native.discretize_matrix(X_cols, [cuts for cuts, _, _, _ in cut_results])
+
         for col_idx in range(X.shape[1]):
             col_name = list(schema.keys())[col_idx]
             self.col_names_.append(col_name)
@@ -188,42 +224,16 @@ class EBMPreprocessor(BaseEstimator, TransformerMixin):
 
             self.col_types_.append(col_info["type"])
             if col_info["type"] == "continuous":
-                col_data = col_data.astype(float)
-
-                min_samples_bin = 1 # TODO: Expose
-                is_humanized = 0
-
-                if self.binning == 'quantile' or self.binning == 'quantile_humanized':
-                    if self.binning == 'quantile_humanized':
-                        is_humanized = 1
-
-                    (
-                        cuts, 
-                        count_missing, 
-                        min_val, 
-                        max_val, 
-                    ) = native.generate_quantile_cuts(
-                        col_data, 
-                        min_samples_bin, 
-                        is_humanized, 
-                        self.max_bins - 2, # one bin for missing, and # of cuts is one less again
-                    )
-                elif self.binning == "uniform":
-                    (
-                        cuts, 
-                        count_missing, 
-                        min_val, 
-                        max_val,
-                    ) = native.generate_uniform_cuts(
-                        col_data, 
-                        self.max_bins - 2, # one bin for missing, and # of cuts is one less again
-                    )
-                else:
-                    raise ValueError(f"Unrecognized bin type: {self.binning}")
+                i = continuous_idxs.index(col_idx)
+                col_data = X_cols[:, i]
+                (
+                    cuts, 
+                    count_missing, 
+                    min_val, 
+                    max_val, 
+                ) = cut_results[i]
 
-                discretized = native.discretize(col_data, cuts)
-
-                _, bin_counts = np.unique(discretized, return_counts=True)
+                _, bin_counts = np.unique(X_cols_binned[:, i], return_counts=True)
 
                 if count_missing == 0:
                     bin_counts = np.concatenate(([0], bin_counts))
@@ -256,9 +266,55 @@ class EBMPreprocessor(BaseEstimator, TransformerMixin):
                 mapping = {val: indx + 1 for indx, val in enumerate(uniq_vals)}
                 self.col_mapping_[col_idx] = mapping
 
+        self._build_categorical_encoders()
         self.has_fitted_ = True
         return self
 
+    def _build_categorical_encoders(self):
+        # the native encoders are built once here and reused by every transform.  They hold native memory, so 
+        # __getstate__ drops them and transform rebuilds them on the first call after unpickling
+        self._free_categorical_encoders()
+
+        missing_constant = 0
+
+        native = Native.get_native_singleton()
+        encoders = {}
+        try:
+            for col_idx, col_type in enumerate(self.col_types_):
+                if col_type == "categorical":
+                    mapping = self.col_mapping_[col_idx].copy()
+
+                    if isinstance(self.missing_str, list):
+                        for val in self.missing_str:
+                            mapping[val] = missing_constant
+                    else:
+                        mapping[self.missing_str] = missing_constant
+
+                    encoders[col_idx] = native.create_categorical_encoder(
+                        np.array(list(mapping.keys()), dtype='U'),
+                        np.array(list(mapping.values()), dtype=np.int64),
+                    )
+        except:
+            for encoder in encoders.values():
+                native.free_categorical_encoder(encoder)
+            raise
+        self._categorical_encoders = encoders
+
+    def _free_categorical_encoders(self):
+        encoders = self.__dict__.pop("_categorical_encoders", None)
+        if encoders:
+            native = Native.get_native_singleton()
+            for encoder in encoders.values():
+                native.free_categorical_encoder(encoder)
+
+    def __getstate__(self):
+        state = super().__getstate__()
+        state.pop("_categorical_encoders", None)
+        return state
+
+    def __del__(self):
+        self._free_categorical_encoders()
+
     def transform(self, X):
         """ Transform on provided samples.
 
@@ -270,45 +326,104 @@ class EBMPreprocessor(BaseEstimator, TransformerMixin):
         """
         check_is_fitted(self, "has_fitted_")
 
-        missing_constant = 0
         unknown_constant = -1
 
         native = Native.get_native_singleton()
+        if not hasattr(self, "_categorical_encoders"):
+            self._build_categorical_encoders()
+
         X_new = np.copy(X)
+
+        # bin all the continuous columns in one native call instead of striding down X once per column
+        continuous_idxs = [
+            col_idx for col_idx in range(X.shape[1]) if self.col_types_[col_idx] == "continuous"
+        ]
+        if continuous_idxs:
+            # fill the float array directly, since X[:, continuous_idxs].astype(float) would copy the columns twice
+            X_cols = np.empty((X.shape[0], len(continuous_idxs)), dtype=np.float64, order="F")
+            for i, col_idx in enumerate(continuous_idxs):
+                X_cols[:, i] = X[:, col_idx]
+            X_new[:, continuous_idxs] = native.discretize_matrix(
+                X_cols,
+                [self.col_bin_edges_[col_idx] for col_idx in continuous_idxs],
+            )
+
         for col_idx in range(X.shape[1]):
             col_type = self.col_types_[col_idx]
             col_data = X[:, col_idx]
 
-            if col_type == "continuous":
-                col_data = col_data.astype(float)
-                cuts = self.col_bin_edges_[col_idx]
-
-                discretized = native.discretize(col_data, cuts)
-                
-                X_new[:, col_idx] = discretized
-
-            elif col_type == "ordinal":
+            if col_type == "ordinal":
                 mapping = self.col_mapping_[col_idx].copy()
                 vec_map = np.vectorize(
                     lambda x: mapping[x] if x in mapping else unknown_constant
                 )
                 X_new[:, col_idx] = vec_map(col_data)
             elif col_type == "categorical":
-                mapping = self.col_mapping_[col_idx].copy()
+                X_new[:, col_idx] = native.encode_categories(
+                    self._categorical_encoders[col_idx], col_data.astype('U'), unknown_constant
+                )
 
-                if isinstance(self.missing_str, list):
-                    for val in self.missing_str:
-                        mapping[val] = missing_constant
-                else:
-                    mapping[self.missing_str] = missing_constant
+        return X_new.astype(np.int64)
 
-                vec_map = np.vectorize(
-                    lambda x: mapping[x] if x in mapping else unknown_constant
+    def coarsen(self, X_binned, max_bins):
+        """ Derives a preprocessor with fewer bins by merging adjacent bins of this one.
+
+        Continuous features keep a subset of this preprocessor's cuts, chosen natively from the bin counts
+        so that the merged bins stay balanced. The raw feature values are never re-sorted or re-binned.
+        Categorical and ordinal features are unchanged.
+
+        Args:
+            X_binned: Numpy array of samples already transformed by this preprocessor.
+            max_bins: Max number of bins per continuous feature in the derived preprocessor.
+
+        Returns:
+            The derived preprocessor, and X_binned transformed into its bins.
+        """
+        check_is_fitted(self, "has_fitted_")
+
+        if max_bins < 2:
+            raise ValueError("max_bins must be 2 or higher.  One bin is required for missing, and annother for non-missing values.")
+
+        coarse = EBMPreprocessor(
+            feature_names=self.feature_names,
+            feature_types=self.feature_types,
+            max_bins=max_bins,
+            binning=self.binning,
+            missing_str=self.missing_str,
+            min_samples_bin=self.min_samples_bin,
+        )
+        coarse.col_bin_edges_ = {}
+        coarse.col_min_ = dict(self.col_min_)
+        coarse.col_max_ = dict(self.col_max_)
+        coarse.hist_counts_ = dict(self.hist_counts_)
+        coarse.hist_edges_ = dict(self.hist_edges_)
+        coarse.col_mapping_ = dict(self.col_mapping_)
+        coarse.col_bin_counts_ = list(self.col_bin_counts_)
+        coarse.col_names_ = list(self.col_names_)
+        coarse.col_types_ = list(self.col_types_)
+
+        native = Native.get_native_singleton()
+        X_new = np.copy(X_binned)
+        for col_idx, col_type in enumerate(self.col_types_):
+            if col_type == "continuous":
+                cuts, discretized = native.generate_coarse_cuts(
+                    np.ascontiguousarray(X_binned[:, col_idx], dtype=np.int64), 
+                    self.col_bin_edges_[col_idx], 
+                    self.min_samples_bin, 
+                    max_bins - 2, # one bin for missing, and # of cuts is one less again
                 )
-                col_data = col_data.astype('U')
-                X_new[:, col_idx] = vec_map(col_data)
+                X_new[:, col_idx] = discretized
+                coarse.col_bin_edges_[col_idx] = cuts
 
-        return X_new.astype(np.int64)
+                # same layout as fit: occupied bins only, with a leading zero when there are no missing values
+                _, bin_counts = np.unique(discretized, return_counts=True)
+                if self.col_bin_counts_[col_idx][0] == 0:
+                    bin_counts = np.concatenate(([0], bin_counts))
+                coarse.col_bin_counts_[col_idx] = bin_counts
+
+        coarse._build_categorical_encoders()
+        coarse.has_fitted_ = True
+        return coarse, X_new
 
     def _get_hist_counts(self, feature_index):
         col_type = self.col_types_[feature_index]
@@ -374,6 +489,8 @@ class BaseCoreEBM:
         max_rounds,
         early_stopping_tolerance,
         early_stopping_rounds,
+        schedule_gain_threshold,
+        schedule_max_skip_rounds,
         # Native
         inner_bags,
         learning_rate,
@@ -398,6 +515,8 @@ class BaseCoreEBM:
         self.max_rounds = max_rounds
         self.early_stopping_tolerance = early_stopping_tolerance
         self.early_stopping_rounds = early_stopping_rounds
+        self.schedule_gain_threshold = schedule_gain_threshold
+        self.schedule_max_skip_rounds = schedule_max_skip_rounds
 
         # Arguments for internal EBM.
         self.inner_bags = inner_bags
@@ -457,18 +576,18 @@ class BaseCoreEBM:
         self.feature_groups_ = []
         self.model_ = []
 
-        # Train main effects
-        self._fit_main(main_feature_indices, X_train, y_train, X_val, y_val)
+        # Train main effects, then build interaction terms, if required, before the main booster is freed
+        def build_interactions(booster):
+            self.inter_indices_, self.inter_scores_ = self._build_interactions(
+                X_train, y_train, X_pair_train, booster
+            )
 
-        # Build interaction terms, if required
-        self.inter_indices_, self.inter_scores_ = self._build_interactions(
-            X_train, y_train, X_pair_train
-        )
+        self._fit_main(main_feature_indices, X_train, y_train, X_val, y_val, build_interactions)
 
         self.inter_episode_idx_ = 0
         return self
 
-    def _fit_main(self, main_feature_groups, X_train, y_train, X_val, y_val):
+    def _fit_main(self, main_feature_groups, X_train, y_train, X_val, y_val, on_boosted=None):
         log.info("Train main effects")
         (
             self.model_,
@@ -496,19 +615,26 @@ class BaseCoreEBM:
             max_rounds=self.max_rounds,
             random_state=self.random_state,
             name="Main",
+            schedule_gain_threshold=self.schedule_gain_threshold,
+            schedule_max_skip_rounds=self.schedule_max_skip_rounds,
+            on_boosted=on_boosted,
         )
 
         self.feature_groups_ = main_feature_groups
 
         return
 
-    def _build_interactions(self, X_train, y_train, X_pair):
+    def _build_interactions(self, X_train, y_train, X_pair, booster=None):
         if isinstance(self.interactions, int) and self.interactions != 0:
             log.info("Estimating with FAST")
 
-            scores_train = EBMUtils.decision_function(
-                X_train, X_pair, self.feature_groups_, self.model_, self.intercept_
-            )
+            if booster is None:
+                scores_train = EBMUtils.decision_function(
+                    X_train, X_pair, self.feature_groups_, self.model_, self.intercept_
+                )
+            else:
+                # the booster's best model is self.model_, and it already holds the scores of that model on X_train
+                scores_train = None
 
             iter_feature_groups = combinations(range(X_pair.shape[0]), 2)
 
@@ -523,6 +649,7 @@ class BaseCoreEBM:
                 y=y_train,
                 scores=scores_train,
                 min_samples_leaf=self.min_samples_leaf,
+                booster=booster,
             )
         elif isinstance(self.interactions, int) and self.interactions == 0:
             final_indices = []
@@ -574,6 +701,8 @@ class BaseCoreEBM:
             max_rounds=self.max_rounds,
             random_state=self.random_state,
             name="Pair",
+            schedule_gain_threshold=self.schedule_gain_threshold,
+            schedule_max_skip_rounds=self.schedule_max_skip_rounds,
         )
 
         self.model_.extend(model_update)
@@ -658,6 +787,8 @@ class BaseEBM(BaseEstimator):
         max_rounds,
         early_stopping_tolerance,
         early_stopping_rounds,
+        schedule_gain_threshold,
+        schedule_max_skip_rounds,
         # Native
         learning_rate,
         # Holte, R. C. (1993) "Very simple classification rules perform well on most commonly used datasets"
@@ -692,6 +823,8 @@ class BaseEBM(BaseEstimator):
         self.max_rounds = max_rounds
         self.early_stopping_tolerance = early_stopping_tolerance
         self.early_stopping_rounds = early_stopping_rounds
+        self.schedule_gain_threshold = schedule_gain_threshold
+        self.schedule_max_skip_rounds = schedule_max_skip_rounds
 
         # Arguments for internal EBM.
         self.learning_rate = learning_rate
@@ -762,14 +895,18 @@ class BaseEBM(BaseEstimator):
         features_bin_count = np.array([len(x) for x in self.preprocessor_.col_bin_counts_], dtype=ct.c_int64)
 
         if self.interactions != 0:
-            self.pair_preprocessor_ = EBMPreprocessor(
-                feature_names=self.feature_names,
-                feature_types=self.feature_types,
-                max_bins=self.max_interaction_bins,
-                binning=self.binning,
-            )
-            self.pair_preprocessor_.fit(X_orig)
-            X_pair = self.pair_preprocessor_.transform(X_orig)
+            if self.binning in ("quantile", "quantile_humanized") and self.max_interaction_bins <= self.max_bins:
+                # merging adjacent main bins keeps the pair bins quantile balanced without sorting the raw data again
+                self.pair_preprocessor_, X_pair = self.preprocessor_.coarsen(X, self.max_interaction_bins)
+            else:
+                self.pair_preprocessor_ = EBMPreprocessor(
+                    feature_names=self.feature_names,
+                    feature_types=self.feature_types,
+                    max_bins=self.max_interaction_bins,
+                    binning=self.binning,
+                )
+                self.pair_preprocessor_.fit(X_orig)
+                X_pair = self.pair_preprocessor_.transform(X_orig)
             pair_features_categorical = np.array([x == "categorical" for x in self.pair_preprocessor_.col_types_], dtype=ct.c_int64)
             pair_features_bin_count = np.array([len(x) for x in self.pair_preprocessor_.col_bin_counts_], dtype=ct.c_int64)
         else:
@@ -806,6 +943,8 @@ class BaseEBM(BaseEstimator):
                     max_rounds=self.max_rounds,
                     early_stopping_tolerance=self.early_stopping_tolerance,
                     early_stopping_rounds=self.early_stopping_rounds,
+                    schedule_gain_threshold=self.schedule_gain_threshold,
+                    schedule_max_skip_rounds=self.schedule_max_skip_rounds,
                     # Native
                     inner_bags=self.inner_bags,
                     learning_rate=self.learning_rate,
@@ -834,6 +973,8 @@ class BaseEBM(BaseEstimator):
                     max_rounds=self.max_rounds,
                     early_stopping_tolerance=self.early_stopping_tolerance,
                     early_stopping_rounds=self.early_stopping_rounds,
+                    schedule_gain_threshold=self.schedule_gain_threshold,
+                    schedule_max_skip_rounds=self.schedule_max_skip_rounds,
                     # Native
                     inner_bags=self.inner_bags,
                     learning_rate=self.learning_rate,
@@ -1405,6 +1546,8 @@ class ExplainableBoostingClassifier(BaseEBM, ClassifierMixin, ExplainerMixin):
         early_stopping_rounds=50,
         early_stopping_tolerance=1e-4,
         max_rounds=5000,
+        schedule_gain_threshold=0.0,
+        schedule_max_skip_rounds=0,
         # Trees
         min_samples_leaf=2,
         max_leaves=3,
@@ -1431,6 +1574,8 @@ class ExplainableBoostingClassifier(BaseEBM, ClassifierMixin, ExplainerMixin):
             early_stopping_rounds: Number of rounds of no improvement to trigger early stopping.
             early_stopping_tolerance: Tolerance that dictates the smallest delta required to be considered an improvement.
             max_rounds: Number of rounds for boosting.
+            schedule_gain_threshold: Feature groups whose gain falls below this sit out of boosting for 1, 2, 4, ... rounds.
+            schedule_max_skip_rounds: Most rounds a feature group sits out before it is re-checked. Zero boosts every feature group every round.
             min_samples_leaf: Minimum number of cases for tree splits used in boosting.
             max_leaves: Maximum leaf nodes used in boosting.
             n_jobs: Number of jobs to run in parallel.
@@ -1456,6 +1601,8 @@ class ExplainableBoostingClassifier(BaseEBM, ClassifierMixin, ExplainerMixin):
             early_stopping_rounds=early_stopping_rounds,
             early_stopping_tolerance=early_stopping_tolerance,
             max_rounds=max_rounds,
+            schedule_gain_threshold=schedule_gain_threshold,
+            schedule_max_skip_rounds=schedule_max_skip_rounds,
             # Trees
             min_samples_leaf=min_samples_leaf,
             max_leaves=max_leaves,
@@ -1554,6 +1701,8 @@ class ExplainableBoostingRegressor(BaseEBM, RegressorMixin, ExplainerMixin):
         early_stopping_rounds=50,
         early_stopping_tolerance=1e-4,
         max_rounds=5000,
+        schedule_gain_threshold=0.0,
+        schedule_max_skip_rounds=0,
         # Trees
         min_samples_leaf=2,
         max_leaves=3,
@@ -1579,6 +1728,8 @@ class ExplainableBoostingRegressor(BaseEBM, RegressorMixin, ExplainerMixin):
             early_stopping_rounds: Number of rounds of no improvement to trigger early stopping.
             early_stopping_tolerance: Tolerance that dictates the smallest delta required to be considered an improvement.
             max_rounds: Number of rounds for boosting.
+            schedule_gain_threshold: Feature groups whose gain falls below this sit out of boosting for 1, 2, 4, ... rounds.
+            schedule_max_skip_rounds: Most rounds a feature group sits out before it is re-checked. Zero boosts every feature group every round.
             min_samples_leaf: Minimum number of cases for tree splits used in boosting.
             max_leaves: Maximum leaf nodes used in boosting.
             n_jobs: Number of jobs to run in parallel.
@@ -1604,6 +1755,8 @@ class ExplainableBoostingRegressor(BaseEBM, RegressorMixin, ExplainerMixin):
             early_stopping_rounds=early_stopping_rounds,
             early_stopping_tolerance=early_stopping_tolerance,
             max_rounds=max_rounds,
+            schedule_gain_threshold=schedule_gain_threshold,
+            schedule_max_skip_rounds=schedule_max_skip_rounds,
             # Trees
             min_samples_leaf=min_samples_leaf,
             max_leaves=max_leaves,
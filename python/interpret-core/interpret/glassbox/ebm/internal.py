@@ -22,6 +22,11 @@ class Native:
     GenerateUpdateOptions_GradientSums          = 0x0000000000000004
     GenerateUpdateOptions_RandomSplits          = 0x0000000000000008
 
+    # CategoryTypeType
+    CategoryType_Int64 = 0
+    CategoryType_Float64 = 1
+    CategoryType_Bytes = 2
+
     # TraceLevel
     _TraceLevelOff = 0
     _TraceLevelError = 1
@@ -141,6 +146,238 @@ class Native:
 
         return cuts, count_missing, min_val, max_val
 
+    def generate_quantile_cuts_resolutions(
+        self, 
+        col_data, 
+        min_samples_bin, 
+        is_humanized, 
+        max_cuts_list, 
+    ):
+        """ Sorts col_data once and generates a set of quantile cuts for each entry of max_cuts_list.
+
+        Returns (cuts_list, count_missing, min_val, max_val) where cuts_list[i] matches the cuts that
+        generate_quantile_cuts returns for max_cuts_list[i].
+        """
+        count_cuts = np.array(max_cuts_list, dtype=np.int64)
+        # resolution i writes its cuts after the space requested by the resolutions before it
+        offsets = np.concatenate(([0], np.cumsum(count_cuts)))
+        cuts = np.empty(max(int(offsets[-1]), 1), dtype=np.float64, order="C")
+        count_missing = ct.c_int64(0)
+        min_val = ct.c_double(0)
+        count_neg_inf = ct.c_int64(0)
+        max_val = ct.c_double(0)
+        count_inf = ct.c_int64(0)
+
+        return_code = self._unsafe.GenerateQuantileCutsResolutions(
+            col_data.shape[0],
+            col_data, 
+            min_samples_bin,
+            is_humanized,
+            count_cuts.shape[0],
+            count_cuts,
+            cuts,
+            ct.byref(count_missing),
+            ct.byref(min_val),
+            ct.byref(count_neg_inf),
+            ct.byref(max_val),
+            ct.byref(count_inf)
+        )
+
+        if return_code != 0:  # pragma: no cover
+            raise Exception("Out of memory in GenerateQuantileCutsResolutions")
+
+        cuts_list = [
+            cuts[offsets[i]:offsets[i] + count_cuts[i]].copy() for i in range(count_cuts.shape[0])
+        ]
+        return cuts_list, count_missing.value, min_val.value, max_val.value
+
+    def generate_quantile_cuts_batch(
+        self, 
+        X_cols, 
+        min_samples_bin, 
+        is_humanized, 
+        max_cuts, 
+    ):
+        """ Bins every column of the 2D float array X_cols in one native call. The native side starts a bounded pool of
+        workers (no more than the hardware threads, nor the number of columns) and each worker pulls the next column from
+        a shared counter until none are left.
+
+        X_cols is used without copying if it is already a Fortran-ordered float64 array, otherwise it is copied once.
+
+        Returns a list with a (cuts, count_missing, min_val, max_val) tuple per column, the same as generate_quantile_cuts.
+        """
+        n_samples, n_features = X_cols.shape
+        # column-major lets each native worker copy its column with a single memcpy.  ravel(order="F") of a Fortran 
+        # ordered array is a view, so this is at most one copy of the data
+        feature_values = np.asfortranarray(X_cols, dtype=np.float64).ravel(order="F")
+        min_samples_bins = np.full(n_features, min_samples_bin, dtype=np.int64)
+        count_cuts = np.full(n_features, max_cuts, dtype=np.int64)
+        cuts = np.empty(max(n_features * max_cuts, 1), dtype=np.float64, order="C")
+        count_missing = np.empty(n_features, dtype=np.int64)
+        min_vals = np.empty(n_features, dtype=np.float64)
+        count_neg_inf = np.empty(n_features, dtype=np.int64)
+        max_vals = np.empty(n_features, dtype=np.float64)
+        count_inf = np.empty(n_features, dtype=np.int64)
+
+        return_code = self._unsafe.GenerateQuantileCutsBatch(
+            n_samples,
+            n_features,
+            feature_values,
+            1,
+            min_samples_bins,
+            is_humanized,
+            count_cuts,
+            cuts,
+            count_missing,
+            min_vals,
+            count_neg_inf,
+            max_vals,
+            count_inf,
+        )
+
+        if return_code != 0:  # pragma: no cover
+            raise Exception("Out of memory in GenerateQuantileCutsBatch")
+
+        # each column's cuts start max_cuts after the previous column's
+        return [
+            (
+                cuts[i * max_cuts:i * max_cuts + count_cuts[i]].copy(),
+                int(count_missing[i]),
+                float(min_vals[i]),
+                float(max_vals[i]),
+            )
+            for i in range(n_features)
+        ]
+
+    def create_quantile_sketch(self, random_state, items_per_level_max=0):
+        """ Returns a handle to a native quantile sketch, which must be released with free_quantile_sketch.
+
+        items_per_level_max trades memory for accuracy, and 0 selects the native default.
+        """
+        handle = self._unsafe.CreateQuantileSketch(random_state, items_per_level_max)
+        if not handle:  # pragma: no cover
+            raise Exception("Out of memory in CreateQuantileSketch")
+        return handle
+
+    def add_to_quantile_sketch(self, handle, col_data):
+        col_data = np.ascontiguousarray(col_data, dtype=np.float64)
+        return_code = self._unsafe.AddToQuantileSketch(handle, col_data.shape[0], col_data)
+        if return_code != 0:  # pragma: no cover
+            raise Exception("Out of memory in AddToQuantileSketch")
+
+    def merge_quantile_sketch(self, handle_into, handle_from):
+        return_code = self._unsafe.MergeQuantileSketch(handle_into, handle_from)
+        if return_code != 0:  # pragma: no cover
+            raise Exception("Out of memory in MergeQuantileSketch")
+
+    def generate_quantile_cuts_from_sketch(
+        self, 
+        handle, 
+        min_samples_bin, 
+        is_humanized, 
+        max_cuts, 
+    ):
+        cuts = np.empty(max(max_cuts, 1), dtype=np.float64, order="C")
+        count_cuts = ct.c_int64(max_cuts)
+        count_missing = ct.c_int64(0)
+        min_val = ct.c_double(0)
+        count_neg_inf = ct.c_int64(0)
+        max_val = ct.c_double(0)
+        count_inf = ct.c_int64(0)
+
+        return_code = self._unsafe.GenerateQuantileCutsFromSketch(
+            handle,
+            min_samples_bin,
+            is_humanized,
+            ct.byref(count_cuts),
+            cuts,
+            ct.byref(count_missing),
+            ct.byref(min_val),
+            ct.byref(count_neg_inf),
+            ct.byref(max_val),
+            ct.byref(count_inf)
+        )
+
+        if return_code != 0:  # pragma: no cover
+            raise Exception("Out of memory in GenerateQuantileCutsFromSketch")
+
+        cuts = cuts[:count_cuts.value]
+        count_missing = count_missing.value
+        min_val = min_val.value
+        max_val = max_val.value
+
+        return cuts, count_missing, min_val, max_val
+
+    def free_quantile_sketch(self, handle):
+        self._unsafe.FreeQuantileSketch(handle)
+
+    def begin_streaming_binning(self, n_features, random_state, items_per_level_max=0):
+        """ Returns a handle that accumulates binning statistics for n_features columns over many chunks.
+
+        Release it with free_streaming_binning.
+        """
+        handle = self._unsafe.BeginStreamingBinning(random_state, n_features, items_per_level_max)
+        if not handle:  # pragma: no cover
+            raise Exception("Out of memory in BeginStreamingBinning")
+        return handle
+
+    def add_streaming_binning_chunk(self, handle, X_chunk):
+        n_samples = X_chunk.shape[0]
+        # row-major avoids a transpose in python.  The native workers gather each column themselves
+        feature_values = np.ascontiguousarray(X_chunk, dtype=np.float64).ravel()
+        return_code = self._unsafe.AddStreamingBinningChunk(handle, n_samples, feature_values, 0)
+        if return_code != 0:  # pragma: no cover
+            raise Exception("Out of memory in AddStreamingBinningChunk")
+
+    def _finish_streaming_cuts(self, func, args, max_cuts):
+        cuts = np.empty(max(max_cuts, 1), dtype=np.float64, order="C")
+        count_cuts = ct.c_int64(max_cuts)
+        count_missing = ct.c_int64(0)
+        min_val = ct.c_double(0)
+        count_neg_inf = ct.c_int64(0)
+        max_val = ct.c_double(0)
+        count_inf = ct.c_int64(0)
+
+        return_code = func(
+            *args,
+            ct.byref(count_cuts),
+            cuts,
+            ct.byref(count_missing),
+            ct.byref(min_val),
+            ct.byref(count_neg_inf),
+            ct.byref(max_val),
+            ct.byref(count_inf)
+        )
+
+        if return_code != 0:  # pragma: no cover
+            raise Exception("Out of memory in " + func.__name__)
+
+        return cuts[:count_cuts.value], count_missing.value, min_val.value, max_val.value
+
+    def finish_streaming_quantile_cuts(self, handle, feature_idx, min_samples_bin, is_humanized, max_cuts):
+        return self._finish_streaming_cuts(
+            self._unsafe.FinishStreamingQuantileCuts,
+            (handle, feature_idx, min_samples_bin, is_humanized),
+            max_cuts,
+        )
+
+    def finish_streaming_uniform_cuts(self, handle, feature_idx, max_cuts):
+        return self._finish_streaming_cuts(
+            self._unsafe.FinishStreamingUniformCuts,
+            (handle, feature_idx),
+            max_cuts,
+        )
+
+    def finish_streaming_winsorized_cuts(self, handle, feature_idx, max_cuts):
+        return self._finish_streaming_cuts(
+            self._unsafe.FinishStreamingWinsorizedCuts,
+            (handle, feature_idx),
+            max_cuts,
+        )
+
+    def free_streaming_binning(self, handle):
+        self._unsafe.FreeStreamingBinning(handle)
+
     def generate_uniform_cuts(
         self, 
         col_data, 
@@ -173,6 +410,35 @@ class Native:
 
         return cuts, count_missing, min_val, max_val
 
+    def generate_coarse_cuts(
+        self, 
+        discretized, 
+        cuts, 
+        min_samples_bin, 
+        max_cuts, 
+    ):
+        coarse_cuts = np.empty(max_cuts, dtype=np.float64, order="C")
+        count_coarse_cuts = ct.c_int64(max_cuts)
+        coarse_discretized = np.empty(discretized.shape[0], dtype=np.int64, order="C")
+
+        return_code = self._unsafe.GenerateCoarseCuts(
+            discretized.shape[0],
+            discretized, 
+            cuts.shape[0],
+            cuts,
+            min_samples_bin,
+            ct.byref(count_coarse_cuts),
+            coarse_cuts,
+            coarse_discretized
+        )
+
+        if return_code != 0:  # pragma: no cover
+            raise Exception("Out of memory in GenerateCoarseCuts")
+
+        coarse_cuts = coarse_cuts[:count_coarse_cuts.value]
+
+        return coarse_cuts, coarse_discretized
+
     def discretize(
         self, 
         col_data, 
@@ -192,6 +458,103 @@ class Native:
 
         return discretized
 
+    def discretize_matrix(
+        self, 
+        X, 
+        cuts_list, 
+        dtype=np.int64, 
+    ):
+        # bins every column of X against its own cuts in a single native call, which is much faster than calling
+        # discretize per column on C ordered data.  Returns an array shaped like X in the requested dtype
+        dtype = np.dtype(dtype)
+        if dtype not in (np.uint8, np.uint16, np.uint32, np.int64):
+            raise ValueError("dtype must be one of uint8, uint16, uint32 or int64")
+
+        n_samples, n_features = X.shape
+        is_column_major = X.flags.f_contiguous and not X.flags.c_contiguous
+        if is_column_major:
+            feature_values = np.asfortranarray(X, dtype=np.float64).ravel(order="F")
+        else:
+            feature_values = np.ascontiguousarray(X, dtype=np.float64).ravel()
+
+        count_cuts = np.array([len(cuts) for cuts in cuts_list], dtype=np.int64)
+        if count_cuts.sum() == 0:
+            cuts = np.zeros(1, dtype=np.float64)
+        else:
+            cuts = np.concatenate([np.asarray(c, dtype=np.float64) for c in cuts_list])
+
+        # the native code writes each feature's bins contiguously, so the transpose below is a free view
+        discretized = np.empty((n_features, n_samples), dtype=dtype, order="C")
+        return_code = self._unsafe.DiscretizeMatrix(
+            n_samples,
+            n_features,
+            feature_values,
+            1 if is_column_major else 0,
+            count_cuts,
+            cuts,
+            dtype.itemsize,
+            discretized
+        )
+
+        if return_code != 0:  # pragma: no cover
+            raise Exception("Out of memory or too many cuts for dtype in DiscretizeMatrix")
+
+        return discretized.T
+
+    @staticmethod
+    def _to_category_array(arr):
+        # numeric categories are hashed by their 8 byte representation, and everything else is hashed
+        # as fixed width strings where the native code ignores the trailing zero padding
+        arr = np.asarray(arr)
+        if arr.dtype.kind in "iub":
+            return Native.CategoryType_Int64, np.ascontiguousarray(arr, dtype=np.int64)
+        if arr.dtype.kind == "f":
+            return Native.CategoryType_Float64, np.ascontiguousarray(arr, dtype=np.float64)
+        if arr.dtype.kind not in "US":
+            arr = arr.astype("U")
+        return Native.CategoryType_Bytes, np.ascontiguousarray(arr)
+
+    def create_categorical_encoder(self, categories, bin_indexes):
+        # returns a handle that maps each category to its bin index.  Release it with free_categorical_encoder.
+        category_type, categories = Native._to_category_array(categories)
+        bin_indexes = np.ascontiguousarray(bin_indexes, dtype=np.int64)
+        if categories.shape[0] != bin_indexes.shape[0]:
+            raise ValueError("categories and bin_indexes must have the same length")
+
+        handle = self._unsafe.CreateCategoricalEncoder(
+            category_type,
+            categories.dtype.itemsize,
+            categories.shape[0],
+            categories.ctypes.data if categories.shape[0] != 0 else None,
+            bin_indexes
+        )
+        if not handle:  # pragma: no cover
+            raise Exception("Out of memory in CreateCategoricalEncoder")
+
+        return handle
+
+    def encode_categories(self, handle, values, unknown_bin_index):
+        # values must be of the same kind (integer, float or string) as the categories the encoder was created with
+        _, values = Native._to_category_array(values)
+
+        bin_indexes = np.empty(values.shape[0], dtype=np.int64, order="C")
+        return_code = self._unsafe.EncodeCategories(
+            handle,
+            values.shape[0],
+            values.dtype.itemsize,
+            values.ctypes.data if values.shape[0] != 0 else None,
+            unknown_bin_index,
+            bin_indexes
+        )
+
+        if return_code != 0:  # pragma: no cover
+            raise Exception("Mismatched value type in EncodeCategories")
+
+        return bin_indexes
+
+    def free_categorical_encoder(self, handle):
+        self._unsafe.FreeCategoricalEncoder(handle)
+
 
     @staticmethod
     def _get_ebm_lib_path(debug=False):
@@ -293,6 +656,216 @@ class Native:
         ]
         self._unsafe.GenerateQuantileCuts.restype = ct.c_int64
 
+        self._unsafe.GenerateQuantileCutsResolutions.argtypes = [
+            # int64_t countSamples
+            ct.c_int64,
+            # double * featureValues
+            ndpointer(dtype=ct.c_double, ndim=1, flags="C_CONTIGUOUS"),
+            # int64_t countSamplesPerBinMin
+            ct.c_int64,
+            # int64_t isHumanized
+            ct.c_int64,
+            # int64_t countResolutions
+            ct.c_int64,
+            # int64_t * countCutsInOut
+            ndpointer(dtype=ct.c_int64, ndim=1, flags="C_CONTIGUOUS"),
+            # double * cutsLowerBoundInclusiveOut
+            ndpointer(dtype=ct.c_double, ndim=1, flags="C_CONTIGUOUS"),
+            # int64_t * countMissingValuesOut
+            ct.POINTER(ct.c_int64),
+            # double * minNonInfinityValueOut
+            ct.POINTER(ct.c_double),
+            # int64_t * countNegativeInfinityOut
+            ct.POINTER(ct.c_int64),
+            # double * maxNonInfinityValueOut
+            ct.POINTER(ct.c_double),
+            # int64_t * countPositiveInfinityOut
+            ct.POINTER(ct.c_int64),
+        ]
+        self._unsafe.GenerateQuantileCutsResolutions.restype = ct.c_int64
+
+        self._unsafe.GenerateQuantileCutsBatch.argtypes = [
+            # int64_t countSamples
+            ct.c_int64,
+            # int64_t countFeatures
+            ct.c_int64,
+            # double * featureValues
+            ndpointer(dtype=ct.c_double, ndim=1, flags="C_CONTIGUOUS"),
+            # int64_t isColumnMajor
+            ct.c_int64,
+            # int64_t * countSamplesPerBinMin
+            ndpointer(dtype=ct.c_int64, ndim=1, flags="C_CONTIGUOUS"),
+            # int64_t isHumanized
+            ct.c_int64,
+            # int64_t * countCutsInOut
+            ndpointer(dtype=ct.c_int64, ndim=1, flags="C_CONTIGUOUS"),
+            # double * cutsLowerBoundInclusiveOut
+            ndpointer(dtype=ct.c_double, ndim=1, flags="C_CONTIGUOUS"),
+            # int64_t * countMissingValuesOut
+            ndpointer(dtype=ct.c_int64, ndim=1, flags="C_CONTIGUOUS"),
+            # double * minNonInfinityValueOut
+            ndpointer(dtype=ct.c_double, ndim=1, flags="C_CONTIGUOUS"),
+            # int64_t * countNegativeInfinityOut
+            ndpointer(dtype=ct.c_int64, ndim=1, flags="C_CONTIGUOUS"),
+            # double * maxNonInfinityValueOut
+            ndpointer(dtype=ct.c_double, ndim=1, flags="C_CONTIGUOUS"),
+            # int64_t * countPositiveInfinityOut
+            ndpointer(dtype=ct.c_int64, ndim=1, flags="C_CONTIGUOUS"),
+        ]
+        self._unsafe.GenerateQuantileCutsBatch.restype = ct.c_int64
+
+        self._unsafe.CreateQuantileSketch.argtypes = [
+            # int32_t randomSeed
+            ct.c_int32,
+            # int64_t countItemsPerLevelMax
+            ct.c_int64,
+        ]
+        self._unsafe.CreateQuantileSketch.restype = ct.c_void_p
+
+        self._unsafe.AddToQuantileSketch.argtypes = [
+            # void * quantileSketchHandle
+            ct.c_void_p,
+            # int64_t countSamples
+            ct.c_int64,
+            # double * featureValues
+            ndpointer(dtype=ct.c_double, ndim=1, flags="C_CONTIGUOUS"),
+        ]
+        self._unsafe.AddToQuantileSketch.restype = ct.c_int64
+
+        self._unsafe.MergeQuantileSketch.argtypes = [
+            # void * quantileSketchHandleInto
+            ct.c_void_p,
+            # void * quantileSketchHandleFrom
+            ct.c_void_p,
+        ]
+        self._unsafe.MergeQuantileSketch.restype = ct.c_int64
+
+        self._unsafe.GenerateQuantileCutsFromSketch.argtypes = [
+            # void * quantileSketchHandle
+            ct.c_void_p,
+            # int64_t countSamplesPerBinMin
+            ct.c_int64,
+            # int64_t isHumanized
+            ct.c_int64,
+            # int64_t * countCutsInOut
+            ct.POINTER(ct.c_int64),
+            # double * cutsLowerBoundInclusiveOut
+            ndpointer(dtype=ct.c_double, ndim=1, flags="C_CONTIGUOUS"),
+            # int64_t * countMissingValuesOut
+            ct.POINTER(ct.c_int64),
+            # double * minNonInfinityValueOut
+            ct.POINTER(ct.c_double),
+            # int64_t * countNegativeInfinityOut
+            ct.POINTER(ct.c_int64),
+            # double * maxNonInfinityValueOut
+            ct.POINTER(ct.c_double),
+            # int64_t * countPositiveInfinityOut
+            ct.POINTER(ct.c_int64),
+        ]
+        self._unsafe.GenerateQuantileCutsFromSketch.restype = ct.c_int64
+
+        self._unsafe.FreeQuantileSketch.argtypes = [
+            # void * quantileSketchHandle
+            ct.c_void_p
+        ]
+
+        self._unsafe.BeginStreamingBinning.argtypes = [
+            # int32_t randomSeed
+            ct.c_int32,
+            # int64_t countFeatures
+            ct.c_int64,
+            # int64_t countItemsPerLevelMax
+            ct.c_int64,
+        ]
+        self._unsafe.BeginStreamingBinning.restype = ct.c_void_p
+
+        self._unsafe.AddStreamingBinningChunk.argtypes = [
+            # void * streamingBinningHandle
+            ct.c_void_p,
+            # int64_t countSamples
+            ct.c_int64,
+            # double * featureValues
+            ndpointer(dtype=ct.c_double, ndim=1, flags="C_CONTIGUOUS"),
+            # int64_t isColumnMajor
+            ct.c_int64,
+        ]
+        self._unsafe.AddStreamingBinningChunk.restype = ct.c_int64
+
+        self._unsafe.FinishStreamingQuantileCuts.argtypes = [
+            # void * streamingBinningHandle
+            ct.c_void_p,
+            # int64_t indexFeature
+            ct.c_int64,
+            # int64_t countSamplesPerBinMin
+            ct.c_int64,
+            # int64_t isHumanized
+            ct.c_int64,
+            # int64_t * countCutsInOut
+            ct.POINTER(ct.c_int64),
+            # double * cutsLowerBoundInclusiveOut
+            ndpointer(dtype=ct.c_double, ndim=1, flags="C_CONTIGUOUS"),
+            # int64_t * countMissingValuesOut
+            ct.POINTER(ct.c_int64),
+            # double * minNonInfinityValueOut
+            ct.POINTER(ct.c_double),
+            # int64_t * countNegativeInfinityOut
+            ct.POINTER(ct.c_int64),
+            # double * maxNonInfinityValueOut
+            ct.POINTER(ct.c_double),
+            # int64_t * countPositiveInfinityOut
+            ct.POINTER(ct.c_int64),
+        ]
+        self._unsafe.FinishStreamingQuantileCuts.restype = ct.c_int64
+
+        self._unsafe.FinishStreamingUniformCuts.argtypes = [
+            # void * streamingBinningHandle
+            ct.c_void_p,
+            # int64_t indexFeature
+            ct.c_int64,
+            # int64_t * countCutsInOut
+            ct.POINTER(ct.c_int64),
+            # double * cutsLowerBoundInclusiveOut
+            ndpointer(dtype=ct.c_double, ndim=1, flags="C_CONTIGUOUS"),
+            # int64_t * countMissingValuesOut
+            ct.POINTER(ct.c_int64),
+            # double * minNonInfinityValueOut
+            ct.POINTER(ct.c_double),
+            # int64_t * countNegativeInfinityOut
+            ct.POINTER(ct.c_int64),
+            # double * maxNonInfinityValueOut
+            ct.POINTER(ct.c_double),
+            # int64_t * countPositiveInfinityOut
+            ct.POINTER(ct.c_int64),
+        ]
+        self._unsafe.FinishStreamingUniformCuts.restype = ct.c_int64
+
+        self._unsafe.FinishStreamingWinsorizedCuts.argtypes = [
+            # void * streamingBinningHandle
+            ct.c_void_p,
+            # int64_t indexFeature
+            ct.c_int64,
+            # int64_t * countCutsInOut
+            ct.POINTER(ct.c_int64),
+            # double * cutsLowerBoundInclusiveOut
+            ndpointer(dtype=ct.c_double, ndim=1, flags="C_CONTIGUOUS"),
+            # int64_t * countMissingValuesOut
+            ct.POINTER(ct.c_int64),
+            # double * minNonInfinityValueOut
+            ct.POINTER(ct.c_double),
+            # int64_t * countNegativeInfinityOut
+            ct.POINTER(ct.c_int64),
+            # double * maxNonInfinityValueOut
+            ct.POINTER(ct.c_double),
+            # int64_t * countPositiveInfinityOut
+            ct.POINTER(ct.c_int64),
+        ]
+        self._unsafe.FinishStreamingWinsorizedCuts.restype = ct.c_int64
+
+        self._unsafe.FreeStreamingBinning.argtypes = [
+            # void * streamingBinningHandle
+            ct.c_void_p
+        ]
+
         self._unsafe.GenerateUniformCuts.argtypes = [
             # int64_t countSamples
             ct.c_int64,
@@ -337,6 +910,26 @@ class Native:
         ]
         self._unsafe.GenerateWinsorizedCuts.restype = ct.c_int64
 
+        self._unsafe.GenerateCoarseCuts.argtypes = [
+            # int64_t countSamples
+            ct.c_int64,
+            # int64_t * discretized
+            ndpointer(dtype=ct.c_int64, ndim=1, flags="C_CONTIGUOUS"),
+            # int64_t countCuts
+            ct.c_int64,
+            # double * cutsLowerBoundInclusive
+            ndpointer(dtype=ct.c_double, ndim=1, flags="C_CONTIGUOUS"),
+            # int64_t countSamplesPerBinMin
+            ct.c_int64,
+            # int64_t * countCoarseCutsInOut
+            ct.POINTER(ct.c_int64),
+            # double * coarseCutsLowerBoundInclusiveOut
+            ndpointer(dtype=ct.c_double, ndim=1, flags="C_CONTIGUOUS"),
+            # int64_t * coarseDiscretizedOut
+            ndpointer(dtype=ct.c_int64, ndim=1, flags="C_CONTIGUOUS"),
+        ]
+        self._unsafe.GenerateCoarseCuts.restype = ct.c_int64
+
 
         self._unsafe.SuggestGraphBounds.argtypes = [
             # int64_t countCuts
@@ -369,7 +962,62 @@ class Native:
             # int64_t * discretizedOut
             ndpointer(dtype=ct.c_int64, ndim=1, flags="C_CONTIGUOUS"),
         ]
-        self._unsafe.Discretize.restype = ct.c_int64
+        self._unsafe.Discretize.restype = ct.c_int64
+
+        self._unsafe.DiscretizeMatrix.argtypes = [
+            # int64_t countSamples
+            ct.c_int64,
+            # int64_t countFeatures
+            ct.c_int64,
+            # double * featureValues
+            ndpointer(dtype=ct.c_double, ndim=1, flags="C_CONTIGUOUS"),
+            # int64_t isColumnMajor
+            ct.c_int64,
+            # int64_t * countCutsPerFeature
+            ndpointer(dtype=ct.c_int64, ndim=1, flags="C_CONTIGUOUS"),
+            # double * cutsLowerBoundInclusive
+            ndpointer(dtype=ct.c_double, ndim=1, flags="C_CONTIGUOUS"),
+            # int64_t countBytesPerBinIndex
+            ct.c_int64,
+            # void * discretizedOut
+            ndpointer(ndim=2, flags="C_CONTIGUOUS"),
+        ]
+        self._unsafe.DiscretizeMatrix.restype = ct.c_int64
+
+        self._unsafe.CreateCategoricalEncoder.argtypes = [
+            # int64_t categoryType
+            ct.c_int64,
+            # int64_t countBytesPerCategory
+            ct.c_int64,
+            # int64_t countCategories
+            ct.c_int64,
+            # void * categories
+            ct.c_void_p,
+            # int64_t * binIndexes
+            ndpointer(dtype=ct.c_int64, ndim=1, flags="C_CONTIGUOUS"),
+        ]
+        self._unsafe.CreateCategoricalEncoder.restype = ct.c_void_p
+
+        self._unsafe.EncodeCategories.argtypes = [
+            # void * categoricalEncoderHandle
+            ct.c_void_p,
+            # int64_t countSamples
+            ct.c_int64,
+            # int64_t countBytesPerValue
+            ct.c_int64,
+            # void * values
+            ct.c_void_p,
+            # int64_t unknownBinIndex
+            ct.c_int64,
+            # int64_t * binIndexesOut
+            ndpointer(dtype=ct.c_int64, ndim=1, flags="C_CONTIGUOUS"),
+        ]
+        self._unsafe.EncodeCategories.restype = ct.c_int64
+
+        self._unsafe.FreeCategoricalEncoder.argtypes = [
+            # void * categoricalEncoderHandle
+            ct.c_void_p
+        ]
 
 
         self._unsafe.Softmax.argtypes = [
@@ -553,6 +1201,42 @@ class Native:
         ]
         self._unsafe.GetCurrentModelFeatureGroup.restype = ct.c_int64
 
+        self._unsafe.SetCoarseBinSchedule.argtypes = [
+            # void * boosterHandle
+            ct.c_void_p,
+            # int64_t countRoundsCoarse
+            ct.c_int64,
+            # int64_t countBinsCoarseMax
+            ct.c_int64,
+        ]
+        self._unsafe.SetCoarseBinSchedule.restype = ct.c_int64
+
+        self._unsafe.SetFeatureGroupSchedule.argtypes = [
+            # void * boosterHandle
+            ct.c_void_p,
+            # double gainThreshold
+            ct.c_double,
+            # int64_t countRoundsSkipMax
+            ct.c_int64,
+        ]
+        self._unsafe.SetFeatureGroupSchedule.restype = ct.c_int64
+
+        self._unsafe.GetScheduledFeatureGroups.argtypes = [
+            # void * boosterHandle
+            ct.c_void_p,
+            # int64_t * countFeatureGroupsOut
+            ct.POINTER(ct.c_int64),
+            # int64_t * featureGroupIndexesOut
+            ndpointer(dtype=ct.c_int64, flags="C_CONTIGUOUS"),
+        ]
+        self._unsafe.GetScheduledFeatureGroups.restype = ct.c_int64
+
+        self._unsafe.AdvanceFeatureGroupSchedule.argtypes = [
+            # void * boosterHandle
+            ct.c_void_p,
+        ]
+        self._unsafe.AdvanceFeatureGroupSchedule.restype = ct.c_int64
+
         self._unsafe.FreeBooster.argtypes = [
             # void * boosterHandle
             ct.c_void_p
@@ -622,6 +1306,25 @@ class Native:
         ]
         self._unsafe.CreateRegressionInteractionDetector.restype = ct.c_void_p
 
+        self._unsafe.CreateInteractionDetectorFromBooster.argtypes = [
+            # void * boosterHandle
+            ct.c_void_p,
+            # int64_t useBestModel
+            ct.c_int64,
+            # int64_t countFeatures
+            ct.c_int64,
+            # int64_t * featuresCategorical
+            # these three are optional, so we pass their addresses or None
+            ct.c_void_p,
+            # int64_t * featuresBinCount
+            ct.c_void_p,
+            # int64_t * binnedData
+            ct.c_void_p,
+            # double * optionalTempParams
+            ct.POINTER(ct.c_double),
+        ]
+        self._unsafe.CreateInteractionDetectorFromBooster.restype = ct.c_void_p
+
         self._unsafe.CalculateInteractionScore.argtypes = [
             # void * interactionDetectorHandle
             ct.c_void_p,
@@ -636,12 +1339,140 @@ class Native:
         ]
         self._unsafe.CalculateInteractionScore.restype = ct.c_int64
 
+        self._unsafe.CalculateInteractionScoreThreadState.argtypes = [
+            # void * threadStateInteractionHandle
+            ct.c_void_p,
+            # int64_t countFeaturesInGroup
+            ct.c_int64,
+            # int64_t * featureIndexes
+            ndpointer(dtype=ct.c_int64, ndim=1),
+            # int64_t countSamplesRequiredForChildSplitMin
+            ct.c_int64,
+            # double * interactionScoreOut
+            ct.POINTER(ct.c_double),
+        ]
+        self._unsafe.CalculateInteractionScoreThreadState.restype = ct.c_int64
+
+        self._unsafe.CalculateInteractionScores.argtypes = [
+            # void * interactionDetectorHandle
+            ct.c_void_p,
+            # int64_t countFeatureGroups
+            ct.c_int64,
+            # int64_t countFeaturesInGroup
+            ct.c_int64,
+            # int64_t * featureIndexes
+            ndpointer(dtype=ct.c_int64, ndim=1),
+            # int64_t countSamplesRequiredForChildSplitMin
+            ct.c_int64,
+            # int64_t countFeatureGroupsTop
+            ct.c_int64,
+            # double * interactionScoresOut
+            ndpointer(dtype=ct.c_double, ndim=1, flags="C_CONTIGUOUS"),
+            # int64_t * featureGroupIndexesOut
+            ndpointer(dtype=ct.c_int64, ndim=1, flags="C_CONTIGUOUS"),
+        ]
+        self._unsafe.CalculateInteractionScores.restype = ct.c_int64
+
+        self._unsafe.CalculateInteractionScoresApproximate.argtypes = [
+            # void * interactionDetectorHandle
+            ct.c_void_p,
+            # int64_t countFeatureGroups
+            ct.c_int64,
+            # int64_t countFeaturesInGroup
+            ct.c_int64,
+            # int64_t * featureIndexes
+            ndpointer(dtype=ct.c_int64, ndim=1),
+            # int64_t countSamplesRequiredForChildSplitMin
+            ct.c_int64,
+            # int32_t randomSeed
+            ct.c_int32,
+            # int64_t countSamplesScreen
+            ct.c_int64,
+            # int64_t countFeatureGroupsRefine
+            ct.c_int64,
+            # int64_t countFeatureGroupsTop
+            ct.c_int64,
+            # double * interactionScoresOut
+            ndpointer(dtype=ct.c_double, ndim=1, flags="C_CONTIGUOUS"),
+            # int64_t * featureGroupIndexesOut
+            ndpointer(dtype=ct.c_int64, ndim=1, flags="C_CONTIGUOUS"),
+        ]
+        self._unsafe.CalculateInteractionScoresApproximate.restype = ct.c_int64
+
+        self._unsafe.CalculateInteractionScoresPruned.argtypes = [
+            # void * interactionDetectorHandle
+            ct.c_void_p,
+            # int64_t countFeatureGroups
+            ct.c_int64,
+            # int64_t countFeaturesInGroup
+            ct.c_int64,
+            # int64_t * featureIndexes
+            ndpointer(dtype=ct.c_int64, ndim=1),
+            # int64_t countSamplesRequiredForChildSplitMin
+            ct.c_int64,
+            # int64_t countFeatureGroupsTop
+            ct.c_int64,
+            # double * interactionScoresOut
+            ndpointer(dtype=ct.c_double, ndim=1, flags="C_CONTIGUOUS"),
+            # int64_t * featureGroupIndexesOut
+            ndpointer(dtype=ct.c_int64, ndim=1, flags="C_CONTIGUOUS"),
+            # int64_t * countFeatureGroupsSkippedOut
+            ct.POINTER(ct.c_int64),
+            # int64_t * countFeatureGroupsPrunedOut
+            ct.POINTER(ct.c_int64),
+        ]
+        self._unsafe.CalculateInteractionScoresPruned.restype = ct.c_int64
+
+        self._unsafe.CalculateInteractionScoresTriples.argtypes = [
+            # void * interactionDetectorHandle
+            ct.c_void_p,
+            # int64_t countPairs
+            ct.c_int64,
+            # int64_t * pairFeatureIndexes
+            ndpointer(dtype=ct.c_int64, ndim=1),
+            # int64_t countSamplesRequiredForChildSplitMin
+            ct.c_int64,
+            # int64_t countTriplesTop
+            ct.c_int64,
+            # double * interactionScoresOut
+            ndpointer(dtype=ct.c_double, ndim=1, flags="C_CONTIGUOUS"),
+            # int64_t * tripleFeatureIndexesOut
+            ndpointer(dtype=ct.c_int64, ndim=1, flags="C_CONTIGUOUS"),
+            # int64_t * countTriplesOut
+            ct.POINTER(ct.c_int64),
+        ]
+        self._unsafe.CalculateInteractionScoresTriples.restype = ct.c_int64
+
+        self._unsafe.SetInteractionSampling.argtypes = [
+            # void * interactionDetectorHandle
+            ct.c_void_p,
+            # int32_t randomSeed
+            ct.c_int32,
+            # double sampleFraction
+            ct.c_double,
+            # int64_t isBootstrap
+            ct.c_int64,
+        ]
+        self._unsafe.SetInteractionSampling.restype = ct.c_int64
+
         self._unsafe.FreeInteractionDetector.argtypes = [
             # void * interactionDetectorHandle
             ct.c_void_p
         ]
         self._unsafe.FreeInteractionDetector.restype = None
 
+        self._unsafe.CreateThreadStateInteraction.argtypes = [
+            # void * interactionDetectorHandle
+            ct.c_void_p
+        ]
+        self._unsafe.CreateThreadStateInteraction.restype = ct.c_void_p
+
+        self._unsafe.FreeThreadStateInteraction.argtypes = [
+            # void * threadStateInteraction
+            ct.c_void_p
+        ]
+        self._unsafe.FreeThreadStateInteraction.restype = None
+
     @staticmethod
     def _convert_feature_groups_to_c(feature_groups):
         # Create C form of feature_groups
@@ -769,6 +1600,7 @@ class NativeEBMBooster:
         self._features_bin_count = features_bin_count
 
         self._feature_groups = feature_groups
+        self._n_samples_train = len(y_train)
         (
             feature_groups_feature_count,
             feature_groups_feature_indexes,
@@ -938,6 +1770,69 @@ class NativeEBMBooster:
         # log.debug("Boosting step end")
         return gain.value
 
+    def set_coarse_bin_schedule(self, coarse_rounds, coarse_max_bins):
+
+        """ Boosts each feature group on coarsened bins for its first rounds.
+
+        Args:
+            coarse_rounds: Number of rounds per feature group that use the
+                coarse bins. Zero turns the schedule off.
+            coarse_max_bins: Most bins each ordinal feature is merged down to
+                while coarse. Must be 2 or more.
+        """
+
+        return_code = self._native._unsafe.SetCoarseBinSchedule(
+            self._booster_handle, coarse_rounds, coarse_max_bins
+        )
+        if return_code:  # pragma: no cover
+            raise Exception("Error in SetCoarseBinSchedule")
+
+    def set_feature_group_schedule(self, gain_threshold, max_skip_rounds):
+
+        """ Sets the policy for skipping feature groups that stop improving.
+
+        Args:
+            gain_threshold: Feature groups with a gain below this are skipped
+                for an exponentially growing number of rounds.
+            max_skip_rounds: Most rounds a feature group is skipped before it
+                is re-checked. Zero visits every feature group every round.
+        """
+
+        return_code = self._native._unsafe.SetFeatureGroupSchedule(
+            self._booster_handle, gain_threshold, max_skip_rounds
+        )
+        if return_code:  # pragma: no cover
+            raise MemoryError("Out of memory in SetFeatureGroupSchedule")
+
+    def get_scheduled_feature_groups(self):
+
+        """ Gets the feature groups to boost in the current round.
+
+        This doesn't change the schedule. Call advance_feature_group_schedule
+        after boosting them to move on to the next round.
+
+        Returns:
+            Array of feature group indexes.
+        """
+
+        count = ct.c_int64(0)
+        indexes = np.empty(max(1, len(self._feature_groups)), dtype=ct.c_int64, order="C")
+        return_code = self._native._unsafe.GetScheduledFeatureGroups(
+            self._booster_handle, ct.byref(count), indexes
+        )
+        if return_code:  # pragma: no cover
+            raise Exception("Error in GetScheduledFeatureGroups")
+
+        return indexes[:count.value]
+
+    def advance_feature_group_schedule(self):
+
+        """ Moves the feature group schedule on to the next round that boosts something. """
+
+        return_code = self._native._unsafe.AdvanceFeatureGroupSchedule(self._booster_handle)
+        if return_code:  # pragma: no cover
+            raise Exception("Error in AdvanceFeatureGroupSchedule")
+
     def apply_model_update(self):
 
         """ Updates the interal C state with the last model update
@@ -1280,31 +2175,312 @@ class NativeEBMInteraction:
         else:  # pragma: no cover
             raise AttributeError("Unrecognized model_type")
 
+        self._thread_state_interaction = self._native._unsafe.CreateThreadStateInteraction(self._interaction_handle)
+        if not self._thread_state_interaction:  # pragma: no cover
+            self._native._unsafe.FreeInteractionDetector(self._interaction_handle)
+            raise MemoryError("Out of memory in CreateThreadStateInteraction")
+
         log.info("Allocation interaction end")
 
+    @classmethod
+    def from_booster(
+        cls, booster, use_best_model=True, features_categorical=None, features_bin_count=None, X=None, optional_temp_params=None
+    ):
+        """ Makes an interaction detector from the scores already held by a booster.
+
+        This skips predicting the training set.  Without X the booster's own binned
+        training data is used too.  Everything is copied, so the booster can keep
+        boosting or be closed while the interaction detector is open.
+
+        Args:
+            booster: An open NativeEBMBooster.
+            use_best_model: Use the residuals of the best model instead of the current model.
+            features_categorical: list of categorical features represented by bools, for X
+            features_bin_count: count of the number of bins for each feature, for X
+            X: Optional design matrix as 2-D ndarray with the booster's training samples
+                binned differently, for instance into fewer bins for pairs.
+            optional_temp_params: Experimental parameters passed through to the native code.
+
+        Returns:
+            A NativeEBMInteraction.
+        """
+        self = cls.__new__(cls)
+        self._interaction_handle = None
+        self._native = Native.get_native_singleton()
+
+        if X is not None:
+            # check inputs for things that would segfault in C
+            if not isinstance(features_categorical, np.ndarray):  # pragma: no cover
+                raise ValueError("features_categorical should be an np.ndarray")
+
+            if not isinstance(features_bin_count, np.ndarray):  # pragma: no cover
+                raise ValueError("features_bin_count should be an np.ndarray")
+
+            if X.ndim != 2:  # pragma: no cover
+                raise ValueError("X should have exactly 2 dimensions")
+
+            if X.shape[0] != len(features_categorical) or X.shape[0] != len(features_bin_count):  # pragma: no cover
+                raise ValueError(
+                    "X does not have the same number of items as the features_categorical and features_bin_count arrays"
+                )
+
+            if X.shape[1] != booster._n_samples_train:  # pragma: no cover
+                raise ValueError("X does not have the same number of samples as the booster's training set")
+
+            features_categorical = np.ascontiguousarray(features_categorical, dtype=ct.c_int64)
+            features_bin_count = np.ascontiguousarray(features_bin_count, dtype=ct.c_int64)
+            X = np.ascontiguousarray(X, dtype=ct.c_int64)
+
+        log.info("Allocation interaction from booster start")
+
+        if optional_temp_params is not None:  # pragma: no cover
+            optional_temp_params = (ct.c_double * len(optional_temp_params))(
+                *optional_temp_params
+            )
+
+        self._interaction_handle = self._native._unsafe.CreateInteractionDetectorFromBooster(
+            booster._booster_handle,
+            1 if use_best_model else 0,
+            0 if X is None else X.shape[0],
+            None if X is None else features_categorical.ctypes.data,
+            None if X is None else features_bin_count.ctypes.data,
+            None if X is None else X.ctypes.data,
+            optional_temp_params,
+        )
+        if not self._interaction_handle:  # pragma: no cover
+            raise MemoryError("Out of memory in CreateInteractionDetectorFromBooster")
+
+        self._thread_state_interaction = self._native._unsafe.CreateThreadStateInteraction(self._interaction_handle)
+        if not self._thread_state_interaction:  # pragma: no cover
+            self._native._unsafe.FreeInteractionDetector(self._interaction_handle)
+            raise MemoryError("Out of memory in CreateThreadStateInteraction")
+
+        log.info("Allocation interaction from booster end")
+        return self
+
     def close(self):
         """ Deallocates C objects used to determine interactions in EBM. """
         log.info("Deallocation interaction start")
+        self._native._unsafe.FreeThreadStateInteraction(self._thread_state_interaction)
         self._native._unsafe.FreeInteractionDetector(self._interaction_handle)
         log.info("Deallocation interaction end")
 
+    def set_sampling(self, random_state, sample_fraction, is_bootstrap=False):
+        """ Restricts later interaction scores to a random bag of the samples.
+
+        Args:
+            random_state: Random seed that picks the bag.
+            sample_fraction: Fraction of the samples in the bag, in (0, 1].
+            is_bootstrap: Draw the bag with replacement instead of without.
+        """
+        return_code = self._native._unsafe.SetInteractionSampling(
+            self._interaction_handle,
+            random_state,
+            sample_fraction,
+            1 if is_bootstrap else 0,
+        )
+        if return_code != 0:
+            raise Exception("SetInteractionSampling failed")
+
     def get_interaction_score(self, feature_index_tuple, min_samples_leaf):
         """ Provides score for an feature interaction. Higher is better."""
         log.info("Fast interaction score start")
         score = ct.c_double(0.0)
-        return_code = self._native._unsafe.CalculateInteractionScore(
-            self._interaction_handle,
+        return_code = self._native._unsafe.CalculateInteractionScoreThreadState(
+            self._thread_state_interaction,
             len(feature_index_tuple),
             np.array(feature_index_tuple, dtype=ct.c_int64),
             min_samples_leaf,
             ct.byref(score),
         )
         if return_code != 0:  # pragma: no cover
-            raise Exception("Out of memory in CalculateInteractionScore")
+            raise Exception("Out of memory in CalculateInteractionScoreThreadState")
 
         log.info("Fast interaction score end")
         return score.value
 
+    def get_interaction_scores(self, feature_index_tuples, min_samples_leaf, n_top=0):
+        """ Scores many feature interactions of the same size in one native call.
+
+        Args:
+            feature_index_tuples: List of feature index tuples, all of the same length.
+            min_samples_leaf: Min observations required at a leaf.
+            n_top: If zero, scores are returned in the order given. Otherwise only
+                the n_top best are returned, best first.
+
+        Returns:
+            Tuple of (positions into feature_index_tuples, scores).
+        """
+        log.info("Fast interaction scores start")
+        n_groups = len(feature_index_tuples)
+        n_features_in_group = len(feature_index_tuples[0]) if n_groups != 0 else 0
+        feature_indexes = np.array(feature_index_tuples, dtype=ct.c_int64).reshape(-1)
+        if feature_indexes.shape[0] == 0:
+            # ndpointer needs a real array
+            feature_indexes = np.empty(1, dtype=ct.c_int64)
+
+        n_out = n_groups if n_top <= 0 else min(n_top, n_groups)
+        scores = np.empty(max(n_out, 1), dtype=ct.c_double)
+        indexes = np.arange(max(n_out, 1), dtype=ct.c_int64)
+
+        return_code = self._native._unsafe.CalculateInteractionScores(
+            self._interaction_handle,
+            n_groups,
+            n_features_in_group,
+            feature_indexes,
+            min_samples_leaf,
+            0 if n_top <= 0 else n_top,
+            scores,
+            indexes,
+        )
+        if return_code != 0:  # pragma: no cover
+            raise Exception("Out of memory in CalculateInteractionScores")
+
+        log.info("Fast interaction scores end")
+        return indexes[:n_out].tolist(), scores[:n_out].tolist()
+
+    def get_interaction_scores_approximate(
+        self,
+        feature_index_tuples,
+        min_samples_leaf,
+        n_top,
+        n_samples_screen,
+        n_refine,
+        random_state,
+    ):
+        """ Screens interactions on a random subsample, then rescores the best on all samples.
+
+        Args:
+            feature_index_tuples: List of feature index tuples, all of the same length.
+            min_samples_leaf: Min observations required at a leaf.
+            n_top: Number of interactions to return, best first.
+            n_samples_screen: Number of samples in the screening subsample.
+            n_refine: Number of screened interactions rescored on all samples.
+            random_state: Seed that picks the screening subsample.
+
+        Returns:
+            Tuple of (positions into feature_index_tuples, scores).
+        """
+        log.info("Approximate fast interaction scores start")
+        n_groups = len(feature_index_tuples)
+        n_features_in_group = len(feature_index_tuples[0]) if n_groups != 0 else 0
+        feature_indexes = np.array(feature_index_tuples, dtype=ct.c_int64).reshape(-1)
+        if feature_indexes.shape[0] == 0:
+            # ndpointer needs a real array
+            feature_indexes = np.empty(1, dtype=ct.c_int64)
+
+        n_out = min(n_top, n_groups)
+        scores = np.empty(max(n_out, 1), dtype=ct.c_double)
+        indexes = np.arange(max(n_out, 1), dtype=ct.c_int64)
+
+        return_code = self._native._unsafe.CalculateInteractionScoresApproximate(
+            self._interaction_handle,
+            n_groups,
+            n_features_in_group,
+            feature_indexes,
+            min_samples_leaf,
+            random_state,
+            n_samples_screen,
+            n_refine,
+            n_top,
+            scores,
+            indexes,
+        )
+        if return_code != 0:  # pragma: no cover
+            raise Exception("Out of memory in CalculateInteractionScoresApproximate")
+
+        log.info("Approximate fast interaction scores end")
+        return indexes[:n_out].tolist(), scores[:n_out].tolist()
+
+    def get_interaction_scores_pruned(self, feature_index_tuples, min_samples_leaf, n_top):
+        """ Finds the n_top best interactions, skipping those that provably can't make the cut.
+
+        Args:
+            feature_index_tuples: List of feature index tuples, all of the same length.
+            min_samples_leaf: Min observations required at a leaf.
+            n_top: Number of interactions to return, best first.
+
+        Returns:
+            Tuple of (positions into feature_index_tuples, scores, n_skipped, n_pruned).
+        """
+        log.info("Pruned fast interaction scores start")
+        n_groups = len(feature_index_tuples)
+        n_features_in_group = len(feature_index_tuples[0]) if n_groups != 0 else 0
+        feature_indexes = np.array(feature_index_tuples, dtype=ct.c_int64).reshape(-1)
+        if feature_indexes.shape[0] == 0:
+            # ndpointer needs a real array
+            feature_indexes = np.empty(1, dtype=ct.c_int64)
+
+        n_out = min(n_top, n_groups)
+        scores = np.empty(max(n_out, 1), dtype=ct.c_double)
+        indexes = np.arange(max(n_out, 1), dtype=ct.c_int64)
+        n_skipped = ct.c_int64(0)
+        n_pruned = ct.c_int64(0)
+
+        return_code = self._native._unsafe.CalculateInteractionScoresPruned(
+            self._interaction_handle,
+            n_groups,
+            n_features_in_group,
+            feature_indexes,
+            min_samples_leaf,
+            n_top,
+            scores,
+            indexes,
+            ct.byref(n_skipped),
+            ct.byref(n_pruned),
+        )
+        if return_code != 0:  # pragma: no cover
+            raise Exception("Out of memory in CalculateInteractionScoresPruned")
+
+        log.info("Pruned fast interaction scores end")
+        return (
+            indexes[:n_out].tolist(),
+            scores[:n_out].tolist(),
+            n_skipped.value,
+            n_pruned.value,
+        )
+
+    def get_interaction_triple_scores(self, feature_index_pairs, min_samples_leaf, n_top):
+        """ Finds the n_top best 3-way interactions among the given pairs extended by the features in the other pairs.
+
+        Args:
+            feature_index_pairs: List of feature index pairs, usually the best pairs found.
+            min_samples_leaf: Min observations required at a leaf.
+            n_top: Number of triples to return, best first.
+
+        Returns:
+            List of (feature index triple, score) tuples.
+        """
+        log.info("Triple interaction scores start")
+        n_pairs = len(feature_index_pairs)
+        pair_feature_indexes = np.array(feature_index_pairs, dtype=ct.c_int64).reshape(-1)
+        if pair_feature_indexes.shape[0] == 0:
+            # ndpointer needs a real array
+            pair_feature_indexes = np.empty(1, dtype=ct.c_int64)
+
+        scores = np.empty(max(n_top, 1), dtype=ct.c_double)
+        triple_feature_indexes = np.empty(max(n_top, 1) * 3, dtype=ct.c_int64)
+        n_triples = ct.c_int64(0)
+
+        return_code = self._native._unsafe.CalculateInteractionScoresTriples(
+            self._interaction_handle,
+            n_pairs,
+            pair_feature_indexes,
+            min_samples_leaf,
+            n_top,
+            scores,
+            triple_feature_indexes,
+            ct.byref(n_triples),
+        )
+        if return_code != 0:  # pragma: no cover
+            raise Exception("Out of memory in CalculateInteractionScoresTriples")
+
+        log.info("Triple interaction scores end")
+        return [
+            (tuple(triple_feature_indexes[i * 3 : i * 3 + 3].tolist()), scores[i])
+            for i in range(n_triples.value)
+        ]
+
 
 class NativeHelper:
     @staticmethod
@@ -1331,6 +2507,11 @@ class NativeHelper:
         random_state,
         name,
         optional_temp_params=None,
+        schedule_gain_threshold=0.0,
+        schedule_max_skip_rounds=0,
+        coarse_rounds=0,
+        coarse_max_bins=2,
+        on_boosted=None,
     ):
         min_metric = np.inf
         episode_index = 0
@@ -1352,6 +2533,14 @@ class NativeHelper:
                 optional_temp_params,
             )
         ) as native_ebm_booster:
+            if coarse_rounds > 0:
+                native_ebm_booster.set_coarse_bin_schedule(
+                    coarse_rounds, coarse_max_bins
+                )
+            if schedule_max_skip_rounds > 0:
+                native_ebm_booster.set_feature_group_schedule(
+                    schedule_gain_threshold, schedule_max_skip_rounds
+                )
             no_change_run_length = 0
             bp_metric = np.inf
             log.info("Start boosting {0}".format(name))
@@ -1360,7 +2549,12 @@ class NativeHelper:
                     log.debug("Sweep Index for {0}: {1}".format(name, episode_index))
                     log.debug("Metric: {0}".format(min_metric))
 
-                for feature_group_index in range(len(feature_groups)):
+                scheduled_feature_groups = native_ebm_booster.get_scheduled_feature_groups()
+                if len(scheduled_feature_groups) == 0:
+                    # the schedule never comes back empty while there are feature groups, so there's nothing to boost
+                    break
+
+                for feature_group_index in scheduled_feature_groups:
                     gain = native_ebm_booster.generate_model_update(
                         feature_group_index=feature_group_index,
                         generate_update_options=generate_update_options,
@@ -1373,6 +2567,8 @@ class NativeHelper:
 
                     min_metric = min(curr_metric, min_metric)
 
+                native_ebm_booster.advance_feature_group_schedule()
+
                 # TODO PK this early_stopping_tolerance is a little inconsistent
                 #      since it triggers intermittently and only re-triggers if the
                 #      threshold is re-passed, but not based on a smooth windowed set
@@ -1402,6 +2598,10 @@ class NativeHelper:
             # TODO: Add alternative | get_current_model
             model_update = native_ebm_booster.get_best_model()
 
+            if on_boosted is not None:
+                # the booster still holds the training scores, which is cheaper than predicting them again
+                on_boosted(native_ebm_booster)
+
         return model_update, min_metric, episode_index
 
     @staticmethod
@@ -1417,18 +2617,33 @@ class NativeHelper:
         scores,
         min_samples_leaf,
         optional_temp_params=None,
+        booster=None,
     ):
         interaction_scores = []
-        with closing(
-            NativeEBMInteraction(
+        if booster is None:
+            native_ebm_interactions = NativeEBMInteraction(
                 model_type, n_classes, features_categorical, features_bin_count, X, y, scores, optional_temp_params
             )
-        ) as native_ebm_interactions:
-            for feature_group in iter_feature_groups:
-                score = native_ebm_interactions.get_interaction_score(
-                    feature_group, min_samples_leaf,
+        else:
+            # y and scores are already in the booster, which holds the same training samples as X
+            native_ebm_interactions = NativeEBMInteraction.from_booster(
+                booster, True, features_categorical, features_bin_count, X, optional_temp_params
+            )
+        with closing(native_ebm_interactions):
+            feature_groups = list(iter_feature_groups)
+            if len(set(len(feature_group) for feature_group in feature_groups)) <= 1:
+                # score everything in one native call, which spreads the work over all cores
+                ranked_positions, ranked_scores = native_ebm_interactions.get_interaction_scores(
+                    feature_groups, min_samples_leaf, n_top=len(feature_groups),
                 )
-                interaction_scores.append((feature_group, score))
+                for position, score in zip(ranked_positions, ranked_scores):
+                    interaction_scores.append((feature_groups[position], score))
+            else:
+                for feature_group in feature_groups:
+                    score = native_ebm_interactions.get_interaction_score(
+                        feature_group, min_samples_leaf,
+                    )
+                    interaction_scores.append((feature_group, score))
 
         ranked_scores = list(
             sorted(interaction_scores, key=lambda x: x[1], reverse=True)
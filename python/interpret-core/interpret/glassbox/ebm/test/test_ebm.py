@@ -12,7 +12,9 @@ from ....test.utils import (
     iris_classification,
 )
 from ....test.utils import synthetic_regression
-from ..ebm import ExplainableBoostingRegressor, ExplainableBoostingClassifier
+from ..ebm import ExplainableBoostingRegressor, ExplainableBoostingClassifier, EBMPreprocessor
+from ..internal import Native
+from ....utils import unify_data
 
 import numpy as np
 import pandas as pd
@@ -198,6 +200,27 @@ def test_ebm_synthetic_regression():
     valid_ebm(clf)
 
 
+def test_ebm_feature_group_schedule():
+    data = synthetic_regression()
+    X = data["full"]["X"]
+    y = data["full"]["y"]
+
+    clf = ExplainableBoostingRegressor(n_jobs=1, outer_bags=2, interactions=2, max_rounds=500)
+    clf.fit(X, y)
+    clf_schedule = ExplainableBoostingRegressor(
+        n_jobs=1, outer_bags=2, interactions=2, max_rounds=500, schedule_gain_threshold=2.0, schedule_max_skip_rounds=8
+    )
+    clf_schedule.fit(X, y)
+
+    valid_ebm(clf_schedule)
+    assert clf_schedule.get_params()["schedule_max_skip_rounds"] == 8
+    # this synthetic data has gains of about 1 to 10, so some feature groups sit out some rounds, which should barely change the fit
+    y = np.asarray(y).ravel()
+    mse = np.mean((clf.predict(X) - y) ** 2)
+    mse_schedule = np.mean((clf_schedule.predict(X) - y) ** 2)
+    assert mse_schedule < mse * 1.1
+
+
 def valid_ebm(ebm):
     assert ebm.feature_groups_[0] == [0]
 
@@ -331,3 +354,129 @@ def test_zero_validation():
 
     clf = ExplainableBoostingClassifier(n_jobs=1, interactions=2, validation_size=0)
     clf.fit(X, y)
+
+
+def _preprocessor_data(n_samples=1000, seed=0):
+    rng = np.random.RandomState(seed)
+    X_df = pd.DataFrame(
+        {
+            "normal": rng.randn(n_samples),
+            "repeated": rng.randint(0, 7, size=n_samples).astype(float),
+            "skewed": np.exp(rng.randn(n_samples) * 3),
+            "category": rng.choice(["a", "b", "c", "d", "e"], size=n_samples),
+        }
+    )
+    feature_types = ["continuous", "continuous", "continuous", "categorical"]
+    X, _, feature_names, _ = unify_data(X_df, None, None, feature_types)
+    return X, feature_names, feature_types
+
+
+def _per_column_fit_transform(X, X_test, feature_types, max_bins, binning):
+    # bins each column on its own with generate_quantile_cuts, discretize and a python dict, which is what
+    # EBMPreprocessor did before it batched the columns and encoded the categories natively
+    native = Native.get_native_singleton()
+    cuts_list = {}
+    bin_counts_list = []
+    mappings = {}
+    X_new = np.empty(X_test.shape, dtype=np.int64)
+    for col_idx, col_type in enumerate(feature_types):
+        if col_type == "continuous":
+            col_data = X[:, col_idx].astype(float)
+            if binning == "uniform":
+                cuts, _, _, _ = native.generate_uniform_cuts(col_data, max_bins - 2)
+            else:
+                cuts, _, _, _ = native.generate_quantile_cuts(
+                    col_data, 1, 1 if binning == "quantile_humanized" else 0, max_bins - 2
+                )
+            _, bin_counts = np.unique(native.discretize(col_data, cuts), return_counts=True)
+            bin_counts_list.append(np.concatenate(([0], bin_counts)))
+            cuts_list[col_idx] = cuts
+            X_new[:, col_idx] = native.discretize(X_test[:, col_idx].astype(float), cuts)
+        else:
+            uniq_vals = np.unique(X[:, col_idx].astype("U"))
+            mapping = {val: indx + 1 for indx, val in enumerate(uniq_vals)}
+            bin_counts_list.append(None)
+            mappings[col_idx] = mapping
+            mapping = dict(mapping, **{str(np.nan): 0})
+            X_new[:, col_idx] = [mapping.get(val, -1) for val in X_test[:, col_idx].astype("U")]
+    return cuts_list, bin_counts_list, mappings, X_new
+
+
+@pytest.mark.parametrize("binning", ["quantile", "quantile_humanized", "uniform"])
+def test_preprocessor_matches_per_column_path(binning):
+    X, feature_names, feature_types = _preprocessor_data()
+    X_test, _, _ = _preprocessor_data(n_samples=200, seed=1)
+    X_test[:5, 3] = "unseen"
+    X_test[5:10, 3] = str(np.nan)
+
+    preprocessor = EBMPreprocessor(feature_names, feature_types, max_bins=32, binning=binning)
+    preprocessor.fit(X)
+    X_binned = preprocessor.transform(X_test)
+
+    cuts_list, bin_counts_list, mappings, X_expected = _per_column_fit_transform(
+        X, X_test, feature_types, 32, binning
+    )
+    for col_idx, col_type in enumerate(feature_types):
+        if col_type == "continuous":
+            assert np.array_equal(preprocessor.col_bin_edges_[col_idx], cuts_list[col_idx])
+            assert np.array_equal(preprocessor.col_bin_counts_[col_idx], bin_counts_list[col_idx])
+        else:
+            assert preprocessor.col_mapping_[col_idx] == mappings[col_idx]
+    assert np.array_equal(X_binned, X_expected)
+    assert np.all(X_binned[:5, 3] == -1)
+    assert np.all(X_binned[5:10, 3] == 0)
+
+
+def test_preprocessor_quantile_cuts_batch():
+    native = Native.get_native_singleton()
+    X, _, _ = _preprocessor_data()
+    X_cols = X[:, :3].astype(float)
+    X_cols[::17, 0] = np.nan
+
+    results = native.generate_quantile_cuts_batch(X_cols, 3, 0, 20)
+    assert len(results) == X_cols.shape[1]
+    for col_idx, (cuts, count_missing, min_val, max_val) in enumerate(results):
+        (
+            expected_cuts,
+            expected_count_missing,
+            expected_min_val,
+            expected_max_val,
+        ) = native.generate_quantile_cuts(np.ascontiguousarray(X_cols[:, col_idx]), 3, 0, 20)
+        assert np.array_equal(cuts, expected_cuts)
+        assert count_missing == expected_count_missing
+        assert min_val == expected_min_val
+        assert max_val == expected_max_val
+
+
+def test_preprocessor_coarsen():
+    X, feature_names, feature_types = _preprocessor_data()
+    preprocessor = EBMPreprocessor(feature_names, feature_types, max_bins=64)
+    preprocessor.fit(X)
+    X_binned = preprocessor.transform(X)
+
+    coarse, X_coarse = preprocessor.coarsen(X_binned, 8)
+    for col_idx, col_type in enumerate(feature_types):
+        if col_type == "continuous":
+            cuts = coarse.col_bin_edges_[col_idx]
+            assert len(cuts) <= 8 - 2
+            assert np.all(np.isin(cuts, preprocessor.col_bin_edges_[col_idx]))
+            assert np.sum(coarse.col_bin_counts_[col_idx]) == X.shape[0]
+        else:
+            assert np.array_equal(X_coarse[:, col_idx], X_binned[:, col_idx])
+    # the coarse bins are the ones the coarse cuts would give the raw values
+    assert np.array_equal(X_coarse, coarse.transform(X))
+
+
+def test_preprocessor_pickle():
+    import pickle
+
+    X, feature_names, feature_types = _preprocessor_data()
+    preprocessor = EBMPreprocessor(feature_names, feature_types)
+    preprocessor.fit(X)
+    X_binned = preprocessor.transform(X)
+
+    # the native encoders stay behind and are rebuilt by the first transform after loading
+    assert "_categorical_encoders" not in preprocessor.__getstate__()
+    loaded = pickle.loads(pickle.dumps(preprocessor))
+    assert np.array_equal(loaded.transform(X), X_binned)
+    assert np.array_equal(preprocessor.transform(X), X_binned)
@@ -1,7 +1,8 @@
 # Copyright (c) 2019 Microsoft Corporation
 # Distributed under the MIT software license
 
-from ..internal import Native, NativeEBMBooster
+from ..internal import Native, NativeEBMBooster, NativeHelper
+from ..utils import EBMUtils
 
 import numpy as np
 import ctypes as ct
@@ -99,3 +100,75 @@ def test_one_class():
         model = native_ebm_booster.get_best_model()
         assert len(model) == 1
         assert model[0] is None
+
+
+def test_interactions_from_booster():
+    random_state = np.random.RandomState(42)
+    X = random_state.randint(0, 8, size=(3, 200)).astype(ct.c_int64)
+    y = (X[0] * X[1] + X[2] + random_state.randint(0, 3, size=200) > 20).astype(ct.c_int64)
+    # pairs are detected on coarser bins than the mains are boosted on
+    X_pair = np.ascontiguousarray(X // 2)
+    features_categorical = np.zeros(3, dtype=ct.c_int64)
+    features_bin_count = np.full(3, 8, dtype=ct.c_int64)
+    pair_features_bin_count = np.full(3, 4, dtype=ct.c_int64)
+    feature_groups = [[0], [1], [2]]
+
+    interactions_booster = []
+
+    def get_interactions_from_booster(booster):
+        interactions_booster.extend(NativeHelper.get_interactions(
+            n_interactions=3,
+            iter_feature_groups=[(0, 1), (0, 2), (1, 2)],
+            model_type="classification",
+            n_classes=2,
+            features_categorical=features_categorical,
+            features_bin_count=pair_features_bin_count,
+            X=X_pair,
+            y=y,
+            scores=None,
+            min_samples_leaf=2,
+            booster=booster,
+        ))
+
+    model, _, _ = NativeHelper.cyclic_gradient_boost(
+        model_type="classification",
+        n_classes=2,
+        features_categorical=features_categorical,
+        features_bin_count=features_bin_count,
+        feature_groups=feature_groups,
+        X_train=X,
+        y_train=y,
+        scores_train=None,
+        X_val=X,
+        y_val=y,
+        scores_val=None,
+        n_inner_bags=0,
+        generate_update_options=Native.GenerateUpdateOptions_Default,
+        learning_rate=0.01,
+        min_samples_leaf=2,
+        max_leaves=np.array([3], dtype=ct.c_int64, order="C"),
+        early_stopping_rounds=50,
+        early_stopping_tolerance=1e-4,
+        max_rounds=100,
+        random_state=42,
+        name="Main",
+        on_boosted=get_interactions_from_booster,
+    )
+
+    scores = EBMUtils.decision_function(X, X_pair, feature_groups, model, np.zeros(1))
+    indices, scores = NativeHelper.get_interactions(
+        n_interactions=3,
+        iter_feature_groups=[(0, 1), (0, 2), (1, 2)],
+        model_type="classification",
+        n_classes=2,
+        features_categorical=features_categorical,
+        features_bin_count=pair_features_bin_count,
+        X=X_pair,
+        y=y,
+        scores=scores,
+        min_samples_leaf=2,
+    )
+
+    indices_booster, scores_booster = interactions_booster
+    assert indices_booster == indices
+    assert np.allclose(scores_booster, scores)
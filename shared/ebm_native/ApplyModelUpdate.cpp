@@ -200,6 +200,10 @@ EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION ApplyMode
    );
    if(0 != ret) {
       LOG_N(TraceLevelWarning, "WARNING ApplyModelUpdate returned %" IntEbmTypePrintf, ret);
+   } else {
+      // rounds for the coarse-to-fine bin schedule and the feature group schedule are counted when the update is applied
+      pBooster->DecrementRoundsCoarse(iFeatureGroup);
+      pBooster->UpdateSchedule(iFeatureGroup, pThreadStateBoosting->GetGain());
    }
 
    pThreadStateBoosting->SetFeatureGroupIndex(ThreadStateBoosting::k_illegalFeatureGroupIndex);
@@ -466,6 +470,9 @@ EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION SetModelU
    // pBooster->GetFeatureGroups() can be null if 0 == pBooster->m_cFeatureGroups, but we checked that condition above
    EBM_ASSERT(nullptr != pBooster->GetFeatureGroups());
 
+   // our caller made this update, so we have no gain to give the feature group schedule
+   pThreadStateBoosting->SetGain(std::numeric_limits<FloatEbmType>::quiet_NaN());
+
    if(ptrdiff_t { 0 } == pBooster->GetRuntimeLearningTypeOrCountTargetClasses() || ptrdiff_t { 1 } == pBooster->GetRuntimeLearningTypeOrCountTargetClasses()) {
       pThreadStateBoosting->SetFeatureGroupIndex(iFeatureGroup);
       return IntEbmType { 0 };
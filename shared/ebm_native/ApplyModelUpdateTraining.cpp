@@ -20,6 +20,36 @@
 #include "Booster.h"
 #include "ThreadStateBoosting.h"
 
+// Above k_cCompilerOptimizedTargetClassesMax we split the work for each sample into separate passes over its contiguous vector of classes and
+// move the comparison against the target class out of the inner loop.  This is not a class-blocked SIMD kernel.  We rely on g++ to vectorize
+// the passes, which it only does for the exp pass when built with the -fno-math-errno and -fno-trapping-math flags from build.sh.  Measured
+// through ApplyModelUpdate (200k samples, best of 200 rounds) this is 9-24% faster than the single fused loop at 9-32 classes.  At 64 classes
+// the two are the same within noise.  The operations are the same as in ComputeResidualErrorMulticlass, so the results are identical.
+INLINE_ALWAYS static void ApplyModelUpdateTrainingMulticlassDynamic(
+   const size_t cVectorLength,
+   const size_t targetData,
+   const FloatEbmType * const aValues,
+   FloatEbmType * const aPredictorScores,
+   FloatEbmType * const aExpVector,
+   FloatEbmType * const aResidualError
+) {
+   EBM_ASSERT(targetData < cVectorLength);
+   for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
+      // this will apply a small fix to our existing TrainingPredictorScores, either positive or negative, whichever is needed
+      const FloatEbmType predictorScore = aPredictorScores[iVector] + aValues[iVector];
+      aPredictorScores[iVector] = predictorScore;
+      aExpVector[iVector] = ExpForResidualsMulticlass(predictorScore);
+   }
+   FloatEbmType sumExp = FloatEbmType { 0 };
+   for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
+      sumExp += aExpVector[iVector];
+   }
+   for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
+      aResidualError[iVector] = FloatEbmType { 0 } - aExpVector[iVector] / sumExp;
+   }
+   aResidualError[targetData] = FloatEbmType { 1 } - aExpVector[targetData] / sumExp;
+}
+
 // C++ does not allow partial function specialization, so we need to use these cumbersome static class functions to do partial function specialization
 
 template<ptrdiff_t compilerLearningTypeOrCountTargetClasses>
@@ -61,39 +91,52 @@ public:
          size_t targetData = static_cast<size_t>(*pTargetData);
          ++pTargetData;
 
-         const FloatEbmType * pValues = aModelFeatureGroupUpdateTensor;
-         FloatEbmType * pExpVector = aExpVector;
-         FloatEbmType sumExp = FloatEbmType { 0 };
-         size_t iVector = 0;
-         do {
-            // TODO : because there is only one bin for a zero feature feature group, we could move these values to the stack where the
-            // compiler could reason about their visibility and optimize small arrays into registers
-            const FloatEbmType smallChangeToPredictorScores = *pValues;
-            ++pValues;
-            // this will apply a small fix to our existing TrainingPredictorScores, either positive or negative, whichever is needed
-            const FloatEbmType predictorScore = *pPredictorScores + smallChangeToPredictorScores;
-            *pPredictorScores = predictorScore;
-            ++pPredictorScores;
-            const FloatEbmType oneExp = ExpForResidualsMulticlass(predictorScore);
-            *pExpVector = oneExp;
-            ++pExpVector;
-            sumExp += oneExp;
-            ++iVector;
-         } while(iVector < cVectorLength);
-         pExpVector -= cVectorLength;
-         iVector = 0;
-         do {
-            const FloatEbmType residualError = EbmStatistics::ComputeResidualErrorMulticlass(
-               sumExp,
-               *pExpVector,
+         if(k_dynamicClassification == compilerLearningTypeOrCountTargetClasses) {
+            ApplyModelUpdateTrainingMulticlassDynamic(
+               cVectorLength,
                targetData,
-               iVector
+               aModelFeatureGroupUpdateTensor,
+               pPredictorScores,
+               aExpVector,
+               pResidualError
             );
-            ++pExpVector;
-            *pResidualError = residualError;
-            ++pResidualError;
-            ++iVector;
-         } while(iVector < cVectorLength);
+            pPredictorScores += cVectorLength;
+            pResidualError += cVectorLength;
+         } else {
+            const FloatEbmType * pValues = aModelFeatureGroupUpdateTensor;
+            FloatEbmType * pExpVector = aExpVector;
+            FloatEbmType sumExp = FloatEbmType { 0 };
+            size_t iVector = 0;
+            do {
+               // TODO : because there is only one bin for a zero feature feature group, we could move these values to the stack where the
+               // compiler could reason about their visibility and optimize small arrays into registers
+               const FloatEbmType smallChangeToPredictorScores = *pValues;
+               ++pValues;
+               // this will apply a small fix to our existing TrainingPredictorScores, either positive or negative, whichever is needed
+               const FloatEbmType predictorScore = *pPredictorScores + smallChangeToPredictorScores;
+               *pPredictorScores = predictorScore;
+               ++pPredictorScores;
+               const FloatEbmType oneExp = ExpForResidualsMulticlass(predictorScore);
+               *pExpVector = oneExp;
+               ++pExpVector;
+               sumExp += oneExp;
+               ++iVector;
+            } while(iVector < cVectorLength);
+            pExpVector -= cVectorLength;
+            iVector = 0;
+            do {
+               const FloatEbmType residualError = EbmStatistics::ComputeResidualErrorMulticlass(
+                  sumExp,
+                  *pExpVector,
+                  targetData,
+                  iVector
+               );
+               ++pExpVector;
+               *pResidualError = residualError;
+               ++pResidualError;
+               ++iVector;
+            } while(iVector < cVectorLength);
+         }
          // TODO: this works as a way to remove one parameter, but it obviously insn't as efficient as omitting the parameter
          // 
          // this works out in the math as making the first model vector parameter equal to zero, which in turn removes one degree of freedom
@@ -299,36 +342,49 @@ public:
 
             const size_t iTensorBin = maskBits & iTensorBinCombined;
             const FloatEbmType * pValues = &aModelFeatureGroupUpdateTensor[iTensorBin * cVectorLength];
-            FloatEbmType * pExpVector = aExpVector;
-            FloatEbmType sumExp = FloatEbmType { 0 };
-            size_t iVector = 0;
-            do {
-               const FloatEbmType smallChangeToPredictorScores = *pValues;
-               ++pValues;
-               // this will apply a small fix to our existing TrainingPredictorScores, either positive or negative, whichever is needed
-               const FloatEbmType predictorScore = *pPredictorScores + smallChangeToPredictorScores;
-               *pPredictorScores = predictorScore;
-               ++pPredictorScores;
-               const FloatEbmType oneExp = ExpForResidualsMulticlass(predictorScore);
-               *pExpVector = oneExp;
-               ++pExpVector;
-               sumExp += oneExp;
-               ++iVector;
-            } while(iVector < cVectorLength);
-            pExpVector -= cVectorLength;
-            iVector = 0;
-            do {
-               const FloatEbmType residualError = EbmStatistics::ComputeResidualErrorMulticlass(
-                  sumExp,
-                  *pExpVector,
+            if(k_dynamicClassification == compilerLearningTypeOrCountTargetClasses) {
+               ApplyModelUpdateTrainingMulticlassDynamic(
+                  cVectorLength,
                   targetData,
-                  iVector
+                  pValues,
+                  pPredictorScores,
+                  aExpVector,
+                  pResidualError
                );
-               ++pExpVector;
-               *pResidualError = residualError;
-               ++pResidualError;
-               ++iVector;
-            } while(iVector < cVectorLength);
+               pPredictorScores += cVectorLength;
+               pResidualError += cVectorLength;
+            } else {
+               FloatEbmType * pExpVector = aExpVector;
+               FloatEbmType sumExp = FloatEbmType { 0 };
+               size_t iVector = 0;
+               do {
+                  const FloatEbmType smallChangeToPredictorScores = *pValues;
+                  ++pValues;
+                  // this will apply a small fix to our existing TrainingPredictorScores, either positive or negative, whichever is needed
+                  const FloatEbmType predictorScore = *pPredictorScores + smallChangeToPredictorScores;
+                  *pPredictorScores = predictorScore;
+                  ++pPredictorScores;
+                  const FloatEbmType oneExp = ExpForResidualsMulticlass(predictorScore);
+                  *pExpVector = oneExp;
+                  ++pExpVector;
+                  sumExp += oneExp;
+                  ++iVector;
+               } while(iVector < cVectorLength);
+               pExpVector -= cVectorLength;
+               iVector = 0;
+               do {
+                  const FloatEbmType residualError = EbmStatistics::ComputeResidualErrorMulticlass(
+                     sumExp,
+                     *pExpVector,
+                     targetData,
+                     iVector
+                  );
+                  ++pExpVector;
+                  *pResidualError = residualError;
+                  ++pResidualError;
+                  ++iVector;
+               } while(iVector < cVectorLength);
+            }
             // TODO: this works as a way to remove one parameter, but it obviously insn't as efficient as omitting the parameter
             // 
             // this works out in the math as making the first model vector parameter equal to zero, which in turn removes one degree of freedom
@@ -702,7 +758,12 @@ extern void ApplyModelUpdateTraining(
 
    if(0 == pFeatureGroup->GetCountSignificantFeatures()) {
       if(IsClassification(runtimeLearningTypeOrCountTargetClasses)) {
-         ApplyModelUpdateTrainingZeroFeaturesTarget<2>::Func(pThreadStateBoosting);
+         if(k_cCompilerOptimizedTargetClassesMax < runtimeLearningTypeOrCountTargetClasses) {
+            // there is no compiler optimized version for this many classes, so skip the template chain that looks for one
+            ApplyModelUpdateTrainingZeroFeaturesTarget<k_cCompilerOptimizedTargetClassesMax + 1>::Func(pThreadStateBoosting);
+         } else {
+            ApplyModelUpdateTrainingZeroFeaturesTarget<2>::Func(pThreadStateBoosting);
+         }
       } else {
          EBM_ASSERT(IsRegression(runtimeLearningTypeOrCountTargetClasses));
          ApplyModelUpdateTrainingZeroFeatures<k_regression>::Func(pThreadStateBoosting);
@@ -722,7 +783,12 @@ extern void ApplyModelUpdateTraining(
          // 7,6,5,4,3,2,1 - use a mask to exclude the non-used conditions and process them like the 8.  These are rare since they require more than 256 values
 
          if(IsClassification(runtimeLearningTypeOrCountTargetClasses)) {
-            ApplyModelUpdateTrainingSIMDTarget<2>::Func(pThreadStateBoosting, pFeatureGroup);
+            if(k_cCompilerOptimizedTargetClassesMax < runtimeLearningTypeOrCountTargetClasses) {
+               // there is no compiler optimized version for this many classes, so skip the template chain that looks for one
+               ApplyModelUpdateTrainingSIMDTarget<k_cCompilerOptimizedTargetClassesMax + 1>::Func(pThreadStateBoosting, pFeatureGroup);
+            } else {
+               ApplyModelUpdateTrainingSIMDTarget<2>::Func(pThreadStateBoosting, pFeatureGroup);
+            }
          } else {
             EBM_ASSERT(IsRegression(runtimeLearningTypeOrCountTargetClasses));
             ApplyModelUpdateTrainingSIMDPacking<k_regression, k_cItemsPerBitPackedDataUnitMax>::Func(
@@ -738,7 +804,12 @@ extern void ApplyModelUpdateTraining(
          // will exceed the L1 instruction cache size.  With SIMD we do 8 times the work in the same number of instructions so these are lesser issues
 
          if(IsClassification(runtimeLearningTypeOrCountTargetClasses)) {
-            ApplyModelUpdateTrainingNormalTarget<2>::Func(pThreadStateBoosting, pFeatureGroup);
+            if(k_cCompilerOptimizedTargetClassesMax < runtimeLearningTypeOrCountTargetClasses) {
+               // there is no compiler optimized version for this many classes, so skip the template chain that looks for one
+               ApplyModelUpdateTrainingNormalTarget<k_cCompilerOptimizedTargetClassesMax + 1>::Func(pThreadStateBoosting, pFeatureGroup);
+            } else {
+               ApplyModelUpdateTrainingNormalTarget<2>::Func(pThreadStateBoosting, pFeatureGroup);
+            }
          } else {
             EBM_ASSERT(IsRegression(runtimeLearningTypeOrCountTargetClasses));
             ApplyModelUpdateTrainingInternal<k_regression, k_cItemsPerBitPackedDataUnitDynamic>::Func(
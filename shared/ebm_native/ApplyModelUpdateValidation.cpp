@@ -661,7 +661,12 @@ extern FloatEbmType ApplyModelUpdateValidation(
    FloatEbmType ret;
    if(0 == pFeatureGroup->GetCountSignificantFeatures()) {
       if(IsClassification(runtimeLearningTypeOrCountTargetClasses)) {
-         ret = ApplyModelUpdateValidationZeroFeaturesTarget<2>::Func(pThreadStateBoosting);
+         if(k_cCompilerOptimizedTargetClassesMax < runtimeLearningTypeOrCountTargetClasses) {
+            // there is no compiler optimized version for this many classes, so skip the template chain that looks for one
+            ret = ApplyModelUpdateValidationZeroFeaturesTarget<k_cCompilerOptimizedTargetClassesMax + 1>::Func(pThreadStateBoosting);
+         } else {
+            ret = ApplyModelUpdateValidationZeroFeaturesTarget<2>::Func(pThreadStateBoosting);
+         }
       } else {
          EBM_ASSERT(IsRegression(runtimeLearningTypeOrCountTargetClasses));
          ret = ApplyModelUpdateValidationZeroFeatures<k_regression>::Func(pThreadStateBoosting);
@@ -681,10 +686,18 @@ extern FloatEbmType ApplyModelUpdateValidation(
          // 7,6,5,4,3,2,1 - use a mask to exclude the non-used conditions and process them like the 8.  These are rare since they require more than 256 values
 
          if(IsClassification(runtimeLearningTypeOrCountTargetClasses)) {
-            ret = ApplyModelUpdateValidationSIMDTarget<2>::Func(
-               pThreadStateBoosting,
-               pFeatureGroup
-            );
+            if(k_cCompilerOptimizedTargetClassesMax < runtimeLearningTypeOrCountTargetClasses) {
+               // there is no compiler optimized version for this many classes, so skip the template chain that looks for one
+               ret = ApplyModelUpdateValidationSIMDTarget<k_cCompilerOptimizedTargetClassesMax + 1>::Func(
+                  pThreadStateBoosting,
+                  pFeatureGroup
+               );
+            } else {
+               ret = ApplyModelUpdateValidationSIMDTarget<2>::Func(
+                  pThreadStateBoosting,
+                  pFeatureGroup
+               );
+            }
          } else {
             EBM_ASSERT(IsRegression(runtimeLearningTypeOrCountTargetClasses));
             ret = ApplyModelUpdateValidationSIMDPacking<k_regression, k_cItemsPerBitPackedDataUnitMax>::Func(
@@ -700,10 +713,18 @@ extern FloatEbmType ApplyModelUpdateValidation(
          // will exceed the L1 instruction cache size.  With SIMD we do 8 times the work in the same number of instructions so these are lesser issues
 
          if(IsClassification(runtimeLearningTypeOrCountTargetClasses)) {
-            ret = ApplyModelUpdateValidationNormalTarget<2>::Func(
-               pThreadStateBoosting,
-               pFeatureGroup
-            );
+            if(k_cCompilerOptimizedTargetClassesMax < runtimeLearningTypeOrCountTargetClasses) {
+               // there is no compiler optimized version for this many classes, so skip the template chain that looks for one
+               ret = ApplyModelUpdateValidationNormalTarget<k_cCompilerOptimizedTargetClassesMax + 1>::Func(
+                  pThreadStateBoosting,
+                  pFeatureGroup
+               );
+            } else {
+               ret = ApplyModelUpdateValidationNormalTarget<2>::Func(
+                  pThreadStateBoosting,
+                  pFeatureGroup
+               );
+            }
          } else {
             EBM_ASSERT(IsRegression(runtimeLearningTypeOrCountTargetClasses));
             ret = ApplyModelUpdateValidationInternal<k_regression, k_cItemsPerBitPackedDataUnitDynamic>::Func(
@@ -188,6 +188,7 @@ public:
    static void Func(
       ThreadStateBoosting * const pThreadStateBoosting,
       const FeatureGroup * const pFeatureGroup,
+      const size_t * const aiTensorBinsCoarse,
       const SamplingSet * const pTrainingSet
    ) {
       constexpr bool bClassification = IsClassification(compilerLearningTypeOrCountTargetClasses);
@@ -258,7 +259,11 @@ public:
          size_t iTensorBinCombined = static_cast<size_t>(*pInputData);
          ++pInputData;
          do {
-            const size_t iTensorBin = maskBits & iTensorBinCombined;
+            size_t iTensorBin = maskBits & iTensorBinCombined;
+            if(nullptr != aiTensorBinsCoarse) {
+               // the coarse-to-fine schedule merges adjacent bins.  This branch goes the same way for the entire call
+               iTensorBin = aiTensorBinsCoarse[iTensorBin];
+            }
 
             HistogramBucket<bClassification> * const pHistogramBucketEntry = GetHistogramBucketByIndex(
                cBytesPerHistogramBucket,
@@ -355,6 +360,7 @@ public:
    INLINE_ALWAYS static void Func(
       ThreadStateBoosting * const pThreadStateBoosting,
       const FeatureGroup * const pFeatureGroup,
+      const size_t * const aiTensorBinsCoarse,
       const SamplingSet * const pTrainingSet
    ) {
       static_assert(IsClassification(compilerLearningTypeOrCountTargetClassesPossible), "compilerLearningTypeOrCountTargetClassesPossible needs to be a classification");
@@ -369,12 +375,14 @@ public:
          BinBoostingInternal<compilerLearningTypeOrCountTargetClassesPossible, k_cItemsPerBitPackedDataUnitDynamic>::Func(
             pThreadStateBoosting,
             pFeatureGroup,
+            aiTensorBinsCoarse,
             pTrainingSet
          );
       } else {
          BinBoostingNormalTarget<compilerLearningTypeOrCountTargetClassesPossible + 1>::Func(
             pThreadStateBoosting,
             pFeatureGroup,
+            aiTensorBinsCoarse,
             pTrainingSet
          );
       }
@@ -390,6 +398,7 @@ public:
    INLINE_ALWAYS static void Func(
       ThreadStateBoosting * const pThreadStateBoosting,
       const FeatureGroup * const pFeatureGroup,
+      const size_t * const aiTensorBinsCoarse,
       const SamplingSet * const pTrainingSet
    ) {
       static_assert(IsClassification(k_cCompilerOptimizedTargetClassesMax), "k_cCompilerOptimizedTargetClassesMax needs to be a classification");
@@ -400,6 +409,7 @@ public:
       BinBoostingInternal<k_dynamicClassification, k_cItemsPerBitPackedDataUnitDynamic>::Func(
          pThreadStateBoosting,
          pFeatureGroup,
+         aiTensorBinsCoarse,
          pTrainingSet
       );
    }
@@ -414,6 +424,7 @@ public:
    INLINE_ALWAYS static void Func(
       ThreadStateBoosting * const pThreadStateBoosting,
       const FeatureGroup * const pFeatureGroup,
+      const size_t * const aiTensorBinsCoarse,
       const SamplingSet * const pTrainingSet
    ) {
       const size_t runtimeCountItemsPerBitPackedDataUnit = pFeatureGroup->GetCountItemsPerBitPackedDataUnit();
@@ -425,6 +436,7 @@ public:
          BinBoostingInternal<compilerLearningTypeOrCountTargetClasses, compilerCountItemsPerBitPackedDataUnitPossible>::Func(
             pThreadStateBoosting,
             pFeatureGroup,
+            aiTensorBinsCoarse,
             pTrainingSet
          );
       } else {
@@ -434,6 +446,7 @@ public:
          >::Func(
             pThreadStateBoosting,
             pFeatureGroup,
+            aiTensorBinsCoarse,
             pTrainingSet
          );
       }
@@ -449,6 +462,7 @@ public:
    INLINE_ALWAYS static void Func(
       ThreadStateBoosting * const pThreadStateBoosting,
       const FeatureGroup * const pFeatureGroup,
+      const size_t * const aiTensorBinsCoarse,
       const SamplingSet * const pTrainingSet
    ) {
       EBM_ASSERT(1 <= pFeatureGroup->GetCountItemsPerBitPackedDataUnit());
@@ -456,6 +470,7 @@ public:
       BinBoostingInternal<compilerLearningTypeOrCountTargetClasses, k_cItemsPerBitPackedDataUnitDynamic>::Func(
          pThreadStateBoosting,
          pFeatureGroup,
+         aiTensorBinsCoarse,
          pTrainingSet
       );
    }
@@ -470,6 +485,7 @@ public:
    INLINE_ALWAYS static void Func(
       ThreadStateBoosting * const pThreadStateBoosting,
       const FeatureGroup * const pFeatureGroup,
+      const size_t * const aiTensorBinsCoarse,
       const SamplingSet * const pTrainingSet
    ) {
       static_assert(IsClassification(compilerLearningTypeOrCountTargetClassesPossible), "compilerLearningTypeOrCountTargetClassesPossible needs to be a classification");
@@ -487,12 +503,14 @@ public:
          >::Func(
             pThreadStateBoosting,
             pFeatureGroup,
+            aiTensorBinsCoarse,
             pTrainingSet
          );
       } else {
          BinBoostingSIMDTarget<compilerLearningTypeOrCountTargetClassesPossible + 1>::Func(
             pThreadStateBoosting,
             pFeatureGroup,
+            aiTensorBinsCoarse,
             pTrainingSet
          );
       }
@@ -508,6 +526,7 @@ public:
    INLINE_ALWAYS static void Func(
       ThreadStateBoosting * const pThreadStateBoosting,
       const FeatureGroup * const pFeatureGroup,
+      const size_t * const aiTensorBinsCoarse,
       const SamplingSet * const pTrainingSet
    ) {
       static_assert(IsClassification(k_cCompilerOptimizedTargetClassesMax), "k_cCompilerOptimizedTargetClassesMax needs to be a classification");
@@ -518,6 +537,7 @@ public:
       BinBoostingSIMDPacking<k_dynamicClassification, k_cItemsPerBitPackedDataUnitMax>::Func(
          pThreadStateBoosting,
          pFeatureGroup,
+         aiTensorBinsCoarse,
          pTrainingSet
       );
    }
@@ -526,6 +546,7 @@ public:
 extern void BinBoosting(
    ThreadStateBoosting * const pThreadStateBoosting,
    const FeatureGroup * const pFeatureGroup,
+   const size_t * const aiTensorBinsCoarse,
    const SamplingSet * const pTrainingSet
 ) {
    LOG_0(TraceLevelVerbose, "Entered BinBoosting");
@@ -535,10 +556,18 @@ extern void BinBoosting(
 
    if(nullptr == pFeatureGroup) {
       if(IsClassification(runtimeLearningTypeOrCountTargetClasses)) {
-         BinBoostingZeroDimensionsTarget<2>::Func(
-            pThreadStateBoosting,
-            pTrainingSet
-         );
+         if(k_cCompilerOptimizedTargetClassesMax < runtimeLearningTypeOrCountTargetClasses) {
+            // there is no compiler optimized version for this many classes, so skip the template chain that looks for one
+            BinBoostingZeroDimensionsTarget<k_cCompilerOptimizedTargetClassesMax + 1>::Func(
+               pThreadStateBoosting,
+               pTrainingSet
+            );
+         } else {
+            BinBoostingZeroDimensionsTarget<2>::Func(
+               pThreadStateBoosting,
+               pTrainingSet
+            );
+         }
       } else {
          EBM_ASSERT(IsRegression(runtimeLearningTypeOrCountTargetClasses));
          BinBoostingZeroDimensions<k_regression>::Func(
@@ -562,16 +591,28 @@ extern void BinBoosting(
          // 7,6,5,4,3,2,1 - use a mask to exclude the non-used conditions and process them like the 8.  These are rare since they require more than 256 values
 
          if(IsClassification(runtimeLearningTypeOrCountTargetClasses)) {
-            BinBoostingSIMDTarget<2>::Func(
-               pThreadStateBoosting,
-               pFeatureGroup,
-               pTrainingSet
-            );
+            if(k_cCompilerOptimizedTargetClassesMax < runtimeLearningTypeOrCountTargetClasses) {
+               // there is no compiler optimized version for this many classes, so skip the template chain that looks for one
+               BinBoostingSIMDTarget<k_cCompilerOptimizedTargetClassesMax + 1>::Func(
+                  pThreadStateBoosting,
+                  pFeatureGroup,
+                  aiTensorBinsCoarse,
+                  pTrainingSet
+               );
+            } else {
+               BinBoostingSIMDTarget<2>::Func(
+                  pThreadStateBoosting,
+                  pFeatureGroup,
+                  aiTensorBinsCoarse,
+                  pTrainingSet
+               );
+            }
          } else {
             EBM_ASSERT(IsRegression(runtimeLearningTypeOrCountTargetClasses));
             BinBoostingSIMDPacking<k_regression, k_cItemsPerBitPackedDataUnitMax>::Func(
                pThreadStateBoosting,
                pFeatureGroup,
+               aiTensorBinsCoarse,
                pTrainingSet
             );
          }
@@ -583,16 +624,28 @@ extern void BinBoosting(
          // will exceed the L1 instruction cache size.  With SIMD we do 8 times the work in the same number of instructions so these are lesser issues
 
          if(IsClassification(runtimeLearningTypeOrCountTargetClasses)) {
-            BinBoostingNormalTarget<2>::Func(
-               pThreadStateBoosting,
-               pFeatureGroup,
-               pTrainingSet
-            );
+            if(k_cCompilerOptimizedTargetClassesMax < runtimeLearningTypeOrCountTargetClasses) {
+               // there is no compiler optimized version for this many classes, so skip the template chain that looks for one
+               BinBoostingNormalTarget<k_cCompilerOptimizedTargetClassesMax + 1>::Func(
+                  pThreadStateBoosting,
+                  pFeatureGroup,
+                  aiTensorBinsCoarse,
+                  pTrainingSet
+               );
+            } else {
+               BinBoostingNormalTarget<2>::Func(
+                  pThreadStateBoosting,
+                  pFeatureGroup,
+                  aiTensorBinsCoarse,
+                  pTrainingSet
+               );
+            }
          } else {
             EBM_ASSERT(IsRegression(runtimeLearningTypeOrCountTargetClasses));
             BinBoostingInternal<k_regression, k_cItemsPerBitPackedDataUnitDynamic>::Func(
                pThreadStateBoosting,
                pFeatureGroup,
+               aiTensorBinsCoarse,
                pTrainingSet
             );
          }
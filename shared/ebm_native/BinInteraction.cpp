@@ -10,8 +10,6 @@
 #include "EbmInternal.h" // INLINE_ALWAYS
 #include "Logging.h" // EBM_ASSERT & LOG
 
-#include "EbmStatisticUtils.h"
-
 #include "FeatureAtomic.h"
 #include "FeatureGroup.h"
 #include "DataSetInteraction.h"
@@ -35,12 +33,12 @@ public:
       , const unsigned char * const aHistogramBucketsEndDebug
 #endif // NDEBUG
    ) {
-      constexpr bool bClassification = IsClassification(compilerLearningTypeOrCountTargetClasses);
-
       LOG_0(TraceLevelVerbose, "Entered BinDataSetInteraction");
 
-      HistogramBucket<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const aHistogramBuckets = 
-         aHistogramBucketBase->GetHistogramBucket<bClassification>();
+      // interaction scores only depend on the residual sums and counts, so we bin into the HistogramBucket<false> layout
+      // even for classification.  It lacks the denominator term, so for classification the buckets are about a third
+      // smaller and we skip calling ComputeNewtonRaphsonStep for every sample
+      HistogramBucket<false> * const aHistogramBuckets = aHistogramBucketBase->GetHistogramBucket<false>();
 
       const ptrdiff_t runtimeLearningTypeOrCountTargetClasses = pInteractionDetector->GetRuntimeLearningTypeOrCountTargetClasses();
 
@@ -49,8 +47,8 @@ public:
          runtimeLearningTypeOrCountTargetClasses
       );
       const size_t cVectorLength = GetVectorLength(learningTypeOrCountTargetClasses);
-      EBM_ASSERT(!GetHistogramBucketSizeOverflow(bClassification, cVectorLength)); // we're accessing allocated memory
-      const size_t cBytesPerHistogramBucket = GetHistogramBucketSize(bClassification, cVectorLength);
+      EBM_ASSERT(!GetHistogramBucketSizeOverflow(false, cVectorLength)); // we're accessing allocated memory
+      const size_t cBytesPerHistogramBucket = GetHistogramBucketSize(false, cVectorLength);
 
       const DataSetByFeature * const pDataSet = pInteractionDetector->GetDataSetByFeature();
       const FloatEbmType * pResidualError = pDataSet->GetResidualPointer();
@@ -59,8 +57,21 @@ public:
       EBM_ASSERT(pFeatureGroup->GetCountFeatures() == pFeatureGroup->GetCountSignificantFeatures()); // for interactions, we just return 0 for interactions with zero features
       const size_t cDimensions = GET_ATTRIBUTE_COMBINATION_DIMENSIONS(compilerCountDimensions, pFeatureGroup->GetCountSignificantFeatures());
       EBM_ASSERT(1 <= cDimensions); // for interactions, we just return 0 for interactions with zero features
+      EBM_ASSERT(cDimensions <= k_cDimensionsMax);
+
+      // the features are bit packed independently, so each dimension walks its own data in sample order
+      BitPackedBinReader aBinReaders[k_cDimensionsMax];
+      size_t iDimensionInit = 0;
+      do {
+         const Feature * const pInputFeature = pFeatureGroup->GetFeatureGroupEntries()[iDimensionInit].m_pFeature;
+         aBinReaders[iDimensionInit].Initialize(
+            pDataSet->GetInputDataPointer(pInputFeature),
+            DataSetByFeature::GetCountItemsPerBitPackedDataUnit(pInputFeature)
+         );
+         ++iDimensionInit;
+      } while(iDimensionInit < cDimensions);
 
-      for(size_t iSample = 0; pResidualErrorEnd != pResidualError; ++iSample) {
+      while(pResidualErrorEnd != pResidualError) {
          // this loop gets about twice as slow if you add a single unpredictable branching if statement based on count, even if you still access all the memory
          // in complete sequential order, so we'll probably want to use non-branching instructions for any solution like conditional selection or multiplication
          // this loop gets about 3 times slower if you use a bad pseudo random number generator like rand(), although it might be better if you inlined rand().
@@ -85,23 +96,19 @@ public:
             // we strip dimensions from the tensors with 1 bin, so if 1 bin was accepted here, we'd need to strip
             // the bin too
             EBM_ASSERT(size_t { 2 } <= cBins);
-            const StorageDataType * pInputData = pDataSet->GetInputDataPointer(pInputFeature);
-            pInputData += iSample;
-            StorageDataType iBinOriginal = *pInputData;
-            EBM_ASSERT(IsNumberConvertable<size_t>(iBinOriginal));
-            size_t iBin = static_cast<size_t>(iBinOriginal);
+            const size_t iBin = aBinReaders[iDimension].Next();
             EBM_ASSERT(iBin < cBins);
             iBucket += cBuckets * iBin;
             cBuckets *= cBins;
             ++iDimension;
          } while(iDimension < cDimensions);
 
-         HistogramBucket<bClassification> * pHistogramBucketEntry =
-            GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, aHistogramBuckets, iBucket);
+         HistogramBucket<false> * pHistogramBucketEntry =
+            GetHistogramBucketByIndex<false>(cBytesPerHistogramBucket, aHistogramBuckets, iBucket);
          ASSERT_BINNED_BUCKET_OK(cBytesPerHistogramBucket, pHistogramBucketEntry, aHistogramBucketsEndDebug);
          pHistogramBucketEntry->SetCountSamplesInBucket(pHistogramBucketEntry->GetCountSamplesInBucket() + 1);
 
-         HistogramBucketVectorEntry<bClassification> * const pHistogramBucketVectorEntry =
+         HistogramBucketVectorEntry<false> * const pHistogramBucketVectorEntry =
             pHistogramBucketEntry->GetHistogramBucketVectorEntry();
 
          for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
@@ -109,35 +116,14 @@ public:
             // residualError could be NaN
             // for classification, residualError can be anything from -1 to +1 (it cannot be infinity!)
             // for regression, residualError can be anything from +infinity or -infinity
+            EBM_ASSERT(
+               !IsClassification(compilerLearningTypeOrCountTargetClasses) ||
+               std::isnan(residualError) ||
+               !std::isinf(residualError) &&
+               FloatEbmType { -1 } - k_epsilonResidualError <= residualError && residualError <= FloatEbmType { 1 }
+            );
             pHistogramBucketVectorEntry[iVector].m_sumResidualError += residualError;
             // m_sumResidualError could be NaN, or anything from +infinity or -infinity in the case of regression
-            if(bClassification) {
-               EBM_ASSERT(
-                  std::isnan(residualError) ||
-                  !std::isinf(residualError) && 
-                  FloatEbmType { -1 } - k_epsilonResidualError <= residualError && residualError <= FloatEbmType { 1 }
-                  );
-
-               // TODO : this code gets executed for each SamplingSet set.  I could probably execute it once and then all the SamplingSet
-               //   sets would have this value, but I would need to store the computation in a new memory place, and it might make more sense to calculate this 
-               //   values in the CPU rather than put more pressure on memory.  I think controlling this should be done in a MACRO and we should use a class to 
-               //   hold the residualError and this computation from that value and then comment out the computation if not necssary and access it through an 
-               //   accessor so that we can make the change entirely via macro
-               const FloatEbmType denominator = EbmStatistics::ComputeNewtonRaphsonStep(residualError);
-               EBM_ASSERT(
-                  std::isnan(denominator) ||
-                  !std::isinf(denominator) && -k_epsilonResidualError <= denominator && denominator <= FloatEbmType { 0.25 }
-               ); // since any one denominatory is limited to -1 <= denominator <= 1, the sum must be representable by a 64 bit number, 
-
-               const FloatEbmType oldDenominator = pHistogramBucketVectorEntry[iVector].GetSumDenominator();
-               // since any one denominatory is limited to -1 <= denominator <= 1, the sum must be representable by a 64 bit number, 
-               EBM_ASSERT(std::isnan(oldDenominator) || !std::isinf(oldDenominator) && -k_epsilonResidualError <= oldDenominator);
-               const FloatEbmType newDenominator = oldDenominator + denominator;
-               // since any one denominatory is limited to -1 <= denominator <= 1, the sum must be representable by a 64 bit number, 
-               EBM_ASSERT(std::isnan(newDenominator) || !std::isinf(newDenominator) && -k_epsilonResidualError <= newDenominator);
-               // which will always be representable by a float or double, so we can't overflow to inifinity or -infinity
-               pHistogramBucketVectorEntry[iVector].SetSumDenominator(newDenominator);
-            }
             ++pResidualError;
          }
       }
@@ -299,7 +285,29 @@ extern void BinInteraction(
    const ptrdiff_t runtimeLearningTypeOrCountTargetClasses = pInteractionDetector->GetRuntimeLearningTypeOrCountTargetClasses();
 
    if(IsClassification(runtimeLearningTypeOrCountTargetClasses)) {
-      BinInteractionTarget<2>::Func(
+      if(k_cCompilerOptimizedTargetClassesMax < runtimeLearningTypeOrCountTargetClasses) {
+         // there is no compiler optimized version for this many classes, so skip the template chain that looks for one
+         BinInteractionTarget<k_cCompilerOptimizedTargetClassesMax + 1>::Func(
+            pInteractionDetector,
+            pFeatureGroup,
+            aHistogramBuckets
+#ifndef NDEBUG
+            , aHistogramBucketsEndDebug
+#endif // NDEBUG
+         );
+      } else {
+         BinInteractionTarget<2>::Func(
+            pInteractionDetector,
+            pFeatureGroup,
+            aHistogramBuckets
+#ifndef NDEBUG
+            , aHistogramBucketsEndDebug
+#endif // NDEBUG
+         );
+      }
+   } else {
+      EBM_ASSERT(IsRegression(runtimeLearningTypeOrCountTargetClasses));
+      BinInteractionDimensions<k_regression, 2>::Func(
          pInteractionDetector,
          pFeatureGroup,
          aHistogramBuckets
@@ -307,12 +315,219 @@ extern void BinInteraction(
          , aHistogramBucketsEndDebug
 #endif // NDEBUG
       );
+   }
+}
+
+// Builds the histograms of many pairs in one pass over the samples.  All the pairs share the anchor feature in their first dimension, so for 
+// each sample we load the residuals and the anchor bin once and then scatter them into every pair's histogram.  This replaces one full pass 
+// over the residuals per pair with one pass per group of pairs.  The residuals are added to each bucket in sample order, so the histograms are 
+// identical to the ones that BinInteraction builds.
+template<ptrdiff_t compilerLearningTypeOrCountTargetClasses>
+class BinInteractionSharedInternal final {
+public:
+
+   BinInteractionSharedInternal() = delete; // this is a static class.  Do not construct
+
+   static void Func(
+      InteractionDetector * const pInteractionDetector,
+      const size_t cPairs,
+      const FeatureGroup * const * const apFeatureGroups,
+      HistogramBucketBase * const * const apHistogramBuckets
+#ifndef NDEBUG
+      , const unsigned char * const aHistogramBucketsEndDebug
+#endif // NDEBUG
+   ) {
+      LOG_0(TraceLevelVerbose, "Entered BinInteractionSharedInternal");
+
+      EBM_ASSERT(1 <= cPairs);
+      EBM_ASSERT(cPairs <= k_cPairsSharedScanMax);
+
+      const ptrdiff_t runtimeLearningTypeOrCountTargetClasses = pInteractionDetector->GetRuntimeLearningTypeOrCountTargetClasses();
+
+      const ptrdiff_t learningTypeOrCountTargetClasses = GET_LEARNING_TYPE_OR_COUNT_TARGET_CLASSES(
+         compilerLearningTypeOrCountTargetClasses,
+         runtimeLearningTypeOrCountTargetClasses
+      );
+      const size_t cVectorLength = GetVectorLength(learningTypeOrCountTargetClasses);
+      EBM_ASSERT(!GetHistogramBucketSizeOverflow(false, cVectorLength)); // we're accessing allocated memory
+      const size_t cBytesPerHistogramBucket = GetHistogramBucketSize(false, cVectorLength);
+
+      const DataSetByFeature * const pDataSet = pInteractionDetector->GetDataSetByFeature();
+
+      const Feature * const pFeatureAnchor = apFeatureGroups[0]->GetFeatureGroupEntries()[0].m_pFeature;
+      const size_t cBinsAnchor = pFeatureAnchor->GetCountBins();
+      EBM_ASSERT(size_t { 2 } <= cBinsAnchor);
+      BitPackedBinReader binReaderAnchor;
+      binReaderAnchor.Initialize(
+         pDataSet->GetInputDataPointer(pFeatureAnchor),
+         DataSetByFeature::GetCountItemsPerBitPackedDataUnit(pFeatureAnchor)
+      );
+
+      BitPackedBinReader aBinReadersOther[k_cPairsSharedScanMax];
+      HistogramBucket<false> * aaHistogramBuckets[k_cPairsSharedScanMax];
+      for(size_t iPair = 0; iPair < cPairs; ++iPair) {
+         const FeatureGroup * const pFeatureGroup = apFeatureGroups[iPair];
+         EBM_ASSERT(2 == pFeatureGroup->GetCountFeatures());
+         EBM_ASSERT(2 == pFeatureGroup->GetCountSignificantFeatures());
+         EBM_ASSERT(pFeatureAnchor == pFeatureGroup->GetFeatureGroupEntries()[0].m_pFeature);
+         const Feature * const pFeatureOther = pFeatureGroup->GetFeatureGroupEntries()[1].m_pFeature;
+         EBM_ASSERT(size_t { 2 } <= pFeatureOther->GetCountBins());
+         aBinReadersOther[iPair].Initialize(
+            pDataSet->GetInputDataPointer(pFeatureOther),
+            DataSetByFeature::GetCountItemsPerBitPackedDataUnit(pFeatureOther)
+         );
+         aaHistogramBuckets[iPair] = apHistogramBuckets[iPair]->GetHistogramBucket<false>();
+      }
+
+      const FloatEbmType * pResidualError = pDataSet->GetResidualPointer();
+      const size_t cSamples = pDataSet->GetCountSamples();
+      for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+         const size_t iBinAnchor = binReaderAnchor.Next();
+         EBM_ASSERT(iBinAnchor < cBinsAnchor);
+
+         for(size_t iPair = 0; iPair < cPairs; ++iPair) {
+            const size_t iBinOther = aBinReadersOther[iPair].Next();
+            EBM_ASSERT(iBinOther < apFeatureGroups[iPair]->GetFeatureGroupEntries()[1].m_pFeature->GetCountBins());
+            // the first feature in a FeatureGroup has a stride of 1, so this is the same index that BinInteraction computes
+            const size_t iBucket = iBinAnchor + cBinsAnchor * iBinOther;
+
+            HistogramBucket<false> * const pHistogramBucketEntry =
+               GetHistogramBucketByIndex<false>(cBytesPerHistogramBucket, aaHistogramBuckets[iPair], iBucket);
+            ASSERT_BINNED_BUCKET_OK(cBytesPerHistogramBucket, pHistogramBucketEntry, aHistogramBucketsEndDebug);
+            pHistogramBucketEntry->SetCountSamplesInBucket(pHistogramBucketEntry->GetCountSamplesInBucket() + 1);
+
+            HistogramBucketVectorEntry<false> * const pHistogramBucketVectorEntry =
+               pHistogramBucketEntry->GetHistogramBucketVectorEntry();
+            for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
+               // residualError could be NaN, or anything from +infinity or -infinity in the case of regression
+               pHistogramBucketVectorEntry[iVector].m_sumResidualError += pResidualError[iVector];
+            }
+         }
+         pResidualError += cVectorLength;
+      }
+      LOG_0(TraceLevelVerbose, "Exited BinInteractionSharedInternal");
+   }
+};
+
+template<ptrdiff_t compilerLearningTypeOrCountTargetClassesPossible>
+class BinInteractionSharedTarget final {
+public:
+
+   BinInteractionSharedTarget() = delete; // this is a static class.  Do not construct
+
+   INLINE_ALWAYS static void Func(
+      InteractionDetector * const pInteractionDetector,
+      const size_t cPairs,
+      const FeatureGroup * const * const apFeatureGroups,
+      HistogramBucketBase * const * const apHistogramBuckets
+#ifndef NDEBUG
+      , const unsigned char * const aHistogramBucketsEndDebug
+#endif // NDEBUG
+   ) {
+      static_assert(IsClassification(compilerLearningTypeOrCountTargetClassesPossible), "compilerLearningTypeOrCountTargetClassesPossible needs to be a classification");
+      static_assert(compilerLearningTypeOrCountTargetClassesPossible <= k_cCompilerOptimizedTargetClassesMax, "We can't have this many items in a data pack.");
+
+      const ptrdiff_t runtimeLearningTypeOrCountTargetClasses = pInteractionDetector->GetRuntimeLearningTypeOrCountTargetClasses();
+      EBM_ASSERT(IsClassification(runtimeLearningTypeOrCountTargetClasses));
+      EBM_ASSERT(runtimeLearningTypeOrCountTargetClasses <= k_cCompilerOptimizedTargetClassesMax);
+
+      if(compilerLearningTypeOrCountTargetClassesPossible == runtimeLearningTypeOrCountTargetClasses) {
+         BinInteractionSharedInternal<compilerLearningTypeOrCountTargetClassesPossible>::Func(
+            pInteractionDetector,
+            cPairs,
+            apFeatureGroups,
+            apHistogramBuckets
+#ifndef NDEBUG
+            , aHistogramBucketsEndDebug
+#endif // NDEBUG
+         );
+      } else {
+         BinInteractionSharedTarget<compilerLearningTypeOrCountTargetClassesPossible + 1>::Func(
+            pInteractionDetector,
+            cPairs,
+            apFeatureGroups,
+            apHistogramBuckets
+#ifndef NDEBUG
+            , aHistogramBucketsEndDebug
+#endif // NDEBUG
+         );
+      }
+   }
+};
+
+template<>
+class BinInteractionSharedTarget<k_cCompilerOptimizedTargetClassesMax + 1> final {
+public:
+
+   BinInteractionSharedTarget() = delete; // this is a static class.  Do not construct
+
+   INLINE_ALWAYS static void Func(
+      InteractionDetector * const pInteractionDetector,
+      const size_t cPairs,
+      const FeatureGroup * const * const apFeatureGroups,
+      HistogramBucketBase * const * const apHistogramBuckets
+#ifndef NDEBUG
+      , const unsigned char * const aHistogramBucketsEndDebug
+#endif // NDEBUG
+   ) {
+      static_assert(IsClassification(k_cCompilerOptimizedTargetClassesMax), "k_cCompilerOptimizedTargetClassesMax needs to be a classification");
+
+      EBM_ASSERT(IsClassification(pInteractionDetector->GetRuntimeLearningTypeOrCountTargetClasses()));
+      EBM_ASSERT(k_cCompilerOptimizedTargetClassesMax < pInteractionDetector->GetRuntimeLearningTypeOrCountTargetClasses());
+
+      BinInteractionSharedInternal<k_dynamicClassification>::Func(
+         pInteractionDetector,
+         cPairs,
+         apFeatureGroups,
+         apHistogramBuckets
+#ifndef NDEBUG
+         , aHistogramBucketsEndDebug
+#endif // NDEBUG
+      );
+   }
+};
+
+extern void BinInteractionShared(
+   InteractionDetector * const pInteractionDetector,
+   const size_t cPairs,
+   const FeatureGroup * const * const apFeatureGroups,
+   HistogramBucketBase * const * const apHistogramBuckets
+#ifndef NDEBUG
+   , const unsigned char * const aHistogramBucketsEndDebug
+#endif // NDEBUG
+) {
+   const ptrdiff_t runtimeLearningTypeOrCountTargetClasses = pInteractionDetector->GetRuntimeLearningTypeOrCountTargetClasses();
+
+   if(IsClassification(runtimeLearningTypeOrCountTargetClasses)) {
+      if(k_cCompilerOptimizedTargetClassesMax < runtimeLearningTypeOrCountTargetClasses) {
+         // there is no compiler optimized version for this many classes, so skip the template chain that looks for one
+         BinInteractionSharedTarget<k_cCompilerOptimizedTargetClassesMax + 1>::Func(
+            pInteractionDetector,
+            cPairs,
+            apFeatureGroups,
+            apHistogramBuckets
+#ifndef NDEBUG
+            , aHistogramBucketsEndDebug
+#endif // NDEBUG
+         );
+      } else {
+         BinInteractionSharedTarget<2>::Func(
+            pInteractionDetector,
+            cPairs,
+            apFeatureGroups,
+            apHistogramBuckets
+#ifndef NDEBUG
+            , aHistogramBucketsEndDebug
+#endif // NDEBUG
+         );
+      }
    } else {
       EBM_ASSERT(IsRegression(runtimeLearningTypeOrCountTargetClasses));
-      BinInteractionDimensions<k_regression, 2>::Func(
+      BinInteractionSharedInternal<k_regression>::Func(
          pInteractionDetector,
-         pFeatureGroup,
-         aHistogramBuckets
+         cPairs,
+         apFeatureGroups,
+         apHistogramBuckets
 #ifndef NDEBUG
          , aHistogramBucketsEndDebug
 #endif // NDEBUG
@@ -0,0 +1,331 @@
+// Copyright (c) 2018 Microsoft Corporation
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#include "PrecompiledHeader.h"
+
+#include <stdlib.h> // free
+#include <stddef.h> // size_t, ptrdiff_t
+#include <string.h> // memcpy
+#include <limits> // std::numeric_limits
+
+#include "ebm_native.h"
+#include "EbmInternal.h"
+#include "Logging.h" // EBM_ASSERT & LOG
+
+// a fine bin can't hold this many samples since the samples themselves need memory, so we use it to mark the fine bins that end a coarse bin
+constexpr size_t k_fineBinEndsCoarseBin = std::numeric_limits<size_t>::max();
+
+// Every coarse cut is one of the fine cuts, so calling Discretize on the original feature values with the coarse cuts gives exactly the
+// coarse bins that we write into aCoarseDiscretizedOut.  We never need the original feature values because the fine bin counts tell us
+// everything we need to know about how the samples are spread across the cuts that we're able to keep.
+//
+// We choose the cuts greedily from left to right.  Each time we place a cut we spread the samples that remain to the right of it evenly
+// across the coarse bins that we still have left, which keeps the coarse bins balanced even after a heavy fine bin forces one coarse bin
+// to be larger than its share.  At each target we keep whichever of the two fine boundaries that straddle it is closer.
+static bool CoarsenBins(
+   const size_t cSamples,
+   const IntEbmType * const aDiscretized,
+   const size_t cCuts,
+   const FloatEbmType * const aCutsLowerBoundInclusive,
+   const size_t cSamplesPerBinMin,
+   const size_t cCoarseCutsMax,
+   size_t * const pcCoarseCutsOut,
+   FloatEbmType * const aCoarseCutsLowerBoundInclusiveOut,
+   IntEbmType * const aCoarseDiscretizedOut
+) {
+   EBM_ASSERT(size_t { 1 } <= cSamples);
+   EBM_ASSERT(nullptr != aDiscretized);
+   EBM_ASSERT(cCoarseCutsMax < cCuts);
+   EBM_ASSERT(nullptr != aCutsLowerBoundInclusive);
+   EBM_ASSERT(size_t { 1 } <= cSamplesPerBinMin);
+   EBM_ASSERT(nullptr != pcCoarseCutsOut);
+
+   // index 0 is the missing bin, and the non-missing bins are 1 through cCuts + 1
+   const size_t cFineBins = cCuts + size_t { 2 };
+   if(UNLIKELY(cFineBins < cCuts)) {
+      LOG_0(TraceLevelError, "ERROR CoarsenBins cFineBins < cCuts");
+      return true;
+   }
+
+   // we convert the fine bin counts in place into the coarse bin index of each fine bin once we've chosen our cuts
+   size_t * const aFineBins = EbmMalloc<size_t>(cFineBins);
+   if(UNLIKELY(nullptr == aFineBins)) {
+      LOG_0(TraceLevelWarning, "WARNING CoarsenBins nullptr == aFineBins");
+      return true;
+   }
+   for(size_t iFineBin = 0; iFineBin < cFineBins; ++iFineBin) {
+      aFineBins[iFineBin] = 0;
+   }
+
+   const IntEbmType * pDiscretized = aDiscretized;
+   const IntEbmType * const pDiscretizedEnd = aDiscretized + cSamples;
+   do {
+      const IntEbmType iFineBin = *pDiscretized;
+      if(UNLIKELY(iFineBin < IntEbmType { 0 })) {
+         LOG_0(TraceLevelError, "ERROR CoarsenBins discretized value cannot be negative");
+         free(aFineBins);
+         return true;
+      }
+      if(UNLIKELY(!IsNumberConvertable<size_t>(iFineBin) || cFineBins <= static_cast<size_t>(iFineBin))) {
+         LOG_0(TraceLevelError, "ERROR CoarsenBins discretized value must be less than countCuts + 2");
+         free(aFineBins);
+         return true;
+      }
+      ++aFineBins[static_cast<size_t>(iFineBin)];
+      ++pDiscretized;
+   } while(pDiscretizedEnd != pDiscretized);
+
+   const size_t cNonMissing = cSamples - aFineBins[0];
+
+   size_t cCoarseCuts = 0;
+   size_t cSamplesLeftOfLastCut = 0;
+   size_t cSamplesLeftOfPrevBoundary = 0;
+   size_t iPrevBoundary = 0; // boundary i sits between fine bins i and i + 1, so 0 means we have no previous boundary to fall back to
+   size_t iBoundary = 1;
+   size_t cSamplesLeftOfBoundary = aFineBins[1];
+   while(iBoundary <= cCuts && cCoarseCuts < cCoarseCutsMax) {
+      const size_t cCoarseBinsRemaining = cCoarseCutsMax - cCoarseCuts + size_t { 1 };
+      const FloatEbmType target = static_cast<FloatEbmType>(cSamplesLeftOfLastCut) +
+         static_cast<FloatEbmType>(cNonMissing - cSamplesLeftOfLastCut) / static_cast<FloatEbmType>(cCoarseBinsRemaining);
+
+      const bool bRightLegal = cSamplesPerBinMin <= cNonMissing - cSamplesLeftOfBoundary;
+      if(bRightLegal && static_cast<FloatEbmType>(cSamplesLeftOfBoundary) < target) {
+         iPrevBoundary = iBoundary;
+         cSamplesLeftOfPrevBoundary = cSamplesLeftOfBoundary;
+         ++iBoundary;
+         cSamplesLeftOfBoundary += aFineBins[iBoundary];
+         continue;
+      }
+
+      // we've reached the target, or no boundary further right can leave enough samples in the last bin
+      const bool bBoundaryLegal = bRightLegal && cSamplesPerBinMin <= cSamplesLeftOfBoundary - cSamplesLeftOfLastCut;
+      const bool bPrevLegal = size_t { 0 } != iPrevBoundary &&
+         cSamplesPerBinMin <= cSamplesLeftOfPrevBoundary - cSamplesLeftOfLastCut &&
+         cSamplesPerBinMin <= cNonMissing - cSamplesLeftOfPrevBoundary;
+
+      size_t iCutBoundary;
+      size_t cSamplesLeftOfCut;
+      if(bPrevLegal && (!bBoundaryLegal || 
+         target - static_cast<FloatEbmType>(cSamplesLeftOfPrevBoundary) < static_cast<FloatEbmType>(cSamplesLeftOfBoundary) - target)
+      ) {
+         iCutBoundary = iPrevBoundary;
+         cSamplesLeftOfCut = cSamplesLeftOfPrevBoundary;
+      } else if(bBoundaryLegal) {
+         iCutBoundary = iBoundary;
+         cSamplesLeftOfCut = cSamplesLeftOfBoundary;
+      } else if(!bRightLegal) {
+         // every boundary from here on leaves too few samples on the right
+         break;
+      } else {
+         // the bin that this boundary would close doesn't have enough samples yet
+         iPrevBoundary = iBoundary;
+         cSamplesLeftOfPrevBoundary = cSamplesLeftOfBoundary;
+         ++iBoundary;
+         cSamplesLeftOfBoundary += aFineBins[iBoundary];
+         continue;
+      }
+
+      if(nullptr != aCoarseCutsLowerBoundInclusiveOut) {
+         aCoarseCutsLowerBoundInclusiveOut[cCoarseCuts] = aCutsLowerBoundInclusive[iCutBoundary - size_t { 1 }];
+      }
+      ++cCoarseCuts;
+      // mark the fine bin to the left of the cut as the end of its coarse bin.  We never read the counts of bins left of the cut again
+      aFineBins[iCutBoundary] = k_fineBinEndsCoarseBin;
+      cSamplesLeftOfLastCut = cSamplesLeftOfCut;
+      // anything left of our new cut can't be a fallback for the next target
+      iPrevBoundary = 0;
+      if(iCutBoundary == iBoundary) {
+         ++iBoundary;
+         cSamplesLeftOfBoundary += aFineBins[iBoundary];
+      }
+   }
+   *pcCoarseCutsOut = cCoarseCuts;
+
+   if(nullptr != aCoarseDiscretizedOut) {
+      // convert the fine bins into the coarse bin index that each fine bin belongs to.  The missing bin stays at 0
+      aFineBins[0] = 0;
+      size_t iCoarseBin = 1;
+      for(size_t iFineBin = 1; iFineBin < cFineBins; ++iFineBin) {
+         const bool bCutAfter = k_fineBinEndsCoarseBin == aFineBins[iFineBin];
+         aFineBins[iFineBin] = iCoarseBin;
+         if(bCutAfter) {
+            ++iCoarseBin;
+         }
+      }
+      EBM_ASSERT(cCoarseCuts + size_t { 1 } == iCoarseBin);
+
+      pDiscretized = aDiscretized;
+      IntEbmType * pCoarseDiscretized = aCoarseDiscretizedOut;
+      do {
+         *pCoarseDiscretized = static_cast<IntEbmType>(aFineBins[static_cast<size_t>(*pDiscretized)]);
+         ++pCoarseDiscretized;
+         ++pDiscretized;
+      } while(pDiscretizedEnd != pDiscretized);
+   }
+
+   free(aFineBins);
+   return false;
+}
+
+// we don't care if an extra log message is outputted due to the non-atomic nature of the decrement to this value
+static int g_cLogEnterGenerateCoarseCutsParametersMessages = 25;
+static int g_cLogExitGenerateCoarseCutsParametersMessages = 25;
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION GenerateCoarseCuts(
+   IntEbmType countSamples,
+   const IntEbmType * discretized,
+   IntEbmType countCuts,
+   const FloatEbmType * cutsLowerBoundInclusive,
+   IntEbmType countSamplesPerBinMin,
+   IntEbmType * countCoarseCutsInOut,
+   FloatEbmType * coarseCutsLowerBoundInclusiveOut,
+   IntEbmType * coarseDiscretizedOut
+) {
+   LOG_COUNTED_N(
+      &g_cLogEnterGenerateCoarseCutsParametersMessages,
+      TraceLevelInfo,
+      TraceLevelVerbose,
+      "Entered GenerateCoarseCuts: "
+      "countSamples=%" IntEbmTypePrintf ", "
+      "discretized=%p, "
+      "countCuts=%" IntEbmTypePrintf ", "
+      "cutsLowerBoundInclusive=%p, "
+      "countSamplesPerBinMin=%" IntEbmTypePrintf ", "
+      "countCoarseCutsInOut=%p, "
+      "coarseCutsLowerBoundInclusiveOut=%p, "
+      "coarseDiscretizedOut=%p"
+      ,
+      countSamples,
+      static_cast<const void *>(discretized),
+      countCuts,
+      static_cast<const void *>(cutsLowerBoundInclusive),
+      countSamplesPerBinMin,
+      static_cast<void *>(countCoarseCutsInOut),
+      static_cast<void *>(coarseCutsLowerBoundInclusiveOut),
+      static_cast<void *>(coarseDiscretizedOut)
+   );
+
+   IntEbmType countCoarseCutsRet = IntEbmType { 0 };
+   IntEbmType ret;
+
+   if(UNLIKELY(nullptr == countCoarseCutsInOut)) {
+      LOG_0(TraceLevelError, "ERROR GenerateCoarseCuts nullptr == countCoarseCutsInOut");
+      ret = IntEbmType { 1 };
+      goto exit_without_count;
+   }
+   if(UNLIKELY(*countCoarseCutsInOut < IntEbmType { 0 })) {
+      LOG_0(TraceLevelError, "ERROR GenerateCoarseCuts *countCoarseCutsInOut cannot be negative");
+      ret = IntEbmType { 1 };
+      goto exit_with_log;
+   }
+   if(UNLIKELY(countCuts < IntEbmType { 0 })) {
+      LOG_0(TraceLevelError, "ERROR GenerateCoarseCuts countCuts cannot be negative");
+      ret = IntEbmType { 1 };
+      goto exit_with_log;
+   }
+   if(UNLIKELY(!IsNumberConvertable<size_t>(countCuts))) {
+      LOG_0(TraceLevelError, "ERROR GenerateCoarseCuts countCuts was too large to fit into memory");
+      ret = IntEbmType { 1 };
+      goto exit_with_log;
+   }
+   if(UNLIKELY(IntEbmType { 0 } != countCuts && nullptr == cutsLowerBoundInclusive)) {
+      LOG_0(TraceLevelError, "ERROR GenerateCoarseCuts cutsLowerBoundInclusive cannot be null if 0 < countCuts");
+      ret = IntEbmType { 1 };
+      goto exit_with_log;
+   }
+   if(UNLIKELY(countSamples < IntEbmType { 0 })) {
+      LOG_0(TraceLevelError, "ERROR GenerateCoarseCuts countSamples cannot be negative");
+      ret = IntEbmType { 1 };
+      goto exit_with_log;
+   }
+   if(UNLIKELY(!IsNumberConvertable<size_t>(countSamples))) {
+      LOG_0(TraceLevelError, "ERROR GenerateCoarseCuts countSamples was too large to fit into memory");
+      ret = IntEbmType { 1 };
+      goto exit_with_log;
+   }
+   if(UNLIKELY(IntEbmType { 0 } != countSamples && nullptr == discretized)) {
+      LOG_0(TraceLevelError, "ERROR GenerateCoarseCuts discretized cannot be null if 0 < countSamples");
+      ret = IntEbmType { 1 };
+      goto exit_with_log;
+   }
+
+   {
+      const size_t cSamples = static_cast<size_t>(countSamples);
+      const size_t cCuts = static_cast<size_t>(countCuts);
+      if(IsMultiplyError(sizeof(*discretized), cSamples)) {
+         LOG_0(TraceLevelError, "ERROR GenerateCoarseCuts countSamples was too large to fit into discretized");
+         ret = IntEbmType { 1 };
+         goto exit_with_log;
+      }
+
+      if(UNLIKELY(countCuts <= *countCoarseCutsInOut)) {
+         // the fine cuts already fit within the number of coarse cuts allowed, so the coarse binning is the fine binning
+         if(nullptr != coarseCutsLowerBoundInclusiveOut && size_t { 0 } != cCuts) {
+            memcpy(coarseCutsLowerBoundInclusiveOut, cutsLowerBoundInclusive, sizeof(*cutsLowerBoundInclusive) * cCuts);
+         }
+         if(nullptr != coarseDiscretizedOut && size_t { 0 } != cSamples) {
+            memcpy(coarseDiscretizedOut, discretized, sizeof(*discretized) * cSamples);
+         }
+         countCoarseCutsRet = countCuts;
+         ret = IntEbmType { 0 };
+         goto exit_with_log;
+      }
+
+      if(UNLIKELY(size_t { 0 } == cSamples)) {
+         // without samples there is no basis for choosing any cuts
+         ret = IntEbmType { 0 };
+         goto exit_with_log;
+      }
+
+      size_t cSamplesPerBinMin = size_t { 1 };
+      if(IntEbmType { 1 } <= countSamplesPerBinMin) {
+         cSamplesPerBinMin = static_cast<size_t>(countSamplesPerBinMin);
+         if(!IsNumberConvertable<size_t>(countSamplesPerBinMin)) {
+            // we can never exceed a size_t number of samples, so we can't make any cuts
+            cSamplesPerBinMin = std::numeric_limits<size_t>::max();
+         }
+      } else {
+         LOG_0(TraceLevelWarning, "WARNING GenerateCoarseCuts countSamplesPerBinMin can't be less than 1.  Adjusting to 1.");
+      }
+
+      size_t cCoarseCuts;
+      if(CoarsenBins(
+         cSamples,
+         discretized,
+         cCuts,
+         cutsLowerBoundInclusive,
+         cSamplesPerBinMin,
+         static_cast<size_t>(*countCoarseCutsInOut),
+         &cCoarseCuts,
+         coarseCutsLowerBoundInclusiveOut,
+         coarseDiscretizedOut
+      )) {
+         ret = IntEbmType { 1 };
+         goto exit_with_log;
+      }
+      countCoarseCutsRet = static_cast<IntEbmType>(cCoarseCuts);
+      ret = IntEbmType { 0 };
+   }
+
+exit_with_log:;
+
+   EBM_ASSERT(nullptr != countCoarseCutsInOut);
+   *countCoarseCutsInOut = countCoarseCutsRet;
+
+exit_without_count:;
+
+   LOG_COUNTED_N(
+      &g_cLogExitGenerateCoarseCutsParametersMessages,
+      TraceLevelInfo,
+      TraceLevelVerbose,
+      "Exited GenerateCoarseCuts: "
+      "countCoarseCuts=%" IntEbmTypePrintf ", "
+      "return=%" IntEbmTypePrintf
+      ,
+      countCoarseCutsRet,
+      ret
+   );
+
+   return ret;
+}
@@ -8,15 +8,15 @@
 #include <limits> // std::numeric_limits
 #include <algorithm> // std::sort
 #include <cmath> // std::round
-#include <vector> // std::vector (used in std::priority_queue)
-#include <queue> // std::priority_queue
-#include <set> // std::set
 #include <string.h> // strchr, memmove
+#include <atomic>
 
 #include "ebm_native.h"
 #include "EbmInternal.h"
 #include "Logging.h" // EBM_ASSERT & LOG
 #include "RandomStream.h"
+#include "ParallelWork.h"
+#include "QuantileSketch.h"
 
 //#define LOG_SUPERVERBOSE_DISCRETIZATION_ORDERED
 //#define LOG_SUPERVERBOSE_DISCRETIZATION_UNORDERED
@@ -53,6 +53,12 @@ extern FloatEbmType GetInterpretableEndpoint(
    const FloatEbmType movementFromEnds
 ) noexcept;
 
+extern void SortFeatureValues(
+   const size_t cSamples,
+   FloatEbmType * const aValues,
+   FloatEbmType * const aScratch
+) noexcept;
+
 extern size_t RemoveMissingValuesAndReplaceInfinities(
    size_t cSamples,
    FloatEbmType * const aValues,
@@ -118,6 +124,9 @@ struct CutPoint final {
    // comparing two Cuts that have the same distance to their endpoints
    size_t         m_uniqueTiebreaker;
 
+   // our position within the IntrusiveHeap of cuts that haven't been decided yet
+   size_t         m_iHeap;
+
    INLINE_ALWAYS void SetCut() noexcept {
       m_cPredeterminedMovementOnCut = k_movementDoneCut;
    }
@@ -169,6 +178,9 @@ struct CuttingRange final {
 
    FloatEbmType   m_avgCuttableRangeWidthAfterAddingOneCut;
    size_t         m_cRangesMax;
+
+   // our position within the IntrusiveHeap of CuttingRanges that can accept more cuts
+   size_t         m_iHeap;
 };
 static_assert(std::is_standard_layout<CuttingRange>::value,
    "We use the struct hack in several places, so disallow non-standard_layout types in general");
@@ -208,6 +220,131 @@ public:
    }
 };
 
+// A binary heap of pointers to items that each record their own position in the heap within m_iHeap.  Knowing
+// the position lets us remove an item, or fix the heap after an item's priority changes, in O(log N) without
+// searching for it.  TCompare returns true when lhs should come out of the heap before rhs, so GetTop returns the
+// item that would be first if we sorted all the items with TCompare.
+// The heap never allocates.  The caller supplies an array with room for every item that will be in the heap
+// at the same time, which lets us carve the heap out of the same allocation as the items themselves.
+template<typename T, typename TCompare>
+struct IntrusiveHeap final {
+
+   IntrusiveHeap() = default; // preserve our POD status
+   ~IntrusiveHeap() = default; // preserve our POD status
+   void * operator new(std::size_t) = delete; // we only use malloc/free in this library
+   void operator delete (void *) = delete; // we only use malloc/free in this library
+
+   T **     m_apItems;
+   size_t   m_cItems;
+
+   INLINE_ALWAYS void Initialize(T ** const apItems) noexcept {
+      EBM_ASSERT(nullptr != apItems);
+      m_apItems = apItems;
+      m_cItems = size_t { 0 };
+   }
+
+   INLINE_ALWAYS bool IsEmpty() const noexcept {
+      return size_t { 0 } == m_cItems;
+   }
+
+   INLINE_ALWAYS T * GetTop() const noexcept {
+      EBM_ASSERT(!IsEmpty());
+      return m_apItems[0];
+   }
+
+   INLINE_ALWAYS bool IsContained(const T * const pItem) const noexcept {
+      // items that were removed keep their stale m_iHeap, but their old slot is either beyond the end or 
+      // was filled by a different item
+      return pItem->m_iHeap < m_cItems && pItem == m_apItems[pItem->m_iHeap];
+   }
+
+   INLINE_ALWAYS void Push(T * const pItem) noexcept {
+      SiftUp(m_cItems, pItem);
+      ++m_cItems;
+   }
+
+   void Remove(T * const pItem) noexcept {
+      EBM_ASSERT(IsContained(pItem));
+      --m_cItems;
+      const size_t iHole = pItem->m_iHeap;
+      if(LIKELY(iHole != m_cItems)) {
+         // move our last item into the hole.  It can belong either above or below the hole
+         Reposition(iHole, m_apItems[m_cItems]);
+      }
+   }
+
+   // call after changing anything that affects the position of pItem in the TCompare ordering.  This is
+   // the decrease-key (and increase-key) operation that we'd otherwise need an erase and insert to achieve
+   INLINE_ALWAYS void Update(T * const pItem) noexcept {
+      EBM_ASSERT(IsContained(pItem));
+      Reposition(pItem->m_iHeap, pItem);
+   }
+
+private:
+
+   INLINE_ALWAYS void Reposition(const size_t iHole, T * const pItem) noexcept {
+      const TCompare compare;
+      if(size_t { 0 } != iHole && compare(pItem, m_apItems[(iHole - size_t { 1 }) >> 1])) {
+         SiftUp(iHole, pItem);
+      } else {
+         SiftDown(iHole, pItem);
+      }
+   }
+
+   void SiftUp(size_t iHole, T * const pItem) noexcept {
+      const TCompare compare;
+      while(size_t { 0 } != iHole) {
+         const size_t iParent = (iHole - size_t { 1 }) >> 1;
+         T * const pParent = m_apItems[iParent];
+         if(!compare(pItem, pParent)) {
+            break;
+         }
+         m_apItems[iHole] = pParent;
+         pParent->m_iHeap = iHole;
+         iHole = iParent;
+      }
+      m_apItems[iHole] = pItem;
+      pItem->m_iHeap = iHole;
+   }
+
+   void SiftDown(size_t iHole, T * const pItem) noexcept {
+      const TCompare compare;
+      const size_t cItems = m_cItems;
+      while(true) {
+         size_t iChild = (iHole << 1) + size_t { 1 };
+         if(cItems <= iChild) {
+            break;
+         }
+         T * pChild = m_apItems[iChild];
+         const size_t iChildRight = iChild + size_t { 1 };
+         if(iChildRight < cItems) {
+            T * const pChildRight = m_apItems[iChildRight];
+            if(compare(pChildRight, pChild)) {
+               iChild = iChildRight;
+               pChild = pChildRight;
+            }
+         }
+         if(!compare(pChild, pItem)) {
+            break;
+         }
+         m_apItems[iHole] = pChild;
+         pChild->m_iHeap = iHole;
+         iHole = iChild;
+      }
+      m_apItems[iHole] = pItem;
+      pItem->m_iHeap = iHole;
+   }
+};
+static_assert(std::is_standard_layout<IntrusiveHeap<CutPoint, CompareCutPoint>>::value,
+   "We use the struct hack in several places, so disallow non-standard_layout types in general");
+static_assert(std::is_trivial<IntrusiveHeap<CutPoint, CompareCutPoint>>::value,
+   "We use memcpy in several places, so disallow non-trivial types in general");
+static_assert(std::is_pod<IntrusiveHeap<CutPoint, CompareCutPoint>>::value,
+   "We use a lot of C constructs, so disallow non-POD types in general");
+
+typedef IntrusiveHeap<CutPoint, CompareCutPoint> CutPointHeap;
+typedef IntrusiveHeap<CuttingRange, CompareCuttingRange> CuttingRangeHeap;
+
 INLINE_RELEASE_UNTEMPLATED size_t CalculateRangesMaximizeMin(
    const FloatEbmType sideDistance, 
    const FloatEbmType totalDistance, 
@@ -808,7 +945,7 @@ static void BuildNeighbourhoodPlan(
 }
 
 static bool CutCuttingRange(
-   std::set<CutPoint *, CompareCutPoint> * const pBestCuts,
+   CutPointHeap * const pBestCuts,
 
    const size_t cSamples,
    const bool bSymmetryReversal,
@@ -830,659 +967,644 @@ static bool CutCuttingRange(
    EBM_ASSERT(cCuttableItems <= cSamples);
    EBM_ASSERT(nullptr != aNeighbourJumps);
 
-   // TODO: someday, for performance, it might make sense to use a non-allocating tree, like:
-   //       https://github.com/attractivechaos/klib/blob/master/kavl.h
-
-   try {
-      while(!pBestCuts->empty()) {
-         // We've located our desired cut points previously.  Sometimes those desired cut points
-         // are placed in the bulk of a long run of identical values and we have to decide if we'll be putting
-         // the cut at the start or the end of those long runs of identical values.
-         //
-         // Before this function in the call stack, we do some expensive exploration of the hardest cut point placement
-         // decisions that we need to make.  We do a full exploration of both the lower and higher placements of the long 
-         // runs, but that grows at O(2^N), so we need to limit this full exploration to just a few choices
-         //
-         // This function being lower in the stack needs to decide whether to place the cut at the lower or higher
-         // position without the benefit of an in-depth exploration of both options across all possible other cut points 
-         // (local exploration is still ok though).  We need to choose one side and live with that decision, so we 
-         // look at all our potential cuts, and we greedily pick out the cut that is 
-         // really nice on one side, but really bad on the other, and we keep greedily picking cuts this way until they 
-         // are all selected.  We use a priority queue to efficiently find the most important cut at any given time.
-         // Now we have an O(N * log(N)) algorithm in principal, but it's still a bit worse than that.
-         //
-         // After we decide whether to put the cut at the start or end of a run, we're actualizing the location of 
-         // the cut and we'll be changing the size of the runs to our left and right since they'll either have
-         // actualized or desired cut points, or the immutable ends as neighbours.  We'd prefer to spread out the
-         // movement between our desired and actual cut points into all our potential neighbours instead of to the 
-         // immediately bordering ranges.  Ideally, we'd like to spread out and re-calculate all other cut points 
-         // until we reach the immovable boundaries of an already decided cut, or the ends, after we've decided 
-         // on each cut. So, if we had 255 cuts, we'd choose one, then re-calculate the cut points of the remaining 
-         // 254, but that is clearly bad computationally, since then our algorithm would be O(N^2 * log(N)).  For low 
-         // numbers like 255 it might be fine, but our user could choose much larger numbers of cuts, and then 
-         // it would become intractable.
-         //
-         // Instead of re-calculating all remaining 255 cut points though, we instead choose a window 
-         // of influence.  So, if our influence window was set to 50 cut points, then even if we had to move one 
-         // cut point by a large amount of almost a complete cut range, we'd only impact the neighboring 50 ranges 
-         // by 2% (1/50).
-         //
-         // After we choose whether to go to the start or the end, we then choose an anchor point 50 to the 
-         // left and another one 50 to the right, unless we hit a materialized cut point, or the end, which we can't 
-         // move.  All the 50 items to the left and right either grow a bit smaller, or a bit bigger anchored to 
-         // the influence region ends.
-         //
-         // After calculating the new sizes of the ranges and the new desired cut points, we can then remove
-         // the 50-ish items on both sides from our priority queue, which in fact needs to be a tree so that we can
-         // remove items that aren't just the lowest value, and we can re-add them to the tree with their new
-         // recalculated priority score.
-         //
-         // But the scores of the desired cut points outside of our window have changed slightly too!  
-         // The 50th, 51st, 52nd, etc, items to the left and the right weren't moved, but they can still "see" cut 
-         // points that are within our influence window of desired cut points that we changed, so their priorty 
-         // scores need to change.  Once we get to twice the window size though, the items beyond that can't be 
-         // affected, so we only need to update items within a four time range of our window size, 
-         // two on the left and two on the right.
-         //
-         // If we have our window set to larger than the number of cuts, then we'll effectively be re-doing all
-         // the cuts, which might be ok for small N.  In that case all the cuts would always have the same width
-         // In our modified world, we get divergence over time, but since we're limiting our change to a small
-         // percentage, we shouldn't get too far out of whack.  Also, we'll quickly put down actualized cutting points such
-         // that afer a few we'll probably find ourselves close to a previous cut point and we'll proceed by
-         // updating all the priority scores exactly since we'll hit the already decided cuts before the 
-         // influence window length
-         //
-         // initially, we have pre-calculated which direction each cut should go, and we've calculated how many
-         // cut points should move between our right and left sides, and we also previously calculated a priority for
-         // making decisions. When we pull one potential cut point off the queue, we need to nuke all our decisions
-         // within the 50 item window on both sides (or until we hit an imovable boundary) and then we need to
-         // recalculate for each cut which way it should go and what it's priority is
-         //
-         // At this point we're re-doing our cuts within the 50 item cut window and we need to decide two things:
-         //   1) calculate the direction we'd go for each new cut point, and how many cuts we'd move from our right 
-         //      and left to the other side
-         //   2) Calculate the priority of making the decision
-         //
-         // If we do a full local exploration of where we're going to do our cuts for any single cut, then we can
-         // do a better job at calculating the priority, since we'll know how many cuts will be moved from right to left
-         //
-         // When doing a local exploration, examine going right left on each N segments to each side
-         //
-         // So, our process is:
-         //    1) Pull a high priority item from the queue (which has a pre-calculated direction to cut and all other
-         //       cutting decisions already calculated beforehand)
-         //    1) execute our pre-determined cut placement AND move cuts from one side to the other if called for in our pre-plan
-         //    2) re-calculate the aspirational cut points and for each of those do a first pass combination exploration
-         //       to choose the best materialied cut point based on just ourselves
-         //    3) Re-pass through our semi-materialized cuts points and jiggle them as necessary against their neighbours
-         //       since the "view of the world" is different for each cut point and they don't match perfectly even if
-         //       they are often close.
-         //    4) Pass from the center to the outer-outer boundary (twice the boundary distance), and remove cuts from
-         //       our priority queue, then calculate our new priority which is based on the squared change in all
-         //       aspirational cut point (either real or just assuming equal cutting after the cut)
-         //       And re-add them with our newly calculated priority, which can examine any cuts within
-         //       the N item window at any point (but won't change them)
-
-         // all fields of our pCutBest should have been filled with initialized data previously
-         CutPoint * const pCutBest = *pBestCuts->begin();
+   while(!pBestCuts->IsEmpty()) {
+      // We've located our desired cut points previously.  Sometimes those desired cut points
+      // are placed in the bulk of a long run of identical values and we have to decide if we'll be putting
+      // the cut at the start or the end of those long runs of identical values.
+      //
+      // Before this function in the call stack, we do some expensive exploration of the hardest cut point placement
+      // decisions that we need to make.  We do a full exploration of both the lower and higher placements of the long 
+      // runs, but that grows at O(2^N), so we need to limit this full exploration to just a few choices
+      //
+      // This function being lower in the stack needs to decide whether to place the cut at the lower or higher
+      // position without the benefit of an in-depth exploration of both options across all possible other cut points 
+      // (local exploration is still ok though).  We need to choose one side and live with that decision, so we 
+      // look at all our potential cuts, and we greedily pick out the cut that is 
+      // really nice on one side, but really bad on the other, and we keep greedily picking cuts this way until they 
+      // are all selected.  We use a priority queue to efficiently find the most important cut at any given time.
+      // Now we have an O(N * log(N)) algorithm in principal, but it's still a bit worse than that.
+      //
+      // After we decide whether to put the cut at the start or end of a run, we're actualizing the location of 
+      // the cut and we'll be changing the size of the runs to our left and right since they'll either have
+      // actualized or desired cut points, or the immutable ends as neighbours.  We'd prefer to spread out the
+      // movement between our desired and actual cut points into all our potential neighbours instead of to the 
+      // immediately bordering ranges.  Ideally, we'd like to spread out and re-calculate all other cut points 
+      // until we reach the immovable boundaries of an already decided cut, or the ends, after we've decided 
+      // on each cut. So, if we had 255 cuts, we'd choose one, then re-calculate the cut points of the remaining 
+      // 254, but that is clearly bad computationally, since then our algorithm would be O(N^2 * log(N)).  For low 
+      // numbers like 255 it might be fine, but our user could choose much larger numbers of cuts, and then 
+      // it would become intractable.
+      //
+      // Instead of re-calculating all remaining 255 cut points though, we instead choose a window 
+      // of influence.  So, if our influence window was set to 50 cut points, then even if we had to move one 
+      // cut point by a large amount of almost a complete cut range, we'd only impact the neighboring 50 ranges 
+      // by 2% (1/50).
+      //
+      // After we choose whether to go to the start or the end, we then choose an anchor point 50 to the 
+      // left and another one 50 to the right, unless we hit a materialized cut point, or the end, which we can't 
+      // move.  All the 50 items to the left and right either grow a bit smaller, or a bit bigger anchored to 
+      // the influence region ends.
+      //
+      // After calculating the new sizes of the ranges and the new desired cut points, we can then remove
+      // the 50-ish items on both sides from our priority queue, which in fact needs to be a tree so that we can
+      // remove items that aren't just the lowest value, and we can re-add them to the tree with their new
+      // recalculated priority score.
+      //
+      // But the scores of the desired cut points outside of our window have changed slightly too!  
+      // The 50th, 51st, 52nd, etc, items to the left and the right weren't moved, but they can still "see" cut 
+      // points that are within our influence window of desired cut points that we changed, so their priorty 
+      // scores need to change.  Once we get to twice the window size though, the items beyond that can't be 
+      // affected, so we only need to update items within a four time range of our window size, 
+      // two on the left and two on the right.
+      //
+      // If we have our window set to larger than the number of cuts, then we'll effectively be re-doing all
+      // the cuts, which might be ok for small N.  In that case all the cuts would always have the same width
+      // In our modified world, we get divergence over time, but since we're limiting our change to a small
+      // percentage, we shouldn't get too far out of whack.  Also, we'll quickly put down actualized cutting points such
+      // that afer a few we'll probably find ourselves close to a previous cut point and we'll proceed by
+      // updating all the priority scores exactly since we'll hit the already decided cuts before the 
+      // influence window length
+      //
+      // initially, we have pre-calculated which direction each cut should go, and we've calculated how many
+      // cut points should move between our right and left sides, and we also previously calculated a priority for
+      // making decisions. When we pull one potential cut point off the queue, we need to nuke all our decisions
+      // within the 50 item window on both sides (or until we hit an imovable boundary) and then we need to
+      // recalculate for each cut which way it should go and what it's priority is
+      //
+      // At this point we're re-doing our cuts within the 50 item cut window and we need to decide two things:
+      //   1) calculate the direction we'd go for each new cut point, and how many cuts we'd move from our right 
+      //      and left to the other side
+      //   2) Calculate the priority of making the decision
+      //
+      // If we do a full local exploration of where we're going to do our cuts for any single cut, then we can
+      // do a better job at calculating the priority, since we'll know how many cuts will be moved from right to left
+      //
+      // When doing a local exploration, examine going right left on each N segments to each side
+      //
+      // So, our process is:
+      //    1) Pull a high priority item from the queue (which has a pre-calculated direction to cut and all other
+      //       cutting decisions already calculated beforehand)
+      //    1) execute our pre-determined cut placement AND move cuts from one side to the other if called for in our pre-plan
+      //    2) re-calculate the aspirational cut points and for each of those do a first pass combination exploration
+      //       to choose the best materialied cut point based on just ourselves
+      //    3) Re-pass through our semi-materialized cuts points and jiggle them as necessary against their neighbours
+      //       since the "view of the world" is different for each cut point and they don't match perfectly even if
+      //       they are often close.
+      //    4) Pass from the center to the outer-outer boundary (twice the boundary distance), and remove cuts from
+      //       our priority queue, then calculate our new priority which is based on the squared change in all
+      //       aspirational cut point (either real or just assuming equal cutting after the cut)
+      //       And re-add them with our newly calculated priority, which can examine any cuts within
+      //       the N item window at any point (but won't change them)
+
+      // all fields of our pCutBest should have been filled with initialized data previously
+      CutPoint * const pCutBest = pBestCuts->GetTop();
 
 #ifdef LOG_SUPERVERBOSE_DISCRETIZATION_ORDERED
-         LOG_N(TraceLevelVerbose, "Dequeue CutPoint: %zu, %zu, %" FloatEbmTypePrintf ", %td, %" FloatEbmTypePrintf,
-            pCutBest->m_uniqueTiebreaker,
-            pCutBest->m_iVal,
-            pCutBest->m_iValAspirationalFloat,
-            pCutBest->m_cPredeterminedMovementOnCut,
-            pCutBest->m_priority
-         );
+      LOG_N(TraceLevelVerbose, "Dequeue CutPoint: %zu, %zu, %" FloatEbmTypePrintf ", %td, %" FloatEbmTypePrintf,
+         pCutBest->m_uniqueTiebreaker,
+         pCutBest->m_iVal,
+         pCutBest->m_iValAspirationalFloat,
+         pCutBest->m_cPredeterminedMovementOnCut,
+         pCutBest->m_priority
+      );
 #endif // LOG_SUPERVERBOSE_DISCRETIZATION_ORDERED
 
-         EBM_ASSERT(nullptr != pCutBest->m_pPrev);
-         EBM_ASSERT(nullptr != pCutBest->m_pNext);
-         EBM_ASSERT(!pCutBest->IsCut()); // this checks m_cPredeterminedMovementOnCut
+      EBM_ASSERT(nullptr != pCutBest->m_pPrev);
+      EBM_ASSERT(nullptr != pCutBest->m_pNext);
+      EBM_ASSERT(!pCutBest->IsCut()); // this checks m_cPredeterminedMovementOnCut
 
-         // we can't move past our outer boundaries
-         EBM_ASSERT(-ptrdiff_t { k_cutExploreDistance } < pCutBest->m_cPredeterminedMovementOnCut &&
-            pCutBest->m_cPredeterminedMovementOnCut < ptrdiff_t { k_cutExploreDistance });
+      // we can't move past our outer boundaries
+      EBM_ASSERT(-ptrdiff_t { k_cutExploreDistance } < pCutBest->m_cPredeterminedMovementOnCut &&
+         pCutBest->m_cPredeterminedMovementOnCut < ptrdiff_t { k_cutExploreDistance });
 
-         EBM_ASSERT(!std::isnan(pCutBest->m_iValAspirationalFloat));
-         EBM_ASSERT(!std::isinf(pCutBest->m_iValAspirationalFloat));
-         EBM_ASSERT(FloatEbmType { 0 } < pCutBest->m_iValAspirationalFloat);
+      EBM_ASSERT(!std::isnan(pCutBest->m_iValAspirationalFloat));
+      EBM_ASSERT(!std::isinf(pCutBest->m_iValAspirationalFloat));
+      EBM_ASSERT(FloatEbmType { 0 } < pCutBest->m_iValAspirationalFloat);
 
-         EBM_ASSERT(!std::isnan(pCutBest->m_priority));
-         EBM_ASSERT(!std::isinf(pCutBest->m_priority));
+      EBM_ASSERT(!std::isnan(pCutBest->m_priority));
+      EBM_ASSERT(!std::isinf(pCutBest->m_priority));
 
-         const size_t iVal = pCutBest->m_iVal; // preserve the location of our cut in case we end up moving
-         if(k_valNotLegal == iVal) {
-            // k_valNoCutsPossible means there are no legal cuts, and also that all the remaining items 
-            // in the queue are also uncuttable, so exit.
-            EBM_ASSERT(k_priorityNoCutsPossible == pCutBest->m_priority);
-            break;
-         }
-         EBM_ASSERT(FloatEbmType { 0 } <= pCutBest->m_priority);
+      const size_t iVal = pCutBest->m_iVal; // preserve the location of our cut in case we end up moving
+      if(k_valNotLegal == iVal) {
+         // k_valNoCutsPossible means there are no legal cuts, and also that all the remaining items 
+         // in the queue are also uncuttable, so exit.
+         EBM_ASSERT(k_priorityNoCutsPossible == pCutBest->m_priority);
+         break;
+      }
+      EBM_ASSERT(FloatEbmType { 0 } <= pCutBest->m_priority);
 
-         // find our visibility window region
-         CutPoint * pCutLowModificationExclusiveBoundary = pCutBest;
-         size_t cRangesLowModification = k_cutExploreDistance;
-         ptrdiff_t cPredeterminedMovementOnCutLowLow;
-         do {
-            pCutLowModificationExclusiveBoundary = pCutLowModificationExclusiveBoundary->m_pPrev;
-            cPredeterminedMovementOnCutLowLow = pCutLowModificationExclusiveBoundary->m_cPredeterminedMovementOnCut;
-            --cRangesLowModification;
-         } while(LIKELY(LIKELY(k_movementDoneCut != cPredeterminedMovementOnCutLowLow) && 
-            LIKELY(size_t { 0 } != cRangesLowModification)));
-
-         cRangesLowModification = k_cutExploreDistance - cRangesLowModification;
-         EBM_ASSERT(1 <= cRangesLowModification);
-         EBM_ASSERT(cRangesLowModification <= k_cutExploreDistance);
-         EBM_ASSERT(-pCutBest->m_cPredeterminedMovementOnCut < static_cast<ptrdiff_t>(cRangesLowModification));
-
-         EBM_ASSERT(FloatEbmType { 0 } <= pCutLowModificationExclusiveBoundary->m_iValAspirationalFloat);
-
-         // this should be exact, since we would have set it like this
-         EBM_ASSERT(!pCutLowModificationExclusiveBoundary->IsCut() || pCutLowModificationExclusiveBoundary->m_iValAspirationalFloat == static_cast<FloatEbmType>(pCutLowModificationExclusiveBoundary->m_iVal));
-         EBM_ASSERT(pCutLowModificationExclusiveBoundary->m_iVal <= pCutBest->m_iVal);
-         EBM_ASSERT(pCutLowModificationExclusiveBoundary->m_iValAspirationalFloat < pCutBest->m_iValAspirationalFloat);
-
-         CutPoint * pCutHighModificationExclusiveBoundary = pCutBest;
-         size_t cRangesHighModification = k_cutExploreDistance;
-         ptrdiff_t cPredeterminedMovementOnCutHighHigh;
-         do {
-            pCutHighModificationExclusiveBoundary = pCutHighModificationExclusiveBoundary->m_pNext;
-            cPredeterminedMovementOnCutHighHigh = pCutHighModificationExclusiveBoundary->m_cPredeterminedMovementOnCut;
-            --cRangesHighModification;
-         } while(LIKELY(LIKELY(k_movementDoneCut != cPredeterminedMovementOnCutHighHigh) && 
-            LIKELY(size_t { 0 } != cRangesHighModification)));
-
-         cRangesHighModification = k_cutExploreDistance - cRangesHighModification;
-         EBM_ASSERT(1 <= cRangesHighModification);
-         EBM_ASSERT(cRangesHighModification <= k_cutExploreDistance);
-         EBM_ASSERT(pCutBest->m_cPredeterminedMovementOnCut < static_cast<ptrdiff_t>(cRangesHighModification));
-
-         EBM_ASSERT(FloatEbmType { 0 } < pCutHighModificationExclusiveBoundary->m_iValAspirationalFloat);
-
-         // this should be exact, since we would have set it like this
-         EBM_ASSERT(!pCutHighModificationExclusiveBoundary->IsCut() || pCutHighModificationExclusiveBoundary->m_iValAspirationalFloat == static_cast<FloatEbmType>(pCutHighModificationExclusiveBoundary->m_iVal));
-         EBM_ASSERT(pCutBest->m_iVal <= pCutHighModificationExclusiveBoundary->m_iVal);
-         EBM_ASSERT(pCutBest->m_iValAspirationalFloat < pCutHighModificationExclusiveBoundary->m_iValAspirationalFloat);
-
-         // we're allowed to move cuts between our sides before cutting, so let's find our new home
-         ptrdiff_t cPredeterminedMovementOnCut = pCutBest->m_cPredeterminedMovementOnCut;
-
-         CutPoint * pCutCur = pCutBest;
-
-         CutPoint * pCutLowLowVisibilityInclusiveBoundary = pCutLowModificationExclusiveBoundary;
-         size_t cRangesLowLowPlan = cRangesLowModification;
-
-         CutPoint * pCutHighHighVisibilityInclusiveBoundary = pCutHighModificationExclusiveBoundary;
-         size_t cRangesHighHighPlan = cRangesHighModification;
-
-         cRangesLowModification = 
-            static_cast<size_t>(static_cast<ptrdiff_t>(cRangesLowModification) + cPredeterminedMovementOnCut);
-         cRangesHighModification = 
-            static_cast<size_t>(static_cast<ptrdiff_t>(cRangesHighModification) - cPredeterminedMovementOnCut);
-
-         EBM_ASSERT(size_t { 1 } <= cRangesLowModification);
-         EBM_ASSERT(size_t { 1 } <= cRangesHighModification);
-
-         if(UNLIKELY(ptrdiff_t { 0 } != cPredeterminedMovementOnCut)) {
-
-            // If we push cuts either left or right, we don't change the window bounds within which we modify
-            // the aspirational cuts, because if we did, then there would be no bounds on where we can 
-            // 100% guarantee that no changes will affect outside regions
-            // we do however keep track of our visibility bounds since we'll use that when computing
-            // the plan and the priority of our cuts since those can observe other aspirational cuts
-            // outside of the bounds which we modify the aspirational cuts
-
-            if(UNPREDICTABLE(cPredeterminedMovementOnCut < ptrdiff_t { 0 })) {
-               do {
-                  pCutCur = pCutCur->m_pPrev;
-                  EBM_ASSERT(!pCutCur->IsCut());
-
-                  if(k_movementDoneCut != cPredeterminedMovementOnCutLowLow) {
-                     pCutLowLowVisibilityInclusiveBoundary = pCutLowLowVisibilityInclusiveBoundary->m_pPrev;
-                     cPredeterminedMovementOnCutLowLow = pCutLowLowVisibilityInclusiveBoundary->m_cPredeterminedMovementOnCut;
-                  } else {
-                     // we've hit a cut boundary which we can't move, so we get closer to it
-                     EBM_ASSERT(2 <= cRangesLowLowPlan);
-                     --cRangesLowLowPlan;
-                  }
-                  EBM_ASSERT((k_movementDoneCut == cPredeterminedMovementOnCutLowLow) == pCutLowLowVisibilityInclusiveBoundary->IsCut());
-
-                  if(k_cutExploreDistance == cRangesHighHighPlan) {
-                     pCutHighHighVisibilityInclusiveBoundary = pCutHighHighVisibilityInclusiveBoundary->m_pPrev;
-                     EBM_ASSERT(!pCutHighHighVisibilityInclusiveBoundary->IsCut());
-                  } else {
-                     EBM_ASSERT(pCutHighHighVisibilityInclusiveBoundary->IsCut());
-                     ++cRangesHighHighPlan;
-                  }
+      // find our visibility window region
+      CutPoint * pCutLowModificationExclusiveBoundary = pCutBest;
+      size_t cRangesLowModification = k_cutExploreDistance;
+      ptrdiff_t cPredeterminedMovementOnCutLowLow;
+      do {
+         pCutLowModificationExclusiveBoundary = pCutLowModificationExclusiveBoundary->m_pPrev;
+         cPredeterminedMovementOnCutLowLow = pCutLowModificationExclusiveBoundary->m_cPredeterminedMovementOnCut;
+         --cRangesLowModification;
+      } while(LIKELY(LIKELY(k_movementDoneCut != cPredeterminedMovementOnCutLowLow) && 
+         LIKELY(size_t { 0 } != cRangesLowModification)));
+
+      cRangesLowModification = k_cutExploreDistance - cRangesLowModification;
+      EBM_ASSERT(1 <= cRangesLowModification);
+      EBM_ASSERT(cRangesLowModification <= k_cutExploreDistance);
+      EBM_ASSERT(-pCutBest->m_cPredeterminedMovementOnCut < static_cast<ptrdiff_t>(cRangesLowModification));
+
+      EBM_ASSERT(FloatEbmType { 0 } <= pCutLowModificationExclusiveBoundary->m_iValAspirationalFloat);
+
+      // this should be exact, since we would have set it like this
+      EBM_ASSERT(!pCutLowModificationExclusiveBoundary->IsCut() || pCutLowModificationExclusiveBoundary->m_iValAspirationalFloat == static_cast<FloatEbmType>(pCutLowModificationExclusiveBoundary->m_iVal));
+      EBM_ASSERT(pCutLowModificationExclusiveBoundary->m_iVal <= pCutBest->m_iVal);
+      EBM_ASSERT(pCutLowModificationExclusiveBoundary->m_iValAspirationalFloat < pCutBest->m_iValAspirationalFloat);
+
+      CutPoint * pCutHighModificationExclusiveBoundary = pCutBest;
+      size_t cRangesHighModification = k_cutExploreDistance;
+      ptrdiff_t cPredeterminedMovementOnCutHighHigh;
+      do {
+         pCutHighModificationExclusiveBoundary = pCutHighModificationExclusiveBoundary->m_pNext;
+         cPredeterminedMovementOnCutHighHigh = pCutHighModificationExclusiveBoundary->m_cPredeterminedMovementOnCut;
+         --cRangesHighModification;
+      } while(LIKELY(LIKELY(k_movementDoneCut != cPredeterminedMovementOnCutHighHigh) && 
+         LIKELY(size_t { 0 } != cRangesHighModification)));
 
-                  ++cPredeterminedMovementOnCut;
-               } while(UNLIKELY(ptrdiff_t { 0 } != cPredeterminedMovementOnCut));
-               cPredeterminedMovementOnCutHighHigh = pCutHighHighVisibilityInclusiveBoundary->m_cPredeterminedMovementOnCut;
-            } else {
-               do {
-                  pCutCur = pCutCur->m_pNext;
-                  EBM_ASSERT(!pCutCur->IsCut());
-
-                  if(k_cutExploreDistance == cRangesLowLowPlan) {
-                     pCutLowLowVisibilityInclusiveBoundary = pCutLowLowVisibilityInclusiveBoundary->m_pNext;
-                     EBM_ASSERT(!pCutLowLowVisibilityInclusiveBoundary->IsCut());
-                  } else {
-                     EBM_ASSERT(pCutLowLowVisibilityInclusiveBoundary->IsCut());
-                     ++cRangesLowLowPlan;
-                  }
+      cRangesHighModification = k_cutExploreDistance - cRangesHighModification;
+      EBM_ASSERT(1 <= cRangesHighModification);
+      EBM_ASSERT(cRangesHighModification <= k_cutExploreDistance);
+      EBM_ASSERT(pCutBest->m_cPredeterminedMovementOnCut < static_cast<ptrdiff_t>(cRangesHighModification));
 
-                  if(k_movementDoneCut != cPredeterminedMovementOnCutHighHigh) {
-                     pCutHighHighVisibilityInclusiveBoundary = pCutHighHighVisibilityInclusiveBoundary->m_pNext;
-                     cPredeterminedMovementOnCutHighHigh = pCutHighHighVisibilityInclusiveBoundary->m_cPredeterminedMovementOnCut;
-                  } else {
-                     // we've hit a cut boundary which we can't move, so we get closer to it
-                     EBM_ASSERT(2 <= cRangesHighHighPlan);
-                     --cRangesHighHighPlan;
-                  }
-                  EBM_ASSERT((k_movementDoneCut == cPredeterminedMovementOnCutHighHigh) == pCutHighHighVisibilityInclusiveBoundary->IsCut());
+      EBM_ASSERT(FloatEbmType { 0 } < pCutHighModificationExclusiveBoundary->m_iValAspirationalFloat);
 
-                  --cPredeterminedMovementOnCut;
-               } while(UNLIKELY(ptrdiff_t { 0 } != cPredeterminedMovementOnCut));
-               cPredeterminedMovementOnCutLowLow = pCutLowLowVisibilityInclusiveBoundary->m_cPredeterminedMovementOnCut;
-            }
-         }
+      // this should be exact, since we would have set it like this
+      EBM_ASSERT(!pCutHighModificationExclusiveBoundary->IsCut() || pCutHighModificationExclusiveBoundary->m_iValAspirationalFloat == static_cast<FloatEbmType>(pCutHighModificationExclusiveBoundary->m_iVal));
+      EBM_ASSERT(pCutBest->m_iVal <= pCutHighModificationExclusiveBoundary->m_iVal);
+      EBM_ASSERT(pCutBest->m_iValAspirationalFloat < pCutHighModificationExclusiveBoundary->m_iValAspirationalFloat);
 
-         EBM_ASSERT(size_t { 1 } <= cRangesLowLowPlan);
-         EBM_ASSERT(size_t { 1 } <= cRangesHighHighPlan);
-
-         EBM_ASSERT(!pCutCur->IsCut());
-
-         pCutCur->SetCut();
-
-         const FloatEbmType iValFloat = static_cast<FloatEbmType>(iVal);
-
-         pCutCur->m_iValAspirationalFloat = iValFloat;
-         pCutCur->m_iVal = iVal;
-
-         // TODO: We've just finished materializing the cut based on the plan we developed earlier.  We'll
-         // now go and re-do our aspirational cut plan for all the aspirational cuts within our visibility windows
-         // on each side.  Before we do that though, we can do a quick check to find out what the maximum number of 
-         // cuts we could place is between our new materialized cut and our visibility windows.  If it's not possible
-         // even in theory to place 20 cuts on our low side, then our aspirational plans shouldn't even consider that
-         // Also, if we delete/move aspirational cuts early, there's a higher chance that we'll be able to re-use them
-         // in a good place.  See the DetermineRangesMax(...) function on how to do this.
-         // There's actually two subtle issues here that we need to handle differently:
-         //  1) we need to determine if we should delete any cuts on our left or right.  To do this go from our
-         //     materialized cut and jump by cSamplesPerBinMin using aNeighbourJumps until we hit the aspirational
-         //     or materialized window.  If the window is aspirational we can either use the edge that's within the
-         //     aspirational window or the one right outside if we want more certainty, but in either case it's not a
-         //     100% guarantee since we might not even cut on the range that our aspirational cut falls on.  I lean towards
-         //     using our inner window and pruning early so that we get the cuts to useful place early.  The alternate
-         //     viewpoint is to only trim when we hit a materialized boundary before our visibility window.
-         //     since cuts could eventually be pushed into the open ended range potentially, but in general we should
-         //     think that if cuts can't be used within our range for a long distance we'd want to reallocate them
-         //     even if they could be pushed since it changes the density within our visibility window and
-         //     if we pushed them to a point outside then we'be be increasing the density there, so better to change
-         //     the densities in a more controlled way beforehand
-         //  2) We want to know how many potential cuts there are on each side of each aspirational cut that we're
-         //     we're considering.  Since we're processing like 20-50 of these, we can slide the value window
-         //     with cSamplesPerBinMin as we slide the visiblility windows to the left or right
-         //
-         // We only need to know if we have more than k_cutExploreDistance items, since we can't have more than
-         // that number of cuts until our border.  We can allocate a fixed size array on the stack with 
-         // k_cutExploreDistance size_t indexes and fill these from the lower and higher sides, and then if we
-         // cross any of those indexes we know if we've gone below a limit.
+      // we're allowed to move cuts between our sides before cutting, so let's find our new home
+      ptrdiff_t cPredeterminedMovementOnCut = pCutBest->m_cPredeterminedMovementOnCut;
 
+      CutPoint * pCutCur = pCutBest;
 
-         FloatEbmType stepPoint = pCutLowModificationExclusiveBoundary->m_iValAspirationalFloat;
-         FloatEbmType stepLength;
-         if(pCutLowModificationExclusiveBoundary->IsCut()) {
-            EBM_ASSERT(pCutLowModificationExclusiveBoundary->m_iVal < iVal);
-            stepLength = static_cast<FloatEbmType>(iVal - pCutLowModificationExclusiveBoundary->m_iVal);
-         } else {
-            EBM_ASSERT(stepPoint < iValFloat);
-            stepLength = iValFloat - stepPoint;
-         }
-         stepLength /= static_cast<FloatEbmType>(cRangesLowModification);
-
-         CutPoint * pCutAspirational = pCutCur;
-         while(LIKELY(size_t { 0 } != --cRangesLowModification)) {
-            pCutAspirational = pCutAspirational->m_pPrev;
-            const FloatEbmType iValAspirationalFloat = stepPoint + 
-               stepLength * static_cast<FloatEbmType>(cRangesLowModification);
-            pCutAspirational->m_iValAspirationalFloat = iValAspirationalFloat;
-         }
+      CutPoint * pCutLowLowVisibilityInclusiveBoundary = pCutLowModificationExclusiveBoundary;
+      size_t cRangesLowLowPlan = cRangesLowModification;
 
-         stepPoint = iValFloat;
-         if(pCutHighModificationExclusiveBoundary->IsCut()) {
-            EBM_ASSERT(iVal < pCutHighModificationExclusiveBoundary->m_iVal);
-            stepLength = static_cast<FloatEbmType>(pCutHighModificationExclusiveBoundary->m_iVal - iVal);
-         } else {
-            EBM_ASSERT(iValFloat < pCutHighModificationExclusiveBoundary->m_iValAspirationalFloat);
-            stepLength = pCutHighModificationExclusiveBoundary->m_iValAspirationalFloat - stepPoint;
-         }
-         stepLength /= static_cast<FloatEbmType>(cRangesHighModification);
-
-         pCutAspirational = pCutHighModificationExclusiveBoundary;
-         while(size_t { 0 } != --cRangesHighModification) {
-            pCutAspirational = pCutAspirational->m_pPrev;
-            const FloatEbmType iValAspirationalFloat = stepPoint + 
-               stepLength * static_cast<FloatEbmType>(cRangesHighModification);
-            pCutAspirational->m_iValAspirationalFloat = iValAspirationalFloat;
-         }
+      CutPoint * pCutHighHighVisibilityInclusiveBoundary = pCutHighModificationExclusiveBoundary;
+      size_t cRangesHighHighPlan = cRangesHighModification;
 
-         CutPoint * pCutLowLowPlanInclusiveBoundary = pCutLowLowVisibilityInclusiveBoundary;
-         CutPoint * pCutLowHighPlanInclusiveBoundary = pCutCur;
-         size_t cRangesLowHighPlan = size_t { 0 };
+      cRangesLowModification = 
+         static_cast<size_t>(static_cast<ptrdiff_t>(cRangesLowModification) + cPredeterminedMovementOnCut);
+      cRangesHighModification = 
+         static_cast<size_t>(static_cast<ptrdiff_t>(cRangesHighModification) - cPredeterminedMovementOnCut);
 
-         size_t iValLowLowPlan = LIKELY(k_movementDoneCut == cPredeterminedMovementOnCutLowLow) ? 
-            pCutLowLowPlanInclusiveBoundary->m_iVal : k_valNotLegal;
-         size_t iValLowHighPlan = iVal;
+      EBM_ASSERT(size_t { 1 } <= cRangesLowModification);
+      EBM_ASSERT(size_t { 1 } <= cRangesHighModification);
 
-         CutPoint * pCutLowPlanCur = pCutCur;
+      if(UNLIKELY(ptrdiff_t { 0 } != cPredeterminedMovementOnCut)) {
 
-         while(true) {
-            if(UNLIKELY(k_valNotLegal == iValLowLowPlan)) {
-               EBM_ASSERT(!pCutLowLowPlanInclusiveBoundary->IsCut());
-               pCutLowLowPlanInclusiveBoundary = pCutLowLowPlanInclusiveBoundary->m_pPrev;
-               if(UNLIKELY(pCutLowLowPlanInclusiveBoundary->IsCut())) {
-                  iValLowLowPlan = pCutLowLowPlanInclusiveBoundary->m_iVal;
+         // If we push cuts either left or right, we don't change the window bounds within which we modify
+         // the aspirational cuts, because if we did, then there would be no bounds on where we can 
+         // 100% guarantee that no changes will affect outside regions
+         // we do however keep track of our visibility bounds since we'll use that when computing
+         // the plan and the priority of our cuts since those can observe other aspirational cuts
+         // outside of the bounds which we modify the aspirational cuts
+
+         if(UNPREDICTABLE(cPredeterminedMovementOnCut < ptrdiff_t { 0 })) {
+            do {
+               pCutCur = pCutCur->m_pPrev;
+               EBM_ASSERT(!pCutCur->IsCut());
+
+               if(k_movementDoneCut != cPredeterminedMovementOnCutLowLow) {
+                  pCutLowLowVisibilityInclusiveBoundary = pCutLowLowVisibilityInclusiveBoundary->m_pPrev;
+                  cPredeterminedMovementOnCutLowLow = pCutLowLowVisibilityInclusiveBoundary->m_cPredeterminedMovementOnCut;
+               } else {
+                  // we've hit a cut boundary which we can't move, so we get closer to it
+                  EBM_ASSERT(2 <= cRangesLowLowPlan);
+                  --cRangesLowLowPlan;
                }
-            } else {
-               EBM_ASSERT(pCutLowLowPlanInclusiveBoundary->IsCut());
-               --cRangesLowLowPlan;
-               if(UNLIKELY(0 == cRangesLowLowPlan)) {
-                  // we've reached the hard boundary of a materialized cut
-                  break;
+               EBM_ASSERT((k_movementDoneCut == cPredeterminedMovementOnCutLowLow) == pCutLowLowVisibilityInclusiveBoundary->IsCut());
+
+               if(k_cutExploreDistance == cRangesHighHighPlan) {
+                  pCutHighHighVisibilityInclusiveBoundary = pCutHighHighVisibilityInclusiveBoundary->m_pPrev;
+                  EBM_ASSERT(!pCutHighHighVisibilityInclusiveBoundary->IsCut());
+               } else {
+                  EBM_ASSERT(pCutHighHighVisibilityInclusiveBoundary->IsCut());
+                  ++cRangesHighHighPlan;
+               }
+
+               ++cPredeterminedMovementOnCut;
+            } while(UNLIKELY(ptrdiff_t { 0 } != cPredeterminedMovementOnCut));
+            cPredeterminedMovementOnCutHighHigh = pCutHighHighVisibilityInclusiveBoundary->m_cPredeterminedMovementOnCut;
+         } else {
+            do {
+               pCutCur = pCutCur->m_pNext;
+               EBM_ASSERT(!pCutCur->IsCut());
+
+               if(k_cutExploreDistance == cRangesLowLowPlan) {
+                  pCutLowLowVisibilityInclusiveBoundary = pCutLowLowVisibilityInclusiveBoundary->m_pNext;
+                  EBM_ASSERT(!pCutLowLowVisibilityInclusiveBoundary->IsCut());
+               } else {
+                  EBM_ASSERT(pCutLowLowVisibilityInclusiveBoundary->IsCut());
+                  ++cRangesLowLowPlan;
                }
-            }
 
-            if(UNLIKELY(k_cutExploreDistance == cRangesLowHighPlan)) {
-               pCutLowHighPlanInclusiveBoundary = pCutLowHighPlanInclusiveBoundary->m_pPrev;
-               EBM_ASSERT(!pCutLowHighPlanInclusiveBoundary->IsCut());
-               iValLowHighPlan = k_valNotLegal;
-               if(UNLIKELY(pCutLowHighPlanInclusiveBoundary == pCutLowModificationExclusiveBoundary)) {
-                  // we've reached the boundary of where we changed the aspirational cuts, so no changes should
-                  // occur beyond this point
-                  break;
+               if(k_movementDoneCut != cPredeterminedMovementOnCutHighHigh) {
+                  pCutHighHighVisibilityInclusiveBoundary = pCutHighHighVisibilityInclusiveBoundary->m_pNext;
+                  cPredeterminedMovementOnCutHighHigh = pCutHighHighVisibilityInclusiveBoundary->m_cPredeterminedMovementOnCut;
+               } else {
+                  // we've hit a cut boundary which we can't move, so we get closer to it
+                  EBM_ASSERT(2 <= cRangesHighHighPlan);
+                  --cRangesHighHighPlan;
                }
-            } else {
-               EBM_ASSERT(pCutLowHighPlanInclusiveBoundary->IsCut());
-               EBM_ASSERT(k_valNotLegal != iValLowHighPlan);
-               ++cRangesLowHighPlan;
-            }
+               EBM_ASSERT((k_movementDoneCut == cPredeterminedMovementOnCutHighHigh) == pCutHighHighVisibilityInclusiveBoundary->IsCut());
 
-            pCutLowPlanCur = pCutLowPlanCur->m_pPrev;
-            EBM_ASSERT(!pCutLowPlanCur->IsCut()); // we should have exited on 0 == cRangesLowLowPlan beforehand
+               --cPredeterminedMovementOnCut;
+            } while(UNLIKELY(ptrdiff_t { 0 } != cPredeterminedMovementOnCut));
+            cPredeterminedMovementOnCutLowLow = pCutLowLowVisibilityInclusiveBoundary->m_cPredeterminedMovementOnCut;
+         }
+      }
 
-            BuildNeighbourhoodPlan(
-               cSamples,
-               bSymmetryReversal,
+      EBM_ASSERT(size_t { 1 } <= cRangesLowLowPlan);
+      EBM_ASSERT(size_t { 1 } <= cRangesHighHighPlan);
 
-               cSamplesPerBinMin,
-               iValuesStart,
-               cCuttableItems,
-               aNeighbourJumps,
+      EBM_ASSERT(!pCutCur->IsCut());
+
+      pCutCur->SetCut();
 
-               cRangesLowLowPlan,
-               iValLowLowPlan,
-               pCutLowLowPlanInclusiveBoundary->m_iValAspirationalFloat,
+      const FloatEbmType iValFloat = static_cast<FloatEbmType>(iVal);
+
+      pCutCur->m_iValAspirationalFloat = iValFloat;
+      pCutCur->m_iVal = iVal;
+
+      // TODO: We've just finished materializing the cut based on the plan we developed earlier.  We'll
+      // now go and re-do our aspirational cut plan for all the aspirational cuts within our visibility windows
+      // on each side.  Before we do that though, we can do a quick check to find out what the maximum number of 
+      // cuts we could place is between our new materialized cut and our visibility windows.  If it's not possible
+      // even in theory to place 20 cuts on our low side, then our aspirational plans shouldn't even consider that
+      // Also, if we delete/move aspirational cuts early, there's a higher chance that we'll be able to re-use them
+      // in a good place.  See the DetermineRangesMax(...) function on how to do this.
+      // There's actually two subtle issues here that we need to handle differently:
+      //  1) we need to determine if we should delete any cuts on our left or right.  To do this go from our
+      //     materialized cut and jump by cSamplesPerBinMin using aNeighbourJumps until we hit the aspirational
+      //     or materialized window.  If the window is aspirational we can either use the edge that's within the
+      //     aspirational window or the one right outside if we want more certainty, but in either case it's not a
+      //     100% guarantee since we might not even cut on the range that our aspirational cut falls on.  I lean towards
+      //     using our inner window and pruning early so that we get the cuts to useful place early.  The alternate
+      //     viewpoint is to only trim when we hit a materialized boundary before our visibility window.
+      //     since cuts could eventually be pushed into the open ended range potentially, but in general we should
+      //     think that if cuts can't be used within our range for a long distance we'd want to reallocate them
+      //     even if they could be pushed since it changes the density within our visibility window and
+      //     if we pushed them to a point outside then we'be be increasing the density there, so better to change
+      //     the densities in a more controlled way beforehand
+      //  2) We want to know how many potential cuts there are on each side of each aspirational cut that we're
+      //     we're considering.  Since we're processing like 20-50 of these, we can slide the value window
+      //     with cSamplesPerBinMin as we slide the visiblility windows to the left or right
+      //
+      // We only need to know if we have more than k_cutExploreDistance items, since we can't have more than
+      // that number of cuts until our border.  We can allocate a fixed size array on the stack with 
+      // k_cutExploreDistance size_t indexes and fill these from the lower and higher sides, and then if we
+      // cross any of those indexes we know if we've gone below a limit.
 
-               cRangesLowHighPlan,
-               iValLowHighPlan,
-               pCutLowHighPlanInclusiveBoundary->m_iValAspirationalFloat,
 
-               pCutLowPlanCur
-            );
-         }
+      FloatEbmType stepPoint = pCutLowModificationExclusiveBoundary->m_iValAspirationalFloat;
+      FloatEbmType stepLength;
+      if(pCutLowModificationExclusiveBoundary->IsCut()) {
+         EBM_ASSERT(pCutLowModificationExclusiveBoundary->m_iVal < iVal);
+         stepLength = static_cast<FloatEbmType>(iVal - pCutLowModificationExclusiveBoundary->m_iVal);
+      } else {
+         EBM_ASSERT(stepPoint < iValFloat);
+         stepLength = iValFloat - stepPoint;
+      }
+      stepLength /= static_cast<FloatEbmType>(cRangesLowModification);
+
+      CutPoint * pCutAspirational = pCutCur;
+      while(LIKELY(size_t { 0 } != --cRangesLowModification)) {
+         pCutAspirational = pCutAspirational->m_pPrev;
+         const FloatEbmType iValAspirationalFloat = stepPoint + 
+            stepLength * static_cast<FloatEbmType>(cRangesLowModification);
+         pCutAspirational->m_iValAspirationalFloat = iValAspirationalFloat;
+      }
+
+      stepPoint = iValFloat;
+      if(pCutHighModificationExclusiveBoundary->IsCut()) {
+         EBM_ASSERT(iVal < pCutHighModificationExclusiveBoundary->m_iVal);
+         stepLength = static_cast<FloatEbmType>(pCutHighModificationExclusiveBoundary->m_iVal - iVal);
+      } else {
+         EBM_ASSERT(iValFloat < pCutHighModificationExclusiveBoundary->m_iValAspirationalFloat);
+         stepLength = pCutHighModificationExclusiveBoundary->m_iValAspirationalFloat - stepPoint;
+      }
+      stepLength /= static_cast<FloatEbmType>(cRangesHighModification);
+
+      pCutAspirational = pCutHighModificationExclusiveBoundary;
+      while(size_t { 0 } != --cRangesHighModification) {
+         pCutAspirational = pCutAspirational->m_pPrev;
+         const FloatEbmType iValAspirationalFloat = stepPoint + 
+            stepLength * static_cast<FloatEbmType>(cRangesHighModification);
+         pCutAspirational->m_iValAspirationalFloat = iValAspirationalFloat;
+      }
 
-         CutPoint * pCutHighHighPlanInclusiveBoundary = pCutHighHighVisibilityInclusiveBoundary;
-         CutPoint * pCutHighLowPlanInclusiveBoundary = pCutCur;
-         size_t cRangesHighLowPlan = size_t { 0 };
+      CutPoint * pCutLowLowPlanInclusiveBoundary = pCutLowLowVisibilityInclusiveBoundary;
+      CutPoint * pCutLowHighPlanInclusiveBoundary = pCutCur;
+      size_t cRangesLowHighPlan = size_t { 0 };
 
-         size_t iValHighHighPlan = LIKELY(k_movementDoneCut == cPredeterminedMovementOnCutHighHigh) ? 
-            pCutHighHighPlanInclusiveBoundary->m_iVal : k_valNotLegal;
-         size_t iValHighLowPlan = iVal;
+      size_t iValLowLowPlan = LIKELY(k_movementDoneCut == cPredeterminedMovementOnCutLowLow) ? 
+         pCutLowLowPlanInclusiveBoundary->m_iVal : k_valNotLegal;
+      size_t iValLowHighPlan = iVal;
 
-         CutPoint * pCutHighPlanCur = pCutCur;
+      CutPoint * pCutLowPlanCur = pCutCur;
 
-         while(true) {
-            if(UNLIKELY(k_valNotLegal == iValHighHighPlan)) {
-               EBM_ASSERT(!pCutHighHighPlanInclusiveBoundary->IsCut());
-               pCutHighHighPlanInclusiveBoundary = pCutHighHighPlanInclusiveBoundary->m_pNext;
-               if(UNLIKELY(pCutHighHighPlanInclusiveBoundary->IsCut())) {
-                  iValHighHighPlan = pCutHighHighPlanInclusiveBoundary->m_iVal;
-               }
-            } else {
-               EBM_ASSERT(pCutHighHighPlanInclusiveBoundary->IsCut());
-               --cRangesHighHighPlan;
-               if(UNLIKELY(0 == cRangesHighHighPlan)) {
-                  // we've reached the hard boundary of a materialized cut
-                  break;
-               }
+      while(true) {
+         if(UNLIKELY(k_valNotLegal == iValLowLowPlan)) {
+            EBM_ASSERT(!pCutLowLowPlanInclusiveBoundary->IsCut());
+            pCutLowLowPlanInclusiveBoundary = pCutLowLowPlanInclusiveBoundary->m_pPrev;
+            if(UNLIKELY(pCutLowLowPlanInclusiveBoundary->IsCut())) {
+               iValLowLowPlan = pCutLowLowPlanInclusiveBoundary->m_iVal;
             }
+         } else {
+            EBM_ASSERT(pCutLowLowPlanInclusiveBoundary->IsCut());
+            --cRangesLowLowPlan;
+            if(UNLIKELY(0 == cRangesLowLowPlan)) {
+               // we've reached the hard boundary of a materialized cut
+               break;
+            }
+         }
 
-            if(UNLIKELY(k_cutExploreDistance == cRangesHighLowPlan)) {
-               pCutHighLowPlanInclusiveBoundary = pCutHighLowPlanInclusiveBoundary->m_pNext;
-               EBM_ASSERT(!pCutHighLowPlanInclusiveBoundary->IsCut());
-               iValHighLowPlan = k_valNotLegal;
-               if(UNLIKELY(pCutHighLowPlanInclusiveBoundary == pCutHighModificationExclusiveBoundary)) {
-                  // we've reached the boundary of where we changed the aspirational cuts, so no changes should
-                  // occur beyond this point
-                  break;
-               }
-            } else {
-               EBM_ASSERT(pCutHighLowPlanInclusiveBoundary->IsCut());
-               EBM_ASSERT(k_valNotLegal != iValHighLowPlan);
-               ++cRangesHighLowPlan;
+         if(UNLIKELY(k_cutExploreDistance == cRangesLowHighPlan)) {
+            pCutLowHighPlanInclusiveBoundary = pCutLowHighPlanInclusiveBoundary->m_pPrev;
+            EBM_ASSERT(!pCutLowHighPlanInclusiveBoundary->IsCut());
+            iValLowHighPlan = k_valNotLegal;
+            if(UNLIKELY(pCutLowHighPlanInclusiveBoundary == pCutLowModificationExclusiveBoundary)) {
+               // we've reached the boundary of where we changed the aspirational cuts, so no changes should
+               // occur beyond this point
+               break;
             }
+         } else {
+            EBM_ASSERT(pCutLowHighPlanInclusiveBoundary->IsCut());
+            EBM_ASSERT(k_valNotLegal != iValLowHighPlan);
+            ++cRangesLowHighPlan;
+         }
 
-            pCutHighPlanCur = pCutHighPlanCur->m_pNext;
-            EBM_ASSERT(!pCutHighPlanCur->IsCut()); // we should have exited on 0 == cRangesHighHighPlan beforehand
+         pCutLowPlanCur = pCutLowPlanCur->m_pPrev;
+         EBM_ASSERT(!pCutLowPlanCur->IsCut()); // we should have exited on 0 == cRangesLowLowPlan beforehand
 
-            BuildNeighbourhoodPlan(
-               cSamples,
-               bSymmetryReversal,
+         BuildNeighbourhoodPlan(
+            cSamples,
+            bSymmetryReversal,
 
-               cSamplesPerBinMin,
-               iValuesStart,
-               cCuttableItems,
-               aNeighbourJumps,
+            cSamplesPerBinMin,
+            iValuesStart,
+            cCuttableItems,
+            aNeighbourJumps,
+
+            cRangesLowLowPlan,
+            iValLowLowPlan,
+            pCutLowLowPlanInclusiveBoundary->m_iValAspirationalFloat,
+
+            cRangesLowHighPlan,
+            iValLowHighPlan,
+            pCutLowHighPlanInclusiveBoundary->m_iValAspirationalFloat,
+
+            pCutLowPlanCur
+         );
+      }
+
+      CutPoint * pCutHighHighPlanInclusiveBoundary = pCutHighHighVisibilityInclusiveBoundary;
+      CutPoint * pCutHighLowPlanInclusiveBoundary = pCutCur;
+      size_t cRangesHighLowPlan = size_t { 0 };
+
+      size_t iValHighHighPlan = LIKELY(k_movementDoneCut == cPredeterminedMovementOnCutHighHigh) ? 
+         pCutHighHighPlanInclusiveBoundary->m_iVal : k_valNotLegal;
+      size_t iValHighLowPlan = iVal;
 
-               cRangesHighLowPlan,
-               iValHighLowPlan,
-               pCutHighLowPlanInclusiveBoundary->m_iValAspirationalFloat,
+      CutPoint * pCutHighPlanCur = pCutCur;
 
-               cRangesHighHighPlan,
-               iValHighHighPlan,
-               pCutHighHighPlanInclusiveBoundary->m_iValAspirationalFloat,
+      while(true) {
+         if(UNLIKELY(k_valNotLegal == iValHighHighPlan)) {
+            EBM_ASSERT(!pCutHighHighPlanInclusiveBoundary->IsCut());
+            pCutHighHighPlanInclusiveBoundary = pCutHighHighPlanInclusiveBoundary->m_pNext;
+            if(UNLIKELY(pCutHighHighPlanInclusiveBoundary->IsCut())) {
+               iValHighHighPlan = pCutHighHighPlanInclusiveBoundary->m_iVal;
+            }
+         } else {
+            EBM_ASSERT(pCutHighHighPlanInclusiveBoundary->IsCut());
+            --cRangesHighHighPlan;
+            if(UNLIKELY(0 == cRangesHighHighPlan)) {
+               // we've reached the hard boundary of a materialized cut
+               break;
+            }
+         }
 
-               pCutHighPlanCur
-            );
+         if(UNLIKELY(k_cutExploreDistance == cRangesHighLowPlan)) {
+            pCutHighLowPlanInclusiveBoundary = pCutHighLowPlanInclusiveBoundary->m_pNext;
+            EBM_ASSERT(!pCutHighLowPlanInclusiveBoundary->IsCut());
+            iValHighLowPlan = k_valNotLegal;
+            if(UNLIKELY(pCutHighLowPlanInclusiveBoundary == pCutHighModificationExclusiveBoundary)) {
+               // we've reached the boundary of where we changed the aspirational cuts, so no changes should
+               // occur beyond this point
+               break;
+            }
+         } else {
+            EBM_ASSERT(pCutHighLowPlanInclusiveBoundary->IsCut());
+            EBM_ASSERT(k_valNotLegal != iValHighLowPlan);
+            ++cRangesHighLowPlan;
          }
 
-         // TODO: For each cut point we've examined our neighbourhood and selected a right/left decison that we can live with
-         // for that cut point independent of all the other ones.  We can then maybe do an analysis to see if our
-         // ideas for the neighbours match up with theirs and do some jiggering if the outcome within a window is bad
-         // this allows us to see a bigger area, so we have to be careful that changes don't cascade beyond our visibility
-         // window.  Perhaps we allow changes to ASPIRATIONAL cuts within our hard change boundary, but don't
-         // change things outside of this window.
+         pCutHighPlanCur = pCutHighPlanCur->m_pNext;
+         EBM_ASSERT(!pCutHighPlanCur->IsCut()); // we should have exited on 0 == cRangesHighHighPlan beforehand
 
-         EBM_ASSERT(pBestCuts->end() != pBestCuts->find(pCutCur));
-         pBestCuts->erase(pCutCur);
+         BuildNeighbourhoodPlan(
+            cSamples,
+            bSymmetryReversal,
 
-         // Ok, so now we've computed our aspirational cut points, and decided where we'd go for each cut point if we
-         // were forced to select a cut point now.  We now need to calculate the PRIORITY for all our cut points
-         // 
-         // Initially we have a lot of options when deciding cuts.  As time goes on, we get less options.  We want our
-         // first cut to minimize the danger that later cuts will force us into a bad position.  
-
-         // When calculating the pririty of a cut point a couple of things come to mind:
-         //   - if we have a large open space of many un-materialized cuts, an aspiration cut in the middle that falls 
-         //     into a big range is not a threat yet since we can deftly avoid it by changing by small amounts the
-         //     aspirational cuts on both ends, BUT if someone puts down a ham-fisted cut right down next to it then
-         //     we'll have a problem
-         //   - even if the cuts in the center are good, a cut in the center next to a large range of equal values could
-         //     create a problem for us easily (so we should include metrics on the goodness of cuts)
-         //   - our cut materializer needs to be smart and examine the local space before it finalizes a cut, so that
-         //     we avoid the largest risks around putting down ham-fisted cuts.  So, with this combination we can relax
-         //     and not worry about the asipirational cuts in the middle of a large un-materialized section, whether
-         //     they fall onto a currently bad cut or not
-         //   - the asipirational cuts near the boundaries of materialized cuts are the most problematic, especially
-         //     if they currently happen to be hard decision cuts.  We probably want to make the hard decisions early
-         //     when we have the most flexibility to address them
-         //   - so, our algorithm will tend to first materialize the cuts near existing boundaries and move inwards as
-         //     spaces that were previously not problems become more constrained
-         //   - we might or might not want to include results from our decisions about where we'll put cuts.  For
-         //     instance, let's say a potential cut point has one good option and one terrible option.  We may want
-         //     to materialize the good option so that a neighbour cut doesn't force us to take the terrible option
-         //     But this issue is reduced if before we materialize cuts we do an exploration of of the local space to
-         //     avoid hurting neighbours.
-         //   - in general, because cuts tend to disrupt many other aspirational cuts, we should probably weigh the exact
-         //     cut plan less and concentrate of making the most disruptive cuts first.  We might find that our carefully
-         //     crafted plan for future cuts is irrelevant and we no longer even make cuts on ranges that we thought
-         //     were important previously.
-         //   - by choosing the most disruptive cuts first, we'll probably get to a point quickly were most of our
-         //     remaining potential cuts are non-conrovertial.  All the hard decisions will be made early and we'll be
-         //     left with the cuts that jiggle the remaining cuts less.
-         //
-         //
-         //
-         // TODO: CONSIDER (very tentatively) incorporating how bad it would be if we were forced to choose the worse side to cut on
-         // if that's a bad scenario, we should probably try increasing our priority for our aspirational cut point
-         // since we want that one to be materialized first. 
-         // There are a lot of metrics we might use.  Three ideas:
-         //   1) Look at how bad the best solution for any particular cut is.. if it's bad it's probably because the
-         //      alternatives were worse
-         //   2) Look at how bad the worst solution for any particular cut is.. we don't want to be forced to take the
-         //      worst
-         //   3) * take the aspirational cut, take the best matrialized cut, calculate what percentage we need to
-         //      stretch from either boundary (the low boundary and the high boundary).  Take the one that has the highest
-         //      percentage stretch
-         //
-         // I like #3 (it's the one we have implemented now), because after we choose each cut everything 
-         // within the visibility windows gets re-shuffed.  We might not even fall on some of the problematic 
-         // ranges anymore.  Choosing the cuts with the highest "tension" causes
-         // us to decide the longest ranges that are the closest to one of our existing imovable boundaries thus
-         // we're nailing down the ones that'll cause the most movement first while we have the most room, and it also
-         // captures the idea that these are bad ones that need to be selected.  It'll tend to try deciding cuts
-         // near our existing edge boundaries first instead of the ones in the center.  This is good since the ones at
-         // the boundaries are more critical.  As we materialize cuts we'll get closer to the center and those will start
-         // to want attention
-
-         CutPoint * pCutLowLowPriorityInclusiveBoundary = pCutLowLowVisibilityInclusiveBoundary;
-         CutPoint * pCutLowHighPriorityInclusiveBoundary = pCutCur;
-         size_t cRangesLowHighPriority = 0;
-         CutPoint * pCutLowPriorityCur = pCutCur;
-
-         while(true) {
-            pCutLowPriorityCur = pCutLowPriorityCur->m_pPrev;
-            if(PREDICTABLE(k_movementDoneCut != cPredeterminedMovementOnCutLowLow)) {
-               EBM_ASSERT(!pCutLowLowPriorityInclusiveBoundary->IsCut());
-               pCutLowLowPriorityInclusiveBoundary = pCutLowLowPriorityInclusiveBoundary->m_pPrev;
-               cPredeterminedMovementOnCutLowLow = pCutLowLowPriorityInclusiveBoundary->m_cPredeterminedMovementOnCut;
-            } else {
-               EBM_ASSERT(pCutLowLowPriorityInclusiveBoundary->IsCut());
-               if(UNLIKELY(pCutLowPriorityCur == pCutLowLowPriorityInclusiveBoundary)) {
-                  EBM_ASSERT(pCutLowPriorityCur->IsCut());
-                  break;
-               }
+            cSamplesPerBinMin,
+            iValuesStart,
+            cCuttableItems,
+            aNeighbourJumps,
+
+            cRangesHighLowPlan,
+            iValHighLowPlan,
+            pCutHighLowPlanInclusiveBoundary->m_iValAspirationalFloat,
+
+            cRangesHighHighPlan,
+            iValHighHighPlan,
+            pCutHighHighPlanInclusiveBoundary->m_iValAspirationalFloat,
+
+            pCutHighPlanCur
+         );
+      }
+
+      // TODO: For each cut point we've examined our neighbourhood and selected a right/left decison that we can live with
+      // for that cut point independent of all the other ones.  We can then maybe do an analysis to see if our
+      // ideas for the neighbours match up with theirs and do some jiggering if the outcome within a window is bad
+      // this allows us to see a bigger area, so we have to be careful that changes don't cascade beyond our visibility
+      // window.  Perhaps we allow changes to ASPIRATIONAL cuts within our hard change boundary, but don't
+      // change things outside of this window.
+
+      pBestCuts->Remove(pCutCur);
+
+      // Ok, so now we've computed our aspirational cut points, and decided where we'd go for each cut point if we
+      // were forced to select a cut point now.  We now need to calculate the PRIORITY for all our cut points
+      // 
+      // Initially we have a lot of options when deciding cuts.  As time goes on, we get less options.  We want our
+      // first cut to minimize the danger that later cuts will force us into a bad position.  
+
+      // When calculating the pririty of a cut point a couple of things come to mind:
+      //   - if we have a large open space of many un-materialized cuts, an aspiration cut in the middle that falls 
+      //     into a big range is not a threat yet since we can deftly avoid it by changing by small amounts the
+      //     aspirational cuts on both ends, BUT if someone puts down a ham-fisted cut right down next to it then
+      //     we'll have a problem
+      //   - even if the cuts in the center are good, a cut in the center next to a large range of equal values could
+      //     create a problem for us easily (so we should include metrics on the goodness of cuts)
+      //   - our cut materializer needs to be smart and examine the local space before it finalizes a cut, so that
+      //     we avoid the largest risks around putting down ham-fisted cuts.  So, with this combination we can relax
+      //     and not worry about the asipirational cuts in the middle of a large un-materialized section, whether
+      //     they fall onto a currently bad cut or not
+      //   - the asipirational cuts near the boundaries of materialized cuts are the most problematic, especially
+      //     if they currently happen to be hard decision cuts.  We probably want to make the hard decisions early
+      //     when we have the most flexibility to address them
+      //   - so, our algorithm will tend to first materialize the cuts near existing boundaries and move inwards as
+      //     spaces that were previously not problems become more constrained
+      //   - we might or might not want to include results from our decisions about where we'll put cuts.  For
+      //     instance, let's say a potential cut point has one good option and one terrible option.  We may want
+      //     to materialize the good option so that a neighbour cut doesn't force us to take the terrible option
+      //     But this issue is reduced if before we materialize cuts we do an exploration of of the local space to
+      //     avoid hurting neighbours.
+      //   - in general, because cuts tend to disrupt many other aspirational cuts, we should probably weigh the exact
+      //     cut plan less and concentrate of making the most disruptive cuts first.  We might find that our carefully
+      //     crafted plan for future cuts is irrelevant and we no longer even make cuts on ranges that we thought
+      //     were important previously.
+      //   - by choosing the most disruptive cuts first, we'll probably get to a point quickly were most of our
+      //     remaining potential cuts are non-conrovertial.  All the hard decisions will be made early and we'll be
+      //     left with the cuts that jiggle the remaining cuts less.
+      //
+      //
+      //
+      // TODO: CONSIDER (very tentatively) incorporating how bad it would be if we were forced to choose the worse side to cut on
+      // if that's a bad scenario, we should probably try increasing our priority for our aspirational cut point
+      // since we want that one to be materialized first. 
+      // There are a lot of metrics we might use.  Three ideas:
+      //   1) Look at how bad the best solution for any particular cut is.. if it's bad it's probably because the
+      //      alternatives were worse
+      //   2) Look at how bad the worst solution for any particular cut is.. we don't want to be forced to take the
+      //      worst
+      //   3) * take the aspirational cut, take the best matrialized cut, calculate what percentage we need to
+      //      stretch from either boundary (the low boundary and the high boundary).  Take the one that has the highest
+      //      percentage stretch
+      //
+      // I like #3 (it's the one we have implemented now), because after we choose each cut everything 
+      // within the visibility windows gets re-shuffed.  We might not even fall on some of the problematic 
+      // ranges anymore.  Choosing the cuts with the highest "tension" causes
+      // us to decide the longest ranges that are the closest to one of our existing imovable boundaries thus
+      // we're nailing down the ones that'll cause the most movement first while we have the most room, and it also
+      // captures the idea that these are bad ones that need to be selected.  It'll tend to try deciding cuts
+      // near our existing edge boundaries first instead of the ones in the center.  This is good since the ones at
+      // the boundaries are more critical.  As we materialize cuts we'll get closer to the center and those will start
+      // to want attention
+
+      CutPoint * pCutLowLowPriorityInclusiveBoundary = pCutLowLowVisibilityInclusiveBoundary;
+      CutPoint * pCutLowHighPriorityInclusiveBoundary = pCutCur;
+      size_t cRangesLowHighPriority = 0;
+      CutPoint * pCutLowPriorityCur = pCutCur;
+
+      while(true) {
+         pCutLowPriorityCur = pCutLowPriorityCur->m_pPrev;
+         if(PREDICTABLE(k_movementDoneCut != cPredeterminedMovementOnCutLowLow)) {
+            EBM_ASSERT(!pCutLowLowPriorityInclusiveBoundary->IsCut());
+            pCutLowLowPriorityInclusiveBoundary = pCutLowLowPriorityInclusiveBoundary->m_pPrev;
+            cPredeterminedMovementOnCutLowLow = pCutLowLowPriorityInclusiveBoundary->m_cPredeterminedMovementOnCut;
+         } else {
+            EBM_ASSERT(pCutLowLowPriorityInclusiveBoundary->IsCut());
+            if(UNLIKELY(pCutLowPriorityCur == pCutLowLowPriorityInclusiveBoundary)) {
+               EBM_ASSERT(pCutLowPriorityCur->IsCut());
+               break;
             }
-            EBM_ASSERT(!pCutLowPriorityCur->IsCut());
+         }
+         EBM_ASSERT(!pCutLowPriorityCur->IsCut());
 
-            if(PREDICTABLE(k_cutExploreDistance == cRangesLowHighPriority)) {
-               pCutLowHighPriorityInclusiveBoundary = pCutLowHighPriorityInclusiveBoundary->m_pPrev;
-               EBM_ASSERT(!pCutLowHighPriorityInclusiveBoundary->IsCut());
-               if(UNLIKELY(pCutLowHighPriorityInclusiveBoundary == pCutLowModificationExclusiveBoundary)) {
+         if(PREDICTABLE(k_cutExploreDistance == cRangesLowHighPriority)) {
+            pCutLowHighPriorityInclusiveBoundary = pCutLowHighPriorityInclusiveBoundary->m_pPrev;
+            EBM_ASSERT(!pCutLowHighPriorityInclusiveBoundary->IsCut());
+            if(UNLIKELY(pCutLowHighPriorityInclusiveBoundary == pCutLowModificationExclusiveBoundary)) {
 
 #ifndef NDEBUG
 
-                  FloatEbmType debugPriority = CalculatePriority(
-                     pCutLowLowPriorityInclusiveBoundary->m_iValAspirationalFloat,
-                     pCutLowHighPriorityInclusiveBoundary->m_iValAspirationalFloat,
-                     pCutLowPriorityCur
-                  );
+               FloatEbmType debugPriority = CalculatePriority(
+                  pCutLowLowPriorityInclusiveBoundary->m_iValAspirationalFloat,
+                  pCutLowHighPriorityInclusiveBoundary->m_iValAspirationalFloat,
+                  pCutLowPriorityCur
+               );
 
-                  // these should be calculated via the same pathway, so should be identical
-                  EBM_ASSERT(debugPriority == pCutLowPriorityCur->m_priority);
+               // these should be calculated via the same pathway, so should be identical
+               EBM_ASSERT(debugPriority == pCutLowPriorityCur->m_priority);
 
 #endif // NDEBUG
 
-                  break;
-               }
-            } else {
-               EBM_ASSERT(pCutLowHighPriorityInclusiveBoundary->IsCut());
-               ++cRangesLowHighPriority;
+               break;
             }
+         } else {
+            EBM_ASSERT(pCutLowHighPriorityInclusiveBoundary->IsCut());
+            ++cRangesLowHighPriority;
+         }
 
-            EBM_ASSERT(pBestCuts->end() != pBestCuts->find(pCutLowPriorityCur));
-            pBestCuts->erase(pCutLowPriorityCur);
-
-            pCutLowPriorityCur->m_priority = CalculatePriority(
-               pCutLowLowPriorityInclusiveBoundary->m_iValAspirationalFloat,
-               pCutLowHighPriorityInclusiveBoundary->m_iValAspirationalFloat,
-               pCutLowPriorityCur
-            );
+         pCutLowPriorityCur->m_priority = CalculatePriority(
+            pCutLowLowPriorityInclusiveBoundary->m_iValAspirationalFloat,
+            pCutLowHighPriorityInclusiveBoundary->m_iValAspirationalFloat,
+            pCutLowPriorityCur
+         );
 
-            pBestCuts->insert(pCutLowPriorityCur);
-         }
+         pBestCuts->Update(pCutLowPriorityCur);
+      }
 
-         CutPoint * pCutHighHighPriorityInclusiveBoundary = pCutHighHighVisibilityInclusiveBoundary;
-         CutPoint * pCutHighLowPriorityInclusiveBoundary = pCutCur;
-         size_t cRangesHighLowPriority = 0;
-         CutPoint * pCutHighPriorityCur = pCutCur;
-
-         while(true) {
-            pCutHighPriorityCur = pCutHighPriorityCur->m_pNext;
-            if(PREDICTABLE(k_movementDoneCut != cPredeterminedMovementOnCutHighHigh)) {
-               EBM_ASSERT(!pCutHighHighPriorityInclusiveBoundary->IsCut());
-               pCutHighHighPriorityInclusiveBoundary = pCutHighHighPriorityInclusiveBoundary->m_pNext;
-               cPredeterminedMovementOnCutHighHigh = pCutHighHighPriorityInclusiveBoundary->m_cPredeterminedMovementOnCut;
-            } else {
-               EBM_ASSERT(pCutHighHighPriorityInclusiveBoundary->IsCut());
-               if(UNLIKELY(pCutHighPriorityCur == pCutHighHighPriorityInclusiveBoundary)) {
-                  EBM_ASSERT(pCutHighPriorityCur->IsCut());
-                  break;
-               }
+      CutPoint * pCutHighHighPriorityInclusiveBoundary = pCutHighHighVisibilityInclusiveBoundary;
+      CutPoint * pCutHighLowPriorityInclusiveBoundary = pCutCur;
+      size_t cRangesHighLowPriority = 0;
+      CutPoint * pCutHighPriorityCur = pCutCur;
+
+      while(true) {
+         pCutHighPriorityCur = pCutHighPriorityCur->m_pNext;
+         if(PREDICTABLE(k_movementDoneCut != cPredeterminedMovementOnCutHighHigh)) {
+            EBM_ASSERT(!pCutHighHighPriorityInclusiveBoundary->IsCut());
+            pCutHighHighPriorityInclusiveBoundary = pCutHighHighPriorityInclusiveBoundary->m_pNext;
+            cPredeterminedMovementOnCutHighHigh = pCutHighHighPriorityInclusiveBoundary->m_cPredeterminedMovementOnCut;
+         } else {
+            EBM_ASSERT(pCutHighHighPriorityInclusiveBoundary->IsCut());
+            if(UNLIKELY(pCutHighPriorityCur == pCutHighHighPriorityInclusiveBoundary)) {
+               EBM_ASSERT(pCutHighPriorityCur->IsCut());
+               break;
             }
-            EBM_ASSERT(!pCutHighPriorityCur->IsCut());
+         }
+         EBM_ASSERT(!pCutHighPriorityCur->IsCut());
 
-            if(PREDICTABLE(k_cutExploreDistance == cRangesHighLowPriority)) {
-               pCutHighLowPriorityInclusiveBoundary = pCutHighLowPriorityInclusiveBoundary->m_pNext;
-               EBM_ASSERT(!pCutHighLowPriorityInclusiveBoundary->IsCut());
-               if(UNLIKELY(pCutHighLowPriorityInclusiveBoundary == pCutHighModificationExclusiveBoundary)) {
+         if(PREDICTABLE(k_cutExploreDistance == cRangesHighLowPriority)) {
+            pCutHighLowPriorityInclusiveBoundary = pCutHighLowPriorityInclusiveBoundary->m_pNext;
+            EBM_ASSERT(!pCutHighLowPriorityInclusiveBoundary->IsCut());
+            if(UNLIKELY(pCutHighLowPriorityInclusiveBoundary == pCutHighModificationExclusiveBoundary)) {
 
 #ifndef NDEBUG
 
-                  FloatEbmType debugPriority = CalculatePriority(
-                     pCutHighLowPriorityInclusiveBoundary->m_iValAspirationalFloat,
-                     pCutHighHighPriorityInclusiveBoundary->m_iValAspirationalFloat,
-                     pCutHighPriorityCur
-                  );
+               FloatEbmType debugPriority = CalculatePriority(
+                  pCutHighLowPriorityInclusiveBoundary->m_iValAspirationalFloat,
+                  pCutHighHighPriorityInclusiveBoundary->m_iValAspirationalFloat,
+                  pCutHighPriorityCur
+               );
 
-                  // these should be calculated via the same pathway, so should be identical
-                  EBM_ASSERT(debugPriority == pCutHighPriorityCur->m_priority);
+               // these should be calculated via the same pathway, so should be identical
+               EBM_ASSERT(debugPriority == pCutHighPriorityCur->m_priority);
 
 #endif // NDEBUG
 
-                  break;
-               }
-            } else {
-               EBM_ASSERT(pCutHighLowPriorityInclusiveBoundary->IsCut());
-               ++cRangesHighLowPriority;
+               break;
             }
+         } else {
+            EBM_ASSERT(pCutHighLowPriorityInclusiveBoundary->IsCut());
+            ++cRangesHighLowPriority;
+         }
 
-            EBM_ASSERT(pBestCuts->end() != pBestCuts->find(pCutHighPriorityCur));
-            pBestCuts->erase(pCutHighPriorityCur);
-
-            pCutHighPriorityCur->m_priority = CalculatePriority(
-               pCutHighLowPriorityInclusiveBoundary->m_iValAspirationalFloat,
-               pCutHighHighPriorityInclusiveBoundary->m_iValAspirationalFloat,
-               pCutHighPriorityCur
-            );
+         pCutHighPriorityCur->m_priority = CalculatePriority(
+            pCutHighLowPriorityInclusiveBoundary->m_iValAspirationalFloat,
+            pCutHighHighPriorityInclusiveBoundary->m_iValAspirationalFloat,
+            pCutHighPriorityCur
+         );
 
-            pBestCuts->insert(pCutHighPriorityCur);
-         }
+         pBestCuts->Update(pCutHighPriorityCur);
       }
-   } catch(...) {
-      LOG_0(TraceLevelWarning, "WARNING CutSegment exception");
-      return true;
    }
 
    IronCuts();
@@ -1491,7 +1613,7 @@ static bool CutCuttingRange(
 }
 
 static bool TreeSearchCutSegment(
-   std::set<CutPoint *, CompareCutPoint> * pBestCuts,
+   CutPointHeap * const pBestCuts,
 
    const size_t cSamples,
    const bool bSymmetryReversal,
@@ -1505,174 +1627,169 @@ static bool TreeSearchCutSegment(
    // for efficiency we include space for the end point cuts even if they don't exist
    CutPoint * const aCutsWithENDPOINTS
 ) noexcept {
-   try {
-      EBM_ASSERT(nullptr != pBestCuts);
-      EBM_ASSERT(pBestCuts->empty());
-
-      EBM_ASSERT(2 <= cSamples); // we need at least 2 to split, otherwise we'd have exited before calling here
-      EBM_ASSERT(1 <= cSamplesPerBinMin);
-
-      EBM_ASSERT(nullptr != aNeighbourJumps);
-
-      EBM_ASSERT(2 <= cRanges);
-      EBM_ASSERT(cSamplesPerBinMin <= cCuttableItems / cRanges);
-      EBM_ASSERT(nullptr != aCutsWithENDPOINTS);
-
-      // - TODO: EXPLORING BOTH SIDES
-      //   - this function calls CutSegment, which greedily materializes cuts, so when it's unsure about a cut
-      //     it needs to be conservative and pick the least likley cut to cause problems down the road
-      //   - at this higher level, we can try cutting both low AND high AND skip the cut.  We use CutCuttingRange to
-      //     do the full exploration of both options and then we pick the better one.
-      //   - we can also explore N steps in the future to pick the best first step, then delete the worst 1st step
-      //     and keep all the work we did along the choice that we made (the remaining 128 options) then we can pick
-      //     the best step from all those 128 options and continue this way.  Since we do a complete recalculation
-      //     of all the Cuts we can only do this several times, but it allows us to have 2 levels of fallback
-
-      //   - we can design an algorithm that divides into 255 and chooses the worst one and then does a complete fit on either direction.Best fit is recorded
-      //     then we re-do all 254 other cuts on BOTH sides.  We can only do a set number of these, so after 8 levels we'd have 256 attempts.  That might be acceptable
-      //   - the algorithm that we have below plays it safe since it needs to live with it's decions.  This more spectlative algorithm above can be more
-      //     risky since it plays both directions a bad play won't undermine it.  As such, we should try and chose the worst decion without regard to position
-      //     so in other words, try to choose the range that we have a drop point in in the middle where we need to move the most to get away from the 
-      //     best drops.  We can also try going left, going right, OR not choosing.  Don't traverse down the NO choice path, so we add 50% load, but we don't grow at 3^N, and we'll 
-      //     also explore the no choice at the root option
-      //
+   EBM_ASSERT(nullptr != pBestCuts);
+   EBM_ASSERT(pBestCuts->IsEmpty());
 
-      //constexpr size_t k_CutExploreDepth = 8;
-      //constexpr size_t k_CutExplorations = size_t { 1 } << k_CutExploreDepth;
+   EBM_ASSERT(2 <= cSamples); // we need at least 2 to split, otherwise we'd have exited before calling here
+   EBM_ASSERT(1 <= cSamplesPerBinMin);
 
-      CutPoint * pCutCur = &aCutsWithENDPOINTS[0];
-      CutPoint * pCutNext = &aCutsWithENDPOINTS[1];
+   EBM_ASSERT(nullptr != aNeighbourJumps);
 
-      pCutCur->m_pNext = pCutNext;
-      pCutCur->SetCut();
-      pCutCur->m_iValAspirationalFloat = FloatEbmType { 0 };
-      pCutCur->m_iVal = size_t { 0 };
-
-      const FloatEbmType stepInit = static_cast<FloatEbmType>(cCuttableItems) / static_cast<FloatEbmType>(cRanges);
-      EBM_ASSERT(cSamplesPerBinMin <= 1.00001 * stepInit);
-
-      const FloatEbmType cCuttableItemsFloat = static_cast<FloatEbmType>(cCuttableItems);
-      size_t iCutCur = 1;
-      size_t iValLow = size_t { 0 };
-      FloatEbmType iValAspirationalLowFloat = FloatEbmType { 0 };
-      size_t cRangesHigh = k_cutExploreDistance;
-      size_t iValHigh = k_valNotLegal;
-      do {
-         pCutNext->m_pPrev = pCutCur;
-         pCutCur = pCutNext;
-         ++pCutNext;
-         pCutCur->m_pNext = pCutNext;
-
-         size_t cRangesLow;
-         const ptrdiff_t iRangeLow = 
-            static_cast<ptrdiff_t>(iCutCur) - static_cast<ptrdiff_t>(k_cutExploreDistance);
-         if(UNLIKELY(iRangeLow <= ptrdiff_t { 0 })) {
-            cRangesLow = iCutCur;
-            EBM_ASSERT(size_t { 0 } == iValLow);
-            EBM_ASSERT(FloatEbmType { 0 } == iValAspirationalLowFloat);
-         } else {
-            cRangesLow = k_cutExploreDistance;
-            iValLow = k_valNotLegal;
-            iValAspirationalLowFloat = stepInit * static_cast<FloatEbmType>(static_cast<size_t>(iRangeLow));
-         }
+   EBM_ASSERT(2 <= cRanges);
+   EBM_ASSERT(cSamplesPerBinMin <= cCuttableItems / cRanges);
+   EBM_ASSERT(nullptr != aCutsWithENDPOINTS);
+
+   // - TODO: EXPLORING BOTH SIDES
+   //   - this function calls CutSegment, which greedily materializes cuts, so when it's unsure about a cut
+   //     it needs to be conservative and pick the least likley cut to cause problems down the road
+   //   - at this higher level, we can try cutting both low AND high AND skip the cut.  We use CutCuttingRange to
+   //     do the full exploration of both options and then we pick the better one.
+   //   - we can also explore N steps in the future to pick the best first step, then delete the worst 1st step
+   //     and keep all the work we did along the choice that we made (the remaining 128 options) then we can pick
+   //     the best step from all those 128 options and continue this way.  Since we do a complete recalculation
+   //     of all the Cuts we can only do this several times, but it allows us to have 2 levels of fallback
+
+   //   - we can design an algorithm that divides into 255 and chooses the worst one and then does a complete fit on either direction.Best fit is recorded
+   //     then we re-do all 254 other cuts on BOTH sides.  We can only do a set number of these, so after 8 levels we'd have 256 attempts.  That might be acceptable
+   //   - the algorithm that we have below plays it safe since it needs to live with it's decions.  This more spectlative algorithm above can be more
+   //     risky since it plays both directions a bad play won't undermine it.  As such, we should try and chose the worst decion without regard to position
+   //     so in other words, try to choose the range that we have a drop point in in the middle where we need to move the most to get away from the 
+   //     best drops.  We can also try going left, going right, OR not choosing.  Don't traverse down the NO choice path, so we add 50% load, but we don't grow at 3^N, and we'll 
+   //     also explore the no choice at the root option
+   //
 
-         FloatEbmType iValAspirationalHighFloat;
-         size_t iRangeHigh = iCutCur + k_cutExploreDistance;
-         if(UNLIKELY(cRanges <= iRangeHigh)) {
-            cRangesHigh = cRanges - iCutCur;
-            iValHigh = cCuttableItems;
-            iValAspirationalHighFloat = cCuttableItemsFloat;
-         } else {
-            EBM_ASSERT(k_cutExploreDistance == cRangesHigh);
-            EBM_ASSERT(k_valNotLegal == iValHigh);
-            iValAspirationalHighFloat = stepInit * static_cast<FloatEbmType>(iRangeHigh);
-         }
+   //constexpr size_t k_CutExploreDepth = 8;
+   //constexpr size_t k_CutExplorations = size_t { 1 } << k_CutExploreDepth;
 
-         const FloatEbmType iValAspirationalCurFloat = stepInit * static_cast<FloatEbmType>(iCutCur);
-         pCutCur->m_iValAspirationalFloat = iValAspirationalCurFloat;
+   CutPoint * pCutCur = &aCutsWithENDPOINTS[0];
+   CutPoint * pCutNext = &aCutsWithENDPOINTS[1];
 
-         EBM_ASSERT(pCutCur->m_uniqueTiebreaker < cRanges);
+   pCutCur->m_pNext = pCutNext;
+   pCutCur->SetCut();
+   pCutCur->m_iValAspirationalFloat = FloatEbmType { 0 };
+   pCutCur->m_iVal = size_t { 0 };
 
-         BuildNeighbourhoodPlan(
-            cSamples,
-            bSymmetryReversal,
-            cSamplesPerBinMin,
-            iValuesStart,
-            cCuttableItems,
-            aNeighbourJumps,
-            cRangesLow,
-            iValLow,
-            iValAspirationalLowFloat,
-            cRangesHigh,
-            iValHigh,
-            iValAspirationalHighFloat,
-            pCutCur
-         );
-         ++iCutCur;
-      } while(iCutCur < cRanges);
+   const FloatEbmType stepInit = static_cast<FloatEbmType>(cCuttableItems) / static_cast<FloatEbmType>(cRanges);
+   EBM_ASSERT(cSamplesPerBinMin <= 1.00001 * stepInit);
 
+   const FloatEbmType cCuttableItemsFloat = static_cast<FloatEbmType>(cCuttableItems);
+   size_t iCutCur = 1;
+   size_t iValLow = size_t { 0 };
+   FloatEbmType iValAspirationalLowFloat = FloatEbmType { 0 };
+   size_t cRangesHigh = k_cutExploreDistance;
+   size_t iValHigh = k_valNotLegal;
+   do {
       pCutNext->m_pPrev = pCutCur;
-      pCutNext->m_pNext = nullptr;
-      pCutNext->SetCut();
-      pCutNext->m_iValAspirationalFloat = cCuttableItemsFloat;
-      pCutNext->m_iVal = cCuttableItems;
-
-
-      // now calculate priorities
-      CutPoint * pCutLow = &aCutsWithENDPOINTS[0];
-      CutPoint * pCutCenter = &aCutsWithENDPOINTS[1];
-      const size_t iRangeHigh = cRanges <= size_t { 1 } + k_cutExploreDistance ? 
-         cRanges : size_t { 1 } + k_cutExploreDistance;
-      CutPoint * pCutHigh = &aCutsWithENDPOINTS[iRangeHigh];
+      pCutCur = pCutNext;
+      ++pCutNext;
+      pCutCur->m_pNext = pCutNext;
 
-#ifndef NDEBUG
+      size_t cRangesLow;
+      const ptrdiff_t iRangeLow = 
+         static_cast<ptrdiff_t>(iCutCur) - static_cast<ptrdiff_t>(k_cutExploreDistance);
+      if(UNLIKELY(iRangeLow <= ptrdiff_t { 0 })) {
+         cRangesLow = iCutCur;
+         EBM_ASSERT(size_t { 0 } == iValLow);
+         EBM_ASSERT(FloatEbmType { 0 } == iValAspirationalLowFloat);
+      } else {
+         cRangesLow = k_cutExploreDistance;
+         iValLow = k_valNotLegal;
+         iValAspirationalLowFloat = stepInit * static_cast<FloatEbmType>(static_cast<size_t>(iRangeLow));
+      }
 
-      EBM_ASSERT(aCutsWithENDPOINTS[0].m_pNext == pCutCenter); // this will fail if we remove items above in the future
-      CutPoint * pCutDebug = pCutCenter;
-      for(size_t cDebugRemaining = k_cutExploreDistance; nullptr != pCutDebug->m_pNext && 0 < cDebugRemaining ; 
-         --cDebugRemaining) 
-      {
-         pCutDebug = pCutDebug->m_pNext;
+      FloatEbmType iValAspirationalHighFloat;
+      size_t iRangeHigh = iCutCur + k_cutExploreDistance;
+      if(UNLIKELY(cRanges <= iRangeHigh)) {
+         cRangesHigh = cRanges - iCutCur;
+         iValHigh = cCuttableItems;
+         iValAspirationalHighFloat = cCuttableItemsFloat;
+      } else {
+         EBM_ASSERT(k_cutExploreDistance == cRangesHigh);
+         EBM_ASSERT(k_valNotLegal == iValHigh);
+         iValAspirationalHighFloat = stepInit * static_cast<FloatEbmType>(iRangeHigh);
       }
-      // this will fail if we remove items above in the future
-      EBM_ASSERT(pCutDebug == pCutHigh);
 
-#endif // NDEBUG
+      const FloatEbmType iValAspirationalCurFloat = stepInit * static_cast<FloatEbmType>(iCutCur);
+      pCutCur->m_iValAspirationalFloat = iValAspirationalCurFloat;
+
+      EBM_ASSERT(pCutCur->m_uniqueTiebreaker < cRanges);
+
+      BuildNeighbourhoodPlan(
+         cSamples,
+         bSymmetryReversal,
+         cSamplesPerBinMin,
+         iValuesStart,
+         cCuttableItems,
+         aNeighbourJumps,
+         cRangesLow,
+         iValLow,
+         iValAspirationalLowFloat,
+         cRangesHigh,
+         iValHigh,
+         iValAspirationalHighFloat,
+         pCutCur
+      );
+      ++iCutCur;
+   } while(iCutCur < cRanges);
 
-      size_t cLowRanges = 1;
-      do {
-         // in the future we might write code above that removes Cuts, which if it were true could mean no legal cuts
-         EBM_ASSERT(nullptr != pCutCenter->m_pNext);
-         EBM_ASSERT(pCutLow < pCutCenter);
-         EBM_ASSERT(pCutCenter < pCutHigh);
-
-         pCutCenter->m_priority = CalculatePriority(
-            pCutLow->m_iValAspirationalFloat,
-            pCutHigh->m_iValAspirationalFloat,
-            pCutCenter
-         );
+   pCutNext->m_pPrev = pCutCur;
+   pCutNext->m_pNext = nullptr;
+   pCutNext->SetCut();
+   pCutNext->m_iValAspirationalFloat = cCuttableItemsFloat;
+   pCutNext->m_iVal = cCuttableItems;
 
-         EBM_ASSERT(!pCutCenter->IsCut());
-         pBestCuts->insert(pCutCenter);
 
-         if(UNLIKELY(k_cutExploreDistance != cLowRanges)) {
-            ++cLowRanges;
-         } else {
-            pCutLow = pCutLow->m_pNext;
-         }
+   // now calculate priorities
+   CutPoint * pCutLow = &aCutsWithENDPOINTS[0];
+   CutPoint * pCutCenter = &aCutsWithENDPOINTS[1];
+   const size_t iRangeHigh = cRanges <= size_t { 1 } + k_cutExploreDistance ? 
+      cRanges : size_t { 1 } + k_cutExploreDistance;
+   CutPoint * pCutHigh = &aCutsWithENDPOINTS[iRangeHigh];
 
-         if(UNLIKELY(pCutNext != pCutHigh)) {
-            pCutHigh = pCutHigh->m_pNext;
-         }
+#ifndef NDEBUG
 
-         pCutCenter = pCutCenter->m_pNext;
-      } while(pCutNext != pCutCenter);
-   } catch(...) {
-      LOG_0(TraceLevelWarning, "WARNING TreeSearchCutSegment exception");
-      return true;
+   EBM_ASSERT(aCutsWithENDPOINTS[0].m_pNext == pCutCenter); // this will fail if we remove items above in the future
+   CutPoint * pCutDebug = pCutCenter;
+   for(size_t cDebugRemaining = k_cutExploreDistance; nullptr != pCutDebug->m_pNext && 0 < cDebugRemaining ; 
+      --cDebugRemaining) 
+   {
+      pCutDebug = pCutDebug->m_pNext;
    }
+   // this will fail if we remove items above in the future
+   EBM_ASSERT(pCutDebug == pCutHigh);
 
-   return CutCuttingRange(
+#endif // NDEBUG
+
+   size_t cLowRanges = 1;
+   do {
+      // in the future we might write code above that removes Cuts, which if it were true could mean no legal cuts
+      EBM_ASSERT(nullptr != pCutCenter->m_pNext);
+      EBM_ASSERT(pCutLow < pCutCenter);
+      EBM_ASSERT(pCutCenter < pCutHigh);
+
+      pCutCenter->m_priority = CalculatePriority(
+         pCutLow->m_iValAspirationalFloat,
+         pCutHigh->m_iValAspirationalFloat,
+         pCutCenter
+      );
+
+      EBM_ASSERT(!pCutCenter->IsCut());
+      pBestCuts->Push(pCutCenter);
+
+      if(UNLIKELY(k_cutExploreDistance != cLowRanges)) {
+         ++cLowRanges;
+      } else {
+         pCutLow = pCutLow->m_pNext;
+      }
+
+      if(UNLIKELY(pCutNext != pCutHigh)) {
+         pCutHigh = pCutHigh->m_pNext;
+      }
+
+      pCutCenter = pCutCenter->m_pNext;
+   } while(pCutNext != pCutCenter);
+
+   return CutCuttingRange(
       pBestCuts,
       cSamples,
       bSymmetryReversal,
@@ -1684,7 +1801,7 @@ static bool TreeSearchCutSegment(
 }
 
 INLINE_RELEASE_UNTEMPLATED static bool TradeCutSegment(
-   std::set<CutPoint *, CompareCutPoint> * const pBestCuts,
+   CutPointHeap * const pBestCuts,
 
    const size_t cSamples,
    const bool bSymmetryReversal,
@@ -1792,17 +1909,16 @@ INLINE_RELEASE_UNTEMPLATED static size_t DetermineRangesMax(
 }
 
 static bool AddCutToRanges(
-   std::set<CuttingRange *, CompareCuttingRange> & queue
-) {
-   EBM_ASSERT(!queue.empty());
+   CuttingRangeHeap * const pQueue
+) noexcept {
+   EBM_ASSERT(nullptr != pQueue);
+   EBM_ASSERT(!pQueue->IsEmpty());
 
-   auto iterator = queue.begin();
-   CuttingRange * const pCuttingRangeAdd = *iterator;
+   CuttingRange * const pCuttingRangeAdd = pQueue->GetTop();
    if(k_illegalAvgCuttableRangeWidthAfterAddingOneCut == pCuttingRangeAdd->m_avgCuttableRangeWidthAfterAddingOneCut) {
       // nothing remaining in the queue can accept new cuts
       return true;
    }
-   queue.erase(iterator);
 
    // this is how many ranges we were assigned before deciding that this range would recieve a new cut
    const size_t cRangesPrev = pCuttingRangeAdd->m_cRangesAssigned;
@@ -1813,7 +1929,7 @@ static bool AddCutToRanges(
    FloatEbmType avgRangeWidthAfterAddingOneCut = k_illegalAvgCuttableRangeWidthAfterAddingOneCut;
    EBM_ASSERT(cRangesCur <= pCuttingRangeAdd->m_cRangesMax);
    if(LIKELY(pCuttingRangeAdd->m_cRangesMax != cRangesCur)) {
-      // we need to re-add our CuttingRange back into the priority queue.  If we were assigned a new range
+      // we need to re-position our CuttingRange within the priority queue.  If we were assigned a new range
       // again, this is how many we'd be at
       const size_t cRangesNext = cRangesCur + size_t { 1 };
       const size_t cCuttableItems = pCuttingRangeAdd->m_cCuttableValues;
@@ -1829,17 +1945,20 @@ static bool AddCutToRanges(
       // priorities, unlike for Cuts
    }
    pCuttingRangeAdd->m_avgCuttableRangeWidthAfterAddingOneCut = avgRangeWidthAfterAddingOneCut;
-   queue.insert(pCuttingRangeAdd);
+   // our priority only ever decreases, so this sifts us down from the top
+   pQueue->Update(pCuttingRangeAdd);
    return false;
 }
 
 static void StuffCutsIntoCuttingRanges(
-   std::set<CuttingRange *, CompareCuttingRange> & queue,
+   CuttingRangeHeap * const pQueue,
    const size_t cCuttingRanges,
    CuttingRange * const aCuttingRange,
    const size_t cSamplesPerBinMin,
    const size_t cCutsAssignable
-) {
+) noexcept {
+   EBM_ASSERT(nullptr != pQueue);
+   EBM_ASSERT(pQueue->IsEmpty());
    EBM_ASSERT(1 <= cCuttingRanges);
    EBM_ASSERT(nullptr != aCuttingRange);
    EBM_ASSERT(1 <= cSamplesPerBinMin);
@@ -1909,7 +2028,7 @@ static void StuffCutsIntoCuttingRanges(
       }
       pCuttingRangeInit->m_avgCuttableRangeWidthAfterAddingOneCut = avgRangeWidthAfterAddingOneCut;
       pCuttingRangeInit->m_cRangesMax = cRangesMax;
-      queue.insert(pCuttingRangeInit);
+      pQueue->Push(pCuttingRangeInit);
 
       ++pCuttingRangeInit;
    } while(LIKELY(pCuttingRangeEnd != pCuttingRangeInit));
@@ -1935,7 +2054,7 @@ static void StuffCutsIntoCuttingRanges(
    cRemainingCuts -= cCuttingRanges;
    // the queue can initially be empty if all the ranges are too short to make them cSamplesPerBinMin
    while(LIKELY(0 != cRemainingCuts)) {
-      if(AddCutToRanges(queue)) {
+      if(AddCutToRanges(pQueue)) {
          break;
       }
       --cRemainingCuts;
@@ -2442,6 +2561,891 @@ INLINE_RELEASE_UNTEMPLATED static size_t GetUncuttableRangeLengthMin(
    return cUncuttableRangeLengthMin;
 }
 
+// the scratch space that GenerateQuantileCutsSorted needs for cSamples values and up to cCutsMax cuts.  Everything lives in
+// one allocation that starts at m_aNeighbourJumps, so freeing m_aNeighbourJumps releases all of it
+struct QuantileCutsMemory final {
+
+   QuantileCutsMemory() = default; // preserve our POD status
+   ~QuantileCutsMemory() = default; // preserve our POD status
+   void * operator new(std::size_t) = delete; // we only use malloc/free in this library
+   void operator delete (void *) = delete; // we only use malloc/free in this library
+
+   NeighbourJump *         m_aNeighbourJumps;
+   const FloatEbmType **   m_apValueCutTops;
+   CutPoint *              m_aCuts;
+   CuttingRange *          m_aCuttingRanges;
+   CutPoint **             m_apCutHeap;
+   CuttingRange **         m_apCuttingRangeHeap;
+};
+static_assert(std::is_standard_layout<QuantileCutsMemory>::value,
+   "We use the struct hack in several places, so disallow non-standard_layout types in general");
+static_assert(std::is_trivial<QuantileCutsMemory>::value,
+   "We use memcpy in several places, so disallow non-trivial types in general");
+static_assert(std::is_pod<QuantileCutsMemory>::value,
+   "We use a lot of C constructs, so disallow non-POD types in general");
+
+static bool AllocateQuantileCutsMemory(
+   const size_t cSamples,
+   const size_t cCutsMax,
+   QuantileCutsMemory * const pMemory
+) {
+   EBM_ASSERT(size_t { 2 } <= cSamples);
+   EBM_ASSERT(size_t { 1 } <= cCutsMax);
+   EBM_ASSERT(cCutsMax < cSamples);
+   EBM_ASSERT(nullptr != pMemory);
+
+   // we need to be able to index both the cutsLowerBoundInclusiveOut AND we also allocate an array
+   // of pointers below of FloatEbmType * to index into aFeatureValues, and an array of CutPoint * for the heap
+   if(UNLIKELY(IsMultiplyError(cCutsMax, std::max(sizeof(FloatEbmType), std::max(sizeof(FloatEbmType *), sizeof(CutPoint *)))))) {
+      LOG_0(TraceLevelWarning, "WARNING GenerateQuantileCuts IsMultiplyError(cCutsMax, std::max(sizeof(FloatEbmType), std::max(sizeof(FloatEbmType *), sizeof(CutPoint *))))");
+      return true;
+   }
+
+   if(UNLIKELY(IsMultiplyError(cSamples, sizeof(NeighbourJump)))) {
+      LOG_0(TraceLevelWarning, "WARNING GenerateQuantileCuts IsMultiplyError(cSamples, sizeof(NeighbourJump))");
+      return true;
+   }
+   const size_t cBytesNeighbourJumps = cSamples * sizeof(NeighbourJump);
+
+   // we checked that this multiplication wouldn't overflow above
+   EBM_ASSERT(!IsMultiplyError(cCutsMax, sizeof(FloatEbmType *)));
+   const size_t cBytesValueCutPointers = cCutsMax * sizeof(FloatEbmType *);
+
+   // we limit the cCutsMax to no more than cSamples - 1.  cSamples can't be anywhere close to
+   // the maximum size_t though since the caller must have allocated cSamples floats in aFeatureValues, and
+   // there are no float types that are 1 byte, and we checked that this didn't overflow, so we should be good
+   // to add 2 to the cCutsMax value
+   EBM_ASSERT(cCutsMax <= std::numeric_limits<size_t>::max() - size_t { 2 });
+   // include storage for the end points
+   const size_t cCutsWithEndpointsMax = cCutsMax + size_t { 2 };
+   if(UNLIKELY(IsMultiplyError(cCutsWithEndpointsMax, sizeof(CutPoint)))) {
+      LOG_0(TraceLevelWarning, "WARNING GenerateQuantileCuts IsMultiplyError(cCutsWithEndpointsMax, sizeof(CutPoint))");
+      return true;
+   }
+   const size_t cBytesCuts = cCutsWithEndpointsMax * sizeof(CutPoint);
+
+   // CountCuttingRanges can return at most one more CuttingRange than the number of cuts, so size for that
+   // since the same memory gets reused for every resolution
+   const size_t cCuttingRangesMax = cCutsMax + size_t { 1 };
+   if(UNLIKELY(IsMultiplyError(cCuttingRangesMax, sizeof(CuttingRange)))) {
+      LOG_0(TraceLevelWarning, "WARNING GenerateQuantileCuts IsMultiplyError(cCuttingRangesMax, sizeof(CuttingRange))");
+      return true;
+   }
+   const size_t cBytesCuttingRanges = cCuttingRangesMax * sizeof(CuttingRange);
+
+   // our priority queues are IntrusiveHeaps of pointers to the items above.  There can't be more CutPoints in
+   // the heap than there are non-endpoint cuts, and every CuttingRange goes into its heap
+   EBM_ASSERT(!IsMultiplyError(cCutsMax, sizeof(CutPoint *)));
+   const size_t cBytesCutHeap = cCutsMax * sizeof(CutPoint *);
+   if(UNLIKELY(IsMultiplyError(cCuttingRangesMax, sizeof(CuttingRange *)))) {
+      LOG_0(TraceLevelWarning, "WARNING GenerateQuantileCuts IsMultiplyError(cCuttingRangesMax, sizeof(CuttingRange *))");
+      return true;
+   }
+   const size_t cBytesCuttingRangeHeap = cCuttingRangesMax * sizeof(CuttingRange *);
+
+   const size_t cBytesToNeighbourJump = size_t { 0 };
+   const size_t cBytesToValueCutPointers = cBytesToNeighbourJump + cBytesNeighbourJumps;
+
+   if(UNLIKELY(IsAddError(cBytesToValueCutPointers, cBytesValueCutPointers))) {
+      LOG_0(TraceLevelWarning, "WARNING GenerateQuantileCuts IsAddError(cBytesToValueCutPointers, cBytesValueCutPointers))");
+      return true;
+   }
+   const size_t cBytesToCuts = cBytesToValueCutPointers + cBytesValueCutPointers;
+
+   if(UNLIKELY(IsAddError(cBytesToCuts, cBytesCuts))) {
+      LOG_0(TraceLevelWarning, "WARNING GenerateQuantileCuts IsAddError(cBytesToCuts, cBytesCuts))");
+      return true;
+   }
+   const size_t cBytesToCuttingRange = cBytesToCuts + cBytesCuts;
+
+   if(UNLIKELY(IsAddError(cBytesToCuttingRange, cBytesCuttingRanges))) {
+      LOG_0(TraceLevelWarning, "WARNING GenerateQuantileCuts IsAddError(cBytesToCuttingRange, cBytesCuttingRanges))");
+      return true;
+   }
+   const size_t cBytesToCutHeap = cBytesToCuttingRange + cBytesCuttingRanges;
+
+   if(UNLIKELY(IsAddError(cBytesToCutHeap, cBytesCutHeap))) {
+      LOG_0(TraceLevelWarning, "WARNING GenerateQuantileCuts IsAddError(cBytesToCutHeap, cBytesCutHeap))");
+      return true;
+   }
+   const size_t cBytesToCuttingRangeHeap = cBytesToCutHeap + cBytesCutHeap;
+
+   if(UNLIKELY(IsAddError(cBytesToCuttingRangeHeap, cBytesCuttingRangeHeap))) {
+      LOG_0(TraceLevelWarning, "WARNING GenerateQuantileCuts IsAddError(cBytesToCuttingRangeHeap, cBytesCuttingRangeHeap))");
+      return true;
+   }
+   const size_t cBytesToEnd = cBytesToCuttingRangeHeap + cBytesCuttingRangeHeap;
+
+   char * const pMem = static_cast<char *>(malloc(cBytesToEnd));
+   if(UNLIKELY(nullptr == pMem)) {
+      LOG_0(TraceLevelWarning, "WARNING GenerateQuantileCuts nullptr == pMem");
+      return true;
+   }
+
+   static_assert(size_t { 0 } == cBytesToNeighbourJump, "m_aNeighbourJumps needs to be the start of the allocation so that we can free it");
+   pMemory->m_aNeighbourJumps = reinterpret_cast<NeighbourJump *>(pMem + cBytesToNeighbourJump);
+   pMemory->m_apValueCutTops = reinterpret_cast<const FloatEbmType **>(pMem + cBytesToValueCutPointers);
+   pMemory->m_aCuts = reinterpret_cast<CutPoint *>(pMem + cBytesToCuts);
+   pMemory->m_aCuttingRanges = reinterpret_cast<CuttingRange *>(pMem + cBytesToCuttingRange);
+   pMemory->m_apCutHeap = reinterpret_cast<CutPoint **>(pMem + cBytesToCutHeap);
+   pMemory->m_apCuttingRangeHeap = reinterpret_cast<CuttingRange **>(pMem + cBytesToCuttingRangeHeap);
+   return false;
+}
+
+// Places up to cCutsMax cuts on aFeatureValues, which are already sorted and free of missing values and infinities.
+// aNeighbourJumps and bSymmetryReversal depend only on the sorted values, so callers that want several resolutions of the same
+// feature compute them once and call this for each resolution.  This function only reads aFeatureValues.
+static bool GenerateQuantileCutsSorted(
+   const size_t cSamples,
+   FloatEbmType * const aFeatureValues,
+   const NeighbourJump * const aNeighbourJumps,
+   const bool bSymmetryReversal,
+   const size_t cSamplesPerBinMin,
+   const BoolEbmType isHumanized,
+   const size_t cCutsMax,
+   const FloatEbmType ** const apValueCutTops,
+   CutPoint * const aCuts,
+   CuttingRange * const aCuttingRange,
+   CutPoint ** const apCutHeap,
+   CuttingRange ** const apCuttingRangeHeap,
+   FloatEbmType * const cutsLowerBoundInclusiveOut,
+   size_t * const pcCutsRet
+) {
+   // don't expose this random seed.  It's used to settle tiebreakers and will only make
+   // marginal changes to where the cuts are placed.  Exposing it just means we need to
+   // use the same value in every language that we support, and any preprocessors then need to
+   // take a random number to be useful, which would be odd for a preprocessor.
+   const SeedEbmType randomSeed = SeedEbmType { 1260428135 };
+
+   EBM_ASSERT(size_t { 2 } <= cSamples);
+   EBM_ASSERT(nullptr != aFeatureValues);
+   EBM_ASSERT(nullptr != aNeighbourJumps);
+   EBM_ASSERT(size_t { 1 } <= cSamplesPerBinMin);
+   EBM_ASSERT(size_t { 1 } <= cCutsMax);
+   EBM_ASSERT(nullptr != apValueCutTops);
+   EBM_ASSERT(nullptr != aCuts);
+   EBM_ASSERT(nullptr != aCuttingRange);
+   EBM_ASSERT(nullptr != apCutHeap);
+   EBM_ASSERT(nullptr != apCuttingRangeHeap);
+   EBM_ASSERT(nullptr != cutsLowerBoundInclusiveOut);
+   EBM_ASSERT(nullptr != pcCutsRet);
+
+   *pcCutsRet = size_t { 0 };
+
+   EBM_ASSERT(cCutsMax < cSamples); // so we can add 1 to cCutsMax safely
+   const size_t cUncuttableRangeLengthMin =
+      GetUncuttableRangeLengthMin(cSamples, cCutsMax + size_t { 1 }, cSamplesPerBinMin);
+   EBM_ASSERT(size_t { 1 } <= cUncuttableRangeLengthMin);
+
+   const size_t cCuttingRanges = CountCuttingRanges(
+      cSamples,
+      aFeatureValues,
+      cUncuttableRangeLengthMin,
+      cSamplesPerBinMin
+   );
+   // we GUARANTEE that each interior CuttingRange can have at least one cut by choosing an
+   // cUncuttableRangeLengthMin sufficiently long to ensure this property.  The first and last cutable
+   // ranges, if they exist, can be quite small, so we can trade 1 long uncutable range for 2 cutable
+   // ranges at the tail ends, so we can get 1 more cut than the maximum number of cuts given to us
+   // but not 2 more.  cCutsMax + size_t { 1 } can't overflow since cCutsMax < cSamples , and
+   // cSamples is a size_t
+   EBM_ASSERT(cCuttingRanges <= cCutsMax + size_t { 1 });
+   if(UNLIKELY(size_t { 0 } == cCuttingRanges)) {
+      return false;
+   }
+
+   RandomStream randomStream;
+   randomStream.InitializeUnsigned(randomSeed, k_quantileRandomizationMix);
+
+   FillTiebreakers(bSymmetryReversal, &randomStream, cCuttingRanges, aCuttingRange);
+
+   FillCuttingRangeBasics(cSamples, aFeatureValues, cUncuttableRangeLengthMin, cSamplesPerBinMin, cCuttingRanges, aCuttingRange);
+   FillCuttingRangeNeighbours(cSamples, aFeatureValues, cCuttingRanges, aCuttingRange);
+
+   const FloatEbmType ** ppValueCutTop = apValueCutTops;
+
+   CuttingRangeHeap priorityQueue;
+   priorityQueue.Initialize(apCuttingRangeHeap);
+   StuffCutsIntoCuttingRanges(
+      &priorityQueue,
+      cCuttingRanges,
+      aCuttingRange,
+      cSamplesPerBinMin,
+      cCutsMax
+   );
+   EBM_ASSERT(cCuttingRanges == priorityQueue.m_cItems);
+
+   // every CuttingRange is still in the queue, and from here on we only take them out from the worst to the
+   // best without changing any priorities, so sorting the heap's array gives us the order of extraction directly
+   std::sort(apCuttingRangeHeap, apCuttingRangeHeap + cCuttingRanges, CompareCuttingRange());
+   CuttingRange * const * ppCuttingRange = apCuttingRangeHeap + cCuttingRanges;
+   do {
+      // remove the item that is the worst CuttingRange for us to add a new cut to.  We'll keep
+      // the cutting ranges that are closest to the threshold for adding new cuts in the queue so that
+      // if we can't use all our cuts, we can move the cuts to the next best choice
+      --ppCuttingRange;
+      CuttingRange * const pCuttingRange = *ppCuttingRange;
+
+      const size_t cRanges = pCuttingRange->m_cRangesAssigned;
+
+#ifdef LOG_SUPERVERBOSE_DISCRETIZATION_ORDERED
+      LOG_N(TraceLevelVerbose, "Dequque CuttingRange: %zu, %zu, %zu, %zu, %zu, %zu, %zu, %" FloatEbmTypePrintf,
+         pCuttingRange->m_uniqueTiebreaker,
+         pCuttingRange->m_cRangesAssigned,
+         pCuttingRange->m_cCuttableValues,
+         static_cast<size_t>(pCuttingRange->m_pCuttableValuesFirst - aFeatureValues),
+         pCuttingRange->m_cUncuttableHighValues,
+         pCuttingRange->m_cUncuttableLowValues,
+         pCuttingRange->m_cRangesMax,
+         pCuttingRange->m_avgCuttableRangeWidthAfterAddingOneCut
+      );
+#endif // LOG_SUPERVERBOSE_DISCRETIZATION_ORDERED
+
+      if(PREDICTABLE(size_t { 1 } < cRanges)) {
+         // we have cuts on our ends, either explicit or implicit at the tail ends that don't have unsplitable
+         // ranges on the tails, and at least one cut in our center, so we have to make decisions
+         CutPointHeap bestCuts;
+         bestCuts.Initialize(apCutHeap);
+
+#ifdef NEVER
+         // TODO : in the future fill this priority queue with the average length within our
+         //        visibility window AFTER a new cut would be added.  We calculate this value per
+         //        CutPoint and we do it at the same time we're calculating the cut priority, which
+         //        is good since we'll already have the visibility windows calculated and all that.
+         //        One wrinkle is that we want to be able to insert a cut into a range that no longer
+         //        has any internal cuts.  So for instance if we had a range from 50 to 100 with
+         //        materialized cuts on both 50 and 100, and no allocated cuts between them, in
+         //        the future if cuts become plentiful, then we want to create a new cut between
+         //        those materialized cuts.  I believe the best way to handle this is to check
+         //        when materializing a cut if both our lower and higher cut points are aspirational
+         //        or materialized.  If they are both materialized, then insert our new materialized
+         //        cut into the open space priority queue AND the cut to the left (which represents)
+         //        the lower range.  Or if that's too complicated then take the maximum min from both
+         //        our sides and insert ourselves with that.  We can always examine the left and right
+         //        on extraction to determine which side we should go to.
+         //        Inisde CalculateRangesMaximizeMin, we might notice that one of our sides doesn't
+         //        work very well with a certain number of cuts.  We should speculatively move
+         //        one of our cuts from that side to a new set of ranges (encoded as Cuts)
+         //        We still do the low/high cut number optimization with our left and right windows
+         //        when planning since it's more efficient, and no changes should leak information
+         //        outside those windows otherwise it would become an N^2 algorithm.
+         //        We use our doubly linked list to move non-materialized cut points long distances
+         //        from one part of the cutting range to annother if necessary.
+         //        We should also use the doubly linked list to delete Cuts that we can't use
+         //        if there is no place to put them
+
+         CutPointHeap fillTheVoids;
+#endif // NEVER
+
+         FillTiebreakers(bSymmetryReversal, &randomStream, cRanges - size_t { 1 }, aCuts + 1);
+         if(TradeCutSegment(
+            &bestCuts,
+            cSamples,
+            bSymmetryReversal,
+            cSamplesPerBinMin,
+            pCuttingRange->m_pCuttableValuesFirst - aFeatureValues,
+            pCuttingRange->m_cCuttableValues,
+            aNeighbourJumps,
+            cRanges,
+            // for efficiency we include space for the end point cuts even if they don't exist
+            aCuts
+         )) {
+            // any error messages should have been written to the log inside TradeCutSegment
+
+            return true;
+         }
+
+         const FloatEbmType * const pCuttableValuesStart = pCuttingRange->m_pCuttableValuesFirst;
+
+         if(0 != pCuttingRange->m_cUncuttableLowValues) {
+            // if it's zero then it's an implicit cut and we shouldn't put one there, 
+            // otherwise put in the cut
+            const FloatEbmType * const pCut = pCuttableValuesStart;
+            EBM_ASSERT(aFeatureValues < pCut);
+            EBM_ASSERT(pCut < aFeatureValues + cSamples);
+            *ppValueCutTop = pCut;
+            ++ppValueCutTop;
+         }
+
+         const CutPoint * pCutPoint = aCuts->m_pNext;
+         const CutPoint * pNext = pCutPoint->m_pNext;
+         while(LIKELY(nullptr != pNext)) {
+            const size_t iVal = pCutPoint->m_iVal;
+            if(LIKELY(k_valNotLegal != iVal)) {
+               const FloatEbmType * const pCut = pCuttableValuesStart + iVal;
+               EBM_ASSERT(aFeatureValues < pCut);
+               EBM_ASSERT(pCut < aFeatureValues + cSamples);
+               EBM_ASSERT(pCuttingRange->m_pCuttableValuesFirst < pCut);
+               EBM_ASSERT(pCut < pCuttingRange->m_pCuttableValuesFirst + pCuttingRange->m_cCuttableValues);
+               *ppValueCutTop = pCut;
+               ++ppValueCutTop;
+            }
+            pCutPoint = pNext;
+            pNext = pCutPoint->m_pNext;
+         }
+
+         if(0 != pCuttingRange->m_cUncuttableHighValues) {
+            // if it's zero then it's an implicit cut and we shouldn't put one there, 
+            // otherwise put in the cut
+            const FloatEbmType * const pCut =
+               pCuttableValuesStart + pCuttingRange->m_cCuttableValues;
+            EBM_ASSERT(aFeatureValues < pCut);
+            EBM_ASSERT(pCut < aFeatureValues + cSamples);
+            *ppValueCutTop = pCut;
+            ++ppValueCutTop;
+         }
+      } else if(PREDICTABLE(size_t { 1 } == cRanges)) {
+         // we have cuts on both our ends (either explicit or implicit), so
+         // we don't have to make any hard decisions, but we do have to be careful of the scenarios
+         // where some of our cuts are implicit
+
+         if(0 != pCuttingRange->m_cUncuttableLowValues) {
+            // if it's zero then it's an implicit cut and we shouldn't put one there, 
+            // otherwise put in the cut
+            const FloatEbmType * const pCut = pCuttingRange->m_pCuttableValuesFirst;
+            EBM_ASSERT(aFeatureValues < pCut);
+            EBM_ASSERT(pCut < aFeatureValues + cSamples);
+            *ppValueCutTop = pCut;
+            ++ppValueCutTop;
+         }
+         if(0 != pCuttingRange->m_cUncuttableHighValues) {
+            // if it's zero then it's an implicit cut and we shouldn't put one there, 
+            // otherwise put in the cut
+            const FloatEbmType * const pCut =
+               pCuttingRange->m_pCuttableValuesFirst + pCuttingRange->m_cCuttableValues;
+            EBM_ASSERT(aFeatureValues < pCut);
+            EBM_ASSERT(pCut < aFeatureValues + cSamples);
+            *ppValueCutTop = pCut;
+            ++ppValueCutTop;
+         }
+      } else {
+         EBM_ASSERT(0 == cRanges);
+         // we have only 1 cut to place, and no cuts on our boundaries, so we need to figure out
+         // where in our range to place it, taking into consideration that we might have neighbours on our
+         // sides that could be large
+
+         // if we had implicit cuts on both ends and zero assigned cuts, we'd have 1 range and would
+         // be handled above
+         EBM_ASSERT(0 != pCuttingRange->m_cUncuttableLowValues || 0 != pCuttingRange->m_cUncuttableHighValues);
+
+         // if one side or the other was an implicit cut, then we have zero cuts left after
+         // the implicit cut is accounted for, so do nothing
+         if(LIKELY(LIKELY(0 != pCuttingRange->m_cUncuttableLowValues) && 
+            LIKELY(0 != pCuttingRange->m_cUncuttableHighValues))) {
+            // even though we could reduce our squared error length more, it probably makes sense to 
+            // include a little bit of our available numbers on one long range and the other, so let's put
+            // the cut in the middle and only make the low/high decision to settle long-ish ranges
+            // in the center
+
+            const size_t cCuttableItems = pCuttingRange->m_cCuttableValues;
+               
+            const size_t iRangeFirst = pCuttingRange->m_pCuttableValuesFirst - aFeatureValues;
+            const size_t iCenterOfRange = iRangeFirst + (cCuttableItems >> 1);
+
+            // unlike in BuildNeighbourhoodPlan, we don't need to worry about the scenario that
+            // a jumping range falls on the exact iCenterOfRange value, since for our purposes here
+            // if we have a perfect answer that is perfectly in the center, then we always select that
+            // one since we have no exclusion criteria here.  We never will seriously consider the 
+            // iStartNext value if iStartCur is a perfectly centered match.
+            // So we don't need to inject some randomness here, unlike in BuildNeighbourhoodPlan
+
+            const NeighbourJump * const pNeighbourJump = &aNeighbourJumps[iCenterOfRange];
+
+            const size_t iStartCur = pNeighbourJump->m_iStartCur;
+            const size_t iStartNext = pNeighbourJump->m_iStartNext;
+
+            const ptrdiff_t cDistanceLow1 = static_cast<ptrdiff_t>(iStartCur - iRangeFirst);
+            EBM_ASSERT(ptrdiff_t { 0 } <= cDistanceLow1);
+            EBM_ASSERT(cDistanceLow1 <= static_cast<ptrdiff_t>(cCuttableItems >> 1));
+            // cDistanceHigh1 can be negative if cCuttableItems is zero since then iStartNext
+            // will reflect the boundary of the point after the unsplittable range above
+            // our cut point, but since our cDistanceLow1 will be zero, it'll work out without
+            // a special check
+            const ptrdiff_t cDistanceHigh1 = static_cast<ptrdiff_t>(iRangeFirst + cCuttableItems) 
+               - static_cast<ptrdiff_t>(iStartNext);
+            EBM_ASSERT(cDistanceHigh1 <= static_cast<ptrdiff_t>(cCuttableItems >> 1));
+            EBM_ASSERT(size_t { 1 } == cCuttableItems % size_t { 2 } ||
+               cDistanceHigh1 < static_cast<ptrdiff_t>(cCuttableItems >> 1));
+
+            size_t iResult = UNPREDICTABLE(cDistanceHigh1 < cDistanceLow1) ? iStartCur : iStartNext;
+            if(UNLIKELY(cDistanceHigh1 == cDistanceLow1)) {
+               // per above, we can't get the situation where iCenterOfRange is the perfect center
+               // past our if check above for cDistanceHigh1 == cDistanceLow1
+               EBM_ASSERT(static_cast<size_t>(cDistanceLow1) * size_t { 2 } != cCuttableItems);
+
+               // we're equidistant to both edges.  Next try to see which is closer to the outer
+               // edge if we include the uncuttable ranges beyond
+               const size_t cDistanceLow2 = pCuttingRange->m_cUncuttableLowValues;
+               const size_t cDistanceHigh2 = pCuttingRange->m_cUncuttableHighValues;
+               iResult = UNPREDICTABLE(cDistanceHigh2 < cDistanceLow2) ? iStartCur : iStartNext;
+               if(UNLIKELY(cDistanceHigh2 == cDistanceLow2)) {
+                  // next, let's try to the edges of our full array
+                  const size_t cDistanceLow3 = iStartCur;
+                  const size_t cDistanceHigh3 = cSamples - iStartNext;
+                  iResult = UNPREDICTABLE(cDistanceHigh3 < cDistanceLow3) ? iStartCur : iStartNext;
+                  if(UNLIKELY(cDistanceHigh3 == cDistanceLow3)) {
+                     // wow, we're at the center of the entire array AND the center of the outer
+                     // unsplittable ranges, AND the center of the splitable ranges.  Our final fallback
+                     // is to resort to our symmetric determination (PLUS randomness)
+
+                     bool bLocalSymmetryReversal = randomStream.Next() != bSymmetryReversal;
+                     iResult = UNPREDICTABLE(bLocalSymmetryReversal) ? iStartCur : iStartNext;
+                  }
+               }
+            }
+            const FloatEbmType * pCut = aFeatureValues + iResult;
+            EBM_ASSERT(aFeatureValues < pCut);
+            *ppValueCutTop = pCut;
+            ++ppValueCutTop;
+         }
+      }
+   } while(apCuttingRangeHeap != ppCuttingRange);
+
+   EBM_ASSERT(apValueCutTops <= ppValueCutTop);
+   const size_t cCutsRet = ppValueCutTop - apValueCutTops;
+
+   // it's possible, although extremely unlikely, that due to floating point issues that should only
+   // occur with huge double indexes, we were not able to find the legal cut point, so check for zero
+   if(LIKELY(size_t { 0 } != cCutsRet)) {
+      // the pointers are guaranteed to be in same order as the cut values
+      std::sort(apValueCutTops, ppValueCutTop);
+
+      FloatEbmType * pCutsLowerBoundInclusive = cutsLowerBoundInclusiveOut;
+      const FloatEbmType * const * ppValueCutTop2 = apValueCutTops;
+
+      if(EBM_FALSE == isHumanized) {
+         do {
+            const FloatEbmType * const pCut = *ppValueCutTop2;
+            EBM_ASSERT(aFeatureValues < pCut);
+            EBM_ASSERT(pCut < aFeatureValues + cSamples);
+            const FloatEbmType valHigh = *pCut;
+            EBM_ASSERT(!std::isnan(valHigh));
+            EBM_ASSERT(!std::isinf(valHigh));
+            const FloatEbmType valLow = *(pCut - size_t { 1 });
+            EBM_ASSERT(!std::isnan(valLow));
+            EBM_ASSERT(!std::isinf(valLow));
+            const FloatEbmType cut = ArithmeticMean(valLow, valHigh);
+            EBM_ASSERT(cutsLowerBoundInclusiveOut == pCutsLowerBoundInclusive || *(pCutsLowerBoundInclusive - size_t { 1 }) < cut);
+            *pCutsLowerBoundInclusive = cut;
+            ++pCutsLowerBoundInclusive;
+            ++ppValueCutTop2;
+         } while(ppValueCutTop != ppValueCutTop2);
+      } else {
+         do {
+            const FloatEbmType * const pCut = *ppValueCutTop2;
+            EBM_ASSERT(aFeatureValues < pCut);
+            EBM_ASSERT(pCut < aFeatureValues + cSamples);
+            const FloatEbmType valHigh = *pCut;
+            EBM_ASSERT(!std::isnan(valHigh));
+            EBM_ASSERT(!std::isinf(valHigh));
+            const FloatEbmType valLow = *(pCut - size_t { 1 });
+            EBM_ASSERT(!std::isnan(valLow));
+            EBM_ASSERT(!std::isinf(valLow));
+            const FloatEbmType cut = GetInterpretableCutPointFloat(valLow, valHigh);
+            EBM_ASSERT(cutsLowerBoundInclusiveOut == pCutsLowerBoundInclusive || *(pCutsLowerBoundInclusive - size_t { 1 }) < cut);
+            *pCutsLowerBoundInclusive = cut;
+            ++pCutsLowerBoundInclusive;
+            ++ppValueCutTop2;
+         } while(ppValueCutTop != ppValueCutTop2);
+
+         // if you have 1 cut point, then you get a graph with some mass on the left, some mass on the right
+         // and the cut point, and that's great.  We don't need to improve on that.  Our one cut points provides
+         // the most information possible and it's displayable on a graph.
+         // eg: "0.01 0.01 | 100 100" -> put the cut point at 1 and we can show both logit sides without
+         // indicating the min/max values of 0.001 and 1000
+         //
+         // if you have 2 cut points, then the graph will have 3 regions, and we can scale the graph so that
+         // 1/3 of the mass in on the left, 1/3 is in the scaled center, and 1/3 is on the right.  Whatever cuts
+         // we get provide the most amount of information possible, and it's graphable.
+         // eg: "0.01 0.01 | 1 1 | 100 100" -> put the cut points at 0.1 and 10 and the graph can range
+         // from 0.1 to 10 with some space on the tails to show the logits for the "-infinity -> 0.1" bin
+         // and the "10 -> +infinity" bin.
+         //
+         // if we have 3 cut points, then we could get into graphing issues if one of the ranges was so big
+         // that it dwarfed the other two in size.  We can't do anything about this if one of the interior
+         // ranges is huge, but often times the huge range is at the extreme ends of the graph and if the
+         // value on the interior side is smaller then we have some ability to pick the cut point.
+         // eg: "1 1 | 2 2 | 3 3 | infinity infinity".  The cut points can legally be:
+         //         1.5   2.5   3.5
+         // but if the values were instead:
+         // eg: "1 1 | 2 2 | 3 3 | 3.2 3.2".  The cut points can't exceed 3.2, so we'd use:
+         //         1.5   2.5   3.1
+         //
+         // Our algorithm finds 3.5 and 3.1 and picks the minimum, and the same on the low side, but there we
+         // take the maximum.
+         //
+         // In the above example, our graph must at minimum show the data from 2 -> 3, and in fact we'll want
+         // to not put our cuts right outside 2 and 3, so we want to move a reasonable distance away from those
+         // ends to the 1.5 and 3.5 positions to put our cuts, and since the "-infinity -> 1.5" bin and
+         // "3.5 -> +infinity" bins have logits, we also want some space on the graph to show those logits
+         // so we probably want our graph to show something like the space 0 -> 5, although this can be
+         // chosen by the graphing function.
+         //
+         // It's tempting to want to use the interior cuts to determine the outer cuts:
+         // eg: "-infinity -infinity | 2 2 | 3 3 | 4 4 | +infinity +infinity"
+         //                         1.5   2.5   3.5   4.5
+         // We might want to use 2.5 and 3.5 to determine that the cuts progress with distnaces of 1, and
+         // extrapolate 2.5 - 1 = 1.5 and 3.5 + 1 = 4.5, but we can't really do that because we might instead have
+         // something like this where the extrapolation will put us below the highLow value
+         // eg: "-infinity -infinity | 2 2 | 3 3 | 9 9 | +infinity +infinity"
+         // So we need to use the 9 value and extend from there.
+         //
+         // In the examples above, we've chosen point values, but we could easily have the following situation:
+         // 0.6 1.4 | 1.6 2.4 | 2.6 3.4 | 3.6 4.4 | 4.6 5.4
+         //        1.5       2.5       3.5       4.5
+         // which illustrates that in general the cut points can be very close to their neighbouring values.
+         // so in the examples farther above we had a spacing of 0.5 units from the interior values to the
+         // exterior cuts (1.5 -> 2) and (3 -> 3.5), but here we have separations of 0.1 (1.4 -> 1.5) and
+         // "4.4 -> 4.5".  
+         // 
+         // We're only choosing to override the averaged cut value when the outer value is a huge way off
+         // so we probably want to be conservative about how much we're override this and not put the
+         // new cut point too close to our lowHigh or highLow values.  If we start from a pointalism point
+         // of view that all the interior values are bunched onto discrete values like "2 2", and we assume
+         // half of the distance between a value and it's cut occurs on the lower and higher side, it gives
+         // us a kind of worse case reasonable scenario to deal with.  So starting from:
+         // "-infinity -infinity | 2 2 | 3 3 | 4 4 | +infinity +infinity"
+         //                     1.5   2.5   3.5   4.5
+         // We get the minimum graph range by taking the 4 and the 2 and substracting for 2.
+         // Then we assume that half of the bin on the upper side of the 2 is within that range and
+         // the lower side of the 4 is within that range, and we know that there is a range bounding 3,
+         // so we have 0.5 + 1 + 0.5 ranges total = 2.
+         // So our cut density is 2 / 2 = 1 cut per range.
+         // and we extend by half a bin downwards from the 2, which gives (2 - 1 / 2) = 1.5
+         // and we extend by half a bin upwards from the 4, which gives (4 + 1 / 2) = 4.5
+
+         if(LIKELY(size_t { 3 } <= cCutsRet)) {
+            const FloatEbmType * const pScaleHighHigh = *(ppValueCutTop - size_t { 1 });
+            EBM_ASSERT(aFeatureValues + size_t { 2 } < pScaleHighHigh);
+            EBM_ASSERT(pScaleHighHigh < aFeatureValues + cSamples);
+            const FloatEbmType * const pScaleHighLow = pScaleHighHigh - size_t { 1 };
+            EBM_ASSERT(aFeatureValues + size_t { 1 } < pScaleHighLow);
+            EBM_ASSERT(pScaleHighLow < aFeatureValues + cSamples - size_t { 1 });
+            const FloatEbmType scaleHighLow = *pScaleHighLow;
+            EBM_ASSERT(!std::isnan(scaleHighLow));
+            EBM_ASSERT(!std::isinf(scaleHighLow));
+            const FloatEbmType * pScaleLowHigh = *apValueCutTops;
+            EBM_ASSERT(aFeatureValues < pScaleLowHigh);
+            EBM_ASSERT(pScaleLowHigh < aFeatureValues + cSamples - size_t { 2 });
+            const FloatEbmType scaleLowHigh = *pScaleLowHigh;
+            EBM_ASSERT(!std::isnan(scaleLowHigh));
+            EBM_ASSERT(!std::isinf(scaleLowHigh));
+            EBM_ASSERT(scaleLowHigh < scaleHighLow);
+            // this is the inescapable scale of our graph, from the value right above the lowest cut to the value 
+            // right below the highest cut
+
+            const FloatEbmType scaleMin = scaleHighLow - scaleLowHigh;
+            // scaleMin can be +infinity if scaleHighLow is max and scaleLowHigh is lowest.  We can handle it.
+            EBM_ASSERT(!std::isnan(scaleMin));
+            // IEEE 754 (which we static_assert) won't allow the subtraction of two unequal numbers to be non-zero
+            EBM_ASSERT(FloatEbmType { 0 } < scaleMin);
+
+            // limit the amount of dillution allowed for the tails by capping the relevant cCutPointRet value
+            // to 1/32, which means we leave about 3% of the visible area to tail bounds (1.5% on the left and
+            // 1.5% on the right)
+
+            const size_t cCutsLimited = size_t { 32 } < cCutsRet ? size_t { 32 } : cCutsRet;
+
+            // the leftmost and rightmost cuts can legally be right outside of the bounds between scaleHighLow and
+            // scaleLowHigh, so we subtract these two cuts, leaving us the number of ranges between the two end
+            // points.  Half a range on the bottom, N - 1 ranges in the middle, and half a range on the top
+            // Dividing by that number of ranges gives us the average range width.  We don't want to get the final
+            // cut though from the previous inner cut.  We want to move outwards from the scaleHighLow and
+            // scaleLowHigh values, which should be half a cut inwards (not exactly but in spirit), so we
+            // divide by two, which is the same as multiplying the divisor by 2, which is the right shift below
+            EBM_ASSERT(size_t { 3 } <= cCutsMax);
+            const size_t denominator = (cCutsLimited - size_t { 2 }) << 1;
+            EBM_ASSERT(size_t { 0 } < denominator);
+            const FloatEbmType movementFromEnds = scaleMin / static_cast<FloatEbmType>(denominator);
+            // movementFromEnds can be +infinity if scaleMin is infinity. We can handle it.
+            EBM_ASSERT(!std::isnan(movementFromEnds));
+            EBM_ASSERT(FloatEbmType { 0 } <= movementFromEnds); // underflow is possible
+
+            const FloatEbmType lowCutFullPrecisionMin = scaleLowHigh - movementFromEnds;
+            // lowCutFullPrecisionMin can be -infinity if movementFromEnds is +infinity.  We can handle it.
+            EBM_ASSERT(!std::isnan(lowCutFullPrecisionMin));
+            EBM_ASSERT(lowCutFullPrecisionMin < std::numeric_limits<FloatEbmType>::max());
+            // GetInterpretableEndpoint can accept -infinity, but it'll return -infinity in that case
+            const FloatEbmType lowCutMin = GetInterpretableEndpoint(lowCutFullPrecisionMin, movementFromEnds);
+            // lowCutMin can legally be -infinity and we handle this scenario below
+
+            const FloatEbmType lowCutExisting = *cutsLowerBoundInclusiveOut;
+            EBM_ASSERT(!std::isnan(lowCutExisting));
+            EBM_ASSERT(!std::isinf(lowCutExisting));
+
+            if(lowCutExisting < lowCutMin) {
+               // lowCutMin can legally be -infinity, but then we wouldn't get here then
+               EBM_ASSERT(!std::isnan(lowCutMin));
+               EBM_ASSERT(!std::isinf(lowCutMin));
+               *cutsLowerBoundInclusiveOut = lowCutMin;
+            }
+
+            const FloatEbmType highCutFullPrecisionMax = scaleHighLow + movementFromEnds;
+            // highCutFullPrecisionMax can be +infinity if movementFromEnds is +infinity.  We can handle it.
+            EBM_ASSERT(!std::isnan(highCutFullPrecisionMax));
+            EBM_ASSERT(std::numeric_limits<FloatEbmType>::lowest() < highCutFullPrecisionMax);
+            // GetInterpretableEndpoint can accept infinity, but it'll return infinity in that case
+            const FloatEbmType highCutMax = GetInterpretableEndpoint(highCutFullPrecisionMax, movementFromEnds);
+            // highCutMax can legally be +infinity and we handle this scenario below
+
+            const FloatEbmType highCutExisting = *(pCutsLowerBoundInclusive - size_t { 1 });
+            EBM_ASSERT(!std::isnan(highCutExisting));
+            EBM_ASSERT(!std::isinf(highCutExisting));
+
+            if(highCutMax < highCutExisting) {
+               // highCutMax can legally be +infinity, but then we wouldn't get here then
+               EBM_ASSERT(!std::isnan(highCutMax));
+               EBM_ASSERT(!std::isinf(highCutMax));
+               *(pCutsLowerBoundInclusive - size_t { 1 }) = highCutMax;
+            }
+         }
+      }
+   }
+
+   // this conversion is guaranteed to work since the number of cut points can't exceed the number our user
+   // specified, and that value came to us as an IntEbmType
+   EBM_ASSERT(cCutsRet <= cCutsMax);
+   *pcCutsRet = cCutsRet;
+   return false;
+}
+
+// The body of GenerateQuantileCuts after the parameters have been checked, generalized to produce cResolutions sets of
+// cuts from a single sort.  aFeatureValues holds a copy of the feature that we sort in place, and every out pointer is
+// non-null.  aScratch is either nullptr or holds room for cSamplesIncludingMissingValues values that the radix sort can use.
+// On entry aCountCutsInOut holds the maximum number of cuts for each resolution, and the cuts for resolution i are written
+// to cutsLowerBoundInclusiveOut after the space requested by the resolutions before it.  On exit aCountCutsInOut holds the
+// number of cuts written for each resolution.  This function doesn't use any counted logging or other shared state, so it
+// can run on many features at once from different threads
+static IntEbmType GenerateQuantileCutsResolutionsInternal(
+   const size_t cSamplesIncludingMissingValues,
+   FloatEbmType * const aFeatureValues,
+   FloatEbmType * const aScratch,
+   IntEbmType countSamplesPerBinMin,
+   const BoolEbmType isHumanized,
+   const size_t cResolutions,
+   IntEbmType * const aCountCutsInOut,
+   FloatEbmType * const cutsLowerBoundInclusiveOut,
+   IntEbmType * const countMissingValuesOut,
+   FloatEbmType * const minNonInfinityValueOut,
+   IntEbmType * const countNegativeInfinityOut,
+   FloatEbmType * const maxNonInfinityValueOut,
+   IntEbmType * const countPositiveInfinityOut
+) {
+   EBM_ASSERT(1 <= cSamplesIncludingMissingValues);
+   EBM_ASSERT(nullptr != aFeatureValues);
+   EBM_ASSERT(size_t { 0 } == cResolutions || nullptr != aCountCutsInOut);
+   EBM_ASSERT(nullptr != countMissingValuesOut);
+   EBM_ASSERT(nullptr != minNonInfinityValueOut);
+   EBM_ASSERT(nullptr != countNegativeInfinityOut);
+   EBM_ASSERT(nullptr != maxNonInfinityValueOut);
+   EBM_ASSERT(nullptr != countPositiveInfinityOut);
+
+   IntEbmType ret;
+
+   {
+      // if there are +infinity values in the data we won't be able to separate them
+      // from max_float values without having a cut at infinity since we use lower bound inclusivity
+      // so we disallow +infinity values by turning them into max_float.  For symmetry we do the same on
+      // the -infinity side turning those into lowest_float.
+      const size_t cSamples = RemoveMissingValuesAndReplaceInfinities(
+         cSamplesIncludingMissingValues,
+         aFeatureValues,
+         minNonInfinityValueOut,
+         countNegativeInfinityOut,
+         maxNonInfinityValueOut,
+         countPositiveInfinityOut
+      );
+
+      EBM_ASSERT(cSamples <= cSamplesIncludingMissingValues);
+      const size_t cMissingValues = cSamplesIncludingMissingValues - cSamples;
+      // this is guaranteed to work since the number of missing values can't exceed the number of original
+      // samples, and samples came to us as an IntEbmType
+      EBM_ASSERT(IsNumberConvertable<IntEbmType>(cMissingValues));
+      *countMissingValuesOut = static_cast<IntEbmType>(cMissingValues);
+
+      if(UNLIKELY(cSamples <= size_t { 1 })) {
+         // we can't really split 0 or 1 samples.  Now that we know our min, max, etc values, we can exit
+         // or if there was only 1 non-missing value
+         ret = IntEbmType { 0 };
+         goto exit_without_cuts;
+      }
+
+      IntEbmType countCutsLargest = IntEbmType { 0 };
+      for(size_t iResolution = 0; iResolution < cResolutions; ++iResolution) {
+         const IntEbmType countCuts = aCountCutsInOut[iResolution];
+         if(UNLIKELY(countCuts < IntEbmType { 0 })) {
+            LOG_0(TraceLevelError, "ERROR GenerateQuantileCuts countCuts can't be negative.");
+            ret = IntEbmType { 1 };
+            goto exit_without_cuts;
+         }
+         countCutsLargest = UNPREDICTABLE(countCutsLargest < countCuts) ? countCuts : countCutsLargest;
+      }
+
+      if(UNLIKELY(IntEbmType { 0 } == countCutsLargest)) {
+         ret = IntEbmType { 0 };
+         goto exit_without_cuts;
+      }
+
+      if(UNLIKELY(nullptr == cutsLowerBoundInclusiveOut)) {
+         // if we have a potential bin cut, then cutsLowerBoundInclusiveOut shouldn't be nullptr
+         LOG_0(TraceLevelError, "ERROR GenerateQuantileCuts nullptr == cutsLowerBoundInclusiveOut");
+         ret = IntEbmType { 1 };
+         goto exit_without_cuts;
+      }
+
+      if(UNLIKELY(countSamplesPerBinMin <= IntEbmType { 0 })) {
+         LOG_0(TraceLevelWarning,
+            "WARNING GenerateQuantileCuts countSamplesPerBinMin shouldn't be zero or negative.  Setting to 1");
+
+         countSamplesPerBinMin = IntEbmType { 1 };
+      }
+
+      EBM_ASSERT(IsNumberConvertable<IntEbmType>(cSamples)); // since it came from an IntEbmType originally
+      if(UNLIKELY(static_cast<IntEbmType>(cSamples >> 1) < countSamplesPerBinMin)) {
+         // each bin needs at least countSamplesPerBinMin samples, so we need two sets of countSamplesPerBinMin
+         // in order to make any cuts.  Anything less and we should just return now.
+         // We also use this as a comparison to ensure that countSamplesPerBinMin is convertible to a size_t
+         ret = IntEbmType { 0 };
+         goto exit_without_cuts;
+      }
+
+      // countSamplesPerBinMin is convertible to size_t since countSamplesPerBinMin <= (cSamples >> 1)
+      EBM_ASSERT(IsNumberConvertable<size_t>(countSamplesPerBinMin));
+      const size_t cSamplesPerBinMin = static_cast<size_t>(countSamplesPerBinMin);
+
+      // In theory, we could constrain our cBinsMaxInitial value a bit more by taking our value array
+      // and attempting to jump by the minimum each time.  Then if there was a long run of equal values we'd
+      // be able to limit the number of cuts, but then the algorithm is going to need to be pretty smart later
+      // on when it finds the long run and needs to compress the available cuts back down into the cutable regions
+      // it's probably better to just place a lot of asiprational cuts at the minimum separation and trim them
+      // as we go on so.  In that case we'd be hard pressed to misallocate cuts since they'll almost always
+      // alrady be cSamplesPerBinMin apart in the regions that are cutable.
+      const size_t cBinsMaxInitial = cSamples / cSamplesPerBinMin;
+
+      // otherwise we'd have failed the check "static_cast<IntEbmType>(cSamples >> 1) < countSamplesPerBinMin"
+      EBM_ASSERT(size_t { 2 } <= cBinsMaxInitial);
+      const size_t cCutsMaxInitial = cBinsMaxInitial - size_t { 1 };
+
+      // cSamples fit into an IntEbmType, and since cCutsMaxInitial is less than cSamples,
+      // we should be able to convert it back to an IntEbmType
+      EBM_ASSERT(cCutsMaxInitial < cSamples);
+      EBM_ASSERT(IsNumberConvertable<IntEbmType>(cCutsMaxInitial));
+      const size_t cCutsMaxLargest = static_cast<IntEbmType>(cCutsMaxInitial) < countCutsLargest ?
+         cCutsMaxInitial : static_cast<size_t>(countCutsLargest);
+
+      EBM_ASSERT(size_t { 1 } <= cCutsMaxLargest); // we won't eliminate to less than 1, and we had at least 1 before
+
+      // every resolution shares this memory, so size it for the one with the most cuts
+      QuantileCutsMemory memory;
+      if(UNLIKELY(AllocateQuantileCutsMemory(cSamples, cCutsMaxLargest, &memory))) {
+         // any error messages should have been written to the log inside AllocateQuantileCutsMemory
+         ret = IntEbmType { 1 };
+         goto exit_without_cuts;
+      }
+
+      // this is the only O(N log N) step, and everything from here up to the cut placement depends only
+      // on the sorted values, so we do it once for all the resolutions
+      SortFeatureValues(cSamples, aFeatureValues, aScratch);
+
+      if(UNLIKELY(aFeatureValues[0] == aFeatureValues[cSamples - size_t { 1 }])) {
+         // every value is identical, so there is nowhere to put a cut.  DetermineSymmetricDirection needs at least two
+         // distinct values, and every resolution would find zero CuttingRanges anyways
+         free(memory.m_aNeighbourJumps);
+         ret = IntEbmType { 0 };
+         goto exit_without_cuts;
+      }
+
+      ConstructJumps(cSamples, aFeatureValues, memory.m_aNeighbourJumps);
+
+      // we always XOR (with != for bools) a random number with bSymmetryReversal, so there is no need to
+      // XOR bSymmetryReversal with a random number here
+      const bool bSymmetryReversal = DetermineSymmetricDirection(cSamples, aFeatureValues);
+
+      FloatEbmType * pCutsLowerBoundInclusive = cutsLowerBoundInclusiveOut;
+      for(size_t iResolution = 0; iResolution < cResolutions; ++iResolution) {
+         const IntEbmType countCuts = aCountCutsInOut[iResolution];
+         EBM_ASSERT(IntEbmType { 0 } <= countCuts);
+
+         size_t cCutsRet = size_t { 0 };
+         if(LIKELY(IntEbmType { 0 } != countCuts)) {
+            const size_t cCutsMax = static_cast<IntEbmType>(cCutsMaxInitial) < countCuts ?
+               cCutsMaxInitial : static_cast<size_t>(countCuts);
+            EBM_ASSERT(cCutsMax <= cCutsMaxLargest);
+
+            if(UNLIKELY(GenerateQuantileCutsSorted(
+               cSamples,
+               aFeatureValues,
+               memory.m_aNeighbourJumps,
+               bSymmetryReversal,
+               cSamplesPerBinMin,
+               isHumanized,
+               cCutsMax,
+               memory.m_apValueCutTops,
+               memory.m_aCuts,
+               memory.m_aCuttingRanges,
+               memory.m_apCutHeap,
+               memory.m_apCuttingRangeHeap,
+               pCutsLowerBoundInclusive,
+               &cCutsRet
+            ))) {
+               // any error messages should have been written to the log inside GenerateQuantileCutsSorted
+               free(memory.m_aNeighbourJumps);
+               ret = IntEbmType { 1 };
+               goto exit_without_cuts;
+            }
+         }
+
+         // cCutsRet can't exceed countCuts, which came to us as an IntEbmType
+         aCountCutsInOut[iResolution] = static_cast<IntEbmType>(cCutsRet);
+         // each resolution owns the full space that it asked for, even if we didn't fill all of it
+         pCutsLowerBoundInclusive += static_cast<size_t>(countCuts);
+      }
+
+      free(memory.m_aNeighbourJumps);
+   }
+
+   return IntEbmType { 0 };
+
+exit_without_cuts:;
+   for(size_t iResolution = 0; iResolution < cResolutions; ++iResolution) {
+      aCountCutsInOut[iResolution] = IntEbmType { 0 };
+   }
+   return ret;
+}
+
+static IntEbmType GenerateQuantileCutsInternal(
+   const size_t cSamplesIncludingMissingValues,
+   FloatEbmType * const aFeatureValues,
+   FloatEbmType * const aScratch,
+   IntEbmType countSamplesPerBinMin,
+   const BoolEbmType isHumanized,
+   IntEbmType * const countCutsInOut,
+   FloatEbmType * const cutsLowerBoundInclusiveOut,
+   IntEbmType * const countMissingValuesOut,
+   FloatEbmType * const minNonInfinityValueOut,
+   IntEbmType * const countNegativeInfinityOut,
+   FloatEbmType * const maxNonInfinityValueOut,
+   IntEbmType * const countPositiveInfinityOut
+) {
+   EBM_ASSERT(nullptr != countCutsInOut);
+
+   return GenerateQuantileCutsResolutionsInternal(
+      cSamplesIncludingMissingValues,
+      aFeatureValues,
+      aScratch,
+      countSamplesPerBinMin,
+      isHumanized,
+      size_t { 1 },
+      countCutsInOut,
+      cutsLowerBoundInclusiveOut,
+      countMissingValuesOut,
+      minNonInfinityValueOut,
+      countNegativeInfinityOut,
+      maxNonInfinityValueOut,
+      countPositiveInfinityOut
+   );
+}
+
 // we don't care if an extra log message is outputted due to the non-atomic nature of the decrement to this value
 static int g_cLogEnterGenerateQuantileCutsParametersMessages = 25;
 static int g_cLogExitGenerateQuantileCutsParametersMessages = 25;
@@ -2459,12 +3463,6 @@ EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION GenerateQ
    FloatEbmType * maxNonInfinityValueOut,
    IntEbmType * countPositiveInfinityOut
 ) {
-   // don't expose this random seed.  It's used to settle tiebreakers and will only make 
-   // marginal changes to where the cuts are placed.  Exposing it just means we need to 
-   // use the same value in every language that we support, and any preprocessors then need to
-   // take a random number to be useful, which would be odd for a preprocessor.
-   const SeedEbmType randomSeed = SeedEbmType { 1260428135 };
-
    LOG_COUNTED_N(
       &g_cLogEnterGenerateQuantileCutsParametersMessages,
       TraceLevelInfo,
@@ -2573,740 +3571,735 @@ EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION GenerateQ
          const size_t cBytesFeatureValues = sizeof(*featureValues) * cSamplesIncludingMissingValues;
          memcpy(aFeatureValues, featureValues, cBytesFeatureValues);
 
-         // if there are +infinity values in the data we won't be able to separate them
-         // from max_float values without having a cut at infinity since we use lower bound inclusivity
-         // so we disallow +infinity values by turning them into max_float.  For symmetry we do the same on
-         // the -infinity side turning those into lowest_float.  
-         const size_t cSamples = RemoveMissingValuesAndReplaceInfinities(
-            cSamplesIncludingMissingValues, 
+         // the radix sort needs a second buffer.  If we can't get it we fall back to std::sort, which is slower but gives the same result
+         FloatEbmType * const aScratch = k_cSamplesRadixSortMin <= cSamplesIncludingMissingValues ? 
+            EbmMalloc<FloatEbmType>(cSamplesIncludingMissingValues) : nullptr;
+
+         countCutsRet = *countCutsInOut;
+         ret = GenerateQuantileCutsInternal(
+            cSamplesIncludingMissingValues,
             aFeatureValues,
+            aScratch,
+            countSamplesPerBinMin,
+            isHumanized,
+            &countCutsRet,
+            cutsLowerBoundInclusiveOut,
+            &countMissingValuesRet,
             &minNonInfinityValueRet,
             &countNegativeInfinityRet,
             &maxNonInfinityValueRet,
             &countPositiveInfinityRet
          );
 
-         EBM_ASSERT(cSamples <= cSamplesIncludingMissingValues);
-         const size_t cMissingValues = cSamplesIncludingMissingValues - cSamples;
-         // this is guaranteed to work since the number of missing values can't exceed the number of original
-         // samples, and samples came to us as an IntEbmType
-         EBM_ASSERT(IsNumberConvertable<IntEbmType>(cMissingValues));
-         countMissingValuesRet = static_cast<IntEbmType>(cMissingValues);
-
-         if(UNLIKELY(cSamples <= size_t { 1 })) {
-            free(aFeatureValues);
-            // we can't really split 0 or 1 samples.  Now that we know our min, max, etc values, we can exit
-            // or if there was only 1 non-missing value
-            countCutsRet = IntEbmType { 0 };
-            ret = IntEbmType { 0 };
-            goto exit_with_log;
-         }
-
-         EBM_ASSERT(nullptr != countCutsInOut);
-         const IntEbmType countCuts = *countCutsInOut;
-
-         if(UNLIKELY(countCuts <= IntEbmType { 0 })) {
-            free(aFeatureValues);
-            countCutsRet = IntEbmType { 0 };
-            ret = IntEbmType { 0 };
-            if(UNLIKELY(countCuts < IntEbmType { 0 })) {
-               LOG_0(TraceLevelError, "ERROR GenerateQuantileCuts countCuts can't be negative.");
-               ret = IntEbmType { 1 };
-            }
-            goto exit_with_log;
-         }
-         
-         if(UNLIKELY(nullptr == cutsLowerBoundInclusiveOut)) {
-            // if we have a potential bin cut, then cutsLowerBoundInclusiveOut shouldn't be nullptr
-            LOG_0(TraceLevelError, "ERROR GenerateQuantileCuts nullptr == cutsLowerBoundInclusiveOut");
-
-            free(aFeatureValues);
-            countCutsRet = IntEbmType { 0 };
-            ret = IntEbmType { 1 };
-
-            goto exit_with_log;
-         }
+         free(aScratch);
+         free(aFeatureValues);
+      }
 
-         if(UNLIKELY(countSamplesPerBinMin <= IntEbmType { 0 })) {
-            LOG_0(TraceLevelWarning,
-               "WARNING GenerateQuantileCuts countSamplesPerBinMin shouldn't be zero or negative.  Setting to 1");
+   exit_with_log:;
 
-            countSamplesPerBinMin = IntEbmType { 1 };
-         }
+      EBM_ASSERT(nullptr != countCutsInOut);
+      *countCutsInOut = countCutsRet;
+   }
 
-         EBM_ASSERT(IsNumberConvertable<IntEbmType>(cSamples)); // since it came from an IntEbmType originally
-         if(UNLIKELY(static_cast<IntEbmType>(cSamples >> 1) < countSamplesPerBinMin)) {
-            // each bin needs at least countSamplesPerBinMin samples, so we need two sets of countSamplesPerBinMin
-            // in order to make any cuts.  Anything less and we should just return now.
-            // We also use this as a comparison to ensure that countSamplesPerBinMin is convertible to a size_t
+   if(LIKELY(nullptr != countMissingValuesOut)) {
+      *countMissingValuesOut = countMissingValuesRet;
+   }
+   if(LIKELY(nullptr != minNonInfinityValueOut)) {
+      *minNonInfinityValueOut = minNonInfinityValueRet;
+   }
+   if(LIKELY(nullptr != countNegativeInfinityOut)) {
+      *countNegativeInfinityOut = countNegativeInfinityRet;
+   }
+   if(LIKELY(nullptr != maxNonInfinityValueOut)) {
+      *maxNonInfinityValueOut = maxNonInfinityValueRet;
+   }
+   if(LIKELY(nullptr != countPositiveInfinityOut)) {
+      *countPositiveInfinityOut = countPositiveInfinityRet;
+   }
 
-            free(aFeatureValues);
-            countCutsRet = IntEbmType { 0 };
-            ret = IntEbmType { 0 };
-            goto exit_with_log;
-         }
+   LOG_COUNTED_N(
+      &g_cLogExitGenerateQuantileCutsParametersMessages,
+      TraceLevelInfo,
+      TraceLevelVerbose,
+      "Exited GenerateQuantileCuts: "
+      "countCuts=%" IntEbmTypePrintf ", "
+      "countMissingValues=%" IntEbmTypePrintf ", "
+      "minNonInfinityValue=%" FloatEbmTypePrintf ", "
+      "countNegativeInfinity=%" IntEbmTypePrintf ", "
+      "maxNonInfinityValue=%" FloatEbmTypePrintf ", "
+      "countPositiveInfinity=%" IntEbmTypePrintf ", "
+      "return=%" IntEbmTypePrintf
+      ,
+      countCutsRet,
+      countMissingValuesRet,
+      minNonInfinityValueRet,
+      countNegativeInfinityRet,
+      maxNonInfinityValueRet,
+      countPositiveInfinityRet,
+      ret
+   );
 
-         // countSamplesPerBinMin is convertible to size_t since countSamplesPerBinMin <= (cSamples >> 1)
-         EBM_ASSERT(IsNumberConvertable<size_t>(countSamplesPerBinMin));
-         const size_t cSamplesPerBinMin = static_cast<size_t>(countSamplesPerBinMin);
-
-         // In theory, we could constrain our cBinsMaxInitial value a bit more by taking our value array
-         // and attempting to jump by the minimum each time.  Then if there was a long run of equal values we'd
-         // be able to limit the number of cuts, but then the algorithm is going to need to be pretty smart later
-         // on when it finds the long run and needs to compress the available cuts back down into the cutable regions
-         // it's probably better to just place a lot of asiprational cuts at the minimum separation and trim them
-         // as we go on so.  In that case we'd be hard pressed to misallocate cuts since they'll almost always
-         // alrady be cSamplesPerBinMin apart in the regions that are cutable.
-         const size_t cBinsMaxInitial = cSamples / cSamplesPerBinMin;
-
-         // otherwise we'd have failed the check "static_cast<IntEbmType>(cSamples >> 1) < countSamplesPerBinMin"
-         EBM_ASSERT(size_t { 2 } <= cBinsMaxInitial);
-         const size_t cCutsMaxInitial = cBinsMaxInitial - size_t { 1 };
-
-         // cSamples fit into an IntEbmType, and since cCutsMaxInitial is less than cSamples, 
-         // we should be able to convert it back to an IntEbmType
-         EBM_ASSERT(cCutsMaxInitial < cSamples);
-         EBM_ASSERT(IsNumberConvertable<IntEbmType>(cCutsMaxInitial));
-         const size_t cCutsMax = static_cast<IntEbmType>(cCutsMaxInitial) < countCuts ?
-            cCutsMaxInitial : static_cast<size_t>(countCuts);
-
-         EBM_ASSERT(size_t { 1 } <= cCutsMax); // we won't eliminate to less than 1, and we had at least 1 before
-
-         // we need to be able to index both the cutsLowerBoundInclusiveOut AND we also allocate an array
-         // of pointers below of FloatEbmType * to index into aFeatureValues 
-         if(UNLIKELY(IsMultiplyError(cCutsMax, std::max(sizeof(*cutsLowerBoundInclusiveOut), sizeof(FloatEbmType *))))) {
-            LOG_0(TraceLevelWarning, "WARNING GenerateQuantileCuts IsMultiplyError(cCutsMax, std::max(sizeof(*cutsLowerBoundInclusiveOut), sizeof(FloatEbmType *)))");
-            free(aFeatureValues);
-            countCutsRet = IntEbmType { 0 };
-            ret = IntEbmType { 1 };
-            goto exit_with_log;
-         }
+   return ret;
+}
+
+// we don't care if an extra log message is outputted due to the non-atomic nature of the decrement to this value
+static int g_cLogEnterGenerateQuantileCutsResolutionsParametersMessages = 25;
+static int g_cLogExitGenerateQuantileCutsResolutionsParametersMessages = 25;
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION GenerateQuantileCutsResolutions(
+   IntEbmType countSamples,
+   const FloatEbmType * featureValues,
+   IntEbmType countSamplesPerBinMin,
+   BoolEbmType isHumanized,
+   IntEbmType countResolutions,
+   IntEbmType * countCutsInOut,
+   FloatEbmType * cutsLowerBoundInclusiveOut,
+   IntEbmType * countMissingValuesOut,
+   FloatEbmType * minNonInfinityValueOut,
+   IntEbmType * countNegativeInfinityOut,
+   FloatEbmType * maxNonInfinityValueOut,
+   IntEbmType * countPositiveInfinityOut
+) {
+   LOG_COUNTED_N(
+      &g_cLogEnterGenerateQuantileCutsResolutionsParametersMessages,
+      TraceLevelInfo,
+      TraceLevelVerbose,
+      "Entered GenerateQuantileCutsResolutions: "
+      "countSamples=%" IntEbmTypePrintf ", "
+      "featureValues=%p, "
+      "countSamplesPerBinMin=%" IntEbmTypePrintf ", "
+      "isHumanized=%s, "
+      "countResolutions=%" IntEbmTypePrintf ", "
+      "countCutsInOut=%p, "
+      "cutsLowerBoundInclusiveOut=%p, "
+      "countMissingValuesOut=%p, "
+      "minNonInfinityValueOut=%p, "
+      "countNegativeInfinityOut=%p, "
+      "maxNonInfinityValueOut=%p, "
+      "countPositiveInfinityOut=%p"
+      ,
+      countSamples,
+      static_cast<const void *>(featureValues),
+      countSamplesPerBinMin,
+      ObtainTruth(isHumanized),
+      countResolutions,
+      static_cast<void *>(countCutsInOut),
+      static_cast<void *>(cutsLowerBoundInclusiveOut),
+      static_cast<void *>(countMissingValuesOut),
+      static_cast<void *>(minNonInfinityValueOut),
+      static_cast<void *>(countNegativeInfinityOut),
+      static_cast<void *>(maxNonInfinityValueOut),
+      static_cast<void *>(countPositiveInfinityOut)
+   );
 
-         std::sort(aFeatureValues, aFeatureValues + cSamples);
+   IntEbmType countMissingValuesRet = IntEbmType { 0 };
+   FloatEbmType minNonInfinityValueRet = FloatEbmType { 0 };
+   IntEbmType countNegativeInfinityRet = IntEbmType { 0 };
+   FloatEbmType maxNonInfinityValueRet = FloatEbmType { 0 };
+   IntEbmType countPositiveInfinityRet = IntEbmType { 0 };
+   IntEbmType ret = IntEbmType { 1 };
 
-         EBM_ASSERT(cCutsMax < cSamples); // so we can add 1 to cCutsMax safely
-         const size_t cUncuttableRangeLengthMin = 
-            GetUncuttableRangeLengthMin(cSamples, cCutsMax + size_t { 1 }, cSamplesPerBinMin);
-         EBM_ASSERT(size_t { 1 } <= cUncuttableRangeLengthMin);
+   if(UNLIKELY(countResolutions < IntEbmType { 0 })) {
+      LOG_0(TraceLevelError, "ERROR GenerateQuantileCutsResolutions countResolutions < IntEbmType { 0 }");
+      goto exit_with_log;
+   }
+   if(UNLIKELY(!IsNumberConvertable<size_t>(countResolutions))) {
+      LOG_0(TraceLevelWarning, "WARNING GenerateQuantileCutsResolutions !IsNumberConvertable<size_t>(countResolutions)");
+      goto exit_with_log;
+   }
+   if(UNLIKELY(IntEbmType { 0 } != countResolutions && nullptr == countCutsInOut)) {
+      LOG_0(TraceLevelError, "ERROR GenerateQuantileCutsResolutions nullptr == countCutsInOut");
+      goto exit_with_log;
+   }
 
-         const size_t cCuttingRanges = CountCuttingRanges(
-            cSamples, 
-            aFeatureValues,
-            cUncuttableRangeLengthMin, 
-            cSamplesPerBinMin
-         );
-         // we GUARANTEE that each interior CuttingRange can have at least one cut by choosing an 
-         // cUncuttableRangeLengthMin sufficiently long to ensure this property.  The first and last cutable
-         // ranges, if they exist, can be quite small, so we can trade 1 long uncutable range for 2 cutable
-         // ranges at the tail ends, so we can get 1 more cut than the maximum number of cuts given to us
-         // but not 2 more.  cCutsMax + size_t { 1 } can't overflow since cCutsMax < cSamples , and
-         // cSamples is a size_t
-         EBM_ASSERT(cCuttingRanges <= cCutsMax + size_t { 1 });
-         if(UNLIKELY(size_t { 0 } == cCuttingRanges)) {
-            free(aFeatureValues);
-            countCutsRet = IntEbmType { 0 };
+   {
+      const size_t cResolutions = static_cast<size_t>(countResolutions);
+
+      {
+         if(UNLIKELY(countSamples <= IntEbmType { 0 })) {
             ret = IntEbmType { 0 };
-            goto exit_with_log;
+            if(UNLIKELY(countSamples < IntEbmType { 0 })) {
+               LOG_0(TraceLevelError, "ERROR GenerateQuantileCutsResolutions countSamples < IntEbmType { 0 }");
+               ret = IntEbmType { 1 };
+            }
+            goto exit_without_cuts;
          }
 
-         if(UNLIKELY(IsMultiplyError(cSamples, sizeof(NeighbourJump)))) {
-            LOG_0(TraceLevelWarning, "WARNING GenerateQuantileCuts IsMultiplyError(cSamples, sizeof(NeighbourJump))");
-            free(aFeatureValues);
-            countCutsRet = IntEbmType { 0 };
-            ret = IntEbmType { 1 };
-            goto exit_with_log;
+         if(UNLIKELY(nullptr == featureValues)) {
+            LOG_0(TraceLevelError, "ERROR GenerateQuantileCutsResolutions nullptr == featureValues");
+            goto exit_without_cuts;
          }
-         const size_t cBytesNeighbourJumps = cSamples * sizeof(NeighbourJump);
-
-         // we checked that this multiplication wouldn't overflow above
-         EBM_ASSERT(!IsMultiplyError(cCutsMax, sizeof(FloatEbmType *)));
-         const size_t cBytesValueCutPointers = cCutsMax * sizeof(FloatEbmType *);
-
-         // we limit the cCutsMax to no more than cSamples - 1.  cSamples can't be anywhere close to
-         // the maximum size_t though since the caller must have allocated cSamples floats in aFeatureValues, and
-         // there are no float types that are 1 byte, and we checked that this didn't overflow, so we should be good
-         // to add 2 to the cCutsMax value
-         EBM_ASSERT(cCutsMax <= std::numeric_limits<size_t>::max() - size_t { 2 });
-         // include storage for the end points
-         const size_t cCutsWithEndpointsMax = cCutsMax + size_t { 2 };
-         if(UNLIKELY(IsMultiplyError(cCutsWithEndpointsMax, sizeof(CutPoint)))) {
-            LOG_0(TraceLevelWarning, "WARNING GenerateQuantileCuts IsMultiplyError(cCutsWithEndpointsMax, sizeof(CutPoint))");
-            free(aFeatureValues);
-            countCutsRet = IntEbmType { 0 };
-            ret = IntEbmType { 1 };
-            goto exit_with_log;
+
+         if(UNLIKELY(!IsNumberConvertable<size_t>(countSamples))) {
+            LOG_0(TraceLevelWarning, "WARNING GenerateQuantileCutsResolutions !IsNumberConvertable<size_t>(countSamples)");
+            goto exit_without_cuts;
          }
-         const size_t cBytesCuts = cCutsWithEndpointsMax * sizeof(CutPoint);
 
-         if(UNLIKELY(IsMultiplyError(cCuttingRanges, sizeof(CuttingRange)))) {
-            LOG_0(TraceLevelWarning, "WARNING GenerateQuantileCuts IsMultiplyError(cCuttingRanges, sizeof(CuttingRange))");
-            free(aFeatureValues);
-            countCutsRet = IntEbmType { 0 };
-            ret = IntEbmType { 1 };
-            goto exit_with_log;
+         const size_t cSamplesIncludingMissingValues = static_cast<size_t>(countSamples);
+
+         FloatEbmType * const aFeatureValues = EbmMalloc<FloatEbmType>(cSamplesIncludingMissingValues);
+         if(UNLIKELY(nullptr == aFeatureValues)) {
+            LOG_0(TraceLevelError, "ERROR GenerateQuantileCutsResolutions nullptr == aFeatureValues");
+            goto exit_without_cuts;
          }
-         const size_t cBytesCuttingRanges = cCuttingRanges * sizeof(CuttingRange);
+         const size_t cBytesFeatureValues = sizeof(*featureValues) * cSamplesIncludingMissingValues;
+         memcpy(aFeatureValues, featureValues, cBytesFeatureValues);
 
+         // the radix sort needs a second buffer.  If we can't get it we fall back to std::sort, which is slower but gives the same result
+         FloatEbmType * const aScratch = k_cSamplesRadixSortMin <= cSamplesIncludingMissingValues ?
+            EbmMalloc<FloatEbmType>(cSamplesIncludingMissingValues) : nullptr;
 
-         const size_t cBytesToNeighbourJump = size_t { 0 };
-         const size_t cBytesToValueCutPointers = cBytesToNeighbourJump + cBytesNeighbourJumps;
+         ret = GenerateQuantileCutsResolutionsInternal(
+            cSamplesIncludingMissingValues,
+            aFeatureValues,
+            aScratch,
+            countSamplesPerBinMin,
+            isHumanized,
+            cResolutions,
+            countCutsInOut,
+            cutsLowerBoundInclusiveOut,
+            &countMissingValuesRet,
+            &minNonInfinityValueRet,
+            &countNegativeInfinityRet,
+            &maxNonInfinityValueRet,
+            &countPositiveInfinityRet
+         );
 
-         if(UNLIKELY(IsAddError(cBytesToValueCutPointers, cBytesValueCutPointers))) {
-            LOG_0(TraceLevelWarning, "WARNING GenerateQuantileCuts IsAddError(cBytesToValueCutPointers, cBytesValueCutPointers))");
-            free(aFeatureValues);
-            countCutsRet = IntEbmType { 0 };
-            ret = IntEbmType { 1 };
-            goto exit_with_log;
-         }
-         const size_t cBytesToCuts = cBytesToValueCutPointers + cBytesValueCutPointers;
+         free(aScratch);
+         free(aFeatureValues);
+         goto exit_with_log;
+      }
 
-         if(UNLIKELY(IsAddError(cBytesToCuts, cBytesCuts))) {
-            LOG_0(TraceLevelWarning, "WARNING GenerateQuantileCuts IsAddError(cBytesToCuts, cBytesCuts))");
-            free(aFeatureValues);
-            countCutsRet = IntEbmType { 0 };
-            ret = IntEbmType { 1 };
-            goto exit_with_log;
-         }
-         const size_t cBytesToCuttingRange = cBytesToCuts + cBytesCuts;
+   exit_without_cuts:;
+      for(size_t iResolution = 0; iResolution < cResolutions; ++iResolution) {
+         countCutsInOut[iResolution] = IntEbmType { 0 };
+      }
+   }
 
-         if(UNLIKELY(IsAddError(cBytesToCuttingRange, cBytesCuttingRanges))) {
-            LOG_0(TraceLevelWarning, "WARNING GenerateQuantileCuts IsAddError(cBytesToCuttingRange, cBytesCuttingRanges))");
-            free(aFeatureValues);
-            countCutsRet = IntEbmType { 0 };
-            ret = IntEbmType { 1 };
-            goto exit_with_log;
-         }
-         const size_t cBytesToEnd = cBytesToCuttingRange + cBytesCuttingRanges;
+exit_with_log:;
 
-         char * const pMem = static_cast<char *>(malloc(cBytesToEnd));
-         if(UNLIKELY(nullptr == pMem)) {
-            LOG_0(TraceLevelWarning, "WARNING GenerateQuantileCuts nullptr == pMem");
-            free(aFeatureValues);
-            countCutsRet = IntEbmType { 0 };
-            ret = IntEbmType { 1 };
-            goto exit_with_log;
-         }
+   if(LIKELY(nullptr != countMissingValuesOut)) {
+      *countMissingValuesOut = countMissingValuesRet;
+   }
+   if(LIKELY(nullptr != minNonInfinityValueOut)) {
+      *minNonInfinityValueOut = minNonInfinityValueRet;
+   }
+   if(LIKELY(nullptr != countNegativeInfinityOut)) {
+      *countNegativeInfinityOut = countNegativeInfinityRet;
+   }
+   if(LIKELY(nullptr != maxNonInfinityValueOut)) {
+      *maxNonInfinityValueOut = maxNonInfinityValueRet;
+   }
+   if(LIKELY(nullptr != countPositiveInfinityOut)) {
+      *countPositiveInfinityOut = countPositiveInfinityRet;
+   }
+
+   LOG_COUNTED_N(
+      &g_cLogExitGenerateQuantileCutsResolutionsParametersMessages,
+      TraceLevelInfo,
+      TraceLevelVerbose,
+      "Exited GenerateQuantileCutsResolutions: "
+      "countMissingValues=%" IntEbmTypePrintf ", "
+      "minNonInfinityValue=%" FloatEbmTypePrintf ", "
+      "countNegativeInfinity=%" IntEbmTypePrintf ", "
+      "maxNonInfinityValue=%" FloatEbmTypePrintf ", "
+      "countPositiveInfinity=%" IntEbmTypePrintf ", "
+      "return=%" IntEbmTypePrintf
+      ,
+      countMissingValuesRet,
+      minNonInfinityValueRet,
+      countNegativeInfinityRet,
+      maxNonInfinityValueRet,
+      countPositiveInfinityRet,
+      ret
+   );
 
-         NeighbourJump * const aNeighbourJumps = reinterpret_cast<NeighbourJump *>(pMem + cBytesToNeighbourJump);
-         const FloatEbmType ** const apValueCutTops = reinterpret_cast<const FloatEbmType **>(pMem + cBytesToValueCutPointers);
-         CutPoint * const aCuts = reinterpret_cast<CutPoint *>(pMem + cBytesToCuts);
-         CuttingRange * const aCuttingRange = reinterpret_cast<CuttingRange *>(pMem + cBytesToCuttingRange);
+   return ret;
+}
 
-         ConstructJumps(cSamples, aFeatureValues, aNeighbourJumps);
+// The workers in GenerateQuantileCutsBatch each hold a copy of one column, a radix sort scratch buffer, and the NeighbourJumps that 
+// GenerateQuantileCutsSorted allocates per sample.  That's about 32 bytes per sample per worker on top of the caller's matrix, so with 
+// tens of millions of samples and many cores the workers alone could need tens of GB.  We launch no more workers than fit in this budget.
+constexpr size_t k_cBytesQuantileCutsWorkersMax = size_t { 1 } << 30;
+
+struct QuantileCutsWork final {
+   size_t m_cSamples;
+   size_t m_cFeatures;
+   const FloatEbmType * m_aFeatureValues;
+   bool m_bColumnMajor;
+   const IntEbmType * m_aCountSamplesPerBinMin;
+   BoolEbmType m_isHumanized;
+   // where each feature's cuts start in m_aCutsLowerBoundInclusive
+   const size_t * m_aiCutsFirst;
+   IntEbmType * m_aCountCuts;
+   FloatEbmType * m_aCutsLowerBoundInclusive;
+   IntEbmType * m_aCountMissingValues;
+   FloatEbmType * m_aMinNonInfinityValue;
+   IntEbmType * m_aCountNegativeInfinity;
+   FloatEbmType * m_aMaxNonInfinityValue;
+   IntEbmType * m_aCountPositiveInfinity;
+   std::atomic<size_t> m_iFeatureNext;
+   bool m_abError[k_cWorkersMax];
+};
 
-         // we always XOR (with != for bools) a random number with bSymmetryReversal, so there is no need to
-         // XOR bSymmetryReversal with a random number here
-         const bool bSymmetryReversal = DetermineSymmetricDirection(cSamples, aFeatureValues);
+static void GenerateQuantileCutsWorker(void * const pWorkVoid, const size_t iWorker) {
+   QuantileCutsWork * const pWork = static_cast<QuantileCutsWork *>(pWorkVoid);
 
-         RandomStream randomStream;
-         randomStream.InitializeUnsigned(randomSeed, k_quantileRandomizationMix);
+   const size_t cSamples = pWork->m_cSamples;
+   const size_t cFeatures = pWork->m_cFeatures;
 
-         FillTiebreakers(bSymmetryReversal, &randomStream, cCuttingRanges, aCuttingRange);
+   // each worker sorts its features in its own scratch buffer, which we re-use for every feature that it takes.  If we can't get the 
+   // memory then we leave the features for the other workers and our caller checks that every feature was taken
+   FloatEbmType * const aFeatureValues = EbmMalloc<FloatEbmType>(cSamples);
+   if(nullptr == aFeatureValues) {
+      LOG_0(TraceLevelWarning, "WARNING GenerateQuantileCutsWorker nullptr == aFeatureValues");
+      return;
+   }
+   // a missing scratch buffer only means that we sort with std::sort instead of the radix sort
+   FloatEbmType * const aScratch = k_cSamplesRadixSortMin <= cSamples ? EbmMalloc<FloatEbmType>(cSamples) : nullptr;
 
-         FillCuttingRangeBasics(cSamples, aFeatureValues, cUncuttableRangeLengthMin, cSamplesPerBinMin, cCuttingRanges, aCuttingRange);
-         FillCuttingRangeNeighbours(cSamples, aFeatureValues, cCuttingRanges, aCuttingRange);
+   bool bError = false;
+   while(true) {
+      const size_t iFeature = pWork->m_iFeatureNext.fetch_add(size_t { 1 }, std::memory_order_relaxed);
+      if(cFeatures <= iFeature) {
+         break;
+      }
 
-         const FloatEbmType ** ppValueCutTop = apValueCutTops;
-         try {
-            std::set<CuttingRange *, CompareCuttingRange> priorityQueue;
-            StuffCutsIntoCuttingRanges(
-               priorityQueue,
-               cCuttingRanges,
-               aCuttingRange,
-               cSamplesPerBinMin,
-               cCutsMax
-            );
-            do {
-               EBM_ASSERT(!priorityQueue.empty());
-               // remove the item that is the worst CuttingRange for us to add a new cut to.  We'll keep
-               // the cutting ranges that are closest to the threshold for adding new cuts in the queue so that
-               // if we can't use all our cuts, we can move the cuts to the next best choice
-               auto iterator = prev(priorityQueue.end());
-               CuttingRange * const pCuttingRange = *iterator;
-               priorityQueue.erase(iterator);
+      if(pWork->m_bColumnMajor) {
+         memcpy(aFeatureValues, &pWork->m_aFeatureValues[iFeature * cSamples], sizeof(*aFeatureValues) * cSamples);
+      } else {
+         const FloatEbmType * pFeatureValueFrom = &pWork->m_aFeatureValues[iFeature];
+         for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+            aFeatureValues[iSample] = *pFeatureValueFrom;
+            pFeatureValueFrom += cFeatures;
+         }
+      }
 
-               const size_t cRanges = pCuttingRange->m_cRangesAssigned;
+      IntEbmType countMissingValues;
+      FloatEbmType minNonInfinityValue;
+      IntEbmType countNegativeInfinity;
+      FloatEbmType maxNonInfinityValue;
+      IntEbmType countPositiveInfinity;
+      const IntEbmType ret = GenerateQuantileCutsInternal(
+         cSamples,
+         aFeatureValues,
+         aScratch,
+         pWork->m_aCountSamplesPerBinMin[iFeature],
+         pWork->m_isHumanized,
+         &pWork->m_aCountCuts[iFeature],
+         nullptr == pWork->m_aCutsLowerBoundInclusive ? nullptr : &pWork->m_aCutsLowerBoundInclusive[pWork->m_aiCutsFirst[iFeature]],
+         &countMissingValues,
+         &minNonInfinityValue,
+         &countNegativeInfinity,
+         &maxNonInfinityValue,
+         &countPositiveInfinity
+      );
+      bError = bError || IntEbmType { 0 } != ret;
 
-#ifdef LOG_SUPERVERBOSE_DISCRETIZATION_ORDERED
-               LOG_N(TraceLevelVerbose, "Dequque CuttingRange: %zu, %zu, %zu, %zu, %zu, %zu, %zu, %" FloatEbmTypePrintf,
-                  pCuttingRange->m_uniqueTiebreaker,
-                  pCuttingRange->m_cRangesAssigned,
-                  pCuttingRange->m_cCuttableValues,
-                  static_cast<size_t>(pCuttingRange->m_pCuttableValuesFirst - aFeatureValues),
-                  pCuttingRange->m_cUncuttableHighValues,
-                  pCuttingRange->m_cUncuttableLowValues,
-                  pCuttingRange->m_cRangesMax,
-                  pCuttingRange->m_avgCuttableRangeWidthAfterAddingOneCut
-               );
-#endif // LOG_SUPERVERBOSE_DISCRETIZATION_ORDERED
+      if(nullptr != pWork->m_aCountMissingValues) {
+         pWork->m_aCountMissingValues[iFeature] = countMissingValues;
+      }
+      if(nullptr != pWork->m_aMinNonInfinityValue) {
+         pWork->m_aMinNonInfinityValue[iFeature] = minNonInfinityValue;
+      }
+      if(nullptr != pWork->m_aCountNegativeInfinity) {
+         pWork->m_aCountNegativeInfinity[iFeature] = countNegativeInfinity;
+      }
+      if(nullptr != pWork->m_aMaxNonInfinityValue) {
+         pWork->m_aMaxNonInfinityValue[iFeature] = maxNonInfinityValue;
+      }
+      if(nullptr != pWork->m_aCountPositiveInfinity) {
+         pWork->m_aCountPositiveInfinity[iFeature] = countPositiveInfinity;
+      }
+   }
+   pWork->m_abError[iWorker] = bError;
 
-               if(PREDICTABLE(size_t { 1 } < cRanges)) {
-                  // we have cuts on our ends, either explicit or implicit at the tail ends that don't have unsplitable
-                  // ranges on the tails, and at least one cut in our center, so we have to make decisions
-                  std::set<CutPoint *, CompareCutPoint> bestCuts;
+   free(aScratch);
+   free(aFeatureValues);
+}
 
-#ifdef NEVER
-                  // TODO : in the future fill this priority queue with the average length within our
-                  //        visibility window AFTER a new cut would be added.  We calculate this value per
-                  //        CutPoint and we do it at the same time we're calculating the cut priority, which
-                  //        is good since we'll already have the visibility windows calculated and all that.
-                  //        One wrinkle is that we want to be able to insert a cut into a range that no longer
-                  //        has any internal cuts.  So for instance if we had a range from 50 to 100 with
-                  //        materialized cuts on both 50 and 100, and no allocated cuts between them, in
-                  //        the future if cuts become plentiful, then we want to create a new cut between
-                  //        those materialized cuts.  I believe the best way to handle this is to check
-                  //        when materializing a cut if both our lower and higher cut points are aspirational
-                  //        or materialized.  If they are both materialized, then insert our new materialized
-                  //        cut into the open space priority queue AND the cut to the left (which represents)
-                  //        the lower range.  Or if that's too complicated then take the maximum min from both
-                  //        our sides and insert ourselves with that.  We can always examine the left and right
-                  //        on extraction to determine which side we should go to.
-                  //        Inisde CalculateRangesMaximizeMin, we might notice that one of our sides doesn't
-                  //        work very well with a certain number of cuts.  We should speculatively move
-                  //        one of our cuts from that side to a new set of ranges (encoded as Cuts)
-                  //        We still do the low/high cut number optimization with our left and right windows
-                  //        when planning since it's more efficient, and no changes should leak information
-                  //        outside those windows otherwise it would become an N^2 algorithm.
-                  //        We use our doubly linked list to move non-materialized cut points long distances
-                  //        from one part of the cutting range to annother if necessary.
-                  //        We should also use the doubly linked list to delete Cuts that we can't use
-                  //        if there is no place to put them
-
-                  std::set<CutPoint *, CompareCutPoint> fillTheVoids;
-#endif // NEVER
+static int g_cLogEnterGenerateQuantileCutsBatchParametersMessages = 25;
+static int g_cLogExitGenerateQuantileCutsBatchParametersMessages = 25;
 
-                  FillTiebreakers(bSymmetryReversal, &randomStream, cRanges - size_t { 1 }, aCuts + 1);
-                  if(TradeCutSegment(
-                     &bestCuts,
-                     cSamples,
-                     bSymmetryReversal,
-                     cSamplesPerBinMin,
-                     pCuttingRange->m_pCuttableValuesFirst - aFeatureValues,
-                     pCuttingRange->m_cCuttableValues,
-                     aNeighbourJumps,
-                     cRanges,
-                     // for efficiency we include space for the end point cuts even if they don't exist
-                     aCuts
-                  )) {
-                     // any error messages should have been written to the log inside TradeCutSegment
-
-                     free(pMem);
-                     free(aFeatureValues);
-
-                     countCutsRet = IntEbmType { 0 };
-                     ret = IntEbmType { 1 };
-                     goto exit_with_log;
-                  }
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION GenerateQuantileCutsBatch(
+   IntEbmType countSamples,
+   IntEbmType countFeatures,
+   const FloatEbmType * featureValues,
+   BoolEbmType isColumnMajor,
+   const IntEbmType * countSamplesPerBinMin,
+   BoolEbmType isHumanized,
+   IntEbmType * countCutsInOut,
+   FloatEbmType * cutsLowerBoundInclusiveOut,
+   IntEbmType * countMissingValuesOut,
+   FloatEbmType * minNonInfinityValueOut,
+   IntEbmType * countNegativeInfinityOut,
+   FloatEbmType * maxNonInfinityValueOut,
+   IntEbmType * countPositiveInfinityOut
+) {
+   LOG_COUNTED_N(
+      &g_cLogEnterGenerateQuantileCutsBatchParametersMessages,
+      TraceLevelInfo,
+      TraceLevelVerbose,
+      "Entered GenerateQuantileCutsBatch: "
+      "countSamples=%" IntEbmTypePrintf ", "
+      "countFeatures=%" IntEbmTypePrintf ", "
+      "featureValues=%p, "
+      "isColumnMajor=%s, "
+      "countSamplesPerBinMin=%p, "
+      "isHumanized=%s, "
+      "countCutsInOut=%p, "
+      "cutsLowerBoundInclusiveOut=%p, "
+      "countMissingValuesOut=%p, "
+      "minNonInfinityValueOut=%p, "
+      "countNegativeInfinityOut=%p, "
+      "maxNonInfinityValueOut=%p, "
+      "countPositiveInfinityOut=%p"
+      ,
+      countSamples,
+      countFeatures,
+      static_cast<const void *>(featureValues),
+      ObtainTruth(isColumnMajor),
+      static_cast<const void *>(countSamplesPerBinMin),
+      ObtainTruth(isHumanized),
+      static_cast<void *>(countCutsInOut),
+      static_cast<void *>(cutsLowerBoundInclusiveOut),
+      static_cast<void *>(countMissingValuesOut),
+      static_cast<void *>(minNonInfinityValueOut),
+      static_cast<void *>(countNegativeInfinityOut),
+      static_cast<void *>(maxNonInfinityValueOut),
+      static_cast<void *>(countPositiveInfinityOut)
+   );
 
-                  const FloatEbmType * const pCuttableValuesStart = pCuttingRange->m_pCuttableValuesFirst;
+   IntEbmType ret;
+   size_t cFeatures;
+   size_t * aiCutsFirst = nullptr;
+
+   if(UNLIKELY(countFeatures <= IntEbmType { 0 })) {
+      ret = IntEbmType { 0 };
+      if(UNLIKELY(countFeatures < IntEbmType { 0 })) {
+         LOG_0(TraceLevelError, "ERROR GenerateQuantileCutsBatch countFeatures can't be negative");
+         ret = IntEbmType { 1 };
+      }
+      goto exit_with_log;
+   }
+   if(UNLIKELY(!IsNumberConvertable<size_t>(countFeatures))) {
+      LOG_0(TraceLevelWarning, "WARNING GenerateQuantileCutsBatch !IsNumberConvertable<size_t>(countFeatures)");
+      ret = IntEbmType { 1 };
+      goto exit_with_log;
+   }
+   cFeatures = static_cast<size_t>(countFeatures);
 
-                  if(0 != pCuttingRange->m_cUncuttableLowValues) {
-                     // if it's zero then it's an implicit cut and we shouldn't put one there, 
-                     // otherwise put in the cut
-                     const FloatEbmType * const pCut = pCuttableValuesStart;
-                     EBM_ASSERT(aFeatureValues < pCut);
-                     EBM_ASSERT(pCut < aFeatureValues + countSamples);
-                     *ppValueCutTop = pCut;
-                     ++ppValueCutTop;
-                  }
+   if(UNLIKELY(nullptr == countCutsInOut)) {
+      LOG_0(TraceLevelError, "ERROR GenerateQuantileCutsBatch nullptr == countCutsInOut");
+      ret = IntEbmType { 1 };
+      goto exit_with_log;
+   }
 
-                  const CutPoint * pCutPoint = aCuts->m_pNext;
-                  const CutPoint * pNext = pCutPoint->m_pNext;
-                  while(LIKELY(nullptr != pNext)) {
-                     const size_t iVal = pCutPoint->m_iVal;
-                     if(LIKELY(k_valNotLegal != iVal)) {
-                        const FloatEbmType * const pCut = pCuttableValuesStart + iVal;
-                        EBM_ASSERT(aFeatureValues < pCut);
-                        EBM_ASSERT(pCut < aFeatureValues + countSamples);
-                        EBM_ASSERT(pCuttingRange->m_pCuttableValuesFirst < pCut);
-                        EBM_ASSERT(pCut < pCuttingRange->m_pCuttableValuesFirst + pCuttingRange->m_cCuttableValues);
-                        *ppValueCutTop = pCut;
-                        ++ppValueCutTop;
-                     }
-                     pCutPoint = pNext;
-                     pNext = pCutPoint->m_pNext;
-                  }
+   if(UNLIKELY(countSamples <= IntEbmType { 0 })) {
+      // same as GenerateQuantileCuts, no samples means no cuts and zeroed statistics for every feature
+      for(size_t iFeature = 0; iFeature < cFeatures; ++iFeature) {
+         countCutsInOut[iFeature] = IntEbmType { 0 };
+         if(nullptr != countMissingValuesOut) {
+            countMissingValuesOut[iFeature] = IntEbmType { 0 };
+         }
+         if(nullptr != minNonInfinityValueOut) {
+            minNonInfinityValueOut[iFeature] = FloatEbmType { 0 };
+         }
+         if(nullptr != countNegativeInfinityOut) {
+            countNegativeInfinityOut[iFeature] = IntEbmType { 0 };
+         }
+         if(nullptr != maxNonInfinityValueOut) {
+            maxNonInfinityValueOut[iFeature] = FloatEbmType { 0 };
+         }
+         if(nullptr != countPositiveInfinityOut) {
+            countPositiveInfinityOut[iFeature] = IntEbmType { 0 };
+         }
+      }
+      ret = IntEbmType { 0 };
+      if(UNLIKELY(countSamples < IntEbmType { 0 })) {
+         LOG_0(TraceLevelError, "ERROR GenerateQuantileCutsBatch countSamples can't be negative");
+         ret = IntEbmType { 1 };
+      }
+      goto exit_with_log;
+   }
 
-                  if(0 != pCuttingRange->m_cUncuttableHighValues) {
-                     // if it's zero then it's an implicit cut and we shouldn't put one there, 
-                     // otherwise put in the cut
-                     const FloatEbmType * const pCut =
-                        pCuttableValuesStart + pCuttingRange->m_cCuttableValues;
-                     EBM_ASSERT(aFeatureValues < pCut);
-                     EBM_ASSERT(pCut < aFeatureValues + countSamples);
-                     *ppValueCutTop = pCut;
-                     ++ppValueCutTop;
-                  }
-               } else if(PREDICTABLE(size_t { 1 } == cRanges)) {
-                  // we have cuts on both our ends (either explicit or implicit), so
-                  // we don't have to make any hard decisions, but we do have to be careful of the scenarios
-                  // where some of our cuts are implicit
-
-                  if(0 != pCuttingRange->m_cUncuttableLowValues) {
-                     // if it's zero then it's an implicit cut and we shouldn't put one there, 
-                     // otherwise put in the cut
-                     const FloatEbmType * const pCut = pCuttingRange->m_pCuttableValuesFirst;
-                     EBM_ASSERT(aFeatureValues < pCut);
-                     EBM_ASSERT(pCut < aFeatureValues + countSamples);
-                     *ppValueCutTop = pCut;
-                     ++ppValueCutTop;
-                  }
-                  if(0 != pCuttingRange->m_cUncuttableHighValues) {
-                     // if it's zero then it's an implicit cut and we shouldn't put one there, 
-                     // otherwise put in the cut
-                     const FloatEbmType * const pCut =
-                        pCuttingRange->m_pCuttableValuesFirst + pCuttingRange->m_cCuttableValues;
-                     EBM_ASSERT(aFeatureValues < pCut);
-                     EBM_ASSERT(pCut < aFeatureValues + countSamples);
-                     *ppValueCutTop = pCut;
-                     ++ppValueCutTop;
-                  }
-               } else {
-                  EBM_ASSERT(0 == cRanges);
-                  // we have only 1 cut to place, and no cuts on our boundaries, so we need to figure out
-                  // where in our range to place it, taking into consideration that we might have neighbours on our
-                  // sides that could be large
-
-                  // if we had implicit cuts on both ends and zero assigned cuts, we'd have 1 range and would
-                  // be handled above
-                  EBM_ASSERT(0 != pCuttingRange->m_cUncuttableLowValues || 0 != pCuttingRange->m_cUncuttableHighValues);
-
-                  // if one side or the other was an implicit cut, then we have zero cuts left after
-                  // the implicit cut is accounted for, so do nothing
-                  if(LIKELY(LIKELY(0 != pCuttingRange->m_cUncuttableLowValues) && 
-                     LIKELY(0 != pCuttingRange->m_cUncuttableHighValues))) {
-                     // even though we could reduce our squared error length more, it probably makes sense to 
-                     // include a little bit of our available numbers on one long range and the other, so let's put
-                     // the cut in the middle and only make the low/high decision to settle long-ish ranges
-                     // in the center
-
-                     const size_t cCuttableItems = pCuttingRange->m_cCuttableValues;
-                        
-                     const size_t iRangeFirst = pCuttingRange->m_pCuttableValuesFirst - aFeatureValues;
-                     const size_t iCenterOfRange = iRangeFirst + (cCuttableItems >> 1);
-
-                     // unlike in BuildNeighbourhoodPlan, we don't need to worry about the scenario that
-                     // a jumping range falls on the exact iCenterOfRange value, since for our purposes here
-                     // if we have a perfect answer that is perfectly in the center, then we always select that
-                     // one since we have no exclusion criteria here.  We never will seriously consider the 
-                     // iStartNext value if iStartCur is a perfectly centered match.
-                     // So we don't need to inject some randomness here, unlike in BuildNeighbourhoodPlan
-
-                     const NeighbourJump * const pNeighbourJump = &aNeighbourJumps[iCenterOfRange];
-
-                     const size_t iStartCur = pNeighbourJump->m_iStartCur;
-                     const size_t iStartNext = pNeighbourJump->m_iStartNext;
-
-                     const ptrdiff_t cDistanceLow1 = static_cast<ptrdiff_t>(iStartCur - iRangeFirst);
-                     EBM_ASSERT(ptrdiff_t { 0 } <= cDistanceLow1);
-                     EBM_ASSERT(cDistanceLow1 <= static_cast<ptrdiff_t>(cCuttableItems >> 1));
-                     // cDistanceHigh1 can be negative if cCuttableItems is zero since then iStartNext
-                     // will reflect the boundary of the point after the unsplittable range above
-                     // our cut point, but since our cDistanceLow1 will be zero, it'll work out without
-                     // a special check
-                     const ptrdiff_t cDistanceHigh1 = static_cast<ptrdiff_t>(iRangeFirst + cCuttableItems) 
-                        - static_cast<ptrdiff_t>(iStartNext);
-                     EBM_ASSERT(cDistanceHigh1 <= static_cast<ptrdiff_t>(cCuttableItems >> 1));
-                     EBM_ASSERT(size_t { 1 } == cCuttableItems % size_t { 2 } ||
-                        cDistanceHigh1 < static_cast<ptrdiff_t>(cCuttableItems >> 1));
-
-                     size_t iResult = UNPREDICTABLE(cDistanceHigh1 < cDistanceLow1) ? iStartCur : iStartNext;
-                     if(UNLIKELY(cDistanceHigh1 == cDistanceLow1)) {
-                        // per above, we can't get the situation where iCenterOfRange is the perfect center
-                        // past our if check above for cDistanceHigh1 == cDistanceLow1
-                        EBM_ASSERT(static_cast<size_t>(cDistanceLow1) * size_t { 2 } != cCuttableItems);
-
-                        // we're equidistant to both edges.  Next try to see which is closer to the outer
-                        // edge if we include the uncuttable ranges beyond
-                        const size_t cDistanceLow2 = pCuttingRange->m_cUncuttableLowValues;
-                        const size_t cDistanceHigh2 = pCuttingRange->m_cUncuttableHighValues;
-                        iResult = UNPREDICTABLE(cDistanceHigh2 < cDistanceLow2) ? iStartCur : iStartNext;
-                        if(UNLIKELY(cDistanceHigh2 == cDistanceLow2)) {
-                           // next, let's try to the edges of our full array
-                           const size_t cDistanceLow3 = iStartCur;
-                           const size_t cDistanceHigh3 = cSamples - iStartNext;
-                           iResult = UNPREDICTABLE(cDistanceHigh3 < cDistanceLow3) ? iStartCur : iStartNext;
-                           if(UNLIKELY(cDistanceHigh3 == cDistanceLow3)) {
-                              // wow, we're at the center of the entire array AND the center of the outer
-                              // unsplittable ranges, AND the center of the splitable ranges.  Our final fallback
-                              // is to resort to our symmetric determination (PLUS randomness)
-
-                              bool bLocalSymmetryReversal = randomStream.Next() != bSymmetryReversal;
-                              iResult = UNPREDICTABLE(bLocalSymmetryReversal) ? iStartCur : iStartNext;
-                           }
-                        }
-                     }
-                     const FloatEbmType * pCut = aFeatureValues + iResult;
-                     EBM_ASSERT(aFeatureValues < pCut);
-                     *ppValueCutTop = pCut;
-                     ++ppValueCutTop;
-                  }
-               }
-            } while(!priorityQueue.empty());
-         } catch(...) {
-            LOG_0(TraceLevelWarning, "WARNING GenerateQuantileCuts exception");
+   if(UNLIKELY(nullptr == featureValues)) {
+      LOG_0(TraceLevelError, "ERROR GenerateQuantileCutsBatch nullptr == featureValues");
+      ret = IntEbmType { 1 };
+      goto exit_with_log;
+   }
+   if(UNLIKELY(nullptr == countSamplesPerBinMin)) {
+      LOG_0(TraceLevelError, "ERROR GenerateQuantileCutsBatch nullptr == countSamplesPerBinMin");
+      ret = IntEbmType { 1 };
+      goto exit_with_log;
+   }
+   if(UNLIKELY(!IsNumberConvertable<size_t>(countSamples))) {
+      LOG_0(TraceLevelWarning, "WARNING GenerateQuantileCutsBatch !IsNumberConvertable<size_t>(countSamples)");
+      ret = IntEbmType { 1 };
+      goto exit_with_log;
+   }
 
-            free(pMem);
-            free(aFeatureValues);
+   {
+      const size_t cSamples = static_cast<size_t>(countSamples);
+      if(UNLIKELY(IsMultiplyError(cSamples, cFeatures) || IsMultiplyError(cSamples * cFeatures, sizeof(*featureValues)))) {
+         LOG_0(TraceLevelWarning, "WARNING GenerateQuantileCutsBatch the featureValues matrix is too large");
+         ret = IntEbmType { 1 };
+         goto exit_with_log;
+      }
 
-            countCutsRet = IntEbmType { 0 };
+      if(UNLIKELY(IsAddError(cFeatures, size_t { 1 }))) {
+         LOG_0(TraceLevelWarning, "WARNING GenerateQuantileCutsBatch IsAddError(cFeatures, size_t { 1 })");
+         ret = IntEbmType { 1 };
+         goto exit_with_log;
+      }
+      // the extra entry holds the total so that we can recover how many cuts each feature asked for if we need to retry
+      aiCutsFirst = EbmMalloc<size_t>(cFeatures + size_t { 1 });
+      if(UNLIKELY(nullptr == aiCutsFirst)) {
+         LOG_0(TraceLevelWarning, "WARNING GenerateQuantileCutsBatch nullptr == aiCutsFirst");
+         ret = IntEbmType { 1 };
+         goto exit_with_log;
+      }
+
+      // each feature's cuts are packed one after the other in cutsLowerBoundInclusiveOut, with as much room as it asked for in 
+      // countCutsInOut
+      size_t cCutsTotal = 0;
+      for(size_t iFeature = 0; iFeature < cFeatures; ++iFeature) {
+         const IntEbmType countCuts = countCutsInOut[iFeature];
+         if(UNLIKELY(countCuts < IntEbmType { 0 })) {
+            LOG_0(TraceLevelError, "ERROR GenerateQuantileCutsBatch countCutsInOut can't contain negative values");
+            ret = IntEbmType { 1 };
+            goto exit_with_log;
+         }
+         if(UNLIKELY(!IsNumberConvertable<size_t>(countCuts) || IsAddError(cCutsTotal, static_cast<size_t>(countCuts)))) {
+            LOG_0(TraceLevelWarning, "WARNING GenerateQuantileCutsBatch too many cuts");
             ret = IntEbmType { 1 };
             goto exit_with_log;
          }
+         aiCutsFirst[iFeature] = cCutsTotal;
+         cCutsTotal += static_cast<size_t>(countCuts);
+      }
+      aiCutsFirst[cFeatures] = cCutsTotal;
+      if(UNLIKELY(size_t { 0 } != cCutsTotal && nullptr == cutsLowerBoundInclusiveOut)) {
+         LOG_0(TraceLevelError, "ERROR GenerateQuantileCutsBatch nullptr == cutsLowerBoundInclusiveOut");
+         ret = IntEbmType { 1 };
+         goto exit_with_log;
+      }
 
-         EBM_ASSERT(apValueCutTops <= ppValueCutTop);
-         const size_t cCutsRet = ppValueCutTop - apValueCutTops;
-
-         // it's possible, although extremely unlikely, that due to floating point issues that should only
-         // occur with huge double indexes, we were not able to find the legal cut point, so check for zero
-         if(LIKELY(size_t { 0 } != cCutsRet)) {
-            // the pointers are guaranteed to be in same order as the cut values
-            std::sort(apValueCutTops, ppValueCutTop);
-
-            FloatEbmType * pCutsLowerBoundInclusive = cutsLowerBoundInclusiveOut;
-            const FloatEbmType * const * ppValueCutTop2 = apValueCutTops;
-
-            if(EBM_FALSE == isHumanized) {
-               do {
-                  const FloatEbmType * const pCut = *ppValueCutTop2;
-                  EBM_ASSERT(aFeatureValues < pCut);
-                  EBM_ASSERT(pCut < aFeatureValues + cSamples);
-                  const FloatEbmType valHigh = *pCut;
-                  EBM_ASSERT(!std::isnan(valHigh));
-                  EBM_ASSERT(!std::isinf(valHigh));
-                  const FloatEbmType valLow = *(pCut - size_t { 1 });
-                  EBM_ASSERT(!std::isnan(valLow));
-                  EBM_ASSERT(!std::isinf(valLow));
-                  const FloatEbmType cut = ArithmeticMean(valLow, valHigh);
-                  EBM_ASSERT(cutsLowerBoundInclusiveOut == pCutsLowerBoundInclusive || *(pCutsLowerBoundInclusive - size_t { 1 }) < cut);
-                  *pCutsLowerBoundInclusive = cut;
-                  ++pCutsLowerBoundInclusive;
-                  ++ppValueCutTop2;
-               } while(ppValueCutTop != ppValueCutTop2);
-            } else {
-               do {
-                  const FloatEbmType * const pCut = *ppValueCutTop2;
-                  EBM_ASSERT(aFeatureValues < pCut);
-                  EBM_ASSERT(pCut < aFeatureValues + cSamples);
-                  const FloatEbmType valHigh = *pCut;
-                  EBM_ASSERT(!std::isnan(valHigh));
-                  EBM_ASSERT(!std::isinf(valHigh));
-                  const FloatEbmType valLow = *(pCut - size_t { 1 });
-                  EBM_ASSERT(!std::isnan(valLow));
-                  EBM_ASSERT(!std::isinf(valLow));
-                  const FloatEbmType cut = GetInterpretableCutPointFloat(valLow, valHigh);
-                  EBM_ASSERT(cutsLowerBoundInclusiveOut == pCutsLowerBoundInclusive || *(pCutsLowerBoundInclusive - size_t { 1 }) < cut);
-                  *pCutsLowerBoundInclusive = cut;
-                  ++pCutsLowerBoundInclusive;
-                  ++ppValueCutTop2;
-               } while(ppValueCutTop != ppValueCutTop2);
-
-               // if you have 1 cut point, then you get a graph with some mass on the left, some mass on the right
-               // and the cut point, and that's great.  We don't need to improve on that.  Our one cut points provides
-               // the most information possible and it's displayable on a graph.
-               // eg: "0.01 0.01 | 100 100" -> put the cut point at 1 and we can show both logit sides without
-               // indicating the min/max values of 0.001 and 1000
-               //
-               // if you have 2 cut points, then the graph will have 3 regions, and we can scale the graph so that
-               // 1/3 of the mass in on the left, 1/3 is in the scaled center, and 1/3 is on the right.  Whatever cuts
-               // we get provide the most amount of information possible, and it's graphable.
-               // eg: "0.01 0.01 | 1 1 | 100 100" -> put the cut points at 0.1 and 10 and the graph can range
-               // from 0.1 to 10 with some space on the tails to show the logits for the "-infinity -> 0.1" bin
-               // and the "10 -> +infinity" bin.
-               //
-               // if we have 3 cut points, then we could get into graphing issues if one of the ranges was so big
-               // that it dwarfed the other two in size.  We can't do anything about this if one of the interior
-               // ranges is huge, but often times the huge range is at the extreme ends of the graph and if the
-               // value on the interior side is smaller then we have some ability to pick the cut point.
-               // eg: "1 1 | 2 2 | 3 3 | infinity infinity".  The cut points can legally be:
-               //         1.5   2.5   3.5
-               // but if the values were instead:
-               // eg: "1 1 | 2 2 | 3 3 | 3.2 3.2".  The cut points can't exceed 3.2, so we'd use:
-               //         1.5   2.5   3.1
-               //
-               // Our algorithm finds 3.5 and 3.1 and picks the minimum, and the same on the low side, but there we
-               // take the maximum.
-               //
-               // In the above example, our graph must at minimum show the data from 2 -> 3, and in fact we'll want
-               // to not put our cuts right outside 2 and 3, so we want to move a reasonable distance away from those
-               // ends to the 1.5 and 3.5 positions to put our cuts, and since the "-infinity -> 1.5" bin and
-               // "3.5 -> +infinity" bins have logits, we also want some space on the graph to show those logits
-               // so we probably want our graph to show something like the space 0 -> 5, although this can be
-               // chosen by the graphing function.
-               //
-               // It's tempting to want to use the interior cuts to determine the outer cuts:
-               // eg: "-infinity -infinity | 2 2 | 3 3 | 4 4 | +infinity +infinity"
-               //                         1.5   2.5   3.5   4.5
-               // We might want to use 2.5 and 3.5 to determine that the cuts progress with distnaces of 1, and
-               // extrapolate 2.5 - 1 = 1.5 and 3.5 + 1 = 4.5, but we can't really do that because we might instead have
-               // something like this where the extrapolation will put us below the highLow value
-               // eg: "-infinity -infinity | 2 2 | 3 3 | 9 9 | +infinity +infinity"
-               // So we need to use the 9 value and extend from there.
-               //
-               // In the examples above, we've chosen point values, but we could easily have the following situation:
-               // 0.6 1.4 | 1.6 2.4 | 2.6 3.4 | 3.6 4.4 | 4.6 5.4
-               //        1.5       2.5       3.5       4.5
-               // which illustrates that in general the cut points can be very close to their neighbouring values.
-               // so in the examples farther above we had a spacing of 0.5 units from the interior values to the
-               // exterior cuts (1.5 -> 2) and (3 -> 3.5), but here we have separations of 0.1 (1.4 -> 1.5) and
-               // "4.4 -> 4.5".  
-               // 
-               // We're only choosing to override the averaged cut value when the outer value is a huge way off
-               // so we probably want to be conservative about how much we're override this and not put the
-               // new cut point too close to our lowHigh or highLow values.  If we start from a pointalism point
-               // of view that all the interior values are bunched onto discrete values like "2 2", and we assume
-               // half of the distance between a value and it's cut occurs on the lower and higher side, it gives
-               // us a kind of worse case reasonable scenario to deal with.  So starting from:
-               // "-infinity -infinity | 2 2 | 3 3 | 4 4 | +infinity +infinity"
-               //                     1.5   2.5   3.5   4.5
-               // We get the minimum graph range by taking the 4 and the 2 and substracting for 2.
-               // Then we assume that half of the bin on the upper side of the 2 is within that range and
-               // the lower side of the 4 is within that range, and we know that there is a range bounding 3,
-               // so we have 0.5 + 1 + 0.5 ranges total = 2.
-               // So our cut density is 2 / 2 = 1 cut per range.
-               // and we extend by half a bin downwards from the 2, which gives (2 - 1 / 2) = 1.5
-               // and we extend by half a bin upwards from the 4, which gives (4 + 1 / 2) = 4.5
-
-               if(LIKELY(size_t { 3 } <= cCutsRet)) {
-                  const FloatEbmType * const pScaleHighHigh = *(ppValueCutTop - size_t { 1 });
-                  EBM_ASSERT(aFeatureValues + size_t { 2 } < pScaleHighHigh);
-                  EBM_ASSERT(pScaleHighHigh < aFeatureValues + cSamples);
-                  const FloatEbmType * const pScaleHighLow = pScaleHighHigh - size_t { 1 };
-                  EBM_ASSERT(aFeatureValues + size_t { 1 } < pScaleHighLow);
-                  EBM_ASSERT(pScaleHighLow < aFeatureValues + cSamples - size_t { 1 });
-                  const FloatEbmType scaleHighLow = *pScaleHighLow;
-                  EBM_ASSERT(!std::isnan(scaleHighLow));
-                  EBM_ASSERT(!std::isinf(scaleHighLow));
-                  const FloatEbmType * pScaleLowHigh = *apValueCutTops;
-                  EBM_ASSERT(aFeatureValues < pScaleLowHigh);
-                  EBM_ASSERT(pScaleLowHigh < aFeatureValues + cSamples - size_t { 2 });
-                  const FloatEbmType scaleLowHigh = *pScaleLowHigh;
-                  EBM_ASSERT(!std::isnan(scaleLowHigh));
-                  EBM_ASSERT(!std::isinf(scaleLowHigh));
-                  EBM_ASSERT(scaleLowHigh < scaleHighLow);
-                  // this is the inescapable scale of our graph, from the value right above the lowest cut to the value 
-                  // right below the highest cut
-
-                  const FloatEbmType scaleMin = scaleHighLow - scaleLowHigh;
-                  // scaleMin can be +infinity if scaleHighLow is max and scaleLowHigh is lowest.  We can handle it.
-                  EBM_ASSERT(!std::isnan(scaleMin));
-                  // IEEE 754 (which we static_assert) won't allow the subtraction of two unequal numbers to be non-zero
-                  EBM_ASSERT(FloatEbmType { 0 } < scaleMin);
-
-                  // limit the amount of dillution allowed for the tails by capping the relevant cCutPointRet value
-                  // to 1/32, which means we leave about 3% of the visible area to tail bounds (1.5% on the left and
-                  // 1.5% on the right)
-
-                  const size_t cCutsLimited = size_t { 32 } < cCutsRet ? size_t { 32 } : cCutsRet;
-
-                  // the leftmost and rightmost cuts can legally be right outside of the bounds between scaleHighLow and
-                  // scaleLowHigh, so we subtract these two cuts, leaving us the number of ranges between the two end
-                  // points.  Half a range on the bottom, N - 1 ranges in the middle, and half a range on the top
-                  // Dividing by that number of ranges gives us the average range width.  We don't want to get the final
-                  // cut though from the previous inner cut.  We want to move outwards from the scaleHighLow and
-                  // scaleLowHigh values, which should be half a cut inwards (not exactly but in spirit), so we
-                  // divide by two, which is the same as multiplying the divisor by 2, which is the right shift below
-                  EBM_ASSERT(IntEbmType { 3 } <= countCuts);
-                  const size_t denominator = (cCutsLimited - size_t { 2 }) << 1;
-                  EBM_ASSERT(size_t { 0 } < denominator);
-                  const FloatEbmType movementFromEnds = scaleMin / static_cast<FloatEbmType>(denominator);
-                  // movementFromEnds can be +infinity if scaleMin is infinity. We can handle it.
-                  EBM_ASSERT(!std::isnan(movementFromEnds));
-                  EBM_ASSERT(FloatEbmType { 0 } <= movementFromEnds); // underflow is possible
-
-                  const FloatEbmType lowCutFullPrecisionMin = scaleLowHigh - movementFromEnds;
-                  // lowCutFullPrecisionMin can be -infinity if movementFromEnds is +infinity.  We can handle it.
-                  EBM_ASSERT(!std::isnan(lowCutFullPrecisionMin));
-                  EBM_ASSERT(lowCutFullPrecisionMin < std::numeric_limits<FloatEbmType>::max());
-                  // GetInterpretableEndpoint can accept -infinity, but it'll return -infinity in that case
-                  const FloatEbmType lowCutMin = GetInterpretableEndpoint(lowCutFullPrecisionMin, movementFromEnds);
-                  // lowCutMin can legally be -infinity and we handle this scenario below
-
-                  const FloatEbmType lowCutExisting = *cutsLowerBoundInclusiveOut;
-                  EBM_ASSERT(!std::isnan(lowCutExisting));
-                  EBM_ASSERT(!std::isinf(lowCutExisting));
-
-                  if(lowCutExisting < lowCutMin) {
-                     // lowCutMin can legally be -infinity, but then we wouldn't get here then
-                     EBM_ASSERT(!std::isnan(lowCutMin));
-                     EBM_ASSERT(!std::isinf(lowCutMin));
-                     *cutsLowerBoundInclusiveOut = lowCutMin;
-                  }
+      size_t cWorkers = GetCountWorkersMax();
+      cWorkers = cFeatures < cWorkers ? cFeatures : cWorkers;
+
+      const size_t cBytesPerSampleWorker = sizeof(FloatEbmType) + 
+         (k_cSamplesRadixSortMin <= cSamples ? sizeof(FloatEbmType) : size_t { 0 }) + sizeof(NeighbourJump);
+      // we always keep one worker even if it alone is over the budget, since one column at a time is what GenerateQuantileCuts needs 
+      // anyways.  A worker that fails to allocate its scratch leaves its features to the others
+      const size_t cWorkersMemory = IsMultiplyError(cSamples, cBytesPerSampleWorker) ? size_t { 1 } : 
+         k_cBytesQuantileCutsWorkersMax / (cSamples * cBytesPerSampleWorker);
+      if(cWorkersMemory < cWorkers) {
+         cWorkers = size_t { 0 } == cWorkersMemory ? size_t { 1 } : cWorkersMemory;
+      }
 
-                  const FloatEbmType highCutFullPrecisionMax = scaleHighLow + movementFromEnds;
-                  // highCutFullPrecisionMax can be +infinity if movementFromEnds is +infinity.  We can handle it.
-                  EBM_ASSERT(!std::isnan(highCutFullPrecisionMax));
-                  EBM_ASSERT(std::numeric_limits<FloatEbmType>::lowest() < highCutFullPrecisionMax);
-                  // GetInterpretableEndpoint can accept infinity, but it'll return infinity in that case
-                  const FloatEbmType highCutMax = GetInterpretableEndpoint(highCutFullPrecisionMax, movementFromEnds);
-                  // highCutMax can legally be +infinity and we handle this scenario below
-
-                  const FloatEbmType highCutExisting = *(pCutsLowerBoundInclusive - size_t { 1 });
-                  EBM_ASSERT(!std::isnan(highCutExisting));
-                  EBM_ASSERT(!std::isinf(highCutExisting));
-
-                  if(highCutMax < highCutExisting) {
-                     // highCutMax can legally be +infinity, but then we wouldn't get here then
-                     EBM_ASSERT(!std::isnan(highCutMax));
-                     EBM_ASSERT(!std::isinf(highCutMax));
-                     *(pCutsLowerBoundInclusive - size_t { 1 }) = highCutMax;
-                  }
-               }
-            }
+      QuantileCutsWork work;
+      work.m_cSamples = cSamples;
+      work.m_cFeatures = cFeatures;
+      work.m_aFeatureValues = featureValues;
+      work.m_bColumnMajor = EBM_FALSE != isColumnMajor;
+      work.m_aCountSamplesPerBinMin = countSamplesPerBinMin;
+      work.m_isHumanized = isHumanized;
+      work.m_aiCutsFirst = aiCutsFirst;
+      work.m_aCountCuts = countCutsInOut;
+      work.m_aCutsLowerBoundInclusive = cutsLowerBoundInclusiveOut;
+      work.m_aCountMissingValues = countMissingValuesOut;
+      work.m_aMinNonInfinityValue = minNonInfinityValueOut;
+      work.m_aCountNegativeInfinity = countNegativeInfinityOut;
+      work.m_aMaxNonInfinityValue = maxNonInfinityValueOut;
+      work.m_aCountPositiveInfinity = countPositiveInfinityOut;
+      work.m_iFeatureNext.store(size_t { 0 }, std::memory_order_relaxed);
+      for(size_t iWorker = 0; iWorker < cWorkers; ++iWorker) {
+         work.m_abError[iWorker] = false;
+      }
+
+      LOG_N(
+         TraceLevelVerbose,
+         "GenerateQuantileCutsBatch binning %zu features of %zu samples with %zu workers",
+         cFeatures,
+         cSamples,
+         cWorkers
+      );
+      ExecuteParallelWork(cWorkers, &GenerateQuantileCutsWorker, &work);
+
+      bool bError = work.m_iFeatureNext.load(std::memory_order_relaxed) < cFeatures;
+      for(size_t iWorker = 0; iWorker < cWorkers; ++iWorker) {
+         bError = bError || work.m_abError[iWorker];
+      }
+      if(bError && size_t { 1 } < cWorkers) {
+         // we checked the parameters above, so the workers only fail to allocate.  The other workers have released their memory, so one 
+         // worker on our thread may succeed where several in parallel did not.  The results are the same for any number of workers
+         LOG_0(TraceLevelWarning, "WARNING GenerateQuantileCutsBatch out of memory with several workers, so retrying with one");
+         for(size_t iFeature = 0; iFeature < cFeatures; ++iFeature) {
+            countCutsInOut[iFeature] = static_cast<IntEbmType>(aiCutsFirst[iFeature + size_t { 1 }] - aiCutsFirst[iFeature]);
          }
+         work.m_iFeatureNext.store(size_t { 0 }, std::memory_order_relaxed);
+         work.m_abError[0] = false;
+         ExecuteParallelWork(size_t { 1 }, &GenerateQuantileCutsWorker, &work);
+         bError = work.m_iFeatureNext.load(std::memory_order_relaxed) < cFeatures || work.m_abError[0];
+      }
+      if(bError) {
+         LOG_0(TraceLevelWarning, "WARNING GenerateQuantileCutsBatch out of memory");
+      }
+      ret = bError ? IntEbmType { 1 } : IntEbmType { 0 };
+   }
 
-         // this conversion is guaranteed to work since the number of cut points can't exceed the number our user
-         // specified, and that value came to us as an IntEbmType
-         countCutsRet = static_cast<IntEbmType>(cCutsRet);
-         EBM_ASSERT(countCutsRet <= countCuts);
+exit_with_log:;
 
-         free(pMem);
-         free(aFeatureValues);
+   free(aiCutsFirst);
 
-         ret = IntEbmType { 0 };
+   LOG_COUNTED_N(
+      &g_cLogExitGenerateQuantileCutsBatchParametersMessages,
+      TraceLevelInfo,
+      TraceLevelVerbose,
+      "Exited GenerateQuantileCutsBatch: "
+      "return=%" IntEbmTypePrintf
+      ,
+      ret
+   );
+
+   return ret;
+}
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION GenerateQuantileCutsFromSketch(
+   QuantileSketchHandle quantileSketchHandle,
+   IntEbmType countSamplesPerBinMin,
+   BoolEbmType isHumanized,
+   IntEbmType * countCutsInOut,
+   FloatEbmType * cutsLowerBoundInclusiveOut,
+   IntEbmType * countMissingValuesOut,
+   FloatEbmType * minNonInfinityValueOut,
+   IntEbmType * countNegativeInfinityOut,
+   FloatEbmType * maxNonInfinityValueOut,
+   IntEbmType * countPositiveInfinityOut
+) {
+   LOG_N(
+      TraceLevelInfo,
+      "Entered GenerateQuantileCutsFromSketch: "
+      "quantileSketchHandle=%p, "
+      "countSamplesPerBinMin=%" IntEbmTypePrintf ", "
+      "isHumanized=%s, "
+      "countCutsInOut=%p, "
+      "cutsLowerBoundInclusiveOut=%p, "
+      "countMissingValuesOut=%p, "
+      "minNonInfinityValueOut=%p, "
+      "countNegativeInfinityOut=%p, "
+      "maxNonInfinityValueOut=%p, "
+      "countPositiveInfinityOut=%p"
+      ,
+      static_cast<void *>(quantileSketchHandle),
+      countSamplesPerBinMin,
+      ObtainTruth(isHumanized),
+      static_cast<void *>(countCutsInOut),
+      static_cast<void *>(cutsLowerBoundInclusiveOut),
+      static_cast<void *>(countMissingValuesOut),
+      static_cast<void *>(minNonInfinityValueOut),
+      static_cast<void *>(countNegativeInfinityOut),
+      static_cast<void *>(maxNonInfinityValueOut),
+      static_cast<void *>(countPositiveInfinityOut)
+   );
+
+   const QuantileSketch * const pQuantileSketch = reinterpret_cast<const QuantileSketch *>(quantileSketchHandle);
+   if(UNLIKELY(nullptr == pQuantileSketch)) {
+      LOG_0(TraceLevelError, "ERROR GenerateQuantileCutsFromSketch quantileSketchHandle cannot be nullptr");
+      return IntEbmType { 1 };
+   }
+   if(UNLIKELY(nullptr == countCutsInOut)) {
+      LOG_0(TraceLevelError, "ERROR GenerateQuantileCutsFromSketch nullptr == countCutsInOut");
+      return IntEbmType { 1 };
+   }
+
+   const size_t cNonMissing = pQuantileSketch->GetCountNonMissing();
+   const size_t cMissing = pQuantileSketch->GetCountMissing();
+   if(UNLIKELY(IsAddError(cNonMissing, cMissing) || !IsNumberConvertable<IntEbmType>(cNonMissing + cMissing))) {
+      LOG_0(TraceLevelWarning, "WARNING GenerateQuantileCutsFromSketch the sketch holds more samples than an IntEbmType can count");
+      *countCutsInOut = IntEbmType { 0 };
+      return IntEbmType { 1 };
+   }
+
+   IntEbmType countCutsRet = IntEbmType { 0 };
+   IntEbmType ret = IntEbmType { 0 };
+   if(size_t { 0 } != cNonMissing) {
+      // we run the exact algorithm over evenly spaced quantiles of the sketch.  Each of those values stands in for
+      // cNonMissing / cValues samples, so the minimum bin size has to shrink by the same ratio
+      const size_t cValues = pQuantileSketch->GetCountRepresentativeValues();
+      EBM_ASSERT(size_t { 1 } <= cValues && cValues <= cNonMissing);
+      if(cValues != cNonMissing && IntEbmType { 0 } < countSamplesPerBinMin) {
+         const FloatEbmType scaled = std::round(static_cast<FloatEbmType>(countSamplesPerBinMin) * 
+            static_cast<FloatEbmType>(cValues) / static_cast<FloatEbmType>(cNonMissing));
+         countSamplesPerBinMin = scaled < FloatEbmType { 1 } ? IntEbmType { 1 } : static_cast<IntEbmType>(scaled);
       }
 
-   exit_with_log:;
+      FloatEbmType * const aValues = EbmMalloc<FloatEbmType>(cValues);
+      if(UNLIKELY(nullptr == aValues)) {
+         LOG_0(TraceLevelWarning, "WARNING GenerateQuantileCutsFromSketch nullptr == aValues");
+         *countCutsInOut = IntEbmType { 0 };
+         return IntEbmType { 1 };
+      }
+      if(UNLIKELY(pQuantileSketch->GetRepresentativeValues(cValues, aValues))) {
+         LOG_0(TraceLevelWarning, "WARNING GenerateQuantileCutsFromSketch pQuantileSketch->GetRepresentativeValues failed");
+         free(aValues);
+         *countCutsInOut = IntEbmType { 0 };
+         return IntEbmType { 1 };
+      }
 
-      EBM_ASSERT(nullptr != countCutsInOut);
-      *countCutsInOut = countCutsRet;
+      // the statistics that GenerateQuantileCutsInternal computes from the representative values are approximate, so we 
+      // throw them away below and report the exact ones that the sketch tracked
+      IntEbmType countMissingValuesIgnored;
+      FloatEbmType minNonInfinityValueIgnored;
+      IntEbmType countNegativeInfinityIgnored;
+      FloatEbmType maxNonInfinityValueIgnored;
+      IntEbmType countPositiveInfinityIgnored;
+
+      countCutsRet = *countCutsInOut;
+      // the representative values are already sorted, so there's nothing for the radix sort to win
+      ret = GenerateQuantileCutsInternal(
+         cValues,
+         aValues,
+         nullptr,
+         countSamplesPerBinMin,
+         isHumanized,
+         &countCutsRet,
+         cutsLowerBoundInclusiveOut,
+         &countMissingValuesIgnored,
+         &minNonInfinityValueIgnored,
+         &countNegativeInfinityIgnored,
+         &maxNonInfinityValueIgnored,
+         &countPositiveInfinityIgnored
+      );
+
+      free(aValues);
    }
+   *countCutsInOut = countCutsRet;
 
    if(LIKELY(nullptr != countMissingValuesOut)) {
-      *countMissingValuesOut = countMissingValuesRet;
+      *countMissingValuesOut = static_cast<IntEbmType>(cMissing);
    }
    if(LIKELY(nullptr != minNonInfinityValueOut)) {
-      *minNonInfinityValueOut = minNonInfinityValueRet;
+      *minNonInfinityValueOut = pQuantileSketch->GetMinNonInfinityValue();
    }
    if(LIKELY(nullptr != countNegativeInfinityOut)) {
-      *countNegativeInfinityOut = countNegativeInfinityRet;
+      *countNegativeInfinityOut = static_cast<IntEbmType>(pQuantileSketch->GetCountNegativeInfinity());
    }
    if(LIKELY(nullptr != maxNonInfinityValueOut)) {
-      *maxNonInfinityValueOut = maxNonInfinityValueRet;
+      *maxNonInfinityValueOut = pQuantileSketch->GetMaxNonInfinityValue();
    }
    if(LIKELY(nullptr != countPositiveInfinityOut)) {
-      *countPositiveInfinityOut = countPositiveInfinityRet;
+      *countPositiveInfinityOut = static_cast<IntEbmType>(pQuantileSketch->GetCountPositiveInfinity());
    }
 
-   LOG_COUNTED_N(
-      &g_cLogExitGenerateQuantileCutsParametersMessages,
+   LOG_N(
       TraceLevelInfo,
-      TraceLevelVerbose,
-      "Exited GenerateQuantileCuts: "
+      "Exited GenerateQuantileCutsFromSketch: "
       "countCuts=%" IntEbmTypePrintf ", "
-      "countMissingValues=%" IntEbmTypePrintf ", "
-      "minNonInfinityValue=%" FloatEbmTypePrintf ", "
-      "countNegativeInfinity=%" IntEbmTypePrintf ", "
-      "maxNonInfinityValue=%" FloatEbmTypePrintf ", "
-      "countPositiveInfinity=%" IntEbmTypePrintf ", "
       "return=%" IntEbmTypePrintf
       ,
       countCutsRet,
-      countMissingValuesRet,
-      minNonInfinityValueRet,
-      countNegativeInfinityRet,
-      maxNonInfinityValueRet,
-      countPositiveInfinityRet,
       ret
    );
 
@@ -6,12 +6,18 @@
 
 #include <stddef.h> // size_t, ptrdiff_t
 #include <limits> // std::numeric_limits
-#include <algorithm> // std::sort
 
 #include "ebm_native.h"
 #include "EbmInternal.h"
 #include "Logging.h" // EBM_ASSERT & LOG
 
+extern FloatEbmType SelectFeatureValue(
+   const size_t cSamples,
+   FloatEbmType * const aValues,
+   size_t iNth,
+   FloatEbmType * const aScratch
+) noexcept;
+
 extern size_t RemoveMissingValuesAndReplaceInfinities(
    size_t cSamples,
    FloatEbmType * const aValues,
@@ -26,6 +32,51 @@ extern FloatEbmType ArithmeticMean(
    const FloatEbmType high
 ) noexcept;
 
+// Winsorized binning only looks at a handful of positions in the sorted order of the values and at the nearest distinct
+// values on either side of them, so instead of sorting we use SelectFeatureValue for the positions and this function for
+// the neighbours.  It finds what a sorted array would hold just below and just above the run of values equal to val.
+// The loop has no early exits or data dependent branches, so the compiler can vectorize it.
+static void FindNeighbours(
+   const size_t cSamples,
+   const FloatEbmType * const aValues,
+   const FloatEbmType val,
+   size_t * const pcBelowOut,
+   FloatEbmType * const pBelowMaxOut,
+   size_t * const pcAboveOut,
+   FloatEbmType * const pAboveMinOut
+) noexcept {
+   EBM_ASSERT(size_t { 1 } <= cSamples);
+   EBM_ASSERT(nullptr != aValues);
+   EBM_ASSERT(!std::isnan(val));
+
+   size_t cBelow = size_t { 0 };
+   size_t cAbove = size_t { 0 };
+   FloatEbmType belowMax = std::numeric_limits<FloatEbmType>::lowest();
+   FloatEbmType aboveMin = std::numeric_limits<FloatEbmType>::max();
+
+   const FloatEbmType * pValue = aValues;
+   const FloatEbmType * const pValuesEnd = aValues + cSamples;
+   do {
+      const FloatEbmType cur = *pValue;
+      EBM_ASSERT(!std::isnan(cur));
+
+      cBelow += static_cast<size_t>(cur < val);
+      cAbove += static_cast<size_t>(val < cur);
+
+      const FloatEbmType below = cur < val ? cur : std::numeric_limits<FloatEbmType>::lowest();
+      belowMax = belowMax < below ? below : belowMax;
+      const FloatEbmType above = val < cur ? cur : std::numeric_limits<FloatEbmType>::max();
+      aboveMin = above < aboveMin ? above : aboveMin;
+
+      ++pValue;
+   } while(pValuesEnd != pValue);
+
+   *pcBelowOut = cBelow;
+   *pBelowMaxOut = belowMax;
+   *pcAboveOut = cAbove;
+   *pAboveMinOut = aboveMin;
+}
+
 // we don't care if an extra log message is outputted due to the non-atomic nature of the decrement to this value
 static int g_cLogEnterGenerateWinsorizedCutsParametersMessages = 25;
 static int g_cLogExitGenerateWinsorizedCutsParametersMessages = 25;
@@ -206,50 +257,49 @@ EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION GenerateW
             // uniform we just need to find a single cut between values and we can divide the space up between
             // uniform bins between those values.
 
-            std::sort(aFeatureValues, aFeatureValues + cSamples);
+            // Winsorized binning only depends on a few positions in the sorted order of the values and on the nearest
+            // distinct values around them, so we select those positions with SelectFeatureValue and find the neighbours
+            // with linear scans in FindNeighbours instead of sorting.  This gives the same cuts in O(N)
+
+            // the radix select needs a second buffer, but if we can't get one std::nth_element gives us the same result more slowly
+            FloatEbmType * const aScratch = k_cSamplesRadixSelectMin <= cSamples ? EbmMalloc<FloatEbmType>(cSamples) : nullptr;
 
             if(UNLIKELY(size_t { 1 } == cCuts)) {
                // if we're only given 1 cut, then we need do so something special since we can't have an upper and
                // lower cut from which to range between.  We want to find the best central cut and use that
 
-               const FloatEbmType minValue = aFeatureValues[0];
-               const FloatEbmType maxValue = aFeatureValues[cSamples - size_t { 1 }];
-
-#ifndef NDEBUG
-               // if all of the samples are positive infinity then minValue is max, otherwise if there are any
-               // negative infinities, then the min will be lowest.  Same for the max, but in reverse.
-               const FloatEbmType minValueCompare = UNLIKELY(cSamples == static_cast<size_t>(countPositiveInfinityRet)) ?
-                  std::numeric_limits<FloatEbmType>::max() :
-                  (UNPREDICTABLE(0 == countNegativeInfinityRet) ?
-                     minNonInfinityValueRet : std::numeric_limits<FloatEbmType>::lowest());
-               const FloatEbmType maxValueCompare = UNLIKELY(cSamples == static_cast<size_t>(countNegativeInfinityRet)) ?
-                  std::numeric_limits<FloatEbmType>::lowest() :
-                  (UNPREDICTABLE(0 == countPositiveInfinityRet) ?
-                     maxNonInfinityValueRet : std::numeric_limits<FloatEbmType>::max());
-
-               EBM_ASSERT(minValue == minValueCompare);
-               EBM_ASSERT(maxValue == maxValueCompare);
-#endif
+               const size_t iCenterHigh = cSamples >> 1;
+               const FloatEbmType centerVal = SelectFeatureValue(cSamples, aFeatureValues, iCenterHigh, aScratch);
+
+               size_t cBelow;
+               FloatEbmType belowMax;
+               size_t cAbove;
+               FloatEbmType aboveMin;
+               FindNeighbours(cSamples, aFeatureValues, centerVal, &cBelow, &belowMax, &cAbove, &aboveMin);
 
                // if this fails there are no transitions at all, so we can't have a cut
-               if(LIKELY(minValue != maxValue)) {
-                  const size_t iCenterHigh = cSamples >> 1;
-                  // put the low on the high side so that in our first loop we decrement it to it's actual position
-                  const FloatEbmType * pLow = &aFeatureValues[iCenterHigh];
-                  const FloatEbmType * pHigh = pLow - (size_t { 1 } & (cSamples - size_t { 1 }));
-
-                  FloatEbmType lowCur;
-                  FloatEbmType highCur;
-                  do {
-                     --pLow;
-                     ++pHigh;
-
-                     EBM_ASSERT(aFeatureValues <= pLow && pLow < aFeatureValues + cSamples);
-                     lowCur = *pLow;
-                     EBM_ASSERT(aFeatureValues <= pHigh && pHigh < aFeatureValues + cSamples);
-                     highCur = *pHigh;
-                     // since minValue != maxValue per above, we know there is a transition SOMEWHERE, which will exit us
-                  } while(LIKELY(lowCur == highCur));
+               if(LIKELY(size_t { 0 } != cBelow || size_t { 0 } != cAbove)) {
+                  // In sorted order we'd step outwards from the center one value at a time on both sides until the low
+                  // and high values differ.  The low side starts right below iCenterHigh.  The high side starts on
+                  // iCenterHigh if we have an even number of samples, or right above it if we have an odd number.
+                  // In sorted order the values equal to centerVal occupy [cBelow, cSamples - cAbove), so we can
+                  // count how many steps each side takes to leave that run, and whichever side leaves first (or both)
+                  // lands on its distinct neighbour
+                  const size_t iLowStart = iCenterHigh - size_t { 1 };
+                  const size_t iHighStart = iCenterHigh + (size_t { 1 } & cSamples);
+
+                  EBM_ASSERT(cBelow <= iCenterHigh);
+                  EBM_ASSERT(iCenterHigh < cSamples - cAbove);
+                  EBM_ASSERT(iHighStart <= cSamples - cAbove);
+                  const size_t cStepsLow = iLowStart + size_t { 1 } - cBelow;
+                  const size_t cStepsHigh = cSamples - cAbove - iHighStart;
+                  // a side that never leaves the run would walk off the end of the array, but the other side
+                  // always leaves first since there's at least one transition
+                  EBM_ASSERT(size_t { 0 } != cBelow || cStepsHigh < cStepsLow);
+                  EBM_ASSERT(size_t { 0 } != cAbove || cStepsLow < cStepsHigh);
+
+                  const FloatEbmType lowCur = cStepsLow <= cStepsHigh ? belowMax : centerVal;
+                  const FloatEbmType highCur = cStepsHigh <= cStepsLow ? aboveMin : centerVal;
                   EBM_ASSERT(lowCur < highCur);
 
                   // if both lowCur and highCur have changed, we'll get the average value between them, but that'll
@@ -270,18 +320,21 @@ EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION GenerateW
                const size_t iOuterBound = (cSamples - size_t { 1 }) / cBins;
                EBM_ASSERT(iOuterBound < cSamples);
 
-               // position ourselves at low-high and move inwards
-               const FloatEbmType * pLow = &aFeatureValues[iOuterBound];
-               // position ourselves at high-low and move inwards
-               const FloatEbmType * pHigh = &aFeatureValues[cSamples - iOuterBound - size_t { 1 }];
-
-               EBM_ASSERT(aFeatureValues <= pLow && pLow < aFeatureValues + cSamples);
-               EBM_ASSERT(aFeatureValues <= pHigh && pHigh < aFeatureValues + cSamples);
+               // the low-high position and the high-low position, which we'd move inwards from in sorted order
+               const size_t iLowOuter = iOuterBound;
+               const size_t iHighOuter = cSamples - iOuterBound - size_t { 1 };
+               // we have at least 3 bins, so iOuterBound is at most a third of the way in
+               EBM_ASSERT(iLowOuter < iHighOuter);
 
-               const FloatEbmType lowOuterVal = *pLow;
-               const FloatEbmType highOuterVal = *pHigh;
+               const FloatEbmType lowOuterVal = SelectFeatureValue(cSamples, aFeatureValues, iLowOuter, aScratch);
+               const FloatEbmType highOuterVal = SelectFeatureValue(cSamples, aFeatureValues, iHighOuter, aScratch);
                EBM_ASSERT(lowOuterVal <= highOuterVal);
 
+               size_t cBelow;
+               FloatEbmType belowMax;
+               size_t cAbove;
+               FloatEbmType aboveMin;
+
                if(UNLIKELY(lowOuterVal == highOuterVal)) {
                   // there are no transitions between our outer values.  We have just 1 single value between them
                   // one way to handle this would be to wrap the value on the low side with the exact value
@@ -290,70 +343,34 @@ EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION GenerateW
 
                   const FloatEbmType centerVal = lowOuterVal;
 
-                  const FloatEbmType minValue = aFeatureValues[0];
-                  const FloatEbmType maxValue = aFeatureValues[cSamples - size_t { 1 }];
-
-#ifndef NDEBUG
-                  // if all of the samples are positive infinity then minValue is max, otherwise if there are any
-                  // negative infinities, then the min will be lowest.  Same for the max, but in reverse.
-                  const FloatEbmType minValueCompare = UNLIKELY(cSamples == static_cast<size_t>(countPositiveInfinityRet)) ?
-                     std::numeric_limits<FloatEbmType>::max() :
-                     (UNPREDICTABLE(0 == countNegativeInfinityRet) ?
-                     minNonInfinityValueRet : std::numeric_limits<FloatEbmType>::lowest());
-                  const FloatEbmType maxValueCompare = UNLIKELY(cSamples == static_cast<size_t>(countNegativeInfinityRet)) ?
-                     std::numeric_limits<FloatEbmType>::lowest() :
-                     (UNPREDICTABLE(0 == countPositiveInfinityRet) ?
-                     maxNonInfinityValueRet : std::numeric_limits<FloatEbmType>::max());
-
-                  EBM_ASSERT(minValue == minValueCompare);
-                  EBM_ASSERT(maxValue == maxValueCompare);
-#endif // NDEBUG
+                  FindNeighbours(cSamples, aFeatureValues, centerVal, &cBelow, &belowMax, &cAbove, &aboveMin);
 
                   FloatEbmType * pCutsLowerBoundInclusive = cutsLowerBoundInclusiveOut;
-                  if(PREDICTABLE(minValue != centerVal)) {
+                  if(PREDICTABLE(size_t { 0 } != cBelow)) {
                      // there's a transition somewhere on the low side
                      EBM_ASSERT(std::numeric_limits<FloatEbmType>::lowest() < centerVal);
-                     EBM_ASSERT(minValue < centerVal);
+                     EBM_ASSERT(belowMax < centerVal);
 
-                     FloatEbmType valCur;
-                     do {
-                        --pLow;
-                        EBM_ASSERT(aFeatureValues <= pLow && pLow < aFeatureValues + cSamples);
-                        valCur = *pLow;
-                     } while(centerVal == valCur);
-                     EBM_ASSERT(valCur < centerVal);
-
-                     const FloatEbmType avg = ArithmeticMean(valCur, centerVal);
+                     const FloatEbmType avg = ArithmeticMean(belowMax, centerVal);
                      *pCutsLowerBoundInclusive = avg;
                      ++pCutsLowerBoundInclusive;
                      ++countCutsRet;
                   }
-                  if(PREDICTABLE(maxValue != centerVal)) {
+                  if(PREDICTABLE(size_t { 0 } != cAbove)) {
                      // there's a transition somewhere on the high side
                      EBM_ASSERT(centerVal < std::numeric_limits<FloatEbmType>::max());
-                     EBM_ASSERT(centerVal < maxValue);
-
-                     FloatEbmType valCur;
-                     do {
-                        ++pHigh;
-                        EBM_ASSERT(aFeatureValues <= pHigh && pHigh < aFeatureValues + cSamples);
-                        valCur = *pHigh;
-                     } while(centerVal == valCur);
-                     EBM_ASSERT(centerVal < valCur);
+                     EBM_ASSERT(centerVal < aboveMin);
 
-                     const FloatEbmType avg = ArithmeticMean(centerVal, valCur);
+                     const FloatEbmType avg = ArithmeticMean(centerVal, aboveMin);
                      *pCutsLowerBoundInclusive = avg;
                      ++countCutsRet;
                   }
                } else {
-                  // because lowVal != highVal, we know there's a transition that'll exit our loops somewhere in between
-
-                  FloatEbmType lowInnerVal;
-                  do {
-                     ++pLow;
-                     EBM_ASSERT(aFeatureValues <= pLow && pLow < aFeatureValues + cSamples);
-                     lowInnerVal = *pLow;
-                  } while(lowOuterVal == lowInnerVal);
+                  // because lowVal != highVal, we know there's a value above lowOuterVal
+
+                  FindNeighbours(cSamples, aFeatureValues, lowOuterVal, &cBelow, &belowMax, &cAbove, &aboveMin);
+                  EBM_ASSERT(size_t { 0 } != cAbove);
+                  const FloatEbmType lowInnerVal = aboveMin;
                   EBM_ASSERT(std::numeric_limits<FloatEbmType>::lowest() < lowInnerVal);
                   EBM_ASSERT(lowOuterVal < lowInnerVal);
                   EBM_ASSERT(lowInnerVal <= highOuterVal);
@@ -368,12 +385,9 @@ EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION GenerateW
                      *cutsLowerBoundInclusiveOut = avg;
                      countCutsRet = IntEbmType { 1 };
                   } else {
-                     FloatEbmType highInnerVal;
-                     do {
-                        --pHigh;
-                        EBM_ASSERT(aFeatureValues <= pHigh && pHigh < aFeatureValues + cSamples);
-                        highInnerVal = *pHigh;
-                     } while(highOuterVal == highInnerVal);
+                     FindNeighbours(cSamples, aFeatureValues, highOuterVal, &cBelow, &belowMax, &cAbove, &aboveMin);
+                     EBM_ASSERT(size_t { 0 } != cBelow);
+                     FloatEbmType highInnerVal = belowMax;
                      EBM_ASSERT(highInnerVal < std::numeric_limits<FloatEbmType>::max());
                      EBM_ASSERT(highInnerVal < highOuterVal);
                      EBM_ASSERT(lowInnerVal <= highInnerVal);
@@ -480,6 +494,7 @@ EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION GenerateW
                   }
                }
             }
+            free(aScratch);
          }
          free(aFeatureValues);
          ret = IntEbmType { 0 };
@@ -35,11 +35,6 @@ extern bool InitializeResiduals(
    FloatEbmType * pResidualError
 );
 
-INLINE_ALWAYS static size_t GetCountItemsBitPacked(const size_t cBits) {
-   EBM_ASSERT(size_t { 1 } <= cBits);
-   return k_cBitsForStorageType / cBits;
-}
-
 void Booster::DeleteSegmentedTensors(const size_t cFeatureGroups, SegmentedTensor ** const apSegmentedTensors) {
    LOG_0(TraceLevelInfo, "Entered DeleteSegmentedTensors");
 
@@ -101,6 +96,252 @@ SegmentedTensor ** Booster::InitializeSegmentedTensors(
    return apSegmentedTensors;
 }
 
+void Booster::FreeCoarseBins() {
+   LOG_0(TraceLevelInfo, "Entered Booster::FreeCoarseBins");
+
+   if(nullptr != m_aaiTensorBinsCoarse) {
+      EBM_ASSERT(0 < m_cFeatureGroups);
+      for(size_t i = 0; i < m_cFeatureGroups; ++i) {
+         free(m_aaiTensorBinsCoarse[i]);
+      }
+      free(m_aaiTensorBinsCoarse);
+      m_aaiTensorBinsCoarse = nullptr;
+   }
+   FeatureGroup::FreeFeatureGroups(m_cFeatureGroups, m_apFeatureGroupsCoarse);
+   m_apFeatureGroupsCoarse = nullptr;
+
+   free(m_acRoundsCoarseRemaining);
+   m_acRoundsCoarseRemaining = nullptr;
+   free(m_acBinsMergedCoarse);
+   m_acBinsMergedCoarse = nullptr;
+   free(m_aFeaturesCoarse);
+   m_aFeaturesCoarse = nullptr;
+
+   LOG_0(TraceLevelInfo, "Exited Booster::FreeCoarseBins");
+}
+
+bool Booster::InitializeCoarseBins(const size_t cRoundsCoarse, const size_t cBinsCoarseMax) {
+   LOG_0(TraceLevelInfo, "Entered Booster::InitializeCoarseBins");
+
+   EBM_ASSERT(size_t { 2 } <= cBinsCoarseMax);
+
+   FreeCoarseBins();
+
+   if(size_t { 0 } == cRoundsCoarse || size_t { 0 } == m_cFeatureGroups || size_t { 0 } == m_cFeatures) {
+      LOG_0(TraceLevelInfo, "Exited Booster::InitializeCoarseBins with nothing to coarsen");
+      return false;
+   }
+
+   m_aFeaturesCoarse = EbmMalloc<Feature>(m_cFeatures);
+   m_acBinsMergedCoarse = EbmMalloc<size_t>(m_cFeatures);
+   m_apFeatureGroupsCoarse = FeatureGroup::AllocateFeatureGroups(m_cFeatureGroups);
+   m_aaiTensorBinsCoarse = EbmMalloc<size_t *>(m_cFeatureGroups);
+   m_acRoundsCoarseRemaining = EbmMalloc<size_t>(m_cFeatureGroups);
+   if(nullptr == m_aFeaturesCoarse || nullptr == m_acBinsMergedCoarse || nullptr == m_apFeatureGroupsCoarse || 
+      nullptr == m_aaiTensorBinsCoarse || nullptr == m_acRoundsCoarseRemaining) 
+   {
+      LOG_0(TraceLevelWarning, "WARNING Booster::InitializeCoarseBins out of memory");
+      free(m_aaiTensorBinsCoarse);
+      m_aaiTensorBinsCoarse = nullptr;
+      FreeCoarseBins();
+      return true;
+   }
+   for(size_t i = 0; i < m_cFeatureGroups; ++i) {
+      m_aaiTensorBinsCoarse[i] = nullptr;
+      m_acRoundsCoarseRemaining[i] = size_t { 0 };
+   }
+
+   for(size_t iFeature = 0; iFeature < m_cFeatures; ++iFeature) {
+      const Feature * const pFeature = &m_aFeatures[iFeature];
+      const size_t cBins = pFeature->GetCountBins();
+      // categorical bins have no ordering, so merging neighbours would be meaningless
+      size_t cBinsMerged = 1;
+      if(!pFeature->GetIsCategorical() && cBinsCoarseMax < cBins) {
+         // every coarse bin holds the same number of fine bins except the last one, which can hold fewer.  This keeps 
+         // the translation from coarse cuts to fine cuts a simple multiplication
+         cBinsMerged = (cBins - 1) / cBinsCoarseMax + 1;
+      }
+      const size_t cBinsCoarse = size_t { 0 } == cBins ? size_t { 0 } : (cBins - 1) / cBinsMerged + 1;
+      EBM_ASSERT(cBinsCoarse <= cBins);
+      // a feature with 2 or more bins keeps 2 or more bins, so the significant dimensions don't change
+      EBM_ASSERT(cBins <= size_t { 1 } || size_t { 2 } <= cBinsCoarse);
+      m_aFeaturesCoarse[iFeature].Initialize(cBinsCoarse, iFeature, pFeature->GetIsCategorical());
+      m_acBinsMergedCoarse[iFeature] = cBinsMerged;
+   }
+
+   for(size_t iFeatureGroup = 0; iFeatureGroup < m_cFeatureGroups; ++iFeatureGroup) {
+      const FeatureGroup * const pFeatureGroup = m_apFeatureGroups[iFeatureGroup];
+      const size_t cFeaturesInGroup = pFeatureGroup->GetCountFeatures();
+      if(size_t { 0 } == pFeatureGroup->GetCountSignificantFeatures()) {
+         continue;
+      }
+
+      bool bCoarsened = false;
+      size_t cTensorBins = 1;
+      const FeatureGroupEntry * pFeatureGroupEntry = pFeatureGroup->GetFeatureGroupEntries();
+      const FeatureGroupEntry * const pFeatureGroupEntryEnd = pFeatureGroupEntry + cFeaturesInGroup;
+      do {
+         const Feature * const pFeature = pFeatureGroupEntry->m_pFeature;
+         if(size_t { 1 } != m_acBinsMergedCoarse[pFeature->GetIndexFeatureData()]) {
+            bCoarsened = true;
+         }
+         // we checked for overflow when we built the feature group
+         EBM_ASSERT(!IsMultiplyError(cTensorBins, pFeature->GetCountBins()));
+         cTensorBins *= pFeature->GetCountBins();
+         ++pFeatureGroupEntry;
+      } while(pFeatureGroupEntryEnd != pFeatureGroupEntry);
+      if(!bCoarsened) {
+         continue;
+      }
+
+      // the coarse feature group reads the same packed data as the fine one, so it keeps the same data index and packing
+      FeatureGroup * const pFeatureGroupCoarse = FeatureGroup::Allocate(cFeaturesInGroup, pFeatureGroup->GetIndexInputData());
+      size_t * const aiTensorBinsCoarse = EbmMalloc<size_t>(cTensorBins);
+      m_apFeatureGroupsCoarse[iFeatureGroup] = pFeatureGroupCoarse;
+      m_aaiTensorBinsCoarse[iFeatureGroup] = aiTensorBinsCoarse;
+      if(nullptr == pFeatureGroupCoarse || nullptr == aiTensorBinsCoarse) {
+         LOG_0(TraceLevelWarning, "WARNING Booster::InitializeCoarseBins out of memory");
+         FreeCoarseBins();
+         return true;
+      }
+      pFeatureGroupCoarse->SetCountItemsPerBitPackedDataUnit(pFeatureGroup->GetCountItemsPerBitPackedDataUnit());
+      pFeatureGroupCoarse->SetCountSignificantFeatures(pFeatureGroup->GetCountSignificantFeatures());
+      for(size_t iDimension = 0; iDimension < cFeaturesInGroup; ++iDimension) {
+         const size_t iFeature = pFeatureGroup->GetFeatureGroupEntries()[iDimension].m_pFeature->GetIndexFeatureData();
+         pFeatureGroupCoarse->GetFeatureGroupEntries()[iDimension].m_pFeature = &m_aFeaturesCoarse[iFeature];
+      }
+
+      // the first feature in the group occupies the lowest stride of the packed tensor index
+      for(size_t iTensorBin = 0; iTensorBin < cTensorBins; ++iTensorBin) {
+         size_t iTensorBinRemaining = iTensorBin;
+         size_t iTensorBinCoarse = 0;
+         size_t cTensorMultipleCoarse = 1;
+         pFeatureGroupEntry = pFeatureGroup->GetFeatureGroupEntries();
+         do {
+            const Feature * const pFeature = pFeatureGroupEntry->m_pFeature;
+            const size_t cBins = pFeature->GetCountBins();
+            const size_t iFeature = pFeature->GetIndexFeatureData();
+            const size_t iBin = iTensorBinRemaining % cBins;
+            iTensorBinRemaining /= cBins;
+            iTensorBinCoarse += iBin / m_acBinsMergedCoarse[iFeature] * cTensorMultipleCoarse;
+            cTensorMultipleCoarse *= m_aFeaturesCoarse[iFeature].GetCountBins();
+            ++pFeatureGroupEntry;
+         } while(pFeatureGroupEntryEnd != pFeatureGroupEntry);
+         aiTensorBinsCoarse[iTensorBin] = iTensorBinCoarse;
+      }
+
+      m_acRoundsCoarseRemaining[iFeatureGroup] = cRoundsCoarse;
+   }
+
+   LOG_0(TraceLevelInfo, "Exited Booster::InitializeCoarseBins");
+   return false;
+}
+
+void Booster::DecrementRoundsCoarse(const size_t iFeatureGroup) {
+   EBM_ASSERT(iFeatureGroup < m_cFeatureGroups);
+   if(nullptr != m_apFeatureGroupsCoarse && nullptr != m_apFeatureGroupsCoarse[iFeatureGroup]) {
+      EBM_ASSERT(size_t { 1 } <= m_acRoundsCoarseRemaining[iFeatureGroup]);
+      --m_acRoundsCoarseRemaining[iFeatureGroup];
+      if(size_t { 0 } == m_acRoundsCoarseRemaining[iFeatureGroup]) {
+         // this feature group moves to full resolution permanently, so we don't need the remapping anymore
+         LOG_0(TraceLevelInfo, "Booster::DecrementRoundsCoarse switching feature group to full resolution");
+         FeatureGroup::Free(m_apFeatureGroupsCoarse[iFeatureGroup]);
+         m_apFeatureGroupsCoarse[iFeatureGroup] = nullptr;
+         free(m_aaiTensorBinsCoarse[iFeatureGroup]);
+         m_aaiTensorBinsCoarse[iFeatureGroup] = nullptr;
+      }
+   }
+}
+
+bool Booster::InitializeSchedule(const FloatEbmType gainThreshold, const size_t cRoundsSkipMax) {
+   LOG_0(TraceLevelInfo, "Entered Booster::InitializeSchedule");
+
+   free(m_acRoundsSkipSchedule);
+   m_acRoundsSkipSchedule = nullptr;
+   free(m_aiRoundScheduleNext);
+   m_aiRoundScheduleNext = nullptr;
+   m_gainScheduleThreshold = gainThreshold;
+   m_cRoundsSkipScheduleMax = size_t { 0 };
+   m_iRoundSchedule = size_t { 0 };
+
+   if(size_t { 0 } == cRoundsSkipMax || size_t { 0 } == m_cFeatureGroups) {
+      LOG_0(TraceLevelInfo, "Exited Booster::InitializeSchedule with no schedule");
+      return false;
+   }
+
+   m_acRoundsSkipSchedule = EbmMalloc<size_t>(m_cFeatureGroups);
+   m_aiRoundScheduleNext = EbmMalloc<size_t>(m_cFeatureGroups);
+   if(nullptr == m_acRoundsSkipSchedule || nullptr == m_aiRoundScheduleNext) {
+      LOG_0(TraceLevelWarning, "WARNING Booster::InitializeSchedule out of memory");
+      free(m_acRoundsSkipSchedule);
+      m_acRoundsSkipSchedule = nullptr;
+      free(m_aiRoundScheduleNext);
+      m_aiRoundScheduleNext = nullptr;
+      return true;
+   }
+   for(size_t i = 0; i < m_cFeatureGroups; ++i) {
+      m_acRoundsSkipSchedule[i] = size_t { 0 };
+      m_aiRoundScheduleNext[i] = size_t { 0 };
+   }
+   m_cRoundsSkipScheduleMax = cRoundsSkipMax;
+
+   LOG_0(TraceLevelInfo, "Exited Booster::InitializeSchedule");
+   return false;
+}
+
+size_t Booster::GetScheduledFeatureGroups(IntEbmType * const aFeatureGroupIndexesOut) const {
+   size_t cScheduled = 0;
+   for(size_t iFeatureGroup = 0; iFeatureGroup < m_cFeatureGroups; ++iFeatureGroup) {
+      if(size_t { 0 } == m_cRoundsSkipScheduleMax || m_aiRoundScheduleNext[iFeatureGroup] <= m_iRoundSchedule) {
+         aFeatureGroupIndexesOut[cScheduled] = static_cast<IntEbmType>(iFeatureGroup);
+         ++cScheduled;
+      }
+   }
+   return cScheduled;
+}
+
+void Booster::AdvanceSchedule() {
+   if(size_t { 0 } == m_cRoundsSkipScheduleMax) {
+      return;
+   }
+   // a round where every feature group sits out changes nothing, so we jump straight to the next round that boosts something.  
+   // Otherwise our caller would count empty rounds against its early stopping patience and its limit on rounds
+   size_t iRoundNext = std::numeric_limits<size_t>::max();
+   for(size_t iFeatureGroup = 0; iFeatureGroup < m_cFeatureGroups; ++iFeatureGroup) {
+      const size_t iRoundScheduleNext = m_aiRoundScheduleNext[iFeatureGroup];
+      iRoundNext = iRoundScheduleNext < iRoundNext ? iRoundScheduleNext : iRoundNext;
+   }
+   if(std::numeric_limits<size_t>::max() != m_iRoundSchedule) {
+      ++m_iRoundSchedule;
+   }
+   m_iRoundSchedule = m_iRoundSchedule < iRoundNext ? iRoundNext : m_iRoundSchedule;
+}
+
+void Booster::UpdateSchedule(const size_t iFeatureGroup, const FloatEbmType gain) {
+   EBM_ASSERT(iFeatureGroup < m_cFeatureGroups);
+   if(size_t { 0 } == m_cRoundsSkipScheduleMax) {
+      return;
+   }
+   // a NaN gain means we don't know the gain, like when our caller provides the update, so leave the schedule alone
+   if(std::isnan(gain)) {
+      return;
+   }
+   size_t cRoundsSkip = 0;
+   if(gain < m_gainScheduleThreshold) {
+      cRoundsSkip = m_acRoundsSkipSchedule[iFeatureGroup];
+      cRoundsSkip = size_t { 0 } == cRoundsSkip ? size_t { 1 } : cRoundsSkip << 1;
+      if(m_cRoundsSkipScheduleMax < cRoundsSkip || cRoundsSkip < m_acRoundsSkipSchedule[iFeatureGroup]) {
+         // the second condition catches the shift overflowing, although we'd need to have been at the max for that
+         cRoundsSkip = m_cRoundsSkipScheduleMax;
+      }
+   }
+   m_acRoundsSkipSchedule[iFeatureGroup] = cRoundsSkip;
+   // the update was applied in round m_iRoundSchedule, so skipping starts with the round after it
+   const size_t iRoundAfter = std::numeric_limits<size_t>::max() == m_iRoundSchedule ? m_iRoundSchedule : m_iRoundSchedule + 1;
+   m_aiRoundScheduleNext[iFeatureGroup] = IsAddError(iRoundAfter, cRoundsSkip) ? 
+      std::numeric_limits<size_t>::max() : iRoundAfter + cRoundsSkip;
+}
+
 void Booster::Free(Booster * const pBooster) {
    LOG_0(TraceLevelInfo, "Entered Booster::Free");
    if(nullptr != pBooster) {
@@ -109,6 +350,9 @@ void Booster::Free(Booster * const pBooster) {
 
       SamplingSet::FreeSamplingSets(pBooster->m_cSamplingSets, pBooster->m_apSamplingSets);
 
+      pBooster->FreeCoarseBins();
+      free(pBooster->m_acRoundsSkipSchedule);
+      free(pBooster->m_aiRoundScheduleNext);
       FeatureGroup::FreeFeatureGroups(pBooster->m_cFeatureGroups, pBooster->m_apFeatureGroups);
 
       free(pBooster->m_aFeatures);
@@ -1020,6 +1264,164 @@ EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION GetCurren
    return IntEbmType { 0 };
 }
 
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION SetCoarseBinSchedule(
+   BoosterHandle boosterHandle,
+   IntEbmType countRoundsCoarse,
+   IntEbmType countBinsCoarseMax
+) {
+   LOG_N(
+      TraceLevelInfo,
+      "Entered SetCoarseBinSchedule: "
+      "boosterHandle=%p, "
+      "countRoundsCoarse=%" IntEbmTypePrintf ", "
+      "countBinsCoarseMax=%" IntEbmTypePrintf
+      ,
+      static_cast<void *>(boosterHandle),
+      countRoundsCoarse,
+      countBinsCoarseMax
+   );
+
+   Booster * pBooster = reinterpret_cast<Booster *>(boosterHandle);
+   if(nullptr == pBooster) {
+      LOG_0(TraceLevelError, "ERROR SetCoarseBinSchedule boosterHandle cannot be nullptr");
+      return IntEbmType { 1 };
+   }
+   if(countRoundsCoarse < 0) {
+      LOG_0(TraceLevelError, "ERROR SetCoarseBinSchedule countRoundsCoarse must be positive");
+      return IntEbmType { 1 };
+   }
+   if(countBinsCoarseMax < 2) {
+      LOG_0(TraceLevelError, "ERROR SetCoarseBinSchedule countBinsCoarseMax must be 2 or more");
+      return IntEbmType { 1 };
+   }
+   // rounds above what size_t can hold would never run out, so clip them.  Same for the bin count which can't exceed memory
+   const size_t cRoundsCoarse = IsNumberConvertable<size_t>(countRoundsCoarse) ? 
+      static_cast<size_t>(countRoundsCoarse) : std::numeric_limits<size_t>::max();
+   const size_t cBinsCoarseMax = IsNumberConvertable<size_t>(countBinsCoarseMax) ?
+      static_cast<size_t>(countBinsCoarseMax) : std::numeric_limits<size_t>::max();
+
+   if(pBooster->InitializeCoarseBins(cRoundsCoarse, cBinsCoarseMax)) {
+      LOG_0(TraceLevelWarning, "WARNING SetCoarseBinSchedule pBooster->InitializeCoarseBins failed");
+      return IntEbmType { 1 };
+   }
+
+   LOG_0(TraceLevelInfo, "Exited SetCoarseBinSchedule");
+   return IntEbmType { 0 };
+}
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION SetFeatureGroupSchedule(
+   BoosterHandle boosterHandle,
+   FloatEbmType gainThreshold,
+   IntEbmType countRoundsSkipMax
+) {
+   LOG_N(
+      TraceLevelInfo,
+      "Entered SetFeatureGroupSchedule: "
+      "boosterHandle=%p, "
+      "gainThreshold=%" FloatEbmTypePrintf ", "
+      "countRoundsSkipMax=%" IntEbmTypePrintf
+      ,
+      static_cast<void *>(boosterHandle),
+      gainThreshold,
+      countRoundsSkipMax
+   );
+
+   Booster * pBooster = reinterpret_cast<Booster *>(boosterHandle);
+   if(nullptr == pBooster) {
+      LOG_0(TraceLevelError, "ERROR SetFeatureGroupSchedule boosterHandle cannot be nullptr");
+      return IntEbmType { 1 };
+   }
+   if(std::isnan(gainThreshold)) {
+      LOG_0(TraceLevelError, "ERROR SetFeatureGroupSchedule gainThreshold cannot be NaN");
+      return IntEbmType { 1 };
+   }
+   if(countRoundsSkipMax < 0) {
+      LOG_0(TraceLevelError, "ERROR SetFeatureGroupSchedule countRoundsSkipMax must be positive");
+      return IntEbmType { 1 };
+   }
+   const size_t cRoundsSkipMax = IsNumberConvertable<size_t>(countRoundsSkipMax) ?
+      static_cast<size_t>(countRoundsSkipMax) : std::numeric_limits<size_t>::max();
+
+   if(pBooster->InitializeSchedule(gainThreshold, cRoundsSkipMax)) {
+      LOG_0(TraceLevelWarning, "WARNING SetFeatureGroupSchedule pBooster->InitializeSchedule failed");
+      return IntEbmType { 1 };
+   }
+
+   LOG_0(TraceLevelInfo, "Exited SetFeatureGroupSchedule");
+   return IntEbmType { 0 };
+}
+
+// gets the feature groups scheduled for the current round and leaves the schedule alone, so calling this again gives the same answer.  
+// Our caller moves on to the next round with AdvanceFeatureGroupSchedule once it has applied the updates for this one
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION GetScheduledFeatureGroups(
+   BoosterHandle boosterHandle,
+   IntEbmType * countFeatureGroupsOut,
+   IntEbmType * featureGroupIndexesOut
+) {
+   LOG_N(
+      TraceLevelVerbose,
+      "Entered GetScheduledFeatureGroups: "
+      "boosterHandle=%p, "
+      "countFeatureGroupsOut=%p, "
+      "featureGroupIndexesOut=%p"
+      ,
+      static_cast<void *>(boosterHandle),
+      static_cast<void *>(countFeatureGroupsOut),
+      static_cast<void *>(featureGroupIndexesOut)
+   );
+
+   if(nullptr == countFeatureGroupsOut) {
+      LOG_0(TraceLevelError, "ERROR GetScheduledFeatureGroups countFeatureGroupsOut cannot be nullptr");
+      return IntEbmType { 1 };
+   }
+   *countFeatureGroupsOut = IntEbmType { 0 };
+
+   Booster * pBooster = reinterpret_cast<Booster *>(boosterHandle);
+   if(nullptr == pBooster) {
+      LOG_0(TraceLevelError, "ERROR GetScheduledFeatureGroups boosterHandle cannot be nullptr");
+      return IntEbmType { 1 };
+   }
+   if(size_t { 0 } == pBooster->GetCountFeatureGroups()) {
+      LOG_0(TraceLevelVerbose, "Exited GetScheduledFeatureGroups with no feature groups");
+      return IntEbmType { 0 };
+   }
+   if(nullptr == featureGroupIndexesOut) {
+      LOG_0(TraceLevelError, "ERROR GetScheduledFeatureGroups featureGroupIndexesOut cannot be nullptr");
+      return IntEbmType { 1 };
+   }
+
+   const size_t cScheduled = pBooster->GetScheduledFeatureGroups(featureGroupIndexesOut);
+   // we would have failed to allocate the feature groups if their count couldn't be represented
+   EBM_ASSERT(IsNumberConvertable<IntEbmType>(cScheduled));
+   *countFeatureGroupsOut = static_cast<IntEbmType>(cScheduled);
+
+   LOG_0(TraceLevelVerbose, "Exited GetScheduledFeatureGroups");
+   return IntEbmType { 0 };
+}
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION AdvanceFeatureGroupSchedule(
+   BoosterHandle boosterHandle
+) {
+   LOG_N(
+      TraceLevelVerbose,
+      "Entered AdvanceFeatureGroupSchedule: "
+      "boosterHandle=%p"
+      ,
+      static_cast<void *>(boosterHandle)
+   );
+
+   Booster * pBooster = reinterpret_cast<Booster *>(boosterHandle);
+   if(nullptr == pBooster) {
+      LOG_0(TraceLevelError, "ERROR AdvanceFeatureGroupSchedule boosterHandle cannot be nullptr");
+      return IntEbmType { 1 };
+   }
+
+   pBooster->AdvanceSchedule();
+
+   LOG_0(TraceLevelVerbose, "Exited AdvanceFeatureGroupSchedule");
+   return IntEbmType { 0 };
+}
+
 EBM_NATIVE_IMPORT_EXPORT_BODY void EBM_NATIVE_CALLING_CONVENTION FreeBooster(
    BoosterHandle boosterHandle
 ) {
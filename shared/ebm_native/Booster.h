@@ -48,6 +48,26 @@ class Booster final {
 
    RandomStream m_randomStream;
 
+   // coarse-to-fine bin schedule.  For the first rounds of each feature group we merge runs of adjacent ordinal bins 
+   // together and boost on the merged view.  The data isn't repacked.  Instead we remap each fine tensor bin index to its
+   // coarse tensor bin index while building the histograms.  m_apFeatureGroupsCoarse[iFeatureGroup] is nullptr if
+   // the feature group has no coarsened dimensions or once it has used up its coarse rounds
+   Feature * m_aFeaturesCoarse;
+   size_t * m_acBinsMergedCoarse;
+   FeatureGroup ** m_apFeatureGroupsCoarse;
+   size_t ** m_aaiTensorBinsCoarse;
+   size_t * m_acRoundsCoarseRemaining;
+
+   // gain driven feature group schedule.  A feature group whose gain falls below m_gainScheduleThreshold sits out for 
+   // 1, 2, 4, ... rounds, up to m_cRoundsSkipScheduleMax, after which it gets re-checked.  Any round with enough gain 
+   // puts it back into every round.  m_cRoundsSkipScheduleMax of zero means there is no schedule.  m_iRoundSchedule is the 
+   // round our caller is boosting, and it only moves when our caller calls AdvanceSchedule
+   FloatEbmType m_gainScheduleThreshold;
+   size_t m_cRoundsSkipScheduleMax;
+   size_t m_iRoundSchedule;
+   size_t * m_acRoundsSkipSchedule;
+   size_t * m_aiRoundScheduleNext;
+
    static void DeleteSegmentedTensors(const size_t cFeatureGroups, SegmentedTensor ** const apSegmentedTensors);
 
    static SegmentedTensor ** InitializeSegmentedTensors(
@@ -84,6 +104,18 @@ public:
       m_bestModelMetric = FloatEbmType { 0 };
 
       m_cBytesArrayEquivalentSplitMax = size_t { 0 };
+
+      m_aFeaturesCoarse = nullptr;
+      m_acBinsMergedCoarse = nullptr;
+      m_apFeatureGroupsCoarse = nullptr;
+      m_aaiTensorBinsCoarse = nullptr;
+      m_acRoundsCoarseRemaining = nullptr;
+
+      m_gainScheduleThreshold = FloatEbmType { 0 };
+      m_cRoundsSkipScheduleMax = size_t { 0 };
+      m_iRoundSchedule = size_t { 0 };
+      m_acRoundsSkipSchedule = nullptr;
+      m_aiRoundScheduleNext = nullptr;
    }
 
    INLINE_ALWAYS ptrdiff_t GetRuntimeLearningTypeOrCountTargetClasses() const {
@@ -94,6 +126,14 @@ public:
       return m_cBytesArrayEquivalentSplitMax;
    }
 
+   INLINE_ALWAYS size_t GetCountFeatures() const {
+      return m_cFeatures;
+   }
+
+   INLINE_ALWAYS const Feature * GetFeatures() const {
+      return m_aFeatures;
+   }
+
    INLINE_ALWAYS size_t GetCountFeatureGroups() const {
       return m_cFeatureGroups;
    }
@@ -138,6 +178,32 @@ public:
       return &m_randomStream;
    }
 
+   INLINE_ALWAYS const FeatureGroup * GetFeatureGroupCoarse(const size_t iFeatureGroup) const {
+      EBM_ASSERT(iFeatureGroup < m_cFeatureGroups);
+      return nullptr == m_apFeatureGroupsCoarse ? nullptr : m_apFeatureGroupsCoarse[iFeatureGroup];
+   }
+
+   INLINE_ALWAYS const size_t * GetTensorBinsCoarse(const size_t iFeatureGroup) const {
+      EBM_ASSERT(iFeatureGroup < m_cFeatureGroups);
+      EBM_ASSERT(nullptr != m_aaiTensorBinsCoarse);
+      return m_aaiTensorBinsCoarse[iFeatureGroup];
+   }
+
+   INLINE_ALWAYS size_t GetCountBinsMergedCoarse(const size_t iFeature) const {
+      EBM_ASSERT(iFeature < m_cFeatures);
+      EBM_ASSERT(nullptr != m_acBinsMergedCoarse);
+      return m_acBinsMergedCoarse[iFeature];
+   }
+
+   void FreeCoarseBins();
+   bool InitializeCoarseBins(const size_t cRoundsCoarse, const size_t cBinsCoarseMax);
+   void DecrementRoundsCoarse(const size_t iFeatureGroup);
+
+   bool InitializeSchedule(const FloatEbmType gainThreshold, const size_t cRoundsSkipMax);
+   size_t GetScheduledFeatureGroups(IntEbmType * const aFeatureGroupIndexesOut) const;
+   void AdvanceSchedule();
+   void UpdateSchedule(const size_t iFeatureGroup, const FloatEbmType gain);
+
    static void Free(Booster * const pBooster);
 
    static Booster * Allocate(
@@ -6,18 +6,27 @@
 
 #include <stddef.h> // size_t, ptrdiff_t
 #include <limits> // numeric_limits
+#include <atomic>
+#include <algorithm> // std::partial_sort, std::sort, std::unique, std::swap, std::push_heap, std::pop_heap
+#include <functional> // std::greater
+#include <string.h> // memcpy
 
 #include "ebm_native.h"
 #include "EbmInternal.h"
 #include "Logging.h" // EBM_ASSERT & LOG
+#include "EbmStatisticUtils.h"
 // feature includes
+#include "RandomStream.h"
 #include "FeatureAtomic.h"
 #include "FeatureGroup.h"
 // dataset depends on features
 #include "DataSetInteraction.h"
 #include "ThreadStateInteraction.h"
+#include "HistogramTargetEntry.h"
+#include "HistogramBucket.h"
 
 #include "InteractionDetector.h"
+#include "ParallelWork.h"
 
 #include "TensorTotalsSum.h"
 
@@ -30,6 +39,16 @@ extern void BinInteraction(
 #endif // NDEBUG
 );
 
+extern void BinInteractionShared(
+   InteractionDetector * const pInteractionDetector,
+   const size_t cPairs,
+   const FeatureGroup * const * const apFeatureGroups,
+   HistogramBucketBase * const * const apHistogramBuckets
+#ifndef NDEBUG
+   , const unsigned char * const aHistogramBucketsEndDebug
+#endif // NDEBUG
+);
+
 extern FloatEbmType FindBestInteractionGainPairs(
    InteractionDetector * const pInteractionDetector,
    const FeatureGroup * const pFeatureGroup,
@@ -42,22 +61,23 @@ extern FloatEbmType FindBestInteractionGainPairs(
 #endif // NDEBUG
 );
 
-static bool CalculateInteractionScoreInternal(
-   ThreadStateInteraction * const pThreadStateInteraction,
+extern FloatEbmType FindBestInteractionGainTriples(
    InteractionDetector * const pInteractionDetector,
    const FeatureGroup * const pFeatureGroup,
    const size_t cSamplesRequiredForChildSplitMin,
-   FloatEbmType * const pInteractionScoreReturn
-) {
-   // TODO : we NEVER use the denominator term in HistogramBucketVectorEntry when calculating interaction scores, but we're spending time calculating 
-   // it, and it's taking up precious memory.  We should eliminate the denominator term HERE in our datastructures OR we should think whether we can 
-   // use the denominator as part of the gain function!!!
-
-   const ptrdiff_t runtimeLearningTypeOrCountTargetClasses = pInteractionDetector->GetRuntimeLearningTypeOrCountTargetClasses();
-   const bool bClassification = IsClassification(runtimeLearningTypeOrCountTargetClasses);
-
-   LOG_0(TraceLevelVerbose, "Entered CalculateInteractionScoreInternal");
+   const HistogramBucketBase * const aHistogramBuckets
+#ifndef NDEBUG
+   , const unsigned char * const aHistogramBucketsEndDebug
+#endif // NDEBUG
+);
 
+// returns the number of buckets in the main tensor space and the total including the auxillary buckets that we use to build the fast totals 
+// and to sweep the cuts
+static bool GetInteractionBucketCounts(
+   const FeatureGroup * const pFeatureGroup,
+   size_t * const pcTotalBucketsMainSpaceOut,
+   size_t * const pcTotalBucketsOut
+) {
    // situations with 0 dimensions should have been filtered out before this function was called (but still inside the C++)
    EBM_ASSERT(1 <= pFeatureGroup->GetCountFeatures());
    EBM_ASSERT(1 <= pFeatureGroup->GetCountSignificantFeatures());
@@ -84,7 +104,7 @@ static bool CalculateInteractionScoreInternal(
          // unlike in the boosting code where we check at allocation time if the tensor created overflows on multiplication
          // we don't know what group of features our caller will give us for calculating the interaction scores,
          // so we need to check if our caller gave us a tensor that overflows multiplication
-         LOG_0(TraceLevelWarning, "WARNING CalculateInteractionScoreInternal IsMultiplyError(cTotalBucketsMainSpace, cBins)");
+         LOG_0(TraceLevelWarning, "WARNING GetInteractionBucketCounts IsMultiplyError(cTotalBucketsMainSpace, cBins)");
          return true;
       }
       cTotalBucketsMainSpace *= cBins;
@@ -98,66 +118,34 @@ static bool CalculateInteractionScoreInternal(
    const size_t cAuxillaryBuckets =
       cAuxillaryBucketsForBuildFastTotals < cAuxillaryBucketsForSplitting ? cAuxillaryBucketsForSplitting : cAuxillaryBucketsForBuildFastTotals;
    if(IsAddError(cTotalBucketsMainSpace, cAuxillaryBuckets)) {
-      LOG_0(TraceLevelWarning, "WARNING CalculateInteractionScoreInternal IsAddError(cTotalBucketsMainSpace, cAuxillaryBuckets)");
+      LOG_0(TraceLevelWarning, "WARNING GetInteractionBucketCounts IsAddError(cTotalBucketsMainSpace, cAuxillaryBuckets)");
       return true;
    }
-   const size_t cTotalBuckets = cTotalBucketsMainSpace + cAuxillaryBuckets;
+   *pcTotalBucketsMainSpaceOut = cTotalBucketsMainSpace;
+   *pcTotalBucketsOut = cTotalBucketsMainSpace + cAuxillaryBuckets;
+   return false;
+}
 
+// takes the binned histogram for one feature group and turns it into the interaction score
+static void FindInteractionScore(
+   InteractionDetector * const pInteractionDetector,
+   const FeatureGroup * const pFeatureGroup,
+   const size_t cSamplesRequiredForChildSplitMin,
+   const size_t cTotalBucketsMainSpace,
+   FloatEbmType * const pInteractionScoreReturn,
+   HistogramBucketBase * const aHistogramBuckets
+#ifndef NDEBUG
+   , const unsigned char * const aHistogramBucketsEndDebug
+#endif // NDEBUG
+) {
+   const ptrdiff_t runtimeLearningTypeOrCountTargetClasses = pInteractionDetector->GetRuntimeLearningTypeOrCountTargetClasses();
    const size_t cVectorLength = GetVectorLength(runtimeLearningTypeOrCountTargetClasses);
-
-   if(GetHistogramBucketSizeOverflow(bClassification, cVectorLength)) {
-      LOG_0(
-         TraceLevelWarning,
-         "WARNING CalculateInteractionScoreInternal GetHistogramBucketSizeOverflow<bClassification>(cVectorLength)"
-      );
-      return true;
-   }
-   const size_t cBytesPerHistogramBucket = GetHistogramBucketSize(bClassification, cVectorLength);
-   if(IsMultiplyError(cTotalBuckets, cBytesPerHistogramBucket)) {
-      LOG_0(TraceLevelWarning, "WARNING CalculateInteractionScoreInternal IsMultiplyError(cTotalBuckets, cBytesPerHistogramBucket)");
-      return true;
-   }
-   const size_t cBytesBuffer = cTotalBuckets * cBytesPerHistogramBucket;
-
-   // this doesn't need to be freed since it's tracked and re-used by the class ThreadStateInteraction
-   HistogramBucketBase * const aHistogramBuckets = pThreadStateInteraction->GetHistogramBucketBase(cBytesBuffer);
-   if(UNLIKELY(nullptr == aHistogramBuckets)) {
-      LOG_0(TraceLevelWarning, "WARNING CalculateInteractionScoreInternal nullptr == aHistogramBuckets");
-      return true;
-   }
-
-   if(bClassification) {
-      HistogramBucket<true> * const aHistogramBucketsLocal = aHistogramBuckets->GetHistogramBucket<true>();
-      for(size_t i = 0; i < cTotalBuckets; ++i) {
-         HistogramBucket<true> * const pHistogramBucket =
-            GetHistogramBucketByIndex(cBytesPerHistogramBucket, aHistogramBucketsLocal, i);
-         pHistogramBucket->Zero(cVectorLength);
-      }
-   } else {
-      HistogramBucket<false> * const aHistogramBucketsLocal = aHistogramBuckets->GetHistogramBucket<false>();
-      for(size_t i = 0; i < cTotalBuckets; ++i) {
-         HistogramBucket<false> * const pHistogramBucket =
-            GetHistogramBucketByIndex(cBytesPerHistogramBucket, aHistogramBucketsLocal, i);
-         pHistogramBucket->Zero(cVectorLength);
-      }
-   }
+   EBM_ASSERT(!GetHistogramBucketSizeOverflow(false, cVectorLength)); // we're accessing allocated memory
+   const size_t cBytesPerHistogramBucket = GetHistogramBucketSize(false, cVectorLength);
 
    HistogramBucketBase * pAuxiliaryBucketZone =
       GetHistogramBucketByIndex(cBytesPerHistogramBucket, aHistogramBuckets, cTotalBucketsMainSpace);
 
-#ifndef NDEBUG
-   const unsigned char * const aHistogramBucketsEndDebug = reinterpret_cast<unsigned char *>(aHistogramBuckets) + cBytesBuffer;
-#endif // NDEBUG
-
-   BinInteraction(
-      pInteractionDetector,
-      pFeatureGroup,
-      aHistogramBuckets
-#ifndef NDEBUG
-      , aHistogramBucketsEndDebug
-#endif // NDEBUG
-   );
-
 #ifndef NDEBUG
    // make a copy of the original binned buckets for debugging purposes
    HistogramBucketBase * const aHistogramBucketsDebugCopy =
@@ -169,7 +157,7 @@ static bool CalculateInteractionScoreInternal(
    }
 #endif // NDEBUG
 
-   TensorTotalsBuild(
+   TensorTotalsBuildInteraction(
       runtimeLearningTypeOrCountTargetClasses,
       pFeatureGroup,
       pAuxiliaryBucketZone,
@@ -180,28 +168,42 @@ static bool CalculateInteractionScoreInternal(
 #endif // NDEBUG
    );
 
-   if(2 == pFeatureGroup->GetCountSignificantFeatures()) {
-      LOG_0(TraceLevelVerbose, "CalculateInteractionScoreInternal Starting bin sweep loop");
+   const size_t cDimensions = pFeatureGroup->GetCountSignificantFeatures();
+   if(2 == cDimensions || 3 == cDimensions) {
+      LOG_0(TraceLevelVerbose, "FindInteractionScore Starting bin sweep loop");
 
-      FloatEbmType bestSplittingScore = FindBestInteractionGainPairs(
-         pInteractionDetector,
-         pFeatureGroup,
-         cSamplesRequiredForChildSplitMin,
-         pAuxiliaryBucketZone,
-         aHistogramBuckets
+      FloatEbmType bestSplittingScore;
+      if(2 == cDimensions) {
+         bestSplittingScore = FindBestInteractionGainPairs(
+            pInteractionDetector,
+            pFeatureGroup,
+            cSamplesRequiredForChildSplitMin,
+            pAuxiliaryBucketZone,
+            aHistogramBuckets
 #ifndef NDEBUG
-         , aHistogramBucketsDebugCopy
-         , aHistogramBucketsEndDebug
+            , aHistogramBucketsDebugCopy
+            , aHistogramBucketsEndDebug
 #endif // NDEBUG
-      );
+         );
+      } else {
+         bestSplittingScore = FindBestInteractionGainTriples(
+            pInteractionDetector,
+            pFeatureGroup,
+            cSamplesRequiredForChildSplitMin,
+            aHistogramBuckets
+#ifndef NDEBUG
+            , aHistogramBucketsEndDebug
+#endif // NDEBUG
+         );
+      }
 
-      LOG_0(TraceLevelVerbose, "CalculateInteractionScoreInternal Done bin sweep loop");
+      LOG_0(TraceLevelVerbose, "FindInteractionScore Done bin sweep loop");
 
       if(nullptr != pInteractionScoreReturn) {
          // we started our score at zero, and didn't replace with anything lower, so it can't be below zero
          // if we collected a NaN value, then we kept it
          EBM_ASSERT(std::isnan(bestSplittingScore) || FloatEbmType { 0 } <= bestSplittingScore);
-         EBM_ASSERT((!bClassification) || !std::isinf(bestSplittingScore));
+         EBM_ASSERT(!IsClassification(runtimeLearningTypeOrCountTargetClasses) || !std::isinf(bestSplittingScore));
 
          // if bestSplittingScore was NaN we make it zero so that it's not included.  If infinity, also don't include it since we overloaded something
          // even though bestSplittingScore shouldn't be +-infinity for classification, we check it for +-infinity 
@@ -218,12 +220,12 @@ static bool CalculateInteractionScoreInternal(
          *pInteractionScoreReturn = bestSplittingScore;
       }
    } else {
-      EBM_ASSERT(false); // we only support pairs currently
-      LOG_0(TraceLevelWarning, "WARNING CalculateInteractionScoreInternal 2 != pFeatureGroup->GetCountFeatures()");
+      EBM_ASSERT(false); // we only support pairs and triples currently
+      LOG_0(TraceLevelWarning, "WARNING FindInteractionScore 2 != cDimensions && 3 != cDimensions");
 
       // TODO: handle this better
       if(nullptr != pInteractionScoreReturn) {
-         // for now, just return any interactions that have other than 2 dimensions as zero, which means they won't be considered
+         // for now, just return any interactions that have more than 3 dimensions as zero, which means they won't be considered
          *pInteractionScoreReturn = FloatEbmType { 0 };
       }
    }
@@ -231,153 +233,704 @@ static bool CalculateInteractionScoreInternal(
 #ifndef NDEBUG
    free(aHistogramBucketsDebugCopy);
 #endif // NDEBUG
+}
 
-   LOG_0(TraceLevelVerbose, "Exited CalculateInteractionScoreInternal");
-   return false;
+// real scores are never negative, so this sorts below all of them and keeps pruned feature groups out of any ranking
+constexpr FloatEbmType k_interactionScorePruned = FloatEbmType { -1 };
+// features with more bins than this are grouped into this many coarse bins of roughly equal sample counts for the bound that we take 
+// before binning a feature group.  Tuned in ebm_native_test/benchmark/InteractionPruning.cpp
+constexpr size_t k_cInteractionCoarseBins = 32;
+static_assert(k_cInteractionCoarseBins <= size_t { 1 } + std::numeric_limits<unsigned char>::max(), 
+   "we keep the coarse bin of each fine bin in an unsigned char");
+
+// The 1D statistics that we gather once per call, before binning any feature group.  A bound on an interaction score can't come from 
+// these alone since an XOR has flat marginals and still explains all of the residuals, so we use them to tell which features can't be 
+// split at all, and to lay out the coarse bins that GetInteractionScoreCoarseBound bins each feature group into
+struct InteractionMarginals final {
+   // indexed by feature.  false if the feature has no cut that leaves cSamplesRequiredForChildSplitMin samples in every quadrant no matter 
+   // which feature it is paired with
+   bool * m_abFeatureSplittable;
+   // indexed by feature.  Where the coarse bins of the feature's fine bins start in m_aiCoarseBins.  Only set for the features we use
+   size_t * m_aiCoarseBinsFirst;
+   unsigned char * m_aiCoarseBins;
+   // indexed by feature.  Where the coarse bin of each sample starts in m_aiCoarseBinsBySample.  Only set for the features we use.  
+   // GetInteractionScoreCoarseBound reads a byte per sample from these instead of unpacking the fine bins of every feature group again
+   size_t * m_aiCoarseBinsBySampleFirst;
+   unsigned char * m_aiCoarseBinsBySample;
+   // the sum of the squared residuals of each sample over its vector entries
+   FloatEbmType * m_aSumSquaresBySample;
+   // indexed by feature.  The most that the squared residuals of any one coarse bin that holds 2 or more fine bins exceed what its 
+   // coarse bin explains.  The excess of any slab in GetInteractionScoreCoarseBound is at most this, and is nearly all of it unless the 
+   // other features explain a lot within the slab
+   FloatEbmType * m_aSlabExcessMax;
+   // how far the bound and the score can each be off from floating point rounding.  See InitializeInteractionMarginals
+   FloatEbmType m_boundSlack;
+};
+static_assert(std::is_standard_layout<InteractionMarginals>::value,
+   "We use the struct hack in several places, so disallow non-standard_layout types in general");
+static_assert(std::is_trivial<InteractionMarginals>::value,
+   "We use memcpy in several places, so disallow non-trivial types in general");
+static_assert(std::is_pod<InteractionMarginals>::value,
+   "We use a lot of C constructs, so disallow non-POD types in general");
+
+// Keeps the best m_cScoresMax scores that one worker has computed as a min heap.  The other workers can only push the overall 
+// m_cScoresMax-th best score higher, so the lowest score held here is always a safe threshold for pruning
+struct InteractionScoresTop final {
+   size_t m_cScoresMax;
+   size_t m_cScores;
+   FloatEbmType * m_aScores;
+   // copied from InteractionMarginals::m_boundSlack
+   FloatEbmType m_boundSlack;
+   size_t m_cFeatureGroupsSkipped;
+   size_t m_cFeatureGroupsPruned;
+};
+static_assert(std::is_standard_layout<InteractionScoresTop>::value,
+   "We use the struct hack in several places, so disallow non-standard_layout types in general");
+static_assert(std::is_trivial<InteractionScoresTop>::value,
+   "We use memcpy in several places, so disallow non-trivial types in general");
+static_assert(std::is_pod<InteractionScoresTop>::value,
+   "We use a lot of C constructs, so disallow non-POD types in general");
+
+static void AddInteractionScoreTop(InteractionScoresTop * const pTop, const FloatEbmType score) {
+   EBM_ASSERT(1 <= pTop->m_cScoresMax);
+   if(pTop->m_cScores < pTop->m_cScoresMax) {
+      pTop->m_aScores[pTop->m_cScores] = score;
+      ++pTop->m_cScores;
+      std::push_heap(pTop->m_aScores, pTop->m_aScores + pTop->m_cScores, std::greater<FloatEbmType>());
+   } else if(pTop->m_aScores[0] < score) {
+      std::pop_heap(pTop->m_aScores, pTop->m_aScores + pTop->m_cScores, std::greater<FloatEbmType>());
+      pTop->m_aScores[pTop->m_cScores - 1] = score;
+      std::push_heap(pTop->m_aScores, pTop->m_aScores + pTop->m_cScores, std::greater<FloatEbmType>());
+   }
 }
 
-// we made this a global because if we had put this variable inside the InteractionDetector object, then we would need to dereference that before getting 
-// the count.  By making this global we can send a log message incase a bad InteractionDetector object is sent into us we only decrease the count if the 
-// count is non-zero, so at worst if there is a race condition then we'll output this log message more times than desired, but we can live with that
-static int g_cLogCalculateInteractionScoreParametersMessages = 10;
+// Every split that FindBestInteractionGainPairs considers merges the cells of the full tensor into 4 quadrants, and every split that 
+// FindBestInteractionGainTriples considers merges them into 8 octants.  Merging two cells can only 
+// lower the sum of sumResidualError^2 / cSamples since (a + b)^2 / (m + n) <= a^2 / m + b^2 / n, so the same sum over the unmerged cells 
+// bounds the score of every split the sweep could find.  It only takes one pass over the tensor instead of a sweep over all the splits
+static FloatEbmType GetInteractionScoreBound(
+   const InteractionDetector * const pInteractionDetector,
+   const size_t cTotalBucketsMainSpace,
+   const HistogramBucketBase * const aHistogramBucketsBase
+) {
+   const size_t cVectorLength = GetVectorLength(pInteractionDetector->GetRuntimeLearningTypeOrCountTargetClasses());
+   EBM_ASSERT(!GetHistogramBucketSizeOverflow(false, cVectorLength)); // we're accessing allocated memory
+   const size_t cBytesPerHistogramBucket = GetHistogramBucketSize(false, cVectorLength);
+   const HistogramBucket<false> * const aHistogramBuckets = aHistogramBucketsBase->GetHistogramBucket<false>();
 
-EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION CalculateInteractionScore(
-   InteractionDetectorHandle interactionDetectorHandle,
-   IntEbmType countFeaturesInGroup,
-   const IntEbmType * featureIndexes,
-   IntEbmType countSamplesRequiredForChildSplitMin,
-   FloatEbmType * interactionScoreOut
+   FloatEbmType bound = FloatEbmType { 0 };
+   for(size_t iBucket = 0; iBucket < cTotalBucketsMainSpace; ++iBucket) {
+      const HistogramBucket<false> * const pHistogramBucket =
+         GetHistogramBucketByIndex<false>(cBytesPerHistogramBucket, aHistogramBuckets, iBucket);
+      const size_t cSamplesInBucket = pHistogramBucket->GetCountSamplesInBucket();
+      if(size_t { 0 } != cSamplesInBucket) {
+         const HistogramBucketVectorEntry<false> * const pHistogramBucketVectorEntry = pHistogramBucket->GetHistogramBucketVectorEntry();
+         for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
+            bound += EbmStatistics::ComputeNodeSplittingScore(
+               pHistogramBucketVectorEntry[iVector].m_sumResidualError, 
+               static_cast<FloatEbmType>(cSamplesInBucket)
+            );
+         }
+      }
+   }
+   return bound;
+}
+
+// FindInteractionScore unless pTop already holds enough scores that the bound shows this feature group can't make the cut
+static void FindOrPruneInteractionScore(
+   InteractionDetector * const pInteractionDetector,
+   const FeatureGroup * const pFeatureGroup,
+   const size_t cSamplesRequiredForChildSplitMin,
+   const size_t cTotalBucketsMainSpace,
+   FloatEbmType * const pInteractionScoreReturn,
+   HistogramBucketBase * const aHistogramBuckets,
+   InteractionScoresTop * const pTop
+#ifndef NDEBUG
+   , const unsigned char * const aHistogramBucketsEndDebug
+#endif // NDEBUG
 ) {
-   LOG_COUNTED_N(
-      &g_cLogCalculateInteractionScoreParametersMessages,
-      TraceLevelInfo,
-      TraceLevelVerbose,
-      "CalculateInteractionScore parameters: interactionDetectorHandle=%p, countFeaturesInGroup=%" IntEbmTypePrintf ", featureIndexes=%p, countSamplesRequiredForChildSplitMin=%" IntEbmTypePrintf ", interactionScoreOut=%p",
-      static_cast<void *>(interactionDetectorHandle),
-      countFeaturesInGroup,
-      static_cast<const void *>(featureIndexes),
-      countSamplesRequiredForChildSplitMin,
-      static_cast<void *>(interactionScoreOut)
+   if(nullptr != pTop && pTop->m_cScoresMax == pTop->m_cScores) {
+      const FloatEbmType bound = GetInteractionScoreBound(pInteractionDetector, cTotalBucketsMainSpace, aHistogramBuckets);
+      // a NaN bound fails this comparison, so we fall through and let FindInteractionScore deal with it
+      if(bound + pTop->m_boundSlack < pTop->m_aScores[0]) {
+         EBM_ASSERT(nullptr != pInteractionScoreReturn);
+         *pInteractionScoreReturn = k_interactionScorePruned;
+         ++pTop->m_cFeatureGroupsPruned;
+         return;
+      }
+   }
+
+   FindInteractionScore(
+      pInteractionDetector,
+      pFeatureGroup,
+      cSamplesRequiredForChildSplitMin,
+      cTotalBucketsMainSpace,
+      pInteractionScoreReturn,
+      aHistogramBuckets
+#ifndef NDEBUG
+      , aHistogramBucketsEndDebug
+#endif // NDEBUG
    );
 
-   InteractionDetector * pInteractionDetector = reinterpret_cast<InteractionDetector *>(interactionDetectorHandle);
-   if(nullptr == pInteractionDetector) {
-      if(LIKELY(nullptr != interactionScoreOut)) {
-         *interactionScoreOut = FloatEbmType { 0 };
-      }
-      LOG_0(TraceLevelError, "ERROR CalculateInteractionScore ebmInteraction cannot be nullptr");
-      return 1;
+   if(nullptr != pTop) {
+      EBM_ASSERT(nullptr != pInteractionScoreReturn);
+      AddInteractionScoreTop(pTop, *pInteractionScoreReturn);
    }
+}
 
-   LOG_COUNTED_0(pInteractionDetector->GetPointerCountLogEnterMessages(), TraceLevelInfo, TraceLevelVerbose, "Entered CalculateInteractionScore");
+// we only prune pairs and triples
+constexpr size_t k_cDimensionsCoarseBoundMax = 3;
 
-   if(countFeaturesInGroup < 0) {
-      if(LIKELY(nullptr != interactionScoreOut)) {
-         *interactionScoreOut = FloatEbmType { 0 };
+// Every quadrant (or octant) of a split that the sweep could find is a union of pieces, where a piece is the part of one coarse cell that 
+// lies on one side of every cut.  As in GetInteractionScoreBound, merging pieces can only lower the sum of sumResidualError^2 / cSamples.  
+// A coarse cell that no cut passes through is a single piece and adds its own sumResidualError^2 / cSamples.  The pieces of a cell that a 
+// cut does pass through add at most the cell's sum of squared residuals, since by Cauchy-Schwarz no piece's sumResidualError^2 / cSamples 
+// can exceed its own sum of squared residuals.  A cut can only pass through the slab of cells that shares one coarse bin in its dimension, 
+// and only if that coarse bin holds 2 or more fine bins, so the bound is the sum over the whole coarse tensor plus, in each dimension, the 
+// largest excess of squared residuals that any one such slab holds
+static FloatEbmType GetInteractionScoreCoarseBound(
+   const FeatureGroup * const pFeatureGroup,
+   const InteractionMarginals * const pMarginals,
+   const size_t cVectorLength,
+   const FloatEbmType * const aCells
+) {
+   const size_t cDimensions = pFeatureGroup->GetCountFeatures();
+   EBM_ASSERT(1 <= cDimensions);
+   EBM_ASSERT(cDimensions <= k_cDimensionsCoarseBoundMax);
+
+   size_t acCoarseBins[k_cDimensionsCoarseBoundMax];
+   // whether a cut can fall inside the coarse bin, which needs 2 or more fine bins in it
+   bool aabCuttable[k_cDimensionsCoarseBoundMax][k_cInteractionCoarseBins];
+   FloatEbmType aaSlabExcess[k_cDimensionsCoarseBoundMax][k_cInteractionCoarseBins];
+   size_t cCells = 1;
+   for(size_t iDimension = 0; iDimension < cDimensions; ++iDimension) {
+      const Feature * const pFeature = pFeatureGroup->GetFeatureGroupEntries()[iDimension].m_pFeature;
+      const size_t cBins = pFeature->GetCountBins();
+      const unsigned char * const aiCoarseBins = 
+         &pMarginals->m_aiCoarseBins[pMarginals->m_aiCoarseBinsFirst[pFeature->GetIndexFeatureData()]];
+      const size_t cCoarseBins = size_t { 1 } + static_cast<size_t>(aiCoarseBins[cBins - 1]);
+      acCoarseBins[iDimension] = cCoarseBins;
+      for(size_t iCoarseBin = 0; iCoarseBin < cCoarseBins; ++iCoarseBin) {
+         aabCuttable[iDimension][iCoarseBin] = false;
+         aaSlabExcess[iDimension][iCoarseBin] = FloatEbmType { 0 };
       }
-      LOG_0(TraceLevelError, "ERROR CalculateInteractionScore countFeaturesInGroup must be positive");
-      return 1;
-   }
-   if(0 != countFeaturesInGroup && nullptr == featureIndexes) {
-      if(LIKELY(nullptr != interactionScoreOut)) {
-         *interactionScoreOut = FloatEbmType { 0 };
+      for(size_t iBin = 1; iBin < cBins; ++iBin) {
+         if(aiCoarseBins[iBin - 1] == aiCoarseBins[iBin]) {
+            aabCuttable[iDimension][aiCoarseBins[iBin]] = true;
+         }
       }
-      LOG_0(TraceLevelError, "ERROR CalculateInteractionScore featureIndexes cannot be nullptr if 0 < countFeaturesInGroup");
-      return 1;
+      cCells *= cCoarseBins;
    }
-   if(!IsNumberConvertable<size_t>(countFeaturesInGroup)) {
-      if(LIKELY(nullptr != interactionScoreOut)) {
-         *interactionScoreOut = FloatEbmType { 0 };
+
+   const size_t cFloatsPerCell = size_t { 2 } + cVectorLength;
+   size_t aiCoarseBins[k_cDimensionsCoarseBoundMax] = { 0 };
+   FloatEbmType bound = FloatEbmType { 0 };
+   const FloatEbmType * pCell = aCells;
+   for(size_t iCell = 0; iCell < cCells; ++iCell) {
+      const FloatEbmType cSamplesInCell = pCell[0];
+      if(FloatEbmType { 0 } != cSamplesInCell) {
+         FloatEbmType scoreCell = FloatEbmType { 0 };
+         for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
+            scoreCell += EbmStatistics::ComputeNodeSplittingScore(pCell[2 + iVector], cSamplesInCell);
+         }
+         bound += scoreCell;
+         // rounding can leave this a hair negative when every residual in the cell is the same
+         const FloatEbmType excess = pCell[1] - scoreCell;
+         if(FloatEbmType { 0 } < excess) {
+            for(size_t iDimension = 0; iDimension < cDimensions; ++iDimension) {
+               aaSlabExcess[iDimension][aiCoarseBins[iDimension]] += excess;
+            }
+         }
       }
-      LOG_0(TraceLevelError, "ERROR CalculateInteractionScore countFeaturesInGroup too large to index");
-      return 1;
-   }
-   size_t cFeaturesInGroup = static_cast<size_t>(countFeaturesInGroup);
-   if(0 == cFeaturesInGroup) {
-      LOG_0(TraceLevelInfo, "INFO CalculateInteractionScore empty feature group");
-      if(nullptr != interactionScoreOut) {
-         // we return the lowest value possible for the interaction score, but we don't return an error since we handle it even though we'd prefer our 
-         // caler be smarter about this condition
-         *interactionScoreOut = FloatEbmType { 0 };
+      for(size_t iDimension = 0; iDimension < cDimensions; ++iDimension) {
+         ++aiCoarseBins[iDimension];
+         if(aiCoarseBins[iDimension] != acCoarseBins[iDimension]) {
+            break;
+         }
+         aiCoarseBins[iDimension] = 0;
       }
-      return 0;
+      pCell += cFloatsPerCell;
    }
-   if(0 == pInteractionDetector->GetDataSetByFeature()->GetCountSamples()) {
-      // if there are zero samples, there isn't much basis to say whether there are interactions, so just return zero
-      LOG_0(TraceLevelInfo, "INFO CalculateInteractionScore zero samples");
-      if(nullptr != interactionScoreOut) {
-         // we return the lowest value possible for the interaction score, but we don't return an error since we handle it even though we'd prefer our 
-         // caler be smarter about this condition
-         *interactionScoreOut = 0;
+   for(size_t iDimension = 0; iDimension < cDimensions; ++iDimension) {
+      FloatEbmType excessMax = FloatEbmType { 0 };
+      for(size_t iCoarseBin = 0; iCoarseBin < acCoarseBins[iDimension]; ++iCoarseBin) {
+         if(aabCuttable[iDimension][iCoarseBin] && excessMax < aaSlabExcess[iDimension][iCoarseBin]) {
+            excessMax = aaSlabExcess[iDimension][iCoarseBin];
+         }
       }
-      return 0;
+      bound += excessMax;
    }
+   return bound;
+}
 
-   size_t cSamplesRequiredForChildSplitMin = size_t { 1 }; // this is the min value
-   if(IntEbmType { 1 } <= countSamplesRequiredForChildSplitMin) {
-      cSamplesRequiredForChildSplitMin = static_cast<size_t>(countSamplesRequiredForChildSplitMin);
-      if(!IsNumberConvertable<size_t>(countSamplesRequiredForChildSplitMin)) {
-         // we can never exceed a size_t number of samples, so let's just set it to the maximum if we were going to overflow because it will generate 
-         // the same results as if we used the true number
-         cSamplesRequiredForChildSplitMin = std::numeric_limits<size_t>::max();
+template<size_t cCompilerDimensions>
+static void BinCoarse(
+   const size_t cSamples,
+   const size_t cVectorLength,
+   const unsigned char * const * const aaiCoarseBinsBySample,
+   const size_t * const acCoarseBins,
+   const FloatEbmType * const aSumSquaresBySample,
+   const FloatEbmType * pResidualError,
+   FloatEbmType * const aCells
+) {
+   const size_t cFloatsPerCell = size_t { 2 } + cVectorLength;
+   for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+      size_t iCell = 0;
+      size_t cCellsStride = 1;
+      for(size_t iDimension = 0; iDimension < cCompilerDimensions; ++iDimension) {
+         iCell += static_cast<size_t>(aaiCoarseBinsBySample[iDimension][iSample]) * cCellsStride;
+         cCellsStride *= acCoarseBins[iDimension];
       }
+      FloatEbmType * const pCell = &aCells[iCell * cFloatsPerCell];
+      pCell[0] += FloatEbmType { 1 };
+      pCell[1] += aSumSquaresBySample[iSample];
+      for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
+         pCell[2 + iVector] += pResidualError[iVector];
+      }
+      pResidualError += cVectorLength;
+   }
+}
+
+// Bins pFeatureGroup into the coarse bins of pMarginals and bounds it.  The coarse bin of every sample was found once for each feature, 
+// so this only reads a byte per sample for each feature and fills a histogram small enough to stay in the L1 cache, which takes much 
+// less time than unpacking the fine bins into the full tensor
+static bool GetInteractionScoreCoarseBoundBinned(
+   ThreadStateInteraction * const pThreadStateInteraction,
+   const InteractionDetector * const pInteractionDetector,
+   const FeatureGroup * const pFeatureGroup,
+   const InteractionMarginals * const pMarginals,
+   FloatEbmType * const pBoundOut
+) {
+   const size_t cVectorLength = GetVectorLength(pInteractionDetector->GetRuntimeLearningTypeOrCountTargetClasses());
+   const DataSetByFeature * const pDataSet = pInteractionDetector->GetDataSetByFeature();
+   const size_t cSamples = pDataSet->GetCountSamples();
+   const size_t cDimensions = pFeatureGroup->GetCountFeatures();
+   EBM_ASSERT(size_t { 2 } <= cDimensions);
+   EBM_ASSERT(cDimensions <= k_cDimensionsCoarseBoundMax);
+   // each cell holds its sample count, its sum of squared residuals, and then its sumResidualError for each vector entry.  cVectorLength 
+   // comes from a ptrdiff_t class count, so adding 2 to it can't overflow
+   const size_t cFloatsPerCell = size_t { 2 } + cVectorLength;
+
+   const unsigned char * aaiCoarseBinsBySample[k_cDimensionsCoarseBoundMax];
+   size_t acCoarseBins[k_cDimensionsCoarseBoundMax];
+   // at most k_cInteractionCoarseBins^k_cDimensionsCoarseBoundMax, so this can't overflow
+   size_t cCells = 1;
+   for(size_t iDimension = 0; iDimension < cDimensions; ++iDimension) {
+      const Feature * const pFeature = pFeatureGroup->GetFeatureGroupEntries()[iDimension].m_pFeature;
+      const size_t iFeature = pFeature->GetIndexFeatureData();
+      const size_t cBins = pFeature->GetCountBins();
+      EBM_ASSERT(size_t { 2 } <= cBins);
+      // the coarse bins are in the same order as the fine ones, so the last fine bin is in the last coarse bin
+      const size_t cCoarseBins = size_t { 1 } + 
+         static_cast<size_t>(pMarginals->m_aiCoarseBins[pMarginals->m_aiCoarseBinsFirst[iFeature] + cBins - 1]);
+      EBM_ASSERT(cCoarseBins <= k_cInteractionCoarseBins);
+      aaiCoarseBinsBySample[iDimension] = &pMarginals->m_aiCoarseBinsBySample[pMarginals->m_aiCoarseBinsBySampleFirst[iFeature]];
+      acCoarseBins[iDimension] = cCoarseBins;
+      cCells *= cCoarseBins;
+   }
+
+   if(IsMultiplyError(cCells, cFloatsPerCell) || IsMultiplyError(cCells * cFloatsPerCell, sizeof(FloatEbmType))) {
+      LOG_0(TraceLevelWarning, "WARNING GetInteractionScoreCoarseBoundBinned IsMultiplyError(cCells * cFloatsPerCell, sizeof(FloatEbmType))");
+      return true;
+   }
+   // this doesn't need to be freed since it's tracked and re-used by the class ThreadStateInteraction.  We're done with it before the 
+   // full histogram needs it
+   FloatEbmType * const aCells = reinterpret_cast<FloatEbmType *>(
+      pThreadStateInteraction->GetHistogramBucketBase(cCells * cFloatsPerCell * sizeof(FloatEbmType)));
+   if(UNLIKELY(nullptr == aCells)) {
+      LOG_0(TraceLevelWarning, "WARNING GetInteractionScoreCoarseBoundBinned nullptr == aCells");
+      return true;
+   }
+   for(size_t iFloat = 0; iFloat < cCells * cFloatsPerCell; ++iFloat) {
+      aCells[iFloat] = FloatEbmType { 0 };
+   }
+
+   if(size_t { 2 } == cDimensions) {
+      BinCoarse<2>(cSamples, cVectorLength, aaiCoarseBinsBySample, acCoarseBins, pMarginals->m_aSumSquaresBySample, 
+         pDataSet->GetResidualPointer(), aCells);
    } else {
-      LOG_0(TraceLevelWarning, "WARNING CalculateInteractionScore countSamplesRequiredForChildSplitMin can't be less than 1.  Adjusting to 1.");
+      BinCoarse<3>(cSamples, cVectorLength, aaiCoarseBinsBySample, acCoarseBins, pMarginals->m_aSumSquaresBySample, 
+         pDataSet->GetResidualPointer(), aCells);
    }
 
-   const Feature * const aFeatures = pInteractionDetector->GetFeatures();
-   const IntEbmType * pFeatureIndexes = featureIndexes;
-   const IntEbmType * const pFeatureIndexesEnd = featureIndexes + cFeaturesInGroup;
+   *pBoundOut = GetInteractionScoreCoarseBound(pFeatureGroup, pMarginals, cVectorLength, aCells);
+   return false;
+}
 
-   do {
-      const IntEbmType indexFeatureInterop = *pFeatureIndexes;
-      if(indexFeatureInterop < 0) {
-         if(LIKELY(nullptr != interactionScoreOut)) {
-            *interactionScoreOut = FloatEbmType { 0 };
-         }
-         LOG_0(TraceLevelError, "ERROR CalculateInteractionScore featureIndexes value cannot be negative");
-         return 1;
-      }
-      if(!IsNumberConvertable<size_t>(indexFeatureInterop)) {
-         if(LIKELY(nullptr != interactionScoreOut)) {
-            *interactionScoreOut = FloatEbmType { 0 };
-         }
-         LOG_0(TraceLevelError, "ERROR CalculateInteractionScore featureIndexes value too big to reference memory");
-         return 1;
+// Once pTop holds enough scores, we bound the feature groups in apFeatureGroups from their coarse bins before any of them is binned.  
+// Those that can't make the cut get k_interactionScorePruned and are marked in abPrunedOut so that our caller doesn't bin them.  Feature 
+// groups whose features all have as few bins as their coarse bins would get the same bound as GetInteractionScoreBound gives them after 
+// binning, so we leave those to it
+static bool PruneBeforeBinning(
+   ThreadStateInteraction * const pThreadStateInteraction,
+   const InteractionDetector * const pInteractionDetector,
+   const size_t cFeatureGroups,
+   const FeatureGroup * const * const apFeatureGroups,
+   FloatEbmType * const * const apInteractionScoresReturn,
+   const InteractionMarginals * const pMarginals,
+   InteractionScoresTop * const pTop,
+   bool * const abPrunedOut
+) {
+   EBM_ASSERT(1 <= cFeatureGroups);
+   EBM_ASSERT(cFeatureGroups <= k_cPairsSharedScanMax);
+
+   for(size_t iFeatureGroup = 0; iFeatureGroup < cFeatureGroups; ++iFeatureGroup) {
+      abPrunedOut[iFeatureGroup] = false;
+   }
+   if(nullptr == pTop || pTop->m_cScoresMax != pTop->m_cScores) {
+      return false;
+   }
+   EBM_ASSERT(nullptr != pMarginals);
+   const FloatEbmType threshold = pTop->m_aScores[0];
+
+   for(size_t iFeatureGroup = 0; iFeatureGroup < cFeatureGroups; ++iFeatureGroup) {
+      const FeatureGroup * const pFeatureGroup = apFeatureGroups[iFeatureGroup];
+      const size_t cDimensions = pFeatureGroup->GetCountFeatures();
+      bool bCoarser = false;
+      // the slabs of the coarse bound hold nearly all of the excess in m_aSlabExcessMax unless the feature group explains a lot within 
+      // them.  When that excess alone already reaches the threshold, the coarse bound only gets under it for a feature group that 
+      // explains most of a slab's residuals, which is the opposite of one that we could prune, so we don't spend any time finding that out
+      FloatEbmType slabExcessMax = FloatEbmType { 0 };
+      for(size_t iDimension = 0; iDimension < cDimensions; ++iDimension) {
+         const Feature * const pFeature = pFeatureGroup->GetFeatureGroupEntries()[iDimension].m_pFeature;
+         bCoarser = bCoarser || k_cInteractionCoarseBins < pFeature->GetCountBins();
+         slabExcessMax += pMarginals->m_aSlabExcessMax[pFeature->GetIndexFeatureData()];
       }
-      const size_t iFeatureInGroup = static_cast<size_t>(indexFeatureInterop);
-      if(pInteractionDetector->GetCountFeatures() <= iFeatureInGroup) {
-         if(LIKELY(nullptr != interactionScoreOut)) {
-            *interactionScoreOut = FloatEbmType { 0 };
+      if(bCoarser && slabExcessMax < threshold) {
+         FloatEbmType bound;
+         if(GetInteractionScoreCoarseBoundBinned(pThreadStateInteraction, pInteractionDetector, pFeatureGroup, pMarginals, &bound)) {
+            return true;
          }
-         LOG_0(TraceLevelError, "ERROR CalculateInteractionScore featureIndexes value must be less than the number of features");
-         return 1;
-      }
-      const Feature * const pFeature = &aFeatures[iFeatureInGroup];
-      if(pFeature->GetCountBins() <= size_t { 1 }) {
-         if(nullptr != interactionScoreOut) {
-            // we return the lowest value possible for the interaction score, but we don't return an error since we handle it even though we'd prefer 
-            // our caler be smarter about this condition
-            *interactionScoreOut = FloatEbmType { 0 };
+         // a NaN bound fails this comparison, so we fall through and let FindInteractionScore deal with it
+         if(bound + pTop->m_boundSlack < threshold) {
+            *apInteractionScoresReturn[iFeatureGroup] = k_interactionScorePruned;
+            abPrunedOut[iFeatureGroup] = true;
+            ++pTop->m_cFeatureGroupsPruned;
          }
-         LOG_0(TraceLevelInfo, "INFO CalculateInteractionScore feature group contains a feature with only 1 bin");
-         return IntEbmType { 0 };
       }
-      ++pFeatureIndexes;
-   } while(pFeatureIndexesEnd != pFeatureIndexes);
-
-   if(k_cDimensionsMax < cFeaturesInGroup) {
-      // if we try to run with more than k_cDimensionsMax we'll exceed our memory capacity, so let's exit here instead
-      LOG_0(TraceLevelWarning, "WARNING CalculateInteractionScore k_cDimensionsMax < cFeaturesInGroup");
-      return 1;
    }
+   return false;
+}
 
-   // TODO: instead of putting the FeatureGroup into a character buffer, consider putting k_cDimensionsMax
-   //       items in the array by default and dynamically allocate less if we need less, or use a template that
-   //       allows specification of the number of items with a default of 1 (this would be the cleanest!)
-
-   // put the pFeatureGroup object on the stack. We want to put it into a FeatureGroup object since we want to share code with boosting, 
-   // which calls things like building the tensor totals (which is templated to be compiled many times)
+static bool CalculateInteractionScoreInternal(
+   ThreadStateInteraction * const pThreadStateInteraction,
+   InteractionDetector * const pInteractionDetector,
+   const FeatureGroup * const pFeatureGroup,
+   const size_t cSamplesRequiredForChildSplitMin,
+   FloatEbmType * const pInteractionScoreReturn,
+   InteractionScoresTop * const pTop
+) {
+   // we never use the denominator term in HistogramBucketVectorEntry when calculating interaction scores, so we use the
+   // residual-only HistogramBucket<false> layout for both classification and regression.  If we ever want to use the 
+   // denominator as part of the gain function we'll need to switch back to HistogramBucket<IsClassification(...)>
+
+   const ptrdiff_t runtimeLearningTypeOrCountTargetClasses = pInteractionDetector->GetRuntimeLearningTypeOrCountTargetClasses();
+
+   LOG_0(TraceLevelVerbose, "Entered CalculateInteractionScoreInternal");
+
+   size_t cTotalBucketsMainSpace;
+   size_t cTotalBuckets;
+   if(GetInteractionBucketCounts(pFeatureGroup, &cTotalBucketsMainSpace, &cTotalBuckets)) {
+      LOG_0(TraceLevelWarning, "WARNING CalculateInteractionScoreInternal GetInteractionBucketCounts failed");
+      return true;
+   }
+
+   const size_t cVectorLength = GetVectorLength(runtimeLearningTypeOrCountTargetClasses);
+
+   if(GetHistogramBucketSizeOverflow(false, cVectorLength)) {
+      LOG_0(
+         TraceLevelWarning,
+         "WARNING CalculateInteractionScoreInternal GetHistogramBucketSizeOverflow(false, cVectorLength)"
+      );
+      return true;
+   }
+   const size_t cBytesPerHistogramBucket = GetHistogramBucketSize(false, cVectorLength);
+   if(IsMultiplyError(cTotalBuckets, cBytesPerHistogramBucket)) {
+      LOG_0(TraceLevelWarning, "WARNING CalculateInteractionScoreInternal IsMultiplyError(cTotalBuckets, cBytesPerHistogramBucket)");
+      return true;
+   }
+   const size_t cBytesBuffer = cTotalBuckets * cBytesPerHistogramBucket;
+
+   if(size_t { 3 } <= pFeatureGroup->GetCountSignificantFeatures() && k_cBytesInteractionHistogramTriplesMax < cBytesBuffer) {
+      // this isn't an error.  The group is just too fine grained for us to score, so we give it a score that keeps it out of the ranking
+      LOG_N(
+         TraceLevelWarning, 
+         "WARNING CalculateInteractionScoreInternal k_cBytesInteractionHistogramTriplesMax < cBytesBuffer %zu", 
+         cBytesBuffer
+      );
+      if(nullptr != pInteractionScoreReturn) {
+         *pInteractionScoreReturn = FloatEbmType { 0 };
+      }
+      if(nullptr != pTop) {
+         AddInteractionScoreTop(pTop, FloatEbmType { 0 });
+      }
+      return false;
+   }
+
+   // this doesn't need to be freed since it's tracked and re-used by the class ThreadStateInteraction
+   HistogramBucketBase * const aHistogramBuckets = pThreadStateInteraction->GetHistogramBucketBase(cBytesBuffer);
+   if(UNLIKELY(nullptr == aHistogramBuckets)) {
+      LOG_0(TraceLevelWarning, "WARNING CalculateInteractionScoreInternal nullptr == aHistogramBuckets");
+      return true;
+   }
+
+   HistogramBucket<false> * const aHistogramBucketsLocal = aHistogramBuckets->GetHistogramBucket<false>();
+   for(size_t i = 0; i < cTotalBuckets; ++i) {
+      HistogramBucket<false> * const pHistogramBucket =
+         GetHistogramBucketByIndex(cBytesPerHistogramBucket, aHistogramBucketsLocal, i);
+      pHistogramBucket->Zero(cVectorLength);
+   }
+
+#ifndef NDEBUG
+   const unsigned char * const aHistogramBucketsEndDebug = reinterpret_cast<unsigned char *>(aHistogramBuckets) + cBytesBuffer;
+#endif // NDEBUG
+
+   BinInteraction(
+      pInteractionDetector,
+      pFeatureGroup,
+      aHistogramBuckets
+#ifndef NDEBUG
+      , aHistogramBucketsEndDebug
+#endif // NDEBUG
+   );
+
+   FindOrPruneInteractionScore(
+      pInteractionDetector,
+      pFeatureGroup,
+      cSamplesRequiredForChildSplitMin,
+      cTotalBucketsMainSpace,
+      pInteractionScoreReturn,
+      aHistogramBuckets,
+      pTop
+#ifndef NDEBUG
+      , aHistogramBucketsEndDebug
+#endif // NDEBUG
+   );
+
+   LOG_0(TraceLevelVerbose, "Exited CalculateInteractionScoreInternal");
+   return false;
+}
+
+// scores pairs that all have the same anchor feature in their first dimension.  The histograms of all the pairs are carved out of one buffer 
+// and filled by BinInteractionShared in a single pass over the samples, then each is scored exactly like CalculateInteractionScoreInternal does
+static bool CalculateInteractionScoresSharedInternal(
+   ThreadStateInteraction * const pThreadStateInteraction,
+   InteractionDetector * const pInteractionDetector,
+   const size_t cPairs,
+   const FeatureGroup * const * const apFeatureGroups,
+   const size_t cSamplesRequiredForChildSplitMin,
+   FloatEbmType * const * const apInteractionScoresReturn,
+   InteractionScoresTop * const pTop
+) {
+   LOG_0(TraceLevelVerbose, "Entered CalculateInteractionScoresSharedInternal");
+
+   EBM_ASSERT(2 <= cPairs);
+   EBM_ASSERT(cPairs <= k_cPairsSharedScanMax);
+
+   const ptrdiff_t runtimeLearningTypeOrCountTargetClasses = pInteractionDetector->GetRuntimeLearningTypeOrCountTargetClasses();
+   const size_t cVectorLength = GetVectorLength(runtimeLearningTypeOrCountTargetClasses);
+   if(GetHistogramBucketSizeOverflow(false, cVectorLength)) {
+      LOG_0(
+         TraceLevelWarning,
+         "WARNING CalculateInteractionScoresSharedInternal GetHistogramBucketSizeOverflow(false, cVectorLength)"
+      );
+      return true;
+   }
+   const size_t cBytesPerHistogramBucket = GetHistogramBucketSize(false, cVectorLength);
+
+   size_t acTotalBucketsMainSpace[k_cPairsSharedScanMax];
+   size_t aiBucketsStart[k_cPairsSharedScanMax];
+   size_t cTotalBuckets = 0;
+   for(size_t iPair = 0; iPair < cPairs; ++iPair) {
+      size_t cTotalBucketsPair;
+      if(GetInteractionBucketCounts(apFeatureGroups[iPair], &acTotalBucketsMainSpace[iPair], &cTotalBucketsPair)) {
+         LOG_0(TraceLevelWarning, "WARNING CalculateInteractionScoresSharedInternal GetInteractionBucketCounts failed");
+         return true;
+      }
+      aiBucketsStart[iPair] = cTotalBuckets;
+      if(IsAddError(cTotalBuckets, cTotalBucketsPair)) {
+         LOG_0(TraceLevelWarning, "WARNING CalculateInteractionScoresSharedInternal IsAddError(cTotalBuckets, cTotalBucketsPair)");
+         return true;
+      }
+      cTotalBuckets += cTotalBucketsPair;
+   }
+   if(IsMultiplyError(cTotalBuckets, cBytesPerHistogramBucket)) {
+      LOG_0(TraceLevelWarning, "WARNING CalculateInteractionScoresSharedInternal IsMultiplyError(cTotalBuckets, cBytesPerHistogramBucket)");
+      return true;
+   }
+   const size_t cBytesBuffer = cTotalBuckets * cBytesPerHistogramBucket;
+
+   // this doesn't need to be freed since it's tracked and re-used by the class ThreadStateInteraction
+   HistogramBucketBase * const aHistogramBuckets = pThreadStateInteraction->GetHistogramBucketBase(cBytesBuffer);
+   if(UNLIKELY(nullptr == aHistogramBuckets)) {
+      LOG_0(TraceLevelWarning, "WARNING CalculateInteractionScoresSharedInternal nullptr == aHistogramBuckets");
+      return true;
+   }
+
+   HistogramBucket<false> * const aHistogramBucketsLocal = aHistogramBuckets->GetHistogramBucket<false>();
+   for(size_t i = 0; i < cTotalBuckets; ++i) {
+      HistogramBucket<false> * const pHistogramBucket =
+         GetHistogramBucketByIndex(cBytesPerHistogramBucket, aHistogramBucketsLocal, i);
+      pHistogramBucket->Zero(cVectorLength);
+   }
+
+   HistogramBucketBase * apHistogramBuckets[k_cPairsSharedScanMax];
+   for(size_t iPair = 0; iPair < cPairs; ++iPair) {
+      apHistogramBuckets[iPair] = GetHistogramBucketByIndex(cBytesPerHistogramBucket, aHistogramBuckets, aiBucketsStart[iPair]);
+   }
+
+#ifndef NDEBUG
+   const unsigned char * const aHistogramBucketsEndDebug = reinterpret_cast<unsigned char *>(aHistogramBuckets) + cBytesBuffer;
+#endif // NDEBUG
+
+   BinInteractionShared(
+      pInteractionDetector,
+      cPairs,
+      apFeatureGroups,
+      apHistogramBuckets
+#ifndef NDEBUG
+      , aHistogramBucketsEndDebug
+#endif // NDEBUG
+   );
+
+   for(size_t iPair = 0; iPair < cPairs; ++iPair) {
+      FindOrPruneInteractionScore(
+         pInteractionDetector,
+         apFeatureGroups[iPair],
+         cSamplesRequiredForChildSplitMin,
+         acTotalBucketsMainSpace[iPair],
+         apInteractionScoresReturn[iPair],
+         apHistogramBuckets[iPair],
+         pTop
+#ifndef NDEBUG
+         , aHistogramBucketsEndDebug
+#endif // NDEBUG
+      );
+   }
+
+   LOG_0(TraceLevelVerbose, "Exited CalculateInteractionScoresSharedInternal");
+   return false;
+}
+
+// validates the caller's feature group and scores it.  pThreadStateInteraction can be nullptr, in which case we allocate a temporary one for 
+// the duration of the call
+static IntEbmType CalculateInteractionScoreExternal(
+   ThreadStateInteraction * const pThreadStateInteraction,
+   InteractionDetector * const pInteractionDetector,
+   const IntEbmType countFeaturesInGroup,
+   const IntEbmType * const featureIndexes,
+   const IntEbmType countSamplesRequiredForChildSplitMin,
+   FloatEbmType * const interactionScoreOut
+) {
+   LOG_COUNTED_0(pInteractionDetector->GetPointerCountLogEnterMessages(), TraceLevelInfo, TraceLevelVerbose, "Entered CalculateInteractionScore");
+
+   if(countFeaturesInGroup < 0) {
+      if(LIKELY(nullptr != interactionScoreOut)) {
+         *interactionScoreOut = FloatEbmType { 0 };
+      }
+      LOG_0(TraceLevelError, "ERROR CalculateInteractionScore countFeaturesInGroup must be positive");
+      return 1;
+   }
+   if(0 != countFeaturesInGroup && nullptr == featureIndexes) {
+      if(LIKELY(nullptr != interactionScoreOut)) {
+         *interactionScoreOut = FloatEbmType { 0 };
+      }
+      LOG_0(TraceLevelError, "ERROR CalculateInteractionScore featureIndexes cannot be nullptr if 0 < countFeaturesInGroup");
+      return 1;
+   }
+   if(!IsNumberConvertable<size_t>(countFeaturesInGroup)) {
+      if(LIKELY(nullptr != interactionScoreOut)) {
+         *interactionScoreOut = FloatEbmType { 0 };
+      }
+      LOG_0(TraceLevelError, "ERROR CalculateInteractionScore countFeaturesInGroup too large to index");
+      return 1;
+   }
+   size_t cFeaturesInGroup = static_cast<size_t>(countFeaturesInGroup);
+   if(0 == cFeaturesInGroup) {
+      LOG_0(TraceLevelInfo, "INFO CalculateInteractionScore empty feature group");
+      if(nullptr != interactionScoreOut) {
+         // we return the lowest value possible for the interaction score, but we don't return an error since we handle it even though we'd prefer our 
+         // caler be smarter about this condition
+         *interactionScoreOut = FloatEbmType { 0 };
+      }
+      return 0;
+   }
+   if(0 == pInteractionDetector->GetDataSetByFeature()->GetCountSamples()) {
+      // if there are zero samples, there isn't much basis to say whether there are interactions, so just return zero
+      LOG_0(TraceLevelInfo, "INFO CalculateInteractionScore zero samples");
+      if(nullptr != interactionScoreOut) {
+         // we return the lowest value possible for the interaction score, but we don't return an error since we handle it even though we'd prefer our 
+         // caler be smarter about this condition
+         *interactionScoreOut = 0;
+      }
+      return 0;
+   }
+
+   size_t cSamplesRequiredForChildSplitMin = size_t { 1 }; // this is the min value
+   if(IntEbmType { 1 } <= countSamplesRequiredForChildSplitMin) {
+      cSamplesRequiredForChildSplitMin = static_cast<size_t>(countSamplesRequiredForChildSplitMin);
+      if(!IsNumberConvertable<size_t>(countSamplesRequiredForChildSplitMin)) {
+         // we can never exceed a size_t number of samples, so let's just set it to the maximum if we were going to overflow because it will generate 
+         // the same results as if we used the true number
+         cSamplesRequiredForChildSplitMin = std::numeric_limits<size_t>::max();
+      }
+   } else {
+      LOG_0(TraceLevelWarning, "WARNING CalculateInteractionScore countSamplesRequiredForChildSplitMin can't be less than 1.  Adjusting to 1.");
+   }
+
+   const Feature * const aFeatures = pInteractionDetector->GetFeatures();
+   const IntEbmType * pFeatureIndexes = featureIndexes;
+   const IntEbmType * const pFeatureIndexesEnd = featureIndexes + cFeaturesInGroup;
+
+   do {
+      const IntEbmType indexFeatureInterop = *pFeatureIndexes;
+      if(indexFeatureInterop < 0) {
+         if(LIKELY(nullptr != interactionScoreOut)) {
+            *interactionScoreOut = FloatEbmType { 0 };
+         }
+         LOG_0(TraceLevelError, "ERROR CalculateInteractionScore featureIndexes value cannot be negative");
+         return 1;
+      }
+      if(!IsNumberConvertable<size_t>(indexFeatureInterop)) {
+         if(LIKELY(nullptr != interactionScoreOut)) {
+            *interactionScoreOut = FloatEbmType { 0 };
+         }
+         LOG_0(TraceLevelError, "ERROR CalculateInteractionScore featureIndexes value too big to reference memory");
+         return 1;
+      }
+      const size_t iFeatureInGroup = static_cast<size_t>(indexFeatureInterop);
+      if(pInteractionDetector->GetCountFeatures() <= iFeatureInGroup) {
+         if(LIKELY(nullptr != interactionScoreOut)) {
+            *interactionScoreOut = FloatEbmType { 0 };
+         }
+         LOG_0(TraceLevelError, "ERROR CalculateInteractionScore featureIndexes value must be less than the number of features");
+         return 1;
+      }
+      const Feature * const pFeature = &aFeatures[iFeatureInGroup];
+      if(pFeature->GetCountBins() <= size_t { 1 }) {
+         if(nullptr != interactionScoreOut) {
+            // we return the lowest value possible for the interaction score, but we don't return an error since we handle it even though we'd prefer 
+            // our caler be smarter about this condition
+            *interactionScoreOut = FloatEbmType { 0 };
+         }
+         LOG_0(TraceLevelInfo, "INFO CalculateInteractionScore feature group contains a feature with only 1 bin");
+         return IntEbmType { 0 };
+      }
+      ++pFeatureIndexes;
+   } while(pFeatureIndexesEnd != pFeatureIndexes);
+
+   if(k_cDimensionsMax < cFeaturesInGroup) {
+      // if we try to run with more than k_cDimensionsMax we'll exceed our memory capacity, so let's exit here instead
+      LOG_0(TraceLevelWarning, "WARNING CalculateInteractionScore k_cDimensionsMax < cFeaturesInGroup");
+      return 1;
+   }
+
+   // TODO: instead of putting the FeatureGroup into a character buffer, consider putting k_cDimensionsMax
+   //       items in the array by default and dynamically allocate less if we need less, or use a template that
+   //       allows specification of the number of items with a default of 1 (this would be the cleanest!)
+
+   // put the pFeatureGroup object on the stack. We want to put it into a FeatureGroup object since we want to share code with boosting, 
+   // which calls things like building the tensor totals (which is templated to be compiled many times)
    char FeatureGroupBuffer[FeatureGroup::GetFeatureGroupCountBytes(k_cDimensionsMax)];
    FeatureGroup * const pFeatureGroup = reinterpret_cast<FeatureGroup *>(&FeatureGroupBuffer);
    pFeatureGroup->Initialize(cFeaturesInGroup, 0);
@@ -411,21 +964,26 @@ EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION Calculate
       return 0;
    }
 
-   // TODO : be smarter about our ThreadStateInteraction, otherwise why have it?
-   ThreadStateInteraction * const pThreadStateInteraction = ThreadStateInteraction::Allocate();
+   ThreadStateInteraction * pThreadStateInteractionLocal = pThreadStateInteraction;
    if(nullptr == pThreadStateInteraction) {
-      return 1;
+      pThreadStateInteractionLocal = ThreadStateInteraction::Allocate(pInteractionDetector);
+      if(nullptr == pThreadStateInteractionLocal) {
+         return 1;
+      }
    }
 
    IntEbmType ret = CalculateInteractionScoreInternal(
-      pThreadStateInteraction,
+      pThreadStateInteractionLocal,
       pInteractionDetector,
       pFeatureGroup,
       cSamplesRequiredForChildSplitMin,
-      interactionScoreOut
+      interactionScoreOut,
+      nullptr
    );
 
-   ThreadStateInteraction::Free(pThreadStateInteraction);
+   if(nullptr == pThreadStateInteraction) {
+      ThreadStateInteraction::Free(pThreadStateInteractionLocal);
+   }
 
    if(0 != ret) {
       LOG_N(TraceLevelWarning, "WARNING CalculateInteractionScore returned %" IntEbmTypePrintf, ret);
@@ -445,3 +1003,1605 @@ EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION Calculate
    }
    return ret;
 }
+
+// we made this a global because if we had put this variable inside the InteractionDetector object, then we would need to dereference that before getting 
+// the count.  By making this global we can send a log message incase a bad InteractionDetector object is sent into us we only decrease the count if the 
+// count is non-zero, so at worst if there is a race condition then we'll output this log message more times than desired, but we can live with that
+static int g_cLogCalculateInteractionScoreParametersMessages = 10;
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION CalculateInteractionScore(
+   InteractionDetectorHandle interactionDetectorHandle,
+   IntEbmType countFeaturesInGroup,
+   const IntEbmType * featureIndexes,
+   IntEbmType countSamplesRequiredForChildSplitMin,
+   FloatEbmType * interactionScoreOut
+) {
+   LOG_COUNTED_N(
+      &g_cLogCalculateInteractionScoreParametersMessages,
+      TraceLevelInfo,
+      TraceLevelVerbose,
+      "CalculateInteractionScore parameters: interactionDetectorHandle=%p, countFeaturesInGroup=%" IntEbmTypePrintf ", featureIndexes=%p, countSamplesRequiredForChildSplitMin=%" IntEbmTypePrintf ", interactionScoreOut=%p",
+      static_cast<void *>(interactionDetectorHandle),
+      countFeaturesInGroup,
+      static_cast<const void *>(featureIndexes),
+      countSamplesRequiredForChildSplitMin,
+      static_cast<void *>(interactionScoreOut)
+   );
+
+   InteractionDetector * pInteractionDetector = reinterpret_cast<InteractionDetector *>(interactionDetectorHandle);
+   if(nullptr == pInteractionDetector) {
+      if(LIKELY(nullptr != interactionScoreOut)) {
+         *interactionScoreOut = FloatEbmType { 0 };
+      }
+      LOG_0(TraceLevelError, "ERROR CalculateInteractionScore ebmInteraction cannot be nullptr");
+      return 1;
+   }
+
+   return CalculateInteractionScoreExternal(
+      nullptr,
+      pInteractionDetector,
+      countFeaturesInGroup,
+      featureIndexes,
+      countSamplesRequiredForChildSplitMin,
+      interactionScoreOut
+   );
+}
+
+static int g_cLogCalculateInteractionScoreThreadStateParametersMessages = 10;
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION CalculateInteractionScoreThreadState(
+   ThreadStateInteractionHandle threadStateInteractionHandle,
+   IntEbmType countFeaturesInGroup,
+   const IntEbmType * featureIndexes,
+   IntEbmType countSamplesRequiredForChildSplitMin,
+   FloatEbmType * interactionScoreOut
+) {
+   LOG_COUNTED_N(
+      &g_cLogCalculateInteractionScoreThreadStateParametersMessages,
+      TraceLevelInfo,
+      TraceLevelVerbose,
+      "CalculateInteractionScoreThreadState parameters: threadStateInteractionHandle=%p, countFeaturesInGroup=%" IntEbmTypePrintf ", featureIndexes=%p, countSamplesRequiredForChildSplitMin=%" IntEbmTypePrintf ", interactionScoreOut=%p",
+      static_cast<void *>(threadStateInteractionHandle),
+      countFeaturesInGroup,
+      static_cast<const void *>(featureIndexes),
+      countSamplesRequiredForChildSplitMin,
+      static_cast<void *>(interactionScoreOut)
+   );
+
+   ThreadStateInteraction * const pThreadStateInteraction = reinterpret_cast<ThreadStateInteraction *>(threadStateInteractionHandle);
+   if(nullptr == pThreadStateInteraction) {
+      if(LIKELY(nullptr != interactionScoreOut)) {
+         *interactionScoreOut = FloatEbmType { 0 };
+      }
+      LOG_0(TraceLevelError, "ERROR CalculateInteractionScoreThreadState threadStateInteractionHandle cannot be nullptr");
+      return 1;
+   }
+
+   return CalculateInteractionScoreExternal(
+      pThreadStateInteraction,
+      pThreadStateInteraction->GetInteractionDetector(),
+      countFeaturesInGroup,
+      featureIndexes,
+      countSamplesRequiredForChildSplitMin,
+      interactionScoreOut
+   );
+}
+
+// a run of consecutive feature groups that a worker scores together.  Runs of pairs that share their first feature are binned in one shared 
+// pass over the samples.  Everything else is a run of 1
+struct InteractionScoresBlock final {
+   size_t m_iFeatureGroupFirst;
+   size_t m_cFeatureGroups;
+};
+static_assert(std::is_standard_layout<InteractionScoresBlock>::value,
+   "We use the struct hack in several places, so disallow non-standard_layout types in general");
+static_assert(std::is_trivial<InteractionScoresBlock>::value,
+   "We use memcpy in several places, so disallow non-trivial types in general");
+static_assert(std::is_pod<InteractionScoresBlock>::value,
+   "We use a lot of C constructs, so disallow non-POD types in general");
+
+// state shared between the workers of CalculateInteractionScores.  The cost of a block depends on the bin counts of its features, so 
+// rather than giving each worker a fixed slice we hand out blocks one at a time from m_iBlockNext.  A worker that draws cheap 
+// blocks keeps drawing until the list is exhausted instead of sitting idle while another worker finishes expensive ones
+struct InteractionScoresWork final {
+   InteractionDetector * m_pInteractionDetector;
+   size_t m_cBlocks;
+   const InteractionScoresBlock * m_aBlocks;
+   size_t m_cFeaturesInGroup;
+   const IntEbmType * m_aFeatureIndexes;
+   size_t m_cSamplesRequiredForChildSplitMin;
+   FloatEbmType * m_aInteractionScores;
+   // nullptr unless we're pruning
+   const InteractionMarginals * m_pMarginals;
+   std::atomic<size_t> m_iBlockNext;
+   ThreadStateInteraction * m_apThreadStateInteraction[k_cWorkersMax];
+   // nullptr entries unless we're pruning
+   InteractionScoresTop * m_apTop[k_cWorkersMax];
+   bool m_abError[k_cWorkersMax];
+};
+
+// fills pFeatureGroup from already checked feature indexes.  Returns true if one of the features has only 1 bin, or is marked unsplittable in 
+// abFeatureSplittable, in which case the feature group can't be split and like CalculateInteractionScore we give it a zero score
+static bool FillFeatureGroup(
+   const InteractionDetector * const pInteractionDetector,
+   const size_t cFeaturesInGroup,
+   const IntEbmType * pFeatureIndexes,
+   const bool * const abFeatureSplittable,
+   FeatureGroup * const pFeatureGroup
+) {
+   EBM_ASSERT(1 <= cFeaturesInGroup);
+   EBM_ASSERT(cFeaturesInGroup <= k_cDimensionsMax);
+
+   const Feature * const aFeatures = pInteractionDetector->GetFeatures();
+   pFeatureGroup->Initialize(cFeaturesInGroup, 0);
+   pFeatureGroup->SetCountSignificantFeatures(cFeaturesInGroup);
+   FeatureGroupEntry * pFeatureGroupEntry = pFeatureGroup->GetFeatureGroupEntries();
+   const FeatureGroupEntry * const pFeatureGroupEntryEnd = pFeatureGroupEntry + cFeaturesInGroup;
+   bool bUnsplittable = false;
+   do {
+      const IntEbmType indexFeatureInterop = *pFeatureIndexes;
+      EBM_ASSERT(0 <= indexFeatureInterop);
+      EBM_ASSERT(IsNumberConvertable<size_t>(indexFeatureInterop));
+      const size_t iFeatureInGroup = static_cast<size_t>(indexFeatureInterop);
+      EBM_ASSERT(iFeatureInGroup < pInteractionDetector->GetCountFeatures());
+      const Feature * const pFeature = &aFeatures[iFeatureInGroup];
+      bUnsplittable = bUnsplittable || pFeature->GetCountBins() <= size_t { 1 } || 
+         nullptr != abFeatureSplittable && !abFeatureSplittable[iFeatureInGroup];
+      pFeatureGroupEntry->m_pFeature = pFeature;
+      ++pFeatureGroupEntry;
+      ++pFeatureIndexes;
+   } while(pFeatureGroupEntryEnd != pFeatureGroupEntry);
+   return bUnsplittable;
+}
+
+static void CalculateInteractionScoresWorker(void * const pWorkVoid, const size_t iWorker) {
+   InteractionScoresWork * const pWork = static_cast<InteractionScoresWork *>(pWorkVoid);
+
+   InteractionDetector * const pInteractionDetector = pWork->m_pInteractionDetector;
+   const size_t cBlocks = pWork->m_cBlocks;
+   const size_t cFeaturesInGroup = pWork->m_cFeaturesInGroup;
+   const size_t cSamplesRequiredForChildSplitMin = pWork->m_cSamplesRequiredForChildSplitMin;
+   const InteractionMarginals * const pMarginals = pWork->m_pMarginals;
+   const bool * const abFeatureSplittable = nullptr == pMarginals ? nullptr : pMarginals->m_abFeatureSplittable;
+   ThreadStateInteraction * const pThreadStateInteraction = pWork->m_apThreadStateInteraction[iWorker];
+   InteractionScoresTop * const pTop = pWork->m_apTop[iWorker];
+
+   // our caller checked all the feature indexes before launching us
+   char FeatureGroupBuffer[FeatureGroup::GetFeatureGroupCountBytes(k_cDimensionsMax)];
+   FeatureGroup * const pFeatureGroup = reinterpret_cast<FeatureGroup *>(&FeatureGroupBuffer);
+
+   char aFeatureGroupPairBuffers[k_cPairsSharedScanMax][FeatureGroup::GetFeatureGroupCountBytes(2)];
+   const FeatureGroup * apFeatureGroupsShared[k_cPairsSharedScanMax];
+   FloatEbmType * apInteractionScoresShared[k_cPairsSharedScanMax];
+
+   bool bError = false;
+   while(true) {
+      const size_t iBlock = pWork->m_iBlockNext.fetch_add(size_t { 1 }, std::memory_order_relaxed);
+      if(cBlocks <= iBlock) {
+         break;
+      }
+      const InteractionScoresBlock * const pBlock = &pWork->m_aBlocks[iBlock];
+      const size_t iFeatureGroupFirst = pBlock->m_iFeatureGroupFirst;
+      const size_t cFeatureGroupsBlock = pBlock->m_cFeatureGroups;
+      EBM_ASSERT(1 <= cFeatureGroupsBlock);
+      EBM_ASSERT(cFeatureGroupsBlock <= k_cPairsSharedScanMax);
+
+      if(size_t { 1 } == cFeatureGroupsBlock) {
+         FloatEbmType * const pInteractionScore = &pWork->m_aInteractionScores[iFeatureGroupFirst];
+         *pInteractionScore = FloatEbmType { 0 };
+         if(!FillFeatureGroup(
+            pInteractionDetector, 
+            cFeaturesInGroup, 
+            &pWork->m_aFeatureIndexes[iFeatureGroupFirst * cFeaturesInGroup], 
+            abFeatureSplittable,
+            pFeatureGroup
+         )) {
+            const FeatureGroup * const pFeatureGroupConst = pFeatureGroup;
+            bool bPruned;
+            if(PruneBeforeBinning(
+               pThreadStateInteraction, 
+               pInteractionDetector, 
+               size_t { 1 },
+               &pFeatureGroupConst, 
+               &pInteractionScore, 
+               pMarginals, 
+               pTop, 
+               &bPruned
+            )) {
+               bError = true;
+            } else if(!bPruned && CalculateInteractionScoreInternal(
+               pThreadStateInteraction,
+               pInteractionDetector,
+               pFeatureGroup,
+               cSamplesRequiredForChildSplitMin,
+               pInteractionScore,
+               pTop
+            )) {
+               *pInteractionScore = FloatEbmType { 0 };
+               bError = true;
+            }
+         } else if(nullptr != pTop) {
+            ++pTop->m_cFeatureGroupsSkipped;
+            AddInteractionScoreTop(pTop, FloatEbmType { 0 });
+         }
+      } else {
+         EBM_ASSERT(size_t { 2 } == cFeaturesInGroup);
+         size_t cPairsShared = 0;
+         for(size_t iFeatureGroup = iFeatureGroupFirst; iFeatureGroup < iFeatureGroupFirst + cFeatureGroupsBlock; ++iFeatureGroup) {
+            FloatEbmType * const pInteractionScore = &pWork->m_aInteractionScores[iFeatureGroup];
+            *pInteractionScore = FloatEbmType { 0 };
+            FeatureGroup * const pFeatureGroupPair = reinterpret_cast<FeatureGroup *>(&aFeatureGroupPairBuffers[cPairsShared]);
+            if(!FillFeatureGroup(
+               pInteractionDetector, 
+               size_t { 2 }, 
+               &pWork->m_aFeatureIndexes[iFeatureGroup * size_t { 2 }], 
+               abFeatureSplittable,
+               pFeatureGroupPair
+            )) {
+               apFeatureGroupsShared[cPairsShared] = pFeatureGroupPair;
+               apInteractionScoresShared[cPairsShared] = pInteractionScore;
+               ++cPairsShared;
+            } else if(nullptr != pTop) {
+               ++pTop->m_cFeatureGroupsSkipped;
+               AddInteractionScoreTop(pTop, FloatEbmType { 0 });
+            }
+         }
+         if(size_t { 0 } != cPairsShared) {
+            // pruned pairs drop out of the shared pass, which then bins fewer histograms
+            bool abPruned[k_cPairsSharedScanMax];
+            if(PruneBeforeBinning(
+               pThreadStateInteraction,
+               pInteractionDetector,
+               cPairsShared,
+               apFeatureGroupsShared,
+               apInteractionScoresShared,
+               pMarginals,
+               pTop,
+               abPruned
+            )) {
+               cPairsShared = 0;
+               bError = true;
+            } else {
+               size_t cPairsKept = 0;
+               for(size_t iPair = 0; iPair < cPairsShared; ++iPair) {
+                  if(!abPruned[iPair]) {
+                     apFeatureGroupsShared[cPairsKept] = apFeatureGroupsShared[iPair];
+                     apInteractionScoresShared[cPairsKept] = apInteractionScoresShared[iPair];
+                     ++cPairsKept;
+                  }
+               }
+               cPairsShared = cPairsKept;
+            }
+         }
+         if(size_t { 1 } == cPairsShared) {
+            if(CalculateInteractionScoreInternal(
+               pThreadStateInteraction,
+               pInteractionDetector,
+               apFeatureGroupsShared[0],
+               cSamplesRequiredForChildSplitMin,
+               apInteractionScoresShared[0],
+               pTop
+            )) {
+               *apInteractionScoresShared[0] = FloatEbmType { 0 };
+               bError = true;
+            }
+         } else if(size_t { 2 } <= cPairsShared) {
+            if(CalculateInteractionScoresSharedInternal(
+               pThreadStateInteraction,
+               pInteractionDetector,
+               cPairsShared,
+               apFeatureGroupsShared,
+               cSamplesRequiredForChildSplitMin,
+               apInteractionScoresShared,
+               pTop
+            )) {
+               for(size_t iPair = 0; iPair < cPairsShared; ++iPair) {
+                  *apInteractionScoresShared[iPair] = FloatEbmType { 0 };
+               }
+               bError = true;
+            }
+         }
+      }
+   }
+   pWork->m_abError[iWorker] = bError;
+}
+
+// returns the bytes of histogram space that the pair at pFeatureIndexes needs, or 0 if the pair can't be split and won't need any.  Returns 
+// std::numeric_limits<size_t>::max() if the size overflows, which keeps the pair out of any shared pass
+static size_t GetPairHistogramBytes(
+   const InteractionDetector * const pInteractionDetector, 
+   const IntEbmType * const pFeatureIndexes, 
+   const size_t cBytesPerHistogramBucket
+) {
+   char FeatureGroupBuffer[FeatureGroup::GetFeatureGroupCountBytes(2)];
+   FeatureGroup * const pFeatureGroup = reinterpret_cast<FeatureGroup *>(&FeatureGroupBuffer);
+   if(FillFeatureGroup(pInteractionDetector, size_t { 2 }, pFeatureIndexes, nullptr, pFeatureGroup)) {
+      return size_t { 0 };
+   }
+   size_t cTotalBucketsMainSpace;
+   size_t cTotalBuckets;
+   if(GetInteractionBucketCounts(pFeatureGroup, &cTotalBucketsMainSpace, &cTotalBuckets)) {
+      return std::numeric_limits<size_t>::max();
+   }
+   if(IsMultiplyError(cTotalBuckets, cBytesPerHistogramBucket)) {
+      return std::numeric_limits<size_t>::max();
+   }
+   return cTotalBuckets * cBytesPerHistogramBucket;
+}
+
+// groups consecutive pairs that share their first feature into blocks whose histograms together fit within k_cBytesSharedScanHistogramsMax.  
+// Callers that enumerate pairs the usual way, as in (0, 1), (0, 2), ... (1, 2), (1, 3), ..., get long runs of shared first features
+static size_t BuildInteractionScoresBlocks(
+   const InteractionDetector * const pInteractionDetector,
+   const size_t cFeatureGroups,
+   const size_t cFeaturesInGroup,
+   const IntEbmType * const aFeatureIndexes,
+   InteractionScoresBlock * const aBlocks
+) {
+   const size_t cVectorLength = GetVectorLength(pInteractionDetector->GetRuntimeLearningTypeOrCountTargetClasses());
+   const bool bShareScans = size_t { 2 } == cFeaturesInGroup && !GetHistogramBucketSizeOverflow(false, cVectorLength);
+
+   size_t cBlocks = 0;
+   size_t iFeatureGroup = 0;
+   while(iFeatureGroup < cFeatureGroups) {
+      InteractionScoresBlock * const pBlock = &aBlocks[cBlocks];
+      ++cBlocks;
+      pBlock->m_iFeatureGroupFirst = iFeatureGroup;
+      pBlock->m_cFeatureGroups = 1;
+      ++iFeatureGroup;
+      if(bShareScans) {
+         const size_t cBytesPerHistogramBucket = GetHistogramBucketSize(false, cVectorLength);
+         const IntEbmType indexFeatureAnchor = aFeatureIndexes[pBlock->m_iFeatureGroupFirst * size_t { 2 }];
+         size_t cBytesBlock = GetPairHistogramBytes(
+            pInteractionDetector, 
+            &aFeatureIndexes[pBlock->m_iFeatureGroupFirst * size_t { 2 }], 
+            cBytesPerHistogramBucket
+         );
+         while(iFeatureGroup < cFeatureGroups && pBlock->m_cFeatureGroups < k_cPairsSharedScanMax && 
+            indexFeatureAnchor == aFeatureIndexes[iFeatureGroup * size_t { 2 }]) 
+         {
+            const size_t cBytesPair = GetPairHistogramBytes(
+               pInteractionDetector, 
+               &aFeatureIndexes[iFeatureGroup * size_t { 2 }], 
+               cBytesPerHistogramBucket
+            );
+            if(k_cBytesSharedScanHistogramsMax < cBytesBlock || k_cBytesSharedScanHistogramsMax - cBytesBlock < cBytesPair) {
+               break;
+            }
+            cBytesBlock += cBytesPair;
+            ++pBlock->m_cFeatureGroups;
+            ++iFeatureGroup;
+         }
+      }
+   }
+   return cBlocks;
+}
+
+struct InteractionScoreRanked final {
+   FloatEbmType m_score;
+   size_t m_iFeatureGroup;
+};
+static_assert(std::is_standard_layout<InteractionScoreRanked>::value,
+   "We use the struct hack in several places, so disallow non-standard_layout types in general");
+static_assert(std::is_trivial<InteractionScoreRanked>::value,
+   "We use memcpy in several places, so disallow non-trivial types in general");
+static_assert(std::is_pod<InteractionScoreRanked>::value,
+   "We use a lot of C constructs, so disallow non-POD types in general");
+
+class CompareInteractionScoreRanked final {
+public:
+   // highest score first.  Equal scores keep the order our caller gave us so that the ranking doesn't depend on thread timing
+   INLINE_ALWAYS bool operator() (const InteractionScoreRanked & lhs, const InteractionScoreRanked & rhs) const noexcept {
+      if(UNLIKELY(rhs.m_score == lhs.m_score)) {
+         // we do want exact equality here.  Only bit identical scores are ties, and breaking them on the unique index keeps this a strict 
+         // weak ordering (scores are never NaN) while making the ranking deterministic
+         // https://medium.com/@shiansu/strict-weak-ordering-and-the-c-stl-f7dcfa4d4e07
+         return UNPREDICTABLE(lhs.m_iFeatureGroup < rhs.m_iFeatureGroup);
+      } else {
+         return UNPREDICTABLE(rhs.m_score < lhs.m_score);
+      }
+   }
+};
+
+class CompareInteractionScoreIndex final {
+public:
+   // puts candidates back in the order our caller gave them so that pairs sharing a first feature stay in runs that can be binned together
+   INLINE_ALWAYS bool operator() (const InteractionScoreRanked & lhs, const InteractionScoreRanked & rhs) const noexcept {
+      return UNPREDICTABLE(lhs.m_iFeatureGroup < rhs.m_iFeatureGroup);
+   }
+};
+
+// scores every feature group into aInteractionScores in the order given.  Our caller has already checked the feature indexes.  If 
+// cFeatureGroupsTop is not zero, feature groups that provably can't be among the best cFeatureGroupsTop are given k_interactionScorePruned 
+// instead of their score, and the counts of skipped and pruned feature groups are returned
+static bool ScoreFeatureGroups(
+   InteractionDetector * const pInteractionDetector,
+   const size_t cFeatureGroups,
+   const size_t cFeaturesInGroup,
+   const IntEbmType * const aFeatureIndexes,
+   const size_t cSamplesRequiredForChildSplitMin,
+   const size_t cFeatureGroupsTop,
+   const InteractionMarginals * const pMarginals,
+   FloatEbmType * const aInteractionScores,
+   size_t * const pcFeatureGroupsSkippedOut,
+   size_t * const pcFeatureGroupsPrunedOut
+) {
+   EBM_ASSERT(1 <= cFeatureGroups);
+   EBM_ASSERT(1 <= cFeaturesInGroup);
+   EBM_ASSERT(cFeatureGroupsTop <= cFeatureGroups);
+   EBM_ASSERT(size_t { 0 } == cFeatureGroupsTop || nullptr != pMarginals && nullptr != pcFeatureGroupsSkippedOut && nullptr != pcFeatureGroupsPrunedOut);
+
+   InteractionScoresBlock * const aBlocks = EbmMalloc<InteractionScoresBlock>(cFeatureGroups);
+   if(nullptr == aBlocks) {
+      LOG_0(TraceLevelWarning, "WARNING ScoreFeatureGroups nullptr == aBlocks");
+      return true;
+   }
+   const size_t cBlocks = BuildInteractionScoresBlocks(pInteractionDetector, cFeatureGroups, cFeaturesInGroup, aFeatureIndexes, aBlocks);
+
+   const size_t cWorkersMax = GetCountWorkersMax();
+   const size_t cWorkers = cBlocks < cWorkersMax ? cBlocks : cWorkersMax;
+
+   InteractionScoresWork work;
+   work.m_pInteractionDetector = pInteractionDetector;
+   work.m_cBlocks = cBlocks;
+   work.m_aBlocks = aBlocks;
+   work.m_cFeaturesInGroup = cFeaturesInGroup;
+   work.m_aFeatureIndexes = aFeatureIndexes;
+   work.m_cSamplesRequiredForChildSplitMin = cSamplesRequiredForChildSplitMin;
+   work.m_aInteractionScores = aInteractionScores;
+   work.m_pMarginals = pMarginals;
+   work.m_iBlockNext.store(size_t { 0 }, std::memory_order_relaxed);
+
+   InteractionScoresTop * aTop = nullptr;
+   FloatEbmType * aTopScores = nullptr;
+   if(size_t { 0 } != cFeatureGroupsTop) {
+      // cFeatureGroupsTop <= cFeatureGroups, and cWorkers <= k_cWorkersMax, so this can only overflow on truly enormous requests
+      if(IsMultiplyError(cWorkers, cFeatureGroupsTop)) {
+         LOG_0(TraceLevelWarning, "WARNING ScoreFeatureGroups IsMultiplyError(cWorkers, cFeatureGroupsTop)");
+         free(aBlocks);
+         return true;
+      }
+      aTop = EbmMalloc<InteractionScoresTop>(cWorkers);
+      aTopScores = EbmMalloc<FloatEbmType>(cWorkers * cFeatureGroupsTop);
+      if(nullptr == aTop || nullptr == aTopScores) {
+         LOG_0(TraceLevelWarning, "WARNING ScoreFeatureGroups nullptr == aTop || nullptr == aTopScores");
+         free(aTopScores);
+         free(aTop);
+         free(aBlocks);
+         return true;
+      }
+   }
+   for(size_t iWorker = 0; iWorker < cWorkers; ++iWorker) {
+      InteractionScoresTop * pTop = nullptr;
+      if(nullptr != aTop) {
+         pTop = &aTop[iWorker];
+         pTop->m_cScoresMax = cFeatureGroupsTop;
+         pTop->m_cScores = 0;
+         pTop->m_aScores = &aTopScores[iWorker * cFeatureGroupsTop];
+         pTop->m_boundSlack = pMarginals->m_boundSlack;
+         pTop->m_cFeatureGroupsSkipped = 0;
+         pTop->m_cFeatureGroupsPruned = 0;
+      }
+      work.m_apTop[iWorker] = pTop;
+   }
+
+   bool bError = false;
+
+   // each worker gets its own ThreadStateInteraction so that the histogram buffers are re-used across all the feature groups it scores
+   size_t cThreadStates = 0;
+   while(cThreadStates < cWorkers) {
+      ThreadStateInteraction * const pThreadStateInteraction = ThreadStateInteraction::Allocate(pInteractionDetector);
+      if(nullptr == pThreadStateInteraction) {
+         LOG_0(TraceLevelWarning, "WARNING ScoreFeatureGroups nullptr == pThreadStateInteraction");
+         bError = true;
+         break;
+      }
+      work.m_apThreadStateInteraction[cThreadStates] = pThreadStateInteraction;
+      work.m_abError[cThreadStates] = false;
+      ++cThreadStates;
+   }
+
+   if(!bError) {
+      LOG_N(
+         TraceLevelVerbose, 
+         "ScoreFeatureGroups scoring %zu feature groups on %zu samples in %zu blocks with %zu workers", 
+         cFeatureGroups, 
+         pInteractionDetector->GetDataSetByFeature()->GetCountSamples(),
+         cBlocks, 
+         cWorkers
+      );
+      ExecuteParallelWork(cWorkers, &CalculateInteractionScoresWorker, &work);
+      for(size_t iWorker = 0; iWorker < cWorkers; ++iWorker) {
+         bError = bError || work.m_abError[iWorker];
+      }
+      if(nullptr != aTop) {
+         size_t cFeatureGroupsSkipped = 0;
+         size_t cFeatureGroupsPruned = 0;
+         for(size_t iWorker = 0; iWorker < cWorkers; ++iWorker) {
+            cFeatureGroupsSkipped += aTop[iWorker].m_cFeatureGroupsSkipped;
+            cFeatureGroupsPruned += aTop[iWorker].m_cFeatureGroupsPruned;
+         }
+         *pcFeatureGroupsSkippedOut = cFeatureGroupsSkipped;
+         *pcFeatureGroupsPrunedOut = cFeatureGroupsPruned;
+         LOG_N(
+            TraceLevelVerbose,
+            "ScoreFeatureGroups skipped %zu and pruned %zu of %zu feature groups",
+            cFeatureGroupsSkipped,
+            cFeatureGroupsPruned,
+            cFeatureGroups
+         );
+      }
+   }
+
+   for(size_t iThreadState = 0; iThreadState < cThreadStates; ++iThreadState) {
+      ThreadStateInteraction::Free(work.m_apThreadStateInteraction[iThreadState]);
+   }
+   free(aTopScores);
+   free(aTop);
+   free(aBlocks);
+   return bError;
+}
+
+// Scores every feature group on a random subsample of cSamplesScreen samples, then rescores the cFeatureGroupsRefine best of those on all 
+// the samples.  The rescored candidates are left in aRanked[0, cFeatureGroupsRefine) in no particular order.  The subsample only depends 
+// on randomSeed, so the result is deterministic for a given seed regardless of how many workers we get
+static bool ScreenAndRefineInteractionScores(
+   InteractionDetector * const pInteractionDetector,
+   const size_t cFeatureGroups,
+   const size_t cFeaturesInGroup,
+   const IntEbmType * const aFeatureIndexes,
+   const size_t cSamplesRequiredForChildSplitMin,
+   const SeedEbmType randomSeed,
+   const size_t cSamplesScreen,
+   const size_t cFeatureGroupsRefine,
+   FloatEbmType * const aInteractionScores,
+   InteractionScoreRanked * const aRanked
+) {
+   const size_t cSamples = pInteractionDetector->GetDataSetByFeature()->GetCountSamples();
+   EBM_ASSERT(1 <= cSamplesScreen);
+   EBM_ASSERT(cSamplesScreen < cSamples);
+   EBM_ASSERT(1 <= cFeatureGroupsRefine);
+   EBM_ASSERT(cFeatureGroupsRefine < cFeatureGroups);
+
+   RandomStream randomStream;
+   randomStream.InitializeUnsigned(randomSeed, k_interactionScreenRandomizationMix);
+   InteractionDetector * const pInteractionDetectorScreen = InteractionDetector::AllocateSubsample(
+      pInteractionDetector, 
+      cSamplesScreen, 
+      &randomStream
+   );
+   if(nullptr == pInteractionDetectorScreen) {
+      LOG_0(TraceLevelWarning, "WARNING ScreenAndRefineInteractionScores nullptr == pInteractionDetectorScreen");
+      return true;
+   }
+
+   // the subsample has proportionally fewer samples in every cell, so we scale the minimum child size down with it
+   size_t cSamplesRequiredForChildSplitMinScreen = static_cast<size_t>(
+      static_cast<FloatEbmType>(cSamplesRequiredForChildSplitMin) * static_cast<FloatEbmType>(cSamplesScreen) / 
+      static_cast<FloatEbmType>(cSamples)
+   );
+   if(cSamplesRequiredForChildSplitMinScreen < size_t { 1 }) {
+      cSamplesRequiredForChildSplitMinScreen = size_t { 1 };
+   }
+
+   const bool bErrorScreen = ScoreFeatureGroups(
+      pInteractionDetectorScreen,
+      cFeatureGroups,
+      cFeaturesInGroup,
+      aFeatureIndexes,
+      cSamplesRequiredForChildSplitMinScreen,
+      size_t { 0 },
+      nullptr,
+      aInteractionScores,
+      nullptr,
+      nullptr
+   );
+   InteractionDetector::Free(pInteractionDetectorScreen);
+   if(bErrorScreen) {
+      return true;
+   }
+
+   for(size_t iFeatureGroup = 0; iFeatureGroup < cFeatureGroups; ++iFeatureGroup) {
+      aRanked[iFeatureGroup].m_score = aInteractionScores[iFeatureGroup];
+      aRanked[iFeatureGroup].m_iFeatureGroup = iFeatureGroup;
+   }
+   std::partial_sort(aRanked, aRanked + cFeatureGroupsRefine, aRanked + cFeatureGroups, CompareInteractionScoreRanked());
+   std::sort(aRanked, aRanked + cFeatureGroupsRefine, CompareInteractionScoreIndex());
+
+   // cFeatureGroupsRefine * cFeaturesInGroup < cFeatureGroups * cFeaturesInGroup, which our caller checked for overflow
+   IntEbmType * const aFeatureIndexesRefine = EbmMalloc<IntEbmType>(cFeatureGroupsRefine * cFeaturesInGroup);
+   if(nullptr == aFeatureIndexesRefine) {
+      LOG_0(TraceLevelWarning, "WARNING ScreenAndRefineInteractionScores nullptr == aFeatureIndexesRefine");
+      return true;
+   }
+   for(size_t iRefine = 0; iRefine < cFeatureGroupsRefine; ++iRefine) {
+      memcpy(
+         &aFeatureIndexesRefine[iRefine * cFeaturesInGroup], 
+         &aFeatureIndexes[aRanked[iRefine].m_iFeatureGroup * cFeaturesInGroup], 
+         sizeof(*aFeatureIndexesRefine) * cFeaturesInGroup
+      );
+   }
+
+   const bool bErrorRefine = ScoreFeatureGroups(
+      pInteractionDetector,
+      cFeatureGroupsRefine,
+      cFeaturesInGroup,
+      aFeatureIndexesRefine,
+      cSamplesRequiredForChildSplitMin,
+      size_t { 0 },
+      nullptr,
+      aInteractionScores,
+      nullptr,
+      nullptr
+   );
+   free(aFeatureIndexesRefine);
+   if(bErrorRefine) {
+      return true;
+   }
+
+   for(size_t iRefine = 0; iRefine < cFeatureGroupsRefine; ++iRefine) {
+      aRanked[iRefine].m_score = aInteractionScores[iRefine];
+   }
+   return false;
+}
+
+static void FreeInteractionMarginals(InteractionMarginals * const pMarginals) {
+   free(pMarginals->m_aSumSquaresBySample);
+   free(pMarginals->m_aiCoarseBinsBySample);
+   free(pMarginals->m_aiCoarseBinsBySampleFirst);
+   free(pMarginals->m_aSlabExcessMax);
+   free(pMarginals->m_aiCoarseBins);
+   free(pMarginals->m_aiCoarseBinsFirst);
+   free(pMarginals->m_abFeatureSplittable);
+}
+
+// Takes the 1D bin counts once per feature used in aFeatureIndexes, rather than once per feature group.  Every quadrant of a pair needs 
+// cSamplesRequiredForChildSplitMin samples, so both sides of the cut in each feature need twice that.  A feature without such a cut can't 
+// be split together with any other feature.  The same counts group each feature's bins into up to k_cInteractionCoarseBins coarse bins 
+// of roughly equal sample counts, which keeps any one slab of the coarse tensor from holding much of the residuals
+static bool InitializeInteractionMarginals(
+   const InteractionDetector * const pInteractionDetector,
+   const size_t cFeatureIndexes,
+   const IntEbmType * const aFeatureIndexes,
+   const size_t cSamplesRequiredForChildSplitMin,
+   InteractionMarginals * const pMarginals
+) {
+   const size_t cFeatures = pInteractionDetector->GetCountFeatures();
+   const Feature * const aFeatures = pInteractionDetector->GetFeatures();
+   const DataSetByFeature * const pDataSet = pInteractionDetector->GetDataSetByFeature();
+   const size_t cSamples = pDataSet->GetCountSamples();
+   const size_t cVectorLength = GetVectorLength(pInteractionDetector->GetRuntimeLearningTypeOrCountTargetClasses());
+   EBM_ASSERT(1 <= cFeatures);
+   EBM_ASSERT(1 <= cSamples);
+
+   pMarginals->m_aiCoarseBins = nullptr;
+   pMarginals->m_aiCoarseBinsBySample = nullptr;
+   // unused features stay true, but nothing will look at them
+   pMarginals->m_abFeatureSplittable = EbmMalloc<bool>(cFeatures);
+   pMarginals->m_aiCoarseBinsFirst = EbmMalloc<size_t>(cFeatures);
+   pMarginals->m_aiCoarseBinsBySampleFirst = EbmMalloc<size_t>(cFeatures);
+   pMarginals->m_aSumSquaresBySample = EbmMalloc<FloatEbmType>(cSamples);
+   pMarginals->m_aSlabExcessMax = EbmMalloc<FloatEbmType>(cFeatures);
+   bool * const abFeatureUsed = EbmMalloc<bool>(cFeatures);
+   if(nullptr == pMarginals->m_abFeatureSplittable || nullptr == pMarginals->m_aiCoarseBinsFirst || 
+      nullptr == pMarginals->m_aiCoarseBinsBySampleFirst || nullptr == pMarginals->m_aSumSquaresBySample ||
+      nullptr == pMarginals->m_aSlabExcessMax || nullptr == abFeatureUsed) 
+   {
+      LOG_0(TraceLevelWarning, "WARNING InitializeInteractionMarginals out of memory");
+      free(abFeatureUsed);
+      FreeInteractionMarginals(pMarginals);
+      return true;
+   }
+   bool * const abFeatureSplittable = pMarginals->m_abFeatureSplittable;
+   for(size_t iFeature = 0; iFeature < cFeatures; ++iFeature) {
+      abFeatureSplittable[iFeature] = true;
+      pMarginals->m_aSlabExcessMax[iFeature] = FloatEbmType { 0 };
+      abFeatureUsed[iFeature] = false;
+   }
+   size_t cBinsMax = 0;
+   for(size_t iFeatureIndex = 0; iFeatureIndex < cFeatureIndexes; ++iFeatureIndex) {
+      // our caller checked these indexes already
+      const size_t iFeature = static_cast<size_t>(aFeatureIndexes[iFeatureIndex]);
+      EBM_ASSERT(iFeature < cFeatures);
+      abFeatureUsed[iFeature] = true;
+      const size_t cBins = aFeatures[iFeature].GetCountBins();
+      cBinsMax = cBinsMax < cBins ? cBins : cBinsMax;
+   }
+   // the bins of the used features all came out of memory that we hold, so adding them up can't overflow
+   size_t cBinsUsed = 0;
+   size_t cFeaturesUsed = 0;
+   for(size_t iFeature = 0; iFeature < cFeatures; ++iFeature) {
+      pMarginals->m_aiCoarseBinsFirst[iFeature] = cBinsUsed;
+      pMarginals->m_aiCoarseBinsBySampleFirst[iFeature] = cFeaturesUsed * cSamples;
+      if(abFeatureUsed[iFeature]) {
+         cBinsUsed += aFeatures[iFeature].GetCountBins();
+         ++cFeaturesUsed;
+      }
+   }
+   if(IsMultiplyError(cFeaturesUsed, cSamples)) {
+      LOG_0(TraceLevelWarning, "WARNING InitializeInteractionMarginals IsMultiplyError(cFeaturesUsed, cSamples)");
+      free(abFeatureUsed);
+      FreeInteractionMarginals(pMarginals);
+      return true;
+   }
+
+   // each fine bin, and then each coarse bin, holds its sum of squared residuals followed by its sumResidualError for each vector entry.  
+   // cVectorLength comes from a ptrdiff_t class count, so adding 1 to it can't overflow
+   const size_t cFloatsPerBin = size_t { 1 } + cVectorLength;
+   if(IsMultiplyError(cBinsMax, cFloatsPerBin)) {
+      LOG_0(TraceLevelWarning, "WARNING InitializeInteractionMarginals IsMultiplyError(cBinsMax, cFloatsPerBin)");
+      free(abFeatureUsed);
+      FreeInteractionMarginals(pMarginals);
+      return true;
+   }
+   size_t * const acSamplesInBin = 0 == cBinsMax ? nullptr : EbmMalloc<size_t>(cBinsMax);
+   FloatEbmType * const aBinSums = 0 == cBinsMax ? nullptr : EbmMalloc<FloatEbmType>(cBinsMax * cFloatsPerBin);
+   FloatEbmType * const aCoarseBinSums = EbmMalloc<FloatEbmType>(cFloatsPerBin);
+   pMarginals->m_aiCoarseBins = 0 == cBinsUsed ? nullptr : EbmMalloc<unsigned char>(cBinsUsed);
+   pMarginals->m_aiCoarseBinsBySample = 0 == cFeaturesUsed ? nullptr : EbmMalloc<unsigned char>(cFeaturesUsed * cSamples);
+   if(nullptr == aCoarseBinSums || 0 != cBinsMax && (nullptr == acSamplesInBin || nullptr == aBinSums || 
+      nullptr == pMarginals->m_aiCoarseBins || nullptr == pMarginals->m_aiCoarseBinsBySample)) 
+   {
+      LOG_0(TraceLevelWarning, "WARNING InitializeInteractionMarginals out of memory");
+      free(aCoarseBinSums);
+      free(aBinSums);
+      free(acSamplesInBin);
+      free(abFeatureUsed);
+      FreeInteractionMarginals(pMarginals);
+      return true;
+   }
+
+   // if doubling overflows then no side of any cut can ever have enough samples
+   const size_t cSamplesSideMin = IsAddError(cSamplesRequiredForChildSplitMin, cSamplesRequiredForChildSplitMin) ? 
+      std::numeric_limits<size_t>::max() : cSamplesRequiredForChildSplitMin + cSamplesRequiredForChildSplitMin;
+
+   for(size_t iFeature = 0; iFeature < cFeatures; ++iFeature) {
+      const size_t cBins = aFeatures[iFeature].GetCountBins();
+      if(abFeatureUsed[iFeature] && size_t { 2 } <= cBins) {
+         for(size_t iBin = 0; iBin < cBins; ++iBin) {
+            acSamplesInBin[iBin] = 0;
+         }
+         for(size_t iFloat = 0; iFloat < cBins * cFloatsPerBin; ++iFloat) {
+            aBinSums[iFloat] = FloatEbmType { 0 };
+         }
+         BitPackedBinReader binReader;
+         binReader.Initialize(
+            pDataSet->GetInputDataPointer(&aFeatures[iFeature]), 
+            DataSetByFeature::GetCountItemsPerBitPackedDataUnit(&aFeatures[iFeature])
+         );
+         const FloatEbmType * pResidualError = pDataSet->GetResidualPointer();
+         for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+            const size_t iBin = binReader.Next();
+            EBM_ASSERT(iBin < cBins);
+            ++acSamplesInBin[iBin];
+            FloatEbmType * const pBinSums = &aBinSums[iBin * cFloatsPerBin];
+            FloatEbmType sumSquares = FloatEbmType { 0 };
+            for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
+               const FloatEbmType residualError = pResidualError[iVector];
+               pBinSums[1 + iVector] += residualError;
+               sumSquares += residualError * residualError;
+            }
+            pBinSums[0] += sumSquares;
+            pResidualError += cVectorLength;
+         }
+         bool bSplittable = false;
+         size_t cSamplesLow = 0;
+         for(size_t iBin = 0; iBin < cBins - 1; ++iBin) {
+            cSamplesLow += acSamplesInBin[iBin];
+            if(cSamplesSideMin <= cSamplesLow && cSamplesSideMin <= cSamples - cSamplesLow) {
+               bSplittable = true;
+               break;
+            }
+         }
+         abFeatureSplittable[iFeature] = bSplittable;
+
+         // a feature with few enough bins keeps them as its coarse bins.  Otherwise we start the next coarse bin once the fine bins before 
+         // it hold the share of the samples that the coarse bins before it should
+         unsigned char * const aiCoarseBins = &pMarginals->m_aiCoarseBins[pMarginals->m_aiCoarseBinsFirst[iFeature]];
+         const size_t cSamplesPerCoarseBin = cSamples / k_cInteractionCoarseBins;
+         size_t iCoarseBin = 0;
+         size_t cSamplesBefore = 0;
+         const bool bKeepBins = cBins <= k_cInteractionCoarseBins;
+         for(size_t iBin = 0; iBin < cBins; ++iBin) {
+            if(bKeepBins) {
+               iCoarseBin = iBin;
+            } else if(size_t { 0 } != iBin && iCoarseBin + 1 < k_cInteractionCoarseBins && 
+               (iCoarseBin + 1) * cSamplesPerCoarseBin <= cSamplesBefore) 
+            {
+               ++iCoarseBin;
+            }
+            aiCoarseBins[iBin] = static_cast<unsigned char>(iCoarseBin);
+            cSamplesBefore += acSamplesInBin[iBin];
+         }
+         unsigned char * const aiCoarseBinsBySample = 
+            &pMarginals->m_aiCoarseBinsBySample[pMarginals->m_aiCoarseBinsBySampleFirst[iFeature]];
+         binReader.Initialize(
+            pDataSet->GetInputDataPointer(&aFeatures[iFeature]), 
+            DataSetByFeature::GetCountItemsPerBitPackedDataUnit(&aFeatures[iFeature])
+         );
+         for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+            aiCoarseBinsBySample[iSample] = aiCoarseBins[binReader.Next()];
+         }
+
+         FloatEbmType slabExcessMax = FloatEbmType { 0 };
+         size_t iBinCoarseFirst = 0;
+         while(iBinCoarseFirst < cBins) {
+            size_t iBinCoarseEnd = iBinCoarseFirst + 1;
+            while(iBinCoarseEnd < cBins && aiCoarseBins[iBinCoarseFirst] == aiCoarseBins[iBinCoarseEnd]) {
+               ++iBinCoarseEnd;
+            }
+            // a coarse bin with only 1 fine bin never has a cut inside it
+            if(size_t { 2 } <= iBinCoarseEnd - iBinCoarseFirst) {
+               size_t cSamplesCoarse = 0;
+               for(size_t iFloat = 0; iFloat < cFloatsPerBin; ++iFloat) {
+                  aCoarseBinSums[iFloat] = FloatEbmType { 0 };
+               }
+               for(size_t iBin = iBinCoarseFirst; iBin < iBinCoarseEnd; ++iBin) {
+                  cSamplesCoarse += acSamplesInBin[iBin];
+                  for(size_t iFloat = 0; iFloat < cFloatsPerBin; ++iFloat) {
+                     aCoarseBinSums[iFloat] += aBinSums[iBin * cFloatsPerBin + iFloat];
+                  }
+               }
+               if(size_t { 0 } != cSamplesCoarse) {
+                  FloatEbmType slabExcess = aCoarseBinSums[0];
+                  for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
+                     slabExcess -= EbmStatistics::ComputeNodeSplittingScore(
+                        aCoarseBinSums[1 + iVector], 
+                        static_cast<FloatEbmType>(cSamplesCoarse)
+                     );
+                  }
+                  slabExcessMax = slabExcessMax < slabExcess ? slabExcess : slabExcessMax;
+               }
+            }
+            iBinCoarseFirst = iBinCoarseEnd;
+         }
+         pMarginals->m_aSlabExcessMax[iFeature] = slabExcessMax;
+      }
+   }
+   free(aCoarseBinSums);
+   free(aBinSums);
+   free(acSamplesInBin);
+   free(abFeatureUsed);
+
+   // Every score and bound that we compare adds up terms of sumResidualError^2 / cSamples, and the bound adds up the residuals of each 
+   // term in a different order than the score does.  A sum of n values in any order is off by at most g = n * eps / (1 - n * eps) times 
+   // the sum of their magnitudes.  For a cell whose squared residuals add up to q, Cauchy-Schwarz limits both sumResidualError and the 
+   // sum of the magnitudes to sqrt(cSamples * q), so its sumResidualError^2 / cSamples is off by at most about 2 * g * q.  The cells 
+   // split the samples, so a whole score is off by at most about 2 * g times the sum of all the squared residuals, plus g times that 
+   // again for adding up the terms and the positive excesses of the coarse bound.  The bound and the score can each be off by that much 
+   // in opposite directions, so we leave room for 8 * g of the squared residuals.  No sum has more than cSamples * cVectorLength terms
+   FloatEbmType sumSquares = FloatEbmType { 0 };
+   const FloatEbmType * pResidualError = pDataSet->GetResidualPointer();
+   for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+      FloatEbmType sumSquaresSample = FloatEbmType { 0 };
+      for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
+         sumSquaresSample += pResidualError[iVector] * pResidualError[iVector];
+      }
+      pMarginals->m_aSumSquaresBySample[iSample] = sumSquaresSample;
+      sumSquares += sumSquaresSample;
+      pResidualError += cVectorLength;
+   }
+   const FloatEbmType termsEpsilon = static_cast<FloatEbmType>(cSamples) * static_cast<FloatEbmType>(cVectorLength) * 
+      std::numeric_limits<FloatEbmType>::epsilon();
+   // sums that long are far past any dataset we could hold, but if we ever see one then the rounding isn't bounded and we never prune
+   pMarginals->m_boundSlack = termsEpsilon < FloatEbmType { 0.5 } ? 
+      FloatEbmType { 8 } * termsEpsilon / (FloatEbmType { 1 } - termsEpsilon) * sumSquares : 
+      std::numeric_limits<FloatEbmType>::infinity();
+   return false;
+}
+
+// cSamplesScreen of 0 scores every feature group exactly.  Otherwise the ranking comes from ScreenAndRefineInteractionScores.  If bPrune 
+// is set, exact scoring of pairs skips any pair that provably can't be among the best countFeatureGroupsTop
+static IntEbmType CalculateInteractionScoresInternal(
+   InteractionDetector * const pInteractionDetector,
+   const IntEbmType countFeatureGroups,
+   const IntEbmType countFeaturesInGroup,
+   const IntEbmType * const featureIndexes,
+   const IntEbmType countSamplesRequiredForChildSplitMin,
+   const SeedEbmType randomSeed,
+   const size_t cSamplesScreen,
+   const size_t cFeatureGroupsRefine,
+   const bool bPrune,
+   const IntEbmType countFeatureGroupsTop,
+   FloatEbmType * const interactionScoresOut,
+   IntEbmType * const featureGroupIndexesOut,
+   size_t * const pcFeatureGroupsSkippedOut,
+   size_t * const pcFeatureGroupsPrunedOut
+) {
+   EBM_ASSERT(nullptr != pInteractionDetector);
+   EBM_ASSERT(size_t { 0 } == cSamplesScreen || IntEbmType { 1 } <= countFeatureGroupsTop);
+   EBM_ASSERT(!bPrune || size_t { 0 } == cSamplesScreen && IntEbmType { 1 } <= countFeatureGroupsTop);
+   EBM_ASSERT(!bPrune || nullptr != pcFeatureGroupsSkippedOut && nullptr != pcFeatureGroupsPrunedOut);
+
+   if(bPrune) {
+      *pcFeatureGroupsSkippedOut = 0;
+      *pcFeatureGroupsPrunedOut = 0;
+   }
+
+   if(countFeatureGroups < 0) {
+      LOG_0(TraceLevelError, "ERROR CalculateInteractionScores countFeatureGroups must be positive");
+      return IntEbmType { 1 };
+   }
+   if(!IsNumberConvertable<size_t>(countFeatureGroups)) {
+      LOG_0(TraceLevelError, "ERROR CalculateInteractionScores countFeatureGroups too large to index");
+      return IntEbmType { 1 };
+   }
+   const size_t cFeatureGroups = static_cast<size_t>(countFeatureGroups);
+
+   if(countFeaturesInGroup < 0) {
+      LOG_0(TraceLevelError, "ERROR CalculateInteractionScores countFeaturesInGroup must be positive");
+      return IntEbmType { 1 };
+   }
+   if(!IsNumberConvertable<size_t>(countFeaturesInGroup)) {
+      LOG_0(TraceLevelError, "ERROR CalculateInteractionScores countFeaturesInGroup too large to index");
+      return IntEbmType { 1 };
+   }
+   const size_t cFeaturesInGroup = static_cast<size_t>(countFeaturesInGroup);
+   if(k_cDimensionsMax < cFeaturesInGroup) {
+      // if we try to run with more than k_cDimensionsMax we'll exceed our memory capacity, so let's exit here instead
+      LOG_0(TraceLevelWarning, "WARNING CalculateInteractionScores k_cDimensionsMax < cFeaturesInGroup");
+      return IntEbmType { 1 };
+   }
+
+   if(countFeatureGroupsTop < 0) {
+      LOG_0(TraceLevelError, "ERROR CalculateInteractionScores countFeatureGroupsTop must be positive");
+      return IntEbmType { 1 };
+   }
+   // 0 means return every feature group in the order given.  Otherwise we return the best countFeatureGroupsTop in ranked order
+   size_t cFeatureGroupsOut = cFeatureGroups;
+   if(IntEbmType { 0 } != countFeatureGroupsTop) {
+      if(nullptr == featureGroupIndexesOut) {
+         LOG_0(TraceLevelError, "ERROR CalculateInteractionScores featureGroupIndexesOut cannot be nullptr if 0 < countFeatureGroupsTop");
+         return IntEbmType { 1 };
+      }
+      if(IsNumberConvertable<size_t>(countFeatureGroupsTop) && static_cast<size_t>(countFeatureGroupsTop) < cFeatureGroups) {
+         cFeatureGroupsOut = static_cast<size_t>(countFeatureGroupsTop);
+      }
+   }
+
+   if(size_t { 0 } == cFeatureGroups) {
+      LOG_0(TraceLevelInfo, "INFO CalculateInteractionScores zero feature groups");
+      return IntEbmType { 0 };
+   }
+   if(nullptr == interactionScoresOut) {
+      LOG_0(TraceLevelError, "ERROR CalculateInteractionScores interactionScoresOut cannot be nullptr if 0 < countFeatureGroups");
+      return IntEbmType { 1 };
+   }
+   if(IsMultiplyError(cFeatureGroups, cFeaturesInGroup)) {
+      LOG_0(TraceLevelError, "ERROR CalculateInteractionScores IsMultiplyError(cFeatureGroups, cFeaturesInGroup)");
+      return IntEbmType { 1 };
+   }
+   const size_t cFeatureIndexes = cFeatureGroups * cFeaturesInGroup;
+   if(0 != cFeatureIndexes && nullptr == featureIndexes) {
+      LOG_0(TraceLevelError, "ERROR CalculateInteractionScores featureIndexes cannot be nullptr if 0 < countFeatureGroups * countFeaturesInGroup");
+      return IntEbmType { 1 };
+   }
+
+   // check all the indexes here on our thread so that the workers don't need to log errors or fail part way through
+   for(size_t iFeatureIndex = 0; iFeatureIndex < cFeatureIndexes; ++iFeatureIndex) {
+      const IntEbmType indexFeatureInterop = featureIndexes[iFeatureIndex];
+      if(indexFeatureInterop < 0) {
+         LOG_0(TraceLevelError, "ERROR CalculateInteractionScores featureIndexes value cannot be negative");
+         return IntEbmType { 1 };
+      }
+      if(!IsNumberConvertable<size_t>(indexFeatureInterop)) {
+         LOG_0(TraceLevelError, "ERROR CalculateInteractionScores featureIndexes value too big to reference memory");
+         return IntEbmType { 1 };
+      }
+      if(pInteractionDetector->GetCountFeatures() <= static_cast<size_t>(indexFeatureInterop)) {
+         LOG_0(TraceLevelError, "ERROR CalculateInteractionScores featureIndexes value must be less than the number of features");
+         return IntEbmType { 1 };
+      }
+   }
+
+   FloatEbmType * aInteractionScores = interactionScoresOut;
+   InteractionScoreRanked * aRanked = nullptr;
+   if(IntEbmType { 0 } != countFeatureGroupsTop) {
+      aInteractionScores = EbmMalloc<FloatEbmType>(cFeatureGroups);
+      aRanked = EbmMalloc<InteractionScoreRanked>(cFeatureGroups);
+      if(nullptr == aInteractionScores || nullptr == aRanked) {
+         LOG_0(TraceLevelWarning, "WARNING CalculateInteractionScores nullptr == aInteractionScores || nullptr == aRanked");
+         free(aInteractionScores);
+         free(aRanked);
+         return IntEbmType { 1 };
+      }
+   }
+
+   IntEbmType ret = IntEbmType { 0 };
+   // the number of feature groups in aRanked that have a final score
+   size_t cFeatureGroupsRanked = cFeatureGroups;
+   const size_t cSamples = pInteractionDetector->GetDataSetByFeature()->GetCountSamples();
+   if(size_t { 0 } == cFeaturesInGroup || 0 == cSamples ||
+      ptrdiff_t { 0 } == pInteractionDetector->GetRuntimeLearningTypeOrCountTargetClasses() ||
+      ptrdiff_t { 1 } == pInteractionDetector->GetRuntimeLearningTypeOrCountTargetClasses()) 
+   {
+      // same as CalculateInteractionScore, these have no basis for an interaction, so every feature group gets the lowest score possible
+      LOG_0(TraceLevelInfo, "INFO CalculateInteractionScores empty feature groups, zero samples, or target with 0/1 classes");
+      for(size_t iFeatureGroup = 0; iFeatureGroup < cFeatureGroups; ++iFeatureGroup) {
+         aInteractionScores[iFeatureGroup] = FloatEbmType { 0 };
+      }
+   } else {
+      size_t cSamplesRequiredForChildSplitMin = size_t { 1 }; // this is the min value
+      if(IntEbmType { 1 } <= countSamplesRequiredForChildSplitMin) {
+         cSamplesRequiredForChildSplitMin = static_cast<size_t>(countSamplesRequiredForChildSplitMin);
+         if(!IsNumberConvertable<size_t>(countSamplesRequiredForChildSplitMin)) {
+            // we can never exceed a size_t number of samples, so let's just set it to the maximum if we were going to overflow because it will 
+            // generate the same results as if we used the true number
+            cSamplesRequiredForChildSplitMin = std::numeric_limits<size_t>::max();
+         }
+      } else {
+         LOG_0(TraceLevelWarning, "WARNING CalculateInteractionScores countSamplesRequiredForChildSplitMin can't be less than 1.  Adjusting to 1.");
+      }
+
+      // screening only pays off if it removes both samples and feature groups.  Otherwise the exact scores are what we'd return anyways
+      if(size_t { 0 } != cSamplesScreen && cSamplesScreen < cSamples && cFeatureGroupsRefine < cFeatureGroups) {
+         EBM_ASSERT(nullptr != aRanked);
+         EBM_ASSERT(cFeatureGroupsOut <= cFeatureGroupsRefine);
+         if(ScreenAndRefineInteractionScores(
+            pInteractionDetector,
+            cFeatureGroups,
+            cFeaturesInGroup,
+            featureIndexes,
+            cSamplesRequiredForChildSplitMin,
+            randomSeed,
+            cSamplesScreen,
+            cFeatureGroupsRefine,
+            aInteractionScores,
+            aRanked
+         )) {
+            ret = IntEbmType { 1 };
+         }
+         cFeatureGroupsRanked = cFeatureGroupsRefine;
+      } else {
+         // our bound only covers the pair and triple sweeps, and there's nothing to prune if every feature group is returned anyways
+         const size_t cFeatureGroupsTop = bPrune && (size_t { 2 } == cFeaturesInGroup || size_t { 3 } == cFeaturesInGroup) && 
+            cFeatureGroupsOut < cFeatureGroups ? 
+            cFeatureGroupsOut : size_t { 0 };
+         InteractionMarginals marginals;
+         InteractionMarginals * pMarginals = nullptr;
+         if(size_t { 0 } != cFeatureGroupsTop) {
+            if(InitializeInteractionMarginals(
+               pInteractionDetector, 
+               cFeatureIndexes, 
+               featureIndexes, 
+               cSamplesRequiredForChildSplitMin,
+               &marginals
+            )) {
+               ret = IntEbmType { 1 };
+            } else {
+               pMarginals = &marginals;
+            }
+         }
+         if(IntEbmType { 0 } == ret && ScoreFeatureGroups(
+            pInteractionDetector,
+            cFeatureGroups,
+            cFeaturesInGroup,
+            featureIndexes,
+            cSamplesRequiredForChildSplitMin,
+            cFeatureGroupsTop,
+            pMarginals,
+            aInteractionScores,
+            pcFeatureGroupsSkippedOut,
+            pcFeatureGroupsPrunedOut
+         )) {
+            ret = IntEbmType { 1 };
+         }
+         if(nullptr != pMarginals) {
+            FreeInteractionMarginals(pMarginals);
+         }
+      }
+   }
+
+   if(IntEbmType { 0 } != ret) {
+      LOG_N(TraceLevelWarning, "WARNING CalculateInteractionScores returned %" IntEbmTypePrintf, ret);
+   } else if(nullptr != aRanked) {
+      if(cFeatureGroupsRanked == cFeatureGroups) {
+         for(size_t iFeatureGroup = 0; iFeatureGroup < cFeatureGroups; ++iFeatureGroup) {
+            aRanked[iFeatureGroup].m_score = aInteractionScores[iFeatureGroup];
+            aRanked[iFeatureGroup].m_iFeatureGroup = iFeatureGroup;
+         }
+      }
+      EBM_ASSERT(cFeatureGroupsOut <= cFeatureGroupsRanked);
+      std::partial_sort(aRanked, aRanked + cFeatureGroupsOut, aRanked + cFeatureGroupsRanked, CompareInteractionScoreRanked());
+      for(size_t iFeatureGroupOut = 0; iFeatureGroupOut < cFeatureGroupsOut; ++iFeatureGroupOut) {
+         // we only prune once a worker holds cFeatureGroupsOut real scores, so pruned feature groups always rank below them
+         EBM_ASSERT(FloatEbmType { 0 } <= aRanked[iFeatureGroupOut].m_score);
+         interactionScoresOut[iFeatureGroupOut] = aRanked[iFeatureGroupOut].m_score;
+         // cFeatureGroups came from an IntEbmType, so any index into it fits
+         featureGroupIndexesOut[iFeatureGroupOut] = static_cast<IntEbmType>(aRanked[iFeatureGroupOut].m_iFeatureGroup);
+      }
+   }
+
+   if(nullptr != aRanked) {
+      free(aInteractionScores);
+      free(aRanked);
+   }
+   return ret;
+}
+
+static int g_cLogCalculateInteractionScoresParametersMessages = 10;
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION CalculateInteractionScores(
+   InteractionDetectorHandle interactionDetectorHandle,
+   IntEbmType countFeatureGroups,
+   IntEbmType countFeaturesInGroup,
+   const IntEbmType * featureIndexes,
+   IntEbmType countSamplesRequiredForChildSplitMin,
+   IntEbmType countFeatureGroupsTop,
+   FloatEbmType * interactionScoresOut,
+   IntEbmType * featureGroupIndexesOut
+) {
+   LOG_COUNTED_N(
+      &g_cLogCalculateInteractionScoresParametersMessages,
+      TraceLevelInfo,
+      TraceLevelVerbose,
+      "CalculateInteractionScores parameters: interactionDetectorHandle=%p, countFeatureGroups=%" IntEbmTypePrintf ", countFeaturesInGroup=%" IntEbmTypePrintf ", featureIndexes=%p, countSamplesRequiredForChildSplitMin=%" IntEbmTypePrintf ", countFeatureGroupsTop=%" IntEbmTypePrintf ", interactionScoresOut=%p, featureGroupIndexesOut=%p",
+      static_cast<void *>(interactionDetectorHandle),
+      countFeatureGroups,
+      countFeaturesInGroup,
+      static_cast<const void *>(featureIndexes),
+      countSamplesRequiredForChildSplitMin,
+      countFeatureGroupsTop,
+      static_cast<void *>(interactionScoresOut),
+      static_cast<void *>(featureGroupIndexesOut)
+   );
+
+   InteractionDetector * pInteractionDetector = reinterpret_cast<InteractionDetector *>(interactionDetectorHandle);
+   if(nullptr == pInteractionDetector) {
+      LOG_0(TraceLevelError, "ERROR CalculateInteractionScores interactionDetectorHandle cannot be nullptr");
+      return IntEbmType { 1 };
+   }
+
+   LOG_COUNTED_0(pInteractionDetector->GetPointerCountLogEnterMessages(), TraceLevelInfo, TraceLevelVerbose, "Entered CalculateInteractionScores");
+
+   const IntEbmType ret = CalculateInteractionScoresInternal(
+      pInteractionDetector,
+      countFeatureGroups,
+      countFeaturesInGroup,
+      featureIndexes,
+      countSamplesRequiredForChildSplitMin,
+      SeedEbmType { 0 },
+      size_t { 0 },
+      size_t { 0 },
+      false,
+      countFeatureGroupsTop,
+      interactionScoresOut,
+      featureGroupIndexesOut,
+      nullptr,
+      nullptr
+   );
+
+   LOG_COUNTED_0(pInteractionDetector->GetPointerCountLogExitMessages(), TraceLevelInfo, TraceLevelVerbose, "Exited CalculateInteractionScores");
+   return ret;
+}
+
+static int g_cLogCalculateInteractionScoresApproximateParametersMessages = 10;
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION CalculateInteractionScoresApproximate(
+   InteractionDetectorHandle interactionDetectorHandle,
+   IntEbmType countFeatureGroups,
+   IntEbmType countFeaturesInGroup,
+   const IntEbmType * featureIndexes,
+   IntEbmType countSamplesRequiredForChildSplitMin,
+   SeedEbmType randomSeed,
+   IntEbmType countSamplesScreen,
+   IntEbmType countFeatureGroupsRefine,
+   IntEbmType countFeatureGroupsTop,
+   FloatEbmType * interactionScoresOut,
+   IntEbmType * featureGroupIndexesOut
+) {
+   LOG_COUNTED_N(
+      &g_cLogCalculateInteractionScoresApproximateParametersMessages,
+      TraceLevelInfo,
+      TraceLevelVerbose,
+      "CalculateInteractionScoresApproximate parameters: interactionDetectorHandle=%p, countFeatureGroups=%" IntEbmTypePrintf ", countFeaturesInGroup=%" IntEbmTypePrintf ", featureIndexes=%p, countSamplesRequiredForChildSplitMin=%" IntEbmTypePrintf ", randomSeed=%" SeedEbmTypePrintf ", countSamplesScreen=%" IntEbmTypePrintf ", countFeatureGroupsRefine=%" IntEbmTypePrintf ", countFeatureGroupsTop=%" IntEbmTypePrintf ", interactionScoresOut=%p, featureGroupIndexesOut=%p",
+      static_cast<void *>(interactionDetectorHandle),
+      countFeatureGroups,
+      countFeaturesInGroup,
+      static_cast<const void *>(featureIndexes),
+      countSamplesRequiredForChildSplitMin,
+      randomSeed,
+      countSamplesScreen,
+      countFeatureGroupsRefine,
+      countFeatureGroupsTop,
+      static_cast<void *>(interactionScoresOut),
+      static_cast<void *>(featureGroupIndexesOut)
+   );
+
+   InteractionDetector * pInteractionDetector = reinterpret_cast<InteractionDetector *>(interactionDetectorHandle);
+   if(nullptr == pInteractionDetector) {
+      LOG_0(TraceLevelError, "ERROR CalculateInteractionScoresApproximate interactionDetectorHandle cannot be nullptr");
+      return IntEbmType { 1 };
+   }
+
+   LOG_COUNTED_0(pInteractionDetector->GetPointerCountLogEnterMessages(), TraceLevelInfo, TraceLevelVerbose, "Entered CalculateInteractionScoresApproximate");
+
+   if(countSamplesScreen < IntEbmType { 1 }) {
+      LOG_0(TraceLevelError, "ERROR CalculateInteractionScoresApproximate countSamplesScreen must be 1 or more");
+      return IntEbmType { 1 };
+   }
+   // a subsample at least as big as the data is no subsample at all, and we'll notice that later
+   const size_t cSamplesScreen = IsNumberConvertable<size_t>(countSamplesScreen) ? 
+      static_cast<size_t>(countSamplesScreen) : std::numeric_limits<size_t>::max();
+
+   if(countFeatureGroupsTop < IntEbmType { 1 }) {
+      LOG_0(TraceLevelError, "ERROR CalculateInteractionScoresApproximate countFeatureGroupsTop must be 1 or more");
+      return IntEbmType { 1 };
+   }
+   if(countFeatureGroupsRefine < countFeatureGroupsTop) {
+      // we can't return more feature groups than we rescore
+      LOG_0(TraceLevelWarning, "WARNING CalculateInteractionScoresApproximate countFeatureGroupsRefine can't be less than countFeatureGroupsTop.  Adjusting to countFeatureGroupsTop.");
+      countFeatureGroupsRefine = countFeatureGroupsTop;
+   }
+   const size_t cFeatureGroupsRefine = IsNumberConvertable<size_t>(countFeatureGroupsRefine) ? 
+      static_cast<size_t>(countFeatureGroupsRefine) : std::numeric_limits<size_t>::max();
+
+   const IntEbmType ret = CalculateInteractionScoresInternal(
+      pInteractionDetector,
+      countFeatureGroups,
+      countFeaturesInGroup,
+      featureIndexes,
+      countSamplesRequiredForChildSplitMin,
+      randomSeed,
+      cSamplesScreen,
+      cFeatureGroupsRefine,
+      false,
+      countFeatureGroupsTop,
+      interactionScoresOut,
+      featureGroupIndexesOut,
+      nullptr,
+      nullptr
+   );
+
+   LOG_COUNTED_0(pInteractionDetector->GetPointerCountLogExitMessages(), TraceLevelInfo, TraceLevelVerbose, "Exited CalculateInteractionScoresApproximate");
+   return ret;
+}
+
+static int g_cLogCalculateInteractionScoresPrunedParametersMessages = 10;
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION CalculateInteractionScoresPruned(
+   InteractionDetectorHandle interactionDetectorHandle,
+   IntEbmType countFeatureGroups,
+   IntEbmType countFeaturesInGroup,
+   const IntEbmType * featureIndexes,
+   IntEbmType countSamplesRequiredForChildSplitMin,
+   IntEbmType countFeatureGroupsTop,
+   FloatEbmType * interactionScoresOut,
+   IntEbmType * featureGroupIndexesOut,
+   IntEbmType * countFeatureGroupsSkippedOut,
+   IntEbmType * countFeatureGroupsPrunedOut
+) {
+   LOG_COUNTED_N(
+      &g_cLogCalculateInteractionScoresPrunedParametersMessages,
+      TraceLevelInfo,
+      TraceLevelVerbose,
+      "CalculateInteractionScoresPruned parameters: interactionDetectorHandle=%p, countFeatureGroups=%" IntEbmTypePrintf ", countFeaturesInGroup=%" IntEbmTypePrintf ", featureIndexes=%p, countSamplesRequiredForChildSplitMin=%" IntEbmTypePrintf ", countFeatureGroupsTop=%" IntEbmTypePrintf ", interactionScoresOut=%p, featureGroupIndexesOut=%p, countFeatureGroupsSkippedOut=%p, countFeatureGroupsPrunedOut=%p",
+      static_cast<void *>(interactionDetectorHandle),
+      countFeatureGroups,
+      countFeaturesInGroup,
+      static_cast<const void *>(featureIndexes),
+      countSamplesRequiredForChildSplitMin,
+      countFeatureGroupsTop,
+      static_cast<void *>(interactionScoresOut),
+      static_cast<void *>(featureGroupIndexesOut),
+      static_cast<void *>(countFeatureGroupsSkippedOut),
+      static_cast<void *>(countFeatureGroupsPrunedOut)
+   );
+
+   InteractionDetector * pInteractionDetector = reinterpret_cast<InteractionDetector *>(interactionDetectorHandle);
+   if(nullptr == pInteractionDetector) {
+      LOG_0(TraceLevelError, "ERROR CalculateInteractionScoresPruned interactionDetectorHandle cannot be nullptr");
+      return IntEbmType { 1 };
+   }
+
+   LOG_COUNTED_0(pInteractionDetector->GetPointerCountLogEnterMessages(), TraceLevelInfo, TraceLevelVerbose, "Entered CalculateInteractionScoresPruned");
+
+   if(countFeatureGroupsTop < IntEbmType { 1 }) {
+      LOG_0(TraceLevelError, "ERROR CalculateInteractionScoresPruned countFeatureGroupsTop must be 1 or more");
+      return IntEbmType { 1 };
+   }
+
+   size_t cFeatureGroupsSkipped = 0;
+   size_t cFeatureGroupsPruned = 0;
+   const IntEbmType ret = CalculateInteractionScoresInternal(
+      pInteractionDetector,
+      countFeatureGroups,
+      countFeaturesInGroup,
+      featureIndexes,
+      countSamplesRequiredForChildSplitMin,
+      SeedEbmType { 0 },
+      size_t { 0 },
+      size_t { 0 },
+      true,
+      countFeatureGroupsTop,
+      interactionScoresOut,
+      featureGroupIndexesOut,
+      &cFeatureGroupsSkipped,
+      &cFeatureGroupsPruned
+   );
+
+   if(IntEbmType { 0 } == ret) {
+      // both counts are no larger than countFeatureGroups, which came from an IntEbmType
+      if(nullptr != countFeatureGroupsSkippedOut) {
+         *countFeatureGroupsSkippedOut = static_cast<IntEbmType>(cFeatureGroupsSkipped);
+      }
+      if(nullptr != countFeatureGroupsPrunedOut) {
+         *countFeatureGroupsPrunedOut = static_cast<IntEbmType>(cFeatureGroupsPruned);
+      }
+   }
+
+   LOG_COUNTED_0(pInteractionDetector->GetPointerCountLogExitMessages(), TraceLevelInfo, TraceLevelVerbose, "Exited CalculateInteractionScoresPruned");
+   return ret;
+}
+
+// the 3 feature indexes of a candidate triple, sorted so that identical triples built from different pairs compare equal
+struct InteractionTriple final {
+   IntEbmType m_aiFeatures[3];
+};
+static_assert(std::is_standard_layout<InteractionTriple>::value,
+   "We use the struct hack in several places, so disallow non-standard_layout types in general");
+static_assert(std::is_trivial<InteractionTriple>::value,
+   "We use memcpy in several places, so disallow non-trivial types in general");
+static_assert(std::is_pod<InteractionTriple>::value,
+   "We use a lot of C constructs, so disallow non-POD types in general");
+static_assert(sizeof(InteractionTriple) == 3 * sizeof(IntEbmType), 
+   "we pass an array of InteractionTriple to CalculateInteractionScoresInternal as a flat array of feature indexes");
+
+class CompareInteractionTriple final {
+public:
+   INLINE_ALWAYS bool operator() (const InteractionTriple & lhs, const InteractionTriple & rhs) const noexcept {
+      if(lhs.m_aiFeatures[0] != rhs.m_aiFeatures[0]) {
+         return lhs.m_aiFeatures[0] < rhs.m_aiFeatures[0];
+      }
+      if(lhs.m_aiFeatures[1] != rhs.m_aiFeatures[1]) {
+         return lhs.m_aiFeatures[1] < rhs.m_aiFeatures[1];
+      }
+      return lhs.m_aiFeatures[2] < rhs.m_aiFeatures[2];
+   }
+};
+
+class EqualInteractionTriple final {
+public:
+   INLINE_ALWAYS bool operator() (const InteractionTriple & lhs, const InteractionTriple & rhs) const noexcept {
+      return lhs.m_aiFeatures[0] == rhs.m_aiFeatures[0] && lhs.m_aiFeatures[1] == rhs.m_aiFeatures[1] && 
+         lhs.m_aiFeatures[2] == rhs.m_aiFeatures[2];
+   }
+};
+
+// A triple can only have a strong 3 way interaction if we can find it by extending a pair that already interacts, so our candidates are 
+// every given pair extended by every other feature that appears in any of the given pairs.  Returns the number of unique candidates, 
+// sorted, or SIZE_MAX if we couldn't allocate them
+static size_t BuildInteractionTriples(
+   const InteractionDetector * const pInteractionDetector,
+   const size_t cPairs,
+   const IntEbmType * const aPairFeatureIndexes,
+   InteractionTriple ** const paTriplesOut
+) {
+   EBM_ASSERT(1 <= cPairs);
+
+   const size_t cFeatures = pInteractionDetector->GetCountFeatures();
+   bool * const abFeatureUsed = EbmMalloc<bool>(cFeatures);
+   size_t * const aiFeaturesUsed = EbmMalloc<size_t>(cFeatures);
+   if(nullptr == abFeatureUsed || nullptr == aiFeaturesUsed) {
+      LOG_0(TraceLevelWarning, "WARNING BuildInteractionTriples nullptr == abFeatureUsed || nullptr == aiFeaturesUsed");
+      free(aiFeaturesUsed);
+      free(abFeatureUsed);
+      return std::numeric_limits<size_t>::max();
+   }
+   for(size_t iFeature = 0; iFeature < cFeatures; ++iFeature) {
+      abFeatureUsed[iFeature] = false;
+   }
+   for(size_t iFeatureIndex = 0; iFeatureIndex < cPairs * size_t { 2 }; ++iFeatureIndex) {
+      // our caller checked these indexes already
+      const size_t iFeature = static_cast<size_t>(aPairFeatureIndexes[iFeatureIndex]);
+      EBM_ASSERT(iFeature < cFeatures);
+      abFeatureUsed[iFeature] = true;
+   }
+   size_t cFeaturesUsed = 0;
+   for(size_t iFeature = 0; iFeature < cFeatures; ++iFeature) {
+      if(abFeatureUsed[iFeature]) {
+         aiFeaturesUsed[cFeaturesUsed] = iFeature;
+         ++cFeaturesUsed;
+      }
+   }
+   free(abFeatureUsed);
+
+   if(IsMultiplyError(cPairs, cFeaturesUsed)) {
+      LOG_0(TraceLevelWarning, "WARNING BuildInteractionTriples IsMultiplyError(cPairs, cFeaturesUsed)");
+      free(aiFeaturesUsed);
+      return std::numeric_limits<size_t>::max();
+   }
+   // every pair contributes fewer than cFeaturesUsed triples, so this is enough space even before we remove duplicates
+   InteractionTriple * const aTriples = EbmMalloc<InteractionTriple>(cPairs * cFeaturesUsed);
+   if(nullptr == aTriples) {
+      LOG_0(TraceLevelWarning, "WARNING BuildInteractionTriples nullptr == aTriples");
+      free(aiFeaturesUsed);
+      return std::numeric_limits<size_t>::max();
+   }
+
+   size_t cTriples = 0;
+   for(size_t iPair = 0; iPair < cPairs; ++iPair) {
+      IntEbmType iFeatureLow = aPairFeatureIndexes[iPair * size_t { 2 }];
+      IntEbmType iFeatureHigh = aPairFeatureIndexes[iPair * size_t { 2 } + size_t { 1 }];
+      if(iFeatureHigh < iFeatureLow) {
+         std::swap(iFeatureLow, iFeatureHigh);
+      }
+      if(iFeatureLow == iFeatureHigh) {
+         // a feature paired with itself has no interaction to extend
+         continue;
+      }
+      for(size_t iFeatureUsed = 0; iFeatureUsed < cFeaturesUsed; ++iFeatureUsed) {
+         // cFeatures came from an IntEbmType, so any index into it fits
+         const IntEbmType iFeatureThird = static_cast<IntEbmType>(aiFeaturesUsed[iFeatureUsed]);
+         if(iFeatureThird == iFeatureLow || iFeatureThird == iFeatureHigh) {
+            continue;
+         }
+         InteractionTriple * const pTriple = &aTriples[cTriples];
+         ++cTriples;
+         if(iFeatureThird < iFeatureLow) {
+            pTriple->m_aiFeatures[0] = iFeatureThird;
+            pTriple->m_aiFeatures[1] = iFeatureLow;
+            pTriple->m_aiFeatures[2] = iFeatureHigh;
+         } else if(iFeatureThird < iFeatureHigh) {
+            pTriple->m_aiFeatures[0] = iFeatureLow;
+            pTriple->m_aiFeatures[1] = iFeatureThird;
+            pTriple->m_aiFeatures[2] = iFeatureHigh;
+         } else {
+            pTriple->m_aiFeatures[0] = iFeatureLow;
+            pTriple->m_aiFeatures[1] = iFeatureHigh;
+            pTriple->m_aiFeatures[2] = iFeatureThird;
+         }
+      }
+   }
+   free(aiFeaturesUsed);
+
+   // sorting also puts triples that share their first 2 features next to each other, which keeps the histograms of neighbouring
+   // feature groups in a worker's block similar in size
+   std::sort(aTriples, aTriples + cTriples, CompareInteractionTriple());
+   cTriples = static_cast<size_t>(std::unique(aTriples, aTriples + cTriples, EqualInteractionTriple()) - aTriples);
+
+   *paTriplesOut = aTriples;
+   return cTriples;
+}
+
+static int g_cLogCalculateInteractionScoresTriplesParametersMessages = 10;
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION CalculateInteractionScoresTriples(
+   InteractionDetectorHandle interactionDetectorHandle,
+   IntEbmType countPairs,
+   const IntEbmType * pairFeatureIndexes,
+   IntEbmType countSamplesRequiredForChildSplitMin,
+   IntEbmType countTriplesTop,
+   FloatEbmType * interactionScoresOut,
+   IntEbmType * tripleFeatureIndexesOut,
+   IntEbmType * countTriplesOut
+) {
+   LOG_COUNTED_N(
+      &g_cLogCalculateInteractionScoresTriplesParametersMessages,
+      TraceLevelInfo,
+      TraceLevelVerbose,
+      "CalculateInteractionScoresTriples parameters: interactionDetectorHandle=%p, countPairs=%" IntEbmTypePrintf ", pairFeatureIndexes=%p, countSamplesRequiredForChildSplitMin=%" IntEbmTypePrintf ", countTriplesTop=%" IntEbmTypePrintf ", interactionScoresOut=%p, tripleFeatureIndexesOut=%p, countTriplesOut=%p",
+      static_cast<void *>(interactionDetectorHandle),
+      countPairs,
+      static_cast<const void *>(pairFeatureIndexes),
+      countSamplesRequiredForChildSplitMin,
+      countTriplesTop,
+      static_cast<void *>(interactionScoresOut),
+      static_cast<void *>(tripleFeatureIndexesOut),
+      static_cast<void *>(countTriplesOut)
+   );
+
+   if(nullptr != countTriplesOut) {
+      *countTriplesOut = IntEbmType { 0 };
+   }
+
+   InteractionDetector * pInteractionDetector = reinterpret_cast<InteractionDetector *>(interactionDetectorHandle);
+   if(nullptr == pInteractionDetector) {
+      LOG_0(TraceLevelError, "ERROR CalculateInteractionScoresTriples interactionDetectorHandle cannot be nullptr");
+      return IntEbmType { 1 };
+   }
+
+   LOG_COUNTED_0(pInteractionDetector->GetPointerCountLogEnterMessages(), TraceLevelInfo, TraceLevelVerbose, "Entered CalculateInteractionScoresTriples");
+
+   if(countPairs < 0) {
+      LOG_0(TraceLevelError, "ERROR CalculateInteractionScoresTriples countPairs must be positive");
+      return IntEbmType { 1 };
+   }
+   if(!IsNumberConvertable<size_t>(countPairs) || IsMultiplyError(static_cast<size_t>(countPairs), size_t { 2 })) {
+      LOG_0(TraceLevelError, "ERROR CalculateInteractionScoresTriples countPairs too large to index");
+      return IntEbmType { 1 };
+   }
+   const size_t cPairs = static_cast<size_t>(countPairs);
+   if(countTriplesTop < IntEbmType { 1 }) {
+      LOG_0(TraceLevelError, "ERROR CalculateInteractionScoresTriples countTriplesTop must be 1 or more");
+      return IntEbmType { 1 };
+   }
+   if(size_t { 0 } == cPairs) {
+      LOG_0(TraceLevelInfo, "INFO CalculateInteractionScoresTriples zero pairs");
+      return IntEbmType { 0 };
+   }
+   if(nullptr == pairFeatureIndexes) {
+      LOG_0(TraceLevelError, "ERROR CalculateInteractionScoresTriples pairFeatureIndexes cannot be nullptr if 0 < countPairs");
+      return IntEbmType { 1 };
+   }
+   if(nullptr == interactionScoresOut || nullptr == tripleFeatureIndexesOut) {
+      LOG_0(TraceLevelError, "ERROR CalculateInteractionScoresTriples interactionScoresOut and tripleFeatureIndexesOut cannot be nullptr if 0 < countPairs");
+      return IntEbmType { 1 };
+   }
+   for(size_t iFeatureIndex = 0; iFeatureIndex < cPairs * size_t { 2 }; ++iFeatureIndex) {
+      const IntEbmType indexFeatureInterop = pairFeatureIndexes[iFeatureIndex];
+      if(indexFeatureInterop < 0) {
+         LOG_0(TraceLevelError, "ERROR CalculateInteractionScoresTriples pairFeatureIndexes value cannot be negative");
+         return IntEbmType { 1 };
+      }
+      if(!IsNumberConvertable<size_t>(indexFeatureInterop) || 
+         pInteractionDetector->GetCountFeatures() <= static_cast<size_t>(indexFeatureInterop)) 
+      {
+         LOG_0(TraceLevelError, "ERROR CalculateInteractionScoresTriples pairFeatureIndexes value must be less than the number of features");
+         return IntEbmType { 1 };
+      }
+   }
+
+   InteractionTriple * aTriples = nullptr;
+   const size_t cTriples = BuildInteractionTriples(pInteractionDetector, cPairs, pairFeatureIndexes, &aTriples);
+   if(std::numeric_limits<size_t>::max() == cTriples) {
+      return IntEbmType { 1 };
+   }
+   IntEbmType ret = IntEbmType { 0 };
+   if(size_t { 0 } == cTriples) {
+      LOG_0(TraceLevelInfo, "INFO CalculateInteractionScoresTriples the pairs have no third feature to extend them with");
+   } else {
+      const size_t cTriplesOut = IsNumberConvertable<size_t>(countTriplesTop) && static_cast<size_t>(countTriplesTop) < cTriples ? 
+         static_cast<size_t>(countTriplesTop) : cTriples;
+      IntEbmType * const aiTriplesTop = EbmMalloc<IntEbmType>(cTriplesOut);
+      if(nullptr == aiTriplesTop) {
+         LOG_0(TraceLevelWarning, "WARNING CalculateInteractionScoresTriples nullptr == aiTriplesTop");
+         ret = IntEbmType { 1 };
+      } else {
+         LOG_N(TraceLevelVerbose, "CalculateInteractionScoresTriples scoring %zu candidate triples from %zu pairs", cTriples, cPairs);
+
+         size_t cTriplesSkipped = 0;
+         size_t cTriplesPruned = 0;
+         // cTriples is no larger than countPairs * the number of features, which were both IntEbmType, but their product might not be
+         ret = IsNumberConvertable<IntEbmType>(cTriples) ? CalculateInteractionScoresInternal(
+            pInteractionDetector,
+            static_cast<IntEbmType>(cTriples),
+            IntEbmType { 3 },
+            &aTriples[0].m_aiFeatures[0],
+            countSamplesRequiredForChildSplitMin,
+            SeedEbmType { 0 },
+            size_t { 0 },
+            size_t { 0 },
+            true,
+            countTriplesTop,
+            interactionScoresOut,
+            aiTriplesTop,
+            &cTriplesSkipped,
+            &cTriplesPruned
+         ) : IntEbmType { 1 };
+
+         if(IntEbmType { 0 } == ret) {
+            LOG_N(
+               TraceLevelVerbose, 
+               "CalculateInteractionScoresTriples skipped %zu and pruned %zu candidate triples", 
+               cTriplesSkipped, 
+               cTriplesPruned
+            );
+            for(size_t iTripleOut = 0; iTripleOut < cTriplesOut; ++iTripleOut) {
+               const InteractionTriple * const pTriple = &aTriples[static_cast<size_t>(aiTriplesTop[iTripleOut])];
+               tripleFeatureIndexesOut[iTripleOut * size_t { 3 }] = pTriple->m_aiFeatures[0];
+               tripleFeatureIndexesOut[iTripleOut * size_t { 3 } + size_t { 1 }] = pTriple->m_aiFeatures[1];
+               tripleFeatureIndexesOut[iTripleOut * size_t { 3 } + size_t { 2 }] = pTriple->m_aiFeatures[2];
+            }
+            if(nullptr != countTriplesOut) {
+               *countTriplesOut = static_cast<IntEbmType>(cTriplesOut);
+            }
+         }
+         free(aiTriplesTop);
+      }
+   }
+   free(aTriples);
+
+   LOG_COUNTED_0(pInteractionDetector->GetPointerCountLogExitMessages(), TraceLevelInfo, TraceLevelVerbose, "Exited CalculateInteractionScoresTriples");
+   return ret;
+}
@@ -0,0 +1,437 @@
+// Copyright (c) 2018 Microsoft Corporation
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#include "PrecompiledHeader.h"
+
+#include <stdlib.h> // free
+#include <stddef.h> // size_t, ptrdiff_t
+#include <stdint.h> // uint64_t
+#include <string.h> // memcpy, memcmp
+#include <cmath> // std::isnan
+#include <limits> // std::numeric_limits
+#include <atomic>
+
+#include "ebm_native.h"
+#include "EbmInternal.h" // INLINE_ALWAYS
+#include "Logging.h" // EBM_ASSERT & LOG
+#include "ParallelWork.h"
+
+#include "CategoricalEncoder.h"
+
+constexpr size_t k_cBytesPerNumericCategory = 8;
+static_assert(sizeof(IntEbmType) == k_cBytesPerNumericCategory, "CategoryType_Int64 expects 8 byte integers");
+static_assert(sizeof(FloatEbmType) == k_cBytesPerNumericCategory, "CategoryType_Float64 expects 8 byte doubles");
+
+// the number of samples each worker takes at a time in EncodeCategories
+constexpr size_t k_cEncodeBlockSamples = 4096;
+
+// Returns the number of bytes in the normalized category, and sets *ppKey to where they are.  Equal categories need
+// equal bytes since we hash and compare the bytes, so doubles put -0.0 and NaN values into a single canonical form
+// (using aScratch), and fixed width strings drop their zero padding
+INLINE_ALWAYS static size_t NormalizeCategory(
+   const CategoryTypeType categoryType,
+   const unsigned char * const pValue,
+   const size_t cBytesPerValue,
+   unsigned char * const aScratch,
+   const unsigned char ** const ppKey
+) {
+   if(CategoryType_Float64 == categoryType) {
+      EBM_ASSERT(k_cBytesPerNumericCategory == cBytesPerValue);
+      FloatEbmType val;
+      memcpy(&val, pValue, sizeof(val));
+      if(std::isnan(val)) {
+         val = std::numeric_limits<FloatEbmType>::quiet_NaN();
+      } else if(FloatEbmType { 0 } == val) {
+         val = FloatEbmType { 0 };
+      }
+      memcpy(aScratch, &val, sizeof(val));
+      *ppKey = aScratch;
+      return sizeof(val);
+   } else if(CategoryType_Bytes == categoryType) {
+      size_t cBytes = cBytesPerValue;
+      while(size_t { 0 } != cBytes && 0 == pValue[cBytes - size_t { 1 }]) {
+         --cBytes;
+      }
+      *ppKey = pValue;
+      return cBytes;
+   } else {
+      EBM_ASSERT(CategoryType_Int64 == categoryType);
+      EBM_ASSERT(k_cBytesPerNumericCategory == cBytesPerValue);
+      *ppKey = pValue;
+      return cBytesPerValue;
+   }
+}
+
+static uint64_t HashCategory(const unsigned char * pKey, size_t cKeyBytes) {
+   // mix in 8 bytes at a time with the multiply and xor-shift steps from the MurmurHash3 finalizer
+   constexpr uint64_t k_multiply1 = uint64_t { 0xff51afd7ed558ccd };
+   constexpr uint64_t k_multiply2 = uint64_t { 0xc4ceb9fe1a85ec53 };
+
+   uint64_t hash = uint64_t { 0x9e3779b97f4a7c15 } ^ static_cast<uint64_t>(cKeyBytes);
+   while(sizeof(uint64_t) <= cKeyBytes) {
+      uint64_t word;
+      memcpy(&word, pKey, sizeof(word));
+      hash = (hash ^ word) * k_multiply1;
+      hash ^= hash >> 32;
+      pKey += sizeof(word);
+      cKeyBytes -= sizeof(word);
+   }
+   if(size_t { 0 } != cKeyBytes) {
+      uint64_t word = 0;
+      memcpy(&word, pKey, cKeyBytes);
+      hash = (hash ^ word) * k_multiply1;
+      hash ^= hash >> 32;
+   }
+   hash ^= hash >> 29;
+   hash *= k_multiply2;
+   hash ^= hash >> 32;
+   return hash;
+}
+
+void CategoricalEncoder::Free(CategoricalEncoder * const pCategoricalEncoder) {
+   LOG_0(TraceLevelInfo, "Entered CategoricalEncoder::Free");
+
+   if(nullptr != pCategoricalEncoder) {
+      free(pCategoricalEncoder->m_aiSlots);
+      free(pCategoricalEncoder->m_aHashes);
+      free(pCategoricalEncoder->m_aiKeyStarts);
+      free(pCategoricalEncoder->m_aKeys);
+      free(pCategoricalEncoder->m_aBinIndexes);
+      free(pCategoricalEncoder);
+   }
+
+   LOG_0(TraceLevelInfo, "Exited CategoricalEncoder::Free");
+}
+
+size_t CategoricalEncoder::FindSlot(const unsigned char * const pKey, const size_t cKeyBytes, const uint64_t hash) const {
+   // returns the slot holding the key, or the empty slot where it would go.  We keep the table at most half full,
+   // so linear probing stays short and always reaches an empty slot
+   size_t iSlot = static_cast<size_t>(hash) & m_cSlotsMask;
+   while(true) {
+      const size_t iCategoryPlusOne = m_aiSlots[iSlot];
+      if(size_t { 0 } == iCategoryPlusOne) {
+         return iSlot;
+      }
+      const size_t iCategory = iCategoryPlusOne - size_t { 1 };
+      if(hash == m_aHashes[iCategory]) {
+         const size_t iKeyStart = m_aiKeyStarts[iCategory];
+         const size_t cBytes = m_aiKeyStarts[iCategory + size_t { 1 }] - iKeyStart;
+         if(cKeyBytes == cBytes && 0 == memcmp(pKey, &m_aKeys[iKeyStart], cBytes)) {
+            return iSlot;
+         }
+      }
+      iSlot = (iSlot + size_t { 1 }) & m_cSlotsMask;
+   }
+}
+
+CategoricalEncoder * CategoricalEncoder::Allocate(
+   const CategoryTypeType categoryType,
+   const size_t cBytesPerCategory,
+   const size_t cCategories,
+   const unsigned char * const aCategories,
+   const IntEbmType * const aBinIndexes
+) {
+   LOG_0(TraceLevelInfo, "Entered CategoricalEncoder::Allocate");
+
+   EBM_ASSERT(size_t { 0 } == cCategories || nullptr != aBinIndexes);
+   EBM_ASSERT(size_t { 0 } == cCategories || size_t { 0 } == cBytesPerCategory || nullptr != aCategories);
+
+   size_t cSlots = 16;
+   while(cSlots < cCategories || cSlots - cCategories < cCategories) {
+      if(std::numeric_limits<size_t>::max() / size_t { 2 } < cSlots) {
+         LOG_0(TraceLevelWarning, "WARNING CategoricalEncoder::Allocate too many categories for the hash table");
+         return nullptr;
+      }
+      cSlots <<= 1;
+   }
+   if(IsMultiplyError(cCategories, cBytesPerCategory) || std::numeric_limits<size_t>::max() == cCategories) {
+      LOG_0(TraceLevelWarning, "WARNING CategoricalEncoder::Allocate countCategories * countBytesPerCategory is too large");
+      return nullptr;
+   }
+   // malloc(0) is allowed to return nullptr, so we always ask for at least 1 byte of keys
+   const size_t cKeyBytesMax = size_t { 0 } == cCategories * cBytesPerCategory ? size_t { 1 } : cCategories * cBytesPerCategory;
+
+   CategoricalEncoder * const pNew = EbmMalloc<CategoricalEncoder>();
+   if(UNLIKELY(nullptr == pNew)) {
+      LOG_0(TraceLevelWarning, "WARNING CategoricalEncoder::Allocate nullptr == pNew");
+      return nullptr;
+   }
+   pNew->m_categoryType = categoryType;
+   pNew->m_cCategories = 0;
+   pNew->m_cSlotsMask = cSlots - size_t { 1 };
+   pNew->m_aiSlots = EbmMalloc<size_t>(cSlots);
+   pNew->m_aHashes = EbmMalloc<uint64_t>(size_t { 0 } == cCategories ? size_t { 1 } : cCategories);
+   pNew->m_aiKeyStarts = EbmMalloc<size_t>(cCategories + size_t { 1 });
+   pNew->m_aKeys = EbmMalloc<unsigned char>(cKeyBytesMax);
+   pNew->m_aBinIndexes = EbmMalloc<IntEbmType>(size_t { 0 } == cCategories ? size_t { 1 } : cCategories);
+   if(nullptr == pNew->m_aiSlots || nullptr == pNew->m_aHashes || nullptr == pNew->m_aiKeyStarts ||
+      nullptr == pNew->m_aKeys || nullptr == pNew->m_aBinIndexes)
+   {
+      LOG_0(TraceLevelWarning, "WARNING CategoricalEncoder::Allocate out of memory");
+      Free(pNew);
+      return nullptr;
+   }
+   for(size_t iSlot = 0; iSlot < cSlots; ++iSlot) {
+      pNew->m_aiSlots[iSlot] = size_t { 0 };
+   }
+
+   size_t cUnique = 0;
+   size_t iKeyNext = 0;
+   pNew->m_aiKeyStarts[0] = 0;
+   unsigned char aScratch[k_cBytesPerNumericCategory];
+   for(size_t iCategory = 0; iCategory < cCategories; ++iCategory) {
+      const unsigned char * pKey;
+      const size_t cKeyBytes = NormalizeCategory(categoryType, aCategories + iCategory * cBytesPerCategory, cBytesPerCategory, aScratch, &pKey);
+      const uint64_t hash = HashCategory(pKey, cKeyBytes);
+
+      // we fill the table as we go, so this also finds duplicates within aCategories
+      const size_t iSlot = pNew->FindSlot(pKey, cKeyBytes, hash);
+      const size_t iCategoryPlusOne = pNew->m_aiSlots[iSlot];
+      if(size_t { 0 } != iCategoryPlusOne) {
+         pNew->m_aBinIndexes[iCategoryPlusOne - size_t { 1 }] = aBinIndexes[iCategory];
+      } else {
+         EBM_ASSERT(iKeyNext + cKeyBytes <= cKeyBytesMax);
+         if(size_t { 0 } != cKeyBytes) {
+            memcpy(&pNew->m_aKeys[iKeyNext], pKey, cKeyBytes);
+         }
+         iKeyNext += cKeyBytes;
+         pNew->m_aHashes[cUnique] = hash;
+         pNew->m_aBinIndexes[cUnique] = aBinIndexes[iCategory];
+         ++cUnique;
+         pNew->m_aiKeyStarts[cUnique] = iKeyNext;
+         pNew->m_aiSlots[iSlot] = cUnique;
+      }
+   }
+   pNew->m_cCategories = cUnique;
+
+   LOG_0(TraceLevelInfo, "Exited CategoricalEncoder::Allocate");
+
+   return pNew;
+}
+
+IntEbmType CategoricalEncoder::GetBinIndex(
+   const unsigned char * const pValue,
+   const size_t cBytesPerValue,
+   const IntEbmType unknownBinIndex
+) const {
+   unsigned char aScratch[k_cBytesPerNumericCategory];
+   const unsigned char * pKey;
+   const size_t cKeyBytes = NormalizeCategory(m_categoryType, pValue, cBytesPerValue, aScratch, &pKey);
+   const size_t iCategoryPlusOne = m_aiSlots[FindSlot(pKey, cKeyBytes, HashCategory(pKey, cKeyBytes))];
+   return size_t { 0 } == iCategoryPlusOne ? unknownBinIndex : m_aBinIndexes[iCategoryPlusOne - size_t { 1 }];
+}
+
+static bool IsCategoryTypeValid(const CategoryTypeType categoryType, const size_t cBytes, const char * const sFunctionName) {
+   if(CategoryType_Int64 != categoryType && CategoryType_Float64 != categoryType && CategoryType_Bytes != categoryType) {
+      LOG_N(TraceLevelError, "ERROR %s categoryType is not a recognized CategoryType", sFunctionName);
+      return false;
+   }
+   if(CategoryType_Bytes != categoryType && k_cBytesPerNumericCategory != cBytes) {
+      LOG_N(TraceLevelError, "ERROR %s numeric categories must be 8 bytes each", sFunctionName);
+      return false;
+   }
+   return true;
+}
+
+EBM_NATIVE_IMPORT_EXPORT_BODY CategoricalEncoderHandle EBM_NATIVE_CALLING_CONVENTION CreateCategoricalEncoder(
+   CategoryTypeType categoryType,
+   IntEbmType countBytesPerCategory,
+   IntEbmType countCategories,
+   const void * categories,
+   const IntEbmType * binIndexes
+) {
+   LOG_N(TraceLevelInfo, "Entered CreateCategoricalEncoder: "
+      "categoryType=%" CategoryTypeTypePrintf ", "
+      "countBytesPerCategory=%" IntEbmTypePrintf ", "
+      "countCategories=%" IntEbmTypePrintf ", "
+      "categories=%p, "
+      "binIndexes=%p"
+      ,
+      categoryType,
+      countBytesPerCategory,
+      countCategories,
+      categories,
+      static_cast<const void *>(binIndexes)
+   );
+
+   if(countBytesPerCategory < IntEbmType { 0 }) {
+      LOG_0(TraceLevelError, "ERROR CreateCategoricalEncoder countBytesPerCategory cannot be negative");
+      return nullptr;
+   }
+   if(countCategories < IntEbmType { 0 }) {
+      LOG_0(TraceLevelError, "ERROR CreateCategoricalEncoder countCategories cannot be negative");
+      return nullptr;
+   }
+   if(!IsNumberConvertable<size_t>(countBytesPerCategory) || !IsNumberConvertable<size_t>(countCategories)) {
+      LOG_0(TraceLevelWarning, "WARNING CreateCategoricalEncoder countBytesPerCategory or countCategories is too large to fit into memory");
+      return nullptr;
+   }
+   const size_t cBytesPerCategory = static_cast<size_t>(countBytesPerCategory);
+   const size_t cCategories = static_cast<size_t>(countCategories);
+   if(!IsCategoryTypeValid(categoryType, cBytesPerCategory, "CreateCategoricalEncoder")) {
+      return nullptr;
+   }
+   if(size_t { 0 } != cCategories) {
+      if(nullptr == binIndexes) {
+         LOG_0(TraceLevelError, "ERROR CreateCategoricalEncoder binIndexes cannot be nullptr");
+         return nullptr;
+      }
+      if(size_t { 0 } != cBytesPerCategory && nullptr == categories) {
+         LOG_0(TraceLevelError, "ERROR CreateCategoricalEncoder categories cannot be nullptr");
+         return nullptr;
+      }
+   }
+
+   CategoricalEncoder * const pCategoricalEncoder = CategoricalEncoder::Allocate(
+      categoryType,
+      cBytesPerCategory,
+      cCategories,
+      static_cast<const unsigned char *>(categories),
+      binIndexes
+   );
+   if(UNLIKELY(nullptr == pCategoricalEncoder)) {
+      LOG_0(TraceLevelWarning, "WARNING CreateCategoricalEncoder nullptr == pCategoricalEncoder");
+      return nullptr;
+   }
+
+   LOG_N(TraceLevelInfo, "Exited CreateCategoricalEncoder %p", static_cast<void *>(pCategoricalEncoder));
+   return reinterpret_cast<CategoricalEncoderHandle>(pCategoricalEncoder);
+}
+
+struct EncodeCategoriesWork final {
+   const CategoricalEncoder * m_pCategoricalEncoder;
+   size_t m_cSamples;
+   size_t m_cBytesPerValue;
+   const unsigned char * m_aValues;
+   IntEbmType m_unknownBinIndex;
+   IntEbmType * m_aBinIndexesOut;
+   size_t m_cBlocks;
+   std::atomic<size_t> m_iBlockNext;
+};
+
+static void EncodeCategoriesWorker(void * const pWorkVoid, const size_t iWorker) {
+   UNUSED(iWorker);
+   EncodeCategoriesWork * const pWork = static_cast<EncodeCategoriesWork *>(pWorkVoid);
+
+   const CategoricalEncoder * const pCategoricalEncoder = pWork->m_pCategoricalEncoder;
+   const size_t cSamples = pWork->m_cSamples;
+   const size_t cBytesPerValue = pWork->m_cBytesPerValue;
+   const IntEbmType unknownBinIndex = pWork->m_unknownBinIndex;
+
+   while(true) {
+      const size_t iBlock = pWork->m_iBlockNext.fetch_add(size_t { 1 }, std::memory_order_relaxed);
+      if(pWork->m_cBlocks <= iBlock) {
+         break;
+      }
+      const size_t iSampleStart = iBlock * k_cEncodeBlockSamples;
+      const size_t iSampleEnd = k_cEncodeBlockSamples < cSamples - iSampleStart ? iSampleStart + k_cEncodeBlockSamples : cSamples;
+
+      const unsigned char * pValue = pWork->m_aValues + iSampleStart * cBytesPerValue;
+      for(size_t iSample = iSampleStart; iSample < iSampleEnd; ++iSample) {
+         pWork->m_aBinIndexesOut[iSample] = pCategoricalEncoder->GetBinIndex(pValue, cBytesPerValue, unknownBinIndex);
+         pValue += cBytesPerValue;
+      }
+   }
+}
+
+// we don't care if an extra log message is outputted due to the non-atomic nature of the decrement to this value
+static int g_cLogEnterEncodeCategoriesParametersMessages = 25;
+static int g_cLogExitEncodeCategoriesParametersMessages = 25;
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION EncodeCategories(
+   CategoricalEncoderHandle categoricalEncoderHandle,
+   IntEbmType countSamples,
+   IntEbmType countBytesPerValue,
+   const void * values,
+   IntEbmType unknownBinIndex,
+   IntEbmType * binIndexesOut
+) {
+   LOG_COUNTED_N(
+      &g_cLogEnterEncodeCategoriesParametersMessages,
+      TraceLevelInfo,
+      TraceLevelVerbose,
+      "Entered EncodeCategories: "
+      "categoricalEncoderHandle=%p, "
+      "countSamples=%" IntEbmTypePrintf ", "
+      "countBytesPerValue=%" IntEbmTypePrintf ", "
+      "values=%p, "
+      "unknownBinIndex=%" IntEbmTypePrintf ", "
+      "binIndexesOut=%p"
+      ,
+      static_cast<void *>(categoricalEncoderHandle),
+      countSamples,
+      countBytesPerValue,
+      values,
+      unknownBinIndex,
+      static_cast<void *>(binIndexesOut)
+   );
+
+   const CategoricalEncoder * const pCategoricalEncoder = reinterpret_cast<const CategoricalEncoder *>(categoricalEncoderHandle);
+   if(nullptr == pCategoricalEncoder) {
+      LOG_0(TraceLevelError, "ERROR EncodeCategories categoricalEncoderHandle cannot be nullptr");
+      return IntEbmType { 1 };
+   }
+   if(countSamples < IntEbmType { 0 }) {
+      LOG_0(TraceLevelError, "ERROR EncodeCategories countSamples cannot be negative");
+      return IntEbmType { 1 };
+   }
+   if(countBytesPerValue < IntEbmType { 0 }) {
+      LOG_0(TraceLevelError, "ERROR EncodeCategories countBytesPerValue cannot be negative");
+      return IntEbmType { 1 };
+   }
+   if(!IsNumberConvertable<size_t>(countSamples) || !IsNumberConvertable<size_t>(countBytesPerValue)) {
+      LOG_0(TraceLevelWarning, "WARNING EncodeCategories countSamples or countBytesPerValue is too large to fit into memory");
+      return IntEbmType { 1 };
+   }
+   const size_t cSamples = static_cast<size_t>(countSamples);
+   const size_t cBytesPerValue = static_cast<size_t>(countBytesPerValue);
+   if(!IsCategoryTypeValid(pCategoricalEncoder->GetCategoryType(), cBytesPerValue, "EncodeCategories")) {
+      return IntEbmType { 1 };
+   }
+   if(size_t { 0 } == cSamples) {
+      return IntEbmType { 0 };
+   }
+   if(IsMultiplyError(cSamples, cBytesPerValue) || IsMultiplyError(cSamples, sizeof(*binIndexesOut))) {
+      LOG_0(TraceLevelWarning, "WARNING EncodeCategories countSamples is too large");
+      return IntEbmType { 1 };
+   }
+   if(size_t { 0 } != cBytesPerValue && nullptr == values) {
+      LOG_0(TraceLevelError, "ERROR EncodeCategories values cannot be nullptr");
+      return IntEbmType { 1 };
+   }
+   if(nullptr == binIndexesOut) {
+      LOG_0(TraceLevelError, "ERROR EncodeCategories binIndexesOut cannot be nullptr");
+      return IntEbmType { 1 };
+   }
+
+   const size_t cBlocks = (cSamples - size_t { 1 }) / k_cEncodeBlockSamples + size_t { 1 };
+   const size_t cWorkersMax = GetCountWorkersMax();
+   const size_t cWorkers = cBlocks < cWorkersMax ? cBlocks : cWorkersMax;
+
+   EncodeCategoriesWork work;
+   work.m_pCategoricalEncoder = pCategoricalEncoder;
+   work.m_cSamples = cSamples;
+   work.m_cBytesPerValue = cBytesPerValue;
+   work.m_aValues = static_cast<const unsigned char *>(values);
+   work.m_unknownBinIndex = unknownBinIndex;
+   work.m_aBinIndexesOut = binIndexesOut;
+   work.m_cBlocks = cBlocks;
+   work.m_iBlockNext.store(size_t { 0 }, std::memory_order_relaxed);
+
+   // the workers only read from the encoder and don't allocate anything, so they can't fail
+   ExecuteParallelWork(cWorkers, &EncodeCategoriesWorker, &work);
+
+   LOG_COUNTED_0(&g_cLogExitEncodeCategoriesParametersMessages, TraceLevelInfo, TraceLevelVerbose, "Exited EncodeCategories");
+   return IntEbmType { 0 };
+}
+
+EBM_NATIVE_IMPORT_EXPORT_BODY void EBM_NATIVE_CALLING_CONVENTION FreeCategoricalEncoder(
+   CategoricalEncoderHandle categoricalEncoderHandle
+) {
+   LOG_N(TraceLevelInfo, "Entered FreeCategoricalEncoder: categoricalEncoderHandle=%p", static_cast<void *>(categoricalEncoderHandle));
+
+   CategoricalEncoder::Free(reinterpret_cast<CategoricalEncoder *>(categoricalEncoderHandle));
+
+   LOG_0(TraceLevelInfo, "Exited FreeCategoricalEncoder");
+}
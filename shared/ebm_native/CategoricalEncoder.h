@@ -0,0 +1,66 @@
+// Copyright (c) 2018 Microsoft Corporation
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#ifndef CATEGORICAL_ENCODER_H
+#define CATEGORICAL_ENCODER_H
+
+#include <stdlib.h> // free
+#include <stddef.h> // size_t, ptrdiff_t
+#include <stdint.h> // uint64_t
+
+#include "ebm_native.h"
+#include "EbmInternal.h" // INLINE_ALWAYS
+#include "Logging.h" // EBM_ASSERT & LOG
+
+// maps categories to bin indexes with an open addressing hash table.  We store every category as a string of bytes
+// after normalizing it (see NormalizeCategory), so the same table handles integers, doubles, and strings.
+// The table is read-only after Allocate, so any number of threads can call GetBinIndex at the same time.
+class CategoricalEncoder final {
+   CategoryTypeType m_categoryType;
+   size_t m_cCategories;
+
+   // the number of slots is a power of two, so we can use a mask instead of a modulo
+   size_t m_cSlotsMask;
+   // zero for an empty slot, otherwise the index of the category plus one
+   size_t * m_aiSlots;
+
+   uint64_t * m_aHashes;
+   // the category iCategory occupies m_aKeys[m_aiKeyStarts[iCategory]] up to m_aKeys[m_aiKeyStarts[iCategory + 1]]
+   size_t * m_aiKeyStarts;
+   unsigned char * m_aKeys;
+   IntEbmType * m_aBinIndexes;
+
+   size_t FindSlot(const unsigned char * const pKey, const size_t cKeyBytes, const uint64_t hash) const;
+
+public:
+
+   CategoricalEncoder() = default; // preserve our POD status
+   ~CategoricalEncoder() = default; // preserve our POD status
+   void * operator new(std::size_t) = delete; // we only use malloc/free in this library
+   void operator delete (void *) = delete; // we only use malloc/free in this library
+
+   static void Free(CategoricalEncoder * const pCategoricalEncoder);
+   // if the same category appears more than once, the last one's bin index wins
+   static CategoricalEncoder * Allocate(
+      const CategoryTypeType categoryType,
+      const size_t cBytesPerCategory,
+      const size_t cCategories,
+      const unsigned char * const aCategories,
+      const IntEbmType * const aBinIndexes
+   );
+
+   IntEbmType GetBinIndex(const unsigned char * const pValue, const size_t cBytesPerValue, const IntEbmType unknownBinIndex) const;
+
+   INLINE_ALWAYS CategoryTypeType GetCategoryType() const {
+      return m_categoryType;
+   }
+};
+static_assert(std::is_standard_layout<CategoricalEncoder>::value,
+   "We use the struct hack in several places, so disallow non-standard_layout types in general");
+static_assert(std::is_trivial<CategoricalEncoder>::value,
+   "We use memcpy in several places, so disallow non-trivial types in general");
+static_assert(std::is_pod<CategoricalEncoder>::value,
+   "We use a lot of C constructs, so disallow non-POD types in general");
+
+#endif // CATEGORICAL_ENCODER_H
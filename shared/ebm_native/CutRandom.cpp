@@ -642,13 +642,24 @@ extern bool CutRandom(
    const ptrdiff_t runtimeLearningTypeOrCountTargetClasses = pBooster->GetRuntimeLearningTypeOrCountTargetClasses();
 
    if(IsClassification(runtimeLearningTypeOrCountTargetClasses)) {
-      return CutRandomTarget<2>::Func(
-         pThreadStateBoosting,
-         pFeatureGroup,
-         options,
-         aLeavesMax,
-         pTotalGain
-      );
+      if(k_cCompilerOptimizedTargetClassesMax < runtimeLearningTypeOrCountTargetClasses) {
+         // there is no compiler optimized version for this many classes, so skip the template chain that looks for one
+         return CutRandomTarget<k_cCompilerOptimizedTargetClassesMax + 1>::Func(
+            pThreadStateBoosting,
+            pFeatureGroup,
+            options,
+            aLeavesMax,
+            pTotalGain
+         );
+      } else {
+         return CutRandomTarget<2>::Func(
+            pThreadStateBoosting,
+            pFeatureGroup,
+            options,
+            aLeavesMax,
+            pTotalGain
+         );
+      }
    } else {
       EBM_ASSERT(IsRegression(runtimeLearningTypeOrCountTargetClasses));
       return CutRandomInternal<k_regression>::Func(
@@ -6,11 +6,17 @@
 
 #include <stdlib.h> // free
 #include <stddef.h> // size_t, ptrdiff_t
+#include <string.h> // memcpy
 
 #include "ebm_native.h" // FloatEbmType
 #include "EbmInternal.h"
 #include "Logging.h" // EBM_ASSERT & LOG
+#include "RandomStream.h"
 #include "FeatureAtomic.h"
+#include "FeatureGroup.h"
+#include "SegmentedTensor.h"
+#include "DataSetBoosting.h"
+#include "Booster.h"
 #include "DataSetInteraction.h"
 
 extern bool InitializeResiduals(
@@ -89,7 +95,17 @@ INLINE_RELEASE_UNTEMPLATED static StorageDataType * * ConstructInputData(
    const Feature * pFeature = aFeatures;
    const Feature * const pFeatureEnd = aFeatures + cFeatures;
    do {
-      StorageDataType * pInputDataTo = EbmMalloc<StorageDataType>(cSamples);
+      const size_t cItemsPerBitPackedDataUnit = DataSetByFeature::GetCountItemsPerBitPackedDataUnit(pFeature);
+      // for a 32/64 bit storage item, we can't have more than 32/64 bit packed items stored
+      EBM_ASSERT(1 <= cItemsPerBitPackedDataUnit);
+      EBM_ASSERT(cItemsPerBitPackedDataUnit <= k_cBitsForStorageType);
+      const size_t cBitsPerItemMax = GetCountBits(cItemsPerBitPackedDataUnit);
+      // if we have 1 item, it can't be larger than the number of bits of storage
+      EBM_ASSERT(cBitsPerItemMax <= k_cBitsForStorageType);
+
+      const size_t cDataUnits = (cSamples - 1) / cItemsPerBitPackedDataUnit + 1; // this can't overflow or underflow
+
+      StorageDataType * pInputDataTo = EbmMalloc<StorageDataType>(cDataUnits);
       if(nullptr == pInputDataTo) {
          LOG_0(TraceLevelWarning, "WARNING DataSetByFeature::ConstructInputData nullptr == pInputDataTo");
          goto free_all;
@@ -99,6 +115,9 @@ INLINE_RELEASE_UNTEMPLATED static StorageDataType * * ConstructInputData(
 
       const IntEbmType * pInputDataFrom = &aBinnedData[pFeature->GetIndexFeatureData() * cSamples];
       const IntEbmType * pInputDataFromEnd = &pInputDataFrom[cSamples];
+      size_t bits = 0;
+      size_t shift = 0;
+      const size_t shiftEnd = cBitsPerItemMax * cItemsPerBitPackedDataUnit;
       do {
          const IntEbmType inputData = *pInputDataFrom;
          if(inputData < 0) {
@@ -118,10 +137,20 @@ INLINE_RELEASE_UNTEMPLATED static StorageDataType * * ConstructInputData(
             LOG_0(TraceLevelError, "ERROR DataSetByFeature::ConstructInputData iData value must be less than the number of bins");
             goto free_all;
          }
-         *pInputDataTo = static_cast<StorageDataType>(inputData);
-         ++pInputDataTo;
+         // put our first item in the least significant bits so that BitPackedBinReader can AND the mask and then shift down
+         EBM_ASSERT(shift < k_cBitsForStorageType);
+         bits |= iData << shift;
+         shift += cBitsPerItemMax;
          ++pInputDataFrom;
+         if(shiftEnd == shift || pInputDataFromEnd == pInputDataFrom) {
+            EBM_ASSERT(IsNumberConvertable<StorageDataType>(bits));
+            *pInputDataTo = static_cast<StorageDataType>(bits);
+            ++pInputDataTo;
+            bits = 0;
+            shift = 0;
+         }
       } while(pInputDataFromEnd != pInputDataFrom);
+      EBM_ASSERT(*(paInputDataTo - 1) + cDataUnits == pInputDataTo);
 
       ++pFeature;
    } while(pFeatureEnd != pFeature);
@@ -146,13 +175,10 @@ void DataSetByFeature::Destruct() {
    free(m_aResidualErrors);
    if(nullptr != m_aaInputData) {
       EBM_ASSERT(1 <= m_cFeatures);
-      StorageDataType ** paInputData = m_aaInputData;
-      const StorageDataType * const * const paInputDataEnd = m_aaInputData + m_cFeatures;
-      do {
-         EBM_ASSERT(nullptr != *paInputData);
-         free(*paInputData);
-         ++paInputData;
-      } while(paInputDataEnd != paInputData);
+      for(size_t iFeature = 0; iFeature < m_cFeatures; ++iFeature) {
+         // if we failed part way through InitializeFromBooster the remaining pointers are nullptr, which free ignores
+         free(m_aaInputData[iFeature]);
+      }
       free(m_aaInputData);
    }
 
@@ -234,3 +260,454 @@ exit_error:;
    LOG_0(TraceLevelWarning, "WARNING Exited DataSetByFeature::Initialize");
    return true;
 }
+
+bool DataSetByFeature::InitializeSubsample(
+   const DataSetByFeature * const pDataSetOriginal,
+   const Feature * const aFeatures,
+   const size_t cVectorLength,
+   const size_t cSamplesSubsample,
+   const bool bWithReplacement,
+   RandomStream * const pRandomStream
+) {
+   EBM_ASSERT(nullptr == m_aResidualErrors); // we expect to start with zeroed values
+   EBM_ASSERT(nullptr == m_aaInputData); // we expect to start with zeroed values
+   EBM_ASSERT(0 == m_cSamples); // we expect to start with zeroed values
+   EBM_ASSERT(nullptr != pDataSetOriginal);
+   EBM_ASSERT(1 <= cVectorLength);
+   EBM_ASSERT(1 <= cSamplesSubsample);
+   EBM_ASSERT(bWithReplacement || cSamplesSubsample <= pDataSetOriginal->m_cSamples);
+   EBM_ASSERT(nullptr != pRandomStream);
+
+   LOG_0(TraceLevelInfo, "Entered DataSetByFeature::InitializeSubsample");
+
+   const size_t cSamples = pDataSetOriginal->m_cSamples;
+   const size_t cFeatures = pDataSetOriginal->m_cFeatures;
+   EBM_ASSERT(1 <= cSamples);
+
+   FloatEbmType * aResidualErrors = nullptr;
+   size_t * const aiSamples = EbmMalloc<size_t>(cSamplesSubsample);
+   StorageDataType ** const aaInputData = 0 == cFeatures ? nullptr : EbmMalloc<StorageDataType *>(cFeatures);
+   StorageDataType ** paInputDataTo = aaInputData;
+   if(nullptr == aiSamples || 0 != cFeatures && nullptr == aaInputData) {
+      LOG_0(TraceLevelWarning, "WARNING DataSetByFeature::InitializeSubsample nullptr == aiSamples || nullptr == aaInputData");
+      goto free_all;
+   }
+   if(IsMultiplyError(cVectorLength, cSamplesSubsample)) {
+      // without replacement cSamplesSubsample <= cSamples and the original residuals were allocated, but bootstrap draws can be more
+      LOG_0(TraceLevelWarning, "WARNING DataSetByFeature::InitializeSubsample IsMultiplyError(cVectorLength, cSamplesSubsample)");
+      goto free_all;
+   }
+   aResidualErrors = EbmMalloc<FloatEbmType>(cVectorLength * cSamplesSubsample);
+   if(nullptr == aResidualErrors) {
+      LOG_0(TraceLevelWarning, "WARNING DataSetByFeature::InitializeSubsample nullptr == aResidualErrors");
+      goto free_all;
+   }
+
+   // we keep the chosen samples in their original order, with repeats next to each other, so that we can pull their bins out of the 
+   // bit packed features in one forward pass
+   if(bWithReplacement) {
+      size_t * const acOccurrences = EbmMalloc<size_t>(cSamples);
+      if(nullptr == acOccurrences) {
+         LOG_0(TraceLevelWarning, "WARNING DataSetByFeature::InitializeSubsample nullptr == acOccurrences");
+         goto free_all;
+      }
+      memset(acOccurrences, 0, sizeof(*acOccurrences) * cSamples);
+      for(size_t iDraw = 0; iDraw < cSamplesSubsample; ++iDraw) {
+         ++acOccurrences[pRandomStream->Next(cSamples)];
+      }
+      size_t * piSampleTo = aiSamples;
+      for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+         for(size_t iOccurrence = 0; iOccurrence < acOccurrences[iSample]; ++iOccurrence) {
+            *piSampleTo = iSample;
+            ++piSampleTo;
+         }
+      }
+      EBM_ASSERT(aiSamples + cSamplesSubsample == piSampleTo);
+      free(acOccurrences);
+   } else {
+      // selection sampling takes each sample with probability (samples still needed) / (samples still left), which picks exactly 
+      // cSamplesSubsample distinct samples and only needs one pass
+      size_t cSamplesNeeded = cSamplesSubsample;
+      size_t * piSampleTo = aiSamples;
+      for(size_t iSample = 0; size_t { 0 } != cSamplesNeeded; ++iSample) {
+         EBM_ASSERT(iSample < cSamples);
+         if(pRandomStream->Next(cSamples - iSample) < cSamplesNeeded) {
+            *piSampleTo = iSample;
+            ++piSampleTo;
+            --cSamplesNeeded;
+         }
+      }
+      EBM_ASSERT(aiSamples + cSamplesSubsample == piSampleTo);
+   }
+
+   {
+      const FloatEbmType * const aResidualErrorsFrom = pDataSetOriginal->m_aResidualErrors;
+      FloatEbmType * pResidualErrorTo = aResidualErrors;
+      const size_t * const piSampleEnd = aiSamples + cSamplesSubsample;
+      for(const size_t * piSample = aiSamples; piSampleEnd != piSample; ++piSample) {
+         memcpy(pResidualErrorTo, &aResidualErrorsFrom[*piSample * cVectorLength], sizeof(*pResidualErrorTo) * cVectorLength);
+         pResidualErrorTo += cVectorLength;
+      }
+   }
+
+   if(0 != cFeatures) {
+      const Feature * pFeature = aFeatures;
+      const Feature * const pFeatureEnd = aFeatures + cFeatures;
+      do {
+         const size_t cItemsPerBitPackedDataUnit = DataSetByFeature::GetCountItemsPerBitPackedDataUnit(pFeature);
+         const size_t cBitsPerItemMax = GetCountBits(cItemsPerBitPackedDataUnit);
+         const size_t cDataUnits = (cSamplesSubsample - 1) / cItemsPerBitPackedDataUnit + 1; // this can't overflow or underflow
+
+         StorageDataType * pInputDataTo = EbmMalloc<StorageDataType>(cDataUnits);
+         if(nullptr == pInputDataTo) {
+            LOG_0(TraceLevelWarning, "WARNING DataSetByFeature::InitializeSubsample nullptr == pInputDataTo");
+            goto free_all;
+         }
+         *paInputDataTo = pInputDataTo;
+         ++paInputDataTo;
+
+         // the original data was already checked when it was constructed, so we only need to repack the chosen samples
+         BitPackedBinReader binReader;
+         binReader.Initialize(pDataSetOriginal->GetInputDataPointer(pFeature), cItemsPerBitPackedDataUnit);
+         const size_t * piSample = aiSamples;
+         const size_t * const piSampleEnd = aiSamples + cSamplesSubsample;
+         size_t iSampleOriginal = 0;
+         size_t iBin = binReader.Next();
+         size_t bits = 0;
+         size_t shift = 0;
+         const size_t shiftEnd = cBitsPerItemMax * cItemsPerBitPackedDataUnit;
+         do {
+            const size_t iSample = *piSample;
+            EBM_ASSERT(iSampleOriginal <= iSample);
+            EBM_ASSERT(iSample < cSamples);
+            while(iSampleOriginal != iSample) {
+               iBin = binReader.Next();
+               ++iSampleOriginal;
+            }
+            EBM_ASSERT(iBin < pFeature->GetCountBins());
+            bits |= iBin << shift;
+            shift += cBitsPerItemMax;
+            ++piSample;
+            if(shiftEnd == shift || piSampleEnd == piSample) {
+               *pInputDataTo = static_cast<StorageDataType>(bits);
+               ++pInputDataTo;
+               bits = 0;
+               shift = 0;
+            }
+         } while(piSampleEnd != piSample);
+         EBM_ASSERT(*(paInputDataTo - 1) + cDataUnits == pInputDataTo);
+
+         ++pFeature;
+      } while(pFeatureEnd != pFeature);
+   }
+
+   free(aiSamples);
+
+   m_aResidualErrors = aResidualErrors;
+   m_aaInputData = aaInputData;
+   m_cSamples = cSamplesSubsample;
+   m_cFeatures = cFeatures;
+
+   LOG_0(TraceLevelInfo, "Exited DataSetByFeature::InitializeSubsample");
+   return false;
+
+free_all:
+   if(nullptr != aaInputData) {
+      while(aaInputData != paInputDataTo) {
+         --paInputDataTo;
+         free(*paInputDataTo);
+      }
+      free(aaInputData);
+   }
+   free(aiSamples);
+   free(aResidualErrors);
+   LOG_0(TraceLevelWarning, "WARNING Exited DataSetByFeature::InitializeSubsample");
+   return true;
+}
+
+// returns the feature group that holds pFeatureBooster as a significant dimension, preferring a feature group with only that feature since 
+// those pack their tensor index, which is then just the bin, exactly the way we pack our features.  Returns nullptr if there isn't one
+static const FeatureGroup * FindFeatureGroupWithFeature(const Booster * const pBooster, const Feature * const pFeatureBooster) {
+   const FeatureGroup * pFeatureGroupFound = nullptr;
+   const size_t cFeatureGroups = pBooster->GetCountFeatureGroups();
+   for(size_t iFeatureGroup = 0; iFeatureGroup < cFeatureGroups; ++iFeatureGroup) {
+      const FeatureGroup * const pFeatureGroup = pBooster->GetFeatureGroups()[iFeatureGroup];
+      const FeatureGroupEntry * pFeatureGroupEntry = pFeatureGroup->GetFeatureGroupEntries();
+      const FeatureGroupEntry * const pFeatureGroupEntryEnd = pFeatureGroupEntry + pFeatureGroup->GetCountFeatures();
+      for(; pFeatureGroupEntryEnd != pFeatureGroupEntry; ++pFeatureGroupEntry) {
+         if(pFeatureBooster == pFeatureGroupEntry->m_pFeature) {
+            if(size_t { 1 } == pFeatureGroup->GetCountSignificantFeatures()) {
+               return pFeatureGroup;
+            }
+            if(nullptr == pFeatureGroupFound) {
+               pFeatureGroupFound = pFeatureGroup;
+            }
+            break;
+         }
+      }
+   }
+   return pFeatureGroupFound;
+}
+
+// pulls the bins of one feature back out of the tensor indexes of a feature group that has other significant features, and packs them 
+// the way we pack our own features
+static StorageDataType * ExtractInputData(
+   const DataSetByFeatureGroup * const pTrainingSet,
+   const FeatureGroup * const pFeatureGroup,
+   const Feature * const pFeatureBooster
+) {
+   const size_t cSamples = pTrainingSet->GetCountSamples();
+   EBM_ASSERT(1 <= cSamples);
+
+   // the tensor index is sum(iBin * tensorMultiple) over the significant features, the same as in DataSetByFeatureGroup::ConstructInputData
+   size_t tensorMultiple = 1;
+   const FeatureGroupEntry * pFeatureGroupEntry = pFeatureGroup->GetFeatureGroupEntries();
+   while(pFeatureBooster != pFeatureGroupEntry->m_pFeature) {
+      const size_t cBinsOther = pFeatureGroupEntry->m_pFeature->GetCountBins();
+      if(size_t { 1 } < cBinsOther) {
+         tensorMultiple *= cBinsOther;
+      }
+      ++pFeatureGroupEntry;
+   }
+   const size_t cBins = pFeatureBooster->GetCountBins();
+   EBM_ASSERT(size_t { 2 } <= cBins);
+
+   const size_t cItemsPerBitPackedDataUnit = DataSetByFeature::GetCountItemsPerBitPackedDataUnit(pFeatureBooster);
+   const size_t cBitsPerItemMax = GetCountBits(cItemsPerBitPackedDataUnit);
+   const size_t cDataUnits = (cSamples - 1) / cItemsPerBitPackedDataUnit + 1; // this can't overflow or underflow
+
+   StorageDataType * const aInputData = EbmMalloc<StorageDataType>(cDataUnits);
+   if(nullptr == aInputData) {
+      LOG_0(TraceLevelWarning, "WARNING ExtractInputData nullptr == aInputData");
+      return nullptr;
+   }
+
+   BitPackedBinReader binReader;
+   binReader.Initialize(pTrainingSet->GetInputDataPointer(pFeatureGroup), pFeatureGroup->GetCountItemsPerBitPackedDataUnit());
+   StorageDataType * pInputDataTo = aInputData;
+   size_t bits = 0;
+   size_t shift = 0;
+   const size_t shiftEnd = cBitsPerItemMax * cItemsPerBitPackedDataUnit;
+   for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+      const size_t iBin = binReader.Next() / tensorMultiple % cBins;
+      bits |= iBin << shift;
+      shift += cBitsPerItemMax;
+      if(shiftEnd == shift) {
+         *pInputDataTo = static_cast<StorageDataType>(bits);
+         ++pInputDataTo;
+         bits = 0;
+         shift = 0;
+      }
+   }
+   if(size_t { 0 } != shift) {
+      *pInputDataTo = static_cast<StorageDataType>(bits);
+      ++pInputDataTo;
+   }
+   EBM_ASSERT(aInputData + cDataUnits == pInputDataTo);
+   return aInputData;
+}
+
+// The Booster keeps the predictor scores of its current model, which includes every update so far.  The best model can differ from it in 
+// any feature group, so we get its predictor scores by adding (best - current) from every feature group that differs.  We add the
+// differences times sign, which lets regression apply them to the residuals directly since residuals there are target - prediction
+static void AddBestModelDifferences(
+   Booster * const pBooster,
+   const FloatEbmType sign,
+   FloatEbmType * const aValues
+) {
+   DataSetByFeatureGroup * const pTrainingSet = pBooster->GetTrainingSet();
+   const size_t cSamples = pTrainingSet->GetCountSamples();
+   const size_t cVectorLength = GetVectorLength(pBooster->GetRuntimeLearningTypeOrCountTargetClasses());
+   const size_t cFeatureGroups = pBooster->GetCountFeatureGroups();
+   for(size_t iFeatureGroup = 0; iFeatureGroup < cFeatureGroups; ++iFeatureGroup) {
+      const FeatureGroup * const pFeatureGroup = pBooster->GetFeatureGroups()[iFeatureGroup];
+      SegmentedTensor * const pBestModel = pBooster->GetBestModel()[iFeatureGroup];
+      SegmentedTensor * const pCurrentModel = pBooster->GetCurrentModel()[iFeatureGroup];
+      EBM_ASSERT(pBestModel->GetExpanded()); // the model should have been expanded at startup
+      EBM_ASSERT(pCurrentModel->GetExpanded()); // the model should have been expanded at startup
+      const FloatEbmType * const aBestValues = pBestModel->GetValuePointer();
+      const FloatEbmType * const aCurrentValues = pCurrentModel->GetValuePointer();
+
+      size_t cTensorBins = 1;
+      const FeatureGroupEntry * pFeatureGroupEntry = pFeatureGroup->GetFeatureGroupEntries();
+      const FeatureGroupEntry * const pFeatureGroupEntryEnd = pFeatureGroupEntry + pFeatureGroup->GetCountFeatures();
+      for(; pFeatureGroupEntryEnd != pFeatureGroupEntry; ++pFeatureGroupEntry) {
+         const size_t cBins = pFeatureGroupEntry->m_pFeature->GetCountBins();
+         if(size_t { 1 } < cBins) {
+            // the booster allocated this tensor, so this can't overflow
+            cTensorBins *= cBins;
+         }
+      }
+      if(0 == memcmp(aBestValues, aCurrentValues, sizeof(*aBestValues) * cTensorBins * cVectorLength)) {
+         // the usual case.  The last rounds of boosting on this feature group improved the validation metric, or it was never boosted
+         continue;
+      }
+
+      FloatEbmType * pValue = aValues;
+      if(size_t { 0 } == pFeatureGroup->GetCountSignificantFeatures()) {
+         // feature groups without significant features have no input data and put every sample in their single tensor bin
+         for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+            for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
+               *pValue += sign * (aBestValues[iVector] - aCurrentValues[iVector]);
+               ++pValue;
+            }
+         }
+      } else {
+         BitPackedBinReader binReader;
+         binReader.Initialize(pTrainingSet->GetInputDataPointer(pFeatureGroup), pFeatureGroup->GetCountItemsPerBitPackedDataUnit());
+         for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+            const size_t iTensorBin = binReader.Next();
+            EBM_ASSERT(iTensorBin < cTensorBins);
+            const FloatEbmType * const pBestValues = &aBestValues[iTensorBin * cVectorLength];
+            const FloatEbmType * const pCurrentValues = &aCurrentValues[iTensorBin * cVectorLength];
+            for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
+               *pValue += sign * (pBestValues[iVector] - pCurrentValues[iVector]);
+               ++pValue;
+            }
+         }
+      }
+   }
+}
+
+// Builds our dataset from the Booster's training set instead of from the original binned data, or from aBinnedData if our caller bins 
+// the Booster's training samples differently for us.  Everything is copied, so the residuals are a snapshot of the model at this point.  
+// Boosting further doesn't change our scores and the Booster can be freed before we are
+bool DataSetByFeature::InitializeFromBooster(
+   Booster * const pBooster,
+   const size_t cFeatures,
+   const Feature * const aFeatures,
+   const IntEbmType * const aBinnedData,
+   const bool bUseBestModel
+) {
+   EBM_ASSERT(nullptr == m_aResidualErrors); // we expect to start with zeroed values
+   EBM_ASSERT(nullptr == m_aaInputData); // we expect to start with zeroed values
+   EBM_ASSERT(0 == m_cSamples); // we expect to start with zeroed values
+   EBM_ASSERT(nullptr != pBooster);
+
+   LOG_0(TraceLevelInfo, "Entered DataSetByFeature::InitializeFromBooster");
+
+   DataSetByFeatureGroup * const pTrainingSet = pBooster->GetTrainingSet();
+   const size_t cSamples = pTrainingSet->GetCountSamples();
+   const ptrdiff_t runtimeLearningTypeOrCountTargetClasses = pBooster->GetRuntimeLearningTypeOrCountTargetClasses();
+   const Feature * const aFeaturesBooster = pBooster->GetFeatures();
+
+   m_cFeatures = cFeatures;
+   if(0 == cSamples) {
+      LOG_0(TraceLevelInfo, "Exited DataSetByFeature::InitializeFromBooster with zero samples");
+      return false;
+   }
+   m_cSamples = cSamples;
+
+   if(nullptr != aBinnedData) {
+      if(0 != cFeatures) {
+         StorageDataType ** const aaInputData = ConstructInputData(cFeatures, aFeatures, cSamples, aBinnedData);
+         if(nullptr == aaInputData) {
+            // error already logged
+            return true;
+         }
+         m_aaInputData = aaInputData;
+      }
+   } else if(0 != cFeatures) {
+      EBM_ASSERT(pBooster->GetCountFeatures() == cFeatures);
+      m_aaInputData = EbmMalloc<StorageDataType *>(cFeatures);
+      if(nullptr == m_aaInputData) {
+         LOG_0(TraceLevelWarning, "WARNING DataSetByFeature::InitializeFromBooster nullptr == m_aaInputData");
+         return true;
+      }
+      for(size_t iFeature = 0; iFeature < cFeatures; ++iFeature) {
+         // so that Destruct can clean up after a failure part way through
+         m_aaInputData[iFeature] = nullptr;
+      }
+      for(size_t iFeature = 0; iFeature < cFeatures; ++iFeature) {
+         const Feature * const pFeature = &aFeatures[iFeature];
+         const Feature * const pFeatureBooster = &aFeaturesBooster[iFeature];
+         const size_t cBins = pFeature->GetCountBins();
+         if(cBins <= size_t { 1 }) {
+            // every sample is in bin 0, and the booster drops these from its tensors, so there's nothing to copy
+            const size_t cDataUnits = (cSamples - 1) / GetCountItemsPerBitPackedDataUnit(pFeature) + 1;
+            StorageDataType * const aInputData = EbmMalloc<StorageDataType>(cDataUnits);
+            if(nullptr == aInputData) {
+               LOG_0(TraceLevelWarning, "WARNING DataSetByFeature::InitializeFromBooster nullptr == aInputData");
+               return true;
+            }
+            memset(aInputData, 0, sizeof(*aInputData) * cDataUnits);
+            m_aaInputData[iFeature] = aInputData;
+            continue;
+         }
+         const FeatureGroup * const pFeatureGroup = FindFeatureGroupWithFeature(pBooster, pFeatureBooster);
+         if(nullptr == pFeatureGroup) {
+            LOG_0(TraceLevelError, "ERROR DataSetByFeature::InitializeFromBooster every feature with 2 or more bins must be in a feature group of the booster");
+            return true;
+         }
+         if(size_t { 1 } == pFeatureGroup->GetCountSignificantFeatures()) {
+            EBM_ASSERT(GetCountItemsPerBitPackedDataUnit(pFeature) == pFeatureGroup->GetCountItemsPerBitPackedDataUnit());
+            // the booster already packed this feature the way we would, so copy it as is
+            const size_t cDataUnits = (cSamples - 1) / GetCountItemsPerBitPackedDataUnit(pFeature) + 1;
+            StorageDataType * const aInputData = EbmMalloc<StorageDataType>(cDataUnits);
+            if(nullptr == aInputData) {
+               LOG_0(TraceLevelWarning, "WARNING DataSetByFeature::InitializeFromBooster nullptr == aInputData");
+               return true;
+            }
+            memcpy(aInputData, pTrainingSet->GetInputDataPointer(pFeatureGroup), sizeof(*aInputData) * cDataUnits);
+            m_aaInputData[iFeature] = aInputData;
+         } else {
+            StorageDataType * const aInputData = ExtractInputData(pTrainingSet, pFeatureGroup, pFeatureBooster);
+            if(nullptr == aInputData) {
+               return true;
+            }
+            m_aaInputData[iFeature] = aInputData;
+         }
+      }
+   }
+
+   const size_t cVectorLength = GetVectorLength(runtimeLearningTypeOrCountTargetClasses);
+   // the booster allocated its residuals with this size, so this can't overflow
+   EBM_ASSERT(!IsMultiplyError(cSamples, cVectorLength));
+   const size_t cElements = cSamples * cVectorLength;
+   FloatEbmType * const aResidualErrors = EbmMalloc<FloatEbmType>(cElements);
+   if(nullptr == aResidualErrors) {
+      LOG_0(TraceLevelWarning, "WARNING DataSetByFeature::InitializeFromBooster nullptr == aResidualErrors");
+      return true;
+   }
+   m_aResidualErrors = aResidualErrors;
+   if(!bUseBestModel || nullptr == pBooster->GetBestModel()) {
+      // the residuals of the current model are the ones that the booster already maintains
+      memcpy(aResidualErrors, pTrainingSet->GetResidualPointer(), sizeof(*aResidualErrors) * cElements);
+   } else if(IsClassification(runtimeLearningTypeOrCountTargetClasses)) {
+      FloatEbmType * const aPredictorScores = EbmMalloc<FloatEbmType>(cElements);
+      IntEbmType * const aTargets = EbmMalloc<IntEbmType>(cSamples);
+      if(nullptr == aPredictorScores || nullptr == aTargets) {
+         LOG_0(TraceLevelWarning, "WARNING DataSetByFeature::InitializeFromBooster nullptr == aPredictorScores || nullptr == aTargets");
+         free(aTargets);
+         free(aPredictorScores);
+         return true;
+      }
+      memcpy(aPredictorScores, pTrainingSet->GetPredictorScores(), sizeof(*aPredictorScores) * cElements);
+      AddBestModelDifferences(pBooster, FloatEbmType { 1 }, aPredictorScores);
+      // InitializeResiduals takes targets in the form our callers give them to us
+      const StorageDataType * const aTargetData = pTrainingSet->GetTargetDataPointer();
+      for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+         aTargets[iSample] = static_cast<IntEbmType>(aTargetData[iSample]);
+      }
+      const bool bError = InitializeResiduals(
+         runtimeLearningTypeOrCountTargetClasses, 
+         cSamples, 
+         aTargets, 
+         aPredictorScores, 
+         aResidualErrors
+      );
+      free(aTargets);
+      free(aPredictorScores);
+      if(bError) {
+         // error already logged
+         return true;
+      }
+   } else {
+      EBM_ASSERT(IsRegression(runtimeLearningTypeOrCountTargetClasses));
+      memcpy(aResidualErrors, pTrainingSet->GetResidualPointer(), sizeof(*aResidualErrors) * cElements);
+      AddBestModelDifferences(pBooster, FloatEbmType { -1 }, aResidualErrors);
+   }
+
+   LOG_0(TraceLevelInfo, "Exited DataSetByFeature::InitializeFromBooster");
+   return false;
+}
@@ -6,12 +6,67 @@
 #define DATA_SET_BY_FEATURE_H
 
 #include <stddef.h> // size_t, ptrdiff_t
+#include <limits> // numeric_limits
 
 #include "ebm_native.h" // FloatEbmType
 #include "EbmInternal.h" // INLINE_ALWAYS
 #include "Logging.h" // EBM_ASSERT & LOG
+#include "RandomStream.h"
 #include "FeatureAtomic.h"
 
+// Reads the bit packed bins of one feature in sample order.  Each StorageDataType holds cItemsPerBitPackedDataUnit bins with the first 
+// sample in the least significant bits, the same way that DataSetByFeatureGroup packs its data
+class BitPackedBinReader final {
+   const StorageDataType * m_pInputData;
+   size_t m_bits;
+   size_t m_cItemsRemaining;
+   size_t m_cItemsPerBitPackedDataUnit;
+   size_t m_cBitsPerItemMax;
+   size_t m_maskBits;
+
+public:
+
+   BitPackedBinReader() = default; // preserve our POD status
+   ~BitPackedBinReader() = default; // preserve our POD status
+   void * operator new(std::size_t) = delete; // we only use malloc/free in this library
+   void operator delete (void *) = delete; // we only use malloc/free in this library
+
+   INLINE_ALWAYS void Initialize(const StorageDataType * const pInputData, const size_t cItemsPerBitPackedDataUnit) {
+      EBM_ASSERT(nullptr != pInputData);
+      EBM_ASSERT(1 <= cItemsPerBitPackedDataUnit);
+      EBM_ASSERT(cItemsPerBitPackedDataUnit <= k_cBitsForStorageType);
+      m_pInputData = pInputData;
+      m_bits = 0;
+      m_cItemsRemaining = 0;
+      m_cItemsPerBitPackedDataUnit = cItemsPerBitPackedDataUnit;
+      const size_t cBitsPerItemMax = GetCountBits(cItemsPerBitPackedDataUnit);
+      EBM_ASSERT(1 <= cBitsPerItemMax);
+      EBM_ASSERT(cBitsPerItemMax <= k_cBitsForStorageType);
+      m_cBitsPerItemMax = cBitsPerItemMax;
+      m_maskBits = std::numeric_limits<size_t>::max() >> (k_cBitsForStorageType - cBitsPerItemMax);
+   }
+
+   INLINE_ALWAYS size_t Next() {
+      if(UNLIKELY(size_t { 0 } == m_cItemsRemaining)) {
+         m_bits = static_cast<size_t>(*m_pInputData);
+         ++m_pInputData;
+         m_cItemsRemaining = m_cItemsPerBitPackedDataUnit;
+      }
+      --m_cItemsRemaining;
+      const size_t iBin = m_maskBits & m_bits;
+      m_bits >>= m_cBitsPerItemMax;
+      return iBin;
+   }
+};
+static_assert(std::is_standard_layout<BitPackedBinReader>::value,
+   "We use the struct hack in several places, so disallow non-standard_layout types in general");
+static_assert(std::is_trivial<BitPackedBinReader>::value,
+   "We use memcpy in several places, so disallow non-trivial types in general");
+static_assert(std::is_pod<BitPackedBinReader>::value,
+   "We use a lot of C constructs, so disallow non-POD types in general");
+
+class Booster;
+
 class DataSetByFeature final {
    FloatEbmType * m_aResidualErrors;
    StorageDataType * * m_aaInputData;
@@ -44,6 +99,23 @@ public:
       const ptrdiff_t runtimeLearningTypeOrCountTargetClasses
    );
 
+   bool InitializeSubsample(
+      const DataSetByFeature * const pDataSetOriginal,
+      const Feature * const aFeatures,
+      const size_t cVectorLength,
+      const size_t cSamplesSubsample,
+      const bool bWithReplacement,
+      RandomStream * const pRandomStream
+   );
+
+   bool InitializeFromBooster(
+      Booster * const pBooster,
+      const size_t cFeatures,
+      const Feature * const aFeatures,
+      const IntEbmType * const aBinnedData,
+      const bool bUseBestModel
+   );
+
    INLINE_ALWAYS const FloatEbmType * GetResidualPointer() const {
       EBM_ASSERT(nullptr != m_aResidualErrors);
       return m_aResidualErrors;
@@ -55,6 +127,13 @@ public:
       EBM_ASSERT(nullptr != m_aaInputData);
       return m_aaInputData[pFeature->GetIndexFeatureData()];
    }
+   // each feature is bit packed with as many bins per StorageDataType as will fit, so 256 bin features take 8 bits per sample
+   INLINE_ALWAYS static size_t GetCountItemsPerBitPackedDataUnit(const Feature * const pFeature) {
+      EBM_ASSERT(nullptr != pFeature);
+      const size_t cBins = pFeature->GetCountBins();
+      const size_t cBitsRequiredMin = cBins <= size_t { 1 } ? size_t { 1 } : CountBitsRequired(cBins - 1);
+      return GetCountItemsBitPacked(cBitsRequiredMin);
+   }
    INLINE_ALWAYS size_t GetCountSamples() const {
       return m_cSamples;
    }
@@ -7,12 +7,17 @@
 // TODO: use noexcept throughout our codebase (exception extern "C" functions) !  The compiler can optimize functions better if it knows there are no exceptions
 // TODO: review all the C++ library calls, including things like std::abs and verify that none of them throw exceptions, otherwise use the C versions that provide this guarantee
 
+#include <stdlib.h> // free
 #include <stddef.h> // size_t, ptrdiff_t
+#include <stdint.h> // uint8_t, uint16_t, uint32_t
+#include <string.h> // memcpy
 #include <limits> // std::numeric_limits
+#include <atomic>
 
 #include "ebm_native.h"
 #include "EbmInternal.h"
 #include "Logging.h" // EBM_ASSERT & LOG
+#include "ParallelWork.h"
 
 EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION Softmax(
    IntEbmType countTargetClasses,
@@ -139,6 +144,300 @@ EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION Softmax(
 //       transpose_8192 = 6.26907
 //       transpose_16384 = 7.73406
 
+// the number of values that we push through the same search together.  Each step of a search needs the load from
+// the previous step before it can start, but the searches for different values are independent, so interleaving
+// them lets the CPU keep several loads in flight instead of waiting on one value's chain of loads at a time
+constexpr size_t k_cDiscretizeInterleave = 4;
+
+template<size_t cCuts>
+static void DiscretizeLinear(
+   const size_t cSamples,
+   const FloatEbmType * const aValues,
+   const FloatEbmType * const aCuts,
+   IntEbmType * const aDiscretized
+) noexcept {
+   // for a handful of cuts, comparing against every cut is cheaper than any search.  The inner loop fully unrolls
+   // since cCuts is a compile time constant, and the body is then a fixed chain of selects with no branches, which
+   // the compiler vectorizes so that each SIMD register of values is compared against the same cuts
+   static_assert(size_t { 1 } <= cCuts, "we handle zero cuts separately");
+   EBM_ASSERT(size_t { 1 } <= cSamples);
+
+   for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+      const FloatEbmType val = aValues[iSample];
+      IntEbmType result = UNPREDICTABLE(aCuts[0] <= val) ? IntEbmType { 2 } : IntEbmType { 1 };
+      for(size_t iCut = 1; iCut < cCuts; ++iCut) {
+         result = UNPREDICTABLE(aCuts[iCut] <= val) ? static_cast<IntEbmType>(iCut) + IntEbmType { 2 } : result;
+      }
+      result = UNPREDICTABLE(std::isnan(val)) ? IntEbmType { 0 } : result;
+      aDiscretized[iSample] = result;
+   }
+}
+
+template<size_t cPower>
+static void DiscretizePadded(
+   const size_t cSamples,
+   const FloatEbmType * const aValues,
+   const size_t cCuts,
+   const FloatEbmType * const aCuts,
+   IntEbmType * const aDiscretized
+) noexcept {
+   // we pad the cuts out to a power of two so that every value takes exactly log2(cPower) steps, which means the
+   // step loops below fully unroll and the only thing each step does is a compare and a conditional add
+   static_assert(size_t { 2 } <= cPower && size_t { 0 } == (cPower & (cPower - size_t { 1 })), "cPower must be a power of two");
+   EBM_ASSERT(size_t { 1 } <= cSamples);
+   EBM_ASSERT(size_t { 1 } <= cCuts && cCuts <= cPower - size_t { 2 });
+
+   FloatEbmType cutsPadded[cPower - size_t { 1 }];
+   // the only value that should be less than this one is NaN, which always returns false for comparisons
+   // that are not NaN.  If we have a NaN value we expect this to convert us to the 0th bin for missing
+   cutsPadded[0] = -std::numeric_limits<FloatEbmType>::infinity();
+   memcpy(&cutsPadded[1], aCuts, sizeof(*aCuts) * cCuts);
+   for(size_t iFill = cCuts + size_t { 1 }; iFill < cPower - size_t { 1 }; ++iFill) {
+      // NaN will always move us downwards into the region of valid cuts.  The first cut is always
+      // guaranteed to be non-NaN, so if we have a missing (NaN) value, then the search will
+      // go low first and never hit these upper NaN values.
+      cutsPadded[iFill] = std::numeric_limits<FloatEbmType>::quiet_NaN();
+   }
+
+   const FloatEbmType * pValue = aValues;
+   IntEbmType * pDiscretized = aDiscretized;
+
+   const FloatEbmType * const pValueInterleaveEnd = aValues + (cSamples - cSamples % k_cDiscretizeInterleave);
+   while(pValueInterleaveEnd != pValue) {
+      size_t aiResults[k_cDiscretizeInterleave];
+      for(size_t iInterleave = 0; iInterleave < k_cDiscretizeInterleave; ++iInterleave) {
+         aiResults[iInterleave] = size_t { 0 };
+      }
+      for(size_t step = cPower >> 1; size_t { 0 } != step; step >>= 1) {
+         for(size_t iInterleave = 0; iInterleave < k_cDiscretizeInterleave; ++iInterleave) {
+            const size_t iResult = aiResults[iInterleave];
+            aiResults[iInterleave] = iResult + static_cast<size_t>(cutsPadded[iResult + step - size_t { 1 }] <= pValue[iInterleave]) * step;
+         }
+      }
+      for(size_t iInterleave = 0; iInterleave < k_cDiscretizeInterleave; ++iInterleave) {
+         EBM_ASSERT(aiResults[iInterleave] <= cCuts + size_t { 1 });
+         pDiscretized[iInterleave] = static_cast<IntEbmType>(aiResults[iInterleave]);
+      }
+      pDiscretized += k_cDiscretizeInterleave;
+      pValue += k_cDiscretizeInterleave;
+   }
+
+   const FloatEbmType * const pValueEnd = aValues + cSamples;
+   while(pValueEnd != pValue) {
+      const FloatEbmType val = *pValue;
+      size_t iResult = size_t { 0 };
+      for(size_t step = cPower >> 1; size_t { 0 } != step; step >>= 1) {
+         iResult += static_cast<size_t>(cutsPadded[iResult + step - size_t { 1 }] <= val) * step;
+      }
+      EBM_ASSERT(iResult <= cCuts + size_t { 1 });
+      *pDiscretized = static_cast<IntEbmType>(iResult);
+      ++pDiscretized;
+      ++pValue;
+   }
+}
+
+extern void DiscretizeBranchless(
+   const size_t cSamples,
+   const FloatEbmType * const aValues,
+   const size_t cCuts,
+   const FloatEbmType * const aCuts,
+   IntEbmType * const aDiscretized
+) noexcept {
+   // for cut counts too large to pad, or too few samples to make padding worthwhile, we search the original array.
+   // We halve the range on each step whether or not the value is above the midpoint, so the number of steps
+   // depends only on cCuts and the loop branches are perfectly predictable.  The only data dependent operation
+   // is the conditional move of the base.  A classic binary search that exits early is a coin flip for the branch
+   // predictor at every level, which dominates the cost once the cuts no longer fit in the lowest levels of cache.
+   EBM_ASSERT(size_t { 1 } <= cSamples);
+   EBM_ASSERT(size_t { 1 } <= cCuts);
+
+   const FloatEbmType * pValue = aValues;
+   IntEbmType * pDiscretized = aDiscretized;
+
+   const FloatEbmType * const pValueInterleaveEnd = aValues + (cSamples - cSamples % k_cDiscretizeInterleave);
+   while(pValueInterleaveEnd != pValue) {
+      const FloatEbmType * apBase[k_cDiscretizeInterleave];
+      for(size_t iInterleave = 0; iInterleave < k_cDiscretizeInterleave; ++iInterleave) {
+         apBase[iInterleave] = aCuts;
+      }
+      // the number of cuts at or below each value is between (pBase - aCuts) and (pBase - aCuts + cRemaining)
+      size_t cRemaining = cCuts;
+      while(size_t { 1 } != cRemaining) {
+         const size_t cHalf = cRemaining >> 1;
+         for(size_t iInterleave = 0; iInterleave < k_cDiscretizeInterleave; ++iInterleave) {
+            const FloatEbmType * const pBase = apBase[iInterleave];
+            apBase[iInterleave] = pBase + static_cast<size_t>(pBase[cHalf - size_t { 1 }] <= pValue[iInterleave]) * cHalf;
+         }
+         cRemaining -= cHalf;
+      }
+      for(size_t iInterleave = 0; iInterleave < k_cDiscretizeInterleave; ++iInterleave) {
+         const FloatEbmType val = pValue[iInterleave];
+         const FloatEbmType * const pBase = apBase[iInterleave];
+         // +1 for the missing bin at index 0, and another +1 if the last undecided cut is also below us
+         size_t iResult = static_cast<size_t>(pBase - aCuts) + size_t { 1 };
+         iResult = UNPREDICTABLE(*pBase <= val) ? iResult + size_t { 1 } : iResult;
+         EBM_ASSERT(iResult <= cCuts + size_t { 1 });
+         EBM_ASSERT(IsNumberConvertable<IntEbmType>(iResult));
+         // NaN compares false to all our cuts, so it never moves the base and has a result of 1 at this point
+         pDiscretized[iInterleave] = UNPREDICTABLE(std::isnan(val)) ? IntEbmType { 0 } : static_cast<IntEbmType>(iResult);
+      }
+      pDiscretized += k_cDiscretizeInterleave;
+      pValue += k_cDiscretizeInterleave;
+   }
+
+   const FloatEbmType * const pValueEnd = aValues + cSamples;
+   while(pValueEnd != pValue) {
+      const FloatEbmType val = *pValue;
+      const FloatEbmType * pBase = aCuts;
+      size_t cRemaining = cCuts;
+      while(size_t { 1 } != cRemaining) {
+         const size_t cHalf = cRemaining >> 1;
+         pBase += static_cast<size_t>(pBase[cHalf - size_t { 1 }] <= val) * cHalf;
+         cRemaining -= cHalf;
+      }
+      size_t iResult = static_cast<size_t>(pBase - aCuts) + size_t { 1 };
+      iResult = UNPREDICTABLE(*pBase <= val) ? iResult + size_t { 1 } : iResult;
+      EBM_ASSERT(iResult <= cCuts + size_t { 1 });
+      EBM_ASSERT(IsNumberConvertable<IntEbmType>(iResult));
+      *pDiscretized = UNPREDICTABLE(std::isnan(val)) ? IntEbmType { 0 } : static_cast<IntEbmType>(iResult);
+      ++pDiscretized;
+      ++pValue;
+   }
+}
+
+// The kernel thresholds below come from ebm_native_test/benchmark, which times each kernel on its own.  Re-run it before changing them.
+// Up to this many cuts DiscretizeLinear beats any search
+constexpr size_t k_cCutsLinearMax = 6;
+// DiscretizePadded keeps its padded copy of the cuts on the stack, so it stops at 1024 - 2 cuts
+constexpr size_t k_cCutsPaddedMax = 1022;
+// DiscretizePadded needs at least one sample per this many padded cuts to pay for its copy of the cuts.  It was still ahead of
+// DiscretizeBranchless at 8, which is the lowest the benchmark goes
+constexpr size_t k_cPaddedCutsPerSampleMax = 8;
+
+// the power of two that DiscretizePaddedCuts pads cCuts out to.  We need a slot for the -infinity guard at the start and the result
+// can be up to cCuts + 1, so cCuts + 2 must fit.  We never go below 16 since the extra steps for smaller powers are nearly free
+INLINE_ALWAYS static size_t GetPaddedPower(const size_t cCuts) noexcept {
+   EBM_ASSERT(cCuts <= k_cCutsPaddedMax);
+   size_t cPower = 16;
+   while(cPower < cCuts + size_t { 2 }) {
+      cPower <<= 1;
+   }
+   return cPower;
+}
+
+// extern so that our benchmarks can time it against the other kernels
+extern void DiscretizeLinearCuts(
+   const size_t cSamples,
+   const FloatEbmType * const aValues,
+   const size_t cCuts,
+   const FloatEbmType * const aCuts,
+   IntEbmType * const aDiscretized
+) noexcept {
+   static_assert(k_cCutsLinearMax == 6, "DiscretizeLinear is instantiated for 1 to 6 cuts below");
+   EBM_ASSERT(size_t { 1 } <= cCuts && cCuts <= k_cCutsLinearMax);
+   switch(cCuts) {
+   case 1:
+      DiscretizeLinear<1>(cSamples, aValues, aCuts, aDiscretized);
+      return;
+   case 2:
+      DiscretizeLinear<2>(cSamples, aValues, aCuts, aDiscretized);
+      return;
+   case 3:
+      DiscretizeLinear<3>(cSamples, aValues, aCuts, aDiscretized);
+      return;
+   case 4:
+      DiscretizeLinear<4>(cSamples, aValues, aCuts, aDiscretized);
+      return;
+   case 5:
+      DiscretizeLinear<5>(cSamples, aValues, aCuts, aDiscretized);
+      return;
+   default:
+      DiscretizeLinear<6>(cSamples, aValues, aCuts, aDiscretized);
+      return;
+   }
+}
+
+// extern so that our benchmarks can time it against the other kernels for sample counts that DiscretizeFeature wouldn't give it
+extern void DiscretizePaddedCuts(
+   const size_t cSamples,
+   const FloatEbmType * const aValues,
+   const size_t cCuts,
+   const FloatEbmType * const aCuts,
+   IntEbmType * const aDiscretized
+) noexcept {
+   static_assert(k_cCutsPaddedMax == 1024 - 2, "add or remove DiscretizePadded instantiations below");
+   switch(GetPaddedPower(cCuts)) {
+   case 16:
+      DiscretizePadded<16>(cSamples, aValues, cCuts, aCuts, aDiscretized);
+      return;
+   case 32:
+      DiscretizePadded<32>(cSamples, aValues, cCuts, aCuts, aDiscretized);
+      return;
+   case 64:
+      DiscretizePadded<64>(cSamples, aValues, cCuts, aCuts, aDiscretized);
+      return;
+   case 128:
+      DiscretizePadded<128>(cSamples, aValues, cCuts, aCuts, aDiscretized);
+      return;
+   case 256:
+      DiscretizePadded<256>(cSamples, aValues, cCuts, aCuts, aDiscretized);
+      return;
+   case 512:
+      DiscretizePadded<512>(cSamples, aValues, cCuts, aCuts, aDiscretized);
+      return;
+   default:
+      EBM_ASSERT(1024 == GetPaddedPower(cCuts));
+      DiscretizePadded<1024>(cSamples, aValues, cCuts, aCuts, aDiscretized);
+      return;
+   }
+}
+
+static void DiscretizeFeature(
+   const size_t cSamples,
+   const FloatEbmType * const aValues,
+   const size_t cCuts,
+   const FloatEbmType * const aCuts,
+   IntEbmType * const aDiscretized,
+   const size_t cSamplesPadding
+) noexcept {
+   // cSamplesPadding is the number of samples that will be discretized with these cuts, which we use to decide if
+   // padding the cuts is worthwhile.  It can be larger than cSamples if our caller splits a feature into blocks.  We
+   // re-pad for each block in that case, but the copy is still cheap next to searching a full block of samples
+
+   EBM_ASSERT(size_t { 1 } <= cSamples);
+   EBM_ASSERT(nullptr != aValues);
+   EBM_ASSERT(nullptr != aDiscretized);
+
+   if(UNLIKELY(size_t { 0 } == cCuts)) {
+      for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+         aDiscretized[iSample] = UNPREDICTABLE(std::isnan(aValues[iSample])) ? IntEbmType { 0 } : IntEbmType { 1 };
+      }
+      return;
+   }
+
+   EBM_ASSERT(nullptr != aCuts);
+#ifndef NDEBUG
+   for(size_t iDebug = 0; iDebug < cCuts; ++iDebug) {
+      EBM_ASSERT(!std::isnan(aCuts[iDebug]));
+      EBM_ASSERT(!std::isinf(aCuts[iDebug]));
+      // if the values aren't increasing, we won't crash, but we'll return non-sensical bins.  That's a tollerable
+      // failure though given that this check might be expensive if cCuts was large compared to cSamples
+      EBM_ASSERT(size_t { 0 } == iDebug || aCuts[iDebug - 1] < aCuts[iDebug]);
+   }
+#endif // NDEBUG
+
+   if(PREDICTABLE(cCuts <= k_cCutsLinearMax)) {
+      DiscretizeLinearCuts(cSamples, aValues, cCuts, aCuts, aDiscretized);
+      return;
+   }
+   // padding costs us a copy of the cuts, so only do it when there are enough samples to pay for that
+   if(PREDICTABLE(cCuts <= k_cCutsPaddedMax) && GetPaddedPower(cCuts) <= cSamplesPadding * k_cPaddedCutsPerSampleMax) {
+      DiscretizePaddedCuts(cSamples, aValues, cCuts, aCuts, aDiscretized);
+      return;
+   }
+   DiscretizeBranchless(cSamples, aValues, cCuts, aCuts, aDiscretized);
+}
+
 // don't bother using a lock here.  We don't care if an extra log message is written out due to thread parallism
 static int g_cLogEnterDiscretizeParametersMessages = 25;
 static int g_cLogExitDiscretizeParametersMessages = 25;
@@ -222,520 +521,12 @@ EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION Discretiz
          goto exit_with_log;
       }
 
-      const FloatEbmType * pValue = featureValues;
-      const FloatEbmType * const pValueEnd = featureValues + cSamples;
-      IntEbmType * pDiscretized = discretizedOut;
-
-      if(UNLIKELY(countCuts <= IntEbmType { 0 })) {
-         if(UNLIKELY(countCuts < IntEbmType { 0 })) {
-            LOG_0(TraceLevelError, "ERROR Discretize countCuts cannot be negative");
-            ret = IntEbmType { 1 };
-            goto exit_with_log;
-         }
-         EBM_ASSERT(IntEbmType { 0 } == countCuts);
-
-         do {
-            const FloatEbmType val = *pValue;
-            IntEbmType result;
-            result = UNPREDICTABLE(std::isnan(val)) ? IntEbmType { 0 } : IntEbmType { 1 };
-            *pDiscretized = result;
-            ++pDiscretized;
-            ++pValue;
-         } while(LIKELY(pValueEnd != pValue));
-         ret = IntEbmType { 0 };
-         goto exit_with_log;
-      }
-
-      if(UNLIKELY(nullptr == cutsLowerBoundInclusive)) {
-         LOG_0(TraceLevelError, "ERROR Discretize cutsLowerBoundInclusive cannot be null");
+      if(UNLIKELY(countCuts < IntEbmType { 0 })) {
+         LOG_0(TraceLevelError, "ERROR Discretize countCuts cannot be negative");
          ret = IntEbmType { 1 };
          goto exit_with_log;
       }
 
-#ifndef NDEBUG
-      if(IsNumberConvertable<size_t>(countCuts)) {
-         const size_t cCuts = static_cast<size_t>(countCuts);
-         size_t iDebug = 0;
-         while(true) {
-            EBM_ASSERT(!std::isnan(cutsLowerBoundInclusive[iDebug]));
-            EBM_ASSERT(!std::isinf(cutsLowerBoundInclusive[iDebug]));
-
-            size_t iDebugInc = iDebug + 1;
-            if(cCuts <= iDebugInc) {
-               break;
-            }
-            // if the values aren't increasing, we won't crash, but we'll return non-sensical bins.  That's a tollerable
-            // failure though given that this check might be expensive if cCuts was large compared to cSamples
-            EBM_ASSERT(cutsLowerBoundInclusive[iDebug] < cutsLowerBoundInclusive[iDebugInc]);
-            iDebug = iDebugInc;
-         }
-      }
-# endif // NDEBUG
-
-      if(PREDICTABLE(IntEbmType { 1 } == countCuts)) {
-         const FloatEbmType cut0 = cutsLowerBoundInclusive[0];
-         do {
-            const FloatEbmType val = *pValue;
-            IntEbmType result;
-
-            result = UNPREDICTABLE(cut0 <= val) ? IntEbmType { 2 } : IntEbmType { 1 };
-            result = UNPREDICTABLE(std::isnan(val)) ? IntEbmType { 0 } : result;
-
-            *pDiscretized = result;
-            ++pDiscretized;
-            ++pValue;
-         } while(LIKELY(pValueEnd != pValue));
-         ret = IntEbmType { 0 };
-         goto exit_with_log;
-      }
-
-      if(PREDICTABLE(IntEbmType { 2 } == countCuts)) {
-         const FloatEbmType cut0 = cutsLowerBoundInclusive[0];
-         const FloatEbmType cut1 = cutsLowerBoundInclusive[1];
-         do {
-            const FloatEbmType val = *pValue;
-            IntEbmType result;
-
-            result = UNPREDICTABLE(cut0 <= val) ? IntEbmType { 2 } : IntEbmType { 1 };
-            result = UNPREDICTABLE(cut1 <= val) ? IntEbmType { 3 } : result;
-            result = UNPREDICTABLE(std::isnan(val)) ? IntEbmType { 0 } : result;
-
-            *pDiscretized = result;
-            ++pDiscretized;
-            ++pValue;
-         } while(LIKELY(pValueEnd != pValue));
-         ret = IntEbmType { 0 };
-         goto exit_with_log;
-      }
-
-      if(PREDICTABLE(IntEbmType { 3 } == countCuts)) {
-         const FloatEbmType cut0 = cutsLowerBoundInclusive[0];
-         const FloatEbmType cut1 = cutsLowerBoundInclusive[1];
-         const FloatEbmType cut2 = cutsLowerBoundInclusive[2];
-         do {
-            const FloatEbmType val = *pValue;
-            IntEbmType result;
-
-            result = UNPREDICTABLE(cut0 <= val) ? IntEbmType { 2 } : IntEbmType { 1 };
-            result = UNPREDICTABLE(cut1 <= val) ? IntEbmType { 3 } : result;
-            result = UNPREDICTABLE(cut2 <= val) ? IntEbmType { 4 } : result;
-            result = UNPREDICTABLE(std::isnan(val)) ? IntEbmType { 0 } : result;
-
-            *pDiscretized = result;
-            ++pDiscretized;
-            ++pValue;
-         } while(LIKELY(pValueEnd != pValue));
-         ret = IntEbmType { 0 };
-         goto exit_with_log;
-      }
-
-      if(PREDICTABLE(IntEbmType { 4 } == countCuts)) {
-         const FloatEbmType cut0 = cutsLowerBoundInclusive[0];
-         const FloatEbmType cut1 = cutsLowerBoundInclusive[1];
-         const FloatEbmType cut2 = cutsLowerBoundInclusive[2];
-         const FloatEbmType cut3 = cutsLowerBoundInclusive[3];
-         do {
-            const FloatEbmType val = *pValue;
-            IntEbmType result;
-
-            result = UNPREDICTABLE(cut0 <= val) ? IntEbmType { 2 } : IntEbmType { 1 };
-            result = UNPREDICTABLE(cut1 <= val) ? IntEbmType { 3 } : result;
-            result = UNPREDICTABLE(cut2 <= val) ? IntEbmType { 4 } : result;
-            result = UNPREDICTABLE(cut3 <= val) ? IntEbmType { 5 } : result;
-            result = UNPREDICTABLE(std::isnan(val)) ? IntEbmType { 0 } : result;
-
-            *pDiscretized = result;
-            ++pDiscretized;
-            ++pValue;
-         } while(LIKELY(pValueEnd != pValue));
-         ret = IntEbmType { 0 };
-         goto exit_with_log;
-      }
-
-      if(PREDICTABLE(IntEbmType { 5 } == countCuts)) {
-         const FloatEbmType cut0 = cutsLowerBoundInclusive[0];
-         const FloatEbmType cut1 = cutsLowerBoundInclusive[1];
-         const FloatEbmType cut2 = cutsLowerBoundInclusive[2];
-         const FloatEbmType cut3 = cutsLowerBoundInclusive[3];
-         const FloatEbmType cut4 = cutsLowerBoundInclusive[4];
-         do {
-            const FloatEbmType val = *pValue;
-            IntEbmType result;
-
-            result = UNPREDICTABLE(cut0 <= val) ? IntEbmType { 2 } : IntEbmType { 1 };
-            result = UNPREDICTABLE(cut1 <= val) ? IntEbmType { 3 } : result;
-            result = UNPREDICTABLE(cut2 <= val) ? IntEbmType { 4 } : result;
-            result = UNPREDICTABLE(cut3 <= val) ? IntEbmType { 5 } : result;
-            result = UNPREDICTABLE(cut4 <= val) ? IntEbmType { 6 } : result;
-            result = UNPREDICTABLE(std::isnan(val)) ? IntEbmType { 0 } : result;
-
-            *pDiscretized = result;
-            ++pDiscretized;
-            ++pValue;
-         } while(LIKELY(pValueEnd != pValue));
-         ret = IntEbmType { 0 };
-         goto exit_with_log;
-      }
-
-      if(PREDICTABLE(IntEbmType { 6 } == countCuts)) {
-         const FloatEbmType cut0 = cutsLowerBoundInclusive[0];
-         const FloatEbmType cut1 = cutsLowerBoundInclusive[1];
-         const FloatEbmType cut2 = cutsLowerBoundInclusive[2];
-         const FloatEbmType cut3 = cutsLowerBoundInclusive[3];
-         const FloatEbmType cut4 = cutsLowerBoundInclusive[4];
-         const FloatEbmType cut5 = cutsLowerBoundInclusive[5];
-         do {
-            const FloatEbmType val = *pValue;
-            IntEbmType result;
-
-            result = UNPREDICTABLE(cut0 <= val) ? IntEbmType { 2 } : IntEbmType { 1 };
-            result = UNPREDICTABLE(cut1 <= val) ? IntEbmType { 3 } : result;
-            result = UNPREDICTABLE(cut2 <= val) ? IntEbmType { 4 } : result;
-            result = UNPREDICTABLE(cut3 <= val) ? IntEbmType { 5 } : result;
-            result = UNPREDICTABLE(cut4 <= val) ? IntEbmType { 6 } : result;
-            result = UNPREDICTABLE(cut5 <= val) ? IntEbmType { 7 } : result;
-            result = UNPREDICTABLE(std::isnan(val)) ? IntEbmType { 0 } : result;
-
-            *pDiscretized = result;
-            ++pDiscretized;
-            ++pValue;
-         } while(LIKELY(pValueEnd != pValue));
-         ret = IntEbmType { 0 };
-         goto exit_with_log;
-      }
-
-      FloatEbmType cutsLowerBoundInclusiveCopy[1023];
-      // the only value that should be less than this one is NaN, which always returns false for comparisons
-      // that are not NaN.  If we have a NaN value we expect this to convert us to the 0th bin for missing
-      cutsLowerBoundInclusiveCopy[0] = -std::numeric_limits<FloatEbmType>::infinity();
-
-      // it's always legal in C++ to convert a signed value to unsigned.  We check below for out of bounds if needed
-      const size_t cCuts = static_cast<size_t>(countCuts);
-
-      if(PREDICTABLE(countCuts <= IntEbmType { 14 })) {
-         constexpr size_t cPower = 16;
-         if(cPower * 4 <= cSamples) {
-            static_assert(cPower - 1 <= sizeof(cutsLowerBoundInclusiveCopy) /
-               sizeof(cutsLowerBoundInclusiveCopy[0]), "cutsLowerBoundInclusiveCopy buffer not large enough");
-
-            memcpy(
-               size_t { 1 } + cutsLowerBoundInclusiveCopy,
-               cutsLowerBoundInclusive, 
-               sizeof(*cutsLowerBoundInclusive) * cCuts
-            );
-
-            if(LIKELY(cCuts != cPower - size_t { 2 })) {
-               FloatEbmType * pFill = &cutsLowerBoundInclusiveCopy[cCuts + size_t { 1 }];
-               const FloatEbmType * const pEndFill = &cutsLowerBoundInclusiveCopy[cPower - size_t { 1 }];
-               do {
-                  // NaN will always move us downwards into the region of valid cuts.  The first cut is always
-                  // guaranteed to be non-NaN, so if we have a missing (NaN) value, then the binary search will
-                  // go low first and never hit these upper NaN values.
-                  *pFill = std::numeric_limits<FloatEbmType>::quiet_NaN();
-                  ++pFill;
-               } while(LIKELY(pEndFill != pFill));
-            }
-
-            const FloatEbmType firstComparison = cutsLowerBoundInclusiveCopy[cPower / 2 - 1];
-            do {
-               const FloatEbmType val = *pValue;
-               char * pResult = reinterpret_cast<char *>(cutsLowerBoundInclusiveCopy);
-
-               pResult += UNPREDICTABLE(firstComparison <= val) ? size_t { cPower / 2 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult + size_t { 3 } * sizeof(FloatEbmType)) <= val) ? size_t { 4 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult + size_t { 1 } * sizeof(FloatEbmType)) <= val) ? size_t { 2 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult) <= val) ? size_t { 1 } * sizeof(FloatEbmType) : size_t { 0 };
-
-               const size_t result = (pResult - reinterpret_cast<char *>(cutsLowerBoundInclusiveCopy)) / sizeof(FloatEbmType);
-
-               *pDiscretized = static_cast<IntEbmType>(result);
-               ++pDiscretized;
-               ++pValue;
-            } while(LIKELY(pValueEnd != pValue));
-            ret = IntEbmType { 0 };
-            goto exit_with_log;
-         }
-      } else if(PREDICTABLE(countCuts <= IntEbmType { 30 })) {
-         constexpr size_t cPower = 32;
-         if(cPower * 4 <= cSamples) {
-            static_assert(cPower - 1 <= sizeof(cutsLowerBoundInclusiveCopy) /
-               sizeof(cutsLowerBoundInclusiveCopy[0]), "cutsLowerBoundInclusiveCopy buffer not large enough");
-
-            memcpy(
-               size_t { 1 } + cutsLowerBoundInclusiveCopy,
-               cutsLowerBoundInclusive,
-               sizeof(*cutsLowerBoundInclusive) * cCuts
-            );
-
-            if(LIKELY(cCuts != cPower - size_t { 2 })) {
-               FloatEbmType * pFill = &cutsLowerBoundInclusiveCopy[cCuts + size_t { 1 }];
-               const FloatEbmType * const pEndFill = &cutsLowerBoundInclusiveCopy[cPower - size_t { 1 }];
-               do {
-                  // NaN will always move us downwards into the region of valid cuts.  The first cut is always
-                  // guaranteed to be non-NaN, so if we have a missing (NaN) value, then the binary search will
-                  // go low first and never hit these upper NaN values.
-                  *pFill = std::numeric_limits<FloatEbmType>::quiet_NaN();
-                  ++pFill;
-               } while(LIKELY(pEndFill != pFill));
-            }
-
-            const FloatEbmType firstComparison = cutsLowerBoundInclusiveCopy[cPower / 2 - 1];
-            do {
-               const FloatEbmType val = *pValue;
-               char * pResult = reinterpret_cast<char *>(cutsLowerBoundInclusiveCopy);
-
-               pResult += UNPREDICTABLE(firstComparison <= val) ? size_t { cPower / 2 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult + size_t { 7 } * sizeof(FloatEbmType)) <= val) ? size_t { 8 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult + size_t { 3 } * sizeof(FloatEbmType)) <= val) ? size_t { 4 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult + size_t { 1 } * sizeof(FloatEbmType)) <= val) ? size_t { 2 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult) <= val) ? size_t { 1 } * sizeof(FloatEbmType) : size_t { 0 };
-
-               const size_t result = (pResult - reinterpret_cast<char *>(cutsLowerBoundInclusiveCopy)) / sizeof(FloatEbmType);
-
-               *pDiscretized = static_cast<IntEbmType>(result);
-               ++pDiscretized;
-               ++pValue;
-            } while(LIKELY(pValueEnd != pValue));
-            ret = IntEbmType { 0 };
-            goto exit_with_log;
-         }
-      } else if(PREDICTABLE(countCuts <= IntEbmType { 62 })) {
-         constexpr size_t cPower = 64;
-         if(cPower * 4 <= cSamples) {
-            static_assert(cPower - 1 <= sizeof(cutsLowerBoundInclusiveCopy) /
-               sizeof(cutsLowerBoundInclusiveCopy[0]), "cutsLowerBoundInclusiveCopy buffer not large enough");
-
-            memcpy(
-               size_t { 1 } + cutsLowerBoundInclusiveCopy,
-               cutsLowerBoundInclusive,
-               sizeof(*cutsLowerBoundInclusive) * cCuts
-            );
-
-            if(LIKELY(cCuts != cPower - size_t { 2 })) {
-               FloatEbmType * pFill = &cutsLowerBoundInclusiveCopy[cCuts + size_t { 1 }];
-               const FloatEbmType * const pEndFill = &cutsLowerBoundInclusiveCopy[cPower - size_t { 1 }];
-               do {
-                  // NaN will always move us downwards into the region of valid cuts.  The first cut is always
-                  // guaranteed to be non-NaN, so if we have a missing (NaN) value, then the binary search will
-                  // go low first and never hit these upper NaN values.
-                  *pFill = std::numeric_limits<FloatEbmType>::quiet_NaN();
-                  ++pFill;
-               } while(LIKELY(pEndFill != pFill));
-            }
-
-            const FloatEbmType firstComparison = cutsLowerBoundInclusiveCopy[cPower / 2 - 1];
-            do {
-               const FloatEbmType val = *pValue;
-               char * pResult = reinterpret_cast<char *>(cutsLowerBoundInclusiveCopy);
-
-               pResult += UNPREDICTABLE(firstComparison <= val) ? size_t { cPower / 2 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult + size_t { 15 } * sizeof(FloatEbmType)) <= val) ? size_t { 16 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult + size_t { 7 } * sizeof(FloatEbmType)) <= val) ? size_t { 8 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult + size_t { 3 } * sizeof(FloatEbmType)) <= val) ? size_t { 4 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult + size_t { 1 } * sizeof(FloatEbmType)) <= val) ? size_t { 2 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult) <= val) ? size_t { 1 } * sizeof(FloatEbmType) : size_t { 0 };
-
-               const size_t result = (pResult - reinterpret_cast<char *>(cutsLowerBoundInclusiveCopy)) / sizeof(FloatEbmType);
-
-               *pDiscretized = static_cast<IntEbmType>(result);
-               ++pDiscretized;
-               ++pValue;
-            } while(LIKELY(pValueEnd != pValue));
-            ret = IntEbmType { 0 };
-            goto exit_with_log;
-         }
-      } else if(PREDICTABLE(countCuts <= IntEbmType { 126 })) {
-         constexpr size_t cPower = 128;
-         if(cPower * 4 <= cSamples) {
-            static_assert(cPower - 1 <= sizeof(cutsLowerBoundInclusiveCopy) /
-               sizeof(cutsLowerBoundInclusiveCopy[0]), "cutsLowerBoundInclusiveCopy buffer not large enough");
-
-            memcpy(
-               size_t { 1 } + cutsLowerBoundInclusiveCopy,
-               cutsLowerBoundInclusive,
-               sizeof(*cutsLowerBoundInclusive) * cCuts
-            );
-
-            if(LIKELY(cCuts != cPower - size_t { 2 })) {
-               FloatEbmType * pFill = &cutsLowerBoundInclusiveCopy[cCuts + size_t { 1 }];
-               const FloatEbmType * const pEndFill = &cutsLowerBoundInclusiveCopy[cPower - size_t { 1 }];
-               do {
-                  // NaN will always move us downwards into the region of valid cuts.  The first cut is always
-                  // guaranteed to be non-NaN, so if we have a missing (NaN) value, then the binary search will
-                  // go low first and never hit these upper NaN values.
-                  *pFill = std::numeric_limits<FloatEbmType>::quiet_NaN();
-                  ++pFill;
-               } while(LIKELY(pEndFill != pFill));
-            }
-
-            const FloatEbmType firstComparison = cutsLowerBoundInclusiveCopy[cPower / 2 - 1];
-            do {
-               const FloatEbmType val = *pValue;
-               char * pResult = reinterpret_cast<char *>(cutsLowerBoundInclusiveCopy);
-
-               pResult += UNPREDICTABLE(firstComparison <= val) ? size_t { cPower / 2 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult + size_t { 31 } * sizeof(FloatEbmType)) <= val) ? size_t { 32 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult + size_t { 15 } * sizeof(FloatEbmType)) <= val) ? size_t { 16 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult + size_t { 7 } * sizeof(FloatEbmType)) <= val) ? size_t { 8 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult + size_t { 3 } * sizeof(FloatEbmType)) <= val) ? size_t { 4 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult + size_t { 1 } * sizeof(FloatEbmType)) <= val) ? size_t { 2 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult) <= val) ? size_t { 1 } * sizeof(FloatEbmType) : size_t { 0 };
-
-               const size_t result = (pResult - reinterpret_cast<char *>(cutsLowerBoundInclusiveCopy)) / sizeof(FloatEbmType);
-
-               *pDiscretized = static_cast<IntEbmType>(result);
-               ++pDiscretized;
-               ++pValue;
-            } while(LIKELY(pValueEnd != pValue));
-            ret = IntEbmType { 0 };
-            goto exit_with_log;
-         }
-      } else if(PREDICTABLE(countCuts <= IntEbmType { 254 })) {
-         constexpr size_t cPower = 256;
-         if(cPower * 4 <= cSamples) {
-            static_assert(cPower - 1 <= sizeof(cutsLowerBoundInclusiveCopy) /
-               sizeof(cutsLowerBoundInclusiveCopy[0]), "cutsLowerBoundInclusiveCopy buffer not large enough");
-
-            memcpy(
-               size_t { 1 } + cutsLowerBoundInclusiveCopy,
-               cutsLowerBoundInclusive,
-               sizeof(*cutsLowerBoundInclusive) * cCuts
-            );
-
-            if(LIKELY(cCuts != cPower - size_t { 2 })) {
-               FloatEbmType * pFill = &cutsLowerBoundInclusiveCopy[cCuts + size_t { 1 }];
-               const FloatEbmType * const pEndFill = &cutsLowerBoundInclusiveCopy[cPower - size_t { 1 }];
-               do {
-                  // NaN will always move us downwards into the region of valid cuts.  The first cut is always
-                  // guaranteed to be non-NaN, so if we have a missing (NaN) value, then the binary search will
-                  // go low first and never hit these upper NaN values.
-                  *pFill = std::numeric_limits<FloatEbmType>::quiet_NaN();
-                  ++pFill;
-               } while(LIKELY(pEndFill != pFill));
-            }
-
-            const FloatEbmType firstComparison = cutsLowerBoundInclusiveCopy[cPower / 2 - 1];
-            do {
-               const FloatEbmType val = *pValue;
-               char * pResult = reinterpret_cast<char *>(cutsLowerBoundInclusiveCopy);
-
-               pResult += UNPREDICTABLE(firstComparison <= val) ? size_t { cPower / 2 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult + size_t { 63 } * sizeof(FloatEbmType)) <= val) ? size_t { 64 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult + size_t { 31 } * sizeof(FloatEbmType)) <= val) ? size_t { 32 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult + size_t { 15 } * sizeof(FloatEbmType)) <= val) ? size_t { 16 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult + size_t { 7 } * sizeof(FloatEbmType)) <= val) ? size_t { 8 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult + size_t { 3 } * sizeof(FloatEbmType)) <= val) ? size_t { 4 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult + size_t { 1 } * sizeof(FloatEbmType)) <= val) ? size_t { 2 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult) <= val) ? size_t { 1 } * sizeof(FloatEbmType) : size_t { 0 };
-
-               const size_t result = (pResult - reinterpret_cast<char *>(cutsLowerBoundInclusiveCopy)) / sizeof(FloatEbmType);
-
-               *pDiscretized = static_cast<IntEbmType>(result);
-               ++pDiscretized;
-               ++pValue;
-            } while(LIKELY(pValueEnd != pValue));
-            ret = IntEbmType { 0 };
-            goto exit_with_log;
-         }
-      } else if(PREDICTABLE(countCuts <= IntEbmType { 510 })) {
-         constexpr size_t cPower = 512;
-         if(cPower * 4 <= cSamples) {
-            static_assert(cPower - 1 <= sizeof(cutsLowerBoundInclusiveCopy) /
-               sizeof(cutsLowerBoundInclusiveCopy[0]), "cutsLowerBoundInclusiveCopy buffer not large enough");
-
-            memcpy(
-               size_t { 1 } + cutsLowerBoundInclusiveCopy,
-               cutsLowerBoundInclusive,
-               sizeof(*cutsLowerBoundInclusive) * cCuts
-            );
-
-            if(LIKELY(cCuts != cPower - size_t { 2 })) {
-               FloatEbmType * pFill = &cutsLowerBoundInclusiveCopy[cCuts + size_t { 1 }];
-               const FloatEbmType * const pEndFill = &cutsLowerBoundInclusiveCopy[cPower - size_t { 1 }];
-               do {
-                  // NaN will always move us downwards into the region of valid cuts.  The first cut is always
-                  // guaranteed to be non-NaN, so if we have a missing (NaN) value, then the binary search will
-                  // go low first and never hit these upper NaN values.
-                  *pFill = std::numeric_limits<FloatEbmType>::quiet_NaN();
-                  ++pFill;
-               } while(LIKELY(pEndFill != pFill));
-            }
-
-            const FloatEbmType firstComparison = cutsLowerBoundInclusiveCopy[cPower / 2 - 1];
-            do {
-               const FloatEbmType val = *pValue;
-               char * pResult = reinterpret_cast<char *>(cutsLowerBoundInclusiveCopy);
-
-               pResult += UNPREDICTABLE(firstComparison <= val) ? size_t { cPower / 2 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult + size_t { 127 } * sizeof(FloatEbmType)) <= val) ? size_t { 128 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult + size_t { 63 } * sizeof(FloatEbmType)) <= val) ? size_t { 64 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult + size_t { 31 } * sizeof(FloatEbmType)) <= val) ? size_t { 32 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult + size_t { 15 } * sizeof(FloatEbmType)) <= val) ? size_t { 16 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult + size_t { 7 } * sizeof(FloatEbmType)) <= val) ? size_t { 8 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult + size_t { 3 } * sizeof(FloatEbmType)) <= val) ? size_t { 4 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult + size_t { 1 } * sizeof(FloatEbmType)) <= val) ? size_t { 2 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult) <= val) ? size_t { 1 } * sizeof(FloatEbmType) : size_t { 0 };
-
-               const size_t result = (pResult - reinterpret_cast<char *>(cutsLowerBoundInclusiveCopy)) / sizeof(FloatEbmType);
-
-               *pDiscretized = static_cast<IntEbmType>(result);
-               ++pDiscretized;
-               ++pValue;
-            } while(LIKELY(pValueEnd != pValue));
-            ret = IntEbmType { 0 };
-            goto exit_with_log;
-         }
-      } else if(PREDICTABLE(countCuts <= IntEbmType { 1022 })) {
-         constexpr size_t cPower = 1024;
-         if(cPower * 4 <= cSamples) {
-            static_assert(cPower - 1 == sizeof(cutsLowerBoundInclusiveCopy) /
-               sizeof(cutsLowerBoundInclusiveCopy[0]), "cutsLowerBoundInclusiveCopy buffer not large enough");
-
-            memcpy(
-               size_t { 1 } + cutsLowerBoundInclusiveCopy,
-               cutsLowerBoundInclusive,
-               sizeof(*cutsLowerBoundInclusive) * cCuts
-            );
-
-            if(LIKELY(cCuts != cPower - size_t { 2 })) {
-               FloatEbmType * pFill = &cutsLowerBoundInclusiveCopy[cCuts + size_t { 1 }];
-               const FloatEbmType * const pEndFill = &cutsLowerBoundInclusiveCopy[cPower - size_t { 1 }];
-               do {
-                  // NaN will always move us downwards into the region of valid cuts.  The first cut is always
-                  // guaranteed to be non-NaN, so if we have a missing (NaN) value, then the binary search will
-                  // go low first and never hit these upper NaN values.
-                  *pFill = std::numeric_limits<FloatEbmType>::quiet_NaN();
-                  ++pFill;
-               } while(LIKELY(pEndFill != pFill));
-            }
-
-            const FloatEbmType firstComparison = cutsLowerBoundInclusiveCopy[cPower / 2 - 1];
-            do {
-               const FloatEbmType val = *pValue;
-               char * pResult = reinterpret_cast<char *>(cutsLowerBoundInclusiveCopy);
-
-               pResult += UNPREDICTABLE(firstComparison <= val) ? size_t { cPower / 2 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult + size_t { 255 } * sizeof(FloatEbmType)) <= val) ? size_t { 256 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult + size_t { 127 } * sizeof(FloatEbmType)) <= val) ? size_t { 128 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult + size_t { 63 } * sizeof(FloatEbmType)) <= val) ? size_t { 64 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult + size_t { 31 } * sizeof(FloatEbmType)) <= val) ? size_t { 32 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult + size_t { 15 } * sizeof(FloatEbmType)) <= val) ? size_t { 16 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult + size_t { 7 } * sizeof(FloatEbmType)) <= val) ? size_t { 8 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult + size_t { 3 } * sizeof(FloatEbmType)) <= val) ? size_t { 4 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult + size_t { 1 } * sizeof(FloatEbmType)) <= val) ? size_t { 2 } * sizeof(FloatEbmType) : size_t { 0 };
-               pResult += UNPREDICTABLE(*reinterpret_cast<FloatEbmType *>(pResult) <= val) ? size_t { 1 } * sizeof(FloatEbmType) : size_t { 0 };
-
-               const size_t result = (pResult - reinterpret_cast<char *>(cutsLowerBoundInclusiveCopy)) / sizeof(FloatEbmType);
-
-               *pDiscretized = static_cast<IntEbmType>(result);
-               ++pDiscretized;
-               ++pValue;
-            } while(LIKELY(pValueEnd != pValue));
-            ret = IntEbmType { 0 };
-            goto exit_with_log;
-         }
-      }
-
       if(UNLIKELY(std::numeric_limits<IntEbmType>::max() == countCuts)) {
          // we convert back to IntEbmType when we return, and if countCuts is at the limit, then we don't
          // have any value to indicate missing
@@ -752,6 +543,8 @@ EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION Discretiz
          goto exit_with_log;
       }
 
+      const size_t cCuts = static_cast<size_t>(countCuts);
+
       if(IsMultiplyError(sizeof(*cutsLowerBoundInclusive), cCuts)) {
          LOG_0(TraceLevelError,
             "ERROR Discretize countCuts was too large to fit into cutsLowerBoundInclusive");
@@ -767,86 +560,13 @@ EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION Discretiz
          goto exit_with_log;
       }
 
-      if(UNLIKELY(size_t { std::numeric_limits<ptrdiff_t>::max() } < cCuts)) {
-         // the low value can increase until it's equal to cCuts, so cCuts must be expressable as a ptrdiff_t
-         LOG_0(TraceLevelError,
-            "ERROR Discretize countCuts was too large to allow for the binary search comparison");
-         ret = IntEbmType { 1 };
-         goto exit_with_log;
-      }
-
-      if(UNLIKELY(std::numeric_limits<size_t>::max() / size_t { 2 } + size_t { 1 } < cCuts)) {
-         // our first operation towards getting the mid-point is to add the size_t low and size_t high, and that can't 
-         // overflow, so check that the maximum high added to the maximum low (which is the high) don't exceed that value
-         LOG_0(TraceLevelError,
-            "ERROR Discretize countCuts was too large to allow for the binary search add");
+      if(UNLIKELY(size_t { 0 } != cCuts && nullptr == cutsLowerBoundInclusive)) {
+         LOG_0(TraceLevelError, "ERROR Discretize cutsLowerBoundInclusive cannot be null");
          ret = IntEbmType { 1 };
          goto exit_with_log;
       }
 
-      EBM_ASSERT(cCuts < std::numeric_limits<size_t>::max());
-      EBM_ASSERT(size_t { 1 } <= cCuts);
-      EBM_ASSERT(cCuts - size_t { 1 } <= size_t { std::numeric_limits<ptrdiff_t>::max() });
-      const ptrdiff_t highStart = static_cast<ptrdiff_t>(cCuts - size_t { 1 });
-
-      // if we're going to runroll our first loop, then we need to ensure that there's a next loop after the first
-      // unrolled loop, otherwise we would need to check if we were done before the first real loop iteration.
-      // To ensure we have 2 original loop iterations, we need 1 cut in the center, 1 cut above, and 1 cut below, so 3
-      EBM_ASSERT(size_t { 3 } <= cCuts);
-      const size_t firstMiddle = static_cast<size_t>(highStart) >> 1;
-      EBM_ASSERT(firstMiddle < cCuts);
-      const FloatEbmType firstMidVal = cutsLowerBoundInclusive[firstMiddle];
-      const ptrdiff_t firstMidLow = static_cast<ptrdiff_t>(firstMiddle) + ptrdiff_t { 1 };
-      const ptrdiff_t firstMidHigh = static_cast<ptrdiff_t>(firstMiddle) - ptrdiff_t { 1 };
-
-      do {
-         const FloatEbmType val = *pValue;
-         size_t middle = size_t { 0 };
-         if(PREDICTABLE(!std::isnan(val))) {
-            ptrdiff_t high = UNPREDICTABLE(firstMidVal <= val) ? highStart : firstMidHigh;
-            ptrdiff_t low = UNPREDICTABLE(firstMidVal <= val) ? firstMidLow : ptrdiff_t { 0 };
-            FloatEbmType midVal;
-            do {
-               EBM_ASSERT(ptrdiff_t { 0 } <= low && static_cast<size_t>(low) < cCuts);
-               EBM_ASSERT(ptrdiff_t { 0 } <= high && static_cast<size_t>(high) < cCuts);
-               EBM_ASSERT(low <= high);
-               // low is equal or lower than high, so summing them can't exceed 2 * high, and after division it
-               // can't be higher than high, so middle can't overflow ptrdiff_t after the division since high
-               // is already a ptrdiff_t.  Generally the maximum positive value of a ptrdiff_t can be doubled 
-               // when converted to a size_t, although that isn't guaranteed.  A more correct statement is that
-               // the following must be false (which we check above):
-               // "std::numeric_limits<size_t>::max() / 2 < cCuts - 1"
-               EBM_ASSERT(!IsAddError(static_cast<size_t>(low), static_cast<size_t>(high)));
-               middle = (static_cast<size_t>(low) + static_cast<size_t>(high)) >> 1;
-               EBM_ASSERT(middle <= static_cast<size_t>(high));
-               EBM_ASSERT(middle < cCuts);
-               midVal = cutsLowerBoundInclusive[middle];
-               EBM_ASSERT(middle < size_t { std::numeric_limits<ptrdiff_t>::max() });
-               low = UNPREDICTABLE(midVal <= val) ? static_cast<ptrdiff_t>(middle) + ptrdiff_t { 1 } : low;
-               EBM_ASSERT(ptrdiff_t { 0 } <= low && static_cast<size_t>(low) <= cCuts);
-               high = UNPREDICTABLE(midVal <= val) ? high : static_cast<ptrdiff_t>(middle) - ptrdiff_t { 1 };
-               EBM_ASSERT(ptrdiff_t { -1 } <= high && high <= highStart);
-
-               // high can become -1 in some cases, so it needs to be ptrdiff_t.  It's tempting to try and change
-               // this code and use the Hermann Bottenbruch version that checks for low != high in the loop comparison
-               // since then we wouldn't have negative values and we could use size_t, but unfortunately that version
-               // has a check at the end where we'd need to fetch cutsLowerBoundInclusive[low] after exiting the 
-               // loop, so this version we have here is faster given that we only need to compare to a value that
-               // we've already fetched from memory.  Also, this version makes slightly faster progress since
-               // it does middle + 1 AND middle - 1 instead of just middle - 1, so it often eliminates one loop
-               // iteration.  In practice this version will always work since no floating point type is less than 4
-               // bytes, so we shouldn't have difficulty expressing any indexes with ptrdiff_t, and our indexes
-               // for accessing memory are always size_t, so those should always work.
-            } while(LIKELY(low <= high));
-            EBM_ASSERT(size_t { 0 } <= middle && middle < cCuts);
-            middle = UNPREDICTABLE(midVal <= val) ? middle + size_t { 2 } : middle + size_t { 1 };
-            EBM_ASSERT(size_t { 1 } <= middle && middle <= size_t { 1 } + cCuts);
-         }
-         EBM_ASSERT(IsNumberConvertable<IntEbmType>(middle));
-         *pDiscretized = static_cast<IntEbmType>(middle);
-         ++pDiscretized;
-         ++pValue;
-      } while(LIKELY(pValueEnd != pValue));
+      DiscretizeFeature(cSamples, featureValues, cCuts, cutsLowerBoundInclusive, discretizedOut, cSamples);
       ret = IntEbmType { 0 };
    }
 
@@ -865,3 +585,295 @@ exit_with_log:;
    return ret;
 }
 
+// DiscretizeMatrix splits the matrix into stripes of k_cDiscretizeStripeFeatures features and blocks of
+// k_cDiscretizeBlockSamples samples.  Each (stripe, block) pair is an independent unit of work.  For C ordered data
+// we transpose the block into per-feature buffers first, since reading a full row of the stripe at a time is much
+// faster than striding down each column (see the transpose timings in the Plan above).  A block of 64 features by
+// 512 samples is 256KB of doubles, which fits into L2 along with the cuts for the feature we're working on.
+constexpr size_t k_cDiscretizeStripeFeatures = 64;
+constexpr size_t k_cDiscretizeBlockSamples = 512;
+
+template<typename TBinIndex>
+static void CopyBinIndexes(const size_t cSamples, const IntEbmType * const aFrom, TBinIndex * const aTo) noexcept {
+   for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+      EBM_ASSERT(IntEbmType { 0 } <= aFrom[iSample]);
+      EBM_ASSERT(static_cast<UIntEbmType>(aFrom[iSample]) <= UIntEbmType { std::numeric_limits<TBinIndex>::max() });
+      aTo[iSample] = static_cast<TBinIndex>(aFrom[iSample]);
+   }
+}
+
+struct DiscretizeMatrixWork final {
+   size_t m_cSamples;
+   size_t m_cFeatures;
+   const FloatEbmType * m_aFeatureValues;
+   bool m_bColumnMajor;
+   const size_t * m_acCuts;
+   const FloatEbmType * const * m_apCuts;
+   size_t m_cBytesPerBinIndex;
+   void * m_aDiscretized;
+   size_t m_cBlocks;
+   size_t m_cUnits;
+   std::atomic<size_t> m_iUnitNext;
+};
+
+static void DiscretizeMatrixWorker(void * const pWorkVoid, const size_t iWorker) {
+   UNUSED(iWorker);
+   DiscretizeMatrixWork * const pWork = static_cast<DiscretizeMatrixWork *>(pWorkVoid);
+
+   const size_t cSamples = pWork->m_cSamples;
+   const size_t cFeatures = pWork->m_cFeatures;
+   const bool bColumnMajor = pWork->m_bColumnMajor;
+   const size_t cBytesPerBinIndex = pWork->m_cBytesPerBinIndex;
+
+   // If we can't get our buffers we leave the units for the other workers and our caller checks that every unit was taken
+   FloatEbmType * aTransposed = nullptr;
+   if(!bColumnMajor) {
+      aTransposed = EbmMalloc<FloatEbmType>(k_cDiscretizeStripeFeatures * k_cDiscretizeBlockSamples);
+      if(nullptr == aTransposed) {
+         LOG_0(TraceLevelWarning, "WARNING DiscretizeMatrixWorker nullptr == aTransposed");
+         return;
+      }
+   }
+   IntEbmType * aBinIndexes = nullptr;
+   if(sizeof(IntEbmType) != cBytesPerBinIndex) {
+      aBinIndexes = EbmMalloc<IntEbmType>(k_cDiscretizeBlockSamples);
+      if(nullptr == aBinIndexes) {
+         LOG_0(TraceLevelWarning, "WARNING DiscretizeMatrixWorker nullptr == aBinIndexes");
+         free(aTransposed);
+         return;
+      }
+   }
+
+   while(true) {
+      const size_t iUnit = pWork->m_iUnitNext.fetch_add(size_t { 1 }, std::memory_order_relaxed);
+      if(pWork->m_cUnits <= iUnit) {
+         break;
+      }
+      // consecutive units share a stripe, so workers that run at the same time tend to use the same cuts
+      const size_t iStripe = iUnit / pWork->m_cBlocks;
+      const size_t iBlock = iUnit % pWork->m_cBlocks;
+
+      const size_t iFeatureStart = iStripe * k_cDiscretizeStripeFeatures;
+      const size_t cStripeFeatures = k_cDiscretizeStripeFeatures < cFeatures - iFeatureStart ?
+         k_cDiscretizeStripeFeatures : cFeatures - iFeatureStart;
+      const size_t iSampleStart = iBlock * k_cDiscretizeBlockSamples;
+      const size_t cBlockSamples = k_cDiscretizeBlockSamples < cSamples - iSampleStart ?
+         k_cDiscretizeBlockSamples : cSamples - iSampleStart;
+
+      if(!bColumnMajor) {
+         const FloatEbmType * pRow = pWork->m_aFeatureValues + iSampleStart * cFeatures + iFeatureStart;
+         for(size_t iSample = 0; iSample < cBlockSamples; ++iSample) {
+            FloatEbmType * pTo = aTransposed + iSample;
+            for(size_t iStripeFeature = 0; iStripeFeature < cStripeFeatures; ++iStripeFeature) {
+               *pTo = pRow[iStripeFeature];
+               pTo += k_cDiscretizeBlockSamples;
+            }
+            pRow += cFeatures;
+         }
+      }
+
+      for(size_t iStripeFeature = 0; iStripeFeature < cStripeFeatures; ++iStripeFeature) {
+         const size_t iFeature = iFeatureStart + iStripeFeature;
+         const FloatEbmType * const aValues = bColumnMajor ?
+            pWork->m_aFeatureValues + iFeature * cSamples + iSampleStart :
+            aTransposed + iStripeFeature * k_cDiscretizeBlockSamples;
+         const size_t iOut = iFeature * cSamples + iSampleStart;
+
+         IntEbmType * const aOut = nullptr == aBinIndexes ?
+            static_cast<IntEbmType *>(pWork->m_aDiscretized) + iOut : aBinIndexes;
+         DiscretizeFeature(cBlockSamples, aValues, pWork->m_acCuts[iFeature], pWork->m_apCuts[iFeature], aOut, cSamples);
+
+         if(1 == cBytesPerBinIndex) {
+            CopyBinIndexes(cBlockSamples, aBinIndexes, static_cast<uint8_t *>(pWork->m_aDiscretized) + iOut);
+         } else if(2 == cBytesPerBinIndex) {
+            CopyBinIndexes(cBlockSamples, aBinIndexes, static_cast<uint16_t *>(pWork->m_aDiscretized) + iOut);
+         } else if(4 == cBytesPerBinIndex) {
+            CopyBinIndexes(cBlockSamples, aBinIndexes, static_cast<uint32_t *>(pWork->m_aDiscretized) + iOut);
+         }
+      }
+   }
+
+   free(aBinIndexes);
+   free(aTransposed);
+}
+
+// don't bother using a lock here.  We don't care if an extra log message is written out due to thread parallism
+static int g_cLogEnterDiscretizeMatrixParametersMessages = 25;
+static int g_cLogExitDiscretizeMatrixParametersMessages = 25;
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION DiscretizeMatrix(
+   IntEbmType countSamples,
+   IntEbmType countFeatures,
+   const FloatEbmType * featureValues,
+   BoolEbmType isColumnMajor,
+   const IntEbmType * countCutsPerFeature,
+   const FloatEbmType * cutsLowerBoundInclusive,
+   IntEbmType countBytesPerBinIndex,
+   void * discretizedOut
+) {
+   // discretizedOut is always feature major (countFeatures columns of countSamples bin indexes each) regardless of
+   // the order of featureValues, since that's the layout we use for boosting.  cutsLowerBoundInclusive holds the cuts
+   // of each feature back to back.  The bin indexes are unsigned if countBytesPerBinIndex is 1, 2, or 4 and
+   // IntEbmType if it is 8, and the largest bin index (countCuts + 1) of each feature must fit
+
+   LOG_COUNTED_N(
+      &g_cLogEnterDiscretizeMatrixParametersMessages,
+      TraceLevelInfo,
+      TraceLevelVerbose,
+      "Entered DiscretizeMatrix: "
+      "countSamples=%" IntEbmTypePrintf ", "
+      "countFeatures=%" IntEbmTypePrintf ", "
+      "featureValues=%p, "
+      "isColumnMajor=%s, "
+      "countCutsPerFeature=%p, "
+      "cutsLowerBoundInclusive=%p, "
+      "countBytesPerBinIndex=%" IntEbmTypePrintf ", "
+      "discretizedOut=%p"
+      ,
+      countSamples,
+      countFeatures,
+      static_cast<const void *>(featureValues),
+      ObtainTruth(isColumnMajor),
+      static_cast<const void *>(countCutsPerFeature),
+      static_cast<const void *>(cutsLowerBoundInclusive),
+      countBytesPerBinIndex,
+      discretizedOut
+   );
+
+   if(countSamples < IntEbmType { 0 }) {
+      LOG_0(TraceLevelError, "ERROR DiscretizeMatrix countSamples cannot be negative");
+      return IntEbmType { 1 };
+   }
+   if(countFeatures < IntEbmType { 0 }) {
+      LOG_0(TraceLevelError, "ERROR DiscretizeMatrix countFeatures cannot be negative");
+      return IntEbmType { 1 };
+   }
+   if(IntEbmType { 1 } != countBytesPerBinIndex && IntEbmType { 2 } != countBytesPerBinIndex &&
+      IntEbmType { 4 } != countBytesPerBinIndex && IntEbmType { 8 } != countBytesPerBinIndex) 
+   {
+      LOG_0(TraceLevelError, "ERROR DiscretizeMatrix countBytesPerBinIndex must be 1, 2, 4, or 8");
+      return IntEbmType { 1 };
+   }
+   static_assert(sizeof(IntEbmType) == 8, "we expect 8 byte bin indexes to be IntEbmType");
+   if(IntEbmType { 0 } == countSamples || IntEbmType { 0 } == countFeatures) {
+      return IntEbmType { 0 };
+   }
+   if(!IsNumberConvertable<size_t>(countSamples) || !IsNumberConvertable<size_t>(countFeatures)) {
+      LOG_0(TraceLevelWarning, "WARNING DiscretizeMatrix countSamples or countFeatures is too large to fit into memory");
+      return IntEbmType { 1 };
+   }
+   const size_t cSamples = static_cast<size_t>(countSamples);
+   const size_t cFeatures = static_cast<size_t>(countFeatures);
+   const size_t cBytesPerBinIndex = static_cast<size_t>(countBytesPerBinIndex);
+
+   if(IsMultiplyError(cSamples, cFeatures) || IsMultiplyError(cSamples * cFeatures, sizeof(*featureValues))) {
+      LOG_0(TraceLevelWarning, "WARNING DiscretizeMatrix countSamples * countFeatures is too large");
+      return IntEbmType { 1 };
+   }
+   if(nullptr == featureValues) {
+      LOG_0(TraceLevelError, "ERROR DiscretizeMatrix featureValues cannot be nullptr");
+      return IntEbmType { 1 };
+   }
+   if(nullptr == countCutsPerFeature) {
+      LOG_0(TraceLevelError, "ERROR DiscretizeMatrix countCutsPerFeature cannot be nullptr");
+      return IntEbmType { 1 };
+   }
+   if(nullptr == discretizedOut) {
+      LOG_0(TraceLevelError, "ERROR DiscretizeMatrix discretizedOut cannot be nullptr");
+      return IntEbmType { 1 };
+   }
+   if(EBM_FALSE != isColumnMajor && EBM_TRUE != isColumnMajor) {
+      LOG_0(TraceLevelWarning, "WARNING DiscretizeMatrix isColumnMajor should either be EBM_TRUE or EBM_FALSE");
+   }
+
+   // the largest bin index is cCuts + 1, so this is the most cuts a feature can have for the requested index width
+   const UIntEbmType cCutsMax = sizeof(IntEbmType) == cBytesPerBinIndex ?
+      static_cast<UIntEbmType>(std::numeric_limits<IntEbmType>::max()) - UIntEbmType { 1 } :
+      (UIntEbmType { 1 } << (cBytesPerBinIndex * 8)) - UIntEbmType { 2 };
+
+   size_t * const acCuts = EbmMalloc<size_t>(cFeatures);
+   if(nullptr == acCuts) {
+      LOG_0(TraceLevelWarning, "WARNING DiscretizeMatrix nullptr == acCuts");
+      return IntEbmType { 1 };
+   }
+   const FloatEbmType ** const apCuts = EbmMalloc<const FloatEbmType *>(cFeatures);
+   if(nullptr == apCuts) {
+      LOG_0(TraceLevelWarning, "WARNING DiscretizeMatrix nullptr == apCuts");
+      free(acCuts);
+      return IntEbmType { 1 };
+   }
+
+   IntEbmType ret = IntEbmType { 0 };
+   size_t cCutsTotal = 0;
+   for(size_t iFeature = 0; iFeature < cFeatures; ++iFeature) {
+      const IntEbmType countCuts = countCutsPerFeature[iFeature];
+      if(countCuts < IntEbmType { 0 }) {
+         LOG_0(TraceLevelError, "ERROR DiscretizeMatrix countCutsPerFeature cannot contain negative values");
+         ret = IntEbmType { 1 };
+         break;
+      }
+      if(cCutsMax < static_cast<UIntEbmType>(countCuts) || !IsNumberConvertable<size_t>(countCuts)) {
+         LOG_0(TraceLevelError, "ERROR DiscretizeMatrix a feature has too many cuts for its bin indexes to fit into countBytesPerBinIndex");
+         ret = IntEbmType { 1 };
+         break;
+      }
+      const size_t cCuts = static_cast<size_t>(countCuts);
+      acCuts[iFeature] = cCuts;
+      apCuts[iFeature] = cutsLowerBoundInclusive + cCutsTotal;
+      if(IsAddError(cCutsTotal, cCuts) || IsMultiplyError(cCutsTotal + cCuts, sizeof(*cutsLowerBoundInclusive))) {
+         LOG_0(TraceLevelError, "ERROR DiscretizeMatrix countCutsPerFeature sums to more cuts than can fit into memory");
+         ret = IntEbmType { 1 };
+         break;
+      }
+      cCutsTotal += cCuts;
+   }
+   if(IntEbmType { 0 } == ret && size_t { 0 } != cCutsTotal && nullptr == cutsLowerBoundInclusive) {
+      LOG_0(TraceLevelError, "ERROR DiscretizeMatrix cutsLowerBoundInclusive cannot be nullptr");
+      ret = IntEbmType { 1 };
+   }
+
+   if(IntEbmType { 0 } == ret) {
+      const size_t cStripes = (cFeatures - size_t { 1 }) / k_cDiscretizeStripeFeatures + size_t { 1 };
+      const size_t cBlocks = (cSamples - size_t { 1 }) / k_cDiscretizeBlockSamples + size_t { 1 };
+      // cStripes * cBlocks can't overflow since it's no larger than cSamples * cFeatures, which we checked above
+      const size_t cUnits = cStripes * cBlocks;
+
+      const size_t cWorkersMax = GetCountWorkersMax();
+      const size_t cWorkers = cUnits < cWorkersMax ? cUnits : cWorkersMax;
+
+      DiscretizeMatrixWork work;
+      work.m_cSamples = cSamples;
+      work.m_cFeatures = cFeatures;
+      work.m_aFeatureValues = featureValues;
+      work.m_bColumnMajor = EBM_FALSE != isColumnMajor;
+      work.m_acCuts = acCuts;
+      work.m_apCuts = apCuts;
+      work.m_cBytesPerBinIndex = cBytesPerBinIndex;
+      work.m_aDiscretized = discretizedOut;
+      work.m_cBlocks = cBlocks;
+      work.m_cUnits = cUnits;
+      work.m_iUnitNext.store(size_t { 0 }, std::memory_order_relaxed);
+
+      ExecuteParallelWork(cWorkers, &DiscretizeMatrixWorker, &work);
+
+      if(work.m_iUnitNext.load(std::memory_order_relaxed) < cUnits) {
+         LOG_0(TraceLevelWarning, "WARNING DiscretizeMatrix no worker could allocate its scratch memory");
+         ret = IntEbmType { 1 };
+      }
+   }
+
+   free(apCuts);
+   free(acCuts);
+
+   LOG_COUNTED_N(
+      &g_cLogExitDiscretizeMatrixParametersMessages,
+      TraceLevelInfo,
+      TraceLevelVerbose,
+      "Exited DiscretizeMatrix: "
+      "return=%" IntEbmTypePrintf
+      ,
+      ret
+   );
+
+   return ret;
+}
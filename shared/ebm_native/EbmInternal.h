@@ -413,11 +413,24 @@ static_assert(k_cCompilerOptimizedCountDimensionsMax <= k_cDimensionsMax,
 
 constexpr size_t k_dynamicDimensions = 0;
 
+// below this many samples std::sort beats our radix sort for feature values since the radix sort has to touch 256 buckets per pass.  From
+// ebm_native_test/benchmark, the crossover is around 128-192 samples for continuous values and 32-64 for heavily duplicated ones, and at 256
+// samples the radix sort is already 1.4x-2.8x faster.  Its lead peaks around 64K samples at 4x and shrinks once its scatter passes no longer
+// fit in the cache, but at 16M samples it is still 1.6x faster for continuous values and 3x for duplicated ones
+constexpr size_t k_cSamplesRadixSortMin = 256;
+// below this many samples std::nth_element beats our radix select for feature values.  The SelectFeatureValue benchmark in
+// ebm_native_test/benchmark puts the crossover between 128 and 256 samples for uniform, heavy-tailed and duplicated values, and by 1024
+// samples the radix select is already 1.6x-2.3x faster
+constexpr size_t k_cSamplesRadixSelectMin = 256;
+
 constexpr size_t k_cBitsForStorageType = CountBitsRequiredPositiveMax<StorageDataType>();
 
 constexpr INLINE_ALWAYS size_t GetCountBits(const size_t cItemsBitPacked) {
    return k_cBitsForStorageType / cItemsBitPacked;
 }
+constexpr INLINE_ALWAYS size_t GetCountItemsBitPacked(const size_t cBits) {
+   return k_cBitsForStorageType / cBits;
+}
 constexpr size_t k_cItemsPerBitPackedDataUnitDynamic = 0;
 constexpr size_t k_cItemsPerBitPackedDataUnitMax = 0; // if there are more than 16 (4 bits), then we should just use a loop since the code will be pretty big
 constexpr size_t k_cItemsPerBitPackedDataUnitMin = 0; // our default binning leads us to 256 values, which is 8 units per 64-bit data pack
@@ -22,6 +22,7 @@
 #include "ThreadStateBoosting.h"
 
 #include "TensorTotalsSum.h"
+#include "ParallelWork.h"
 
 template<ptrdiff_t compilerLearningTypeOrCountTargetClasses>
 static FloatEbmType SweepMultiDiemensional(
@@ -170,8 +171,197 @@ static FloatEbmType SweepMultiDiemensional(
    return bestSplit;
 }
 
+// each worker owns k_cAuxillaryBucketsPerPairWorker auxillary buckets.  Indexes [0, 4) hold the LowLow, LowHigh, HighLow, HighHigh totals of the 
+// worker's best cut, and indexes [4, 8) and [8, 12) are the best+temp zones that SweepMultiDiemensional uses for the low and high side sweeps
+constexpr size_t k_cAuxillaryBucketsPerPairWorker = 12;
+
+// Each worker should have at least this many sweep cells to process.  A sweep cell is one pair of TensorTotalsSum calls inside 
+// SweepMultiDiemensional.  ebm_native_test/benchmark/BoostingPairs.cpp measured 17-19 us to start and join a thread and 34-44 ns per 
+// sweep cell, so at this size a thread launch is about 5% of the worker's sweep
+constexpr size_t k_cSweepCellsPerPairWorkerMin = 8192;
+
+struct PairCutCandidate final {
+   FloatEbmType m_bestSplittingScore;
+   size_t m_iCutBest;
+   size_t m_cutLowBest;
+   size_t m_cutHighBest;
+   bool m_bNaN;
+};
+
+template<bool bClassification>
+struct PairCutSearch final {
+   const HistogramBucket<bClassification> * m_aHistogramBuckets;
+   const FeatureGroup * m_pFeatureGroup;
+   HistogramBucket<bClassification> * m_pAuxiliaryBucketZone;
+   size_t m_cBytesPerHistogramBucket;
+   size_t m_cVectorLength;
+   size_t m_cBinsDimension1;
+   size_t m_cBinsDimension2;
+   size_t m_cSamplesRequiredForChildSplitMin;
+   ptrdiff_t m_runtimeLearningTypeOrCountTargetClasses;
+   size_t m_cWorkers;
+   PairCutCandidate m_aCandidates[k_cWorkersMax];
+#ifndef NDEBUG
+   const HistogramBucket<bClassification> * m_aHistogramBucketsDebugCopy;
+   const unsigned char * m_aHistogramBucketsEndDebug;
+#endif // NDEBUG
+};
+
 template<ptrdiff_t compilerLearningTypeOrCountTargetClasses>
 class FindBestBoostingSplitPairsInternal final {
+
+   // We visit the cuts in the same order as the original serial algorithm: first the (cBinsDimension1 - 1) cuts along dimension 1 with 
+   // each side swept along dimension 2, then the (cBinsDimension2 - 1) cuts along dimension 2 with each side swept along dimension 1.
+   // Each worker takes a contiguous range of these cuts and keeps the best one using the same comparisons as the serial code, so 
+   // reducing the workers in order afterwards picks exactly the cut that a single thread would have picked.
+   static void SearchCuts(void * const pSearchVoid, const size_t iWorker) {
+      constexpr bool bClassification = IsClassification(compilerLearningTypeOrCountTargetClasses);
+
+      // don't LOG this!  It runs on every worker for every pair that we boost on, which would create way too much chatter
+
+      PairCutSearch<bClassification> * const pSearch = static_cast<PairCutSearch<bClassification> *>(pSearchVoid);
+
+      const size_t cBytesPerHistogramBucket = pSearch->m_cBytesPerHistogramBucket;
+      const size_t cVectorLength = pSearch->m_cVectorLength;
+      const size_t cBinsDimension1 = pSearch->m_cBinsDimension1;
+      const size_t cBinsDimension2 = pSearch->m_cBinsDimension2;
+      const size_t cWorkers = pSearch->m_cWorkers;
+
+      const size_t cCutsDimension1 = cBinsDimension1 - 1;
+      const size_t cCuts = cCutsDimension1 + cBinsDimension2 - 1;
+      EBM_ASSERT(iWorker < cWorkers);
+      EBM_ASSERT(cWorkers <= cCuts);
+      const size_t iCutStart = cCuts * iWorker / cWorkers;
+      const size_t iCutEnd = cCuts * (iWorker + 1) / cWorkers;
+
+      HistogramBucket<bClassification> * const pWorkerZone = GetHistogramBucketByIndex<bClassification>(
+         cBytesPerHistogramBucket, 
+         pSearch->m_pAuxiliaryBucketZone, 
+         k_cAuxillaryBucketsPerPairWorker * iWorker
+      );
+      HistogramBucket<bClassification> * const pTotalsLowLowBest =
+         GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pWorkerZone, 0);
+      HistogramBucket<bClassification> * const pTotalsLowHighBest =
+         GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pWorkerZone, 1);
+      HistogramBucket<bClassification> * const pTotalsHighLowBest =
+         GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pWorkerZone, 2);
+      HistogramBucket<bClassification> * const pTotalsHighHighBest =
+         GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pWorkerZone, 3);
+
+      HistogramBucket<bClassification> * const pTotalsLowSweep =
+         GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pWorkerZone, 4);
+      HistogramBucket<bClassification> * const pTotalsHighSweep =
+         GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pWorkerZone, 8);
+
+      FloatEbmType bestSplittingScore = k_illegalGain;
+      size_t iCutBest = 0;
+      size_t cutLowBest = 0;
+      size_t cutHighBest = 0;
+      bool bNaN = false;
+
+      size_t aiStart[k_cDimensionsMax];
+
+      for(size_t iCut = iCutStart; iCut < iCutEnd; ++iCut) {
+         unsigned int iDimensionSweep;
+         size_t cSweepBins;
+         size_t directionVectorHigh;
+         if(iCut < cCutsDimension1) {
+            aiStart[0] = iCut;
+            iDimensionSweep = 1;
+            cSweepBins = cBinsDimension2;
+            directionVectorHigh = 0x1;
+         } else {
+            aiStart[1] = iCut - cCutsDimension1;
+            iDimensionSweep = 0;
+            cSweepBins = cBinsDimension1;
+            directionVectorHigh = 0x2;
+         }
+
+         size_t cutLow;
+         const FloatEbmType splittingScoreNew1 = SweepMultiDiemensional<compilerLearningTypeOrCountTargetClasses>(
+            pSearch->m_aHistogramBuckets,
+            pSearch->m_pFeatureGroup,
+            aiStart,
+            0x0,
+            iDimensionSweep,
+            cSweepBins,
+            pSearch->m_cSamplesRequiredForChildSplitMin,
+            pSearch->m_runtimeLearningTypeOrCountTargetClasses,
+            pTotalsLowSweep,
+            &cutLow
+#ifndef NDEBUG
+            , pSearch->m_aHistogramBucketsDebugCopy
+            , pSearch->m_aHistogramBucketsEndDebug
+#endif // NDEBUG
+         );
+
+         // if we get a NaN result, we'd like to propagate it by making bestSplit NaN.  The rules for NaN values say that non equality comparisons are 
+         // all false so, let's flip this comparison such that it should be true for NaN values.  If the compiler violates NaN comparions rules, no big deal.  
+         // NaN values will get us soon and shut down boosting.
+         if(LIKELY(/* DO NOT CHANGE THIS WITHOUT READING THE ABOVE. WE DO THIS STRANGE COMPARISON FOR NaN values*/ !(k_illegalGain == splittingScoreNew1))) {
+            EBM_ASSERT(std::isnan(splittingScoreNew1) || FloatEbmType { 0 } <= splittingScoreNew1);
+
+            size_t cutHigh;
+            const FloatEbmType splittingScoreNew2 = SweepMultiDiemensional<compilerLearningTypeOrCountTargetClasses>(
+               pSearch->m_aHistogramBuckets,
+               pSearch->m_pFeatureGroup,
+               aiStart,
+               directionVectorHigh,
+               iDimensionSweep,
+               cSweepBins,
+               pSearch->m_cSamplesRequiredForChildSplitMin,
+               pSearch->m_runtimeLearningTypeOrCountTargetClasses,
+               pTotalsHighSweep,
+               &cutHigh
+#ifndef NDEBUG
+               , pSearch->m_aHistogramBucketsDebugCopy
+               , pSearch->m_aHistogramBucketsEndDebug
+#endif // NDEBUG
+            );
+            // if we get a NaN result, we'd like to propagate it by making bestSplit NaN.  The rules for NaN values say that non equality comparisons are 
+            // all false so, let's flip this comparison such that it should be true for NaN values.  If the compiler violates NaN comparions rules, 
+            // no big deal.  NaN values will get us soon and shut down boosting.
+            if(LIKELY(/* DO NOT CHANGE THIS WITHOUT READING THE ABOVE. WE DO THIS STRANGE COMPARISON FOR NaN values*/
+               !(k_illegalGain == splittingScoreNew2))) {
+               EBM_ASSERT(std::isnan(splittingScoreNew2) || FloatEbmType { 0 } <= splittingScoreNew2);
+               const FloatEbmType splittingScore = splittingScoreNew1 + splittingScoreNew2;
+
+               // if we get a NaN result, we'd like to propagate it by making bestSplit NaN.  The rules for NaN values say that non equality comparisons 
+               // are all false so, let's flip this comparison such that it should be true for NaN values.  If the compiler violates NaN comparions rules, 
+               // no big deal.  NaN values will get us soon and shut down boosting.
+               if(UNLIKELY(/* DO NOT CHANGE THIS WITHOUT READING THE ABOVE. WE DO THIS STRANGE COMPARISON FOR NaN values*/
+                  !(splittingScore <= bestSplittingScore))) {
+                  bestSplittingScore = splittingScore;
+                  iCutBest = iCut;
+                  cutLowBest = cutLow;
+                  cutHighBest = cutHigh;
+                  bNaN = bNaN || std::isnan(splittingScore);
+
+                  pTotalsLowLowBest->Copy(*pTotalsLowSweep, cVectorLength);
+                  pTotalsLowHighBest->Copy(*GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pTotalsLowSweep, 1), cVectorLength);
+                  pTotalsHighLowBest->Copy(*pTotalsHighSweep, cVectorLength);
+                  pTotalsHighHighBest->Copy(*GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pTotalsHighSweep, 1), cVectorLength);
+               } else {
+                  EBM_ASSERT(!std::isnan(splittingScore));
+               }
+            } else {
+               EBM_ASSERT(!std::isnan(splittingScoreNew2));
+               EBM_ASSERT(k_illegalGain == splittingScoreNew2);
+            }
+         } else {
+            EBM_ASSERT(!std::isnan(splittingScoreNew1));
+            EBM_ASSERT(k_illegalGain == splittingScoreNew1);
+         }
+      }
+
+      PairCutCandidate * const pCandidate = &pSearch->m_aCandidates[iWorker];
+      pCandidate->m_bestSplittingScore = bestSplittingScore;
+      pCandidate->m_iCutBest = iCutBest;
+      pCandidate->m_cutLowBest = cutLowBest;
+      pCandidate->m_cutHighBest = cutHighBest;
+      pCandidate->m_bNaN = bNaN;
+   }
+
 public:
 
    FindBestBoostingSplitPairsInternal() = delete; // this is a static class.  Do not construct
@@ -183,6 +373,7 @@ public:
       ThreadStateBoosting * const pThreadStateBoosting,
       const FeatureGroup * const pFeatureGroup,
       const size_t cSamplesRequiredForChildSplitMin,
+      const size_t cWorkers,
       HistogramBucketBase * pAuxiliaryBucketZoneBase,
       HistogramBucketBase * const pTotalBase,
       FloatEbmType * const pTotalGain
@@ -216,10 +407,6 @@ public:
       const HistogramBucket<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const aHistogramBucketsDebugCopy = aHistogramBucketsDebugCopyBase->GetHistogramBucket<bClassification>();
 #endif // NDEBUG
 
-      size_t aiStart[k_cDimensionsMax];
-
-      FloatEbmType splittingScore;
-
       EBM_ASSERT(2 == pFeatureGroup->GetCountSignificantFeatures());
       size_t cBinsDimension1 = 0;
       size_t cBinsDimension2 = 0;
@@ -241,21 +428,6 @@ public:
       EBM_ASSERT(2 <= cBinsDimension1);
       EBM_ASSERT(2 <= cBinsDimension2);
 
-      FloatEbmType bestSplittingScore = k_illegalGain;
-
-      size_t cutFirst1Best;
-      size_t cutFirst1LowBest;
-      size_t cutFirst1HighBest;
-
-      HistogramBucket<bClassification> * pTotals1LowLowBest =
-         GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pAuxiliaryBucketZone, 0);
-      HistogramBucket<bClassification> * pTotals1LowHighBest =
-         GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pAuxiliaryBucketZone, 1);
-      HistogramBucket<bClassification> * pTotals1HighLowBest =
-         GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pAuxiliaryBucketZone, 2);
-      HistogramBucket<bClassification> * pTotals1HighHighBest =
-         GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pAuxiliaryBucketZone, 3);
-
       ASSERT_BINNED_BUCKET_OK(cBytesPerHistogramBucket, pTotal, pThreadStateBoosting->GetHistogramBucketsEndDebug());
 
       EBM_ASSERT(0 < cSamplesRequiredForChildSplitMin);
@@ -280,208 +452,71 @@ public:
       }
       EBM_ASSERT(std::isnan(splittingScoreParent) || FloatEbmType { 0 } <= splittingScoreParent); // sumation of positive numbers should be positive
 
-      LOG_0(TraceLevelVerbose, "BoostMultiDimensional Starting FIRST bin sweep loop");
-      size_t iBin1 = 0;
-      do {
-         aiStart[0] = iBin1;
-
-         splittingScore = FloatEbmType { 0 };
-
-         size_t cutSecond1LowBest;
-         HistogramBucket<bClassification> * pTotals2LowLowBest =
-            GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pAuxiliaryBucketZone, 4);
-         HistogramBucket<bClassification> * pTotals2LowHighBest =
-            GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pAuxiliaryBucketZone, 5);
-         const FloatEbmType splittingScoreNew1 = SweepMultiDiemensional<compilerLearningTypeOrCountTargetClasses>(
-            aHistogramBuckets,
-            pFeatureGroup,
-            aiStart,
-            0x0,
-            1,
-            cBinsDimension2,
-            cSamplesRequiredForChildSplitMin,
-            runtimeLearningTypeOrCountTargetClasses,
-            pTotals2LowLowBest,
-            &cutSecond1LowBest
+      EBM_ASSERT(1 <= cWorkers);
+      EBM_ASSERT(cWorkers <= k_cWorkersMax);
+
+      PairCutSearch<bClassification> search;
+      search.m_aHistogramBuckets = aHistogramBuckets;
+      search.m_pFeatureGroup = pFeatureGroup;
+      search.m_pAuxiliaryBucketZone = pAuxiliaryBucketZone;
+      search.m_cBytesPerHistogramBucket = cBytesPerHistogramBucket;
+      search.m_cVectorLength = cVectorLength;
+      search.m_cBinsDimension1 = cBinsDimension1;
+      search.m_cBinsDimension2 = cBinsDimension2;
+      search.m_cSamplesRequiredForChildSplitMin = cSamplesRequiredForChildSplitMin;
+      search.m_runtimeLearningTypeOrCountTargetClasses = runtimeLearningTypeOrCountTargetClasses;
+      search.m_cWorkers = cWorkers;
 #ifndef NDEBUG
-            , aHistogramBucketsDebugCopy
-            , pThreadStateBoosting->GetHistogramBucketsEndDebug()
+      search.m_aHistogramBucketsDebugCopy = aHistogramBucketsDebugCopy;
+      search.m_aHistogramBucketsEndDebug = pThreadStateBoosting->GetHistogramBucketsEndDebug();
 #endif // NDEBUG
-            );
 
-         // if we get a NaN result, we'd like to propagate it by making bestSplit NaN.  The rules for NaN values say that non equality comparisons are all
-         // false so, let's flip this comparison such that it should be true for NaN values.  If the compiler violates NaN comparions rules, no big deal.  
-         // NaN values will get us soon and shut down boosting.
-         if(LIKELY(/* DO NOT CHANGE THIS WITHOUT READING THE ABOVE. WE DO THIS STRANGE COMPARISON FOR NaN values*/ !(k_illegalGain == splittingScoreNew1))) {
-            EBM_ASSERT(std::isnan(splittingScoreNew1) || FloatEbmType { 0 } <= splittingScoreNew1);
-            splittingScore += splittingScoreNew1;
-
-            size_t cutSecond1HighBest;
-            HistogramBucket<bClassification> * pTotals2HighLowBest =
-               GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pAuxiliaryBucketZone, 8);
-            HistogramBucket<bClassification> * pTotals2HighHighBest =
-               GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pAuxiliaryBucketZone, 9);
-            const FloatEbmType splittingScoreNew2 = SweepMultiDiemensional<compilerLearningTypeOrCountTargetClasses>(
-               aHistogramBuckets,
-               pFeatureGroup,
-               aiStart,
-               0x1,
-               1,
-               cBinsDimension2,
-               cSamplesRequiredForChildSplitMin,
-               runtimeLearningTypeOrCountTargetClasses,
-               pTotals2HighLowBest,
-               &cutSecond1HighBest
-#ifndef NDEBUG
-               , aHistogramBucketsDebugCopy
-               , pThreadStateBoosting->GetHistogramBucketsEndDebug()
-#endif // NDEBUG
-               );
-            // if we get a NaN result, we'd like to propagate it by making bestSplit NaN.  The rules for NaN values say that non equality comparisons are 
-            // all false so, let's flip this comparison such that it should be true for NaN values.  If the compiler violates NaN comparions rules, 
-            // no big deal.  NaN values will get us soon and shut down boosting.
-            if(LIKELY(/* DO NOT CHANGE THIS WITHOUT READING THE ABOVE. WE DO THIS STRANGE COMPARISON FOR NaN values*/
-               !(k_illegalGain == splittingScoreNew2))) {
-               EBM_ASSERT(std::isnan(splittingScoreNew2) || FloatEbmType { 0 } <= splittingScoreNew2);
-               splittingScore += splittingScoreNew2;
+      LOG_N(TraceLevelVerbose, "BoostMultiDimensional Starting bin sweeps with %zu workers", cWorkers);
+      ExecuteParallelWork(cWorkers, &SearchCuts, &search);
+      LOG_0(TraceLevelVerbose, "BoostMultiDimensional Done bin sweeps");
 
-               // if we get a NaN result, we'd like to propagate it by making bestSplit NaN.  The rules for NaN values say that non equality comparisons 
-               // are all false so, let's flip this comparison such that it should be true for NaN values.  If the compiler violates NaN comparions rules, 
-               // no big deal.  NaN values will get us soon and shut down boosting.
-               if(UNLIKELY(/* DO NOT CHANGE THIS WITHOUT READING THE ABOVE. WE DO THIS STRANGE COMPARISON FOR NaN values*/
-                  !(splittingScore <= bestSplittingScore))) {
-                  bestSplittingScore = splittingScore;
-                  cutFirst1Best = iBin1;
-                  cutFirst1LowBest = cutSecond1LowBest;
-                  cutFirst1HighBest = cutSecond1HighBest;
-
-                  pTotals1LowLowBest->Copy(*pTotals2LowLowBest, cVectorLength);
-                  pTotals1LowHighBest->Copy(*pTotals2LowHighBest, cVectorLength);
-                  pTotals1HighLowBest->Copy(*pTotals2HighLowBest, cVectorLength);
-                  pTotals1HighHighBest->Copy(*pTotals2HighHighBest, cVectorLength);
-               } else {
-                  EBM_ASSERT(!std::isnan(splittingScore));
-               }
-            } else {
-               EBM_ASSERT(!std::isnan(splittingScoreNew2));
-               EBM_ASSERT(k_illegalGain == splittingScoreNew2);
+      // Reduce the per-worker candidates in cut order.  Without NaN values the serial comparison chain is a max that keeps the first of 
+      // any tied cuts, so comparing each worker's best against the running best with the same strict comparison picks the same cut.  
+      // A NaN score replaces whatever came before it in the serial chain, so if a worker saw a NaN then the serial result after its range 
+      // doesn't depend on the earlier workers and its candidate is exactly what the serial code would have had at that point.
+      FloatEbmType bestSplittingScore = k_illegalGain;
+      size_t iWorkerBest = 0;
+      for(size_t iWorker = 0; iWorker < cWorkers; ++iWorker) {
+         const PairCutCandidate * const pCandidate = &search.m_aCandidates[iWorker];
+         if(UNLIKELY(pCandidate->m_bNaN)) {
+            bestSplittingScore = pCandidate->m_bestSplittingScore;
+            iWorkerBest = iWorker;
+         } else if(k_illegalGain != pCandidate->m_bestSplittingScore) {
+            // DO NOT CHANGE THIS WITHOUT READING THE NaN comments above.  It must match the comparison in SearchCuts
+            if(!(pCandidate->m_bestSplittingScore <= bestSplittingScore)) {
+               bestSplittingScore = pCandidate->m_bestSplittingScore;
+               iWorkerBest = iWorker;
             }
-         } else {
-            EBM_ASSERT(!std::isnan(splittingScoreNew1));
-            EBM_ASSERT(k_illegalGain == splittingScoreNew1);
          }
-         ++iBin1;
-      } while(iBin1 < cBinsDimension1 - 1);
-
-      bool bCutFirst2 = false;
-
-      size_t cutFirst2Best;
-      size_t cutFirst2LowBest;
-      size_t cutFirst2HighBest;
-
-      HistogramBucket<bClassification> * pTotals2LowLowBest =
-         GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pAuxiliaryBucketZone, 12);
-      HistogramBucket<bClassification> * pTotals2LowHighBest =
-         GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pAuxiliaryBucketZone, 13);
-      HistogramBucket<bClassification> * pTotals2HighLowBest =
-         GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pAuxiliaryBucketZone, 14);
-      HistogramBucket<bClassification> * pTotals2HighHighBest =
-         GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pAuxiliaryBucketZone, 15);
-
-      LOG_0(TraceLevelVerbose, "BoostMultiDimensional Starting SECOND bin sweep loop");
-      size_t iBin2 = 0;
-      do {
-         aiStart[1] = iBin2;
-
-         splittingScore = FloatEbmType { 0 };
-
-         size_t cutSecond2LowBest;
-         HistogramBucket<bClassification> * pTotals1LowLowBestInner =
-            GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pAuxiliaryBucketZone, 16);
-         HistogramBucket<bClassification> * pTotals1LowHighBestInner =
-            GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pAuxiliaryBucketZone, 17);
-         const FloatEbmType splittingScoreNew1 = SweepMultiDiemensional<compilerLearningTypeOrCountTargetClasses>(
-            aHistogramBuckets,
-            pFeatureGroup,
-            aiStart,
-            0x0,
-            0,
-            cBinsDimension1,
-            cSamplesRequiredForChildSplitMin,
-            runtimeLearningTypeOrCountTargetClasses,
-            pTotals1LowLowBestInner,
-            &cutSecond2LowBest
-#ifndef NDEBUG
-            , aHistogramBucketsDebugCopy
-            , pThreadStateBoosting->GetHistogramBucketsEndDebug()
-#endif // NDEBUG
-            );
+      }
 
-         // if we get a NaN result, we'd like to propagate it by making bestSplit NaN.  The rules for NaN values say that non equality comparisons are 
-         // all false so, let's flip this comparison such that it should be true for NaN values.  If the compiler violates NaN comparions rules, no big deal.
-         // NaN values will get us soon and shut down boosting.
-         if(LIKELY(/* DO NOT CHANGE THIS WITHOUT READING THE ABOVE. WE DO THIS STRANGE COMPARISON FOR NaN values*/ !(k_illegalGain == splittingScoreNew1))) {
-            EBM_ASSERT(std::isnan(splittingScoreNew1) || FloatEbmType { 0 } <= splittingScoreNew1);
-            splittingScore += splittingScoreNew1;
+      const PairCutCandidate * const pCandidateBest = &search.m_aCandidates[iWorkerBest];
+      HistogramBucket<bClassification> * const pWorkerZoneBest = GetHistogramBucketByIndex<bClassification>(
+         cBytesPerHistogramBucket,
+         pAuxiliaryBucketZone,
+         k_cAuxillaryBucketsPerPairWorker * iWorkerBest
+      );
 
-            size_t cutSecond2HighBest;
-            HistogramBucket<bClassification> * pTotals1HighLowBestInner =
-               GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pAuxiliaryBucketZone, 20);
-            HistogramBucket<bClassification> * pTotals1HighHighBestInner =
-               GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pAuxiliaryBucketZone, 21);
-            const FloatEbmType splittingScoreNew2 = SweepMultiDiemensional<compilerLearningTypeOrCountTargetClasses>(
-               aHistogramBuckets,
-               pFeatureGroup,
-               aiStart,
-               0x2,
-               0,
-               cBinsDimension1,
-               cSamplesRequiredForChildSplitMin,
-               runtimeLearningTypeOrCountTargetClasses,
-               pTotals1HighLowBestInner,
-               &cutSecond2HighBest
-#ifndef NDEBUG
-               , aHistogramBucketsDebugCopy
-               , pThreadStateBoosting->GetHistogramBucketsEndDebug()
-#endif // NDEBUG
-               );
-            // if we get a NaN result, we'd like to propagate it by making bestSplit NaN.  The rules for NaN values say that non equality comparisons are 
-            // all false so, let's flip this comparison such that it should be true for NaN values.  If the compiler violates NaN comparions rules, 
-            // no big deal.  NaN values will get us soon and shut down boosting.
-            if(LIKELY(/* DO NOT CHANGE THIS WITHOUT READING THE ABOVE. WE DO THIS STRANGE COMPARISON FOR NaN values*/
-               !(k_illegalGain == splittingScoreNew2))) {
-               EBM_ASSERT(std::isnan(splittingScoreNew2) || FloatEbmType { 0 } <= splittingScoreNew2);
-               splittingScore += splittingScoreNew2;
-               // if we get a NaN result, we'd like to propagate it by making bestSplit NaN.  The rules for NaN values say that non equality comparisons 
-               // are all false so, let's flip this comparison such that it should be true for NaN values.  If the compiler violates NaN comparions rules, 
-               // no big deal.  NaN values will get us soon and shut down boosting.
-               if(UNLIKELY(/* DO NOT CHANGE THIS WITHOUT READING THE ABOVE. WE DO THIS STRANGE COMPARISON FOR NaN values*/
-                  !(splittingScore <= bestSplittingScore))) {
-                  bestSplittingScore = splittingScore;
-                  cutFirst2Best = iBin2;
-                  cutFirst2LowBest = cutSecond2LowBest;
-                  cutFirst2HighBest = cutSecond2HighBest;
+      // cuts from the second sweep loop come after all the cuts from the first in our ordering
+      const bool bCutFirst2 = cBinsDimension1 - 1 <= pCandidateBest->m_iCutBest;
 
-                  pTotals2LowLowBest->Copy(*pTotals1LowLowBestInner, cVectorLength);
-                  pTotals2LowHighBest->Copy(*pTotals1LowHighBestInner, cVectorLength);
-                  pTotals2HighLowBest->Copy(*pTotals1HighLowBestInner, cVectorLength);
-                  pTotals2HighHighBest->Copy(*pTotals1HighHighBestInner, cVectorLength);
+      const size_t cutFirstBest = bCutFirst2 ? pCandidateBest->m_iCutBest - (cBinsDimension1 - 1) : pCandidateBest->m_iCutBest;
+      const size_t cutSecondLowBest = pCandidateBest->m_cutLowBest;
+      const size_t cutSecondHighBest = pCandidateBest->m_cutHighBest;
 
-                  bCutFirst2 = true;
-               } else {
-                  EBM_ASSERT(!std::isnan(splittingScore));
-               }
-            } else {
-               EBM_ASSERT(!std::isnan(splittingScoreNew2));
-               EBM_ASSERT(k_illegalGain == splittingScoreNew2);
-            }
-         } else {
-            EBM_ASSERT(!std::isnan(splittingScoreNew1));
-            EBM_ASSERT(k_illegalGain == splittingScoreNew1);
-         }
-         ++iBin2;
-      } while(iBin2 < cBinsDimension2 - 1);
-      LOG_0(TraceLevelVerbose, "BoostMultiDimensional Done sweep loops");
+      HistogramBucket<bClassification> * const pTotalsLowLowBest =
+         GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pWorkerZoneBest, 0);
+      HistogramBucket<bClassification> * const pTotalsLowHighBest =
+         GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pWorkerZoneBest, 1);
+      HistogramBucket<bClassification> * const pTotalsHighLowBest =
+         GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pWorkerZoneBest, 2);
+      HistogramBucket<bClassification> * const pTotalsHighHighBest =
+         GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pWorkerZoneBest, 3);
 
       FloatEbmType gain;
       // if we get a NaN result for bestSplittingScore, we might as well do less work and just create a zero split update right now.  The rules 
@@ -533,9 +568,9 @@ public:
                LOG_0(TraceLevelWarning, "WARNING BoostMultiDimensional pSmallChangeToModelOverwriteSingleSamplingSet->SetCountDivisions(1, 1)");
                return true;
             }
-            pSmallChangeToModelOverwriteSingleSamplingSet->GetDivisionPointer(1)[0] = cutFirst2Best;
+            pSmallChangeToModelOverwriteSingleSamplingSet->GetDivisionPointer(1)[0] = cutFirstBest;
 
-            if(cutFirst2LowBest < cutFirst2HighBest) {
+            if(cutSecondLowBest < cutSecondHighBest) {
                if(pSmallChangeToModelOverwriteSingleSamplingSet->EnsureValueCapacity(cVectorLength * 6)) {
                   LOG_0(
                      TraceLevelWarning,
@@ -547,9 +582,9 @@ public:
                   LOG_0(TraceLevelWarning, "WARNING BoostMultiDimensional pSmallChangeToModelOverwriteSingleSamplingSet->SetCountDivisions(0, 2)");
                   return true;
                }
-               pSmallChangeToModelOverwriteSingleSamplingSet->GetDivisionPointer(0)[0] = cutFirst2LowBest;
-               pSmallChangeToModelOverwriteSingleSamplingSet->GetDivisionPointer(0)[1] = cutFirst2HighBest;
-            } else if(cutFirst2HighBest < cutFirst2LowBest) {
+               pSmallChangeToModelOverwriteSingleSamplingSet->GetDivisionPointer(0)[0] = cutSecondLowBest;
+               pSmallChangeToModelOverwriteSingleSamplingSet->GetDivisionPointer(0)[1] = cutSecondHighBest;
+            } else if(cutSecondHighBest < cutSecondLowBest) {
                if(pSmallChangeToModelOverwriteSingleSamplingSet->EnsureValueCapacity(cVectorLength * 6)) {
                   LOG_0(
                      TraceLevelWarning,
@@ -561,8 +596,8 @@ public:
                   LOG_0(TraceLevelWarning, "WARNING BoostMultiDimensional pSmallChangeToModelOverwriteSingleSamplingSet->SetCountDivisions(0, 2)");
                   return true;
                }
-               pSmallChangeToModelOverwriteSingleSamplingSet->GetDivisionPointer(0)[0] = cutFirst2HighBest;
-               pSmallChangeToModelOverwriteSingleSamplingSet->GetDivisionPointer(0)[1] = cutFirst2LowBest;
+               pSmallChangeToModelOverwriteSingleSamplingSet->GetDivisionPointer(0)[0] = cutSecondHighBest;
+               pSmallChangeToModelOverwriteSingleSamplingSet->GetDivisionPointer(0)[1] = cutSecondLowBest;
             } else {
                if(pSmallChangeToModelOverwriteSingleSamplingSet->SetCountDivisions(0, 1)) {
                   LOG_0(TraceLevelWarning, "WARNING BoostMultiDimensional pSmallChangeToModelOverwriteSingleSamplingSet->SetCountDivisions(0, 1)");
@@ -576,17 +611,17 @@ public:
                   );
                   return true;
                }
-               pSmallChangeToModelOverwriteSingleSamplingSet->GetDivisionPointer(0)[0] = cutFirst2LowBest;
+               pSmallChangeToModelOverwriteSingleSamplingSet->GetDivisionPointer(0)[0] = cutSecondLowBest;
             }
 
-            HistogramBucketVectorEntry<bClassification> * const pHistogramBucketVectorEntryTotals2LowLowBest =
-               pTotals2LowLowBest->GetHistogramBucketVectorEntry();
-            HistogramBucketVectorEntry<bClassification> * const pHistogramBucketVectorEntryTotals2LowHighBest =
-               pTotals2LowHighBest->GetHistogramBucketVectorEntry();
-            HistogramBucketVectorEntry<bClassification> * const pHistogramBucketVectorEntryTotals2HighLowBest =
-               pTotals2HighLowBest->GetHistogramBucketVectorEntry();
-            HistogramBucketVectorEntry<bClassification> * const pHistogramBucketVectorEntryTotals2HighHighBest =
-               pTotals2HighHighBest->GetHistogramBucketVectorEntry();
+            HistogramBucketVectorEntry<bClassification> * const pHistogramBucketVectorEntryTotalsLowLowBest =
+               pTotalsLowLowBest->GetHistogramBucketVectorEntry();
+            HistogramBucketVectorEntry<bClassification> * const pHistogramBucketVectorEntryTotalsLowHighBest =
+               pTotalsLowHighBest->GetHistogramBucketVectorEntry();
+            HistogramBucketVectorEntry<bClassification> * const pHistogramBucketVectorEntryTotalsHighLowBest =
+               pTotalsHighLowBest->GetHistogramBucketVectorEntry();
+            HistogramBucketVectorEntry<bClassification> * const pHistogramBucketVectorEntryTotalsHighHighBest =
+               pTotalsHighHighBest->GetHistogramBucketVectorEntry();
 
             for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
                FloatEbmType predictionLowLow;
@@ -596,49 +631,49 @@ public:
 
                if(bClassification) {
                   predictionLowLow = EbmStatistics::ComputeSmallChangeForOneSegmentClassificationLogOdds(
-                     pHistogramBucketVectorEntryTotals2LowLowBest[iVector].m_sumResidualError,
-                     pHistogramBucketVectorEntryTotals2LowLowBest[iVector].GetSumDenominator()
+                     pHistogramBucketVectorEntryTotalsLowLowBest[iVector].m_sumResidualError,
+                     pHistogramBucketVectorEntryTotalsLowLowBest[iVector].GetSumDenominator()
                   );
                   predictionLowHigh = EbmStatistics::ComputeSmallChangeForOneSegmentClassificationLogOdds(
-                     pHistogramBucketVectorEntryTotals2LowHighBest[iVector].m_sumResidualError,
-                     pHistogramBucketVectorEntryTotals2LowHighBest[iVector].GetSumDenominator()
+                     pHistogramBucketVectorEntryTotalsLowHighBest[iVector].m_sumResidualError,
+                     pHistogramBucketVectorEntryTotalsLowHighBest[iVector].GetSumDenominator()
                   );
                   predictionHighLow = EbmStatistics::ComputeSmallChangeForOneSegmentClassificationLogOdds(
-                     pHistogramBucketVectorEntryTotals2HighLowBest[iVector].m_sumResidualError,
-                     pHistogramBucketVectorEntryTotals2HighLowBest[iVector].GetSumDenominator()
+                     pHistogramBucketVectorEntryTotalsHighLowBest[iVector].m_sumResidualError,
+                     pHistogramBucketVectorEntryTotalsHighLowBest[iVector].GetSumDenominator()
                   );
                   predictionHighHigh = EbmStatistics::ComputeSmallChangeForOneSegmentClassificationLogOdds(
-                     pHistogramBucketVectorEntryTotals2HighHighBest[iVector].m_sumResidualError,
-                     pHistogramBucketVectorEntryTotals2HighHighBest[iVector].GetSumDenominator()
+                     pHistogramBucketVectorEntryTotalsHighHighBest[iVector].m_sumResidualError,
+                     pHistogramBucketVectorEntryTotalsHighHighBest[iVector].GetSumDenominator()
                   );
                } else {
                   EBM_ASSERT(IsRegression(compilerLearningTypeOrCountTargetClasses));
                   predictionLowLow = EbmStatistics::ComputeSmallChangeForOneSegmentRegression(
-                     pHistogramBucketVectorEntryTotals2LowLowBest[iVector].m_sumResidualError,
-                     static_cast<FloatEbmType>(pTotals2LowLowBest->GetCountSamplesInBucket())
+                     pHistogramBucketVectorEntryTotalsLowLowBest[iVector].m_sumResidualError,
+                     static_cast<FloatEbmType>(pTotalsLowLowBest->GetCountSamplesInBucket())
                   );
                   predictionLowHigh = EbmStatistics::ComputeSmallChangeForOneSegmentRegression(
-                     pHistogramBucketVectorEntryTotals2LowHighBest[iVector].m_sumResidualError,
-                     static_cast<FloatEbmType>(pTotals2LowHighBest->GetCountSamplesInBucket())
+                     pHistogramBucketVectorEntryTotalsLowHighBest[iVector].m_sumResidualError,
+                     static_cast<FloatEbmType>(pTotalsLowHighBest->GetCountSamplesInBucket())
                   );
                   predictionHighLow = EbmStatistics::ComputeSmallChangeForOneSegmentRegression(
-                     pHistogramBucketVectorEntryTotals2HighLowBest[iVector].m_sumResidualError,
-                     static_cast<FloatEbmType>(pTotals2HighLowBest->GetCountSamplesInBucket())
+                     pHistogramBucketVectorEntryTotalsHighLowBest[iVector].m_sumResidualError,
+                     static_cast<FloatEbmType>(pTotalsHighLowBest->GetCountSamplesInBucket())
                   );
                   predictionHighHigh = EbmStatistics::ComputeSmallChangeForOneSegmentRegression(
-                     pHistogramBucketVectorEntryTotals2HighHighBest[iVector].m_sumResidualError,
-                     static_cast<FloatEbmType>(pTotals2HighHighBest->GetCountSamplesInBucket())
+                     pHistogramBucketVectorEntryTotalsHighHighBest[iVector].m_sumResidualError,
+                     static_cast<FloatEbmType>(pTotalsHighHighBest->GetCountSamplesInBucket())
                   );
                }
 
-               if(cutFirst2LowBest < cutFirst2HighBest) {
+               if(cutSecondLowBest < cutSecondHighBest) {
                   pSmallChangeToModelOverwriteSingleSamplingSet->GetValuePointer()[0 * cVectorLength + iVector] = predictionLowLow;
                   pSmallChangeToModelOverwriteSingleSamplingSet->GetValuePointer()[1 * cVectorLength + iVector] = predictionLowHigh;
                   pSmallChangeToModelOverwriteSingleSamplingSet->GetValuePointer()[2 * cVectorLength + iVector] = predictionLowHigh;
                   pSmallChangeToModelOverwriteSingleSamplingSet->GetValuePointer()[3 * cVectorLength + iVector] = predictionHighLow;
                   pSmallChangeToModelOverwriteSingleSamplingSet->GetValuePointer()[4 * cVectorLength + iVector] = predictionHighLow;
                   pSmallChangeToModelOverwriteSingleSamplingSet->GetValuePointer()[5 * cVectorLength + iVector] = predictionHighHigh;
-               } else if(cutFirst2HighBest < cutFirst2LowBest) {
+               } else if(cutSecondHighBest < cutSecondLowBest) {
                   pSmallChangeToModelOverwriteSingleSamplingSet->GetValuePointer()[0 * cVectorLength + iVector] = predictionLowLow;
                   pSmallChangeToModelOverwriteSingleSamplingSet->GetValuePointer()[1 * cVectorLength + iVector] = predictionLowLow;
                   pSmallChangeToModelOverwriteSingleSamplingSet->GetValuePointer()[2 * cVectorLength + iVector] = predictionLowHigh;
@@ -657,9 +692,9 @@ public:
                LOG_0(TraceLevelWarning, "WARNING BoostMultiDimensional pSmallChangeToModelOverwriteSingleSamplingSet->SetCountDivisions(0, 1)");
                return true;
             }
-            pSmallChangeToModelOverwriteSingleSamplingSet->GetDivisionPointer(0)[0] = cutFirst1Best;
+            pSmallChangeToModelOverwriteSingleSamplingSet->GetDivisionPointer(0)[0] = cutFirstBest;
 
-            if(cutFirst1LowBest < cutFirst1HighBest) {
+            if(cutSecondLowBest < cutSecondHighBest) {
                if(pSmallChangeToModelOverwriteSingleSamplingSet->EnsureValueCapacity(cVectorLength * 6)) {
                   LOG_0(
                      TraceLevelWarning,
@@ -672,9 +707,9 @@ public:
                   LOG_0(TraceLevelWarning, "WARNING BoostMultiDimensional pSmallChangeToModelOverwriteSingleSamplingSet->SetCountDivisions(1, 2)");
                   return true;
                }
-               pSmallChangeToModelOverwriteSingleSamplingSet->GetDivisionPointer(1)[0] = cutFirst1LowBest;
-               pSmallChangeToModelOverwriteSingleSamplingSet->GetDivisionPointer(1)[1] = cutFirst1HighBest;
-            } else if(cutFirst1HighBest < cutFirst1LowBest) {
+               pSmallChangeToModelOverwriteSingleSamplingSet->GetDivisionPointer(1)[0] = cutSecondLowBest;
+               pSmallChangeToModelOverwriteSingleSamplingSet->GetDivisionPointer(1)[1] = cutSecondHighBest;
+            } else if(cutSecondHighBest < cutSecondLowBest) {
                if(pSmallChangeToModelOverwriteSingleSamplingSet->EnsureValueCapacity(cVectorLength * 6)) {
                   LOG_0(
                      TraceLevelWarning,
@@ -687,8 +722,8 @@ public:
                   LOG_0(TraceLevelWarning, "WARNING BoostMultiDimensional pSmallChangeToModelOverwriteSingleSamplingSet->SetCountDivisions(1, 2)");
                   return true;
                }
-               pSmallChangeToModelOverwriteSingleSamplingSet->GetDivisionPointer(1)[0] = cutFirst1HighBest;
-               pSmallChangeToModelOverwriteSingleSamplingSet->GetDivisionPointer(1)[1] = cutFirst1LowBest;
+               pSmallChangeToModelOverwriteSingleSamplingSet->GetDivisionPointer(1)[0] = cutSecondHighBest;
+               pSmallChangeToModelOverwriteSingleSamplingSet->GetDivisionPointer(1)[1] = cutSecondLowBest;
             } else {
                if(pSmallChangeToModelOverwriteSingleSamplingSet->SetCountDivisions(1, 1)) {
                   LOG_0(TraceLevelWarning, "WARNING BoostMultiDimensional pSmallChangeToModelOverwriteSingleSamplingSet->SetCountDivisions(1, 1)");
@@ -701,17 +736,17 @@ public:
                   );
                   return true;
                }
-               pSmallChangeToModelOverwriteSingleSamplingSet->GetDivisionPointer(1)[0] = cutFirst1LowBest;
+               pSmallChangeToModelOverwriteSingleSamplingSet->GetDivisionPointer(1)[0] = cutSecondLowBest;
             }
 
-            HistogramBucketVectorEntry<bClassification> * const pHistogramBucketVectorEntryTotals1LowLowBest =
-               pTotals1LowLowBest->GetHistogramBucketVectorEntry();
-            HistogramBucketVectorEntry<bClassification> * const pHistogramBucketVectorEntryTotals1LowHighBest =
-               pTotals1LowHighBest->GetHistogramBucketVectorEntry();
-            HistogramBucketVectorEntry<bClassification> * const pHistogramBucketVectorEntryTotals1HighLowBest =
-               pTotals1HighLowBest->GetHistogramBucketVectorEntry();
-            HistogramBucketVectorEntry<bClassification> * const pHistogramBucketVectorEntryTotals1HighHighBest =
-               pTotals1HighHighBest->GetHistogramBucketVectorEntry();
+            HistogramBucketVectorEntry<bClassification> * const pHistogramBucketVectorEntryTotalsLowLowBest =
+               pTotalsLowLowBest->GetHistogramBucketVectorEntry();
+            HistogramBucketVectorEntry<bClassification> * const pHistogramBucketVectorEntryTotalsLowHighBest =
+               pTotalsLowHighBest->GetHistogramBucketVectorEntry();
+            HistogramBucketVectorEntry<bClassification> * const pHistogramBucketVectorEntryTotalsHighLowBest =
+               pTotalsHighLowBest->GetHistogramBucketVectorEntry();
+            HistogramBucketVectorEntry<bClassification> * const pHistogramBucketVectorEntryTotalsHighHighBest =
+               pTotalsHighHighBest->GetHistogramBucketVectorEntry();
 
             for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
                FloatEbmType predictionLowLow;
@@ -721,48 +756,48 @@ public:
 
                if(bClassification) {
                   predictionLowLow = EbmStatistics::ComputeSmallChangeForOneSegmentClassificationLogOdds(
-                     pHistogramBucketVectorEntryTotals1LowLowBest[iVector].m_sumResidualError,
-                     pHistogramBucketVectorEntryTotals1LowLowBest[iVector].GetSumDenominator()
+                     pHistogramBucketVectorEntryTotalsLowLowBest[iVector].m_sumResidualError,
+                     pHistogramBucketVectorEntryTotalsLowLowBest[iVector].GetSumDenominator()
                   );
                   predictionLowHigh = EbmStatistics::ComputeSmallChangeForOneSegmentClassificationLogOdds(
-                     pHistogramBucketVectorEntryTotals1LowHighBest[iVector].m_sumResidualError,
-                     pHistogramBucketVectorEntryTotals1LowHighBest[iVector].GetSumDenominator()
+                     pHistogramBucketVectorEntryTotalsLowHighBest[iVector].m_sumResidualError,
+                     pHistogramBucketVectorEntryTotalsLowHighBest[iVector].GetSumDenominator()
                   );
                   predictionHighLow = EbmStatistics::ComputeSmallChangeForOneSegmentClassificationLogOdds(
-                     pHistogramBucketVectorEntryTotals1HighLowBest[iVector].m_sumResidualError,
-                     pHistogramBucketVectorEntryTotals1HighLowBest[iVector].GetSumDenominator()
+                     pHistogramBucketVectorEntryTotalsHighLowBest[iVector].m_sumResidualError,
+                     pHistogramBucketVectorEntryTotalsHighLowBest[iVector].GetSumDenominator()
                   );
                   predictionHighHigh = EbmStatistics::ComputeSmallChangeForOneSegmentClassificationLogOdds(
-                     pHistogramBucketVectorEntryTotals1HighHighBest[iVector].m_sumResidualError,
-                     pHistogramBucketVectorEntryTotals1HighHighBest[iVector].GetSumDenominator()
+                     pHistogramBucketVectorEntryTotalsHighHighBest[iVector].m_sumResidualError,
+                     pHistogramBucketVectorEntryTotalsHighHighBest[iVector].GetSumDenominator()
                   );
                } else {
                   EBM_ASSERT(IsRegression(compilerLearningTypeOrCountTargetClasses));
                   predictionLowLow = EbmStatistics::ComputeSmallChangeForOneSegmentRegression(
-                     pHistogramBucketVectorEntryTotals1LowLowBest[iVector].m_sumResidualError,
-                     static_cast<FloatEbmType>(pTotals1LowLowBest->GetCountSamplesInBucket())
+                     pHistogramBucketVectorEntryTotalsLowLowBest[iVector].m_sumResidualError,
+                     static_cast<FloatEbmType>(pTotalsLowLowBest->GetCountSamplesInBucket())
                   );
                   predictionLowHigh = EbmStatistics::ComputeSmallChangeForOneSegmentRegression(
-                     pHistogramBucketVectorEntryTotals1LowHighBest[iVector].m_sumResidualError,
-                     static_cast<FloatEbmType>(pTotals1LowHighBest->GetCountSamplesInBucket())
+                     pHistogramBucketVectorEntryTotalsLowHighBest[iVector].m_sumResidualError,
+                     static_cast<FloatEbmType>(pTotalsLowHighBest->GetCountSamplesInBucket())
                   );
                   predictionHighLow = EbmStatistics::ComputeSmallChangeForOneSegmentRegression(
-                     pHistogramBucketVectorEntryTotals1HighLowBest[iVector].m_sumResidualError,
-                     static_cast<FloatEbmType>(pTotals1HighLowBest->GetCountSamplesInBucket())
+                     pHistogramBucketVectorEntryTotalsHighLowBest[iVector].m_sumResidualError,
+                     static_cast<FloatEbmType>(pTotalsHighLowBest->GetCountSamplesInBucket())
                   );
                   predictionHighHigh = EbmStatistics::ComputeSmallChangeForOneSegmentRegression(
-                     pHistogramBucketVectorEntryTotals1HighHighBest[iVector].m_sumResidualError,
-                     static_cast<FloatEbmType>(pTotals1HighHighBest->GetCountSamplesInBucket())
+                     pHistogramBucketVectorEntryTotalsHighHighBest[iVector].m_sumResidualError,
+                     static_cast<FloatEbmType>(pTotalsHighHighBest->GetCountSamplesInBucket())
                   );
                }
-               if(cutFirst1LowBest < cutFirst1HighBest) {
+               if(cutSecondLowBest < cutSecondHighBest) {
                   pSmallChangeToModelOverwriteSingleSamplingSet->GetValuePointer()[0 * cVectorLength + iVector] = predictionLowLow;
                   pSmallChangeToModelOverwriteSingleSamplingSet->GetValuePointer()[1 * cVectorLength + iVector] = predictionHighLow;
                   pSmallChangeToModelOverwriteSingleSamplingSet->GetValuePointer()[2 * cVectorLength + iVector] = predictionLowHigh;
                   pSmallChangeToModelOverwriteSingleSamplingSet->GetValuePointer()[3 * cVectorLength + iVector] = predictionHighLow;
                   pSmallChangeToModelOverwriteSingleSamplingSet->GetValuePointer()[4 * cVectorLength + iVector] = predictionLowHigh;
                   pSmallChangeToModelOverwriteSingleSamplingSet->GetValuePointer()[5 * cVectorLength + iVector] = predictionHighHigh;
-               } else if(cutFirst1HighBest < cutFirst1LowBest) {
+               } else if(cutSecondHighBest < cutSecondLowBest) {
                   pSmallChangeToModelOverwriteSingleSamplingSet->GetValuePointer()[0 * cVectorLength + iVector] = predictionLowLow;
                   pSmallChangeToModelOverwriteSingleSamplingSet->GetValuePointer()[1 * cVectorLength + iVector] = predictionHighLow;
                   pSmallChangeToModelOverwriteSingleSamplingSet->GetValuePointer()[2 * cVectorLength + iVector] = predictionLowLow;
@@ -802,6 +837,7 @@ public:
       ThreadStateBoosting * const pThreadStateBoosting,
       const FeatureGroup * const pFeatureGroup,
       const size_t cSamplesRequiredForChildSplitMin,
+      const size_t cWorkers,
       HistogramBucketBase * pAuxiliaryBucketZone,
       HistogramBucketBase * const pTotal,
       FloatEbmType * const pTotalGain
@@ -822,6 +858,7 @@ public:
             pThreadStateBoosting,
             pFeatureGroup,
             cSamplesRequiredForChildSplitMin,
+            cWorkers,
             pAuxiliaryBucketZone,
             pTotal,
             pTotalGain
@@ -834,6 +871,7 @@ public:
             pThreadStateBoosting,
             pFeatureGroup,
             cSamplesRequiredForChildSplitMin,
+            cWorkers,
             pAuxiliaryBucketZone,
             pTotal,
             pTotalGain
@@ -855,6 +893,7 @@ public:
       ThreadStateBoosting * const pThreadStateBoosting,
       const FeatureGroup * const pFeatureGroup,
       const size_t cSamplesRequiredForChildSplitMin,
+      const size_t cWorkers,
       HistogramBucketBase * pAuxiliaryBucketZone,
       HistogramBucketBase * const pTotal,
       FloatEbmType * const pTotalGain
@@ -871,6 +910,7 @@ public:
          pThreadStateBoosting,
          pFeatureGroup,
          cSamplesRequiredForChildSplitMin,
+         cWorkers,
          pAuxiliaryBucketZone,
          pTotal,
          pTotalGain
@@ -881,10 +921,42 @@ public:
    }
 };
 
+extern size_t GetCountWorkersBoostingSplitPairs(const FeatureGroup * const pFeatureGroup) {
+   EBM_ASSERT(2 == pFeatureGroup->GetCountSignificantFeatures());
+
+   size_t cCuts = 0;
+   size_t cSweepCells = 1;
+   const FeatureGroupEntry * pFeatureGroupEntry = pFeatureGroup->GetFeatureGroupEntries();
+   const FeatureGroupEntry * const pFeatureGroupEntryEnd = pFeatureGroupEntry + pFeatureGroup->GetCountFeatures();
+   do {
+      const size_t cBins = pFeatureGroupEntry->m_pFeature->GetCountBins();
+      EBM_ASSERT(size_t { 1 } <= cBins); // we don't boost on empty training sets
+      if(size_t { 1 } < cBins) {
+         cCuts += cBins - 1;
+         // we check for simple multiplication overflow from m_cBins in Booster->Initialize when we unpack featureGroupsFeatureIndexes
+         EBM_ASSERT(!IsMultiplyError(cSweepCells, cBins - 1));
+         cSweepCells *= cBins - 1;
+      }
+      ++pFeatureGroupEntry;
+   } while(pFeatureGroupEntryEnd != pFeatureGroupEntry);
+
+   // every cut does 2 sweeps across the other dimension, and both dimensions get cut, so there are 4 sweep cells for each tensor cell.  
+   // Divide first so that we can't overflow
+   size_t cWorkers = cSweepCells / (k_cSweepCellsPerPairWorkerMin / 4);
+   if(cWorkers <= size_t { 1 }) {
+      return size_t { 1 };
+   }
+   const size_t cWorkersMax = GetCountWorkersMax();
+   cWorkers = cWorkersMax < cWorkers ? cWorkersMax : cWorkers;
+   cWorkers = cCuts < cWorkers ? cCuts : cWorkers;
+   return cWorkers;
+}
+
 extern bool FindBestBoostingSplitPairs(
    ThreadStateBoosting * const pThreadStateBoosting,
    const FeatureGroup * const pFeatureGroup,
    const size_t cSamplesRequiredForChildSplitMin,
+   const size_t cWorkers,
    HistogramBucketBase * pAuxiliaryBucketZone,
    HistogramBucketBase * const pTotal,
    FloatEbmType * const pTotalGain
@@ -896,23 +968,41 @@ extern bool FindBestBoostingSplitPairs(
    const ptrdiff_t runtimeLearningTypeOrCountTargetClasses = pBooster->GetRuntimeLearningTypeOrCountTargetClasses();
 
    if(IsClassification(runtimeLearningTypeOrCountTargetClasses)) {
-      return FindBestBoostingSplitPairsTarget<2>::Func(
-         pThreadStateBoosting,
-         pFeatureGroup,
-         cSamplesRequiredForChildSplitMin,
-         pAuxiliaryBucketZone,
-         pTotal,
-         pTotalGain
+      if(k_cCompilerOptimizedTargetClassesMax < runtimeLearningTypeOrCountTargetClasses) {
+         // there is no compiler optimized version for this many classes, so skip the template chain that looks for one
+         return FindBestBoostingSplitPairsTarget<k_cCompilerOptimizedTargetClassesMax + 1>::Func(
+            pThreadStateBoosting,
+            pFeatureGroup,
+            cSamplesRequiredForChildSplitMin,
+            cWorkers,
+            pAuxiliaryBucketZone,
+            pTotal,
+            pTotalGain
 #ifndef NDEBUG
-         , aHistogramBucketsDebugCopy
+            , aHistogramBucketsDebugCopy
 #endif // NDEBUG
-      );
+         );
+      } else {
+         return FindBestBoostingSplitPairsTarget<2>::Func(
+            pThreadStateBoosting,
+            pFeatureGroup,
+            cSamplesRequiredForChildSplitMin,
+            cWorkers,
+            pAuxiliaryBucketZone,
+            pTotal,
+            pTotalGain
+#ifndef NDEBUG
+            , aHistogramBucketsDebugCopy
+#endif // NDEBUG
+         );
+      }
    } else {
       EBM_ASSERT(IsRegression(runtimeLearningTypeOrCountTargetClasses));
       return FindBestBoostingSplitPairsInternal<k_regression>::Func(
          pThreadStateBoosting,
          pFeatureGroup,
          cSamplesRequiredForChildSplitMin,
+         cWorkers,
          pAuxiliaryBucketZone,
          pTotal,
          pTotalGain
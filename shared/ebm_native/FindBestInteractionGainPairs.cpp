@@ -38,17 +38,15 @@ public:
       , const unsigned char * const aHistogramBucketsEndDebug
 #endif // NDEBUG
    ) {
-      constexpr bool bClassification = IsClassification(compilerLearningTypeOrCountTargetClasses);
+      // interaction detection bins into the residual-only HistogramBucket<false> layout for all learning types since
+      // our gain function doesn't use the denominator term
+      HistogramBucket<false> * pAuxiliaryBucketZone = pAuxiliaryBucketZoneBase->GetHistogramBucket<false>();
 
-      HistogramBucket<IsClassification(compilerLearningTypeOrCountTargetClasses)> * pAuxiliaryBucketZone =
-         pAuxiliaryBucketZoneBase->GetHistogramBucket<bClassification>();
-
-      HistogramBucket<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const aHistogramBuckets =
-         aHistogramBucketsBase->GetHistogramBucket<bClassification>();
+      HistogramBucket<false> * const aHistogramBuckets = aHistogramBucketsBase->GetHistogramBucket<false>();
 
 #ifndef NDEBUG
-      const HistogramBucket<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const aHistogramBucketsDebugCopy =
-         aHistogramBucketsDebugCopyBase->GetHistogramBucket<bClassification>();
+      const HistogramBucket<false> * const aHistogramBucketsDebugCopy =
+         aHistogramBucketsDebugCopyBase->GetHistogramBucket<false>();
 #endif // NDEBUG
 
       const ptrdiff_t learningTypeOrCountTargetClasses = GET_LEARNING_TYPE_OR_COUNT_TARGET_CLASSES(
@@ -57,16 +55,16 @@ public:
       );
 
       const size_t cVectorLength = GetVectorLength(learningTypeOrCountTargetClasses);
-      const size_t cBytesPerHistogramBucket = GetHistogramBucketSize(bClassification, cVectorLength);
+      const size_t cBytesPerHistogramBucket = GetHistogramBucketSize(false, cVectorLength);
 
-      HistogramBucket<bClassification> * pTotalsLowLow =
-         GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pAuxiliaryBucketZone, 0);
-      HistogramBucket<bClassification> * pTotalsLowHigh =
-         GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pAuxiliaryBucketZone, 1);
-      HistogramBucket<bClassification> * pTotalsHighLow =
-         GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pAuxiliaryBucketZone, 2);
-      HistogramBucket<bClassification> * pTotalsHighHigh =
-         GetHistogramBucketByIndex<bClassification>(cBytesPerHistogramBucket, pAuxiliaryBucketZone, 3);
+      HistogramBucket<false> * pTotalsLowLow =
+         GetHistogramBucketByIndex<false>(cBytesPerHistogramBucket, pAuxiliaryBucketZone, 0);
+      HistogramBucket<false> * pTotalsLowHigh =
+         GetHistogramBucketByIndex<false>(cBytesPerHistogramBucket, pAuxiliaryBucketZone, 1);
+      HistogramBucket<false> * pTotalsHighLow =
+         GetHistogramBucketByIndex<false>(cBytesPerHistogramBucket, pAuxiliaryBucketZone, 2);
+      HistogramBucket<false> * pTotalsHighHigh =
+         GetHistogramBucketByIndex<false>(cBytesPerHistogramBucket, pAuxiliaryBucketZone, 3);
 
       // for interactions we return an interaction score of 0 if any of the dimensions are useless
       EBM_ASSERT(2 == pFeatureGroup->GetCountFeatures());
@@ -160,13 +158,13 @@ public:
                         FloatEbmType cHighLowSamplesInBucket = static_cast<FloatEbmType>(pTotalsHighLow->GetCountSamplesInBucket());
                         FloatEbmType cHighHighSamplesInBucket = static_cast<FloatEbmType>(pTotalsHighHigh->GetCountSamplesInBucket());
 
-                        HistogramBucketVectorEntry<bClassification> * const pHistogramBucketVectorEntryTotalsLowLow =
+                        HistogramBucketVectorEntry<false> * const pHistogramBucketVectorEntryTotalsLowLow =
                            pTotalsLowLow->GetHistogramBucketVectorEntry();
-                        HistogramBucketVectorEntry<bClassification> * const pHistogramBucketVectorEntryTotalsLowHigh =
+                        HistogramBucketVectorEntry<false> * const pHistogramBucketVectorEntryTotalsLowHigh =
                            pTotalsLowHigh->GetHistogramBucketVectorEntry();
-                        HistogramBucketVectorEntry<bClassification> * const pHistogramBucketVectorEntryTotalsHighLow =
+                        HistogramBucketVectorEntry<false> * const pHistogramBucketVectorEntryTotalsHighLow =
                            pTotalsHighLow->GetHistogramBucketVectorEntry();
-                        HistogramBucketVectorEntry<bClassification> * const pHistogramBucketVectorEntryTotalsHighHigh =
+                        HistogramBucketVectorEntry<false> * const pHistogramBucketVectorEntryTotalsHighHigh =
                            pTotalsHighHigh->GetHistogramBucketVectorEntry();
 
                         for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
@@ -318,17 +316,32 @@ extern FloatEbmType FindBestInteractionGainPairs(
    const ptrdiff_t runtimeLearningTypeOrCountTargetClasses = pInteractionDetector->GetRuntimeLearningTypeOrCountTargetClasses();
 
    if(IsClassification(runtimeLearningTypeOrCountTargetClasses)) {
-      return FindBestInteractionGainPairsTarget<2>::Func(
-         pInteractionDetector,
-         pFeatureGroup,
-         cSamplesRequiredForChildSplitMin,
-         pAuxiliaryBucketZone,
-         aHistogramBuckets
+      if(k_cCompilerOptimizedTargetClassesMax < runtimeLearningTypeOrCountTargetClasses) {
+         // there is no compiler optimized version for this many classes, so skip the template chain that looks for one
+         return FindBestInteractionGainPairsTarget<k_cCompilerOptimizedTargetClassesMax + 1>::Func(
+            pInteractionDetector,
+            pFeatureGroup,
+            cSamplesRequiredForChildSplitMin,
+            pAuxiliaryBucketZone,
+            aHistogramBuckets
 #ifndef NDEBUG
-         , aHistogramBucketsDebugCopy
-         , aHistogramBucketsEndDebug
+            , aHistogramBucketsDebugCopy
+            , aHistogramBucketsEndDebug
 #endif // NDEBUG
-      );
+         );
+      } else {
+         return FindBestInteractionGainPairsTarget<2>::Func(
+            pInteractionDetector,
+            pFeatureGroup,
+            cSamplesRequiredForChildSplitMin,
+            pAuxiliaryBucketZone,
+            aHistogramBuckets
+#ifndef NDEBUG
+            , aHistogramBucketsDebugCopy
+            , aHistogramBucketsEndDebug
+#endif // NDEBUG
+         );
+      }
    } else {
       EBM_ASSERT(IsRegression(runtimeLearningTypeOrCountTargetClasses));
       return FindBestInteractionGainPairsInternal<k_regression>::Func(
@@ -0,0 +1,313 @@
+// Copyright (c) 2018 Microsoft Corporation
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#include "PrecompiledHeader.h"
+
+#include <stddef.h> // size_t, ptrdiff_t
+
+#include "ebm_native.h" // FloatEbmType
+#include "EbmInternal.h" // INLINE_ALWAYS
+#include "Logging.h" // EBM_ASSERT & LOG
+#include "EbmStatisticUtils.h"
+
+#include "FeatureAtomic.h"
+#include "FeatureGroup.h"
+
+#include "HistogramTargetEntry.h"
+#include "HistogramBucket.h"
+
+#include "InteractionDetector.h"
+
+// TensorTotalsBuild turns the 3D histogram into a summed volume table where each bucket holds the totals of every bucket at or below it in
+// all 3 dimensions.  A cut at (iBin1, iBin2, iBin3) divides the tensor into 8 octants, and each octant total falls out of the 8 table entries
+// at the corners {iBin, cBins - 1} of each dimension by inclusion-exclusion.  TensorTotalsSum could get the same totals, but it walks the
+// dimensions generically and takes up to 8 lookups per octant, or 64 per cut, where these 8 shared corners are enough for all of them
+template<ptrdiff_t compilerLearningTypeOrCountTargetClasses>
+class FindBestInteractionGainTriplesInternal final {
+public:
+
+   FindBestInteractionGainTriplesInternal() = delete; // this is a static class.  Do not construct
+
+   static FloatEbmType Func(
+      InteractionDetector * const pInteractionDetector,
+      const FeatureGroup * const pFeatureGroup,
+      const size_t cSamplesRequiredForChildSplitMin,
+      const HistogramBucketBase * const aHistogramBucketsBase
+#ifndef NDEBUG
+      , const unsigned char * const aHistogramBucketsEndDebug
+#endif // NDEBUG
+   ) {
+      // interaction detection bins into the residual-only HistogramBucket<false> layout for all learning types since
+      // our gain function doesn't use the denominator term
+      const HistogramBucket<false> * const aHistogramBuckets = aHistogramBucketsBase->GetHistogramBucket<false>();
+
+      const ptrdiff_t learningTypeOrCountTargetClasses = GET_LEARNING_TYPE_OR_COUNT_TARGET_CLASSES(
+         compilerLearningTypeOrCountTargetClasses,
+         pInteractionDetector->GetRuntimeLearningTypeOrCountTargetClasses()
+      );
+      const size_t cVectorLength = GetVectorLength(learningTypeOrCountTargetClasses);
+      const size_t cBytesPerHistogramBucket = GetHistogramBucketSize(false, cVectorLength);
+
+      EBM_ASSERT(3 == pFeatureGroup->GetCountFeatures());
+      EBM_ASSERT(3 == pFeatureGroup->GetCountSignificantFeatures());
+
+      const size_t cBinsDimension1 = pFeatureGroup->GetFeatureGroupEntries()[0].m_pFeature->GetCountBins();
+      const size_t cBinsDimension2 = pFeatureGroup->GetFeatureGroupEntries()[1].m_pFeature->GetCountBins();
+      const size_t cBinsDimension3 = pFeatureGroup->GetFeatureGroupEntries()[2].m_pFeature->GetCountBins();
+      // any triple with a feature with 1 cBins returns an interaction score of 0
+      EBM_ASSERT(2 <= cBinsDimension1);
+      EBM_ASSERT(2 <= cBinsDimension2);
+      EBM_ASSERT(2 <= cBinsDimension3);
+
+      EBM_ASSERT(0 < cSamplesRequiredForChildSplitMin);
+
+      // the tensor was allocated, so these multiplications can't overflow
+      const size_t cStride2 = cBinsDimension1;
+      const size_t cStride3 = cBinsDimension1 * cBinsDimension2;
+      const size_t iLast1 = cBinsDimension1 - 1;
+      const size_t iLast2 = (cBinsDimension2 - 1) * cStride2;
+      const size_t iLast3 = (cBinsDimension3 - 1) * cStride3;
+
+      // never return anything above zero, which might happen due to numeric instability if we set this lower than 0
+      FloatEbmType bestSplittingScore = FloatEbmType { 0 };
+
+      size_t iBin3 = 0;
+      do {
+         const size_t iCut3 = iBin3 * cStride3;
+         size_t iBin2 = 0;
+         do {
+            const size_t iCut2 = iBin2 * cStride2;
+            size_t iBin1 = 0;
+            do {
+               // the corner bits are (dimension 1, dimension 2, dimension 3), with 0 at the cut and 1 at the last bin
+               const HistogramBucket<false> * const p000 = GetHistogramBucketByIndex<false>(
+                  cBytesPerHistogramBucket, aHistogramBuckets, iBin1 + iCut2 + iCut3);
+               const HistogramBucket<false> * const p100 = GetHistogramBucketByIndex<false>(
+                  cBytesPerHistogramBucket, aHistogramBuckets, iLast1 + iCut2 + iCut3);
+               const HistogramBucket<false> * const p010 = GetHistogramBucketByIndex<false>(
+                  cBytesPerHistogramBucket, aHistogramBuckets, iBin1 + iLast2 + iCut3);
+               const HistogramBucket<false> * const p110 = GetHistogramBucketByIndex<false>(
+                  cBytesPerHistogramBucket, aHistogramBuckets, iLast1 + iLast2 + iCut3);
+               const HistogramBucket<false> * const p001 = GetHistogramBucketByIndex<false>(
+                  cBytesPerHistogramBucket, aHistogramBuckets, iBin1 + iCut2 + iLast3);
+               const HistogramBucket<false> * const p101 = GetHistogramBucketByIndex<false>(
+                  cBytesPerHistogramBucket, aHistogramBuckets, iLast1 + iCut2 + iLast3);
+               const HistogramBucket<false> * const p011 = GetHistogramBucketByIndex<false>(
+                  cBytesPerHistogramBucket, aHistogramBuckets, iBin1 + iLast2 + iLast3);
+               const HistogramBucket<false> * const p111 = GetHistogramBucketByIndex<false>(
+                  cBytesPerHistogramBucket, aHistogramBuckets, iLast1 + iLast2 + iLast3);
+               ASSERT_BINNED_BUCKET_OK(cBytesPerHistogramBucket, p111, aHistogramBucketsEndDebug);
+
+               const size_t c000 = p000->GetCountSamplesInBucket();
+               const size_t c100 = p100->GetCountSamplesInBucket();
+               const size_t c010 = p010->GetCountSamplesInBucket();
+               const size_t c110 = p110->GetCountSamplesInBucket();
+               const size_t c001 = p001->GetCountSamplesInBucket();
+               const size_t c101 = p101->GetCountSamplesInBucket();
+               const size_t c011 = p011->GetCountSamplesInBucket();
+               const size_t c111 = p111->GetCountSamplesInBucket();
+
+               // unsigned math wraps in the middle of these expressions but the final results are all exact counts
+               const size_t cLowLowLow = c000;
+               const size_t cHighLowLow = c100 - c000;
+               const size_t cLowHighLow = c010 - c000;
+               const size_t cHighHighLow = c110 - c100 - c010 + c000;
+               const size_t cLowLowHigh = c001 - c000;
+               const size_t cHighLowHigh = c101 - c100 - c001 + c000;
+               const size_t cLowHighHigh = c011 - c010 - c001 + c000;
+               const size_t cHighHighHigh = c111 - c110 - c101 - c011 + c100 + c010 + c001 - c000;
+               EBM_ASSERT(c111 == cLowLowLow + cHighLowLow + cLowHighLow + cHighHighLow +
+                  cLowLowHigh + cHighLowHigh + cLowHighHigh + cHighHighHigh);
+
+               if(LIKELY(cSamplesRequiredForChildSplitMin <= cLowLowLow && cSamplesRequiredForChildSplitMin <= cHighLowLow &&
+                  cSamplesRequiredForChildSplitMin <= cLowHighLow && cSamplesRequiredForChildSplitMin <= cHighHighLow &&
+                  cSamplesRequiredForChildSplitMin <= cLowLowHigh && cSamplesRequiredForChildSplitMin <= cHighLowHigh &&
+                  cSamplesRequiredForChildSplitMin <= cLowHighHigh && cSamplesRequiredForChildSplitMin <= cHighHighHigh))
+               {
+                  const HistogramBucketVectorEntry<false> * const pEntry000 = p000->GetHistogramBucketVectorEntry();
+                  const HistogramBucketVectorEntry<false> * const pEntry100 = p100->GetHistogramBucketVectorEntry();
+                  const HistogramBucketVectorEntry<false> * const pEntry010 = p010->GetHistogramBucketVectorEntry();
+                  const HistogramBucketVectorEntry<false> * const pEntry110 = p110->GetHistogramBucketVectorEntry();
+                  const HistogramBucketVectorEntry<false> * const pEntry001 = p001->GetHistogramBucketVectorEntry();
+                  const HistogramBucketVectorEntry<false> * const pEntry101 = p101->GetHistogramBucketVectorEntry();
+                  const HistogramBucketVectorEntry<false> * const pEntry011 = p011->GetHistogramBucketVectorEntry();
+                  const HistogramBucketVectorEntry<false> * const pEntry111 = p111->GetHistogramBucketVectorEntry();
+
+                  const FloatEbmType cLowLowLowSamples = static_cast<FloatEbmType>(cLowLowLow);
+                  const FloatEbmType cHighLowLowSamples = static_cast<FloatEbmType>(cHighLowLow);
+                  const FloatEbmType cLowHighLowSamples = static_cast<FloatEbmType>(cLowHighLow);
+                  const FloatEbmType cHighHighLowSamples = static_cast<FloatEbmType>(cHighHighLow);
+                  const FloatEbmType cLowLowHighSamples = static_cast<FloatEbmType>(cLowLowHigh);
+                  const FloatEbmType cHighLowHighSamples = static_cast<FloatEbmType>(cHighLowHigh);
+                  const FloatEbmType cLowHighHighSamples = static_cast<FloatEbmType>(cLowHighHigh);
+                  const FloatEbmType cHighHighHighSamples = static_cast<FloatEbmType>(cHighHighHigh);
+
+                  FloatEbmType splittingScore = 0;
+                  for(size_t iVector = 0; iVector < cVectorLength; ++iVector) {
+                     const FloatEbmType s000 = pEntry000[iVector].m_sumResidualError;
+                     const FloatEbmType s100 = pEntry100[iVector].m_sumResidualError;
+                     const FloatEbmType s010 = pEntry010[iVector].m_sumResidualError;
+                     const FloatEbmType s110 = pEntry110[iVector].m_sumResidualError;
+                     const FloatEbmType s001 = pEntry001[iVector].m_sumResidualError;
+                     const FloatEbmType s101 = pEntry101[iVector].m_sumResidualError;
+                     const FloatEbmType s011 = pEntry011[iVector].m_sumResidualError;
+                     const FloatEbmType s111 = pEntry111[iVector].m_sumResidualError;
+
+                     splittingScore += EbmStatistics::ComputeNodeSplittingScore(s000, cLowLowLowSamples);
+                     splittingScore += EbmStatistics::ComputeNodeSplittingScore(s100 - s000, cHighLowLowSamples);
+                     splittingScore += EbmStatistics::ComputeNodeSplittingScore(s010 - s000, cLowHighLowSamples);
+                     splittingScore += EbmStatistics::ComputeNodeSplittingScore(s110 - s100 - s010 + s000, cHighHighLowSamples);
+                     splittingScore += EbmStatistics::ComputeNodeSplittingScore(s001 - s000, cLowLowHighSamples);
+                     splittingScore += EbmStatistics::ComputeNodeSplittingScore(s101 - s100 - s001 + s000, cHighLowHighSamples);
+                     splittingScore += EbmStatistics::ComputeNodeSplittingScore(s011 - s010 - s001 + s000, cLowHighHighSamples);
+                     splittingScore += EbmStatistics::ComputeNodeSplittingScore(
+                        s111 - s110 - s101 - s011 + s100 + s010 + s001 - s000, cHighHighHighSamples);
+                  }
+                  EBM_ASSERT(std::isnan(splittingScore) || FloatEbmType { 0 } <= splittingScore); // sumations of positive numbers should be positive
+
+                  // if we get a NaN result, we'd like to propagate it by making bestSplit NaN.  The rules for NaN values say that non equality
+                  // comparisons are all false so, let's flip this comparison such that it should be true for NaN values.  If the compiler violates
+                  // NaN comparions rules, no big deal.  NaN values will get us soon and shut down boosting.
+                  if(UNLIKELY(/* DO NOT CHANGE THIS WITHOUT READING THE ABOVE. WE DO THIS STRANGE COMPARISON FOR NaN values*/
+                     !(splittingScore <= bestSplittingScore))) {
+                     bestSplittingScore = splittingScore;
+                  } else {
+                     EBM_ASSERT(!std::isnan(splittingScore));
+                  }
+               }
+               ++iBin1;
+            } while(iBin1 < cBinsDimension1 - 1);
+            ++iBin2;
+         } while(iBin2 < cBinsDimension2 - 1);
+         ++iBin3;
+      } while(iBin3 < cBinsDimension3 - 1);
+      return bestSplittingScore;
+   }
+};
+
+template<ptrdiff_t compilerLearningTypeOrCountTargetClassesPossible>
+class FindBestInteractionGainTriplesTarget final {
+public:
+
+   FindBestInteractionGainTriplesTarget() = delete; // this is a static class.  Do not construct
+
+   INLINE_ALWAYS static FloatEbmType Func(
+      InteractionDetector * const pInteractionDetector,
+      const FeatureGroup * const pFeatureGroup,
+      const size_t cSamplesRequiredForChildSplitMin,
+      const HistogramBucketBase * const aHistogramBuckets
+#ifndef NDEBUG
+      , const unsigned char * const aHistogramBucketsEndDebug
+#endif // NDEBUG
+   ) {
+      static_assert(IsClassification(compilerLearningTypeOrCountTargetClassesPossible), "compilerLearningTypeOrCountTargetClassesPossible needs to be a classification");
+      static_assert(compilerLearningTypeOrCountTargetClassesPossible <= k_cCompilerOptimizedTargetClassesMax, "We can't have this many items in a data pack.");
+
+      const ptrdiff_t runtimeLearningTypeOrCountTargetClasses = pInteractionDetector->GetRuntimeLearningTypeOrCountTargetClasses();
+      EBM_ASSERT(IsClassification(runtimeLearningTypeOrCountTargetClasses));
+      EBM_ASSERT(runtimeLearningTypeOrCountTargetClasses <= k_cCompilerOptimizedTargetClassesMax);
+
+      if(compilerLearningTypeOrCountTargetClassesPossible == runtimeLearningTypeOrCountTargetClasses) {
+         return FindBestInteractionGainTriplesInternal<compilerLearningTypeOrCountTargetClassesPossible>::Func(
+            pInteractionDetector,
+            pFeatureGroup,
+            cSamplesRequiredForChildSplitMin,
+            aHistogramBuckets
+#ifndef NDEBUG
+            , aHistogramBucketsEndDebug
+#endif // NDEBUG
+         );
+      } else {
+         return FindBestInteractionGainTriplesTarget<compilerLearningTypeOrCountTargetClassesPossible + 1>::Func(
+            pInteractionDetector,
+            pFeatureGroup,
+            cSamplesRequiredForChildSplitMin,
+            aHistogramBuckets
+#ifndef NDEBUG
+            , aHistogramBucketsEndDebug
+#endif // NDEBUG
+         );
+      }
+   }
+};
+
+template<>
+class FindBestInteractionGainTriplesTarget<k_cCompilerOptimizedTargetClassesMax + 1> final {
+public:
+
+   FindBestInteractionGainTriplesTarget() = delete; // this is a static class.  Do not construct
+
+   INLINE_ALWAYS static FloatEbmType Func(
+      InteractionDetector * const pInteractionDetector,
+      const FeatureGroup * const pFeatureGroup,
+      const size_t cSamplesRequiredForChildSplitMin,
+      const HistogramBucketBase * const aHistogramBuckets
+#ifndef NDEBUG
+      , const unsigned char * const aHistogramBucketsEndDebug
+#endif // NDEBUG
+   ) {
+      static_assert(IsClassification(k_cCompilerOptimizedTargetClassesMax), "k_cCompilerOptimizedTargetClassesMax needs to be a classification");
+
+      EBM_ASSERT(IsClassification(pInteractionDetector->GetRuntimeLearningTypeOrCountTargetClasses()));
+      EBM_ASSERT(k_cCompilerOptimizedTargetClassesMax < pInteractionDetector->GetRuntimeLearningTypeOrCountTargetClasses());
+
+      return FindBestInteractionGainTriplesInternal<k_dynamicClassification>::Func(
+         pInteractionDetector,
+         pFeatureGroup,
+         cSamplesRequiredForChildSplitMin,
+         aHistogramBuckets
+#ifndef NDEBUG
+         , aHistogramBucketsEndDebug
+#endif // NDEBUG
+      );
+   }
+};
+
+extern FloatEbmType FindBestInteractionGainTriples(
+   InteractionDetector * const pInteractionDetector,
+   const FeatureGroup * const pFeatureGroup,
+   const size_t cSamplesRequiredForChildSplitMin,
+   const HistogramBucketBase * const aHistogramBuckets
+#ifndef NDEBUG
+   , const unsigned char * const aHistogramBucketsEndDebug
+#endif // NDEBUG
+) {
+   const ptrdiff_t runtimeLearningTypeOrCountTargetClasses = pInteractionDetector->GetRuntimeLearningTypeOrCountTargetClasses();
+
+   if(IsClassification(runtimeLearningTypeOrCountTargetClasses)) {
+      if(k_cCompilerOptimizedTargetClassesMax < runtimeLearningTypeOrCountTargetClasses) {
+         // there is no compiler optimized version for this many classes, so skip the template chain that looks for one
+         return FindBestInteractionGainTriplesTarget<k_cCompilerOptimizedTargetClassesMax + 1>::Func(
+            pInteractionDetector,
+            pFeatureGroup,
+            cSamplesRequiredForChildSplitMin,
+            aHistogramBuckets
+#ifndef NDEBUG
+            , aHistogramBucketsEndDebug
+#endif // NDEBUG
+         );
+      } else {
+         return FindBestInteractionGainTriplesTarget<2>::Func(
+            pInteractionDetector,
+            pFeatureGroup,
+            cSamplesRequiredForChildSplitMin,
+            aHistogramBuckets
+#ifndef NDEBUG
+            , aHistogramBucketsEndDebug
+#endif // NDEBUG
+         );
+      }
+   } else {
+      EBM_ASSERT(IsRegression(runtimeLearningTypeOrCountTargetClasses));
+      return FindBestInteractionGainTriplesInternal<k_regression>::Func(
+         pInteractionDetector,
+         pFeatureGroup,
+         cSamplesRequiredForChildSplitMin,
+         aHistogramBuckets
+#ifndef NDEBUG
+         , aHistogramBucketsEndDebug
+#endif // NDEBUG
+      );
+   }
+}
@@ -33,6 +33,7 @@
 extern void BinBoosting(
    ThreadStateBoosting * const pThreadStateBoosting,
    const FeatureGroup * const pFeatureGroup,
+   const size_t * const aiTensorBinsCoarse,
    const SamplingSet * const pTrainingSet
 );
 
@@ -53,10 +54,13 @@ extern bool GrowDecisionTree(
    FloatEbmType * const pTotalGain
 );
 
+extern size_t GetCountWorkersBoostingSplitPairs(const FeatureGroup * const pFeatureGroup);
+
 extern bool FindBestBoostingSplitPairs(
    ThreadStateBoosting * const pThreadStateBoosting,
    const FeatureGroup * const pFeatureGroup,
    const size_t cSamplesRequiredForChildSplitMin,
+   const size_t cWorkers,
    HistogramBucketBase * pAuxiliaryBucketZone,
    HistogramBucketBase * const pTotal,
    FloatEbmType * const pTotalGain
@@ -113,6 +117,7 @@ static bool BoostZeroDimensional(
    BinBoosting(
       pThreadStateBoosting,
       nullptr,
+      nullptr,
       pTrainingSet
    );
 
@@ -161,6 +166,7 @@ static bool BoostZeroDimensional(
 static bool BoostSingleDimensional(
    ThreadStateBoosting * const pThreadStateBoosting,
    const FeatureGroup * const pFeatureGroup,
+   const size_t * const aiTensorBinsCoarse,
    const size_t cHistogramBuckets,
    const SamplingSet * const pTrainingSet,
    const size_t cSamplesRequiredForChildSplitMin,
@@ -238,6 +244,7 @@ static bool BoostSingleDimensional(
    BinBoosting(
       pThreadStateBoosting,
       pFeatureGroup,
+      aiTensorBinsCoarse,
       pTrainingSet
    );
 
@@ -271,6 +278,7 @@ static bool BoostSingleDimensional(
 static bool BoostMultiDimensional(
    ThreadStateBoosting * const pThreadStateBoosting,
    const FeatureGroup * const pFeatureGroup,
+   const size_t * const aiTensorBinsCoarse,
    const SamplingSet * const pTrainingSet,
    const size_t cSamplesRequiredForChildSplitMin,
    FloatEbmType * const pTotalGain
@@ -303,8 +311,11 @@ static bool BoostMultiDimensional(
       }
       ++pFeatureGroupEntry;
    } while(pFeatureGroupEntryEnd != pFeatureGroupEntry);
-   // we need to reserve 4 PAST the pointer we pass into SweepMultiDiemensional!!!!.  We pass in index 20 at max, so we need 24
-   const size_t cAuxillaryBucketsForSplitting = 24;
+   // FindBestBoostingSplitPairs gives each of its workers 12 auxillary buckets: 4 for the worker's best totals, and 4 for each of the 
+   // 2 zones that it passes into SweepMultiDiemensional, which needs to reserve 4 PAST the pointer we pass into it!!!!
+   const size_t cWorkersSplitPairs =
+      2 == pFeatureGroup->GetCountSignificantFeatures() ? GetCountWorkersBoostingSplitPairs(pFeatureGroup) : size_t { 1 };
+   const size_t cAuxillaryBucketsForSplitting = size_t { 12 } * cWorkersSplitPairs;
    const size_t cAuxillaryBuckets =
       cAuxillaryBucketsForBuildFastTotals < cAuxillaryBucketsForSplitting ? cAuxillaryBucketsForSplitting : cAuxillaryBucketsForBuildFastTotals;
    if(IsAddError(cTotalBucketsMainSpace, cAuxillaryBuckets)) {
@@ -368,6 +379,7 @@ static bool BoostMultiDimensional(
    BinBoosting(
       pThreadStateBoosting,
       pFeatureGroup,
+      aiTensorBinsCoarse,
       pTrainingSet
    );
 
@@ -501,6 +513,7 @@ static bool BoostMultiDimensional(
          pThreadStateBoosting,
          pFeatureGroup,
          cSamplesRequiredForChildSplitMin,
+         cWorkersSplitPairs,
          pAuxiliaryBucketZone,
          pTotal,
          pTotalGain
@@ -546,6 +559,7 @@ static bool BoostMultiDimensional(
 static bool BoostRandom(
    ThreadStateBoosting * const pThreadStateBoosting,
    const FeatureGroup * const pFeatureGroup,
+   const size_t * const aiTensorBinsCoarse,
    const SamplingSet * const pTrainingSet,
    const GenerateUpdateOptionsType options,
    const IntEbmType * const aLeavesMax,
@@ -615,6 +629,7 @@ static bool BoostRandom(
    BinBoosting(
       pThreadStateBoosting,
       pFeatureGroup,
+      aiTensorBinsCoarse,
       pTrainingSet
    );
 
@@ -641,6 +656,36 @@ static bool BoostRandom(
    return false;
 }
 
+static void TranslateCoarseCuts(
+   const Booster * const pBooster,
+   const FeatureGroup * const pFeatureGroupCoarse,
+   SegmentedTensor * const pSmallChangeToModel
+) {
+   // every coarse bin except the last merges exactly cBinsMerged fine bins, so a cut after coarse bin iCut lands 
+   // exactly after fine bin (iCut + 1) * cBinsMerged - 1, and the update can be added to the full resolution model
+   size_t iDimension = 0;
+   const FeatureGroupEntry * pFeatureGroupEntry = pFeatureGroupCoarse->GetFeatureGroupEntries();
+   const FeatureGroupEntry * const pFeatureGroupEntryEnd = pFeatureGroupEntry + pFeatureGroupCoarse->GetCountFeatures();
+   do {
+      const Feature * const pFeature = pFeatureGroupEntry->m_pFeature;
+      if(size_t { 1 } < pFeature->GetCountBins()) {
+         const size_t cBinsMerged = pBooster->GetCountBinsMergedCoarse(pFeature->GetIndexFeatureData());
+         EBM_ASSERT(size_t { 1 } <= cBinsMerged);
+         ActiveDataType * pCut = pSmallChangeToModel->GetDivisionPointer(iDimension);
+         const ActiveDataType * const pCutEnd = pCut + pSmallChangeToModel->GetCountDivisions(iDimension);
+         while(pCutEnd != pCut) {
+            const size_t iCut = static_cast<size_t>(*pCut);
+            EBM_ASSERT(iCut + 1 < pFeature->GetCountBins());
+            *pCut = static_cast<ActiveDataType>((iCut + 1) * cBinsMerged - 1);
+            ++pCut;
+         }
+         ++iDimension;
+      }
+      ++pFeatureGroupEntry;
+   } while(pFeatureGroupEntryEnd != pFeatureGroupEntry);
+   EBM_ASSERT(pFeatureGroupCoarse->GetCountSignificantFeatures() == iDimension);
+}
+
 WARNING_PUSH
 WARNING_DISABLE_UNINITIALIZED_LOCAL_VARIABLE
 
@@ -663,7 +708,13 @@ static IntEbmType GenerateModelUpdateInternal(
    LOG_0(TraceLevelVerbose, "Entered GenerateModelUpdateInternal");
 
    const size_t cSamplingSetsAfterZero = (0 == pBooster->GetCountSamplingSets()) ? 1 : pBooster->GetCountSamplingSets();
-   const FeatureGroup * const pFeatureGroup = pBooster->GetFeatureGroups()[iFeatureGroup];
+   // while the coarse-to-fine bin schedule is active for this feature group we boost on its coarse view, which has
+   // the same dimensions as the real feature group but fewer bins in its ordinal features
+   const FeatureGroup * const pFeatureGroupCoarse = pBooster->GetFeatureGroupCoarse(iFeatureGroup);
+   const FeatureGroup * const pFeatureGroup =
+      nullptr == pFeatureGroupCoarse ? pBooster->GetFeatureGroups()[iFeatureGroup] : pFeatureGroupCoarse;
+   const size_t * const aiTensorBinsCoarse =
+      nullptr == pFeatureGroupCoarse ? nullptr : pBooster->GetTensorBinsCoarse(iFeatureGroup);
    const size_t cSignificantDimensions = pFeatureGroup->GetCountSignificantFeatures();
 
    IntEbmType lastDimensionLeavesMax = IntEbmType { 0 };
@@ -731,6 +782,7 @@ static IntEbmType GenerateModelUpdateInternal(
             if(BoostRandom(
                pThreadStateBoosting,
                pFeatureGroup,
+               aiTensorBinsCoarse,
                pBooster->GetSamplingSets()[iSamplingSet],
                options,
                aLeavesMax, 
@@ -748,6 +800,7 @@ static IntEbmType GenerateModelUpdateInternal(
             if(BoostSingleDimensional(
                pThreadStateBoosting,
                pFeatureGroup,
+               aiTensorBinsCoarse,
                cSignificantBinCount,
                pBooster->GetSamplingSets()[iSamplingSet],
                cSamplesRequiredForChildSplitMin,
@@ -763,6 +816,7 @@ static IntEbmType GenerateModelUpdateInternal(
             if(BoostMultiDimensional(
                pThreadStateBoosting,
                pFeatureGroup,
+               aiTensorBinsCoarse,
                pBooster->GetSamplingSets()[iSamplingSet],
                cSamplesRequiredForChildSplitMin,
                &gain
@@ -777,6 +831,9 @@ static IntEbmType GenerateModelUpdateInternal(
          // See ExamineNodeForPossibleFutureSplittingAndDetermineBestSplitPoint for details, and the equivalent interaction function
          EBM_ASSERT(std::isnan(gain) || (!bClassification) && std::isinf(gain) || k_epsilonNegativeGainAllowed <= gain); // we previously normalized to 0
          totalGain += gain;
+         if(nullptr != pFeatureGroupCoarse && IntEbmType { 0 } != lastDimensionLeavesMax) {
+            TranslateCoarseCuts(pBooster, pFeatureGroupCoarse, pThreadStateBoosting->GetSmallChangeToModelOverwriteSingleSamplingSet());
+         }
          // TODO : when we thread this code, let's have each thread take a lock and update the combined line segment.  They'll each do it while the 
          // others are working, so there should be no blocking and our final result won't require adding by the main thread
          if(pThreadStateBoosting->GetSmallChangeToModelAccumulatedFromSamplingSets()->Add(*pThreadStateBoosting->GetSmallChangeToModelOverwriteSingleSamplingSet())) {
@@ -853,6 +910,7 @@ static IntEbmType GenerateModelUpdateInternal(
    }
 
    pThreadStateBoosting->SetFeatureGroupIndex(iFeatureGroup);
+   pThreadStateBoosting->SetGain(totalGain);
 
    if(nullptr != pGainReturn) {
       *pGainReturn = totalGain;
@@ -1004,6 +1062,7 @@ EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION GenerateM
          *gainOut = FloatEbmType { 0 };
       }
       pThreadStateBoosting->SetFeatureGroupIndex(iFeatureGroup);
+      pThreadStateBoosting->SetGain(FloatEbmType { 0 });
 
       LOG_0(
          TraceLevelWarning,
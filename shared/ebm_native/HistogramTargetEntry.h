@@ -97,7 +97,8 @@ static_assert(std::is_pod<HistogramBucketVectorEntry<true>>::value,
 
 template<>
 struct HistogramBucketVectorEntry<false> final : HistogramBucketVectorEntryBase {
-   // regression version of the HistogramBucketVectorEntry class
+   // regression version of the HistogramBucketVectorEntry class.  Interaction detection also uses this residual-only
+   // layout for classification since the interaction gain never needs the denominator term
 
 #ifndef __SUNPRO_CC
 
@@ -6,16 +6,22 @@
 
 #include <stdlib.h> // free
 #include <stddef.h> // size_t, ptrdiff_t
+#include <string.h> // memcpy
 #include <limits> // numeric_limits
+#include <cmath> // round
 
 #include "ebm_native.h"
 #include "EbmInternal.h"
 #include "Logging.h" // EBM_ASSERT & LOG
 // feature includes
+#include "RandomStream.h"
 #include "FeatureAtomic.h"
 #include "FeatureGroup.h"
+#include "SegmentedTensor.h"
 // dataset depends on features
+#include "DataSetBoosting.h"
 #include "DataSetInteraction.h"
+#include "Booster.h"
 #include "ThreadStateInteraction.h"
 
 #include "InteractionDetector.h"
@@ -24,6 +30,7 @@ void InteractionDetector::Free(InteractionDetector * const pInteractionDetector)
    LOG_0(TraceLevelInfo, "Entered InteractionDetector::Free");
 
    if(nullptr != pInteractionDetector) {
+      pInteractionDetector->m_dataSetInBag.Destruct();
       pInteractionDetector->m_dataSet.Destruct();
       free(pInteractionDetector->m_aFeatures);
       free(pInteractionDetector);
@@ -32,6 +39,71 @@ void InteractionDetector::Free(InteractionDetector * const pInteractionDetector)
    LOG_0(TraceLevelInfo, "Exited InteractionDetector::Free");
 }
 
+static Feature * ConstructFeatures(
+   const size_t cFeatures,
+   const BoolEbmType * const aFeaturesCategorical,
+   const IntEbmType * const aFeaturesBinCount,
+   const size_t cSamples
+) {
+   LOG_0(TraceLevelInfo, "Entered ConstructFeatures");
+
+   EBM_ASSERT(0 < cFeatures);
+
+   Feature * const aFeatures = EbmMalloc<Feature>(cFeatures);
+   if(nullptr == aFeatures) {
+      LOG_0(TraceLevelWarning, "WARNING ConstructFeatures nullptr == aFeatures");
+      return nullptr;
+   }
+
+   const BoolEbmType * pFeatureCategorical = aFeaturesCategorical;
+   const IntEbmType * pFeatureBinCount = aFeaturesBinCount;
+   size_t iFeatureInitialize = 0;
+   do {
+      const IntEbmType countBins = *pFeatureBinCount;
+      if(countBins < 0) {
+         LOG_0(TraceLevelError, "ERROR ConstructFeatures countBins cannot be negative");
+         free(aFeatures);
+         return nullptr;
+      }
+      if(0 == countBins && 0 != cSamples) {
+         LOG_0(TraceLevelError, "ERROR ConstructFeatures countBins cannot be zero if 0 < cSamples");
+         free(aFeatures);
+         return nullptr;
+      }
+      if(!IsNumberConvertable<size_t>(countBins)) {
+         LOG_0(TraceLevelWarning, "WARNING ConstructFeatures countBins is too high for us to allocate enough memory");
+         free(aFeatures);
+         return nullptr;
+      }
+      const size_t cBins = static_cast<size_t>(countBins);
+      if(0 == cBins) {
+         // we can handle 0 == cBins even though that's a degenerate case that shouldn't be boosted on.  0 bins
+         // can only occur if there were zero training and zero validation cases since the 
+         // features would require a value, even if it was 0.
+         LOG_0(TraceLevelInfo, "INFO ConstructFeatures feature with 0 values");
+      } else if(1 == cBins) {
+         // we can handle 1 == cBins even though that's a degenerate case that shouldn't be boosted on. 
+         // Dimensions with 1 bin don't contribute anything since they always have the same value.
+         LOG_0(TraceLevelInfo, "INFO ConstructFeatures feature with 1 value");
+      }
+      const BoolEbmType isCategorical = *pFeatureCategorical;
+      if(EBM_FALSE != isCategorical && EBM_TRUE != isCategorical) {
+         LOG_0(TraceLevelWarning, "WARNING ConstructFeatures featuresCategorical should either be EBM_TRUE or EBM_FALSE");
+      }
+      const bool bCategorical = EBM_FALSE != isCategorical;
+
+      aFeatures[iFeatureInitialize].Initialize(cBins, iFeatureInitialize, bCategorical);
+
+      ++pFeatureCategorical;
+      ++pFeatureBinCount;
+
+      ++iFeatureInitialize;
+   } while(cFeatures != iFeatureInitialize);
+
+   LOG_0(TraceLevelInfo, "Exited ConstructFeatures");
+   return aFeatures;
+}
+
 InteractionDetector * InteractionDetector::Allocate(
    const ptrdiff_t runtimeLearningTypeOrCountTargetClasses,
    const size_t cFeatures,
@@ -54,61 +126,14 @@ InteractionDetector * InteractionDetector::Allocate(
 
    LOG_0(TraceLevelInfo, "Entered InteractionDetector::Allocate");
 
-   LOG_0(TraceLevelInfo, "InteractionDetector::Allocate starting feature processing");
    Feature * aFeatures = nullptr;
    if(0 != cFeatures) {
-      aFeatures = EbmMalloc<Feature>(cFeatures);
+      aFeatures = ConstructFeatures(cFeatures, aFeaturesCategorical, aFeaturesBinCount, cSamples);
       if(nullptr == aFeatures) {
-         LOG_0(TraceLevelWarning, "WARNING InteractionDetector::Allocate nullptr == aFeatures");
+         // error already logged
          return nullptr;
       }
-
-      const BoolEbmType * pFeatureCategorical = aFeaturesCategorical;
-      const IntEbmType * pFeatureBinCount = aFeaturesBinCount;
-      size_t iFeatureInitialize = 0;
-      do {
-         const IntEbmType countBins = *pFeatureBinCount;
-         if(countBins < 0) {
-            LOG_0(TraceLevelError, "ERROR InteractionDetector::Allocate countBins cannot be negative");
-            free(aFeatures);
-            return nullptr;
-         }
-         if(0 == countBins && 0 != cSamples) {
-            LOG_0(TraceLevelError, "ERROR InteractionDetector::Allocate countBins cannot be zero if 0 < cSamples");
-            free(aFeatures);
-            return nullptr;
-         }
-         if(!IsNumberConvertable<size_t>(countBins)) {
-            LOG_0(TraceLevelWarning, "WARNING InteractionDetector::Allocate countBins is too high for us to allocate enough memory");
-            free(aFeatures);
-            return nullptr;
-         }
-         const size_t cBins = static_cast<size_t>(countBins);
-         if(0 == cBins) {
-            // we can handle 0 == cBins even though that's a degenerate case that shouldn't be boosted on.  0 bins
-            // can only occur if there were zero training and zero validation cases since the 
-            // features would require a value, even if it was 0.
-            LOG_0(TraceLevelInfo, "INFO InteractionDetector::Allocate feature with 0 values");
-         } else if(1 == cBins) {
-            // we can handle 1 == cBins even though that's a degenerate case that shouldn't be boosted on. 
-            // Dimensions with 1 bin don't contribute anything since they always have the same value.
-            LOG_0(TraceLevelInfo, "INFO InteractionDetector::Allocate feature with 1 value");
-         }
-         const BoolEbmType isCategorical = *pFeatureCategorical;
-         if(EBM_FALSE != isCategorical && EBM_TRUE != isCategorical) {
-            LOG_0(TraceLevelWarning, "WARNING InteractionDetector::Initialize featuresCategorical should either be EBM_TRUE or EBM_FALSE");
-         }
-         const bool bCategorical = EBM_FALSE != isCategorical;
-
-         aFeatures[iFeatureInitialize].Initialize(cBins, iFeatureInitialize, bCategorical);
-
-         ++pFeatureCategorical;
-         ++pFeatureBinCount;
-
-         ++iFeatureInitialize;
-      } while(cFeatures != iFeatureInitialize);
    }
-   LOG_0(TraceLevelInfo, "InteractionDetector::Allocate done feature processing");
 
    InteractionDetector * const pRet = EbmMalloc<InteractionDetector>();
    if(nullptr == pRet) {
@@ -141,6 +166,155 @@ InteractionDetector * InteractionDetector::Allocate(
    return pRet;
 }
 
+// makes an InteractionDetector from the residuals that pBooster already holds instead of recomputing them from scores that our caller 
+// predicts.  If aBinnedData is nullptr we also take the features and binned data of pBooster's training set, otherwise aBinnedData holds 
+// the same samples binned differently, which is how callers detect pairs on coarser bins than they boost mains on.  We copy what we need, 
+// so pBooster can keep boosting or be freed while the InteractionDetector lives
+InteractionDetector * InteractionDetector::AllocateFromBooster(
+   Booster * const pBooster,
+   const bool bUseBestModel,
+   const size_t cFeatures,
+   const BoolEbmType * const aFeaturesCategorical,
+   const IntEbmType * const aFeaturesBinCount,
+   const IntEbmType * const aBinnedData,
+   const FloatEbmType * const optionalTempParams
+) {
+   // optionalTempParams isn't used by default.  It's meant to provide an easy way for python or other higher
+   // level languages to pass EXPERIMENTAL temporary parameters easily to the C++ code.
+   UNUSED(optionalTempParams);
+
+   EBM_ASSERT(nullptr != pBooster);
+
+   LOG_0(TraceLevelInfo, "Entered InteractionDetector::AllocateFromBooster");
+
+   Feature * aFeatures = nullptr;
+   if(0 != cFeatures) {
+      if(nullptr == aBinnedData) {
+         EBM_ASSERT(pBooster->GetCountFeatures() == cFeatures);
+         aFeatures = EbmMalloc<Feature>(cFeatures);
+         if(nullptr == aFeatures) {
+            LOG_0(TraceLevelWarning, "WARNING InteractionDetector::AllocateFromBooster nullptr == aFeatures");
+            return nullptr;
+         }
+         memcpy(aFeatures, pBooster->GetFeatures(), sizeof(*aFeatures) * cFeatures);
+      } else {
+         aFeatures = ConstructFeatures(cFeatures, aFeaturesCategorical, aFeaturesBinCount, pBooster->GetTrainingSet()->GetCountSamples());
+         if(nullptr == aFeatures) {
+            // error already logged
+            return nullptr;
+         }
+      }
+   }
+
+   InteractionDetector * const pRet = EbmMalloc<InteractionDetector>();
+   if(nullptr == pRet) {
+      free(aFeatures);
+      return nullptr;
+   }
+   pRet->InitializeZero();
+
+   pRet->m_runtimeLearningTypeOrCountTargetClasses = pBooster->GetRuntimeLearningTypeOrCountTargetClasses();
+   pRet->m_cFeatures = cFeatures;
+   pRet->m_aFeatures = aFeatures;
+   pRet->m_cLogEnterMessages = 1000;
+   pRet->m_cLogExitMessages = 1000;
+
+   if(pRet->m_dataSet.InitializeFromBooster(pBooster, cFeatures, aFeatures, aBinnedData, bUseBestModel)) {
+      LOG_0(TraceLevelWarning, "WARNING InteractionDetector::AllocateFromBooster m_dataSet.InitializeFromBooster");
+      InteractionDetector::Free(pRet);
+      return nullptr;
+   }
+
+   LOG_0(TraceLevelInfo, "Exited InteractionDetector::AllocateFromBooster");
+   return pRet;
+}
+
+// makes an independent InteractionDetector over a random subset of the samples of pInteractionDetectorOriginal.  The features are copied 
+// so that the subsample can be freed with InteractionDetector::Free like any other
+InteractionDetector * InteractionDetector::AllocateSubsample(
+   const InteractionDetector * const pInteractionDetectorOriginal,
+   const size_t cSamplesSubsample,
+   RandomStream * const pRandomStream
+) {
+   EBM_ASSERT(nullptr != pInteractionDetectorOriginal);
+   EBM_ASSERT(1 <= cSamplesSubsample);
+   EBM_ASSERT(cSamplesSubsample <= pInteractionDetectorOriginal->GetDataSetByFeature()->GetCountSamples());
+
+   LOG_0(TraceLevelInfo, "Entered InteractionDetector::AllocateSubsample");
+
+   const size_t cFeatures = pInteractionDetectorOriginal->m_cFeatures;
+   Feature * aFeatures = nullptr;
+   if(0 != cFeatures) {
+      aFeatures = EbmMalloc<Feature>(cFeatures);
+      if(nullptr == aFeatures) {
+         LOG_0(TraceLevelWarning, "WARNING InteractionDetector::AllocateSubsample nullptr == aFeatures");
+         return nullptr;
+      }
+      memcpy(aFeatures, pInteractionDetectorOriginal->m_aFeatures, sizeof(*aFeatures) * cFeatures);
+   }
+
+   InteractionDetector * const pRet = EbmMalloc<InteractionDetector>();
+   if(nullptr == pRet) {
+      free(aFeatures);
+      return nullptr;
+   }
+   pRet->InitializeZero();
+
+   const ptrdiff_t runtimeLearningTypeOrCountTargetClasses = pInteractionDetectorOriginal->m_runtimeLearningTypeOrCountTargetClasses;
+   pRet->m_runtimeLearningTypeOrCountTargetClasses = runtimeLearningTypeOrCountTargetClasses;
+   pRet->m_cFeatures = cFeatures;
+   pRet->m_aFeatures = aFeatures;
+   pRet->m_cLogEnterMessages = 1000;
+   pRet->m_cLogExitMessages = 1000;
+
+   if(pRet->m_dataSet.InitializeSubsample(
+      pInteractionDetectorOriginal->GetDataSetByFeature(),
+      aFeatures,
+      GetVectorLength(runtimeLearningTypeOrCountTargetClasses),
+      cSamplesSubsample,
+      false,
+      pRandomStream
+   )) {
+      LOG_0(TraceLevelWarning, "WARNING InteractionDetector::AllocateSubsample m_dataSet.InitializeSubsample");
+      InteractionDetector::Free(pRet);
+      return nullptr;
+   }
+
+   LOG_0(TraceLevelInfo, "Exited InteractionDetector::AllocateSubsample");
+   return pRet;
+}
+
+// replaces any earlier bag with cSamplesInBag samples drawn from all of our samples.  The bag is a compact copy, so scoring a 10% bag only 
+// reads 10% of the bins and residuals
+bool InteractionDetector::SetSampling(
+   const size_t cSamplesInBag,
+   const bool bWithReplacement,
+   RandomStream * const pRandomStream
+) {
+   EBM_ASSERT(1 <= m_dataSet.GetCountSamples());
+
+   ClearSampling();
+   if(m_dataSetInBag.InitializeSubsample(
+      &m_dataSet,
+      m_aFeatures,
+      GetVectorLength(m_runtimeLearningTypeOrCountTargetClasses),
+      cSamplesInBag,
+      bWithReplacement,
+      pRandomStream
+   )) {
+      LOG_0(TraceLevelWarning, "WARNING InteractionDetector::SetSampling m_dataSetInBag.InitializeSubsample");
+      return true;
+   }
+   m_bSampled = true;
+   return false;
+}
+
+void InteractionDetector::ClearSampling() {
+   m_dataSetInBag.Destruct();
+   m_dataSetInBag.InitializeZero();
+   m_bSampled = false;
+}
+
 // a*PredictorScores = logOdds for binary classification
 // a*PredictorScores = logWeights for multiclass classification
 // a*PredictorScores = predictedValue for regression
@@ -332,6 +506,134 @@ EBM_NATIVE_IMPORT_EXPORT_BODY InteractionDetectorHandle EBM_NATIVE_CALLING_CONVE
    return interactionDetectorHandle;
 }
 
+// binnedData is optional.  If it is nullptr we use the features and binned data of the booster's training set and ignore countFeatures, 
+// featuresCategorical and featuresBinCount.  Otherwise binnedData holds the booster's training samples, in the same order, binned into 
+// the features that countFeatures, featuresCategorical and featuresBinCount describe
+EBM_NATIVE_IMPORT_EXPORT_BODY InteractionDetectorHandle EBM_NATIVE_CALLING_CONVENTION CreateInteractionDetectorFromBooster(
+   BoosterHandle boosterHandle,
+   BoolEbmType useBestModel,
+   IntEbmType countFeatures,
+   const BoolEbmType * featuresCategorical,
+   const IntEbmType * featuresBinCount,
+   const IntEbmType * binnedData,
+   const FloatEbmType * optionalTempParams
+) {
+   LOG_N(TraceLevelInfo, "Entered CreateInteractionDetectorFromBooster: "
+      "boosterHandle=%p, "
+      "useBestModel=%" BoolEbmTypePrintf ", "
+      "countFeatures=%" IntEbmTypePrintf ", "
+      "featuresCategorical=%p, "
+      "featuresBinCount=%p, "
+      "binnedData=%p, "
+      "optionalTempParams=%p"
+      ,
+      static_cast<void *>(boosterHandle),
+      useBestModel,
+      countFeatures,
+      static_cast<const void *>(featuresCategorical),
+      static_cast<const void *>(featuresBinCount),
+      static_cast<const void *>(binnedData),
+      static_cast<const void *>(optionalTempParams)
+   );
+   Booster * const pBooster = reinterpret_cast<Booster *>(boosterHandle);
+   if(nullptr == pBooster) {
+      LOG_0(TraceLevelError, "ERROR CreateInteractionDetectorFromBooster boosterHandle cannot be nullptr");
+      return nullptr;
+   }
+   if(EBM_FALSE != useBestModel && EBM_TRUE != useBestModel) {
+      LOG_0(TraceLevelWarning, "WARNING CreateInteractionDetectorFromBooster useBestModel should either be EBM_TRUE or EBM_FALSE");
+   }
+   size_t cFeatures = pBooster->GetCountFeatures();
+   if(nullptr != binnedData) {
+      if(countFeatures < 0) {
+         LOG_0(TraceLevelError, "ERROR CreateInteractionDetectorFromBooster countFeatures must be positive");
+         return nullptr;
+      }
+      if(0 != countFeatures && nullptr == featuresCategorical) {
+         LOG_0(TraceLevelError, "ERROR CreateInteractionDetectorFromBooster featuresCategorical cannot be nullptr if 0 < countFeatures");
+         return nullptr;
+      }
+      if(0 != countFeatures && nullptr == featuresBinCount) {
+         LOG_0(TraceLevelError, "ERROR CreateInteractionDetectorFromBooster featuresBinCount cannot be nullptr if 0 < countFeatures");
+         return nullptr;
+      }
+      if(!IsNumberConvertable<size_t>(countFeatures)) {
+         LOG_0(TraceLevelError, "ERROR CreateInteractionDetectorFromBooster !IsNumberConvertable<size_t>(countFeatures)");
+         return nullptr;
+      }
+      cFeatures = static_cast<size_t>(countFeatures);
+   }
+   const InteractionDetectorHandle interactionDetectorHandle = reinterpret_cast<InteractionDetectorHandle>(
+      InteractionDetector::AllocateFromBooster(
+         pBooster, 
+         EBM_FALSE != useBestModel, 
+         cFeatures, 
+         featuresCategorical, 
+         featuresBinCount, 
+         binnedData, 
+         optionalTempParams
+      )
+   );
+   LOG_N(TraceLevelInfo, "Exited CreateInteractionDetectorFromBooster %p", static_cast<void *>(interactionDetectorHandle));
+   return interactionDetectorHandle;
+}
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION SetInteractionSampling(
+   InteractionDetectorHandle interactionDetectorHandle,
+   SeedEbmType randomSeed,
+   FloatEbmType sampleFraction,
+   BoolEbmType isBootstrap
+) {
+   LOG_N(TraceLevelInfo, "Entered SetInteractionSampling: "
+      "interactionDetectorHandle=%p, "
+      "randomSeed=%" SeedEbmTypePrintf ", "
+      "sampleFraction=%" FloatEbmTypePrintf ", "
+      "isBootstrap=%" BoolEbmTypePrintf
+      ,
+      static_cast<void *>(interactionDetectorHandle),
+      randomSeed,
+      sampleFraction,
+      isBootstrap
+   );
+
+   InteractionDetector * const pInteractionDetector = reinterpret_cast<InteractionDetector *>(interactionDetectorHandle);
+   if(nullptr == pInteractionDetector) {
+      LOG_0(TraceLevelError, "ERROR SetInteractionSampling interactionDetectorHandle cannot be nullptr");
+      return IntEbmType { 1 };
+   }
+   // written this way so that NaN is rejected too
+   if(!(FloatEbmType { 0 } < sampleFraction && sampleFraction <= FloatEbmType { 1 })) {
+      LOG_0(TraceLevelError, "ERROR SetInteractionSampling sampleFraction must be greater than 0 and less than or equal to 1");
+      return IntEbmType { 1 };
+   }
+   if(EBM_FALSE != isBootstrap && EBM_TRUE != isBootstrap) {
+      LOG_0(TraceLevelWarning, "WARNING SetInteractionSampling isBootstrap should either be EBM_TRUE or EBM_FALSE");
+   }
+   const bool bBootstrap = EBM_FALSE != isBootstrap;
+
+   // bags are always drawn from all the samples, not from an earlier bag
+   pInteractionDetector->ClearSampling();
+   const size_t cSamples = pInteractionDetector->GetDataSetByFeature()->GetCountSamples();
+
+   size_t cSamplesInBag = static_cast<size_t>(std::round(sampleFraction * static_cast<FloatEbmType>(cSamples)));
+   // round can't take us past cSamples since sampleFraction <= 1, but keep at least one sample so that the histograms aren't empty
+   cSamplesInBag = cSamples < cSamplesInBag ? cSamples : cSamplesInBag;
+   cSamplesInBag = cSamplesInBag < size_t { 1 } ? size_t { 1 } : cSamplesInBag;
+
+   // without bootstrap, a bag of every sample is the same as no sampling
+   if(size_t { 0 } != cSamples && (bBootstrap || cSamplesInBag != cSamples)) {
+      RandomStream randomStream;
+      randomStream.InitializeUnsigned(randomSeed, k_interactionSamplingRandomizationMix);
+      if(pInteractionDetector->SetSampling(cSamplesInBag, bBootstrap, &randomStream)) {
+         LOG_0(TraceLevelWarning, "WARNING SetInteractionSampling pInteractionDetector->SetSampling failed");
+         return IntEbmType { 1 };
+      }
+   }
+
+   LOG_0(TraceLevelInfo, "Exited SetInteractionSampling");
+   return IntEbmType { 0 };
+}
+
 EBM_NATIVE_IMPORT_EXPORT_BODY void EBM_NATIVE_CALLING_CONVENTION FreeInteractionDetector(
    InteractionDetectorHandle interactionDetectorHandle
 ) {
@@ -13,10 +13,21 @@
 #include "EbmInternal.h"
 #include "Logging.h" // EBM_ASSERT & LOG
 // feature includes
+#include "RandomStream.h"
 #include "FeatureAtomic.h"
 // dataset depends on features
 #include "DataSetInteraction.h"
 
+// the most pair histograms that CalculateInteractionScores fills from a single shared pass over the samples.  Each pair needs a pointer to its 
+// feature data and its histogram while we scan, so this bounds the stack space we use to hold them
+constexpr size_t k_cPairsSharedScanMax = 64;
+// we stop adding pairs to a shared pass once their combined histograms would exceed this many bytes.  Every sample scatters into all the 
+// histograms of the pass, so they need to stay resident in the L2 cache for the shared pass to beat scanning each pair separately
+constexpr size_t k_cBytesSharedScanHistogramsMax = 262144;
+// the tensor of a 3 way interaction grows with the cube of the bins, so we refuse to allocate one larger than this many bytes and 
+// score the group as 0 instead.  Callers that want triples scored should give us features with coarser bins
+constexpr size_t k_cBytesInteractionHistogramTriplesMax = 268435456;
+
 class InteractionDetector final {
    ptrdiff_t m_runtimeLearningTypeOrCountTargetClasses;
 
@@ -24,6 +35,9 @@ class InteractionDetector final {
    Feature * m_aFeatures;
 
    DataSetByFeature m_dataSet;
+   // the samples drawn by SetInteractionSampling, copied out of m_dataSet so that scoring only walks the samples in the bag
+   bool m_bSampled;
+   DataSetByFeature m_dataSetInBag;
 
    int m_cLogEnterMessages;
    int m_cLogExitMessages;
@@ -42,12 +56,14 @@ public:
       m_aFeatures = nullptr;
 
       m_dataSet.InitializeZero();
+      m_bSampled = false;
+      m_dataSetInBag.InitializeZero();
 
       m_cLogEnterMessages = 0;
       m_cLogExitMessages = 0;
    }
 
-   INLINE_ALWAYS ptrdiff_t GetRuntimeLearningTypeOrCountTargetClasses() {
+   INLINE_ALWAYS ptrdiff_t GetRuntimeLearningTypeOrCountTargetClasses() const {
       return m_runtimeLearningTypeOrCountTargetClasses;
    }
 
@@ -59,8 +75,9 @@ public:
       return &m_cLogExitMessages;
    }
 
+   // the samples that interaction scores are calculated on, which are only the samples in the bag while sampling is set
    INLINE_ALWAYS const DataSetByFeature * GetDataSetByFeature() const {
-      return &m_dataSet;
+      return m_bSampled ? &m_dataSetInBag : &m_dataSet;
    }
 
    INLINE_ALWAYS const Feature * GetFeatures() const {
@@ -71,6 +88,13 @@ public:
       return m_cFeatures;
    }
 
+   bool SetSampling(
+      const size_t cSamplesInBag,
+      const bool bWithReplacement,
+      RandomStream * const pRandomStream
+   );
+   void ClearSampling();
+
    static void Free(InteractionDetector * const pInteractionDetector);
    static InteractionDetector * Allocate(
       const ptrdiff_t runtimeLearningTypeOrCountTargetClasses,
@@ -84,6 +108,20 @@ public:
       const FloatEbmType * const aWeights,
       const FloatEbmType * const aPredictorScores
    );
+   static InteractionDetector * AllocateFromBooster(
+      Booster * const pBooster,
+      const bool bUseBestModel,
+      const size_t cFeatures,
+      const BoolEbmType * const aFeaturesCategorical,
+      const IntEbmType * const aFeaturesBinCount,
+      const IntEbmType * const aBinnedData,
+      const FloatEbmType * const optionalTempParams
+   );
+   static InteractionDetector * AllocateSubsample(
+      const InteractionDetector * const pInteractionDetectorOriginal,
+      const size_t cSamplesSubsample,
+      RandomStream * const pRandomStream
+   );
 };
 static_assert(std::is_standard_layout<InteractionDetector>::value,
    "We use the struct hack in several places, so disallow non-standard_layout types in general");
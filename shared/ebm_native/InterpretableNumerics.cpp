@@ -6,7 +6,8 @@
 
 #include <stddef.h> // size_t, ptrdiff_t
 #include <limits> // std::numeric_limits
-#include <string.h> // strchr, memmove
+#include <string.h> // strchr, memmove, memcpy
+#include <algorithm> // std::sort, std::nth_element
 
 #include "ebm_native.h"
 #include "EbmInternal.h"
@@ -832,6 +833,207 @@ extern size_t RemoveMissingValuesAndReplaceInfinities(
    return cSamples;
 }
 
+// IEEE 754 doubles order the same as their bits once we flip every bit of the negative numbers and only the sign bit of the positive 
+// ones.  -0.0 ends up just before +0.0, which is a legal order since they compare equal
+INLINE_ALWAYS static uint64_t FloatToRadixKey(const FloatEbmType val) noexcept {
+   uint64_t bits;
+   memcpy(&bits, &val, sizeof(bits));
+   const uint64_t signMask = uint64_t { 0 } - (bits >> 63);
+   return bits ^ (signMask | (uint64_t { 1 } << 63));
+}
+INLINE_ALWAYS static FloatEbmType RadixKeyToFloat(const uint64_t key) noexcept {
+   const uint64_t signMask = (key >> 63) - uint64_t { 1 };
+   const uint64_t bits = key ^ (signMask | (uint64_t { 1 } << 63));
+   FloatEbmType val;
+   memcpy(&val, &bits, sizeof(val));
+   return val;
+}
+
+// LSD radix sort over the bits of the values, one byte per pass, for the values left by RemoveMissingValuesAndReplaceInfinities, so there 
+// are no NaN or infinity values.  aScratch needs room for cSamples values.  A single counting pass builds the histograms for every byte, and 
+// we skip any pass where all the values share the same byte, which is common for the high bytes of narrow ranged or heavily duplicated 
+// features.  Use SortFeatureValues instead, which falls back to std::sort where that's faster.  This is separate for our benchmarks
+extern void RadixSortFeatureValues(
+   const size_t cSamples,
+   FloatEbmType * const aValues,
+   FloatEbmType * const aScratch
+) noexcept {
+   static_assert(sizeof(FloatEbmType) == sizeof(uint64_t), "our radix sort works on the bits of 64 bit IEEE 754 values");
+   constexpr size_t k_cRadixBits = 8;
+   constexpr size_t k_cRadixBuckets = size_t { 1 } << k_cRadixBits;
+   constexpr size_t k_cRadixPasses = sizeof(uint64_t) * 8 / k_cRadixBits;
+
+   EBM_ASSERT(nullptr != aValues);
+   EBM_ASSERT(nullptr != aScratch);
+   EBM_ASSERT(size_t { 1 } <= cSamples);
+
+   // we keep the keys in the FloatEbmType arrays, but only ever copy their bits with memcpy, so they're never used as floats
+   size_t aacBuckets[k_cRadixPasses][k_cRadixBuckets];
+   memset(aacBuckets, 0, sizeof(aacBuckets));
+   for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+      EBM_ASSERT(!std::isnan(aValues[iSample]));
+      EBM_ASSERT(!std::isinf(aValues[iSample]));
+      uint64_t key = FloatToRadixKey(aValues[iSample]);
+      memcpy(&aValues[iSample], &key, sizeof(key));
+      for(size_t iPass = 0; iPass < k_cRadixPasses; ++iPass) {
+         ++aacBuckets[iPass][static_cast<size_t>(key) & (k_cRadixBuckets - 1)];
+         key >>= k_cRadixBits;
+      }
+   }
+
+   FloatEbmType * aFrom = aValues;
+   FloatEbmType * aTo = aScratch;
+   for(size_t iPass = 0; iPass < k_cRadixPasses; ++iPass) {
+      size_t * const acBuckets = aacBuckets[iPass];
+      const size_t cShift = iPass * k_cRadixBits;
+
+      // every key has the same byte here, so this pass wouldn't move anything
+      uint64_t keyFirst;
+      memcpy(&keyFirst, &aFrom[0], sizeof(keyFirst));
+      if(cSamples == acBuckets[static_cast<size_t>(keyFirst >> cShift) & (k_cRadixBuckets - 1)]) {
+         continue;
+      }
+
+      // turn the counts into the index where each bucket starts
+      size_t iNext = 0;
+      for(size_t iBucket = 0; iBucket < k_cRadixBuckets; ++iBucket) {
+         const size_t cItems = acBuckets[iBucket];
+         acBuckets[iBucket] = iNext;
+         iNext += cItems;
+      }
+      EBM_ASSERT(cSamples == iNext);
+
+      for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+         uint64_t key;
+         memcpy(&key, &aFrom[iSample], sizeof(key));
+         const size_t iBucket = static_cast<size_t>(key >> cShift) & (k_cRadixBuckets - 1);
+         memcpy(&aTo[acBuckets[iBucket]], &key, sizeof(key));
+         ++acBuckets[iBucket];
+      }
+      FloatEbmType * const aSwap = aFrom;
+      aFrom = aTo;
+      aTo = aSwap;
+   }
+
+   for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+      uint64_t key;
+      memcpy(&key, &aFrom[iSample], sizeof(key));
+      aValues[iSample] = RadixKeyToFloat(key);
+   }
+}
+
+// Sorts the values left by RemoveMissingValuesAndReplaceInfinities.  With aScratch, which needs room for cSamples values, and at least 
+// k_cSamplesRadixSortMin samples we use RadixSortFeatureValues, otherwise we fall back to std::sort
+extern void SortFeatureValues(
+   const size_t cSamples,
+   FloatEbmType * const aValues,
+   FloatEbmType * const aScratch
+) noexcept {
+   EBM_ASSERT(nullptr != aValues);
+
+   if(nullptr == aScratch || cSamples < k_cSamplesRadixSortMin) {
+      std::sort(aValues, aValues + cSamples);
+      return;
+   }
+   RadixSortFeatureValues(cSamples, aValues, aScratch);
+}
+
+// MSD radix select over the same keys as RadixSortFeatureValues.  Returns the value that would be at index iNth if we sorted the values 
+// left by RemoveMissingValuesAndReplaceInfinities.  aScratch needs room for cSamples values.  Each pass histograms one digit of the remaining
+// candidates and keeps only the ones in the bucket holding iNth, so we never reorder aValues.  Use SelectFeatureValue instead, which falls 
+// back to std::nth_element where that's faster.  This is separate for our benchmarks
+extern FloatEbmType RadixSelectFeatureValue(
+   const size_t cSamples,
+   const FloatEbmType * const aValues,
+   size_t iNth,
+   FloatEbmType * const aScratch
+) noexcept {
+   static_assert(sizeof(FloatEbmType) == sizeof(uint64_t), "our radix select works on the bits of 64 bit IEEE 754 values");
+   // the top digit holds the sign and exponent, which separates most features into few buckets
+   constexpr size_t k_cRadixBits = 11;
+   constexpr size_t k_cRadixBuckets = size_t { 1 } << k_cRadixBits;
+
+   EBM_ASSERT(nullptr != aValues);
+   EBM_ASSERT(nullptr != aScratch);
+   EBM_ASSERT(iNth < cSamples);
+
+   size_t acBuckets[k_cRadixBuckets];
+   size_t cShift = sizeof(uint64_t) * 8 - k_cRadixBits;
+   size_t cCandidates = cSamples;
+   // the first pass reads the original values and every later pass reads the keys we kept in aScratch
+   bool bKeys = false;
+   while(true) {
+      memset(acBuckets, 0, sizeof(acBuckets));
+      for(size_t iCandidate = 0; iCandidate < cCandidates; ++iCandidate) {
+         uint64_t key;
+         if(bKeys) {
+            memcpy(&key, &aScratch[iCandidate], sizeof(key));
+         } else {
+            EBM_ASSERT(!std::isnan(aValues[iCandidate]));
+            EBM_ASSERT(!std::isinf(aValues[iCandidate]));
+            key = FloatToRadixKey(aValues[iCandidate]);
+         }
+         ++acBuckets[static_cast<size_t>(key >> cShift) & (k_cRadixBuckets - 1)];
+      }
+
+      size_t iBucketNth = 0;
+      while(acBuckets[iBucketNth] <= iNth) {
+         iNth -= acBuckets[iBucketNth];
+         ++iBucketNth;
+         EBM_ASSERT(iBucketNth < k_cRadixBuckets);
+      }
+      const size_t cKeep = acBuckets[iBucketNth];
+
+      // if every candidate is in the same bucket there is nothing to filter out, unless we still need to move them into aScratch
+      if(!bKeys || cKeep != cCandidates) {
+         // we write every candidate and only advance past the ones we keep, which avoids an unpredictable branch.  We never write
+         // past the candidate we're reading, so filtering aScratch in place is safe
+         size_t iKeep = 0;
+         for(size_t iCandidate = 0; iCandidate < cCandidates; ++iCandidate) {
+            uint64_t key;
+            if(bKeys) {
+               memcpy(&key, &aScratch[iCandidate], sizeof(key));
+            } else {
+               key = FloatToRadixKey(aValues[iCandidate]);
+            }
+            memcpy(&aScratch[iKeep], &key, sizeof(key));
+            iKeep += static_cast<size_t>((static_cast<size_t>(key >> cShift) & (k_cRadixBuckets - 1)) == iBucketNth);
+         }
+         EBM_ASSERT(cKeep == iKeep);
+         cCandidates = cKeep;
+         bKeys = true;
+      }
+
+      // once every bit has been through a digit the remaining candidates are all identical
+      if(size_t { 1 } == cCandidates || size_t { 0 } == cShift) {
+         uint64_t key;
+         memcpy(&key, &aScratch[0], sizeof(key));
+         return RadixKeyToFloat(key);
+      }
+      // the last digit overlaps bits we already matched, which is harmless since the candidates share them
+      cShift = cShift < k_cRadixBits ? size_t { 0 } : cShift - k_cRadixBits;
+   }
+}
+
+// Returns the value that would be at index iNth if we sorted the values left by RemoveMissingValuesAndReplaceInfinities.  With aScratch,
+// which needs room for cSamples values, and at least k_cSamplesRadixSelectMin samples we use RadixSelectFeatureValue, which never reorders
+// aValues.  Otherwise we fall back to std::nth_element, which reorders aValues
+extern FloatEbmType SelectFeatureValue(
+   const size_t cSamples,
+   FloatEbmType * const aValues,
+   const size_t iNth,
+   FloatEbmType * const aScratch
+) noexcept {
+   EBM_ASSERT(nullptr != aValues);
+   EBM_ASSERT(iNth < cSamples);
+
+   if(nullptr == aScratch || cSamples < k_cSamplesRadixSelectMin) {
+      std::nth_element(aValues, aValues + iNth, aValues + cSamples);
+      return aValues[iNth];
+   }
+   return RadixSelectFeatureValue(cSamples, aValues, iNth, aScratch);
+}
+
 EBM_NATIVE_IMPORT_EXPORT_BODY void EBM_NATIVE_CALLING_CONVENTION SuggestGraphBounds(
    IntEbmType countCuts,
    FloatEbmType lowestCut,
@@ -7,6 +7,7 @@
 #include <assert.h>
 #include <stdio.h>
 #include <stdarg.h>
+#include <mutex>
 
 #include "ebm_native.h" // FloatEbmType
 #include "EbmInternal.h"
@@ -27,6 +28,19 @@ constexpr static char g_pLoggingParameterError[] = "Error in vsnprintf parameter
 TraceEbmType g_traceLevel = TraceLevelOff;
 static LOG_MESSAGE_FUNCTION g_pLogMessageFunc = nullptr;
 
+// we LOG from the workers of ExecuteParallelWork, but our caller's logging callback isn't guaranteed to be thread safe, so we only allow 
+// one thread at a time into the callback
+static std::mutex g_logMutex;
+
+static void CallLogMessageFunction(const TraceEbmType traceLevel, const char * const message) {
+   try {
+      std::lock_guard<std::mutex> lock(g_logMutex);
+      (*g_pLogMessageFunc)(traceLevel, message);
+   } catch(...) {
+      // std::mutex::lock throws std::system_error if the OS fails us.  Losing a log message is better than crashing
+   }
+}
+
 const char g_traceOffString[] = "OFF";
 const char g_traceErrorString[] = "ERROR";
 const char g_traceWarningString[] = "WARNING";
@@ -93,10 +107,10 @@ extern void InteralLogWithArguments(const TraceEbmType traceLevel, const char *
    // DETAILS: https://stackoverflow.com/questions/58672959/why-does-clang-tidy-say-vsnprintf-has-an-uninitialized-va-list-argument
    StopClangAnalysis();
    if(vsnprintf(messageSpace, sizeof(messageSpace) / sizeof(messageSpace[0]), pOriginalMessage, args) < 0) {
-      (*g_pLogMessageFunc)(traceLevel, g_pLoggingParameterError);
+      CallLogMessageFunction(traceLevel, g_pLoggingParameterError);
    } else {
       // if messageSpace overflows, we clip the message, but it's still legal
-      (*g_pLogMessageFunc)(traceLevel, messageSpace);
+      CallLogMessageFunction(traceLevel, messageSpace);
    }
    va_end(args);
 }
@@ -104,7 +118,7 @@ WARNING_POP
 
 extern void InteralLogWithoutArguments(const TraceEbmType traceLevel, const char * const pOriginalMessage) {
    assert(nullptr != g_pLogMessageFunc);
-   (*g_pLogMessageFunc)(traceLevel, pOriginalMessage);
+   CallLogMessageFunction(traceLevel, pOriginalMessage);
 }
 
 extern void LogAssertFailure(
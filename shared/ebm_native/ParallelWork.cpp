@@ -0,0 +1,68 @@
+// Copyright (c) 2018 Microsoft Corporation
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#include "PrecompiledHeader.h"
+
+#include <stddef.h> // size_t, ptrdiff_t
+#include <thread>
+
+#include "EbmInternal.h" // INLINE_ALWAYS
+#include "Logging.h" // EBM_ASSERT & LOG
+#include "ParallelWork.h"
+
+extern size_t GetCountWorkersMax() {
+   // hardware_concurrency is allowed to return 0 if the value is not computable
+   const unsigned int cHardwareThreads = std::thread::hardware_concurrency();
+   if(cHardwareThreads <= 1) {
+      return size_t { 1 };
+   }
+   const size_t cWorkers = static_cast<size_t>(cHardwareThreads);
+   return k_cWorkersMax < cWorkers ? k_cWorkersMax : cWorkers;
+}
+
+extern void ExecuteParallelWork(const size_t cWorkers, const ParallelWorkFunction pFunction, void * const pContext) {
+   EBM_ASSERT(1 <= cWorkers);
+   EBM_ASSERT(cWorkers <= k_cWorkersMax);
+   EBM_ASSERT(nullptr != pFunction);
+
+   if(size_t { 1 } == cWorkers) {
+      (*pFunction)(pContext, 0);
+      return;
+   }
+
+   // default constructing a std::thread doesn't launch anything and can't throw
+   std::thread aThreads[k_cWorkersMax];
+   bool abLaunched[k_cWorkersMax];
+
+   size_t iWorker = 1;
+   do {
+      bool bLaunched = false;
+      try {
+         aThreads[iWorker] = std::thread(pFunction, pContext, iWorker);
+         bLaunched = true;
+      } catch(...) {
+         // std::thread throws std::system_error if the OS can't give us a thread.  We'll do the work ourselves below
+      }
+      abLaunched[iWorker] = bLaunched;
+      ++iWorker;
+   } while(cWorkers != iWorker);
+
+   (*pFunction)(pContext, 0);
+
+   iWorker = 1;
+   do {
+      if(abLaunched[iWorker]) {
+         try {
+            aThreads[iWorker].join();
+         } catch(...) {
+            // join only throws if the thread isn't joinable or if we would deadlock, neither of which is possible here
+            EBM_ASSERT(false);
+         }
+      } else {
+         LOG_0(TraceLevelWarning, "WARNING ExecuteParallelWork could not launch a thread, so running the work on the calling thread");
+         (*pFunction)(pContext, iWorker);
+      }
+      ++iWorker;
+   } while(cWorkers != iWorker);
+}
@@ -0,0 +1,29 @@
+// Copyright (c) 2018 Microsoft Corporation
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#ifndef PARALLEL_WORK_H
+#define PARALLEL_WORK_H
+
+#include <stddef.h> // size_t, ptrdiff_t
+
+#include "EbmInternal.h" // INLINE_ALWAYS
+
+// We never launch more than this many workers for a single piece of work.  Callers can keep per-worker state in
+// fixed size arrays on the stack because of this limit.
+constexpr size_t k_cWorkersMax = 64;
+
+// iWorker is in the range [0, cWorkers).  Worker 0 always runs on the calling thread.  Worker functions can use LOG_0
+// and LOG_N since calls into the logging callback are serialized, but they must not use LOG_COUNTED_0 or LOG_COUNTED_N
+// since the counters are not atomic, and they must not throw exceptions.
+typedef void (* ParallelWorkFunction)(void * const pContext, const size_t iWorker);
+
+// returns a number in the range [1, k_cWorkersMax]
+extern size_t GetCountWorkersMax();
+
+// Runs pFunction for every iWorker in [0, cWorkers) and returns after all of them have completed.  If the operating
+// system refuses to give us a thread we run that worker's function on the calling thread instead, so this function
+// cannot fail and the work done is identical regardless of how many threads we actually received.
+extern void ExecuteParallelWork(const size_t cWorkers, const ParallelWorkFunction pFunction, void * const pContext);
+
+#endif // PARALLEL_WORK_H
@@ -0,0 +1,447 @@
+// Copyright (c) 2018 Microsoft Corporation
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#include "PrecompiledHeader.h"
+
+#include <stdlib.h> // free
+#include <stddef.h> // size_t, ptrdiff_t
+#include <string.h> // memcpy
+#include <cmath> // std::isnan
+#include <limits> // std::numeric_limits
+#include <algorithm> // std::sort
+
+#include "ebm_native.h"
+#include "EbmInternal.h" // INLINE_ALWAYS
+#include "Logging.h" // EBM_ASSERT & LOG
+#include "RandomStream.h"
+
+#include "QuantileSketch.h"
+
+void QuantileSketch::Free(QuantileSketch * const pQuantileSketch) {
+   LOG_0(TraceLevelInfo, "Entered QuantileSketch::Free");
+
+   if(nullptr != pQuantileSketch) {
+      for(size_t iLevel = 0; iLevel < k_cQuantileSketchLevelsMax; ++iLevel) {
+         free(pQuantileSketch->m_aLevels[iLevel].m_aValues);
+      }
+      free(pQuantileSketch);
+   }
+
+   LOG_0(TraceLevelInfo, "Exited QuantileSketch::Free");
+}
+
+QuantileSketch * QuantileSketch::Allocate(const SeedEbmType randomSeed, const size_t cItemsPerLevelMax) {
+   LOG_0(TraceLevelInfo, "Entered QuantileSketch::Allocate");
+
+   EBM_ASSERT(k_cQuantileSketchItemsPerLevelMin <= cItemsPerLevelMax);
+
+   QuantileSketch * const pNew = EbmMalloc<QuantileSketch>();
+   if(LIKELY(nullptr != pNew)) {
+      pNew->m_cItemsPerLevelMax = cItemsPerLevelMax;
+
+      pNew->m_cNonMissing = 0;
+      pNew->m_cMissing = 0;
+      pNew->m_cNegativeInfinity = 0;
+      pNew->m_cPositiveInfinity = 0;
+      pNew->m_minNonInfinityValue = std::numeric_limits<FloatEbmType>::max();
+      pNew->m_maxNonInfinityValue = std::numeric_limits<FloatEbmType>::lowest();
+
+      pNew->m_randomStream.InitializeUnsigned(randomSeed, k_quantileSketchRandomizationMix);
+
+      pNew->m_cLevels = 1;
+      for(size_t iLevel = 0; iLevel < k_cQuantileSketchLevelsMax; ++iLevel) {
+         pNew->m_aLevels[iLevel].m_aValues = nullptr;
+         pNew->m_aLevels[iLevel].m_cValues = 0;
+         pNew->m_aLevels[iLevel].m_cCapacity = 0;
+      }
+
+      // the bottom level is where AddValues puts new values, and it never needs to hold more than cItemsPerLevelMax
+      FloatEbmType * const aValues = EbmMalloc<FloatEbmType>(cItemsPerLevelMax);
+      if(UNLIKELY(nullptr == aValues)) {
+         LOG_0(TraceLevelWarning, "WARNING QuantileSketch::Allocate nullptr == aValues");
+         free(pNew);
+         return nullptr;
+      }
+      pNew->m_aLevels[0].m_aValues = aValues;
+      pNew->m_aLevels[0].m_cCapacity = cItemsPerLevelMax;
+   }
+
+   LOG_0(TraceLevelInfo, "Exited QuantileSketch::Allocate");
+
+   return pNew;
+}
+
+static bool EnsureLevelCapacity(QuantileSketchLevel * const pLevel, const size_t cValuesRequired) {
+   if(pLevel->m_cCapacity < cValuesRequired) {
+      // grow geometrically so that merging many sketches into one doesn't reallocate on every merge
+      const size_t cCapacityDoubled = pLevel->m_cCapacity << 1;
+      const size_t cCapacity = cValuesRequired < cCapacityDoubled ? cCapacityDoubled : cValuesRequired;
+      FloatEbmType * const aValues = EbmMalloc<FloatEbmType>(cCapacity);
+      if(UNLIKELY(nullptr == aValues)) {
+         LOG_0(TraceLevelWarning, "WARNING EnsureLevelCapacity nullptr == aValues");
+         return true;
+      }
+      if(size_t { 0 } != pLevel->m_cValues) {
+         memcpy(aValues, pLevel->m_aValues, sizeof(*aValues) * pLevel->m_cValues);
+      }
+      free(pLevel->m_aValues);
+      pLevel->m_aValues = aValues;
+      pLevel->m_cCapacity = cCapacity;
+   }
+   return false;
+}
+
+size_t QuantileSketch::GetLevelCapacity(const size_t iLevel) const {
+   EBM_ASSERT(iLevel < m_cLevels);
+
+   // the top level gets the full cItemsPerLevelMax and each level below it gets 2/3 of the level above.  The lower levels hold
+   // values with less weight, so shrinking them costs us little accuracy and keeps the total memory bounded by a geometric series
+   FloatEbmType capacity = static_cast<FloatEbmType>(m_cItemsPerLevelMax);
+   for(size_t iLevelAbove = iLevel + size_t { 1 }; iLevelAbove < m_cLevels; ++iLevelAbove) {
+      capacity *= FloatEbmType { 2 } / FloatEbmType { 3 };
+      if(capacity < static_cast<FloatEbmType>(k_cQuantileSketchItemsPerLevelMin)) {
+         return k_cQuantileSketchItemsPerLevelMin;
+      }
+   }
+   return static_cast<size_t>(capacity);
+}
+
+bool QuantileSketch::CompactLevel(const size_t iLevel) {
+   EBM_ASSERT(iLevel < m_cLevels);
+
+   const size_t iLevelUp = iLevel + size_t { 1 };
+   if(UNLIKELY(k_cQuantileSketchLevelsMax <= iLevelUp)) {
+      // we'd need more than 2^64 samples to get here
+      LOG_0(TraceLevelWarning, "WARNING QuantileSketch::CompactLevel k_cQuantileSketchLevelsMax <= iLevelUp");
+      return true;
+   }
+   if(m_cLevels == iLevelUp) {
+      m_cLevels = iLevelUp + size_t { 1 };
+   }
+
+   QuantileSketchLevel * const pLevel = &m_aLevels[iLevel];
+   QuantileSketchLevel * const pLevelUp = &m_aLevels[iLevelUp];
+
+   FloatEbmType * const aValues = pLevel->m_aValues;
+   const size_t cValues = pLevel->m_cValues;
+   EBM_ASSERT(size_t { 2 } <= cValues);
+
+   std::sort(aValues, aValues + cValues);
+
+   // we can only promote an even number of values without changing the total weight, so if we have an odd count
+   // then the lowest value stays behind at this level
+   const size_t iFirst = cValues & size_t { 1 };
+   const size_t cPromoted = (cValues - iFirst) >> 1;
+
+   if(EnsureLevelCapacity(pLevelUp, pLevelUp->m_cValues + cPromoted)) {
+      LOG_0(TraceLevelWarning, "WARNING QuantileSketch::CompactLevel EnsureLevelCapacity(pLevelUp, pLevelUp->m_cValues + cPromoted)");
+      return true;
+   }
+
+   const FloatEbmType * pValue = aValues + iFirst + (m_randomStream.Next() ? size_t { 1 } : size_t { 0 });
+   FloatEbmType * pValueUp = pLevelUp->m_aValues + pLevelUp->m_cValues;
+   const FloatEbmType * const pValueUpEnd = pValueUp + cPromoted;
+   do {
+      *pValueUp = *pValue;
+      pValue += 2;
+      ++pValueUp;
+   } while(pValueUpEnd != pValueUp);
+
+   pLevelUp->m_cValues += cPromoted;
+   pLevel->m_cValues = iFirst;
+   return false;
+}
+
+bool QuantileSketch::Compress() {
+   // m_cLevels can grow as we compact, which we want since the level we just promoted into might now be full too
+   for(size_t iLevel = 0; iLevel < m_cLevels; ++iLevel) {
+      if(GetLevelCapacity(iLevel) <= m_aLevels[iLevel].m_cValues) {
+         if(CompactLevel(iLevel)) {
+            return true;
+         }
+      }
+   }
+   return false;
+}
+
+bool QuantileSketch::AddValues(const size_t cSamples, const FloatEbmType * const aValues) {
+   EBM_ASSERT(0 == cSamples || nullptr != aValues);
+
+   const FloatEbmType * pValue = aValues;
+   const FloatEbmType * const pValuesEnd = aValues + cSamples;
+   size_t cCapacityBottom = GetLevelCapacity(0);
+   // Merge can leave more values at the bottom than we'd keep from AddValues, but never more than it has room for
+   EBM_ASSERT(cCapacityBottom <= m_aLevels[0].m_cCapacity);
+   while(pValuesEnd != pValue) {
+      const FloatEbmType val = *pValue;
+      ++pValue;
+      if(UNLIKELY(std::isnan(val))) {
+         ++m_cMissing;
+         continue;
+      }
+      if(UNLIKELY(std::numeric_limits<FloatEbmType>::infinity() == val)) {
+         ++m_cPositiveInfinity;
+      } else if(UNLIKELY(-std::numeric_limits<FloatEbmType>::infinity() == val)) {
+         ++m_cNegativeInfinity;
+      } else {
+         m_maxNonInfinityValue = UNPREDICTABLE(m_maxNonInfinityValue < val) ? val : m_maxNonInfinityValue;
+         m_minNonInfinityValue = UNPREDICTABLE(val < m_minNonInfinityValue) ? val : m_minNonInfinityValue;
+      }
+      ++m_cNonMissing;
+
+      QuantileSketchLevel * const pLevelBottom = &m_aLevels[0];
+      pLevelBottom->m_aValues[pLevelBottom->m_cValues] = val;
+      ++pLevelBottom->m_cValues;
+      if(UNLIKELY(cCapacityBottom <= pLevelBottom->m_cValues)) {
+         if(Compress()) {
+            return true;
+         }
+         // adding levels shrinks the capacity of the lower ones
+         cCapacityBottom = GetLevelCapacity(0);
+      }
+   }
+   return false;
+}
+
+bool QuantileSketch::Merge(const QuantileSketch * const pOther) {
+   EBM_ASSERT(nullptr != pOther);
+   EBM_ASSERT(this != pOther);
+
+   m_cNonMissing += pOther->m_cNonMissing;
+   m_cMissing += pOther->m_cMissing;
+   m_cNegativeInfinity += pOther->m_cNegativeInfinity;
+   m_cPositiveInfinity += pOther->m_cPositiveInfinity;
+   m_minNonInfinityValue = pOther->m_minNonInfinityValue < m_minNonInfinityValue ? pOther->m_minNonInfinityValue : m_minNonInfinityValue;
+   m_maxNonInfinityValue = m_maxNonInfinityValue < pOther->m_maxNonInfinityValue ? pOther->m_maxNonInfinityValue : m_maxNonInfinityValue;
+
+   if(m_cLevels < pOther->m_cLevels) {
+      m_cLevels = pOther->m_cLevels;
+   }
+   for(size_t iLevel = 0; iLevel < pOther->m_cLevels; ++iLevel) {
+      const QuantileSketchLevel * const pLevelOther = &pOther->m_aLevels[iLevel];
+      const size_t cValuesOther = pLevelOther->m_cValues;
+      if(size_t { 0 } != cValuesOther) {
+         QuantileSketchLevel * const pLevel = &m_aLevels[iLevel];
+         if(EnsureLevelCapacity(pLevel, pLevel->m_cValues + cValuesOther)) {
+            LOG_0(TraceLevelWarning, "WARNING QuantileSketch::Merge EnsureLevelCapacity(pLevel, pLevel->m_cValues + cValuesOther)");
+            return true;
+         }
+         memcpy(pLevel->m_aValues + pLevel->m_cValues, pLevelOther->m_aValues, sizeof(*pLevel->m_aValues) * cValuesOther);
+         pLevel->m_cValues += cValuesOther;
+      }
+   }
+   return Compress();
+}
+
+struct WeightedValue final {
+   FloatEbmType m_value;
+   size_t m_weight;
+};
+static_assert(std::is_standard_layout<WeightedValue>::value,
+   "We use the struct hack in several places, so disallow non-standard_layout types in general");
+static_assert(std::is_trivial<WeightedValue>::value,
+   "We use memcpy in several places, so disallow non-trivial types in general");
+static_assert(std::is_pod<WeightedValue>::value,
+   "We use a lot of C constructs, so disallow non-POD types in general");
+
+class CompareWeightedValue final {
+public:
+   INLINE_ALWAYS bool operator() (const WeightedValue & lhs, const WeightedValue & rhs) const noexcept {
+      return lhs.m_value < rhs.m_value;
+   }
+};
+
+bool QuantileSketch::GetRepresentativeValues(const size_t cValues, FloatEbmType * const aValuesOut) const {
+   EBM_ASSERT(size_t { 1 } <= cValues);
+   EBM_ASSERT(cValues <= m_cNonMissing);
+   EBM_ASSERT(nullptr != aValuesOut);
+
+   size_t cRetained = 0;
+   for(size_t iLevel = 0; iLevel < m_cLevels; ++iLevel) {
+      cRetained += m_aLevels[iLevel].m_cValues;
+   }
+   EBM_ASSERT(size_t { 1 } <= cRetained);
+
+   WeightedValue * const aWeightedValues = EbmMalloc<WeightedValue>(cRetained);
+   if(UNLIKELY(nullptr == aWeightedValues)) {
+      LOG_0(TraceLevelWarning, "WARNING QuantileSketch::GetRepresentativeValues nullptr == aWeightedValues");
+      return true;
+   }
+   WeightedValue * pWeightedValue = aWeightedValues;
+   for(size_t iLevel = 0; iLevel < m_cLevels; ++iLevel) {
+      const size_t weight = size_t { 1 } << iLevel;
+      const FloatEbmType * pValue = m_aLevels[iLevel].m_aValues;
+      const FloatEbmType * const pValuesEnd = pValue + m_aLevels[iLevel].m_cValues;
+      for(; pValuesEnd != pValue; ++pValue) {
+         pWeightedValue->m_value = *pValue;
+         pWeightedValue->m_weight = weight;
+         ++pWeightedValue;
+      }
+   }
+   std::sort(aWeightedValues, aWeightedValues + cRetained, CompareWeightedValue());
+
+   // take the value at the middle rank of each of cValues equal slices of the samples.  Compaction conserves weight, so the weights
+   // add up to exactly m_cNonMissing and when nothing has been compacted yet this just copies the sorted values
+   const FloatEbmType cNonMissing = static_cast<FloatEbmType>(m_cNonMissing);
+   const FloatEbmType cValuesFloat = static_cast<FloatEbmType>(cValues);
+   const WeightedValue * pWeightedValueCur = aWeightedValues;
+   const WeightedValue * const pWeightedValueLast = aWeightedValues + cRetained - size_t { 1 };
+   size_t weightBefore = 0;
+   for(size_t iValue = 0; iValue < cValues; ++iValue) {
+      const FloatEbmType rankFloat = (static_cast<FloatEbmType>(iValue) + FloatEbmType { 0.5 }) * cNonMissing / cValuesFloat;
+      size_t rank = static_cast<size_t>(rankFloat);
+      rank = m_cNonMissing <= rank ? m_cNonMissing - size_t { 1 } : rank;
+      while(pWeightedValueLast != pWeightedValueCur && weightBefore + pWeightedValueCur->m_weight <= rank) {
+         weightBefore += pWeightedValueCur->m_weight;
+         ++pWeightedValueCur;
+      }
+      aValuesOut[iValue] = pWeightedValueCur->m_value;
+   }
+
+   // the extremes are known exactly, which matters for the edge cuts and humanization
+   aValuesOut[0] = GetLowestValue();
+   aValuesOut[cValues - size_t { 1 }] = GetHighestValue();
+
+   free(aWeightedValues);
+   return false;
+}
+
+// we don't care if an extra log message is outputted due to the non-atomic nature of the decrement to this value
+static int g_cLogEnterAddToQuantileSketchParametersMessages = 25;
+static int g_cLogExitAddToQuantileSketchParametersMessages = 25;
+
+EBM_NATIVE_IMPORT_EXPORT_BODY QuantileSketchHandle EBM_NATIVE_CALLING_CONVENTION CreateQuantileSketch(
+   SeedEbmType randomSeed,
+   IntEbmType countItemsPerLevelMax
+) {
+   LOG_N(TraceLevelInfo, "Entered CreateQuantileSketch: "
+      "randomSeed=%" SeedEbmTypePrintf ", "
+      "countItemsPerLevelMax=%" IntEbmTypePrintf
+      ,
+      randomSeed,
+      countItemsPerLevelMax
+   );
+
+   size_t cItemsPerLevelMax = k_cQuantileSketchItemsPerLevelDefault;
+   if(IntEbmType { 0 } != countItemsPerLevelMax) {
+      if(countItemsPerLevelMax < IntEbmType { 0 }) {
+         LOG_0(TraceLevelError, "ERROR CreateQuantileSketch countItemsPerLevelMax cannot be negative");
+         return nullptr;
+      }
+      if(!IsNumberConvertable<size_t>(countItemsPerLevelMax)) {
+         LOG_0(TraceLevelWarning, "WARNING CreateQuantileSketch !IsNumberConvertable<size_t>(countItemsPerLevelMax)");
+         return nullptr;
+      }
+      cItemsPerLevelMax = static_cast<size_t>(countItemsPerLevelMax);
+      if(cItemsPerLevelMax < k_cQuantileSketchItemsPerLevelMin) {
+         LOG_0(TraceLevelWarning, "WARNING CreateQuantileSketch countItemsPerLevelMax is too small.  Increasing it to the minimum");
+         cItemsPerLevelMax = k_cQuantileSketchItemsPerLevelMin;
+      }
+   }
+
+   QuantileSketch * const pQuantileSketch = QuantileSketch::Allocate(randomSeed, cItemsPerLevelMax);
+   if(UNLIKELY(nullptr == pQuantileSketch)) {
+      LOG_0(TraceLevelWarning, "WARNING CreateQuantileSketch nullptr == pQuantileSketch");
+      return nullptr;
+   }
+
+   LOG_N(TraceLevelInfo, "Exited CreateQuantileSketch %p", static_cast<void *>(pQuantileSketch));
+   return reinterpret_cast<QuantileSketchHandle>(pQuantileSketch);
+}
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION AddToQuantileSketch(
+   QuantileSketchHandle quantileSketchHandle,
+   IntEbmType countSamples,
+   const FloatEbmType * featureValues
+) {
+   LOG_COUNTED_N(
+      &g_cLogEnterAddToQuantileSketchParametersMessages,
+      TraceLevelInfo,
+      TraceLevelVerbose,
+      "Entered AddToQuantileSketch: "
+      "quantileSketchHandle=%p, "
+      "countSamples=%" IntEbmTypePrintf ", "
+      "featureValues=%p"
+      ,
+      static_cast<void *>(quantileSketchHandle),
+      countSamples,
+      static_cast<const void *>(featureValues)
+   );
+
+   QuantileSketch * const pQuantileSketch = reinterpret_cast<QuantileSketch *>(quantileSketchHandle);
+   if(nullptr == pQuantileSketch) {
+      LOG_0(TraceLevelError, "ERROR AddToQuantileSketch quantileSketchHandle cannot be nullptr");
+      return IntEbmType { 1 };
+   }
+   if(countSamples <= IntEbmType { 0 }) {
+      if(countSamples < IntEbmType { 0 }) {
+         LOG_0(TraceLevelError, "ERROR AddToQuantileSketch countSamples cannot be negative");
+         return IntEbmType { 1 };
+      }
+      return IntEbmType { 0 };
+   }
+   if(!IsNumberConvertable<size_t>(countSamples)) {
+      LOG_0(TraceLevelWarning, "WARNING AddToQuantileSketch !IsNumberConvertable<size_t>(countSamples)");
+      return IntEbmType { 1 };
+   }
+   if(nullptr == featureValues) {
+      LOG_0(TraceLevelError, "ERROR AddToQuantileSketch featureValues cannot be nullptr");
+      return IntEbmType { 1 };
+   }
+
+   if(pQuantileSketch->AddValues(static_cast<size_t>(countSamples), featureValues)) {
+      LOG_0(TraceLevelWarning, "WARNING AddToQuantileSketch pQuantileSketch->AddValues failed");
+      return IntEbmType { 1 };
+   }
+
+   LOG_COUNTED_0(&g_cLogExitAddToQuantileSketchParametersMessages, TraceLevelInfo, TraceLevelVerbose, "Exited AddToQuantileSketch");
+   return IntEbmType { 0 };
+}
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION MergeQuantileSketch(
+   QuantileSketchHandle quantileSketchHandleInto,
+   QuantileSketchHandle quantileSketchHandleFrom
+) {
+   LOG_N(TraceLevelInfo, "Entered MergeQuantileSketch: "
+      "quantileSketchHandleInto=%p, "
+      "quantileSketchHandleFrom=%p"
+      ,
+      static_cast<void *>(quantileSketchHandleInto),
+      static_cast<void *>(quantileSketchHandleFrom)
+   );
+
+   QuantileSketch * const pQuantileSketchInto = reinterpret_cast<QuantileSketch *>(quantileSketchHandleInto);
+   if(nullptr == pQuantileSketchInto) {
+      LOG_0(TraceLevelError, "ERROR MergeQuantileSketch quantileSketchHandleInto cannot be nullptr");
+      return IntEbmType { 1 };
+   }
+   const QuantileSketch * const pQuantileSketchFrom = reinterpret_cast<const QuantileSketch *>(quantileSketchHandleFrom);
+   if(nullptr == pQuantileSketchFrom) {
+      LOG_0(TraceLevelError, "ERROR MergeQuantileSketch quantileSketchHandleFrom cannot be nullptr");
+      return IntEbmType { 1 };
+   }
+   if(pQuantileSketchInto == pQuantileSketchFrom) {
+      LOG_0(TraceLevelError, "ERROR MergeQuantileSketch cannot merge a sketch into itself");
+      return IntEbmType { 1 };
+   }
+
+   if(pQuantileSketchInto->Merge(pQuantileSketchFrom)) {
+      LOG_0(TraceLevelWarning, "WARNING MergeQuantileSketch pQuantileSketchInto->Merge failed");
+      return IntEbmType { 1 };
+   }
+
+   LOG_0(TraceLevelInfo, "Exited MergeQuantileSketch");
+   return IntEbmType { 0 };
+}
+
+EBM_NATIVE_IMPORT_EXPORT_BODY void EBM_NATIVE_CALLING_CONVENTION FreeQuantileSketch(
+   QuantileSketchHandle quantileSketchHandle
+) {
+   LOG_N(TraceLevelInfo, "Entered FreeQuantileSketch: quantileSketchHandle=%p", static_cast<void *>(quantileSketchHandle));
+
+   // pQuantileSketch is allowed to be nullptr.  We handle that inside QuantileSketch::Free
+   QuantileSketch::Free(reinterpret_cast<QuantileSketch *>(quantileSketchHandle));
+
+   LOG_0(TraceLevelInfo, "Exited FreeQuantileSketch");
+}
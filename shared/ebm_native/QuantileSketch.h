@@ -0,0 +1,123 @@
+// Copyright (c) 2018 Microsoft Corporation
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#ifndef QUANTILE_SKETCH_H
+#define QUANTILE_SKETCH_H
+
+#include <stdlib.h> // free
+#include <stddef.h> // size_t, ptrdiff_t
+#include <limits> // std::numeric_limits
+
+#include "ebm_native.h"
+#include "EbmInternal.h" // INLINE_ALWAYS
+#include "Logging.h" // EBM_ASSERT & LOG
+#include "RandomStream.h"
+
+// A KLL sketch (Karnin, Lang, Liberty 2016) of the non-missing values of a single feature.  Level iLevel holds values that each stand in
+// for 2^iLevel of the original samples.  When a level fills we sort it and promote every other value to the level above, choosing the odd
+// or even values at random, which keeps the total weight exact while bounding the memory to roughly 3 * cItemsPerLevelMax values.
+// Sketches can be built over separate chunks of the data, possibly on different threads, and merged later.
+// We keep the counts of missing and +-infinity values and the extreme values exactly since they are cheap to track.
+
+constexpr size_t k_cQuantileSketchLevelsMax = 64; // level 63 would hold values that each represent 2^63 samples
+constexpr size_t k_cQuantileSketchItemsPerLevelMin = 8;
+constexpr size_t k_cQuantileSketchItemsPerLevelDefault = 2048;
+
+struct QuantileSketchLevel final {
+   FloatEbmType * m_aValues;
+   size_t m_cValues;
+   size_t m_cCapacity;
+};
+static_assert(std::is_standard_layout<QuantileSketchLevel>::value,
+   "We use the struct hack in several places, so disallow non-standard_layout types in general");
+static_assert(std::is_trivial<QuantileSketchLevel>::value,
+   "We use memcpy in several places, so disallow non-trivial types in general");
+static_assert(std::is_pod<QuantileSketchLevel>::value,
+   "We use a lot of C constructs, so disallow non-POD types in general");
+
+class QuantileSketch final {
+   size_t m_cItemsPerLevelMax;
+
+   size_t m_cNonMissing;
+   size_t m_cMissing;
+   size_t m_cNegativeInfinity;
+   size_t m_cPositiveInfinity;
+   FloatEbmType m_minNonInfinityValue;
+   FloatEbmType m_maxNonInfinityValue;
+
+   RandomStream m_randomStream;
+
+   size_t m_cLevels;
+   QuantileSketchLevel m_aLevels[k_cQuantileSketchLevelsMax];
+
+   size_t GetLevelCapacity(const size_t iLevel) const;
+   bool CompactLevel(const size_t iLevel);
+   bool Compress();
+
+public:
+
+   QuantileSketch() = default; // preserve our POD status
+   ~QuantileSketch() = default; // preserve our POD status
+   void * operator new(std::size_t) = delete; // we only use malloc/free in this library
+   void operator delete (void *) = delete; // we only use malloc/free in this library
+
+   static void Free(QuantileSketch * const pQuantileSketch);
+   static QuantileSketch * Allocate(const SeedEbmType randomSeed, const size_t cItemsPerLevelMax);
+
+   bool AddValues(const size_t cSamples, const FloatEbmType * const aValues);
+   bool Merge(const QuantileSketch * const pOther);
+
+   // fills aValuesOut with cValues evenly spaced quantiles of the sketch, in sorted order.  The first and last values are always the exact
+   // lowest and highest non-missing values seen, which can be +-infinity
+   bool GetRepresentativeValues(const size_t cValues, FloatEbmType * const aValuesOut) const;
+
+   // the number of values that GetRepresentativeValues should be asked for.  If the sketch hasn't had to compact anything yet, this is the
+   // number of non-missing samples and the representative values are the exact sorted data
+   INLINE_ALWAYS size_t GetCountRepresentativeValues() const {
+      constexpr size_t cRepresentativePerItem = 4;
+      const size_t cMax = IsMultiplyError(m_cItemsPerLevelMax, cRepresentativePerItem) ?
+         m_cItemsPerLevelMax : m_cItemsPerLevelMax * cRepresentativePerItem;
+      return m_cNonMissing < cMax ? m_cNonMissing : cMax;
+   }
+
+   INLINE_ALWAYS size_t GetCountNonMissing() const {
+      return m_cNonMissing;
+   }
+   INLINE_ALWAYS size_t GetCountMissing() const {
+      return m_cMissing;
+   }
+   INLINE_ALWAYS size_t GetCountNegativeInfinity() const {
+      return m_cNegativeInfinity;
+   }
+   INLINE_ALWAYS size_t GetCountPositiveInfinity() const {
+      return m_cPositiveInfinity;
+   }
+   INLINE_ALWAYS FloatEbmType GetMinNonInfinityValue() const {
+      // same convention as RemoveMissingValuesAndReplaceInfinities: zero if there were no normal values
+      return m_cNegativeInfinity + m_cPositiveInfinity == m_cNonMissing ? FloatEbmType { 0 } : m_minNonInfinityValue;
+   }
+   INLINE_ALWAYS FloatEbmType GetMaxNonInfinityValue() const {
+      return m_cNegativeInfinity + m_cPositiveInfinity == m_cNonMissing ? FloatEbmType { 0 } : m_maxNonInfinityValue;
+   }
+
+   // the lowest and highest non-missing values seen, including +-infinity.  Only meaningful if there was a non-missing value
+   INLINE_ALWAYS FloatEbmType GetLowestValue() const {
+      EBM_ASSERT(size_t { 0 } != m_cNonMissing);
+      return size_t { 0 } != m_cNegativeInfinity ? -std::numeric_limits<FloatEbmType>::infinity() :
+         m_cPositiveInfinity == m_cNonMissing ? std::numeric_limits<FloatEbmType>::infinity() : m_minNonInfinityValue;
+   }
+   INLINE_ALWAYS FloatEbmType GetHighestValue() const {
+      EBM_ASSERT(size_t { 0 } != m_cNonMissing);
+      return size_t { 0 } != m_cPositiveInfinity ? std::numeric_limits<FloatEbmType>::infinity() :
+         m_cNegativeInfinity == m_cNonMissing ? -std::numeric_limits<FloatEbmType>::infinity() : m_maxNonInfinityValue;
+   }
+};
+static_assert(std::is_standard_layout<QuantileSketch>::value,
+   "We use the struct hack in several places, so disallow non-standard_layout types in general");
+static_assert(std::is_trivial<QuantileSketch>::value,
+   "We use memcpy in several places, so disallow non-trivial types in general");
+static_assert(std::is_pod<QuantileSketch>::value,
+   "We use a lot of C constructs, so disallow non-POD types in general");
+
+#endif // QUANTILE_SKETCH_H
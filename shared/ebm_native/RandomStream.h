@@ -18,6 +18,9 @@
 constexpr uint64_t k_quantileRandomizationMix = uint64_t { 5744215463699302938u };
 constexpr uint64_t k_boosterRandomizationMix = uint64_t { 9397611943394063143u };
 constexpr uint64_t k_samplingWithoutReplacementRandomizationMix = uint64_t { 10077040353197036781u };
+constexpr uint64_t k_interactionScreenRandomizationMix = uint64_t { 13362744159023540977u };
+constexpr uint64_t k_interactionSamplingRandomizationMix = uint64_t { 4611317836917512893u };
+constexpr uint64_t k_quantileSketchRandomizationMix = uint64_t { 16739186924137061057u };
 
 class RandomStream final {
    // If the RandomStream object is stored inside a class/struct, and used inside a hotspot loop, to get the best 
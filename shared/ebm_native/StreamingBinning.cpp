@@ -0,0 +1,527 @@
+// Copyright (c) 2018 Microsoft Corporation
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#include "PrecompiledHeader.h"
+
+#include <stdlib.h> // free
+#include <stddef.h> // size_t, ptrdiff_t
+#include <string.h> // memcpy
+#include <atomic>
+
+#include "ebm_native.h"
+#include "EbmInternal.h" // INLINE_ALWAYS
+#include "Logging.h" // EBM_ASSERT & LOG
+#include "RandomStream.h"
+#include "ParallelWork.h"
+
+#include "QuantileSketch.h"
+#include "StreamingBinning.h"
+
+void StreamingBinning::Free(StreamingBinning * const pStreamingBinning) {
+   LOG_0(TraceLevelInfo, "Entered StreamingBinning::Free");
+
+   if(nullptr != pStreamingBinning) {
+      QuantileSketch ** const apQuantileSketches = pStreamingBinning->m_apQuantileSketches;
+      if(nullptr != apQuantileSketches) {
+         for(size_t iFeature = 0; iFeature < pStreamingBinning->m_cFeatures; ++iFeature) {
+            QuantileSketch::Free(apQuantileSketches[iFeature]);
+         }
+         free(apQuantileSketches);
+      }
+      free(pStreamingBinning);
+   }
+
+   LOG_0(TraceLevelInfo, "Exited StreamingBinning::Free");
+}
+
+StreamingBinning * StreamingBinning::Allocate(const SeedEbmType randomSeed, const size_t cFeatures, const size_t cItemsPerLevelMax) {
+   LOG_0(TraceLevelInfo, "Entered StreamingBinning::Allocate");
+
+   StreamingBinning * const pNew = EbmMalloc<StreamingBinning>();
+   if(UNLIKELY(nullptr == pNew)) {
+      LOG_0(TraceLevelWarning, "WARNING StreamingBinning::Allocate nullptr == pNew");
+      return nullptr;
+   }
+   pNew->m_cFeatures = cFeatures;
+   pNew->m_apQuantileSketches = nullptr;
+
+   if(size_t { 0 } != cFeatures) {
+      QuantileSketch ** const apQuantileSketches = EbmMalloc<QuantileSketch *>(cFeatures);
+      if(UNLIKELY(nullptr == apQuantileSketches)) {
+         LOG_0(TraceLevelWarning, "WARNING StreamingBinning::Allocate nullptr == apQuantileSketches");
+         free(pNew);
+         return nullptr;
+      }
+      for(size_t iFeature = 0; iFeature < cFeatures; ++iFeature) {
+         apQuantileSketches[iFeature] = nullptr;
+      }
+      pNew->m_apQuantileSketches = apQuantileSketches;
+
+      // each feature gets its own random stream so that the order in which the workers reach the features doesn't matter
+      RandomStream randomStream;
+      randomStream.InitializeUnsigned(randomSeed, k_quantileSketchRandomizationMix);
+      for(size_t iFeature = 0; iFeature < cFeatures; ++iFeature) {
+         QuantileSketch * const pQuantileSketch = QuantileSketch::Allocate(randomStream.NextSeed(), cItemsPerLevelMax);
+         if(UNLIKELY(nullptr == pQuantileSketch)) {
+            LOG_0(TraceLevelWarning, "WARNING StreamingBinning::Allocate nullptr == pQuantileSketch");
+            Free(pNew);
+            return nullptr;
+         }
+         apQuantileSketches[iFeature] = pQuantileSketch;
+      }
+   }
+
+   LOG_0(TraceLevelInfo, "Exited StreamingBinning::Allocate");
+
+   return pNew;
+}
+
+struct StreamingBinningWork final {
+   StreamingBinning * m_pStreamingBinning;
+   size_t m_cSamples;
+   const FloatEbmType * m_aFeatureValues;
+   bool m_bColumnMajor;
+   std::atomic<size_t> m_iFeatureNext;
+   bool m_abError[k_cWorkersMax];
+};
+
+static void AddStreamingBinningChunkWorker(void * const pWorkVoid, const size_t iWorker) {
+   StreamingBinningWork * const pWork = static_cast<StreamingBinningWork *>(pWorkVoid);
+
+   StreamingBinning * const pStreamingBinning = pWork->m_pStreamingBinning;
+   const size_t cSamples = pWork->m_cSamples;
+   const size_t cFeatures = pStreamingBinning->GetCountFeatures();
+
+   // row-major chunks need each feature gathered into a contiguous buffer, which we re-use for every feature this worker takes.
+   // If we can't get the memory we leave the features for the other workers and our caller checks that every feature was taken
+   FloatEbmType * aFeatureValues = nullptr;
+   if(!pWork->m_bColumnMajor) {
+      aFeatureValues = EbmMalloc<FloatEbmType>(cSamples);
+      if(nullptr == aFeatureValues) {
+         LOG_0(TraceLevelWarning, "WARNING AddStreamingBinningChunkWorker nullptr == aFeatureValues");
+         return;
+      }
+   }
+
+   bool bError = false;
+   while(true) {
+      const size_t iFeature = pWork->m_iFeatureNext.fetch_add(size_t { 1 }, std::memory_order_relaxed);
+      if(cFeatures <= iFeature) {
+         break;
+      }
+
+      const FloatEbmType * aColumn;
+      if(pWork->m_bColumnMajor) {
+         aColumn = pWork->m_aFeatureValues + iFeature * cSamples;
+      } else {
+         const FloatEbmType * pFrom = pWork->m_aFeatureValues + iFeature;
+         FloatEbmType * pTo = aFeatureValues;
+         const FloatEbmType * const pToEnd = aFeatureValues + cSamples;
+         do {
+            *pTo = *pFrom;
+            pFrom += cFeatures;
+            ++pTo;
+         } while(pToEnd != pTo);
+         aColumn = aFeatureValues;
+      }
+
+      if(pStreamingBinning->GetQuantileSketch(iFeature)->AddValues(cSamples, aColumn)) {
+         bError = true;
+      }
+   }
+   pWork->m_abError[iWorker] = bError;
+
+   free(aFeatureValues);
+}
+
+static void WriteSketchStatistics(
+   const QuantileSketch * const pQuantileSketch,
+   IntEbmType * const countMissingValuesOut,
+   FloatEbmType * const minNonInfinityValueOut,
+   IntEbmType * const countNegativeInfinityOut,
+   FloatEbmType * const maxNonInfinityValueOut,
+   IntEbmType * const countPositiveInfinityOut
+) {
+   if(LIKELY(nullptr != countMissingValuesOut)) {
+      *countMissingValuesOut = static_cast<IntEbmType>(pQuantileSketch->GetCountMissing());
+   }
+   if(LIKELY(nullptr != minNonInfinityValueOut)) {
+      *minNonInfinityValueOut = pQuantileSketch->GetMinNonInfinityValue();
+   }
+   if(LIKELY(nullptr != countNegativeInfinityOut)) {
+      *countNegativeInfinityOut = static_cast<IntEbmType>(pQuantileSketch->GetCountNegativeInfinity());
+   }
+   if(LIKELY(nullptr != maxNonInfinityValueOut)) {
+      *maxNonInfinityValueOut = pQuantileSketch->GetMaxNonInfinityValue();
+   }
+   if(LIKELY(nullptr != countPositiveInfinityOut)) {
+      *countPositiveInfinityOut = static_cast<IntEbmType>(pQuantileSketch->GetCountPositiveInfinity());
+   }
+}
+
+// returns the feature's sketch, or nullptr after logging if the handle or index is bad
+static QuantileSketch * GetFeatureQuantileSketch(
+   const StreamingBinningHandle streamingBinningHandle,
+   const IntEbmType indexFeature,
+   const char * const sFunctionName
+) {
+   StreamingBinning * const pStreamingBinning = reinterpret_cast<StreamingBinning *>(streamingBinningHandle);
+   if(nullptr == pStreamingBinning) {
+      LOG_N(TraceLevelError, "ERROR %s streamingBinningHandle cannot be nullptr", sFunctionName);
+      return nullptr;
+   }
+   if(indexFeature < IntEbmType { 0 } || !IsNumberConvertable<size_t>(indexFeature) ||
+      pStreamingBinning->GetCountFeatures() <= static_cast<size_t>(indexFeature))
+   {
+      LOG_N(TraceLevelError, "ERROR %s indexFeature out of range", sFunctionName);
+      return nullptr;
+   }
+   return pStreamingBinning->GetQuantileSketch(static_cast<size_t>(indexFeature));
+}
+
+EBM_NATIVE_IMPORT_EXPORT_BODY StreamingBinningHandle EBM_NATIVE_CALLING_CONVENTION BeginStreamingBinning(
+   SeedEbmType randomSeed,
+   IntEbmType countFeatures,
+   IntEbmType countItemsPerLevelMax
+) {
+   LOG_N(TraceLevelInfo, "Entered BeginStreamingBinning: "
+      "randomSeed=%" SeedEbmTypePrintf ", "
+      "countFeatures=%" IntEbmTypePrintf ", "
+      "countItemsPerLevelMax=%" IntEbmTypePrintf
+      ,
+      randomSeed,
+      countFeatures,
+      countItemsPerLevelMax
+   );
+
+   if(countFeatures < IntEbmType { 0 }) {
+      LOG_0(TraceLevelError, "ERROR BeginStreamingBinning countFeatures cannot be negative");
+      return nullptr;
+   }
+   if(!IsNumberConvertable<size_t>(countFeatures)) {
+      LOG_0(TraceLevelWarning, "WARNING BeginStreamingBinning !IsNumberConvertable<size_t>(countFeatures)");
+      return nullptr;
+   }
+   const size_t cFeatures = static_cast<size_t>(countFeatures);
+
+   size_t cItemsPerLevelMax = k_cQuantileSketchItemsPerLevelDefault;
+   if(IntEbmType { 0 } != countItemsPerLevelMax) {
+      if(countItemsPerLevelMax < IntEbmType { 0 }) {
+         LOG_0(TraceLevelError, "ERROR BeginStreamingBinning countItemsPerLevelMax cannot be negative");
+         return nullptr;
+      }
+      if(!IsNumberConvertable<size_t>(countItemsPerLevelMax)) {
+         LOG_0(TraceLevelWarning, "WARNING BeginStreamingBinning !IsNumberConvertable<size_t>(countItemsPerLevelMax)");
+         return nullptr;
+      }
+      cItemsPerLevelMax = static_cast<size_t>(countItemsPerLevelMax);
+      if(cItemsPerLevelMax < k_cQuantileSketchItemsPerLevelMin) {
+         LOG_0(TraceLevelWarning, "WARNING BeginStreamingBinning countItemsPerLevelMax is too small.  Increasing it to the minimum");
+         cItemsPerLevelMax = k_cQuantileSketchItemsPerLevelMin;
+      }
+   }
+
+   StreamingBinning * const pStreamingBinning = StreamingBinning::Allocate(randomSeed, cFeatures, cItemsPerLevelMax);
+   if(UNLIKELY(nullptr == pStreamingBinning)) {
+      LOG_0(TraceLevelWarning, "WARNING BeginStreamingBinning nullptr == pStreamingBinning");
+      return nullptr;
+   }
+
+   LOG_N(TraceLevelInfo, "Exited BeginStreamingBinning %p", static_cast<void *>(pStreamingBinning));
+   return reinterpret_cast<StreamingBinningHandle>(pStreamingBinning);
+}
+
+// we don't care if an extra log message is outputted due to the non-atomic nature of the decrement to this value
+static int g_cLogEnterAddStreamingBinningChunkParametersMessages = 25;
+static int g_cLogExitAddStreamingBinningChunkParametersMessages = 25;
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION AddStreamingBinningChunk(
+   StreamingBinningHandle streamingBinningHandle,
+   IntEbmType countSamples,
+   const FloatEbmType * featureValues,
+   BoolEbmType isColumnMajor
+) {
+   LOG_COUNTED_N(
+      &g_cLogEnterAddStreamingBinningChunkParametersMessages,
+      TraceLevelInfo,
+      TraceLevelVerbose,
+      "Entered AddStreamingBinningChunk: "
+      "streamingBinningHandle=%p, "
+      "countSamples=%" IntEbmTypePrintf ", "
+      "featureValues=%p, "
+      "isColumnMajor=%s"
+      ,
+      static_cast<void *>(streamingBinningHandle),
+      countSamples,
+      static_cast<const void *>(featureValues),
+      ObtainTruth(isColumnMajor)
+   );
+
+   StreamingBinning * const pStreamingBinning = reinterpret_cast<StreamingBinning *>(streamingBinningHandle);
+   if(nullptr == pStreamingBinning) {
+      LOG_0(TraceLevelError, "ERROR AddStreamingBinningChunk streamingBinningHandle cannot be nullptr");
+      return IntEbmType { 1 };
+   }
+   if(countSamples <= IntEbmType { 0 }) {
+      if(countSamples < IntEbmType { 0 }) {
+         LOG_0(TraceLevelError, "ERROR AddStreamingBinningChunk countSamples cannot be negative");
+         return IntEbmType { 1 };
+      }
+      return IntEbmType { 0 };
+   }
+   if(!IsNumberConvertable<size_t>(countSamples)) {
+      LOG_0(TraceLevelWarning, "WARNING AddStreamingBinningChunk !IsNumberConvertable<size_t>(countSamples)");
+      return IntEbmType { 1 };
+   }
+   const size_t cSamples = static_cast<size_t>(countSamples);
+   const size_t cFeatures = pStreamingBinning->GetCountFeatures();
+   if(size_t { 0 } == cFeatures) {
+      return IntEbmType { 0 };
+   }
+   if(IsMultiplyError(cSamples, cFeatures) || IsMultiplyError(cSamples * cFeatures, sizeof(*featureValues))) {
+      LOG_0(TraceLevelWarning, "WARNING AddStreamingBinningChunk countSamples * countFeatures is too large");
+      return IntEbmType { 1 };
+   }
+   if(nullptr == featureValues) {
+      LOG_0(TraceLevelError, "ERROR AddStreamingBinningChunk featureValues cannot be nullptr");
+      return IntEbmType { 1 };
+   }
+   if(EBM_FALSE != isColumnMajor && EBM_TRUE != isColumnMajor) {
+      LOG_0(TraceLevelWarning, "WARNING AddStreamingBinningChunk isColumnMajor should either be EBM_TRUE or EBM_FALSE");
+   }
+
+   const size_t cWorkersMax = GetCountWorkersMax();
+   const size_t cWorkers = cFeatures < cWorkersMax ? cFeatures : cWorkersMax;
+
+   StreamingBinningWork work;
+   work.m_pStreamingBinning = pStreamingBinning;
+   work.m_cSamples = cSamples;
+   work.m_aFeatureValues = featureValues;
+   work.m_bColumnMajor = EBM_FALSE != isColumnMajor;
+   work.m_iFeatureNext.store(size_t { 0 }, std::memory_order_relaxed);
+   for(size_t iWorker = 0; iWorker < cWorkers; ++iWorker) {
+      work.m_abError[iWorker] = false;
+   }
+
+   ExecuteParallelWork(cWorkers, &AddStreamingBinningChunkWorker, &work);
+
+   bool bError = work.m_iFeatureNext.load(std::memory_order_relaxed) < cFeatures;
+   if(bError) {
+      LOG_0(TraceLevelWarning, "WARNING AddStreamingBinningChunk no worker could allocate its scratch memory");
+   }
+   for(size_t iWorker = 0; iWorker < cWorkers; ++iWorker) {
+      bError = bError || work.m_abError[iWorker];
+   }
+   if(bError) {
+      // some features might have taken the chunk while others didn't, so the handle can't be trusted anymore
+      LOG_0(TraceLevelWarning, "WARNING AddStreamingBinningChunk failed to add the chunk to every feature");
+      return IntEbmType { 1 };
+   }
+
+   LOG_COUNTED_0(&g_cLogExitAddStreamingBinningChunkParametersMessages, TraceLevelInfo, TraceLevelVerbose, "Exited AddStreamingBinningChunk");
+   return IntEbmType { 0 };
+}
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION FinishStreamingQuantileCuts(
+   StreamingBinningHandle streamingBinningHandle,
+   IntEbmType indexFeature,
+   IntEbmType countSamplesPerBinMin,
+   BoolEbmType isHumanized,
+   IntEbmType * countCutsInOut,
+   FloatEbmType * cutsLowerBoundInclusiveOut,
+   IntEbmType * countMissingValuesOut,
+   FloatEbmType * minNonInfinityValueOut,
+   IntEbmType * countNegativeInfinityOut,
+   FloatEbmType * maxNonInfinityValueOut,
+   IntEbmType * countPositiveInfinityOut
+) {
+   LOG_N(TraceLevelInfo, "Entered FinishStreamingQuantileCuts: "
+      "streamingBinningHandle=%p, "
+      "indexFeature=%" IntEbmTypePrintf
+      ,
+      static_cast<void *>(streamingBinningHandle),
+      indexFeature
+   );
+
+   QuantileSketch * const pQuantileSketch = GetFeatureQuantileSketch(streamingBinningHandle, indexFeature, "FinishStreamingQuantileCuts");
+   if(nullptr == pQuantileSketch) {
+      return IntEbmType { 1 };
+   }
+
+   const IntEbmType ret = GenerateQuantileCutsFromSketch(
+      reinterpret_cast<QuantileSketchHandle>(pQuantileSketch),
+      countSamplesPerBinMin,
+      isHumanized,
+      countCutsInOut,
+      cutsLowerBoundInclusiveOut,
+      countMissingValuesOut,
+      minNonInfinityValueOut,
+      countNegativeInfinityOut,
+      maxNonInfinityValueOut,
+      countPositiveInfinityOut
+   );
+
+   LOG_N(TraceLevelInfo, "Exited FinishStreamingQuantileCuts: return=%" IntEbmTypePrintf, ret);
+   return ret;
+}
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION FinishStreamingUniformCuts(
+   StreamingBinningHandle streamingBinningHandle,
+   IntEbmType indexFeature,
+   IntEbmType * countCutsInOut,
+   FloatEbmType * cutsLowerBoundInclusiveOut,
+   IntEbmType * countMissingValuesOut,
+   FloatEbmType * minNonInfinityValueOut,
+   IntEbmType * countNegativeInfinityOut,
+   FloatEbmType * maxNonInfinityValueOut,
+   IntEbmType * countPositiveInfinityOut
+) {
+   LOG_N(TraceLevelInfo, "Entered FinishStreamingUniformCuts: "
+      "streamingBinningHandle=%p, "
+      "indexFeature=%" IntEbmTypePrintf
+      ,
+      static_cast<void *>(streamingBinningHandle),
+      indexFeature
+   );
+
+   const QuantileSketch * const pQuantileSketch =
+      GetFeatureQuantileSketch(streamingBinningHandle, indexFeature, "FinishStreamingUniformCuts");
+   if(nullptr == pQuantileSketch) {
+      return IntEbmType { 1 };
+   }
+   if(nullptr == countCutsInOut) {
+      LOG_0(TraceLevelError, "ERROR FinishStreamingUniformCuts nullptr == countCutsInOut");
+      return IntEbmType { 1 };
+   }
+
+   // uniform cuts only depend on the extremes and on which infinities are present, so two values give the same cuts as the
+   // full column: the lowest value stands in for any -infinity and the highest for any +infinity
+   FloatEbmType aExtremes[2];
+   IntEbmType countExtremes = IntEbmType { 0 };
+   if(size_t { 0 } != pQuantileSketch->GetCountNonMissing()) {
+      aExtremes[0] = pQuantileSketch->GetLowestValue();
+      aExtremes[1] = pQuantileSketch->GetHighestValue();
+      countExtremes = size_t { 1 } == pQuantileSketch->GetCountNonMissing() ? IntEbmType { 1 } : IntEbmType { 2 };
+   }
+
+   IntEbmType countMissingValuesIgnored;
+   FloatEbmType minNonInfinityValueIgnored;
+   IntEbmType countNegativeInfinityIgnored;
+   FloatEbmType maxNonInfinityValueIgnored;
+   IntEbmType countPositiveInfinityIgnored;
+   GenerateUniformCuts(
+      countExtremes,
+      aExtremes,
+      countCutsInOut,
+      cutsLowerBoundInclusiveOut,
+      &countMissingValuesIgnored,
+      &minNonInfinityValueIgnored,
+      &countNegativeInfinityIgnored,
+      &maxNonInfinityValueIgnored,
+      &countPositiveInfinityIgnored
+   );
+   WriteSketchStatistics(
+      pQuantileSketch,
+      countMissingValuesOut,
+      minNonInfinityValueOut,
+      countNegativeInfinityOut,
+      maxNonInfinityValueOut,
+      countPositiveInfinityOut
+   );
+
+   LOG_0(TraceLevelInfo, "Exited FinishStreamingUniformCuts");
+   return IntEbmType { 0 };
+}
+
+EBM_NATIVE_IMPORT_EXPORT_BODY IntEbmType EBM_NATIVE_CALLING_CONVENTION FinishStreamingWinsorizedCuts(
+   StreamingBinningHandle streamingBinningHandle,
+   IntEbmType indexFeature,
+   IntEbmType * countCutsInOut,
+   FloatEbmType * cutsLowerBoundInclusiveOut,
+   IntEbmType * countMissingValuesOut,
+   FloatEbmType * minNonInfinityValueOut,
+   IntEbmType * countNegativeInfinityOut,
+   FloatEbmType * maxNonInfinityValueOut,
+   IntEbmType * countPositiveInfinityOut
+) {
+   LOG_N(TraceLevelInfo, "Entered FinishStreamingWinsorizedCuts: "
+      "streamingBinningHandle=%p, "
+      "indexFeature=%" IntEbmTypePrintf
+      ,
+      static_cast<void *>(streamingBinningHandle),
+      indexFeature
+   );
+
+   const QuantileSketch * const pQuantileSketch =
+      GetFeatureQuantileSketch(streamingBinningHandle, indexFeature, "FinishStreamingWinsorizedCuts");
+   if(nullptr == pQuantileSketch) {
+      return IntEbmType { 1 };
+   }
+   if(nullptr == countCutsInOut) {
+      LOG_0(TraceLevelError, "ERROR FinishStreamingWinsorizedCuts nullptr == countCutsInOut");
+      return IntEbmType { 1 };
+   }
+
+   IntEbmType ret = IntEbmType { 0 };
+   const size_t cValues = pQuantileSketch->GetCountRepresentativeValues();
+   if(size_t { 0 } == cValues) {
+      *countCutsInOut = IntEbmType { 0 };
+   } else {
+      // the winsorization bounds are quantiles, so we take them from the sketch's evenly spaced quantiles.  They are exact
+      // until the sketch has had to compact
+      FloatEbmType * const aValues = EbmMalloc<FloatEbmType>(cValues);
+      if(UNLIKELY(nullptr == aValues)) {
+         LOG_0(TraceLevelWarning, "WARNING FinishStreamingWinsorizedCuts nullptr == aValues");
+         *countCutsInOut = IntEbmType { 0 };
+         return IntEbmType { 1 };
+      }
+      if(UNLIKELY(pQuantileSketch->GetRepresentativeValues(cValues, aValues))) {
+         LOG_0(TraceLevelWarning, "WARNING FinishStreamingWinsorizedCuts pQuantileSketch->GetRepresentativeValues failed");
+         free(aValues);
+         *countCutsInOut = IntEbmType { 0 };
+         return IntEbmType { 1 };
+      }
+
+      IntEbmType countMissingValuesIgnored;
+      FloatEbmType minNonInfinityValueIgnored;
+      IntEbmType countNegativeInfinityIgnored;
+      FloatEbmType maxNonInfinityValueIgnored;
+      IntEbmType countPositiveInfinityIgnored;
+      ret = GenerateWinsorizedCuts(
+         static_cast<IntEbmType>(cValues),
+         aValues,
+         countCutsInOut,
+         cutsLowerBoundInclusiveOut,
+         &countMissingValuesIgnored,
+         &minNonInfinityValueIgnored,
+         &countNegativeInfinityIgnored,
+         &maxNonInfinityValueIgnored,
+         &countPositiveInfinityIgnored
+      );
+
+      free(aValues);
+   }
+   WriteSketchStatistics(
+      pQuantileSketch,
+      countMissingValuesOut,
+      minNonInfinityValueOut,
+      countNegativeInfinityOut,
+      maxNonInfinityValueOut,
+      countPositiveInfinityOut
+   );
+
+   LOG_N(TraceLevelInfo, "Exited FinishStreamingWinsorizedCuts: return=%" IntEbmTypePrintf, ret);
+   return ret;
+}
+
+EBM_NATIVE_IMPORT_EXPORT_BODY void EBM_NATIVE_CALLING_CONVENTION FreeStreamingBinning(
+   StreamingBinningHandle streamingBinningHandle
+) {
+   LOG_N(TraceLevelInfo, "Entered FreeStreamingBinning: streamingBinningHandle=%p", static_cast<void *>(streamingBinningHandle));
+
+   // pStreamingBinning is allowed to be nullptr.  We handle that inside StreamingBinning::Free
+   StreamingBinning::Free(reinterpret_cast<StreamingBinning *>(streamingBinningHandle));
+
+   LOG_0(TraceLevelInfo, "Exited FreeStreamingBinning");
+}
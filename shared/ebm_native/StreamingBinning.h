@@ -0,0 +1,48 @@
+// Copyright (c) 2018 Microsoft Corporation
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#ifndef STREAMING_BINNING_H
+#define STREAMING_BINNING_H
+
+#include <stdlib.h> // free
+#include <stddef.h> // size_t, ptrdiff_t
+
+#include "ebm_native.h"
+#include "EbmInternal.h" // INLINE_ALWAYS
+#include "Logging.h" // EBM_ASSERT & LOG
+
+class QuantileSketch;
+
+// holds one QuantileSketch per feature so that we can fit cuts on data that arrives in chunks and is never held all at once
+class StreamingBinning final {
+   size_t m_cFeatures;
+   QuantileSketch ** m_apQuantileSketches;
+
+public:
+
+   StreamingBinning() = default; // preserve our POD status
+   ~StreamingBinning() = default; // preserve our POD status
+   void * operator new(std::size_t) = delete; // we only use malloc/free in this library
+   void operator delete (void *) = delete; // we only use malloc/free in this library
+
+   static void Free(StreamingBinning * const pStreamingBinning);
+   static StreamingBinning * Allocate(const SeedEbmType randomSeed, const size_t cFeatures, const size_t cItemsPerLevelMax);
+
+   INLINE_ALWAYS size_t GetCountFeatures() const {
+      return m_cFeatures;
+   }
+
+   INLINE_ALWAYS QuantileSketch * GetQuantileSketch(const size_t iFeature) {
+      EBM_ASSERT(iFeature < m_cFeatures);
+      return m_apQuantileSketches[iFeature];
+   }
+};
+static_assert(std::is_standard_layout<StreamingBinning>::value,
+   "We use the struct hack in several places, so disallow non-standard_layout types in general");
+static_assert(std::is_trivial<StreamingBinning>::value,
+   "We use memcpy in several places, so disallow non-trivial types in general");
+static_assert(std::is_pod<StreamingBinning>::value,
+   "We use a lot of C constructs, so disallow non-POD types in general");
+
+#endif // STREAMING_BINNING_H
@@ -139,7 +139,7 @@
 // TODO: build a pair and triple specific version of this function.  For pairs we can get ride of the pPrevious and just use the actual cell at (-1,-1) from our current cell, and we can use two loops with everything in memory [look at code above from before we incoporated the previous totals].  Triples would also benefit from pulling things out since we have low iterations of the inner loop and we can access indicies directly without additional add/subtract/bit operations.  Beyond triples, the combinatorial choices start to explode, so we should probably use this general N-dimensional code.
 // TODO: after we build pair and triple specific versions of this function, we don't need to have a compiler compilerCountDimensions, since the compiler won't really be able to simpify the loops that are exploding in dimensionality
 // TODO: sort our N-dimensional groups at initialization so that the longest dimension is first!  That way we can more efficiently walk through contiguous memory better in this function!  After we determine the cuts, we can undo the re-ordering for cutting the tensor, which has just a few cells, so will be efficient
-template<ptrdiff_t compilerLearningTypeOrCountTargetClasses, size_t compilerCountDimensions>
+template<ptrdiff_t compilerLearningTypeOrCountTargetClasses, size_t compilerCountDimensions, bool bClassification>
 class TensorTotalsBuildInternal final {
 public:
 
@@ -155,8 +155,6 @@ public:
       , const unsigned char * const aHistogramBucketsEndDebug
 #endif // NDEBUG
    ) {
-      constexpr bool bClassification = IsClassification(compilerLearningTypeOrCountTargetClasses);
-
       struct FastTotalState {
          HistogramBucket<bClassification> * m_pDimensionalCur;
          HistogramBucket<bClassification> * m_pDimensionalWrap;
@@ -251,7 +249,7 @@ public:
       HistogramBucket<bClassification> * const pDebugBucket =
          EbmMalloc<HistogramBucket<bClassification>>(1, cBytesPerHistogramBucket);
 
-      HistogramBucket<IsClassification(compilerLearningTypeOrCountTargetClasses)> * aHistogramBucketsDebugCopy =
+      HistogramBucket<bClassification> * aHistogramBucketsDebugCopy =
          aHistogramBucketsDebugCopyBase->GetHistogramBucket<bClassification>();
 
 #endif //NDEBUG
@@ -334,7 +332,7 @@ public:
    }
 };
 
-template<ptrdiff_t compilerLearningTypeOrCountTargetClasses, size_t compilerCountDimensionsPossible>
+template<ptrdiff_t compilerLearningTypeOrCountTargetClasses, size_t compilerCountDimensionsPossible, bool bClassification>
 class TensorTotalsBuildDimensions final {
 public:
 
@@ -358,7 +356,7 @@ public:
       EBM_ASSERT(1 <= runtimeCountDimensions);
       EBM_ASSERT(runtimeCountDimensions <= k_cDimensionsMax);
       if(compilerCountDimensionsPossible == runtimeCountDimensions) {
-         TensorTotalsBuildInternal<compilerLearningTypeOrCountTargetClasses, compilerCountDimensionsPossible>::Func(
+         TensorTotalsBuildInternal<compilerLearningTypeOrCountTargetClasses, compilerCountDimensionsPossible, bClassification>::Func(
             runtimeLearningTypeOrCountTargetClasses,
             pFeatureGroup,
             pBucketAuxiliaryBuildZone,
@@ -369,7 +367,7 @@ public:
 #endif // NDEBUG
          );
       } else {
-         TensorTotalsBuildDimensions<compilerLearningTypeOrCountTargetClasses, compilerCountDimensionsPossible + 1>::Func(
+         TensorTotalsBuildDimensions<compilerLearningTypeOrCountTargetClasses, compilerCountDimensionsPossible + 1, bClassification>::Func(
             runtimeLearningTypeOrCountTargetClasses,
             pFeatureGroup,
             pBucketAuxiliaryBuildZone,
@@ -383,8 +381,8 @@ public:
    }
 };
 
-template<ptrdiff_t compilerLearningTypeOrCountTargetClasses>
-class TensorTotalsBuildDimensions<compilerLearningTypeOrCountTargetClasses, k_cCompilerOptimizedCountDimensionsMax + 1> final {
+template<ptrdiff_t compilerLearningTypeOrCountTargetClasses, bool bClassification>
+class TensorTotalsBuildDimensions<compilerLearningTypeOrCountTargetClasses, k_cCompilerOptimizedCountDimensionsMax + 1, bClassification> final {
 public:
 
    TensorTotalsBuildDimensions() = delete; // this is a static class.  Do not construct
@@ -401,7 +399,7 @@ public:
    ) {
       EBM_ASSERT(1 <= pFeatureGroup->GetCountSignificantFeatures());
       EBM_ASSERT(pFeatureGroup->GetCountSignificantFeatures() <= k_cDimensionsMax);
-      TensorTotalsBuildInternal<compilerLearningTypeOrCountTargetClasses, k_dynamicDimensions>::Func(
+      TensorTotalsBuildInternal<compilerLearningTypeOrCountTargetClasses, k_dynamicDimensions, bClassification>::Func(
          runtimeLearningTypeOrCountTargetClasses,
          pFeatureGroup,
          pBucketAuxiliaryBuildZone,
@@ -414,7 +412,7 @@ public:
    }
 };
 
-template<ptrdiff_t compilerLearningTypeOrCountTargetClassesPossible>
+template<ptrdiff_t compilerLearningTypeOrCountTargetClassesPossible, bool bClassification>
 class TensorTotalsBuildTarget final {
 public:
 
@@ -437,7 +435,7 @@ public:
       EBM_ASSERT(runtimeLearningTypeOrCountTargetClasses <= k_cCompilerOptimizedTargetClassesMax);
 
       if(compilerLearningTypeOrCountTargetClassesPossible == runtimeLearningTypeOrCountTargetClasses) {
-         TensorTotalsBuildDimensions<compilerLearningTypeOrCountTargetClassesPossible, 2>::Func(
+         TensorTotalsBuildDimensions<compilerLearningTypeOrCountTargetClassesPossible, 2, bClassification>::Func(
             runtimeLearningTypeOrCountTargetClasses,
             pFeatureGroup,
             pBucketAuxiliaryBuildZone,
@@ -448,7 +446,7 @@ public:
 #endif // NDEBUG
          );
       } else {
-         TensorTotalsBuildTarget<compilerLearningTypeOrCountTargetClassesPossible + 1>::Func(
+         TensorTotalsBuildTarget<compilerLearningTypeOrCountTargetClassesPossible + 1, bClassification>::Func(
             runtimeLearningTypeOrCountTargetClasses,
             pFeatureGroup,
             pBucketAuxiliaryBuildZone,
@@ -462,8 +460,8 @@ public:
    }
 };
 
-template<>
-class TensorTotalsBuildTarget<k_cCompilerOptimizedTargetClassesMax + 1> final {
+template<bool bClassification>
+class TensorTotalsBuildTarget<k_cCompilerOptimizedTargetClassesMax + 1, bClassification> final {
 public:
 
    TensorTotalsBuildTarget() = delete; // this is a static class.  Do not construct
@@ -483,7 +481,7 @@ public:
       EBM_ASSERT(IsClassification(runtimeLearningTypeOrCountTargetClasses));
       EBM_ASSERT(k_cCompilerOptimizedTargetClassesMax < runtimeLearningTypeOrCountTargetClasses);
 
-      TensorTotalsBuildDimensions<k_dynamicClassification, 2>::Func(
+      TensorTotalsBuildDimensions<k_dynamicClassification, 2, bClassification>::Func(
          runtimeLearningTypeOrCountTargetClasses,
          pFeatureGroup,
          pBucketAuxiliaryBuildZone,
@@ -507,7 +505,59 @@ extern void TensorTotalsBuild(
 #endif // NDEBUG
 ) {
    if(IsClassification(runtimeLearningTypeOrCountTargetClasses)) {
-      TensorTotalsBuildTarget<2>::Func(
+      if(k_cCompilerOptimizedTargetClassesMax < runtimeLearningTypeOrCountTargetClasses) {
+         // there is no compiler optimized version for this many classes, so skip the template chain that looks for one
+         TensorTotalsBuildTarget<k_cCompilerOptimizedTargetClassesMax + 1, true>::Func(
+            runtimeLearningTypeOrCountTargetClasses,
+            pFeatureGroup,
+            pBucketAuxiliaryBuildZone,
+            aHistogramBuckets
+#ifndef NDEBUG
+            , aHistogramBucketsDebugCopy
+            , aHistogramBucketsEndDebug
+#endif // NDEBUG
+         );
+      } else {
+         TensorTotalsBuildTarget<2, true>::Func(
+            runtimeLearningTypeOrCountTargetClasses,
+            pFeatureGroup,
+            pBucketAuxiliaryBuildZone,
+            aHistogramBuckets
+#ifndef NDEBUG
+            , aHistogramBucketsDebugCopy
+            , aHistogramBucketsEndDebug
+#endif // NDEBUG
+         );
+      }
+   } else {
+      EBM_ASSERT(IsRegression(runtimeLearningTypeOrCountTargetClasses));
+      TensorTotalsBuildDimensions<k_regression, 2, false>::Func(
+         runtimeLearningTypeOrCountTargetClasses,
+         pFeatureGroup,
+         pBucketAuxiliaryBuildZone,
+         aHistogramBuckets
+#ifndef NDEBUG
+         , aHistogramBucketsDebugCopy
+         , aHistogramBucketsEndDebug
+#endif // NDEBUG
+      );
+   }
+}
+
+// interaction detection never uses the denominator term, so it bins into the residual-only HistogramBucket<false> layout
+// for both classification and regression
+extern void TensorTotalsBuildInteraction(
+   const ptrdiff_t runtimeLearningTypeOrCountTargetClasses,
+   const FeatureGroup * const pFeatureGroup,
+   HistogramBucketBase * pBucketAuxiliaryBuildZone,
+   HistogramBucketBase * const aHistogramBuckets
+#ifndef NDEBUG
+   , HistogramBucketBase * const aHistogramBucketsDebugCopy
+   , const unsigned char * const aHistogramBucketsEndDebug
+#endif // NDEBUG
+) {
+   if(IsClassification(runtimeLearningTypeOrCountTargetClasses)) {
+      TensorTotalsBuildTarget<2, false>::Func(
          runtimeLearningTypeOrCountTargetClasses,
          pFeatureGroup,
          pBucketAuxiliaryBuildZone,
@@ -519,7 +569,7 @@ extern void TensorTotalsBuild(
       );
    } else {
       EBM_ASSERT(IsRegression(runtimeLearningTypeOrCountTargetClasses));
-      TensorTotalsBuildDimensions<k_regression, 2>::Func(
+      TensorTotalsBuildDimensions<k_regression, 2, false>::Func(
          runtimeLearningTypeOrCountTargetClasses,
          pFeatureGroup,
          pBucketAuxiliaryBuildZone,
@@ -29,6 +29,17 @@ extern void TensorTotalsBuild(
 #endif // NDEBUG
 );
 
+extern void TensorTotalsBuildInteraction(
+   const ptrdiff_t runtimeLearningTypeOrCountTargetClasses,
+   const FeatureGroup * const pFeatureGroup,
+   HistogramBucketBase * pBucketAuxiliaryBuildZone,
+   HistogramBucketBase * const aHistogramBuckets
+#ifndef NDEBUG
+   , HistogramBucketBase * const aHistogramBucketsDebugCopy
+   , const unsigned char * const aHistogramBucketsEndDebug
+#endif // NDEBUG
+);
+
 #ifndef NDEBUG
 
 template<bool bClassification>
@@ -173,16 +184,18 @@ void TensorTotalsCompareDebug(
 
 #endif // NDEBUG
 
-template<ptrdiff_t compilerLearningTypeOrCountTargetClasses, size_t compilerCountDimensions>
+// bClassification is deduced from the bucket type, which lets interaction detection pass in the residual-only 
+// HistogramBucket<false> layout even when compilerLearningTypeOrCountTargetClasses is a classification
+template<ptrdiff_t compilerLearningTypeOrCountTargetClasses, size_t compilerCountDimensions, bool bClassification>
 void TensorTotalsSum(
    const ptrdiff_t runtimeLearningTypeOrCountTargetClasses,
    const FeatureGroup * const pFeatureGroup,
-   const HistogramBucket<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const aHistogramBuckets,
+   const HistogramBucket<bClassification> * const aHistogramBuckets,
    const size_t * const aiPoint,
    const size_t directionVector,
-   HistogramBucket<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const pRet
+   HistogramBucket<bClassification> * const pRet
 #ifndef NDEBUG
-   , const HistogramBucket<IsClassification(compilerLearningTypeOrCountTargetClasses)> * const aHistogramBucketsDebugCopy
+   , const HistogramBucket<bClassification> * const aHistogramBucketsDebugCopy
    , const unsigned char * const aHistogramBucketsEndDebug
 #endif // NDEBUG
 ) {
@@ -191,8 +204,6 @@ void TensorTotalsSum(
       size_t m_cLast;
    };
 
-   constexpr bool bClassification = IsClassification(compilerLearningTypeOrCountTargetClasses);
-
    // don't LOG this!  It would create way too much chatter!
 
    static_assert(k_cDimensionsMax < k_cBitsForSizeT, "reserve the highest bit for bit manipulation space");
@@ -20,6 +20,8 @@ class ThreadStateBoosting final {
 
    Booster * m_pBooster;
    size_t m_iFeatureGroup;
+   // the gain of the update we're holding, which feeds the feature group schedule.  NaN if we don't know it
+   FloatEbmType m_gain;
 
    SegmentedTensor * m_pSmallChangeToModelAccumulatedFromSamplingSets;
    SegmentedTensor * m_pSmallChangeToModelOverwriteSingleSamplingSet;
@@ -54,6 +56,7 @@ public:
    INLINE_ALWAYS void InitializeZero() {
       m_pBooster = nullptr;
       m_iFeatureGroup = k_illegalFeatureGroupIndex;
+      m_gain = FloatEbmType { 0 };
       m_pSmallChangeToModelAccumulatedFromSamplingSets = nullptr;
       m_pSmallChangeToModelOverwriteSingleSamplingSet = nullptr;
       m_aThreadByteBuffer1 = nullptr;
@@ -81,6 +84,14 @@ public:
       m_iFeatureGroup = val;
    }
 
+   INLINE_ALWAYS FloatEbmType GetGain() const {
+      return m_gain;
+   }
+
+   INLINE_ALWAYS void SetGain(const FloatEbmType val) {
+      m_gain = val;
+   }
+
    INLINE_ALWAYS SegmentedTensor * GetSmallChangeToModelAccumulatedFromSamplingSets() {
       return m_pSmallChangeToModelAccumulatedFromSamplingSets;
    }
@@ -7,27 +7,89 @@
 #include <stdlib.h> // free
 #include <stddef.h> // size_t, ptrdiff_t
 
+#include "ebm_native.h"
 #include "EbmInternal.h" // INLINE_ALWAYS
 #include "Logging.h" // EBM_ASSERT & LOG
 
+#include "FeatureAtomic.h"
+#include "HistogramBucket.h"
+#include "InteractionDetector.h"
+
 #include "ThreadStateInteraction.h"
 
 void ThreadStateInteraction::Free(ThreadStateInteraction * const pThreadStateInteraction) {
    LOG_0(TraceLevelInfo, "Entered ThreadStateInteraction::Free");
 
-   free(pThreadStateInteraction->m_aThreadByteBuffer1);
+   if(nullptr != pThreadStateInteraction) {
+      free(pThreadStateInteraction->m_aThreadByteBuffer1);
 
-   free(pThreadStateInteraction);
+      free(pThreadStateInteraction);
+   }
 
    LOG_0(TraceLevelInfo, "Exited ThreadStateInteraction::Free");
 }
 
-ThreadStateInteraction * ThreadStateInteraction::Allocate() {
+// returns the bytes of histogram space needed by the largest pair that we could be asked to score, or 0 if that can't be computed.  The pair
+// made from the two features with the most bins has both the largest main space and, with the larger feature first, the most auxillary buckets
+static size_t GetPairHistogramBytesMax(const InteractionDetector * const pInteractionDetector) {
+   const ptrdiff_t runtimeLearningTypeOrCountTargetClasses = pInteractionDetector->GetRuntimeLearningTypeOrCountTargetClasses();
+   if(IsClassification(runtimeLearningTypeOrCountTargetClasses) && runtimeLearningTypeOrCountTargetClasses <= ptrdiff_t { 1 }) {
+      // with 0 or 1 target classes we never build histograms
+      return size_t { 0 };
+   }
+
+   size_t cBinsLargest = 0;
+   size_t cBinsSecondLargest = 0;
+   const Feature * pFeature = pInteractionDetector->GetFeatures();
+   const Feature * const pFeaturesEnd = pFeature + pInteractionDetector->GetCountFeatures();
+   for(; pFeaturesEnd != pFeature; ++pFeature) {
+      const size_t cBins = pFeature->GetCountBins();
+      if(cBinsLargest < cBins) {
+         cBinsSecondLargest = cBinsLargest;
+         cBinsLargest = cBins;
+      } else if(cBinsSecondLargest < cBins) {
+         cBinsSecondLargest = cBins;
+      }
+   }
+   if(cBinsSecondLargest <= size_t { 1 }) {
+      // pairs that include a feature with 1 bin are never binned
+      return size_t { 0 };
+   }
+
+   if(IsMultiplyError(cBinsLargest, cBinsSecondLargest)) {
+      return size_t { 0 };
+   }
+   const size_t cTotalBucketsMainSpace = cBinsLargest * cBinsSecondLargest;
+   // the auxillary buckets mirror GetInteractionBucketCounts.  cBinsLargest is less than cTotalBucketsMainSpace so adding 1 can't overflow
+   const size_t cAuxillaryBucketsForBuildFastTotals = size_t { 1 } + cBinsLargest;
+   const size_t cAuxillaryBucketsForSplitting = 4;
+   const size_t cAuxillaryBuckets =
+      cAuxillaryBucketsForBuildFastTotals < cAuxillaryBucketsForSplitting ? cAuxillaryBucketsForSplitting : cAuxillaryBucketsForBuildFastTotals;
+   if(IsAddError(cTotalBucketsMainSpace, cAuxillaryBuckets)) {
+      return size_t { 0 };
+   }
+   const size_t cTotalBuckets = cTotalBucketsMainSpace + cAuxillaryBuckets;
+
+   const size_t cVectorLength = GetVectorLength(runtimeLearningTypeOrCountTargetClasses);
+   if(GetHistogramBucketSizeOverflow(false, cVectorLength)) {
+      return size_t { 0 };
+   }
+   const size_t cBytesPerHistogramBucket = GetHistogramBucketSize(false, cVectorLength);
+   if(IsMultiplyError(cTotalBuckets, cBytesPerHistogramBucket)) {
+      return size_t { 0 };
+   }
+   return cTotalBuckets * cBytesPerHistogramBucket;
+}
+
+ThreadStateInteraction * ThreadStateInteraction::Allocate(InteractionDetector * const pInteractionDetector) {
    LOG_0(TraceLevelInfo, "Entered ThreadStateInteraction::Allocate");
 
+   EBM_ASSERT(nullptr != pInteractionDetector);
+
    ThreadStateInteraction * const pNew = EbmMalloc<ThreadStateInteraction>();
-   if(nullptr != pNew) {
+   if(LIKELY(nullptr != pNew)) {
       pNew->InitializeZero();
+      pNew->m_pInteractionDetector = pInteractionDetector;
    }
 
    LOG_0(TraceLevelInfo, "Exited ThreadStateInteraction::Allocate");
@@ -35,15 +97,81 @@ ThreadStateInteraction * ThreadStateInteraction::Allocate() {
    return pNew;
 }
 
+void ThreadStateInteraction::ReservePairHistogram() {
+   // reserve enough space up front that scoring any pair never needs to allocate.  We don't touch the memory here, so on operating
+   // systems with a first-touch policy the pages land on the NUMA node of the thread that first zeros the histogram, which is the
+   // thread doing the scoring.  If we can't get the memory now we fall back to growing the buffer on demand, since the caller might
+   // only ever score pairs that are much smaller than the largest one
+   EBM_ASSERT(nullptr != m_pInteractionDetector);
+
+   const size_t cBytesReserve = GetPairHistogramBytesMax(m_pInteractionDetector);
+   if(m_cThreadByteBufferCapacity1 < cBytesReserve) {
+      HistogramBucketBase * const aBuffer = static_cast<HistogramBucketBase *>(EbmMalloc<void>(cBytesReserve));
+      if(LIKELY(nullptr != aBuffer)) {
+         free(m_aThreadByteBuffer1);
+         m_aThreadByteBuffer1 = aBuffer;
+         m_cThreadByteBufferCapacity1 = cBytesReserve;
+      } else {
+         LOG_N(TraceLevelWarning, "WARNING ThreadStateInteraction::ReservePairHistogram could not reserve %zu bytes", cBytesReserve);
+      }
+   }
+}
+
 HistogramBucketBase * ThreadStateInteraction::GetHistogramBucketBase(const size_t cBytesRequired) {
    HistogramBucketBase * aBuffer = m_aThreadByteBuffer1;
    if(UNLIKELY(m_cThreadByteBufferCapacity1 < cBytesRequired)) {
-      m_cThreadByteBufferCapacity1 = cBytesRequired << 1;
-      LOG_N(TraceLevelInfo, "Growing ThreadStateInteraction::ThreadByteBuffer1 to %zu", m_cThreadByteBufferCapacity1);
+      size_t cBytesCapacity = cBytesRequired << 1;
+      if(cBytesCapacity < cBytesRequired) {
+         // overflow on the doubling.  Just ask for what we need
+         cBytesCapacity = cBytesRequired;
+      }
+      LOG_N(TraceLevelInfo, "Growing ThreadStateInteraction::ThreadByteBuffer1 to %zu", cBytesCapacity);
 
       free(aBuffer);
-      aBuffer = static_cast<HistogramBucketBase *>(EbmMalloc<void>(m_cThreadByteBufferCapacity1));
+      aBuffer = static_cast<HistogramBucketBase *>(EbmMalloc<void>(cBytesCapacity));
       m_aThreadByteBuffer1 = aBuffer;
+      // our ThreadStateInteraction can outlive a failed request, so only record the capacity that we actually hold
+      m_cThreadByteBufferCapacity1 = nullptr == aBuffer ? size_t { 0 } : cBytesCapacity;
    }
    return aBuffer;
 }
+
+EBM_NATIVE_IMPORT_EXPORT_BODY ThreadStateInteractionHandle EBM_NATIVE_CALLING_CONVENTION CreateThreadStateInteraction(
+   InteractionDetectorHandle interactionDetectorHandle
+) {
+   LOG_N(TraceLevelInfo, "Entered CreateThreadStateInteraction: interactionDetectorHandle=%p", static_cast<void *>(interactionDetectorHandle));
+
+   InteractionDetector * const pInteractionDetector = reinterpret_cast<InteractionDetector *>(interactionDetectorHandle);
+   if(nullptr == pInteractionDetector) {
+      LOG_0(TraceLevelError, "ERROR CreateThreadStateInteraction interactionDetectorHandle cannot be nullptr");
+      return nullptr;
+   }
+
+   ThreadStateInteraction * const pThreadStateInteraction = ThreadStateInteraction::Allocate(pInteractionDetector);
+   if(UNLIKELY(nullptr == pThreadStateInteraction)) {
+      LOG_0(TraceLevelWarning, "WARNING CreateThreadStateInteraction nullptr == pThreadStateInteraction");
+      return nullptr;
+   }
+   // our caller is going to score pair after pair with this object, so size the histogram buffer for the largest pair now
+   pThreadStateInteraction->ReservePairHistogram();
+
+   LOG_N(TraceLevelInfo, "Exited CreateThreadStateInteraction: %p", static_cast<void *>(pThreadStateInteraction));
+   return reinterpret_cast<ThreadStateInteractionHandle>(pThreadStateInteraction);
+}
+
+EBM_NATIVE_IMPORT_EXPORT_BODY void EBM_NATIVE_CALLING_CONVENTION FreeThreadStateInteraction(
+   ThreadStateInteractionHandle threadStateInteractionHandle
+) {
+   LOG_N(TraceLevelInfo, 
+      "Entered FreeThreadStateInteraction: threadStateInteractionHandle=%p", 
+      static_cast<void *>(threadStateInteractionHandle)
+   );
+
+   ThreadStateInteraction * const pThreadStateInteraction = 
+      reinterpret_cast<ThreadStateInteraction *>(threadStateInteractionHandle);
+
+   // it's legal to call free on nullptr, just like for free().  This is checked inside ThreadStateInteraction::Free()
+   ThreadStateInteraction::Free(pThreadStateInteraction);
+
+   LOG_0(TraceLevelInfo, "Exited FreeThreadStateInteraction");
+}
@@ -12,8 +12,11 @@
 #include "Logging.h" // EBM_ASSERT & LOG
 
 struct HistogramBucketBase;
+class InteractionDetector;
 
 class ThreadStateInteraction final {
+   InteractionDetector * m_pInteractionDetector;
+
    HistogramBucketBase * m_aThreadByteBuffer1;
    size_t m_cThreadByteBufferCapacity1;
 
@@ -25,14 +28,21 @@ public:
    void operator delete (void *) = delete; // we only use malloc/free in this library
 
    INLINE_ALWAYS void InitializeZero() {
+      m_pInteractionDetector = nullptr;
+
       m_aThreadByteBuffer1 = nullptr;
       m_cThreadByteBufferCapacity1 = 0;
    }
 
    static void Free(ThreadStateInteraction * const pThreadStateInteraction);
-   static ThreadStateInteraction * Allocate();
-   HistogramBucketBase * GetHistogramBucketBase(const size_t cBytesRequired);
+   static ThreadStateInteraction * Allocate(InteractionDetector * const pInteractionDetector);
 
+   INLINE_ALWAYS InteractionDetector * GetInteractionDetector() {
+      return m_pInteractionDetector;
+   }
+
+   void ReservePairHistogram();
+   HistogramBucketBase * GetHistogramBucketBase(const size_t cBytesRequired);
 };
 static_assert(std::is_standard_layout<ThreadStateInteraction>::value,
    "We use the struct hack in several places, so disallow non-standard_layout types in general");
@@ -1554,3 +1554,180 @@ TEST_CASE("Random splitting, no cuts, binary, sums") {
    CHECK_APPROX(validationMetric, 0.87428283691406250f);
 }
 
+
+TEST_CASE("coarse bin schedule, boosting, regression") {
+   TestApi test = TestApi(k_learningTypeRegression);
+   test.AddFeatures({ FeatureTest(8) });
+   test.AddFeatureGroups({ { 0 } });
+   std::vector<RegressionSample> samples;
+   for(IntEbmType iBin = 0; iBin < 8; ++iBin) {
+      samples.push_back(RegressionSample(static_cast<FloatEbmType>(iBin * iBin), { iBin }));
+   }
+   test.AddTrainingSamples(samples);
+   test.AddValidationSamples(samples);
+   test.InitializeBoosting();
+
+   CHECK(0 != SetCoarseBinSchedule(test.GetBoosterHandle(), IntEbmType { 1 }, IntEbmType { 1 }));
+   CHECK(0 == SetCoarseBinSchedule(test.GetBoosterHandle(), IntEbmType { 1 }, IntEbmType { 2 }));
+
+   // 8 bins in at most 2 coarse bins means 4 fine bins per coarse bin, so the only possible cut is after bin 3
+   test.Boost(0);
+   for(size_t iBin = 1; iBin < 4; ++iBin) {
+      CHECK(test.GetCurrentModelPredictorScore(0, { 0 }, 0) == test.GetCurrentModelPredictorScore(0, { iBin }, 0));
+   }
+   for(size_t iBin = 5; iBin < 8; ++iBin) {
+      CHECK(test.GetCurrentModelPredictorScore(0, { 4 }, 0) == test.GetCurrentModelPredictorScore(0, { iBin }, 0));
+   }
+   CHECK(test.GetCurrentModelPredictorScore(0, { 0 }, 0) < test.GetCurrentModelPredictorScore(0, { 4 }, 0));
+
+   // the coarse round is used up, so we're now boosting on the full resolution bins
+   test.Boost(0);
+   CHECK(test.GetCurrentModelPredictorScore(0, { 4 }, 0) != test.GetCurrentModelPredictorScore(0, { 7 }, 0));
+}
+
+TEST_CASE("coarse bin schedule, pair, boosting, multiclass") {
+   TestApi test = TestApi(3);
+   test.AddFeatures({ FeatureTest(8), FeatureTest(6) });
+   test.AddFeatureGroups({ { 0, 1 } });
+   std::vector<ClassificationSample> samples;
+   for(IntEbmType i0 = 0; i0 < 8; ++i0) {
+      for(IntEbmType i1 = 0; i1 < 6; ++i1) {
+         samples.push_back(ClassificationSample((i0 + 2 * i1) % 3, { i0, i1 }));
+      }
+   }
+   test.AddTrainingSamples(samples);
+   test.AddValidationSamples(samples);
+   test.InitializeBoosting();
+
+   CHECK(0 == SetCoarseBinSchedule(test.GetBoosterHandle(), IntEbmType { 3 }, IntEbmType { 3 }));
+
+   // feature 0 merges 3 fine bins per coarse bin and feature 1 merges 2, so no cut can fall inside those runs
+   for(int iRound = 0; iRound < 3; ++iRound) {
+      test.Boost(0);
+   }
+   for(size_t i0 = 0; i0 < 8; ++i0) {
+      for(size_t i1 = 0; i1 < 6; ++i1) {
+         const size_t i0Coarse = i0 / 3 * 3;
+         const size_t i1Coarse = i1 / 2 * 2;
+         for(size_t iScore = 0; iScore < 3; ++iScore) {
+            CHECK(test.GetCurrentModelPredictorScore(0, { i0Coarse, i1Coarse }, iScore) == 
+               test.GetCurrentModelPredictorScore(0, { i0, i1 }, iScore));
+         }
+      }
+   }
+
+   // turning the schedule off goes straight back to full resolution
+   CHECK(0 == SetCoarseBinSchedule(test.GetBoosterHandle(), IntEbmType { 0 }, IntEbmType { 3 }));
+   for(int iRound = 0; iRound < 20; ++iRound) {
+      test.Boost(0);
+   }
+}
+
+TEST_CASE("feature group schedule backs off stagnant feature groups, boosting, regression") {
+   TestApi test = TestApi(k_learningTypeRegression);
+   test.AddFeatures({ FeatureTest(2), FeatureTest(2) });
+   test.AddFeatureGroups({ { 0 }, { 1 } });
+   // feature 1 has the same targets in both of its bins, so it never has any gain
+   const std::vector<RegressionSample> samples = {
+      RegressionSample(0, { 0, 0 }),
+      RegressionSample(0, { 0, 1 }),
+      RegressionSample(10, { 1, 0 }),
+      RegressionSample(10, { 1, 1 }),
+   };
+   test.AddTrainingSamples(samples);
+   test.AddValidationSamples(samples);
+   test.InitializeBoosting();
+
+   CHECK(0 != SetFeatureGroupSchedule(test.GetBoosterHandle(), FloatEbmType { 0.000001 }, IntEbmType { -1 }));
+   CHECK(0 == SetFeatureGroupSchedule(test.GetBoosterHandle(), FloatEbmType { 0.000001 }, IntEbmType { 4 }));
+
+   // feature group 1 sits out for 1, 2, 4 and then 4 rounds between each re-check
+   const std::vector<IntEbmType> expectedCounts = { 2, 1, 2, 1, 1, 2, 1, 1, 1, 1, 2, 1, 1, 1, 1, 2 };
+   for(size_t iRound = 0; iRound < expectedCounts.size(); ++iRound) {
+      IntEbmType countFeatureGroups = 0;
+      IntEbmType featureGroupIndexes[2];
+      CHECK(0 == GetScheduledFeatureGroups(test.GetBoosterHandle(), &countFeatureGroups, featureGroupIndexes));
+      CHECK(expectedCounts[iRound] == countFeatureGroups);
+      CHECK(0 == featureGroupIndexes[0]);
+      // asking again doesn't move the schedule
+      IntEbmType countFeatureGroupsAgain = 0;
+      CHECK(0 == GetScheduledFeatureGroups(test.GetBoosterHandle(), &countFeatureGroupsAgain, featureGroupIndexes));
+      CHECK(countFeatureGroups == countFeatureGroupsAgain);
+      for(IntEbmType i = 0; i < countFeatureGroups; ++i) {
+         test.Boost(featureGroupIndexes[i]);
+      }
+      CHECK(0 == AdvanceFeatureGroupSchedule(test.GetBoosterHandle()));
+   }
+
+   // without a schedule every feature group is visited every round
+   CHECK(0 == SetFeatureGroupSchedule(test.GetBoosterHandle(), FloatEbmType { 0.000001 }, IntEbmType { 0 }));
+   IntEbmType countFeatureGroups = 0;
+   IntEbmType featureGroupIndexes[2];
+   CHECK(0 == GetScheduledFeatureGroups(test.GetBoosterHandle(), &countFeatureGroups, featureGroupIndexes));
+   CHECK(2 == countFeatureGroups);
+}
+
+TEST_CASE("feature group schedule skips rounds where every feature group sits out, boosting, regression") {
+   TestApi test = TestApi(k_learningTypeRegression);
+   test.AddFeatures({ FeatureTest(2), FeatureTest(2) });
+   test.AddFeatureGroups({ { 0 }, { 1 } });
+   // every sample has the same target, so neither feature group ever has any gain
+   const std::vector<RegressionSample> samples = {
+      RegressionSample(0, { 0, 0 }),
+      RegressionSample(0, { 0, 1 }),
+      RegressionSample(0, { 1, 0 }),
+      RegressionSample(0, { 1, 1 }),
+   };
+   test.AddTrainingSamples(samples);
+   test.AddValidationSamples(samples);
+   test.InitializeBoosting();
+
+   CHECK(0 == SetFeatureGroupSchedule(test.GetBoosterHandle(), FloatEbmType { 0.000001 }, IntEbmType { 4 }));
+
+   // both feature groups sit out for the same rounds, and those rounds are skipped instead of coming back empty
+   for(size_t iRound = 0; iRound < 8; ++iRound) {
+      IntEbmType countFeatureGroups = 0;
+      IntEbmType featureGroupIndexes[2];
+      CHECK(0 == GetScheduledFeatureGroups(test.GetBoosterHandle(), &countFeatureGroups, featureGroupIndexes));
+      CHECK(2 == countFeatureGroups);
+      for(IntEbmType i = 0; i < countFeatureGroups; ++i) {
+         test.Boost(featureGroupIndexes[i]);
+      }
+      CHECK(0 == AdvanceFeatureGroupSchedule(test.GetBoosterHandle()));
+   }
+}
+
+TEST_CASE("more classes than the compiler optimized maximum, boosting, multiclass") {
+   // 12 classes is above k_cCompilerOptimizedTargetClassesMax, so this runs the k_dynamicClassification kernels
+   TestApi test = TestApi(12);
+   test.AddFeatures({ FeatureTest(2) });
+   test.AddFeatureGroups({ { 0 } });
+   const std::vector<ClassificationSample> samples = {
+      ClassificationSample(3, { 0 }),
+      ClassificationSample(9, { 1 }),
+      ClassificationSample(11, { 1 }),
+   };
+   test.AddTrainingSamples(samples);
+   test.AddValidationSamples(samples);
+   test.InitializeBoosting();
+
+   FloatEbmType validationMetric = FloatEbmType { std::numeric_limits<FloatEbmType>::quiet_NaN() };
+   for(int iEpoch = 0; iEpoch < 100; ++iEpoch) {
+      validationMetric = test.Boost(0);
+   }
+   CHECK_APPROX(validationMetric, 0.68058522542317712);
+   CHECK_APPROX(test.GetCurrentModelPredictorScore(0, { 0 }, 0), -1.0480347345892009);
+   CHECK_APPROX(test.GetCurrentModelPredictorScore(0, { 0 }, 3), 2.7519303071454861);
+   CHECK_APPROX(test.GetCurrentModelPredictorScore(0, { 1 }, 9), 1.6298931913388615);
+
+   // classes without any samples in a bin all get the same score in that bin
+   for(size_t iScore = 0; iScore < 12; ++iScore) {
+      if(3 != iScore) {
+         CHECK(test.GetCurrentModelPredictorScore(0, { 0 }, 0) == test.GetCurrentModelPredictorScore(0, { 0 }, iScore));
+      }
+      if(9 != iScore && 11 != iScore) {
+         CHECK(test.GetCurrentModelPredictorScore(0, { 1 }, 0) == test.GetCurrentModelPredictorScore(0, { 1 }, iScore));
+      }
+   }
+   CHECK(test.GetCurrentModelPredictorScore(0, { 1 }, 9) == test.GetCurrentModelPredictorScore(0, { 1 }, 11));
+}
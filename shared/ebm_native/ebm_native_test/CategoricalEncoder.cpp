@@ -0,0 +1,145 @@
+// Copyright (c) 2018 Microsoft Corporation
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#include "PrecompiledHeaderEbmNativeTest.h"
+
+#include "ebm_native.h"
+#include "EbmNativeTest.h"
+
+static const TestPriority k_filePriority = TestPriority::CategoricalEncoder;
+
+constexpr IntEbmType k_unknownBinIndex = IntEbmType { -1 };
+
+TEST_CASE("EncodeCategories, int64 categories with unknowns") {
+   const IntEbmType categories[] { 7, -3, 1000000000000, 0 };
+   const IntEbmType binIndexes[] { 1, 2, 3, 4 };
+   CategoricalEncoderHandle handle = CreateCategoricalEncoder(
+      CategoryType_Int64,
+      sizeof(IntEbmType),
+      sizeof(categories) / sizeof(categories[0]),
+      categories,
+      binIndexes
+   );
+   CHECK(nullptr != handle);
+
+   const IntEbmType values[] { 0, 7, 8, -3, 1000000000000, 7, -1000000000000 };
+   constexpr size_t cValues = sizeof(values) / sizeof(values[0]);
+   IntEbmType binIndexesOut[cValues];
+   const IntEbmType ret = EncodeCategories(handle, cValues, sizeof(IntEbmType), values, k_unknownBinIndex, binIndexesOut);
+   CHECK(0 == ret);
+
+   const IntEbmType expected[cValues] { 4, 1, k_unknownBinIndex, 2, 3, 1, k_unknownBinIndex };
+   for(size_t i = 0; i < cValues; ++i) {
+      CHECK(expected[i] == binIndexesOut[i]);
+   }
+
+   FreeCategoricalEncoder(handle);
+}
+
+TEST_CASE("EncodeCategories, float64 categories treat -0.0 and every NaN as one category") {
+   const FloatEbmType categories[] { 0.0, 2.5, std::numeric_limits<FloatEbmType>::quiet_NaN() };
+   const IntEbmType binIndexes[] { 1, 2, 0 };
+   CategoricalEncoderHandle handle = CreateCategoricalEncoder(
+      CategoryType_Float64,
+      sizeof(FloatEbmType),
+      sizeof(categories) / sizeof(categories[0]),
+      categories,
+      binIndexes
+   );
+   CHECK(nullptr != handle);
+
+   const FloatEbmType values[] {
+      -0.0,
+      2.5,
+      -std::numeric_limits<FloatEbmType>::quiet_NaN(),
+      std::numeric_limits<FloatEbmType>::signaling_NaN(),
+      std::nextafter(2.5, 3.0),
+      std::numeric_limits<FloatEbmType>::infinity()
+   };
+   constexpr size_t cValues = sizeof(values) / sizeof(values[0]);
+   IntEbmType binIndexesOut[cValues];
+   const IntEbmType ret = EncodeCategories(handle, cValues, sizeof(FloatEbmType), values, k_unknownBinIndex, binIndexesOut);
+   CHECK(0 == ret);
+
+   const IntEbmType expected[cValues] { 1, 2, 0, 0, k_unknownBinIndex, k_unknownBinIndex };
+   for(size_t i = 0; i < cValues; ++i) {
+      CHECK(expected[i] == binIndexesOut[i]);
+   }
+
+   FreeCategoricalEncoder(handle);
+}
+
+TEST_CASE("EncodeCategories, byte strings of different widths match after dropping the zero padding") {
+   // 4 byte wide categories, including the empty string and a duplicate where the last bin index wins
+   const char categories[] = "red\0blue\0\0\0\0" "a\0\0\0" "red\0";
+   const IntEbmType binIndexes[] { 1, 2, 0, 3, 4 };
+   CategoricalEncoderHandle handle = CreateCategoricalEncoder(CategoryType_Bytes, 4, 5, categories, binIndexes);
+   CHECK(nullptr != handle);
+
+   // 6 byte wide values
+   const char values[] = "blue\0\0" "red\0\0\0" "\0\0\0\0\0\0" "a\0\0\0\0\0" "green\0" "bluex\0";
+   constexpr size_t cValues = 6;
+   IntEbmType binIndexesOut[cValues];
+   const IntEbmType ret = EncodeCategories(handle, cValues, 6, values, k_unknownBinIndex, binIndexesOut);
+   CHECK(0 == ret);
+
+   const IntEbmType expected[cValues] { 2, 4, 0, 3, k_unknownBinIndex, k_unknownBinIndex };
+   for(size_t i = 0; i < cValues; ++i) {
+      CHECK(expected[i] == binIndexesOut[i]);
+   }
+
+   FreeCategoricalEncoder(handle);
+}
+
+TEST_CASE("EncodeCategories, many categories and samples across worker blocks") {
+   // enough categories to grow the hash table several times and enough samples to split across workers
+   constexpr size_t cCategories = 5000;
+   constexpr size_t cSamples = 20011;
+
+   std::vector<IntEbmType> categories(cCategories);
+   std::vector<IntEbmType> binIndexes(cCategories);
+   for(size_t iCategory = 0; iCategory < cCategories; ++iCategory) {
+      categories[iCategory] = static_cast<IntEbmType>(iCategory * 7919);
+      binIndexes[iCategory] = static_cast<IntEbmType>(iCategory + 1);
+   }
+   CategoricalEncoderHandle handle = CreateCategoricalEncoder(
+      CategoryType_Int64,
+      sizeof(IntEbmType),
+      cCategories,
+      &categories[0],
+      &binIndexes[0]
+   );
+   CHECK(nullptr != handle);
+
+   std::vector<IntEbmType> values(cSamples);
+   for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+      // every other sample lands between two categories
+      values[iSample] = static_cast<IntEbmType>(iSample % (cCategories + 100) * 7919 + iSample % 2);
+   }
+   std::vector<IntEbmType> binIndexesOut(cSamples);
+   const IntEbmType ret = EncodeCategories(handle, cSamples, sizeof(IntEbmType), &values[0], k_unknownBinIndex, &binIndexesOut[0]);
+   CHECK(0 == ret);
+
+   for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+      const size_t iCategory = iSample % (cCategories + 100);
+      const IntEbmType expected = 0 != iSample % 2 || cCategories <= iCategory ?
+         k_unknownBinIndex : static_cast<IntEbmType>(iCategory + 1);
+      CHECK(expected == binIndexesOut[iSample]);
+   }
+
+   FreeCategoricalEncoder(handle);
+}
+
+TEST_CASE("EncodeCategories, numeric categories must be 8 bytes") {
+   const IntEbmType categories[] { 1 };
+   const IntEbmType binIndexes[] { 1 };
+   CHECK(nullptr == CreateCategoricalEncoder(CategoryType_Int64, 4, 1, categories, binIndexes));
+   CHECK(nullptr == CreateCategoricalEncoder(CategoryTypeType { 99 }, sizeof(IntEbmType), 1, categories, binIndexes));
+
+   CategoricalEncoderHandle handle = CreateCategoricalEncoder(CategoryType_Float64, sizeof(FloatEbmType), 1, categories, binIndexes);
+   CHECK(nullptr != handle);
+   IntEbmType binIndexOut = 0;
+   CHECK(0 != EncodeCategories(handle, 1, 4, categories, k_unknownBinIndex, &binIndexOut));
+   FreeCategoricalEncoder(handle);
+}
@@ -101,3 +101,185 @@ TEST_CASE("Discretize, increasing lengths") {
    delete[] singleFeatureDiscretized;
 }
 
+
+TEST_CASE("Discretize, few samples match upper_bound for all search specializations") {
+   // the number of samples decides whether we pad the cuts, and it also decides how many values are left over after
+   // the interleaved loop, so try small sample counts against cut counts on either side of each specialization
+   constexpr size_t cSamplesMax = 9;
+   const size_t aCountCuts[] { 1, 2, 5, 6, 7, 14, 15, 30, 31, 62, 63, 126, 127, 254, 255, 510, 511, 1022, 1023, 1500 };
+
+   std::vector<FloatEbmType> cutsLowerBoundInclusive;
+   std::vector<FloatEbmType> featureValues(cSamplesMax);
+   std::vector<IntEbmType> discretized(cSamplesMax);
+   for(const size_t cCuts : aCountCuts) {
+      cutsLowerBoundInclusive.resize(cCuts);
+      for(size_t iCut = 0; iCut < cCuts; ++iCut) {
+         // irregular spacing so that cut values don't line up with their indexes
+         cutsLowerBoundInclusive[iCut] = static_cast<FloatEbmType>(iCut * iCut) * FloatEbmType { 0.25 } - FloatEbmType { 3 };
+      }
+      const FloatEbmType highest = cutsLowerBoundInclusive[cCuts - 1];
+      for(size_t cSamples = 1; cSamples <= cSamplesMax; ++cSamples) {
+         for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+            // walk the values across the whole range, landing exactly on some cuts and between others
+            const size_t iCut = (iSample * 7 + cSamples * 3) % (cCuts + 2);
+            FloatEbmType val;
+            if(cCuts + 1 == iCut) {
+               val = 0 == iSample % 2 ? std::numeric_limits<FloatEbmType>::quiet_NaN() : highest + FloatEbmType { 1 };
+            } else if(cCuts == iCut) {
+               val = 0 == iSample % 2 ? std::numeric_limits<FloatEbmType>::infinity() : -std::numeric_limits<FloatEbmType>::infinity();
+            } else {
+               val = cutsLowerBoundInclusive[iCut];
+               val = 0 == iSample % 3 ? std::nextafter(val, std::numeric_limits<FloatEbmType>::lowest()) : val;
+            }
+            featureValues[iSample] = val;
+         }
+
+         std::fill(discretized.begin(), discretized.end(), IntEbmType { -1 });
+         const IntEbmType ret = Discretize(
+            static_cast<IntEbmType>(cSamples),
+            &featureValues[0],
+            static_cast<IntEbmType>(cCuts),
+            &cutsLowerBoundInclusive[0],
+            &discretized[0]
+         );
+         CHECK(0 == ret);
+
+         for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+            const FloatEbmType val = featureValues[iSample];
+            const IntEbmType expected = std::isnan(val) ? IntEbmType { 0 } : IntEbmType { 1 } + static_cast<IntEbmType>(
+               std::upper_bound(cutsLowerBoundInclusive.begin(), cutsLowerBoundInclusive.end(), val) - cutsLowerBoundInclusive.begin());
+            CHECK(expected == discretized[iSample]);
+         }
+         CHECK(IntEbmType { -1 } == discretized[cSamplesMax - 1] || cSamplesMax == cSamples);
+      }
+   }
+}
+
+TEST_CASE("DiscretizeMatrix, row and column major match Discretize for every bin index width") {
+   // more features than a stripe and more samples than a block so that we cross both boundaries, with partial ones at the end
+   constexpr size_t cSamples = 1100;
+   constexpr size_t cFeatures = 70;
+
+   std::vector<IntEbmType> countCutsPerFeature(cFeatures);
+   std::vector<FloatEbmType> cuts;
+   for(size_t iFeature = 0; iFeature < cFeatures; ++iFeature) {
+      // feature 0 has no cuts, and the rest span the linear, padded and branchless searches but stay under 254 for 1 byte indexes
+      const size_t cCuts = iFeature * iFeature % 250;
+      countCutsPerFeature[iFeature] = static_cast<IntEbmType>(cCuts);
+      for(size_t iCut = 0; iCut < cCuts; ++iCut) {
+         cuts.push_back(static_cast<FloatEbmType>(iCut) - static_cast<FloatEbmType>(iFeature));
+      }
+   }
+   cuts.push_back(0); // so that &cuts[0] is valid if every feature had zero cuts
+
+   std::vector<FloatEbmType> rowMajor(cSamples * cFeatures);
+   std::vector<FloatEbmType> columnMajor(cSamples * cFeatures);
+   for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+      for(size_t iFeature = 0; iFeature < cFeatures; ++iFeature) {
+         FloatEbmType val = static_cast<FloatEbmType>((iSample * 37 + iFeature * 11) % 300) * FloatEbmType { 0.5 } - FloatEbmType { 60 };
+         val = 0 == (iSample + iFeature) % 29 ? std::numeric_limits<FloatEbmType>::quiet_NaN() : val;
+         rowMajor[iSample * cFeatures + iFeature] = val;
+         columnMajor[iFeature * cSamples + iSample] = val;
+      }
+   }
+
+   std::vector<IntEbmType> expected(cSamples * cFeatures);
+   const FloatEbmType * pCuts = &cuts[0];
+   for(size_t iFeature = 0; iFeature < cFeatures; ++iFeature) {
+      const IntEbmType ret = Discretize(
+         static_cast<IntEbmType>(cSamples),
+         &columnMajor[iFeature * cSamples],
+         countCutsPerFeature[iFeature],
+         pCuts,
+         &expected[iFeature * cSamples]
+      );
+      CHECK(0 == ret);
+      pCuts += countCutsPerFeature[iFeature];
+   }
+
+   for(int iOrder = 0; iOrder < 2; ++iOrder) {
+      const bool bColumnMajor = 0 != iOrder;
+      const FloatEbmType * const aFeatureValues = bColumnMajor ? &columnMajor[0] : &rowMajor[0];
+
+      std::vector<IntEbmType> discretized64(cSamples * cFeatures, IntEbmType { -1 });
+      IntEbmType ret = DiscretizeMatrix(
+         static_cast<IntEbmType>(cSamples),
+         static_cast<IntEbmType>(cFeatures),
+         aFeatureValues,
+         bColumnMajor ? EBM_TRUE : EBM_FALSE,
+         &countCutsPerFeature[0],
+         &cuts[0],
+         8,
+         &discretized64[0]
+      );
+      CHECK(0 == ret);
+      CHECK(expected == discretized64);
+
+      std::vector<uint8_t> discretized8(cSamples * cFeatures, uint8_t { 0xFF });
+      ret = DiscretizeMatrix(
+         static_cast<IntEbmType>(cSamples),
+         static_cast<IntEbmType>(cFeatures),
+         aFeatureValues,
+         bColumnMajor ? EBM_TRUE : EBM_FALSE,
+         &countCutsPerFeature[0],
+         &cuts[0],
+         1,
+         &discretized8[0]
+      );
+      CHECK(0 == ret);
+      std::vector<uint16_t> discretized16(cSamples * cFeatures, uint16_t { 0xFFFF });
+      ret = DiscretizeMatrix(
+         static_cast<IntEbmType>(cSamples),
+         static_cast<IntEbmType>(cFeatures),
+         aFeatureValues,
+         bColumnMajor ? EBM_TRUE : EBM_FALSE,
+         &countCutsPerFeature[0],
+         &cuts[0],
+         2,
+         &discretized16[0]
+      );
+      CHECK(0 == ret);
+      std::vector<uint32_t> discretized32(cSamples * cFeatures, uint32_t { 0xFFFFFFFF });
+      ret = DiscretizeMatrix(
+         static_cast<IntEbmType>(cSamples),
+         static_cast<IntEbmType>(cFeatures),
+         aFeatureValues,
+         bColumnMajor ? EBM_TRUE : EBM_FALSE,
+         &countCutsPerFeature[0],
+         &cuts[0],
+         4,
+         &discretized32[0]
+      );
+      CHECK(0 == ret);
+
+      for(size_t i = 0; i < cSamples * cFeatures; ++i) {
+         CHECK(expected[i] == static_cast<IntEbmType>(discretized8[i]));
+         CHECK(expected[i] == static_cast<IntEbmType>(discretized16[i]));
+         CHECK(expected[i] == static_cast<IntEbmType>(discretized32[i]));
+      }
+   }
+}
+
+TEST_CASE("DiscretizeMatrix, bin indexes that don't fit the requested width are an error") {
+   const FloatEbmType featureValues[] { 1, 2, 3 };
+   std::vector<FloatEbmType> cuts(300);
+   for(size_t iCut = 0; iCut < cuts.size(); ++iCut) {
+      cuts[iCut] = static_cast<FloatEbmType>(iCut);
+   }
+
+   // 254 cuts has a largest bin index of 255, which is the most that fits into a byte
+   IntEbmType countCuts = 254;
+   uint8_t discretized[3];
+   IntEbmType ret = DiscretizeMatrix(3, 1, featureValues, EBM_TRUE, &countCuts, &cuts[0], 1, discretized);
+   CHECK(0 == ret);
+   CHECK(3 == discretized[0]);
+   CHECK(5 == discretized[2]);
+
+   countCuts = 255;
+   ret = DiscretizeMatrix(3, 1, featureValues, EBM_TRUE, &countCuts, &cuts[0], 1, discretized);
+   CHECK(0 != ret);
+
+   countCuts = 255;
+   ret = DiscretizeMatrix(3, 1, featureValues, EBM_TRUE, &countCuts, &cuts[0], 3, discretized);
+   CHECK(0 != ret);
+}
@@ -17,7 +17,10 @@ enum class TestPriority {
    Discretize,
    GenerateUniformCuts,
    GenerateWinsorizedCuts,
-   GenerateQuantileCuts
+   GenerateQuantileCuts,
+   GenerateCoarseCuts,
+   StreamingBinning,
+   CategoricalEncoder
 };
 
 class TestCaseHidden;
@@ -347,6 +350,14 @@ public:
       return m_featureGroupsFeatureCount.size();
    }
 
+   inline BoosterHandle GetBoosterHandle() const {
+      return m_boosterHandle;
+   }
+
+   inline InteractionDetectorHandle GetInteractionDetectorHandle() const {
+      return m_interactionDetectorHandle;
+   }
+
    void AddFeatures(const std::vector<FeatureTest> features);
    void AddFeatureGroups(const std::vector<std::vector<size_t>> featureGroups);
    void AddTrainingSamples(const std::vector<RegressionSample> samples);
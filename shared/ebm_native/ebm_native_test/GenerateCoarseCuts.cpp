@@ -0,0 +1,189 @@
+// Copyright (c) 2018 Microsoft Corporation
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#include "PrecompiledHeaderEbmNativeTest.h"
+
+#include "ebm_native.h"
+#include "EbmNativeTest.h"
+
+static const TestPriority k_filePriority = TestPriority::GenerateCoarseCuts;
+
+constexpr FloatEbmType illegalVal = FloatEbmType { -888.88 };
+
+TEST_CASE("GenerateCoarseCuts, 0 samples") {
+   const std::vector<FloatEbmType> cutsLowerBoundInclusive { 1, 2, 3 };
+   IntEbmType countCoarseCuts = 1;
+   std::vector<FloatEbmType> coarseCutsLowerBoundInclusive(1, illegalVal);
+
+   const IntEbmType ret = GenerateCoarseCuts(
+      0,
+      nullptr,
+      cutsLowerBoundInclusive.size(),
+      &cutsLowerBoundInclusive[0],
+      1,
+      &countCoarseCuts,
+      &coarseCutsLowerBoundInclusive[0],
+      nullptr
+   );
+   CHECK(0 == ret);
+   CHECK(0 == countCoarseCuts);
+}
+
+TEST_CASE("GenerateCoarseCuts, fine cuts already fit") {
+   const std::vector<FloatEbmType> cutsLowerBoundInclusive { 1, 2 };
+   const std::vector<IntEbmType> discretized { 0, 1, 2, 3, 3, 1 };
+   IntEbmType countCoarseCuts = 5;
+   std::vector<FloatEbmType> coarseCutsLowerBoundInclusive(5, illegalVal);
+   std::vector<IntEbmType> coarseDiscretized(discretized.size(), -1);
+
+   const IntEbmType ret = GenerateCoarseCuts(
+      discretized.size(),
+      &discretized[0],
+      cutsLowerBoundInclusive.size(),
+      &cutsLowerBoundInclusive[0],
+      1,
+      &countCoarseCuts,
+      &coarseCutsLowerBoundInclusive[0],
+      &coarseDiscretized[0]
+   );
+   CHECK(0 == ret);
+   CHECK(2 == countCoarseCuts);
+   CHECK(1 == coarseCutsLowerBoundInclusive[0]);
+   CHECK(2 == coarseCutsLowerBoundInclusive[1]);
+   CHECK(discretized == coarseDiscretized);
+}
+
+TEST_CASE("GenerateCoarseCuts, even fine bins merge evenly and match Discretize") {
+   const std::vector<FloatEbmType> cutsLowerBoundInclusive { 1, 2, 3, 4, 5, 6, 7 };
+   std::vector<FloatEbmType> featureValues;
+   for(size_t i = 0; i < 80; ++i) {
+      featureValues.push_back(FloatEbmType { 0.05 } + static_cast<FloatEbmType>(i) / FloatEbmType { 10 });
+   }
+   for(size_t i = 0; i < 5; ++i) {
+      featureValues.push_back(std::numeric_limits<FloatEbmType>::quiet_NaN());
+   }
+   std::vector<IntEbmType> discretized(featureValues.size());
+   IntEbmType ret = Discretize(
+      featureValues.size(),
+      &featureValues[0],
+      cutsLowerBoundInclusive.size(),
+      &cutsLowerBoundInclusive[0],
+      &discretized[0]
+   );
+   CHECK(0 == ret);
+
+   IntEbmType countCoarseCuts = 3;
+   std::vector<FloatEbmType> coarseCutsLowerBoundInclusive(3, illegalVal);
+   std::vector<IntEbmType> coarseDiscretized(discretized.size(), -1);
+   ret = GenerateCoarseCuts(
+      discretized.size(),
+      &discretized[0],
+      cutsLowerBoundInclusive.size(),
+      &cutsLowerBoundInclusive[0],
+      1,
+      &countCoarseCuts,
+      &coarseCutsLowerBoundInclusive[0],
+      &coarseDiscretized[0]
+   );
+   CHECK(0 == ret);
+   CHECK(3 == countCoarseCuts);
+   CHECK(2 == coarseCutsLowerBoundInclusive[0]);
+   CHECK(4 == coarseCutsLowerBoundInclusive[1]);
+   CHECK(6 == coarseCutsLowerBoundInclusive[2]);
+
+   // the coarse cuts are a subset of the fine cuts, so binning the original values with them gives the same bins
+   std::vector<IntEbmType> expectedDiscretized(featureValues.size());
+   ret = Discretize(
+      featureValues.size(),
+      &featureValues[0],
+      countCoarseCuts,
+      &coarseCutsLowerBoundInclusive[0],
+      &expectedDiscretized[0]
+   );
+   CHECK(0 == ret);
+   CHECK(expectedDiscretized == coarseDiscretized);
+   CHECK(0 == coarseDiscretized[80]);
+}
+
+TEST_CASE("GenerateCoarseCuts, heavy fine bin") {
+   const std::vector<FloatEbmType> cutsLowerBoundInclusive { 1, 2, 3, 4 };
+   // fine bin 3 holds most of the samples, so it ends up alone in its coarse bin
+   std::vector<IntEbmType> discretized { 1, 2, 4, 5, 0 };
+   for(size_t i = 0; i < 10; ++i) {
+      discretized.push_back(3);
+   }
+   IntEbmType countCoarseCuts = 2;
+   std::vector<FloatEbmType> coarseCutsLowerBoundInclusive(2, illegalVal);
+   std::vector<IntEbmType> coarseDiscretized(discretized.size(), -1);
+
+   const IntEbmType ret = GenerateCoarseCuts(
+      discretized.size(),
+      &discretized[0],
+      cutsLowerBoundInclusive.size(),
+      &cutsLowerBoundInclusive[0],
+      1,
+      &countCoarseCuts,
+      &coarseCutsLowerBoundInclusive[0],
+      &coarseDiscretized[0]
+   );
+   CHECK(0 == ret);
+   CHECK(2 == countCoarseCuts);
+   CHECK(2 == coarseCutsLowerBoundInclusive[0]);
+   CHECK(3 == coarseCutsLowerBoundInclusive[1]);
+   CHECK(1 == coarseDiscretized[0]);
+   CHECK(1 == coarseDiscretized[1]);
+   CHECK(3 == coarseDiscretized[2]);
+   CHECK(3 == coarseDiscretized[3]);
+   CHECK(0 == coarseDiscretized[4]);
+   CHECK(2 == coarseDiscretized[5]);
+}
+
+TEST_CASE("GenerateCoarseCuts, countSamplesPerBinMin") {
+   const std::vector<FloatEbmType> cutsLowerBoundInclusive { 1, 2, 3, 4, 5, 6, 7 };
+   std::vector<IntEbmType> discretized;
+   for(IntEbmType iBin = 1; iBin <= 8; ++iBin) {
+      for(size_t i = 0; i < 10; ++i) {
+         discretized.push_back(iBin);
+      }
+   }
+   IntEbmType countCoarseCuts = 3;
+   std::vector<FloatEbmType> coarseCutsLowerBoundInclusive(3, illegalVal);
+   std::vector<IntEbmType> coarseDiscretized(discretized.size(), -1);
+
+   const IntEbmType ret = GenerateCoarseCuts(
+      discretized.size(),
+      &discretized[0],
+      cutsLowerBoundInclusive.size(),
+      &cutsLowerBoundInclusive[0],
+      25,
+      &countCoarseCuts,
+      &coarseCutsLowerBoundInclusive[0],
+      &coarseDiscretized[0]
+   );
+   CHECK(0 == ret);
+   CHECK(1 == countCoarseCuts);
+   CHECK(3 == coarseCutsLowerBoundInclusive[0]);
+   CHECK(1 == coarseDiscretized[29]);
+   CHECK(2 == coarseDiscretized[30]);
+}
+
+TEST_CASE("GenerateCoarseCuts, discretized value out of range") {
+   const std::vector<FloatEbmType> cutsLowerBoundInclusive { 1, 2, 3 };
+   const std::vector<IntEbmType> discretized { 1, 5, 2 };
+   IntEbmType countCoarseCuts = 1;
+   std::vector<FloatEbmType> coarseCutsLowerBoundInclusive(1, illegalVal);
+
+   const IntEbmType ret = GenerateCoarseCuts(
+      discretized.size(),
+      &discretized[0],
+      cutsLowerBoundInclusive.size(),
+      &cutsLowerBoundInclusive[0],
+      1,
+      &countCoarseCuts,
+      &coarseCutsLowerBoundInclusive[0],
+      nullptr
+   );
+   CHECK(0 != ret);
+   CHECK(0 == countCoarseCuts);
+}
@@ -1593,3 +1593,540 @@ TEST_CASE("GenerateQuantileCuts, chunky randomized check") {
    }
 }
 
+
+TEST_CASE("GenerateQuantileCuts, large feature is independent of sample order") {
+   // large enough to go through the radix sort, and full of the values that a bit-based sort could get wrong
+   constexpr FloatEbmType illegalVal = FloatEbmType { -888.88 };
+   constexpr size_t cSamples = 5003;
+   constexpr IntEbmType countCutsMax = 40;
+
+   std::vector<FloatEbmType> featureValues(cSamples);
+   for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+      const size_t iMix = (iSample * 7919) % cSamples;
+      FloatEbmType val;
+      switch(iMix % 11) {
+      case 0:
+         val = -FloatEbmType { 0 };
+         break;
+      case 1:
+         val = FloatEbmType { 0 };
+         break;
+      case 2:
+         val = std::numeric_limits<FloatEbmType>::denorm_min() * static_cast<FloatEbmType>(iMix % 3);
+         break;
+      case 3:
+         val = -std::numeric_limits<FloatEbmType>::denorm_min();
+         break;
+      case 4:
+         val = 0 == iMix % 4 ? std::numeric_limits<FloatEbmType>::quiet_NaN() : -std::numeric_limits<FloatEbmType>::infinity();
+         break;
+      case 5:
+         val = std::numeric_limits<FloatEbmType>::infinity();
+         break;
+      default:
+         val = static_cast<FloatEbmType>(static_cast<double>(iMix % 257) - 128.5) * FloatEbmType { 1e3 };
+         break;
+      }
+      featureValues[iSample] = val;
+   }
+   std::vector<FloatEbmType> sortedValues(featureValues);
+   std::sort(sortedValues.begin(), sortedValues.end(), CompareFloatWithNan());
+
+   IntEbmType countCuts[2];
+   std::vector<FloatEbmType> cuts[2];
+   IntEbmType countMissingValues[2];
+   FloatEbmType minNonInfinityValue[2];
+   IntEbmType countNegativeInfinity[2];
+   FloatEbmType maxNonInfinityValue[2];
+   IntEbmType countPositiveInfinity[2];
+   for(size_t iPass = 0; iPass < 2; ++iPass) {
+      countCuts[iPass] = countCutsMax;
+      cuts[iPass].resize(static_cast<size_t>(countCutsMax) + 1, illegalVal);
+      const IntEbmType ret = GenerateQuantileCuts(
+         cSamples,
+         0 == iPass ? &featureValues[0] : &sortedValues[0],
+         3,
+         EBM_TRUE,
+         &countCuts[iPass],
+         &cuts[iPass][0],
+         &countMissingValues[iPass],
+         &minNonInfinityValue[iPass],
+         &countNegativeInfinity[iPass],
+         &maxNonInfinityValue[iPass],
+         &countPositiveInfinity[iPass]
+      );
+      CHECK(0 == ret);
+   }
+
+   CHECK(countCuts[0] == countCuts[1]);
+   CHECK(0 < countCuts[0]);
+   CHECK(countMissingValues[0] == countMissingValues[1]);
+   CHECK(minNonInfinityValue[0] == minNonInfinityValue[1]);
+   CHECK(countNegativeInfinity[0] == countNegativeInfinity[1]);
+   CHECK(maxNonInfinityValue[0] == maxNonInfinityValue[1]);
+   CHECK(countPositiveInfinity[0] == countPositiveInfinity[1]);
+   CHECK(FloatEbmType { -128.5e3 } == minNonInfinityValue[0]);
+   CHECK(FloatEbmType { 127.5e3 } == maxNonInfinityValue[0]);
+   const size_t cCuts = static_cast<size_t>(countCuts[0]);
+   for(size_t iCut = 0; iCut < cCuts; ++iCut) {
+      CHECK(cuts[0][iCut] == cuts[1][iCut]);
+      if(0 != iCut) {
+         CHECK(cuts[0][iCut - 1] < cuts[0][iCut]);
+      }
+   }
+   CHECK(illegalVal == cuts[0][cCuts]);
+}
+
+TEST_CASE("GenerateQuantileCuts, many uncuttable ranges") {
+   // every distinct value repeats often enough to form its own uncuttable range, which puts hundreds of
+   // CuttingRanges into the priority queue that doles out the cuts
+   constexpr FloatEbmType illegalVal = FloatEbmType { -888.88 };
+   constexpr size_t cDistinct = 500;
+   constexpr size_t cSamples = cDistinct * 20;
+   constexpr IntEbmType countCutsMax = static_cast<IntEbmType>(cDistinct) - 1;
+
+   std::vector<FloatEbmType> featureValues(cSamples);
+   for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+      featureValues[iSample] = static_cast<FloatEbmType>((iSample * 7919) % cSamples % cDistinct);
+   }
+
+   IntEbmType countCuts = countCutsMax;
+   std::vector<FloatEbmType> cuts(static_cast<size_t>(countCutsMax) + 1, illegalVal);
+   IntEbmType countMissingValues;
+   FloatEbmType minNonInfinityValue;
+   IntEbmType countNegativeInfinity;
+   FloatEbmType maxNonInfinityValue;
+   IntEbmType countPositiveInfinity;
+   const IntEbmType ret = GenerateQuantileCuts(
+      cSamples,
+      &featureValues[0],
+      1,
+      EBM_FALSE,
+      &countCuts,
+      &cuts[0],
+      &countMissingValues,
+      &minNonInfinityValue,
+      &countNegativeInfinity,
+      &maxNonInfinityValue,
+      &countPositiveInfinity
+   );
+   CHECK(0 == ret);
+   CHECK(0 == countMissingValues);
+   CHECK(0 == minNonInfinityValue);
+   CHECK(static_cast<FloatEbmType>(cDistinct - 1) == maxNonInfinityValue);
+
+   // there is exactly enough room to separate every distinct value from its neighbours
+   CHECK(countCutsMax == countCuts);
+   if(countCutsMax == countCuts) {
+      for(size_t iCut = 0; iCut < static_cast<size_t>(countCutsMax); ++iCut) {
+         CHECK(static_cast<FloatEbmType>(iCut) < cuts[iCut]);
+         CHECK(cuts[iCut] <= static_cast<FloatEbmType>(iCut + 1));
+      }
+   }
+   CHECK(illegalVal == cuts[static_cast<size_t>(countCutsMax)]);
+}
+
+TEST_CASE("GenerateQuantileCutsBatch, matches GenerateQuantileCuts on each feature in both layouts") {
+   constexpr FloatEbmType illegalVal = FloatEbmType { -888.88 };
+   constexpr size_t cSamples = 97;
+   constexpr size_t cFeatures = 5;
+   const std::vector<IntEbmType> countSamplesPerBinMin { 1, 3, 2, 1, 60 };
+   const std::vector<IntEbmType> countCutsMax { 10, 7, 0, 4, 3 };
+
+   std::vector<FloatEbmType> columnMajor(cSamples * cFeatures);
+   for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+      columnMajor[0 * cSamples + iSample] = static_cast<FloatEbmType>((iSample * 37) % 101);
+      columnMajor[1 * cSamples + iSample] = 0 == iSample % 13 ? std::numeric_limits<FloatEbmType>::quiet_NaN() : 
+         static_cast<FloatEbmType>(iSample % 9) / FloatEbmType { 3 };
+      columnMajor[2 * cSamples + iSample] = static_cast<FloatEbmType>(iSample);
+      columnMajor[3 * cSamples + iSample] = 0 == iSample % 7 ? std::numeric_limits<FloatEbmType>::infinity() :
+         1 == iSample % 7 ? -std::numeric_limits<FloatEbmType>::infinity() : static_cast<FloatEbmType>(iSample % 5);
+      columnMajor[4 * cSamples + iSample] = static_cast<FloatEbmType>(iSample % 4);
+   }
+   std::vector<FloatEbmType> rowMajor(cSamples * cFeatures);
+   for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+      for(size_t iFeature = 0; iFeature < cFeatures; ++iFeature) {
+         rowMajor[iSample * cFeatures + iFeature] = columnMajor[iFeature * cSamples + iSample];
+      }
+   }
+
+   std::vector<IntEbmType> countCutsExpected(countCutsMax);
+   std::vector<FloatEbmType> cutsExpected;
+   std::vector<IntEbmType> countMissingValuesExpected(cFeatures);
+   std::vector<FloatEbmType> minNonInfinityValueExpected(cFeatures);
+   std::vector<IntEbmType> countNegativeInfinityExpected(cFeatures);
+   std::vector<FloatEbmType> maxNonInfinityValueExpected(cFeatures);
+   std::vector<IntEbmType> countPositiveInfinityExpected(cFeatures);
+   for(size_t iFeature = 0; iFeature < cFeatures; ++iFeature) {
+      std::vector<FloatEbmType> cuts(static_cast<size_t>(countCutsMax[iFeature]) + 1, illegalVal);
+      const IntEbmType ret = GenerateQuantileCuts(
+         cSamples,
+         &columnMajor[iFeature * cSamples],
+         countSamplesPerBinMin[iFeature],
+         EBM_TRUE,
+         &countCutsExpected[iFeature],
+         &cuts[0],
+         &countMissingValuesExpected[iFeature],
+         &minNonInfinityValueExpected[iFeature],
+         &countNegativeInfinityExpected[iFeature],
+         &maxNonInfinityValueExpected[iFeature],
+         &countPositiveInfinityExpected[iFeature]
+      );
+      CHECK(0 == ret);
+      // pad each feature to the room it asked for, which is how the batch packs its cuts
+      cuts.resize(static_cast<size_t>(countCutsMax[iFeature]));
+      cutsExpected.insert(cutsExpected.end(), cuts.begin(), cuts.end());
+   }
+
+   for(const BoolEbmType isColumnMajor : { EBM_TRUE, EBM_FALSE }) {
+      std::vector<IntEbmType> countCuts(countCutsMax);
+      std::vector<FloatEbmType> cuts(cutsExpected.size(), illegalVal);
+      std::vector<IntEbmType> countMissingValues(cFeatures, -1);
+      std::vector<FloatEbmType> minNonInfinityValue(cFeatures, illegalVal);
+      std::vector<IntEbmType> countNegativeInfinity(cFeatures, -1);
+      std::vector<FloatEbmType> maxNonInfinityValue(cFeatures, illegalVal);
+      std::vector<IntEbmType> countPositiveInfinity(cFeatures, -1);
+      const IntEbmType ret = GenerateQuantileCutsBatch(
+         cSamples,
+         cFeatures,
+         EBM_FALSE != isColumnMajor ? &columnMajor[0] : &rowMajor[0],
+         isColumnMajor,
+         &countSamplesPerBinMin[0],
+         EBM_TRUE,
+         &countCuts[0],
+         &cuts[0],
+         &countMissingValues[0],
+         &minNonInfinityValue[0],
+         &countNegativeInfinity[0],
+         &maxNonInfinityValue[0],
+         &countPositiveInfinity[0]
+      );
+      CHECK(0 == ret);
+      CHECK(countCutsExpected == countCuts);
+      CHECK(countMissingValuesExpected == countMissingValues);
+      CHECK(minNonInfinityValueExpected == minNonInfinityValue);
+      CHECK(countNegativeInfinityExpected == countNegativeInfinity);
+      CHECK(maxNonInfinityValueExpected == maxNonInfinityValue);
+      CHECK(countPositiveInfinityExpected == countPositiveInfinity);
+      size_t iCutFirst = 0;
+      for(size_t iFeature = 0; iFeature < cFeatures; ++iFeature) {
+         for(IntEbmType iCut = 0; iCut < countCuts[iFeature]; ++iCut) {
+            CHECK(cutsExpected[iCutFirst + static_cast<size_t>(iCut)] == cuts[iCutFirst + static_cast<size_t>(iCut)]);
+         }
+         iCutFirst += static_cast<size_t>(countCutsMax[iFeature]);
+      }
+   }
+}
+
+TEST_CASE("GenerateQuantileCutsBatch, bad parameters") {
+   constexpr FloatEbmType illegalVal = FloatEbmType { -888.88 };
+   const std::vector<FloatEbmType> featureValues { 1, 2, 3, 4 };
+   const std::vector<IntEbmType> countSamplesPerBinMin { 1, 1 };
+   std::vector<FloatEbmType> cuts(2, illegalVal);
+
+   std::vector<IntEbmType> countCuts { 1, -1 };
+   IntEbmType ret = GenerateQuantileCutsBatch(2, 2, &featureValues[0], EBM_TRUE, &countSamplesPerBinMin[0], EBM_FALSE, 
+      &countCuts[0], &cuts[0], nullptr, nullptr, nullptr, nullptr, nullptr);
+   CHECK(0 != ret);
+
+   countCuts = { 1, 1 };
+   ret = GenerateQuantileCutsBatch(2, 2, &featureValues[0], EBM_TRUE, &countSamplesPerBinMin[0], EBM_FALSE, 
+      &countCuts[0], nullptr, nullptr, nullptr, nullptr, nullptr, nullptr);
+   CHECK(0 != ret);
+
+   ret = GenerateQuantileCutsBatch(2, -1, &featureValues[0], EBM_TRUE, &countSamplesPerBinMin[0], EBM_FALSE, 
+      &countCuts[0], &cuts[0], nullptr, nullptr, nullptr, nullptr, nullptr);
+   CHECK(0 != ret);
+
+   // zero samples is legal and gives no cuts
+   ret = GenerateQuantileCutsBatch(0, 2, nullptr, EBM_TRUE, nullptr, EBM_FALSE, 
+      &countCuts[0], nullptr, nullptr, nullptr, nullptr, nullptr, nullptr);
+   CHECK(0 == ret);
+   CHECK(0 == countCuts[0]);
+   CHECK(0 == countCuts[1]);
+}
+
+TEST_CASE("GenerateQuantileCutsResolutions, matches GenerateQuantileCuts at each resolution") {
+   constexpr FloatEbmType illegalVal = FloatEbmType { -888.88 };
+   // large enough to use the radix sort, and with a long run of equal values so the resolutions get different cutting ranges
+   constexpr size_t cSamples = 3001;
+   const std::vector<IntEbmType> countCutsMax { 255, 0, 31, 3, 1, 5000, 31 };
+
+   std::vector<FloatEbmType> featureValues(cSamples);
+   for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+      featureValues[iSample] = 0 == iSample % 97 ? std::numeric_limits<FloatEbmType>::quiet_NaN() :
+         0 == iSample % 101 ? std::numeric_limits<FloatEbmType>::infinity() :
+         0 == iSample % 3 ? FloatEbmType { 7 } : static_cast<FloatEbmType>((iSample * 7919) % 1009) / FloatEbmType { 8 };
+   }
+
+   for(const BoolEbmType isHumanized : { EBM_TRUE, EBM_FALSE }) {
+      std::vector<IntEbmType> countCutsExpected(countCutsMax);
+      std::vector<FloatEbmType> cutsExpected;
+      IntEbmType countMissingValuesExpected;
+      FloatEbmType minNonInfinityValueExpected;
+      IntEbmType countNegativeInfinityExpected;
+      FloatEbmType maxNonInfinityValueExpected;
+      IntEbmType countPositiveInfinityExpected;
+      for(size_t iResolution = 0; iResolution < countCutsMax.size(); ++iResolution) {
+         std::vector<FloatEbmType> cuts(static_cast<size_t>(countCutsMax[iResolution]) + 1, illegalVal);
+         const IntEbmType ret = GenerateQuantileCuts(
+            cSamples,
+            &featureValues[0],
+            2,
+            isHumanized,
+            &countCutsExpected[iResolution],
+            &cuts[0],
+            &countMissingValuesExpected,
+            &minNonInfinityValueExpected,
+            &countNegativeInfinityExpected,
+            &maxNonInfinityValueExpected,
+            &countPositiveInfinityExpected
+         );
+         CHECK(0 == ret);
+         // pad each resolution to the room it asked for, which is how the resolutions are packed
+         cuts.resize(static_cast<size_t>(countCutsMax[iResolution]));
+         cutsExpected.insert(cutsExpected.end(), cuts.begin(), cuts.end());
+      }
+
+      std::vector<IntEbmType> countCuts(countCutsMax);
+      std::vector<FloatEbmType> cuts(cutsExpected.size(), illegalVal);
+      IntEbmType countMissingValues = -1;
+      FloatEbmType minNonInfinityValue = illegalVal;
+      IntEbmType countNegativeInfinity = -1;
+      FloatEbmType maxNonInfinityValue = illegalVal;
+      IntEbmType countPositiveInfinity = -1;
+      const IntEbmType ret = GenerateQuantileCutsResolutions(
+         cSamples,
+         &featureValues[0],
+         2,
+         isHumanized,
+         static_cast<IntEbmType>(countCutsMax.size()),
+         &countCuts[0],
+         &cuts[0],
+         &countMissingValues,
+         &minNonInfinityValue,
+         &countNegativeInfinity,
+         &maxNonInfinityValue,
+         &countPositiveInfinity
+      );
+      CHECK(0 == ret);
+      CHECK(countCutsExpected == countCuts);
+      CHECK(countMissingValuesExpected == countMissingValues);
+      CHECK(minNonInfinityValueExpected == minNonInfinityValue);
+      CHECK(countNegativeInfinityExpected == countNegativeInfinity);
+      CHECK(maxNonInfinityValueExpected == maxNonInfinityValue);
+      CHECK(countPositiveInfinityExpected == countPositiveInfinity);
+      size_t iCutFirst = 0;
+      for(size_t iResolution = 0; iResolution < countCutsMax.size(); ++iResolution) {
+         for(IntEbmType iCut = 0; iCut < countCuts[iResolution]; ++iCut) {
+            CHECK(cutsExpected[iCutFirst + static_cast<size_t>(iCut)] == cuts[iCutFirst + static_cast<size_t>(iCut)]);
+         }
+         iCutFirst += static_cast<size_t>(countCutsMax[iResolution]);
+      }
+   }
+}
+
+TEST_CASE("GenerateQuantileCutsResolutions, bad parameters") {
+   constexpr FloatEbmType illegalVal = FloatEbmType { -888.88 };
+   const std::vector<FloatEbmType> featureValues { 1, 2, 3, 4 };
+   std::vector<FloatEbmType> cuts(2, illegalVal);
+
+   std::vector<IntEbmType> countCuts { 1, -1 };
+   IntEbmType ret = GenerateQuantileCutsResolutions(4, &featureValues[0], 1, EBM_FALSE, 2, 
+      &countCuts[0], &cuts[0], nullptr, nullptr, nullptr, nullptr, nullptr);
+   CHECK(0 != ret);
+   CHECK(0 == countCuts[0]);
+   CHECK(0 == countCuts[1]);
+
+   countCuts = { 1, 1 };
+   ret = GenerateQuantileCutsResolutions(4, &featureValues[0], 1, EBM_FALSE, 2, 
+      &countCuts[0], nullptr, nullptr, nullptr, nullptr, nullptr, nullptr);
+   CHECK(0 != ret);
+
+   ret = GenerateQuantileCutsResolutions(4, &featureValues[0], 1, EBM_FALSE, -1, 
+      &countCuts[0], &cuts[0], nullptr, nullptr, nullptr, nullptr, nullptr);
+   CHECK(0 != ret);
+
+   ret = GenerateQuantileCutsResolutions(4, &featureValues[0], 1, EBM_FALSE, 2, 
+      nullptr, &cuts[0], nullptr, nullptr, nullptr, nullptr, nullptr);
+   CHECK(0 != ret);
+
+   // zero resolutions is legal and still reports the statistics
+   IntEbmType countMissingValues = -1;
+   FloatEbmType maxNonInfinityValue = illegalVal;
+   ret = GenerateQuantileCutsResolutions(4, &featureValues[0], 1, EBM_FALSE, 0, 
+      nullptr, nullptr, &countMissingValues, nullptr, nullptr, &maxNonInfinityValue, nullptr);
+   CHECK(0 == ret);
+   CHECK(0 == countMissingValues);
+   CHECK(FloatEbmType { 4 } == maxNonInfinityValue);
+}
+
+TEST_CASE("GenerateQuantileCutsFromSketch, uncompacted sketch over chunks matches GenerateQuantileCuts") {
+   constexpr FloatEbmType illegalVal = FloatEbmType { -888.88 };
+   constexpr size_t cSamples = 503;
+   constexpr IntEbmType countCutsMax = 12;
+
+   std::vector<FloatEbmType> featureValues(cSamples);
+   for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+      featureValues[iSample] = 0 == iSample % 17 ? std::numeric_limits<FloatEbmType>::quiet_NaN() :
+         0 == iSample % 23 ? std::numeric_limits<FloatEbmType>::infinity() :
+         0 == iSample % 29 ? -std::numeric_limits<FloatEbmType>::infinity() :
+         static_cast<FloatEbmType>((iSample * 31) % 97) / FloatEbmType { 4 };
+   }
+
+   IntEbmType countCutsExpected = countCutsMax;
+   std::vector<FloatEbmType> cutsExpected(static_cast<size_t>(countCutsMax), illegalVal);
+   IntEbmType countMissingValuesExpected;
+   FloatEbmType minNonInfinityValueExpected;
+   IntEbmType countNegativeInfinityExpected;
+   FloatEbmType maxNonInfinityValueExpected;
+   IntEbmType countPositiveInfinityExpected;
+   IntEbmType ret = GenerateQuantileCuts(
+      cSamples,
+      &featureValues[0],
+      3,
+      EBM_TRUE,
+      &countCutsExpected,
+      &cutsExpected[0],
+      &countMissingValuesExpected,
+      &minNonInfinityValueExpected,
+      &countNegativeInfinityExpected,
+      &maxNonInfinityValueExpected,
+      &countPositiveInfinityExpected
+   );
+   CHECK(0 == ret);
+
+   QuantileSketchHandle quantileSketchHandle = CreateQuantileSketch(42, 0);
+   CHECK(nullptr != quantileSketchHandle);
+   // uneven chunks, including an empty one
+   ret = AddToQuantileSketch(quantileSketchHandle, 100, &featureValues[0]);
+   CHECK(0 == ret);
+   ret = AddToQuantileSketch(quantileSketchHandle, 0, nullptr);
+   CHECK(0 == ret);
+   ret = AddToQuantileSketch(quantileSketchHandle, static_cast<IntEbmType>(cSamples - 100), &featureValues[100]);
+   CHECK(0 == ret);
+
+   IntEbmType countCuts = countCutsMax;
+   std::vector<FloatEbmType> cuts(static_cast<size_t>(countCutsMax), illegalVal);
+   IntEbmType countMissingValues;
+   FloatEbmType minNonInfinityValue;
+   IntEbmType countNegativeInfinity;
+   FloatEbmType maxNonInfinityValue;
+   IntEbmType countPositiveInfinity;
+   ret = GenerateQuantileCutsFromSketch(
+      quantileSketchHandle,
+      3,
+      EBM_TRUE,
+      &countCuts,
+      &cuts[0],
+      &countMissingValues,
+      &minNonInfinityValue,
+      &countNegativeInfinity,
+      &maxNonInfinityValue,
+      &countPositiveInfinity
+   );
+   CHECK(0 == ret);
+   FreeQuantileSketch(quantileSketchHandle);
+
+   CHECK(countCutsExpected == countCuts);
+   CHECK(cutsExpected == cuts);
+   CHECK(countMissingValuesExpected == countMissingValues);
+   CHECK(minNonInfinityValueExpected == minNonInfinityValue);
+   CHECK(countNegativeInfinityExpected == countNegativeInfinity);
+   CHECK(maxNonInfinityValueExpected == maxNonInfinityValue);
+   CHECK(countPositiveInfinityExpected == countPositiveInfinity);
+}
+
+TEST_CASE("GenerateQuantileCutsFromSketch, merged sketches approximate the quantiles of a large feature") {
+   constexpr size_t cSamples = 100000;
+   constexpr size_t cSketches = 4;
+   constexpr size_t cCuts = 9;
+
+   // a permutation of 0 to cSamples - 1 so that the exact deciles are known
+   std::vector<FloatEbmType> featureValues(cSamples);
+   for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+      featureValues[iSample] = static_cast<FloatEbmType>((iSample * 7919) % cSamples);
+   }
+
+   QuantileSketchHandle aQuantileSketchHandles[cSketches];
+   constexpr size_t cSamplesPerSketch = cSamples / cSketches;
+   for(size_t iSketch = 0; iSketch < cSketches; ++iSketch) {
+      aQuantileSketchHandles[iSketch] = CreateQuantileSketch(static_cast<SeedEbmType>(iSketch), 256);
+      CHECK(nullptr != aQuantileSketchHandles[iSketch]);
+      const IntEbmType ret = AddToQuantileSketch(
+         aQuantileSketchHandles[iSketch], 
+         cSamplesPerSketch, 
+         &featureValues[iSketch * cSamplesPerSketch]
+      );
+      CHECK(0 == ret);
+   }
+   for(size_t iSketch = 1; iSketch < cSketches; ++iSketch) {
+      const IntEbmType ret = MergeQuantileSketch(aQuantileSketchHandles[0], aQuantileSketchHandles[iSketch]);
+      CHECK(0 == ret);
+      FreeQuantileSketch(aQuantileSketchHandles[iSketch]);
+   }
+
+   IntEbmType countCuts = cCuts;
+   std::vector<FloatEbmType> cuts(cCuts);
+   IntEbmType countMissingValues;
+   FloatEbmType minNonInfinityValue;
+   IntEbmType countNegativeInfinity;
+   FloatEbmType maxNonInfinityValue;
+   IntEbmType countPositiveInfinity;
+   const IntEbmType ret = GenerateQuantileCutsFromSketch(
+      aQuantileSketchHandles[0],
+      1,
+      EBM_FALSE,
+      &countCuts,
+      &cuts[0],
+      &countMissingValues,
+      &minNonInfinityValue,
+      &countNegativeInfinity,
+      &maxNonInfinityValue,
+      &countPositiveInfinity
+   );
+   CHECK(0 == ret);
+   FreeQuantileSketch(aQuantileSketchHandles[0]);
+
+   CHECK(static_cast<IntEbmType>(cCuts) == countCuts);
+   for(size_t iCut = 0; iCut < cCuts; ++iCut) {
+      const FloatEbmType expected = static_cast<FloatEbmType>((iCut + 1) * (cSamples / (cCuts + 1)));
+      // the sketch is approximate, but 256 values per level keeps the rank error well under 2%
+      CHECK(std::abs(cuts[iCut] - expected) < FloatEbmType { 0.02 } * static_cast<FloatEbmType>(cSamples));
+   }
+   CHECK(0 == countMissingValues);
+   CHECK(FloatEbmType { 0 } == minNonInfinityValue);
+   CHECK(0 == countNegativeInfinity);
+   CHECK(static_cast<FloatEbmType>(cSamples - 1) == maxNonInfinityValue);
+   CHECK(0 == countPositiveInfinity);
+}
+
+TEST_CASE("GenerateQuantileCutsFromSketch, bad parameters") {
+   const FloatEbmType featureValues[] { 1, 2, 3 };
+
+   CHECK(nullptr == CreateQuantileSketch(0, -1));
+
+   QuantileSketchHandle quantileSketchHandle = CreateQuantileSketch(0, 1);
+   CHECK(nullptr != quantileSketchHandle);
+
+   CHECK(0 != AddToQuantileSketch(nullptr, 3, featureValues));
+   CHECK(0 != AddToQuantileSketch(quantileSketchHandle, -1, featureValues));
+   CHECK(0 != AddToQuantileSketch(quantileSketchHandle, 3, nullptr));
+   CHECK(0 != MergeQuantileSketch(quantileSketchHandle, nullptr));
+   CHECK(0 != MergeQuantileSketch(nullptr, quantileSketchHandle));
+   CHECK(0 != MergeQuantileSketch(quantileSketchHandle, quantileSketchHandle));
+
+   IntEbmType countCuts = 2;
+   FloatEbmType cuts[2];
+   CHECK(0 != GenerateQuantileCutsFromSketch(nullptr, 1, EBM_FALSE, &countCuts, cuts, nullptr, nullptr, nullptr, nullptr, nullptr));
+   CHECK(0 != GenerateQuantileCutsFromSketch(quantileSketchHandle, 1, EBM_FALSE, nullptr, cuts, nullptr, nullptr, nullptr, nullptr, nullptr));
+
+   // an empty sketch is legal and has no cuts
+   IntEbmType countMissingValues = -1;
+   CHECK(0 == GenerateQuantileCutsFromSketch(quantileSketchHandle, 1, EBM_FALSE, &countCuts, cuts, &countMissingValues, nullptr, nullptr, nullptr, nullptr));
+   CHECK(0 == countCuts);
+   CHECK(0 == countMissingValues);
+
+   FreeQuantileSketch(quantileSketchHandle);
+   FreeQuantileSketch(nullptr);
+}
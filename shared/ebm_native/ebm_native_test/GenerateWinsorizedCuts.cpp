@@ -1228,3 +1228,95 @@ TEST_CASE("GenerateWinsorizedCuts, 3 cuts, -infinity, lowest + 1, max - 1, and +
    }
 }
 
+
+TEST_CASE("GenerateWinsorizedCuts, one cut, many unsorted samples") {
+   // enough samples to take the radix selection path instead of std::nth_element
+   constexpr size_t cSamples = 4096;
+   IntEbmType countCuts = 1;
+
+   std::vector<FloatEbmType> featureValues(cSamples);
+   for(size_t i = 0; i < cSamples; ++i) {
+      // 2477 is coprime with 4096, so this visits every value from 0 to 4095 exactly once, out of order
+      featureValues[i] = static_cast<FloatEbmType>((i * size_t { 2477 }) % cSamples);
+   }
+   const std::vector<FloatEbmType> expectedCuts { 2047.5 };
+
+   IntEbmType countMissingValues;
+   FloatEbmType minNonInfinityValue;
+   IntEbmType countNegativeInfinity;
+   FloatEbmType maxNonInfinityValue;
+   IntEbmType countPositiveInfinity;
+   std::vector<FloatEbmType> cutsLowerBoundInclusive(static_cast<size_t>(countCuts), illegalVal);
+
+   IntEbmType ret = GenerateWinsorizedCuts(
+      featureValues.size(),
+      &featureValues[0],
+      &countCuts,
+      &cutsLowerBoundInclusive[0],
+      &countMissingValues,
+      &minNonInfinityValue,
+      &countNegativeInfinity,
+      &maxNonInfinityValue,
+      &countPositiveInfinity
+   );
+   CHECK(0 == ret);
+   CHECK(0 == countMissingValues);
+   CHECK(0 == minNonInfinityValue);
+   CHECK(0 == countNegativeInfinity);
+   CHECK(4095 == maxNonInfinityValue);
+   CHECK(0 == countPositiveInfinity);
+
+   size_t cCuts = static_cast<size_t>(countCuts);
+   CHECK(expectedCuts.size() == cCuts);
+   if(expectedCuts.size() == cCuts) {
+      for(size_t i = 0; i < cCuts; ++i) {
+         CHECK_APPROX(expectedCuts[i], cutsLowerBoundInclusive[i]);
+      }
+   }
+}
+
+TEST_CASE("GenerateWinsorizedCuts, one cut, many duplicated samples") {
+   // enough samples to take the radix selection path instead of std::nth_element
+   constexpr size_t cSamples = 4096;
+   IntEbmType countCuts = 1;
+
+   std::vector<FloatEbmType> featureValues(cSamples);
+   for(size_t i = 0; i < cSamples; ++i) {
+      // the median lands inside the long run of 3s, so the only cut separates the two values
+      featureValues[i] = size_t { 0 } == i % size_t { 3 } ? FloatEbmType { -1 } : FloatEbmType { 3 };
+   }
+   const std::vector<FloatEbmType> expectedCuts { 1 };
+
+   IntEbmType countMissingValues;
+   FloatEbmType minNonInfinityValue;
+   IntEbmType countNegativeInfinity;
+   FloatEbmType maxNonInfinityValue;
+   IntEbmType countPositiveInfinity;
+   std::vector<FloatEbmType> cutsLowerBoundInclusive(static_cast<size_t>(countCuts), illegalVal);
+
+   IntEbmType ret = GenerateWinsorizedCuts(
+      featureValues.size(),
+      &featureValues[0],
+      &countCuts,
+      &cutsLowerBoundInclusive[0],
+      &countMissingValues,
+      &minNonInfinityValue,
+      &countNegativeInfinity,
+      &maxNonInfinityValue,
+      &countPositiveInfinity
+   );
+   CHECK(0 == ret);
+   CHECK(0 == countMissingValues);
+   CHECK(-1 == minNonInfinityValue);
+   CHECK(0 == countNegativeInfinity);
+   CHECK(3 == maxNonInfinityValue);
+   CHECK(0 == countPositiveInfinity);
+
+   size_t cCuts = static_cast<size_t>(countCuts);
+   CHECK(expectedCuts.size() == cCuts);
+   if(expectedCuts.size() == cCuts) {
+      for(size_t i = 0; i < cCuts; ++i) {
+         CHECK_APPROX(expectedCuts[i], cutsLowerBoundInclusive[i]);
+      }
+   }
+}
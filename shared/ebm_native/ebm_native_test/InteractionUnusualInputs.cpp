@@ -135,3 +135,641 @@ TEST_CASE("FeatureGroup with one feature with one state, interaction, multiclass
 }
 
 
+
+TEST_CASE("batched feature groups match individual scores, interaction, regression") {
+   TestApi test = TestApi(k_learningTypeRegression);
+   test.AddFeatures({ FeatureTest(2), FeatureTest(3), FeatureTest(1), FeatureTest(4) });
+   test.AddInteractionSamples({
+      RegressionSample(1, { 0, 0, 0, 0 }),
+      RegressionSample(7, { 0, 1, 0, 1 }),
+      RegressionSample(2, { 1, 2, 0, 2 }),
+      RegressionSample(9, { 1, 0, 0, 3 }),
+      RegressionSample(4, { 0, 2, 0, 3 }),
+      RegressionSample(3, { 1, 1, 0, 0 }),
+      RegressionSample(8, { 0, 0, 0, 2 }),
+      RegressionSample(5, { 1, 2, 0, 1 }),
+   });
+   test.InitializeInteraction();
+
+   // feature 2 only has 1 bin, so any pair that includes it gets a zero score
+   const std::vector<IntEbmType> featureIndexes = { 0, 1, 0, 2, 0, 3, 1, 2, 1, 3, 2, 3, 3, 1 };
+   const size_t cFeatureGroups = featureIndexes.size() / 2;
+
+   std::vector<FloatEbmType> scoresExpected;
+   for(size_t iFeatureGroup = 0; iFeatureGroup < cFeatureGroups; ++iFeatureGroup) {
+      scoresExpected.push_back(test.InteractionScore({ featureIndexes[iFeatureGroup * 2], featureIndexes[iFeatureGroup * 2 + 1] }));
+   }
+   CHECK(0 == scoresExpected[1]);
+   CHECK(0 == scoresExpected[3]);
+   CHECK(0 == scoresExpected[5]);
+
+   std::vector<FloatEbmType> scores(cFeatureGroups, FloatEbmType { -1 });
+   IntEbmType ret = CalculateInteractionScores(
+      test.GetInteractionDetectorHandle(),
+      static_cast<IntEbmType>(cFeatureGroups),
+      2,
+      &featureIndexes[0],
+      k_countSamplesRequiredForChildSplitMinDefault,
+      0,
+      &scores[0],
+      nullptr
+   );
+   CHECK(0 == ret);
+   for(size_t iFeatureGroup = 0; iFeatureGroup < cFeatureGroups; ++iFeatureGroup) {
+      CHECK(scoresExpected[iFeatureGroup] == scores[iFeatureGroup]);
+   }
+
+   // the top 3 come back best first, and equal scores keep their original order
+   std::vector<FloatEbmType> scoresTop(3, FloatEbmType { -1 });
+   std::vector<IntEbmType> indexesTop(3, IntEbmType { -1 });
+   ret = CalculateInteractionScores(
+      test.GetInteractionDetectorHandle(),
+      static_cast<IntEbmType>(cFeatureGroups),
+      2,
+      &featureIndexes[0],
+      k_countSamplesRequiredForChildSplitMinDefault,
+      3,
+      &scoresTop[0],
+      &indexesTop[0]
+   );
+   CHECK(0 == ret);
+   for(size_t iTop = 0; iTop < 3; ++iTop) {
+      const size_t iFeatureGroup = static_cast<size_t>(indexesTop[iTop]);
+      CHECK(scoresExpected[iFeatureGroup] == scoresTop[iTop]);
+      size_t cBetter = 0;
+      for(size_t iOther = 0; iOther < cFeatureGroups; ++iOther) {
+         if(scoresExpected[iFeatureGroup] < scoresExpected[iOther] || 
+            scoresExpected[iFeatureGroup] == scoresExpected[iOther] && iOther < iFeatureGroup) {
+            ++cBetter;
+         }
+      }
+      CHECK(iTop == cBetter);
+   }
+
+   // the top-K requires somewhere to put the feature group indexes
+   ret = CalculateInteractionScores(
+      test.GetInteractionDetectorHandle(),
+      static_cast<IntEbmType>(cFeatureGroups),
+      2,
+      &featureIndexes[0],
+      k_countSamplesRequiredForChildSplitMinDefault,
+      3,
+      &scoresTop[0],
+      nullptr
+   );
+   CHECK(0 != ret);
+}
+
+TEST_CASE("batched pairs that share a feature match individual scores, interaction, multiclass") {
+   TestApi test = TestApi(3);
+   test.AddFeatures({ FeatureTest(3), FeatureTest(2), FeatureTest(4), FeatureTest(2) });
+   test.AddInteractionSamples({
+      ClassificationSample(0, { 0, 0, 0, 0 }),
+      ClassificationSample(1, { 1, 1, 3, 0 }),
+      ClassificationSample(2, { 2, 0, 2, 1 }),
+      ClassificationSample(0, { 1, 0, 1, 1 }),
+      ClassificationSample(2, { 0, 1, 3, 0 }),
+      ClassificationSample(1, { 2, 1, 0, 1 }),
+      ClassificationSample(0, { 2, 0, 1, 0 }),
+      ClassificationSample(1, { 0, 1, 2, 1 }),
+   });
+   test.InitializeInteraction();
+
+   // pairs are enumerated the usual way, so each run with the same first feature is binned in one shared pass
+   std::vector<IntEbmType> featureIndexes;
+   for(IntEbmType i0 = 0; i0 < 4; ++i0) {
+      for(IntEbmType i1 = i0 + 1; i1 < 4; ++i1) {
+         featureIndexes.push_back(i0);
+         featureIndexes.push_back(i1);
+      }
+   }
+   const size_t cFeatureGroups = featureIndexes.size() / 2;
+
+   std::vector<FloatEbmType> scores(cFeatureGroups, FloatEbmType { -1 });
+   const IntEbmType ret = CalculateInteractionScores(
+      test.GetInteractionDetectorHandle(),
+      static_cast<IntEbmType>(cFeatureGroups),
+      2,
+      &featureIndexes[0],
+      k_countSamplesRequiredForChildSplitMinDefault,
+      0,
+      &scores[0],
+      nullptr
+   );
+   CHECK(0 == ret);
+   for(size_t iFeatureGroup = 0; iFeatureGroup < cFeatureGroups; ++iFeatureGroup) {
+      const FloatEbmType scoreExpected = test.InteractionScore({ featureIndexes[iFeatureGroup * 2], featureIndexes[iFeatureGroup * 2 + 1] });
+      CHECK(scoreExpected == scores[iFeatureGroup]);
+   }
+}
+
+TEST_CASE("approximate scores are exact for the refined feature groups and repeatable for a seed, interaction, multiclass") {
+   TestApi test = TestApi(3);
+   test.AddFeatures({ FeatureTest(3), FeatureTest(2), FeatureTest(4), FeatureTest(2) });
+   test.AddInteractionSamples({
+      ClassificationSample(0, { 0, 0, 0, 0 }),
+      ClassificationSample(1, { 1, 1, 3, 0 }),
+      ClassificationSample(2, { 2, 0, 2, 1 }),
+      ClassificationSample(0, { 1, 0, 1, 1 }),
+      ClassificationSample(2, { 0, 1, 3, 0 }),
+      ClassificationSample(1, { 2, 1, 0, 1 }),
+      ClassificationSample(0, { 2, 0, 1, 0 }),
+      ClassificationSample(1, { 0, 1, 2, 1 }),
+   });
+   test.InitializeInteraction();
+
+   std::vector<IntEbmType> featureIndexes;
+   for(IntEbmType i0 = 0; i0 < 4; ++i0) {
+      for(IntEbmType i1 = i0 + 1; i1 < 4; ++i1) {
+         featureIndexes.push_back(i0);
+         featureIndexes.push_back(i1);
+      }
+   }
+   const size_t cFeatureGroups = featureIndexes.size() / 2;
+   constexpr size_t cFeatureGroupsTop = 2;
+
+   std::vector<FloatEbmType> scores1(cFeatureGroupsTop, FloatEbmType { -1 });
+   std::vector<IntEbmType> indexes1(cFeatureGroupsTop, IntEbmType { -1 });
+   IntEbmType ret = CalculateInteractionScoresApproximate(
+      test.GetInteractionDetectorHandle(),
+      static_cast<IntEbmType>(cFeatureGroups),
+      2,
+      &featureIndexes[0],
+      k_countSamplesRequiredForChildSplitMinDefault,
+      k_randomSeed,
+      5,
+      3,
+      static_cast<IntEbmType>(cFeatureGroupsTop),
+      &scores1[0],
+      &indexes1[0]
+   );
+   CHECK(0 == ret);
+
+   std::vector<FloatEbmType> scores2(cFeatureGroupsTop, FloatEbmType { -1 });
+   std::vector<IntEbmType> indexes2(cFeatureGroupsTop, IntEbmType { -1 });
+   ret = CalculateInteractionScoresApproximate(
+      test.GetInteractionDetectorHandle(),
+      static_cast<IntEbmType>(cFeatureGroups),
+      2,
+      &featureIndexes[0],
+      k_countSamplesRequiredForChildSplitMinDefault,
+      k_randomSeed,
+      5,
+      3,
+      static_cast<IntEbmType>(cFeatureGroupsTop),
+      &scores2[0],
+      &indexes2[0]
+   );
+   CHECK(0 == ret);
+
+   for(size_t iOut = 0; iOut < cFeatureGroupsTop; ++iOut) {
+      const IntEbmType iFeatureGroup = indexes1[iOut];
+      CHECK(0 <= iFeatureGroup);
+      CHECK(iFeatureGroup < static_cast<IntEbmType>(cFeatureGroups));
+      const size_t iFeatureGroupCast = static_cast<size_t>(iFeatureGroup);
+      const FloatEbmType scoreExpected = test.InteractionScore({ featureIndexes[iFeatureGroupCast * 2], featureIndexes[iFeatureGroupCast * 2 + 1] });
+      CHECK(scoreExpected == scores1[iOut]);
+      CHECK(indexes2[iOut] == indexes1[iOut]);
+      CHECK(scores2[iOut] == scores1[iOut]);
+   }
+   CHECK(indexes1[0] != indexes1[1]);
+   CHECK(scores1[1] <= scores1[0]);
+}
+
+TEST_CASE("pruned top pairs match the exact top pairs, interaction, regression") {
+   TestApi test = TestApi(k_learningTypeRegression);
+   test.AddFeatures({ FeatureTest(2), FeatureTest(2), FeatureTest(3), FeatureTest(2), FeatureTest(2) });
+   // features 0 and 1 form an XOR with the target.  Feature 4 has a single sample in its second bin, so with 2 samples required in each 
+   // quadrant it can't be split with anything
+   test.AddInteractionSamples({
+      RegressionSample(10, { 0, 0, 0, 0, 0 }),
+      RegressionSample(-10, { 0, 1, 1, 1, 0 }),
+      RegressionSample(-10, { 1, 0, 2, 0, 0 }),
+      RegressionSample(10, { 1, 1, 0, 1, 0 }),
+      RegressionSample(11, { 0, 0, 1, 1, 0 }),
+      RegressionSample(-9, { 0, 1, 2, 0, 0 }),
+      RegressionSample(-11, { 1, 0, 0, 1, 0 }),
+      RegressionSample(9, { 1, 1, 1, 0, 0 }),
+      RegressionSample(10, { 0, 0, 2, 0, 0 }),
+      RegressionSample(-10, { 0, 1, 0, 1, 0 }),
+      RegressionSample(-10, { 1, 0, 1, 0, 0 }),
+      RegressionSample(10, { 1, 1, 2, 1, 1 }),
+   });
+   test.InitializeInteraction();
+
+   std::vector<IntEbmType> featureIndexes;
+   for(IntEbmType i0 = 0; i0 < 5; ++i0) {
+      for(IntEbmType i1 = i0 + 1; i1 < 5; ++i1) {
+         featureIndexes.push_back(i0);
+         featureIndexes.push_back(i1);
+      }
+   }
+   const size_t cFeatureGroups = featureIndexes.size() / 2;
+   constexpr size_t cFeatureGroupsTop = 2;
+   constexpr IntEbmType countSamplesRequiredForChildSplitMin = 2;
+
+   std::vector<FloatEbmType> scoresExact(cFeatureGroupsTop, FloatEbmType { -1 });
+   std::vector<IntEbmType> indexesExact(cFeatureGroupsTop, IntEbmType { -1 });
+   IntEbmType ret = CalculateInteractionScores(
+      test.GetInteractionDetectorHandle(),
+      static_cast<IntEbmType>(cFeatureGroups),
+      2,
+      &featureIndexes[0],
+      countSamplesRequiredForChildSplitMin,
+      static_cast<IntEbmType>(cFeatureGroupsTop),
+      &scoresExact[0],
+      &indexesExact[0]
+   );
+   CHECK(0 == ret);
+
+   std::vector<FloatEbmType> scoresPruned(cFeatureGroupsTop, FloatEbmType { -1 });
+   std::vector<IntEbmType> indexesPruned(cFeatureGroupsTop, IntEbmType { -1 });
+   IntEbmType countFeatureGroupsSkipped = -1;
+   IntEbmType countFeatureGroupsPruned = -1;
+   ret = CalculateInteractionScoresPruned(
+      test.GetInteractionDetectorHandle(),
+      static_cast<IntEbmType>(cFeatureGroups),
+      2,
+      &featureIndexes[0],
+      countSamplesRequiredForChildSplitMin,
+      static_cast<IntEbmType>(cFeatureGroupsTop),
+      &scoresPruned[0],
+      &indexesPruned[0],
+      &countFeatureGroupsSkipped,
+      &countFeatureGroupsPruned
+   );
+   CHECK(0 == ret);
+
+   CHECK(0 == indexesExact[0]);
+   for(size_t iOut = 0; iOut < cFeatureGroupsTop; ++iOut) {
+      CHECK(indexesExact[iOut] == indexesPruned[iOut]);
+      CHECK(scoresExact[iOut] == scoresPruned[iOut]);
+   }
+   // every pair with feature 4 is skipped from its 1D counts
+   CHECK(4 == countFeatureGroupsSkipped);
+   CHECK(0 <= countFeatureGroupsPruned);
+   CHECK(countFeatureGroupsSkipped + countFeatureGroupsPruned <= static_cast<IntEbmType>(cFeatureGroups));
+}
+
+TEST_CASE("pruned top pairs match the exact top pairs with more bins than the coarse bins, interaction, regression") {
+   // 64 bins are more than the coarse bins that pruning bounds feature groups with before binning them
+   constexpr IntEbmType cBins = 64;
+   TestApi test = TestApi(k_learningTypeRegression);
+   test.AddFeatures({ FeatureTest(cBins), FeatureTest(cBins), FeatureTest(cBins), FeatureTest(cBins) });
+   // features 0 and 1 form an XOR with the target.  Features 2 and 3 are scrambled mixes of them, so every other pair sees a little of it
+   std::vector<RegressionSample> samples;
+   for(IntEbmType i0 = 0; i0 < cBins; ++i0) {
+      for(IntEbmType i1 = 0; i1 < cBins; ++i1) {
+         const FloatEbmType sign = (i0 < cBins / 2) == (i1 < cBins / 2) ? FloatEbmType { 1 } : FloatEbmType { -1 };
+         const FloatEbmType jitter = static_cast<FloatEbmType>((i0 * 31 + i1 * 17) % 7 - 3) * FloatEbmType { 0.1 };
+         samples.push_back(RegressionSample(
+            sign * FloatEbmType { 10 } + jitter, 
+            { i0, i1, (i0 * 7 + i1 * 13) % cBins, (i0 * 11 + i1 * 5 + 3) % cBins }
+         ));
+      }
+   }
+   test.AddInteractionSamples(samples);
+   test.InitializeInteraction();
+
+   std::vector<IntEbmType> featureIndexes;
+   for(IntEbmType i0 = 0; i0 < 4; ++i0) {
+      for(IntEbmType i1 = i0 + 1; i1 < 4; ++i1) {
+         featureIndexes.push_back(i0);
+         featureIndexes.push_back(i1);
+      }
+   }
+   const size_t cFeatureGroups = featureIndexes.size() / 2;
+
+   for(size_t cFeatureGroupsTop = 1; cFeatureGroupsTop < cFeatureGroups; ++cFeatureGroupsTop) {
+      std::vector<FloatEbmType> scoresExact(cFeatureGroupsTop, FloatEbmType { -1 });
+      std::vector<IntEbmType> indexesExact(cFeatureGroupsTop, IntEbmType { -1 });
+      IntEbmType ret = CalculateInteractionScores(
+         test.GetInteractionDetectorHandle(),
+         static_cast<IntEbmType>(cFeatureGroups),
+         2,
+         &featureIndexes[0],
+         1,
+         static_cast<IntEbmType>(cFeatureGroupsTop),
+         &scoresExact[0],
+         &indexesExact[0]
+      );
+      CHECK(0 == ret);
+
+      std::vector<FloatEbmType> scoresPruned(cFeatureGroupsTop, FloatEbmType { -1 });
+      std::vector<IntEbmType> indexesPruned(cFeatureGroupsTop, IntEbmType { -1 });
+      IntEbmType countFeatureGroupsSkipped = -1;
+      IntEbmType countFeatureGroupsPruned = -1;
+      ret = CalculateInteractionScoresPruned(
+         test.GetInteractionDetectorHandle(),
+         static_cast<IntEbmType>(cFeatureGroups),
+         2,
+         &featureIndexes[0],
+         1,
+         static_cast<IntEbmType>(cFeatureGroupsTop),
+         &scoresPruned[0],
+         &indexesPruned[0],
+         &countFeatureGroupsSkipped,
+         &countFeatureGroupsPruned
+      );
+      CHECK(0 == ret);
+
+      CHECK(0 == indexesExact[0]);
+      for(size_t iOut = 0; iOut < cFeatureGroupsTop; ++iOut) {
+         CHECK(indexesExact[iOut] == indexesPruned[iOut]);
+         CHECK(scoresExact[iOut] == scoresPruned[iOut]);
+      }
+      CHECK(0 == countFeatureGroupsSkipped);
+      CHECK(0 <= countFeatureGroupsPruned);
+      CHECK(countFeatureGroupsPruned < static_cast<IntEbmType>(cFeatureGroups));
+   }
+}
+
+TEST_CASE("triples extended from pairs find a 3 way XOR, interaction, regression") {
+   TestApi test = TestApi(k_learningTypeRegression);
+   test.AddFeatures({ FeatureTest(2), FeatureTest(2), FeatureTest(2), FeatureTest(2) });
+   // the target is the parity of features 0, 1 and 2, so no pair of them has any interaction but the triple explains the target exactly
+   std::vector<RegressionSample> samples;
+   for(IntEbmType iSample = 0; iSample < 16; ++iSample) {
+      const IntEbmType bin0 = iSample & 1;
+      const IntEbmType bin1 = (iSample >> 1) & 1;
+      const IntEbmType bin2 = (iSample >> 2) & 1;
+      const IntEbmType bin3 = (iSample >> 3) & 1;
+      samples.push_back(RegressionSample(0 == (bin0 ^ bin1 ^ bin2) ? 10 : -10, { bin0, bin1, bin2, bin3 }));
+   }
+   test.AddInteractionSamples(samples);
+   test.InitializeInteraction();
+
+   const FloatEbmType scorePair = test.InteractionScore({ 0, 1 }, 1);
+   const FloatEbmType scoreTriple = test.InteractionScore({ 0, 1, 2 }, 1);
+   CHECK(scorePair < scoreTriple);
+   // every octant holds 2 samples with a sum of +-20
+   CHECK_APPROX(scoreTriple, 1600);
+
+   const std::vector<IntEbmType> pairFeatureIndexes { 0, 1, 2, 3 };
+   constexpr IntEbmType countTriplesTop = 2;
+   std::vector<FloatEbmType> scores(countTriplesTop, FloatEbmType { -1 });
+   std::vector<IntEbmType> tripleFeatureIndexes(countTriplesTop * 3, IntEbmType { -1 });
+   IntEbmType countTriples = -1;
+   const IntEbmType ret = CalculateInteractionScoresTriples(
+      test.GetInteractionDetectorHandle(),
+      2,
+      &pairFeatureIndexes[0],
+      1,
+      countTriplesTop,
+      &scores[0],
+      &tripleFeatureIndexes[0],
+      &countTriples
+   );
+   CHECK(0 == ret);
+   CHECK(countTriplesTop == countTriples);
+   CHECK(0 == tripleFeatureIndexes[0]);
+   CHECK(1 == tripleFeatureIndexes[1]);
+   CHECK(2 == tripleFeatureIndexes[2]);
+   CHECK(scoreTriple == scores[0]);
+   CHECK(scores[1] <= scores[0]);
+   CHECK(scores[1] == test.InteractionScore({ tripleFeatureIndexes[3], tripleFeatureIndexes[4], tripleFeatureIndexes[5] }, 1));
+}
+
+TEST_CASE("interaction detector from booster matches one built from the same data, interaction, regression") {
+   const std::vector<FeatureTest> features { FeatureTest(2), FeatureTest(2), FeatureTest(3), FeatureTest(1) };
+   const std::vector<RegressionSample> samples {
+      RegressionSample(10, { 0, 0, 0, 0 }),
+      RegressionSample(-10, { 0, 1, 1, 0 }),
+      RegressionSample(-10, { 1, 0, 2, 0 }),
+      RegressionSample(10, { 1, 1, 0, 0 }),
+      RegressionSample(11, { 0, 0, 1, 0 }),
+      RegressionSample(-9, { 0, 1, 2, 0 }),
+      RegressionSample(-11, { 1, 0, 0, 0 }),
+      RegressionSample(9, { 1, 1, 1, 0 }),
+   };
+
+   TestApi testInteraction = TestApi(k_learningTypeRegression);
+   testInteraction.AddFeatures(features);
+   testInteraction.AddInteractionSamples(samples);
+   testInteraction.InitializeInteraction();
+
+   const std::vector<std::vector<IntEbmType>> pairs { { 0, 1 }, { 0, 2 }, { 1, 2 }, { 2, 3 } };
+
+   InteractionDetectorHandle interactionDetectorHandle;
+   InteractionDetectorHandle interactionDetectorHandleCurrent;
+   InteractionDetectorHandle interactionDetectorHandleBest;
+   {
+      TestApi testBoosting = TestApi(k_learningTypeRegression);
+      testBoosting.AddFeatures(features);
+      // feature 2 is only in a pair, so its bins need to be pulled back out of the pair's tensor indexes
+      testBoosting.AddFeatureGroups({ { 0 }, { 1 }, { 0, 2 } });
+      testBoosting.AddTrainingSamples(samples);
+      testBoosting.AddValidationSamples(samples);
+      testBoosting.InitializeBoosting();
+
+      interactionDetectorHandle = CreateInteractionDetectorFromBooster(testBoosting.GetBoosterHandle(), EBM_FALSE, 0, nullptr, nullptr, nullptr, nullptr);
+      CHECK(nullptr != interactionDetectorHandle);
+
+      for(const std::vector<IntEbmType> & pair : pairs) {
+         FloatEbmType score = -1;
+         const IntEbmType ret = CalculateInteractionScore(interactionDetectorHandle, 2, &pair[0], 1, &score);
+         CHECK(0 == ret);
+         CHECK(testInteraction.InteractionScore(pair, 1) == score);
+      }
+
+      // the validation set is the training set, so every round improves the metric and the best model stays the current model
+      for(int iRound = 0; iRound < 10; ++iRound) {
+         testBoosting.Boost(0);
+         testBoosting.Boost(1);
+      }
+      interactionDetectorHandleCurrent = CreateInteractionDetectorFromBooster(testBoosting.GetBoosterHandle(), EBM_FALSE, 0, nullptr, nullptr, nullptr, nullptr);
+      CHECK(nullptr != interactionDetectorHandleCurrent);
+      interactionDetectorHandleBest = CreateInteractionDetectorFromBooster(testBoosting.GetBoosterHandle(), EBM_TRUE, 0, nullptr, nullptr, nullptr, nullptr);
+      CHECK(nullptr != interactionDetectorHandleBest);
+      // the booster is freed here, and the detectors made from it must not depend on it
+   }
+
+   for(const std::vector<IntEbmType> & pair : pairs) {
+      // the first detector took a snapshot of the residuals before boosting, so boosting afterwards doesn't change its scores
+      FloatEbmType score = -1;
+      IntEbmType ret = CalculateInteractionScore(interactionDetectorHandle, 2, &pair[0], 1, &score);
+      CHECK(0 == ret);
+      CHECK(testInteraction.InteractionScore(pair, 1) == score);
+
+      FloatEbmType scoreCurrent = -1;
+      ret = CalculateInteractionScore(interactionDetectorHandleCurrent, 2, &pair[0], 1, &scoreCurrent);
+      CHECK(0 == ret);
+      FloatEbmType scoreBest = -1;
+      ret = CalculateInteractionScore(interactionDetectorHandleBest, 2, &pair[0], 1, &scoreBest);
+      CHECK(0 == ret);
+      CHECK_APPROX(scoreCurrent, scoreBest);
+   }
+
+   FreeInteractionDetector(interactionDetectorHandleBest);
+   FreeInteractionDetector(interactionDetectorHandleCurrent);
+   FreeInteractionDetector(interactionDetectorHandle);
+}
+
+TEST_CASE("interaction detector from booster on coarser bins matches one built from the coarse data, interaction, regression") {
+   std::vector<RegressionSample> samples;
+   std::vector<RegressionSample> samplesCoarse;
+   for(IntEbmType iSample = 0; iSample < 24; ++iSample) {
+      const IntEbmType iBin0 = iSample % 2;
+      const IntEbmType iBin1 = (iSample * 5 / 3) % 4;
+      const FloatEbmType target = static_cast<FloatEbmType>(iBin0 * iBin1 - iSample % 3);
+      samples.push_back(RegressionSample(target, { iBin0, iBin1 }));
+      // the booster's 4 bins of feature 1 merged into 2, the way EBMPreprocessor.coarsen merges adjacent bins
+      samplesCoarse.push_back(RegressionSample(target, { iBin0, iBin1 / 2 }));
+   }
+
+   TestApi testBoosting = TestApi(k_learningTypeRegression);
+   testBoosting.AddFeatures({ FeatureTest(2), FeatureTest(4) });
+   testBoosting.AddFeatureGroups({ { 0 }, { 1 } });
+   testBoosting.AddTrainingSamples(samples);
+   testBoosting.AddValidationSamples(samples);
+   testBoosting.InitializeBoosting();
+
+   TestApi testInteraction = TestApi(k_learningTypeRegression);
+   testInteraction.AddFeatures({ FeatureTest(2), FeatureTest(2) });
+   testInteraction.AddInteractionSamples(samplesCoarse);
+   testInteraction.InitializeInteraction();
+
+   const BoolEbmType featuresCategorical[] { EBM_FALSE, EBM_FALSE };
+   const IntEbmType featuresBinCount[] { 2, 2 };
+   std::vector<IntEbmType> binnedData;
+   for(size_t iFeature = 0; iFeature < 2; ++iFeature) {
+      for(const RegressionSample & sample : samplesCoarse) {
+         binnedData.push_back(sample.m_binnedDataPerFeatureArray[iFeature]);
+      }
+   }
+
+   const InteractionDetectorHandle interactionDetectorHandle = CreateInteractionDetectorFromBooster(
+      testBoosting.GetBoosterHandle(), 
+      EBM_FALSE, 
+      2, 
+      featuresCategorical, 
+      featuresBinCount, 
+      &binnedData[0], 
+      nullptr
+   );
+   CHECK(nullptr != interactionDetectorHandle);
+
+   const IntEbmType pair[] { 0, 1 };
+   FloatEbmType score = -1;
+   const IntEbmType ret = CalculateInteractionScore(interactionDetectorHandle, 2, pair, 1, &score);
+   CHECK(0 == ret);
+   CHECK(testInteraction.InteractionScore({ 0, 1 }, 1) == score);
+
+   FreeInteractionDetector(interactionDetectorHandle);
+}
+
+TEST_CASE("thread state re-used across feature groups matches CalculateInteractionScore, interaction, multiclass") {
+   TestApi test = TestApi(3);
+   test.AddFeatures({ FeatureTest(2), FeatureTest(5), FeatureTest(3), FeatureTest(1), FeatureTest(4) });
+   std::vector<ClassificationSample> samples;
+   for(IntEbmType iSample = 0; iSample < 60; ++iSample) {
+      samples.push_back(ClassificationSample(
+         (iSample * 7 + iSample / 5) % 3, 
+         { iSample % 2, (iSample / 2) % 5, (iSample * 3 / 7) % 3, 0, (iSample * 5 / 3) % 4 }
+      ));
+   }
+   test.AddInteractionSamples(samples);
+   test.InitializeInteraction();
+
+   ThreadStateInteractionHandle threadStateInteractionHandle = CreateThreadStateInteraction(test.GetInteractionDetectorHandle());
+   CHECK(nullptr != threadStateInteractionHandle);
+
+   // the largest pair first, then smaller ones, a pair with a 1 bin feature, and finally a triple that needs a larger buffer than any pair
+   const std::vector<std::vector<IntEbmType>> featureGroups { { 1, 4 }, { 0, 1 }, { 2, 0 }, { 4, 2 }, { 3, 1 }, { 0, 1, 4 }, { 1, 4 } };
+   for(const std::vector<IntEbmType> & featureGroup : featureGroups) {
+      const IntEbmType countFeaturesInGroup = static_cast<IntEbmType>(featureGroup.size());
+      FloatEbmType scoreThreadState = FloatEbmType { -1 };
+      IntEbmType ret = CalculateInteractionScoreThreadState(
+         threadStateInteractionHandle, 
+         countFeaturesInGroup, 
+         &featureGroup[0], 
+         1, 
+         &scoreThreadState
+      );
+      CHECK(0 == ret);
+      FloatEbmType score = FloatEbmType { -1 };
+      ret = CalculateInteractionScore(test.GetInteractionDetectorHandle(), countFeaturesInGroup, &featureGroup[0], 1, &score);
+      CHECK(0 == ret);
+      CHECK(score == scoreThreadState);
+   }
+
+   FloatEbmType score = FloatEbmType { -1 };
+   const IntEbmType ret = CalculateInteractionScoreThreadState(nullptr, 0, nullptr, 1, &score);
+   CHECK(0 != ret);
+   CHECK(FloatEbmType { 0 } == score);
+
+   FreeThreadStateInteraction(threadStateInteractionHandle);
+   // it's legal to free nullptr
+   FreeThreadStateInteraction(nullptr);
+}
+
+TEST_CASE("sampled interaction scores are repeatable for a seed and agree across scoring paths, interaction, regression") {
+   TestApi test = TestApi(k_learningTypeRegression);
+   test.AddFeatures({ FeatureTest(3), FeatureTest(4), FeatureTest(2), FeatureTest(5) });
+   std::vector<RegressionSample> samples;
+   for(IntEbmType iSample = 0; iSample < 200; ++iSample) {
+      const IntEbmType iBin0 = iSample % 3;
+      const IntEbmType iBin1 = (iSample * 7 / 3) % 4;
+      samples.push_back(RegressionSample(
+         static_cast<FloatEbmType>((iBin0 * iBin1) % 3) + static_cast<FloatEbmType>(iSample % 11) / FloatEbmType { 10 },
+         { iBin0, iBin1, (iSample / 3) % 2, (iSample * 5 / 7) % 5 }
+      ));
+   }
+   test.AddInteractionSamples(samples);
+   test.InitializeInteraction();
+   const InteractionDetectorHandle interactionDetectorHandle = test.GetInteractionDetectorHandle();
+
+   const std::vector<IntEbmType> featureIndexes { 0, 1, 0, 2, 0, 3, 1, 3 };
+   const IntEbmType cPairs = static_cast<IntEbmType>(featureIndexes.size() / 2);
+   std::vector<FloatEbmType> scoresAll(cPairs);
+   for(IntEbmType iPair = 0; iPair < cPairs; ++iPair) {
+      const IntEbmType ret = CalculateInteractionScore(interactionDetectorHandle, 2, &featureIndexes[iPair * 2], 1, &scoresAll[iPair]);
+      CHECK(0 == ret);
+   }
+
+   // every sample once is the same as not sampling
+   IntEbmType ret = SetInteractionSampling(interactionDetectorHandle, 3, FloatEbmType { 1 }, EBM_FALSE);
+   CHECK(0 == ret);
+   for(IntEbmType iPair = 0; iPair < cPairs; ++iPair) {
+      FloatEbmType score = FloatEbmType { -1 };
+      ret = CalculateInteractionScore(interactionDetectorHandle, 2, &featureIndexes[iPair * 2], 1, &score);
+      CHECK(0 == ret);
+      CHECK(scoresAll[iPair] == score);
+   }
+
+   for(const BoolEbmType isBootstrap : { EBM_FALSE, EBM_TRUE }) {
+      ret = SetInteractionSampling(interactionDetectorHandle, 3, FloatEbmType { 0.5 }, isBootstrap);
+      CHECK(0 == ret);
+      std::vector<FloatEbmType> scoresBatch(cPairs, FloatEbmType { -1 });
+      ret = CalculateInteractionScores(interactionDetectorHandle, cPairs, 2, &featureIndexes[0], 1, 0, &scoresBatch[0], nullptr);
+      CHECK(0 == ret);
+      bool bAnyDifferent = false;
+      std::vector<FloatEbmType> scoresSampled(cPairs);
+      for(IntEbmType iPair = 0; iPair < cPairs; ++iPair) {
+         ret = CalculateInteractionScore(interactionDetectorHandle, 2, &featureIndexes[iPair * 2], 1, &scoresSampled[iPair]);
+         CHECK(0 == ret);
+         CHECK_APPROX(scoresSampled[iPair], scoresBatch[iPair]);
+         bAnyDifferent = bAnyDifferent || scoresAll[iPair] != scoresSampled[iPair];
+      }
+      CHECK(bAnyDifferent);
+
+      // the same seed draws the same bag
+      ret = SetInteractionSampling(interactionDetectorHandle, 3, FloatEbmType { 0.5 }, isBootstrap);
+      CHECK(0 == ret);
+      for(IntEbmType iPair = 0; iPair < cPairs; ++iPair) {
+         FloatEbmType score = FloatEbmType { -1 };
+         ret = CalculateInteractionScore(interactionDetectorHandle, 2, &featureIndexes[iPair * 2], 1, &score);
+         CHECK(0 == ret);
+         CHECK(scoresSampled[iPair] == score);
+      }
+   }
+
+   for(const FloatEbmType sampleFraction : { FloatEbmType { 0 }, FloatEbmType { -0.5 }, FloatEbmType { 1.5 }, 
+      std::numeric_limits<FloatEbmType>::quiet_NaN() }) 
+   {
+      ret = SetInteractionSampling(interactionDetectorHandle, 3, sampleFraction, EBM_FALSE);
+      CHECK(0 != ret);
+   }
+   ret = SetInteractionSampling(nullptr, 3, FloatEbmType { 0.5 }, EBM_FALSE);
+   CHECK(0 != ret);
+}
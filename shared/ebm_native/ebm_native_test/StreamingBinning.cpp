@@ -0,0 +1,266 @@
+// Copyright (c) 2018 Microsoft Corporation
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#include "PrecompiledHeaderEbmNativeTest.h"
+
+#include "ebm_native.h"
+#include "EbmNativeTest.h"
+
+static const TestPriority k_filePriority = TestPriority::StreamingBinning;
+
+constexpr FloatEbmType illegalVal = FloatEbmType { -888.88 };
+
+class CutsResult final {
+public:
+   IntEbmType m_ret;
+   std::vector<FloatEbmType> m_cuts;
+   IntEbmType m_countMissingValues;
+   FloatEbmType m_minNonInfinityValue;
+   IntEbmType m_countNegativeInfinity;
+   FloatEbmType m_maxNonInfinityValue;
+   IntEbmType m_countPositiveInfinity;
+
+   CutsResult(const IntEbmType countCutsMax) :
+      m_ret(-1),
+      m_cuts(static_cast<size_t>(countCutsMax) + size_t { 1 }, illegalVal),
+      m_countMissingValues(-1),
+      m_minNonInfinityValue(illegalVal),
+      m_countNegativeInfinity(-1),
+      m_maxNonInfinityValue(illegalVal),
+      m_countPositiveInfinity(-1) {
+   }
+
+   void SetCountCuts(const IntEbmType countCuts) {
+      m_cuts.resize(static_cast<size_t>(countCuts));
+   }
+
+   bool operator==(const CutsResult & other) const {
+      return m_ret == other.m_ret &&
+         m_cuts == other.m_cuts &&
+         m_countMissingValues == other.m_countMissingValues &&
+         m_minNonInfinityValue == other.m_minNonInfinityValue &&
+         m_countNegativeInfinity == other.m_countNegativeInfinity &&
+         m_maxNonInfinityValue == other.m_maxNonInfinityValue &&
+         m_countPositiveInfinity == other.m_countPositiveInfinity;
+   }
+};
+
+static void FillFeatureValues(const size_t cSamples, const size_t cFeatures, std::vector<FloatEbmType> & columnMajor) {
+   columnMajor.resize(cSamples * cFeatures);
+   for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+      for(size_t iFeature = 0; iFeature < cFeatures; ++iFeature) {
+         const size_t iMix = (iSample * 7919 + iFeature * 104729) % cSamples;
+         FloatEbmType val;
+         if(0 == iMix % 19) {
+            val = std::numeric_limits<FloatEbmType>::quiet_NaN();
+         } else if(1 == iFeature && 0 == iMix % 23) {
+            val = std::numeric_limits<FloatEbmType>::infinity();
+         } else if(1 == iFeature && 0 == iMix % 29) {
+            val = -std::numeric_limits<FloatEbmType>::infinity();
+         } else if(2 == iFeature) {
+            // a feature with few distinct values
+            val = static_cast<FloatEbmType>(iMix % 5);
+         } else {
+            val = static_cast<FloatEbmType>(iMix) / FloatEbmType { 8 } - FloatEbmType { 10 };
+         }
+         columnMajor[iFeature * cSamples + iSample] = val;
+      }
+   }
+}
+
+// returns nullptr if any of the calls fail
+static StreamingBinningHandle StreamChunks(
+   const size_t cSamples,
+   const size_t cFeatures,
+   const std::vector<FloatEbmType> & columnMajor,
+   const size_t cSamplesPerChunk,
+   const bool bColumnMajor,
+   const IntEbmType countItemsPerLevelMax
+) {
+   StreamingBinningHandle streamingBinningHandle = BeginStreamingBinning(12345, cFeatures, countItemsPerLevelMax);
+   if(nullptr == streamingBinningHandle) {
+      return nullptr;
+   }
+   for(size_t iSampleStart = 0; iSampleStart < cSamples; iSampleStart += cSamplesPerChunk) {
+      const size_t cSamplesChunk = cSamplesPerChunk < cSamples - iSampleStart ? cSamplesPerChunk : cSamples - iSampleStart;
+      std::vector<FloatEbmType> chunk(cSamplesChunk * cFeatures);
+      for(size_t iSample = 0; iSample < cSamplesChunk; ++iSample) {
+         for(size_t iFeature = 0; iFeature < cFeatures; ++iFeature) {
+            const FloatEbmType val = columnMajor[iFeature * cSamples + iSampleStart + iSample];
+            if(bColumnMajor) {
+               chunk[iFeature * cSamplesChunk + iSample] = val;
+            } else {
+               chunk[iSample * cFeatures + iFeature] = val;
+            }
+         }
+      }
+      const IntEbmType ret = AddStreamingBinningChunk(
+         streamingBinningHandle,
+         cSamplesChunk,
+         &chunk[0],
+         bColumnMajor ? EBM_TRUE : EBM_FALSE
+      );
+      if(0 != ret) {
+         FreeStreamingBinning(streamingBinningHandle);
+         return nullptr;
+      }
+   }
+   return streamingBinningHandle;
+}
+
+TEST_CASE("StreamingBinning, chunks give the same results as binning the full columns") {
+   constexpr size_t cSamples = 997;
+   constexpr size_t cFeatures = 3;
+   constexpr IntEbmType countCutsMax = 8;
+
+   std::vector<FloatEbmType> columnMajor;
+   FillFeatureValues(cSamples, cFeatures, columnMajor);
+
+   for(const bool bColumnMajor : { true, false }) {
+      StreamingBinningHandle streamingBinningHandle = StreamChunks(cSamples, cFeatures, columnMajor, 100, bColumnMajor, 0);
+      CHECK(nullptr != streamingBinningHandle);
+
+      for(size_t iFeature = 0; iFeature < cFeatures; ++iFeature) {
+         const FloatEbmType * const aFeatureValues = &columnMajor[iFeature * cSamples];
+
+         CutsResult quantileExpected(countCutsMax);
+         IntEbmType countCuts = countCutsMax;
+         quantileExpected.m_ret = GenerateQuantileCuts(cSamples, aFeatureValues, 5, EBM_TRUE, &countCuts, &quantileExpected.m_cuts[0],
+            &quantileExpected.m_countMissingValues, &quantileExpected.m_minNonInfinityValue, &quantileExpected.m_countNegativeInfinity,
+            &quantileExpected.m_maxNonInfinityValue, &quantileExpected.m_countPositiveInfinity);
+         quantileExpected.SetCountCuts(countCuts);
+
+         CutsResult quantile(countCutsMax);
+         countCuts = countCutsMax;
+         quantile.m_ret = FinishStreamingQuantileCuts(streamingBinningHandle, iFeature, 5, EBM_TRUE, &countCuts, &quantile.m_cuts[0],
+            &quantile.m_countMissingValues, &quantile.m_minNonInfinityValue, &quantile.m_countNegativeInfinity,
+            &quantile.m_maxNonInfinityValue, &quantile.m_countPositiveInfinity);
+         quantile.SetCountCuts(countCuts);
+
+         CHECK(quantileExpected == quantile);
+
+         CutsResult uniformExpected(countCutsMax);
+         countCuts = countCutsMax;
+         uniformExpected.m_ret = 0;
+         GenerateUniformCuts(cSamples, aFeatureValues, &countCuts, &uniformExpected.m_cuts[0],
+            &uniformExpected.m_countMissingValues, &uniformExpected.m_minNonInfinityValue, &uniformExpected.m_countNegativeInfinity,
+            &uniformExpected.m_maxNonInfinityValue, &uniformExpected.m_countPositiveInfinity);
+         uniformExpected.SetCountCuts(countCuts);
+
+         CutsResult uniform(countCutsMax);
+         countCuts = countCutsMax;
+         uniform.m_ret = FinishStreamingUniformCuts(streamingBinningHandle, iFeature, &countCuts, &uniform.m_cuts[0],
+            &uniform.m_countMissingValues, &uniform.m_minNonInfinityValue, &uniform.m_countNegativeInfinity,
+            &uniform.m_maxNonInfinityValue, &uniform.m_countPositiveInfinity);
+         uniform.SetCountCuts(countCuts);
+
+         CHECK(uniformExpected == uniform);
+
+         CutsResult winsorizedExpected(countCutsMax);
+         countCuts = countCutsMax;
+         winsorizedExpected.m_ret = GenerateWinsorizedCuts(cSamples, aFeatureValues, &countCuts, &winsorizedExpected.m_cuts[0],
+            &winsorizedExpected.m_countMissingValues, &winsorizedExpected.m_minNonInfinityValue, &winsorizedExpected.m_countNegativeInfinity,
+            &winsorizedExpected.m_maxNonInfinityValue, &winsorizedExpected.m_countPositiveInfinity);
+         winsorizedExpected.SetCountCuts(countCuts);
+
+         CutsResult winsorized(countCutsMax);
+         countCuts = countCutsMax;
+         winsorized.m_ret = FinishStreamingWinsorizedCuts(streamingBinningHandle, iFeature, &countCuts, &winsorized.m_cuts[0],
+            &winsorized.m_countMissingValues, &winsorized.m_minNonInfinityValue, &winsorized.m_countNegativeInfinity,
+            &winsorized.m_maxNonInfinityValue, &winsorized.m_countPositiveInfinity);
+         winsorized.SetCountCuts(countCuts);
+
+         CHECK(winsorizedExpected == winsorized);
+      }
+
+      FreeStreamingBinning(streamingBinningHandle);
+   }
+}
+
+TEST_CASE("StreamingBinning, compacted sketches keep exact statistics and uniform cuts") {
+   constexpr size_t cSamples = 50000;
+   constexpr size_t cFeatures = 3;
+   constexpr IntEbmType countCutsMax = 10;
+
+   std::vector<FloatEbmType> columnMajor;
+   FillFeatureValues(cSamples, cFeatures, columnMajor);
+
+   // a small sketch forces compaction long before the end of the data
+   StreamingBinningHandle streamingBinningHandle = StreamChunks(cSamples, cFeatures, columnMajor, 4096, false, 64);
+   CHECK(nullptr != streamingBinningHandle);
+
+   for(size_t iFeature = 0; iFeature < cFeatures; ++iFeature) {
+      const FloatEbmType * const aFeatureValues = &columnMajor[iFeature * cSamples];
+
+      CutsResult uniformExpected(countCutsMax);
+      IntEbmType countCuts = countCutsMax;
+      uniformExpected.m_ret = 0;
+      GenerateUniformCuts(cSamples, aFeatureValues, &countCuts, &uniformExpected.m_cuts[0],
+         &uniformExpected.m_countMissingValues, &uniformExpected.m_minNonInfinityValue, &uniformExpected.m_countNegativeInfinity,
+         &uniformExpected.m_maxNonInfinityValue, &uniformExpected.m_countPositiveInfinity);
+      uniformExpected.SetCountCuts(countCuts);
+
+      CutsResult uniform(countCutsMax);
+      countCuts = countCutsMax;
+      uniform.m_ret = FinishStreamingUniformCuts(streamingBinningHandle, iFeature, &countCuts, &uniform.m_cuts[0],
+         &uniform.m_countMissingValues, &uniform.m_minNonInfinityValue, &uniform.m_countNegativeInfinity,
+         &uniform.m_maxNonInfinityValue, &uniform.m_countPositiveInfinity);
+      uniform.SetCountCuts(countCuts);
+
+      CHECK(uniformExpected == uniform);
+
+      CutsResult quantile(countCutsMax);
+      countCuts = countCutsMax;
+      quantile.m_ret = FinishStreamingQuantileCuts(streamingBinningHandle, iFeature, 1, EBM_FALSE, &countCuts, &quantile.m_cuts[0],
+         &quantile.m_countMissingValues, &quantile.m_minNonInfinityValue, &quantile.m_countNegativeInfinity,
+         &quantile.m_maxNonInfinityValue, &quantile.m_countPositiveInfinity);
+      quantile.SetCountCuts(countCuts);
+
+      CHECK(0 == quantile.m_ret);
+      CHECK(1 <= countCuts);
+      for(size_t iCut = 1; iCut < quantile.m_cuts.size(); ++iCut) {
+         CHECK(quantile.m_cuts[iCut - 1] < quantile.m_cuts[iCut]);
+      }
+      // the statistics are tracked exactly even though the quantiles are approximate
+      CHECK(uniformExpected.m_countMissingValues == quantile.m_countMissingValues);
+      CHECK(uniformExpected.m_minNonInfinityValue == quantile.m_minNonInfinityValue);
+      CHECK(uniformExpected.m_countNegativeInfinity == quantile.m_countNegativeInfinity);
+      CHECK(uniformExpected.m_maxNonInfinityValue == quantile.m_maxNonInfinityValue);
+      CHECK(uniformExpected.m_countPositiveInfinity == quantile.m_countPositiveInfinity);
+   }
+
+   FreeStreamingBinning(streamingBinningHandle);
+}
+
+TEST_CASE("StreamingBinning, bad parameters") {
+   const FloatEbmType featureValues[] { 1, 2, 3, 4 };
+
+   CHECK(nullptr == BeginStreamingBinning(0, -1, 0));
+   CHECK(nullptr == BeginStreamingBinning(0, 2, -1));
+
+   StreamingBinningHandle streamingBinningHandle = BeginStreamingBinning(0, 2, 0);
+   CHECK(nullptr != streamingBinningHandle);
+
+   CHECK(0 != AddStreamingBinningChunk(nullptr, 2, featureValues, EBM_TRUE));
+   CHECK(0 != AddStreamingBinningChunk(streamingBinningHandle, -1, featureValues, EBM_TRUE));
+   CHECK(0 != AddStreamingBinningChunk(streamingBinningHandle, 2, nullptr, EBM_TRUE));
+   CHECK(0 == AddStreamingBinningChunk(streamingBinningHandle, 0, nullptr, EBM_TRUE));
+
+   IntEbmType countCuts = 2;
+   FloatEbmType cuts[2];
+   CHECK(0 != FinishStreamingQuantileCuts(nullptr, 0, 1, EBM_FALSE, &countCuts, cuts, nullptr, nullptr, nullptr, nullptr, nullptr));
+   CHECK(0 != FinishStreamingQuantileCuts(streamingBinningHandle, 2, 1, EBM_FALSE, &countCuts, cuts, nullptr, nullptr, nullptr, nullptr, nullptr));
+   CHECK(0 != FinishStreamingUniformCuts(streamingBinningHandle, -1, &countCuts, cuts, nullptr, nullptr, nullptr, nullptr, nullptr));
+   CHECK(0 != FinishStreamingUniformCuts(streamingBinningHandle, 0, nullptr, cuts, nullptr, nullptr, nullptr, nullptr, nullptr));
+   CHECK(0 != FinishStreamingWinsorizedCuts(streamingBinningHandle, 0, nullptr, cuts, nullptr, nullptr, nullptr, nullptr, nullptr));
+
+   // no data yet is legal and gives no cuts
+   IntEbmType countMissingValues = -1;
+   CHECK(0 == FinishStreamingWinsorizedCuts(streamingBinningHandle, 1, &countCuts, cuts, &countMissingValues, nullptr, nullptr, nullptr, nullptr));
+   CHECK(0 == countCuts);
+   CHECK(0 == countMissingValues);
+
+   FreeStreamingBinning(streamingBinningHandle);
+   FreeStreamingBinning(nullptr);
+}
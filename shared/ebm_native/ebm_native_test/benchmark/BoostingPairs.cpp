@@ -0,0 +1,127 @@
+// Copyright (c) 2018 Microsoft Corporation
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#include <stdio.h>
+#include <vector>
+#include <random>
+
+#include "ebm_native.h"
+#include "EbmNativeBenchmark.h"
+
+// from ParallelWork.h
+typedef void (* ParallelWorkFunction)(void * const pContext, const size_t iWorker);
+extern void ExecuteParallelWork(const size_t cWorkers, const ParallelWorkFunction pFunction, void * const pContext);
+
+static void DoNothingWork(void * const, const size_t) {
+}
+
+// k_cSweepCellsPerPairWorkerMin in FindBestBoostingSplitsPairs.cpp trades the time to launch a worker thread against the sweep work that
+// the worker takes off our thread.  We time both here.  Boosting a pair on few samples but many bins is dominated by the sweep, so the
+// slope between the largest tensors gives the cost of a sweep cell, and a worker should sweep enough cells to cost many thread launches
+BENCHMARK_CASE("BoostingPairs, thread launches against sweep cells") {
+   constexpr size_t k_cLaunchesPerMeasure = 64;
+   constexpr size_t k_cWorkersLaunch = 4;
+   const double nsLaunches = MeasureBestNanoseconds([]() {}, []() {
+      for(size_t iLaunch = 0; iLaunch < k_cLaunchesPerMeasure; ++iLaunch) {
+         ExecuteParallelWork(k_cWorkersLaunch, &DoNothingWork, nullptr);
+      }
+   });
+   // worker 0 runs on our thread, so each launch starts and joins k_cWorkersLaunch - 1 threads
+   const double nsPerThread = nsLaunches / static_cast<double>(k_cLaunchesPerMeasure * (k_cWorkersLaunch - 1));
+   printf("%.0f ns to start and join a worker thread\n", nsPerThread);
+
+   constexpr size_t k_cSamples = 4096;
+   static const IntEbmType k_acBins[] = { 8, 16, 32, 64, 128, 256 };
+
+   std::mt19937_64 generator(42);
+   std::normal_distribution<FloatEbmType> noise(FloatEbmType { 0 }, FloatEbmType { 1 });
+   const std::vector<FloatEbmType> predictorScores(k_cSamples, FloatEbmType { 0 });
+
+   printf("%6s %12s %12s\n", "bins", "sweep cells", "boost pair");
+   double nsPrev = 0;
+   size_t cSweepCellsPrev = 0;
+   double nsPerSweepCell = 0;
+   for(const IntEbmType cBins : k_acBins) {
+      const BoolEbmType featuresCategorical[2] = { EBM_FALSE, EBM_FALSE };
+      const IntEbmType featuresBinCount[2] = { cBins, cBins };
+      const IntEbmType featureGroupsFeatureCount[1] = { 2 };
+      const IntEbmType featureGroupsFeatureIndexes[2] = { 0, 1 };
+
+      std::uniform_int_distribution<IntEbmType> bins(0, cBins - 1);
+      std::vector<IntEbmType> binnedData(2 * k_cSamples);
+      for(IntEbmType & iBin : binnedData) {
+         iBin = bins(generator);
+      }
+      std::vector<FloatEbmType> targets(k_cSamples);
+      for(size_t iSample = 0; iSample < k_cSamples; ++iSample) {
+         targets[iSample] = static_cast<FloatEbmType>(binnedData[iSample] * binnedData[k_cSamples + iSample]) /
+            static_cast<FloatEbmType>(cBins * cBins) + noise(generator);
+      }
+
+      const BoosterHandle boosterHandle = CreateRegressionBooster(
+         42,
+         2,
+         featuresCategorical,
+         featuresBinCount,
+         1,
+         featureGroupsFeatureCount,
+         featureGroupsFeatureIndexes,
+         static_cast<IntEbmType>(k_cSamples),
+         &binnedData[0],
+         &targets[0],
+         nullptr,
+         &predictorScores[0],
+         0,
+         nullptr,
+         nullptr,
+         nullptr,
+         nullptr,
+         0,
+         nullptr
+      );
+      const ThreadStateBoostingHandle threadStateBoostingHandle = nullptr == boosterHandle ? nullptr :
+         CreateThreadStateBoosting(boosterHandle);
+      if(nullptr == threadStateBoostingHandle) {
+         printf("CreateRegressionBooster failed\n");
+         FreeBooster(boosterHandle);
+         return;
+      }
+
+      const IntEbmType leavesMax[2] = { 3, 3 };
+      bool bError = false;
+      FloatEbmType sum = 0;
+      const double ns = MeasureBestNanoseconds([]() {}, [&]() {
+         FloatEbmType gain;
+         bError = bError || 0 != GenerateModelUpdate(
+            threadStateBoostingHandle,
+            0,
+            GenerateUpdateOptions_Default,
+            FloatEbmType { 0.01 },
+            1,
+            leavesMax,
+            &gain
+         );
+         sum += gain;
+      });
+      DoNotOptimizeAway(sum);
+      FreeThreadStateBoosting(threadStateBoostingHandle);
+      FreeBooster(boosterHandle);
+      if(bError) {
+         printf("GenerateModelUpdate failed\n");
+         return;
+      }
+
+      // the same count as GetCountWorkersBoostingSplitPairs: 4 sweep cells for each tensor cell
+      const size_t cSweepCells = size_t { 4 } * static_cast<size_t>(cBins - 1) * static_cast<size_t>(cBins - 1);
+      printf("%6d %12zu %9.1f us\n", static_cast<int>(cBins), cSweepCells, ns / 1000.0);
+      if(size_t { 0 } != cSweepCellsPrev) {
+         nsPerSweepCell = (ns - nsPrev) / static_cast<double>(cSweepCells - cSweepCellsPrev);
+      }
+      nsPrev = ns;
+      cSweepCellsPrev = cSweepCells;
+   }
+
+   printf("%.2f ns per sweep cell, so a worker sweeping %.0f cells costs as much as 10 thread launches\n",
+      nsPerSweepCell, 10.0 * nsPerThread / nsPerSweepCell);
+}
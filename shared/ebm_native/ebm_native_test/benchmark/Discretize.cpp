@@ -0,0 +1,305 @@
+// Copyright (c) 2018 Microsoft Corporation
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#include <stdio.h>
+#include <string.h>
+#include <cmath>
+#include <limits>
+
+#include "ebm_native.h"
+#include "EbmNativeBenchmark.h"
+
+// from Discretization.cpp
+extern void DiscretizeLinearCuts(
+   const size_t cSamples,
+   const FloatEbmType * const aValues,
+   const size_t cCuts,
+   const FloatEbmType * const aCuts,
+   IntEbmType * const aDiscretized
+) noexcept;
+extern void DiscretizePaddedCuts(
+   const size_t cSamples,
+   const FloatEbmType * const aValues,
+   const size_t cCuts,
+   const FloatEbmType * const aCuts,
+   IntEbmType * const aDiscretized
+) noexcept;
+extern void DiscretizeBranchless(
+   const size_t cSamples,
+   const FloatEbmType * const aValues,
+   const size_t cCuts,
+   const FloatEbmType * const aCuts,
+   IntEbmType * const aDiscretized
+) noexcept;
+
+// The baseline is the loop Discretize used before the kernels were specialized by cut count: a chain of selects for up to 6 cuts, a
+// padded search over a power of two that handles one value at a time for up to 1022 cuts when there are at least 4 samples per padded
+// cut, and otherwise a classic binary search that exits as soon as it passes the value
+
+template<size_t cCuts>
+static void BaselineLinear(const size_t cSamples, const FloatEbmType * const aValues, const FloatEbmType * const aCuts, IntEbmType * const aOut) {
+   for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+      const FloatEbmType val = aValues[iSample];
+      IntEbmType result = aCuts[0] <= val ? IntEbmType { 2 } : IntEbmType { 1 };
+      for(size_t iCut = 1; iCut < cCuts; ++iCut) {
+         result = aCuts[iCut] <= val ? static_cast<IntEbmType>(iCut) + IntEbmType { 2 } : result;
+      }
+      aOut[iSample] = std::isnan(val) ? IntEbmType { 0 } : result;
+   }
+}
+
+// the old code wrote out one statement per step by hand.  A loop over the steps, even one the compiler fully unrolls, gets compiled to
+// branches instead of conditional moves and runs several times slower, so we generate the same statements with templates
+template<size_t step>
+static inline char * BaselinePaddedStep(char * const pResult, const FloatEbmType val) {
+   char * const pNext = pResult + (*reinterpret_cast<FloatEbmType *>(pResult + (step - 1) * sizeof(FloatEbmType)) <= val ? 
+      step * sizeof(FloatEbmType) : size_t { 0 });
+   return BaselinePaddedStep<step / 2>(pNext, val);
+}
+template<>
+inline char * BaselinePaddedStep<0>(char * const pResult, const FloatEbmType val) {
+   (void)val;
+   return pResult;
+}
+
+template<size_t cPower>
+static void BaselinePadded(
+   const size_t cSamples,
+   const FloatEbmType * const aValues,
+   const size_t cCuts,
+   const FloatEbmType * const aCuts,
+   IntEbmType * const aOut
+) {
+   FloatEbmType cutsPadded[cPower - 1];
+   cutsPadded[0] = -std::numeric_limits<FloatEbmType>::infinity();
+   memcpy(&cutsPadded[1], aCuts, sizeof(*aCuts) * cCuts);
+   for(size_t iFill = cCuts + 1; iFill < cPower - 1; ++iFill) {
+      cutsPadded[iFill] = std::numeric_limits<FloatEbmType>::quiet_NaN();
+   }
+   for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+      char * const pResult = BaselinePaddedStep<cPower / 2>(reinterpret_cast<char *>(cutsPadded), aValues[iSample]);
+      aOut[iSample] = static_cast<IntEbmType>((pResult - reinterpret_cast<char *>(cutsPadded)) / sizeof(FloatEbmType));
+   }
+}
+
+static void BaselineBinarySearch(
+   const size_t cSamples,
+   const FloatEbmType * const aValues,
+   const size_t cCuts,
+   const FloatEbmType * const aCuts,
+   IntEbmType * const aOut
+) {
+   for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+      const FloatEbmType val = aValues[iSample];
+      size_t middle = 0;
+      if(!std::isnan(val)) {
+         ptrdiff_t low = 0;
+         ptrdiff_t high = static_cast<ptrdiff_t>(cCuts) - 1;
+         FloatEbmType midVal;
+         do {
+            middle = (static_cast<size_t>(low) + static_cast<size_t>(high)) >> 1;
+            midVal = aCuts[middle];
+            low = midVal <= val ? static_cast<ptrdiff_t>(middle) + 1 : low;
+            high = midVal <= val ? high : static_cast<ptrdiff_t>(middle) - 1;
+         } while(low <= high);
+         middle = midVal <= val ? middle + 2 : middle + 1;
+      }
+      aOut[iSample] = static_cast<IntEbmType>(middle);
+   }
+}
+
+static void DiscretizeBaseline(
+   const size_t cSamples,
+   const FloatEbmType * const aValues,
+   const size_t cCuts,
+   const FloatEbmType * const aCuts,
+   IntEbmType * const aOut
+) {
+   switch(cCuts) {
+   case 1:
+      BaselineLinear<1>(cSamples, aValues, aCuts, aOut);
+      return;
+   case 2:
+      BaselineLinear<2>(cSamples, aValues, aCuts, aOut);
+      return;
+   case 3:
+      BaselineLinear<3>(cSamples, aValues, aCuts, aOut);
+      return;
+   case 4:
+      BaselineLinear<4>(cSamples, aValues, aCuts, aOut);
+      return;
+   case 5:
+      BaselineLinear<5>(cSamples, aValues, aCuts, aOut);
+      return;
+   case 6:
+      BaselineLinear<6>(cSamples, aValues, aCuts, aOut);
+      return;
+   default:
+      break;
+   }
+   if(cCuts <= 14 && 16 * 4 <= cSamples) {
+      BaselinePadded<16>(cSamples, aValues, cCuts, aCuts, aOut);
+   } else if(15 <= cCuts && cCuts <= 30 && 32 * 4 <= cSamples) {
+      BaselinePadded<32>(cSamples, aValues, cCuts, aCuts, aOut);
+   } else if(31 <= cCuts && cCuts <= 62 && 64 * 4 <= cSamples) {
+      BaselinePadded<64>(cSamples, aValues, cCuts, aCuts, aOut);
+   } else if(63 <= cCuts && cCuts <= 126 && 128 * 4 <= cSamples) {
+      BaselinePadded<128>(cSamples, aValues, cCuts, aCuts, aOut);
+   } else if(127 <= cCuts && cCuts <= 254 && 256 * 4 <= cSamples) {
+      BaselinePadded<256>(cSamples, aValues, cCuts, aCuts, aOut);
+   } else if(255 <= cCuts && cCuts <= 510 && 512 * 4 <= cSamples) {
+      BaselinePadded<512>(cSamples, aValues, cCuts, aCuts, aOut);
+   } else if(511 <= cCuts && cCuts <= 1022 && 1024 * 4 <= cSamples) {
+      BaselinePadded<1024>(cSamples, aValues, cCuts, aCuts, aOut);
+   } else {
+      BaselineBinarySearch(cSamples, aValues, cCuts, aCuts, aOut);
+   }
+}
+
+// the library only instantiates DiscretizeLinear up to k_cCutsLinearMax cuts.  Past that the chain of selects is the same as the
+// baseline's, so we time the baseline's instantiations to see where the chain stops paying off
+static void DiscretizeLinearAnyCuts(
+   const size_t cSamples,
+   const FloatEbmType * const aValues,
+   const size_t cCuts,
+   const FloatEbmType * const aCuts,
+   IntEbmType * const aOut
+) {
+   switch(cCuts) {
+   case 7:
+      BaselineLinear<7>(cSamples, aValues, aCuts, aOut);
+      return;
+   case 8:
+      BaselineLinear<8>(cSamples, aValues, aCuts, aOut);
+      return;
+   case 10:
+      BaselineLinear<10>(cSamples, aValues, aCuts, aOut);
+      return;
+   case 14:
+      BaselineLinear<14>(cSamples, aValues, aCuts, aOut);
+      return;
+   default:
+      DiscretizeLinearCuts(cSamples, aValues, cCuts, aCuts, aOut);
+      return;
+   }
+}
+
+// uniform values in [-1000, 1000) with 1% missing, and cCuts evenly spaced cuts over the same range
+static void FillDiscretizeInputs(const size_t cSamples, FloatEbmType * const aValues, const size_t cCuts, FloatEbmType * const aCuts) {
+   FillValues(ValueDistribution::Uniform, 42, cSamples, aValues);
+   for(size_t iSample = 0; iSample < cSamples; iSample += 100) {
+      aValues[iSample] = std::numeric_limits<FloatEbmType>::quiet_NaN();
+   }
+   for(size_t iCut = 0; iCut < cCuts; ++iCut) {
+      aCuts[iCut] = FloatEbmType { -1000 } + FloatEbmType { 2000 } * static_cast<FloatEbmType>(iCut + 1) / static_cast<FloatEbmType>(cCuts + 1);
+   }
+}
+
+static bool IsSameDiscretized(const size_t cSamples, const IntEbmType * const aExpected, const IntEbmType * const aDiscretized) {
+   return 0 == memcmp(aExpected, aDiscretized, sizeof(*aExpected) * cSamples);
+}
+
+// Every kernel against the baseline over 1M samples.  "-" is a kernel that doesn't handle that many cuts.  Discretize is the public
+// function, so it shows which kernel DiscretizeFeature picks.  This is what k_cCutsLinearMax was tuned from
+BENCHMARK_CASE("Discretize, kernels by cut count") {
+   constexpr size_t k_cSamples = size_t { 1 } << 20;
+   constexpr size_t k_cCutsMax = 4000;
+   static const size_t k_acCuts[] = { 1, 2, 3, 4, 6, 7, 8, 10, 14, 30, 62, 126, 254, 510, 1022, 2000, 4000 };
+
+   FloatEbmType * const aValues = new FloatEbmType[k_cSamples];
+   FloatEbmType * const aCuts = new FloatEbmType[k_cCutsMax];
+   IntEbmType * const aExpected = new IntEbmType[k_cSamples];
+   IntEbmType * const aDiscretized = new IntEbmType[k_cSamples];
+
+   printf("ns per value\n");
+   printf("%6s %10s %10s %10s %10s %10s\n", "cuts", "baseline", "linear", "padded", "branchless", "Discretize");
+   for(const size_t cCuts : k_acCuts) {
+      FillDiscretizeInputs(k_cSamples, aValues, cCuts, aCuts);
+      auto prepare = []() {};
+      const double nsBaseline = MeasureBestNanoseconds(prepare, [&]() {
+         DiscretizeBaseline(k_cSamples, aValues, cCuts, aCuts, aExpected);
+      });
+
+      char strLinear[32] = "-";
+      if(cCuts <= 8 || 10 == cCuts || 14 == cCuts) {
+         const double ns = MeasureBestNanoseconds(prepare, [&]() {
+            DiscretizeLinearAnyCuts(k_cSamples, aValues, cCuts, aCuts, aDiscretized);
+         });
+         snprintf(strLinear, sizeof(strLinear), IsSameDiscretized(k_cSamples, aExpected, aDiscretized) ? "%.2f" : "WRONG", ns / k_cSamples);
+      }
+
+      char strPadded[32] = "-";
+      if(cCuts <= 1022) {
+         const double ns = MeasureBestNanoseconds(prepare, [&]() {
+            DiscretizePaddedCuts(k_cSamples, aValues, cCuts, aCuts, aDiscretized);
+         });
+         snprintf(strPadded, sizeof(strPadded), IsSameDiscretized(k_cSamples, aExpected, aDiscretized) ? "%.2f" : "WRONG", ns / k_cSamples);
+      }
+
+      char strBranchless[32];
+      const double nsBranchless = MeasureBestNanoseconds(prepare, [&]() {
+         DiscretizeBranchless(k_cSamples, aValues, cCuts, aCuts, aDiscretized);
+      });
+      snprintf(strBranchless, sizeof(strBranchless), IsSameDiscretized(k_cSamples, aExpected, aDiscretized) ? "%.2f" : "WRONG",
+         nsBranchless / k_cSamples);
+
+      char strDiscretize[32];
+      const double nsDiscretize = MeasureBestNanoseconds(prepare, [&]() {
+         Discretize(k_cSamples, aValues, cCuts, aCuts, aDiscretized);
+      });
+      snprintf(strDiscretize, sizeof(strDiscretize), IsSameDiscretized(k_cSamples, aExpected, aDiscretized) ? "%.2f" : "WRONG",
+         nsDiscretize / k_cSamples);
+
+      printf("%6zu %10.2f %10s %10s %10s %10s\n", cCuts, nsBaseline / k_cSamples, strLinear, strPadded, strBranchless, strDiscretize);
+   }
+
+   delete[] aDiscretized;
+   delete[] aExpected;
+   delete[] aCuts;
+   delete[] aValues;
+}
+
+// DiscretizePaddedCuts against DiscretizeBranchless on short columns, where copying the padded cuts is a large part of the work.  The
+// columns are sized in samples per padded cut, from 1/8 up to 16, which is the inverse of k_cPaddedCutsPerSampleMax.  Each measurement
+// discretizes enough columns to cover 1M samples
+BENCHMARK_CASE("Discretize, padding break even") {
+   constexpr size_t k_cValuesPerMeasurement = size_t { 1 } << 20;
+   static const size_t k_acCuts[] = { 14, 126, 1022 };
+   static const size_t k_acEighthsPerPaddedCut[] = { 1, 2, 4, 8, 16, 32, 128 };
+
+   FloatEbmType * const aValues = new FloatEbmType[k_cValuesPerMeasurement];
+   FloatEbmType * const aCuts = new FloatEbmType[1022];
+   IntEbmType * const aDiscretized = new IntEbmType[k_cValuesPerMeasurement];
+
+   printf("ns per value\n");
+   printf("%6s %16s %10s %10s\n", "cuts", "samples per cut", "padded", "branchless");
+   for(const size_t cCuts : k_acCuts) {
+      size_t cPower = 16;
+      while(cPower < cCuts + 2) {
+         cPower <<= 1;
+      }
+      FillDiscretizeInputs(k_cValuesPerMeasurement, aValues, cCuts, aCuts);
+      for(const size_t cEighthsPerPaddedCut : k_acEighthsPerPaddedCut) {
+         const size_t cSamples = cPower * cEighthsPerPaddedCut / 8;
+         const size_t cColumns = k_cValuesPerMeasurement / cSamples;
+         const size_t cValues = cColumns * cSamples;
+         auto prepare = []() {};
+         const double nsPadded = MeasureBestNanoseconds(prepare, [&]() {
+            for(size_t iColumn = 0; iColumn < cColumns; ++iColumn) {
+               DiscretizePaddedCuts(cSamples, &aValues[iColumn * cSamples], cCuts, aCuts, &aDiscretized[iColumn * cSamples]);
+            }
+         });
+         const double nsBranchless = MeasureBestNanoseconds(prepare, [&]() {
+            for(size_t iColumn = 0; iColumn < cColumns; ++iColumn) {
+               DiscretizeBranchless(cSamples, &aValues[iColumn * cSamples], cCuts, aCuts, &aDiscretized[iColumn * cSamples]);
+            }
+         });
+         printf("%6zu %16.3f %10.2f %10.2f\n", cCuts, static_cast<double>(cEighthsPerPaddedCut) / 8, nsPadded / cValues, nsBranchless / cValues);
+      }
+   }
+
+   delete[] aDiscretized;
+   delete[] aCuts;
+   delete[] aValues;
+}
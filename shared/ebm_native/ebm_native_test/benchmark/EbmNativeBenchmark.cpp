@@ -0,0 +1,85 @@
+// Copyright (c) 2018 Microsoft Corporation
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include <random>
+
+#include "ebm_native.h"
+#include "EbmNativeBenchmark.h"
+
+// usage: ebm_native_benchmark [filter]
+// runs every benchmark whose description contains filter, or all of them if there is no filter
+
+extern const ValueDistribution k_aValueDistributions[k_cValueDistributions] = {
+   ValueDistribution::Uniform,
+   ValueDistribution::HeavyTailed,
+   ValueDistribution::Duplicated,
+};
+
+extern const char * GetValueDistributionName(const ValueDistribution distribution) {
+   switch(distribution) {
+   case ValueDistribution::Uniform:
+      return "uniform";
+   case ValueDistribution::HeavyTailed:
+      return "heavy-tailed";
+   case ValueDistribution::Duplicated:
+      return "duplicated";
+   }
+   return "unknown";
+}
+
+extern void FillValues(const ValueDistribution distribution, const uint64_t seed, const size_t cSamples, FloatEbmType * const aValues) {
+   // we use our own generator instead of the library's so that the benchmark inputs don't change if the library's random numbers do
+   std::mt19937_64 generator(seed);
+   if(ValueDistribution::Uniform == distribution) {
+      std::uniform_real_distribution<FloatEbmType> uniform(FloatEbmType { -1000 }, FloatEbmType { 1000 });
+      for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+         aValues[iSample] = uniform(generator);
+      }
+   } else if(ValueDistribution::HeavyTailed == distribution) {
+      std::cauchy_distribution<FloatEbmType> cauchy(FloatEbmType { 0 }, FloatEbmType { 1 });
+      for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+         aValues[iSample] = cauchy(generator);
+      }
+   } else {
+      std::uniform_int_distribution<int> smallIntegers(0, 15);
+      for(size_t iSample = 0; iSample < cSamples; ++iSample) {
+         aValues[iSample] = static_cast<FloatEbmType>(smallIntegers(generator));
+      }
+   }
+}
+
+static volatile FloatEbmType g_sink;
+
+extern void DoNotOptimizeAway(const FloatEbmType val) {
+   g_sink = val;
+}
+
+static std::vector<BenchmarkCaseHidden> & GetAllBenchmarksHidden() {
+   // putting this static variable inside a function avoids the static initialization order problem
+   static std::vector<BenchmarkCaseHidden> g_allBenchmarksHidden;
+   return g_allBenchmarksHidden;
+}
+
+extern int RegisterBenchmarkHidden(const BenchmarkCaseHidden & benchmarkCaseHidden) {
+   GetAllBenchmarksHidden().push_back(benchmarkCaseHidden);
+   return 0;
+}
+
+int main(int argc, char ** argv) {
+   const char * const filter = 2 <= argc ? argv[1] : "";
+
+   for(const BenchmarkCaseHidden & benchmarkCaseHidden : GetAllBenchmarksHidden()) {
+      if(nullptr == strstr(benchmarkCaseHidden.m_description.c_str(), filter)) {
+         continue;
+      }
+      printf("%s\n", benchmarkCaseHidden.m_description.c_str());
+      benchmarkCaseHidden.m_pBenchmarkFunction();
+      printf("\n");
+      fflush(stdout);
+   }
+   return 0;
+}
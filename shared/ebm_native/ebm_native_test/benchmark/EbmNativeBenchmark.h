@@ -0,0 +1,84 @@
+// Copyright (c) 2018 Microsoft Corporation
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#ifndef EBM_NATIVE_BENCHMARK_H
+#define EBM_NATIVE_BENCHMARK_H
+
+// The benchmarks are compiled together with the library sources by ebm_native_benchmark.sh, so unlike ebm_native_test they can reach
+// internal functions through extern declarations.  They're not part of the test run.  Each benchmark prints a table of timings that we use
+// to pick the thresholds in the library, so re-run them on the target hardware before re-tuning any of those thresholds
+
+#include <stddef.h> // size_t
+#include <stdint.h> // uint64_t
+#include <string>
+#include <chrono>
+
+#include "ebm_native.h"
+
+class BenchmarkCaseHidden;
+typedef void (*BenchmarkFunctionHidden)();
+
+class BenchmarkCaseHidden {
+public:
+   inline BenchmarkCaseHidden(BenchmarkFunctionHidden pBenchmarkFunction, std::string description) {
+      m_pBenchmarkFunction = pBenchmarkFunction;
+      m_description = description;
+   }
+
+   BenchmarkFunctionHidden m_pBenchmarkFunction;
+   std::string m_description;
+};
+
+int RegisterBenchmarkHidden(const BenchmarkCaseHidden & benchmarkCaseHidden);
+
+#define CONCATENATE_STRINGS(t1, t2) t1##t2
+#define CONCATENATE_TOKENS(t1, t2) CONCATENATE_STRINGS(t1, t2)
+#define BENCHMARK_CASE(description) \
+   static void CONCATENATE_TOKENS(BENCHMARK_FUNCTION_HIDDEN_, __LINE__)(); \
+   static int CONCATENATE_TOKENS(UNUSED_INTEGER_HIDDEN_, __LINE__) = \
+   RegisterBenchmarkHidden(BenchmarkCaseHidden(&CONCATENATE_TOKENS(BENCHMARK_FUNCTION_HIDDEN_, __LINE__), description)); \
+   static void CONCATENATE_TOKENS(BENCHMARK_FUNCTION_HIDDEN_, __LINE__)()
+
+// number of times we repeat each measurement.  We report the fastest, which is the least disturbed by everything else on the machine
+constexpr size_t k_cBenchmarkRepeats = 7;
+
+// runs prepare and then run k_cBenchmarkRepeats times and returns the fastest run in nanoseconds.  Only run is timed, so prepare can
+// restore any inputs that run modifies
+template<typename TPrepare, typename TRun>
+double MeasureBestNanoseconds(TPrepare prepare, TRun run) {
+   double best = 0;
+   for(size_t iRepeat = 0; iRepeat < k_cBenchmarkRepeats; ++iRepeat) {
+      prepare();
+      const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      run();
+      const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+      const double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count();
+      if(0 == iRepeat || nanoseconds < best) {
+         best = nanoseconds;
+      }
+   }
+   return best;
+}
+
+// the shapes of feature data that stress sorting, selection and binning differently
+enum class ValueDistribution {
+   // continuous values spread over a narrow exponent range
+   Uniform,
+   // Cauchy distributed values, which spread over many exponents and have extreme outliers
+   HeavyTailed,
+   // a handful of small integers repeated many times, like a low cardinality feature stored as floats
+   Duplicated,
+};
+constexpr size_t k_cValueDistributions = 3;
+extern const ValueDistribution k_aValueDistributions[k_cValueDistributions];
+
+const char * GetValueDistributionName(const ValueDistribution distribution);
+
+// fills aValues with cSamples values from distribution.  The same seed always gives the same values
+void FillValues(const ValueDistribution distribution, const uint64_t seed, const size_t cSamples, FloatEbmType * const aValues);
+
+// the compiler can't remove work whose results are passed here
+void DoNotOptimizeAway(const FloatEbmType val);
+
+#endif // EBM_NATIVE_BENCHMARK_H
@@ -0,0 +1,139 @@
+// Copyright (c) 2018 Microsoft Corporation
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#include <stdio.h>
+#include <vector>
+#include <random>
+
+#include "ebm_native.h"
+#include "EbmNativeBenchmark.h"
+
+struct PruningScenario {
+   const char * m_name;
+   FloatEbmType m_aInteractionStrengths[3];
+   IntEbmType m_cPairsTop;
+};
+
+// Ranks every pair of k_cFeatures features and keeps the best few, once with CalculateInteractionScores and once with
+// CalculateInteractionScoresPruned.  The residuals are what boosting leaves after the mains are fit: three interactions plus noise.  Half 
+// of the features have 256 bins and the other half have few enough bins that their coarse bins are their real bins.  Pruning a pair with 
+// many bins before it is binned only works once the best pairs we keep explain a good share of the residuals
+BENCHMARK_CASE("InteractionPruning, top pairs with and without pruning") {
+   constexpr size_t k_cSamples = size_t { 1 } << 18;
+   constexpr size_t k_cFeatures = 20;
+   constexpr IntEbmType k_cSamplesRequiredForChildSplitMin = 2;
+
+   static const PruningScenario k_aScenarios[] = {
+      { "3 similar interactions, top 3", { FloatEbmType { 4 }, FloatEbmType { 2 }, FloatEbmType { 1 } }, 3 },
+      { "1 weak interaction, top 1", { FloatEbmType { 3 }, FloatEbmType { 2 }, FloatEbmType { 1 } }, 1 },
+      { "1 strong interaction, top 1", { FloatEbmType { 5 }, FloatEbmType { 2 }, FloatEbmType { 1 } }, 1 },
+      { "1 dominant interaction, top 1", { FloatEbmType { 16 }, FloatEbmType { 2 }, FloatEbmType { 1 } }, 1 },
+   };
+
+   std::mt19937_64 generator(42);
+   std::normal_distribution<FloatEbmType> noise(FloatEbmType { 0 }, FloatEbmType { 1 });
+
+   std::vector<BoolEbmType> featuresCategorical(k_cFeatures, EBM_FALSE);
+   std::vector<IntEbmType> featuresBinCount(k_cFeatures);
+   std::vector<IntEbmType> binnedData(k_cFeatures * k_cSamples);
+   for(size_t iFeature = 0; iFeature < k_cFeatures; ++iFeature) {
+      featuresBinCount[iFeature] = 0 == iFeature % 2 ? IntEbmType { 256 } : IntEbmType { 12 };
+      std::uniform_int_distribution<IntEbmType> bins(0, featuresBinCount[iFeature] - 1);
+      for(size_t iSample = 0; iSample < k_cSamples; ++iSample) {
+         binnedData[iFeature * k_cSamples + iSample] = bins(generator);
+      }
+   }
+   std::vector<FloatEbmType> noises(k_cSamples);
+   for(FloatEbmType & noiseSample : noises) {
+      noiseSample = noise(generator);
+   }
+
+   std::vector<IntEbmType> featureIndexes;
+   for(IntEbmType iFeature1 = 0; iFeature1 < static_cast<IntEbmType>(k_cFeatures); ++iFeature1) {
+      for(IntEbmType iFeature2 = iFeature1 + 1; iFeature2 < static_cast<IntEbmType>(k_cFeatures); ++iFeature2) {
+         featureIndexes.push_back(iFeature1);
+         featureIndexes.push_back(iFeature2);
+      }
+   }
+   const IntEbmType cPairs = static_cast<IntEbmType>(featureIndexes.size() / 2);
+
+   // centered so that the interactions don't leak into the mains, which boosting would already have fit
+   auto centered = [&](const size_t iFeature, const size_t iSample) {
+      return static_cast<FloatEbmType>(binnedData[iFeature * k_cSamples + iSample]) /
+         static_cast<FloatEbmType>(featuresBinCount[iFeature] - 1) - FloatEbmType { 0.5 };
+   };
+
+   printf("%zu samples, %zu features with 256 or 12 bins, %d pairs\n", k_cSamples, k_cFeatures, static_cast<int>(cPairs));
+   printf("%-30s %11s %11s %7s %8s %5s\n", "residuals", "exact", "pruned", "pruned", "speedup", "same");
+   for(const PruningScenario & scenario : k_aScenarios) {
+      std::vector<FloatEbmType> targets(k_cSamples);
+      std::vector<FloatEbmType> predictorScores(k_cSamples, FloatEbmType { 0 });
+      for(size_t iSample = 0; iSample < k_cSamples; ++iSample) {
+         targets[iSample] =
+            scenario.m_aInteractionStrengths[0] * centered(0, iSample) * centered(1, iSample) +
+            scenario.m_aInteractionStrengths[1] * centered(2, iSample) * centered(5, iSample) +
+            scenario.m_aInteractionStrengths[2] * centered(6, iSample) * centered(8, iSample) +
+            noises[iSample];
+      }
+
+      const InteractionDetectorHandle interactionDetectorHandle = CreateRegressionInteractionDetector(
+         static_cast<IntEbmType>(k_cFeatures),
+         &featuresCategorical[0],
+         &featuresBinCount[0],
+         static_cast<IntEbmType>(k_cSamples),
+         &binnedData[0],
+         &targets[0],
+         nullptr,
+         &predictorScores[0],
+         nullptr
+      );
+      if(nullptr == interactionDetectorHandle) {
+         printf("CreateRegressionInteractionDetector failed\n");
+         return;
+      }
+
+      const IntEbmType cPairsTop = scenario.m_cPairsTop;
+      std::vector<FloatEbmType> scores(static_cast<size_t>(cPairsTop));
+      std::vector<IntEbmType> indexes(static_cast<size_t>(cPairsTop));
+      bool bError = false;
+      const double nsExact = MeasureBestNanoseconds([]() {}, [&]() {
+         bError = bError || 0 != CalculateInteractionScores(
+            interactionDetectorHandle,
+            cPairs,
+            2,
+            &featureIndexes[0],
+            k_cSamplesRequiredForChildSplitMin,
+            cPairsTop,
+            &scores[0],
+            &indexes[0]
+         );
+      });
+      const std::vector<IntEbmType> indexesExact = indexes;
+
+      IntEbmType cSkipped = 0;
+      IntEbmType cPruned = 0;
+      const double nsPruned = MeasureBestNanoseconds([]() {}, [&]() {
+         bError = bError || 0 != CalculateInteractionScoresPruned(
+            interactionDetectorHandle,
+            cPairs,
+            2,
+            &featureIndexes[0],
+            k_cSamplesRequiredForChildSplitMin,
+            cPairsTop,
+            &scores[0],
+            &indexes[0],
+            &cSkipped,
+            &cPruned
+         );
+      });
+      DoNotOptimizeAway(scores[0]);
+      FreeInteractionDetector(interactionDetectorHandle);
+      if(bError) {
+         printf("%s failed\n", scenario.m_name);
+         continue;
+      }
+      printf("%-30s %8.2f ms %8.2f ms %7d %8.2f %5s\n", scenario.m_name, nsExact / 1000000.0, nsPruned / 1000000.0,
+         static_cast<int>(cPruned), nsExact / nsPruned, indexesExact == indexes ? "yes" : "NO");
+   }
+}
@@ -0,0 +1,106 @@
+// Copyright (c) 2018 Microsoft Corporation
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#include <stdio.h>
+#include <vector>
+#include <random>
+
+#include "ebm_native.h"
+#include "EbmNativeBenchmark.h"
+
+// Scores every pair of cFeatures features on all the samples and then on bags drawn by SetInteractionSampling.  Scoring time should drop
+// with the size of the bag, since the bag is a compact copy of the samples in it.  We also time drawing the bag, which reads every sample
+// once and so only pays off if several scores are calculated on the same bag
+BENCHMARK_CASE("InteractionSampling, scoring all pairs on bags of the samples") {
+   constexpr size_t k_cSamples = size_t { 1 } << 20;
+   constexpr size_t k_cFeatures = 8;
+   constexpr IntEbmType k_cBins = 32;
+
+   std::mt19937_64 generator(42);
+   std::uniform_int_distribution<IntEbmType> bins(0, k_cBins - 1);
+   std::normal_distribution<FloatEbmType> noise(FloatEbmType { 0 }, FloatEbmType { 1 });
+
+   std::vector<BoolEbmType> featuresCategorical(k_cFeatures, EBM_FALSE);
+   std::vector<IntEbmType> featuresBinCount(k_cFeatures, k_cBins);
+   std::vector<IntEbmType> binnedData(k_cFeatures * k_cSamples);
+   for(IntEbmType & iBin : binnedData) {
+      iBin = bins(generator);
+   }
+   std::vector<FloatEbmType> targets(k_cSamples);
+   std::vector<FloatEbmType> predictorScores(k_cSamples, FloatEbmType { 0 });
+   for(size_t iSample = 0; iSample < k_cSamples; ++iSample) {
+      // an interaction between the first two features, plus noise
+      targets[iSample] = static_cast<FloatEbmType>(binnedData[iSample] * binnedData[k_cSamples + iSample]) /
+         FloatEbmType { 100 } + noise(generator);
+   }
+
+   const InteractionDetectorHandle interactionDetectorHandle = CreateRegressionInteractionDetector(
+      static_cast<IntEbmType>(k_cFeatures),
+      &featuresCategorical[0],
+      &featuresBinCount[0],
+      static_cast<IntEbmType>(k_cSamples),
+      &binnedData[0],
+      &targets[0],
+      nullptr,
+      &predictorScores[0],
+      nullptr
+   );
+   if(nullptr == interactionDetectorHandle) {
+      printf("CreateRegressionInteractionDetector failed\n");
+      return;
+   }
+
+   std::vector<IntEbmType> featureIndexes;
+   for(IntEbmType iFeature1 = 0; iFeature1 < static_cast<IntEbmType>(k_cFeatures); ++iFeature1) {
+      for(IntEbmType iFeature2 = iFeature1 + 1; iFeature2 < static_cast<IntEbmType>(k_cFeatures); ++iFeature2) {
+         featureIndexes.push_back(iFeature1);
+         featureIndexes.push_back(iFeature2);
+      }
+   }
+   const size_t cPairs = featureIndexes.size() / 2;
+
+   struct SamplingSetting {
+      const char * m_name;
+      FloatEbmType m_sampleFraction;
+      BoolEbmType m_isBootstrap;
+   };
+   static const SamplingSetting k_aSettings[] = {
+      { "all samples", FloatEbmType { 1 }, EBM_FALSE },
+      { "50% bag", FloatEbmType { 0.5 }, EBM_FALSE },
+      { "10% bag", FloatEbmType { 0.1 }, EBM_FALSE },
+      { "1% bag", FloatEbmType { 0.01 }, EBM_FALSE },
+      { "bootstrap", FloatEbmType { 1 }, EBM_TRUE },
+   };
+
+   printf("%zu samples, %zu features with %d bins, %zu pairs\n", k_cSamples, k_cFeatures, static_cast<int>(k_cBins), cPairs);
+   printf("%-12s %12s %14s %8s\n", "sampling", "draw bag", "score pairs", "speedup");
+   double nsScoreAll = 0;
+   for(const SamplingSetting & setting : k_aSettings) {
+      bool bError = false;
+      const double nsDraw = MeasureBestNanoseconds([]() {}, [&]() {
+         bError = bError || 0 != SetInteractionSampling(interactionDetectorHandle, 7, setting.m_sampleFraction, setting.m_isBootstrap);
+      });
+
+      FloatEbmType sum = 0;
+      const double nsScore = MeasureBestNanoseconds([]() {}, [&]() {
+         for(size_t iPair = 0; iPair < cPairs; ++iPair) {
+            FloatEbmType score;
+            bError = bError || 0 != CalculateInteractionScore(interactionDetectorHandle, 2, &featureIndexes[iPair * 2], 1, &score);
+            sum += score;
+         }
+      });
+      DoNotOptimizeAway(sum);
+      if(bError) {
+         printf("%s failed\n", setting.m_name);
+         continue;
+      }
+      if(FloatEbmType { 1 } == setting.m_sampleFraction && EBM_FALSE == setting.m_isBootstrap) {
+         nsScoreAll = nsScore;
+      }
+
+      printf("%-12s %9.2f ms %11.2f ms %8.2f\n", setting.m_name, nsDraw / 1000000.0, nsScore / 1000000.0, nsScoreAll / nsScore);
+   }
+
+   FreeInteractionDetector(interactionDetectorHandle);
+}
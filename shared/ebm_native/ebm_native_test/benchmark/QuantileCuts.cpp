@@ -0,0 +1,162 @@
+// Copyright (c) 2018 Microsoft Corporation
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#include <stdio.h>
+#include <vector>
+#include <random>
+
+#include "ebm_native.h"
+#include "EbmNativeBenchmark.h"
+
+static bool GenerateCuts(
+   const std::vector<FloatEbmType> & values,
+   const BoolEbmType isHumanized,
+   const IntEbmType cCutsMax,
+   std::vector<FloatEbmType> & cutsOut
+) {
+   IntEbmType countCuts = cCutsMax;
+   cutsOut.resize(static_cast<size_t>(cCutsMax));
+   IntEbmType countMissing;
+   FloatEbmType minValue;
+   IntEbmType countNegativeInfinity;
+   FloatEbmType maxValue;
+   IntEbmType countPositiveInfinity;
+   const IntEbmType ret = GenerateQuantileCuts(
+      static_cast<IntEbmType>(values.size()),
+      &values[0],
+      1,
+      isHumanized,
+      &countCuts,
+      &cutsOut[0],
+      &countMissing,
+      &minValue,
+      &countNegativeInfinity,
+      &maxValue,
+      &countPositiveInfinity
+   );
+   cutsOut.resize(static_cast<size_t>(countCuts));
+   return 0 != ret;
+}
+
+struct CutPlacementScenario {
+   const char * m_name;
+   // 0 for continuous values, otherwise the number of distinct values
+   int m_cDistinct;
+   IntEbmType m_cCutsMax;
+};
+
+// GenerateQuantileCuts on 1M samples.  After the sort, the time goes into the priority queues of cutting ranges and cut points, which
+// grow with the number of cuts and with the number of distinct values that the cuts have to be placed between
+BENCHMARK_CASE("QuantileCuts, cut placement by cut count") {
+   constexpr size_t k_cSamples = size_t { 1 } << 20;
+   static const CutPlacementScenario k_aScenarios[] = {
+      { "continuous", 0, 255 },
+      { "continuous", 0, 10000 },
+      { "20k distinct", 20000, 255 },
+      { "20k distinct", 20000, 10000 },
+      { "20k distinct", 20000, 19999 },
+   };
+
+   std::vector<FloatEbmType> continuous(k_cSamples);
+   FillValues(ValueDistribution::Uniform, 42, k_cSamples, &continuous[0]);
+   std::vector<FloatEbmType> distinct(k_cSamples);
+   std::mt19937_64 generator(42);
+   std::uniform_int_distribution<int> distinctValues(0, 19999);
+   for(FloatEbmType & val : distinct) {
+      val = static_cast<FloatEbmType>(distinctValues(generator));
+   }
+
+   printf("%zu samples\n", k_cSamples);
+   printf("%-14s %8s %11s %8s\n", "values", "max cuts", "time", "cuts");
+   for(const CutPlacementScenario & scenario : k_aScenarios) {
+      const std::vector<FloatEbmType> & values = 0 == scenario.m_cDistinct ? continuous : distinct;
+      std::vector<FloatEbmType> cuts;
+      bool bError = false;
+      const double ns = MeasureBestNanoseconds([]() {}, [&]() {
+         bError = bError || GenerateCuts(values, EBM_FALSE, scenario.m_cCutsMax, cuts);
+      });
+      if(bError) {
+         printf("%s failed\n", scenario.m_name);
+         continue;
+      }
+      DoNotOptimizeAway(cuts.empty() ? FloatEbmType { 0 } : cuts[0]);
+      printf("%-14s %8d %8.2f ms %8zu\n", scenario.m_name, static_cast<int>(scenario.m_cCutsMax), ns / 1000000.0, cuts.size());
+   }
+}
+
+// GenerateQuantileCutsResolutions against one GenerateQuantileCuts call per resolution.  The separate calls copy and sort the feature
+// once per resolution, so the single call should cost about as much as the most expensive resolution no matter how many we ask for
+BENCHMARK_CASE("QuantileCuts, several resolutions from one sort") {
+   constexpr size_t k_cSamples = size_t { 1 } << 20;
+   static const IntEbmType k_acCutsMax[] = { 255, 127, 63, 31 };
+   static const size_t k_acResolutions[] = { 1, 2, 4 };
+
+   std::vector<FloatEbmType> values(k_cSamples);
+   std::mt19937_64 generator(42);
+   std::normal_distribution<FloatEbmType> normal(FloatEbmType { 0 }, FloatEbmType { 1 });
+   for(FloatEbmType & val : values) {
+      val = normal(generator);
+   }
+
+   printf("%zu normal values, humanized\n", k_cSamples);
+   printf("%11s %14s %11s %8s %5s\n", "resolutions", "separate calls", "one call", "speedup", "same");
+   for(const size_t cResolutions : k_acResolutions) {
+      std::vector<std::vector<FloatEbmType>> cutsSeparate(cResolutions);
+      bool bError = false;
+      const double nsSeparate = MeasureBestNanoseconds([]() {}, [&]() {
+         for(size_t iResolution = 0; iResolution < cResolutions; ++iResolution) {
+            bError = bError || GenerateCuts(values, EBM_TRUE, k_acCutsMax[iResolution], cutsSeparate[iResolution]);
+         }
+      });
+
+      // resolution i writes its cuts after the space requested by the resolutions before it
+      std::vector<IntEbmType> countCuts(cResolutions);
+      size_t cCutsTotal = 0;
+      for(size_t iResolution = 0; iResolution < cResolutions; ++iResolution) {
+         cCutsTotal += static_cast<size_t>(k_acCutsMax[iResolution]);
+      }
+      std::vector<FloatEbmType> cuts(cCutsTotal);
+      IntEbmType countMissing;
+      FloatEbmType minValue;
+      IntEbmType countNegativeInfinity;
+      FloatEbmType maxValue;
+      IntEbmType countPositiveInfinity;
+      const double nsOne = MeasureBestNanoseconds([&]() {
+         for(size_t iResolution = 0; iResolution < cResolutions; ++iResolution) {
+            countCuts[iResolution] = k_acCutsMax[iResolution];
+         }
+      }, [&]() {
+         bError = bError || 0 != GenerateQuantileCutsResolutions(
+            static_cast<IntEbmType>(k_cSamples),
+            &values[0],
+            1,
+            EBM_TRUE,
+            static_cast<IntEbmType>(cResolutions),
+            &countCuts[0],
+            &cuts[0],
+            &countMissing,
+            &minValue,
+            &countNegativeInfinity,
+            &maxValue,
+            &countPositiveInfinity
+         );
+      });
+      if(bError) {
+         printf("%zu resolutions failed\n", cResolutions);
+         continue;
+      }
+      DoNotOptimizeAway(cuts[0]);
+
+      bool bSame = true;
+      size_t iCutsStart = 0;
+      for(size_t iResolution = 0; iResolution < cResolutions; ++iResolution) {
+         const std::vector<FloatEbmType> cutsOne(cuts.begin() + iCutsStart,
+            cuts.begin() + iCutsStart + static_cast<size_t>(countCuts[iResolution]));
+         bSame = bSame && cutsOne == cutsSeparate[iResolution];
+         iCutsStart += static_cast<size_t>(k_acCutsMax[iResolution]);
+      }
+      printf("%11zu %11.2f ms %8.2f ms %8.2f %5s\n", cResolutions, nsSeparate / 1000000.0, nsOne / 1000000.0, nsSeparate / nsOne,
+         bSame ? "yes" : "NO");
+   }
+}
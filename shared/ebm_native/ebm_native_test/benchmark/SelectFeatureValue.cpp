@@ -0,0 +1,150 @@
+// Copyright (c) 2018 Microsoft Corporation
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+
+#include "ebm_native.h"
+#include "EbmNativeBenchmark.h"
+
+// from InterpretableNumerics.cpp
+extern void SortFeatureValues(
+   const size_t cSamples,
+   FloatEbmType * const aValues,
+   FloatEbmType * const aScratch
+) noexcept;
+extern FloatEbmType SelectFeatureValue(
+   const size_t cSamples,
+   FloatEbmType * const aValues,
+   const size_t iNth,
+   FloatEbmType * const aScratch
+) noexcept;
+extern FloatEbmType RadixSelectFeatureValue(
+   const size_t cSamples,
+   const FloatEbmType * const aValues,
+   size_t iNth,
+   FloatEbmType * const aScratch
+) noexcept;
+
+constexpr size_t k_cValuesPerMeasurement = size_t { 1 } << 20;
+
+// GenerateWinsorizedCuts used to sort the whole feature and read the positions it needs from the sorted values.  Now it selects the center
+// value when it makes 1 cut, or the two outer bound values when it makes more.  Both then find the distinct values next to those positions,
+// which costs about the same either way and isn't timed here.  Small features finish too fast to time one at a time, so every measurement
+// covers k_cValuesPerMeasurement values split into as many features as it takes.  We report nanoseconds per value
+BENCHMARK_CASE("SelectFeatureValue, sorting vs selecting the winsorized positions") {
+   static const size_t k_acSamples[] = { 256, 1024, 2048, 4096, 16384, 131072, 1048576 };
+
+   FloatEbmType * const aOriginal = new FloatEbmType[k_cValuesPerMeasurement];
+   FloatEbmType * const aValues = new FloatEbmType[k_cValuesPerMeasurement];
+   FloatEbmType * const aScratch = new FloatEbmType[k_cValuesPerMeasurement];
+
+   printf("%-14s %9s %12s %12s %12s\n", "distribution", "samples", "sort", "1 cut", "many cuts");
+   for(const ValueDistribution distribution : k_aValueDistributions) {
+      FillValues(distribution, 42, k_cValuesPerMeasurement, aOriginal);
+      for(const size_t cSamples : k_acSamples) {
+         const size_t cFeatures = k_cValuesPerMeasurement / cSamples;
+         const size_t cValues = cFeatures * cSamples;
+         const size_t iCenter = cSamples / 2;
+         // with 255 cuts the outer bounds are 1/256 of the way in from each end
+         const size_t iLowOuter = (cSamples - size_t { 1 }) / 256;
+         const size_t iHighOuter = cSamples - size_t { 1 } - iLowOuter;
+         auto prepare = [&]() {
+            memcpy(aValues, aOriginal, sizeof(*aValues) * cValues);
+         };
+
+         FloatEbmType sumSort = 0;
+         const double nsSort = MeasureBestNanoseconds(prepare, [&]() {
+            for(size_t iFeature = 0; iFeature < cFeatures; ++iFeature) {
+               FloatEbmType * const aFeature = &aValues[iFeature * cSamples];
+               SortFeatureValues(cSamples, aFeature, aScratch);
+               sumSort += aFeature[iCenter] + aFeature[iLowOuter] + aFeature[iHighOuter];
+            }
+         });
+
+         FloatEbmType sumCenter = 0;
+         const double nsCenter = MeasureBestNanoseconds(prepare, [&]() {
+            for(size_t iFeature = 0; iFeature < cFeatures; ++iFeature) {
+               sumCenter += SelectFeatureValue(cSamples, &aValues[iFeature * cSamples], iCenter, aScratch);
+            }
+         });
+
+         FloatEbmType sumOuter = 0;
+         const double nsOuter = MeasureBestNanoseconds(prepare, [&]() {
+            for(size_t iFeature = 0; iFeature < cFeatures; ++iFeature) {
+               FloatEbmType * const aFeature = &aValues[iFeature * cSamples];
+               const FloatEbmType lowOuter = SelectFeatureValue(cSamples, aFeature, iLowOuter, aScratch);
+               const FloatEbmType highOuter = SelectFeatureValue(cSamples, aFeature, iHighOuter, aScratch);
+               sumOuter += lowOuter + highOuter;
+            }
+         });
+         DoNotOptimizeAway(sumSort + sumCenter + sumOuter);
+
+         printf("%-14s %9zu %9.2f ns %9.2f ns %9.2f ns\n",
+            GetValueDistributionName(distribution),
+            cSamples,
+            nsSort / static_cast<double>(cValues),
+            nsCenter / static_cast<double>(cValues),
+            nsOuter / static_cast<double>(cValues)
+         );
+      }
+   }
+
+   delete[] aScratch;
+   delete[] aValues;
+   delete[] aOriginal;
+}
+
+// std::nth_element against our radix select around k_cSamplesRadixSelectMin, selecting the center value
+BENCHMARK_CASE("SelectFeatureValue, std::nth_element vs radix select") {
+   static const size_t k_acSamples[] = { 64, 128, 256, 512, 1024, 2048, 4096, 16384, 65536 };
+
+   FloatEbmType * const aOriginal = new FloatEbmType[k_cValuesPerMeasurement];
+   FloatEbmType * const aValues = new FloatEbmType[k_cValuesPerMeasurement];
+   FloatEbmType * const aScratch = new FloatEbmType[k_cValuesPerMeasurement];
+
+   printf("%-14s %9s %12s %12s %8s\n", "distribution", "samples", "nth_element", "radix", "ratio");
+   for(const ValueDistribution distribution : k_aValueDistributions) {
+      FillValues(distribution, 42, k_cValuesPerMeasurement, aOriginal);
+      for(const size_t cSamples : k_acSamples) {
+         const size_t cFeatures = k_cValuesPerMeasurement / cSamples;
+         const size_t cValues = cFeatures * cSamples;
+         const size_t iCenter = cSamples / 2;
+         auto prepare = [&]() {
+            memcpy(aValues, aOriginal, sizeof(*aValues) * cValues);
+         };
+
+         FloatEbmType sumNth = 0;
+         const double nsNth = MeasureBestNanoseconds(prepare, [&]() {
+            for(size_t iFeature = 0; iFeature < cFeatures; ++iFeature) {
+               FloatEbmType * const aFeature = &aValues[iFeature * cSamples];
+               std::nth_element(aFeature, aFeature + iCenter, aFeature + cSamples);
+               sumNth += aFeature[iCenter];
+            }
+         });
+
+         FloatEbmType sumRadix = 0;
+         const double nsRadix = MeasureBestNanoseconds(prepare, [&]() {
+            for(size_t iFeature = 0; iFeature < cFeatures; ++iFeature) {
+               sumRadix += RadixSelectFeatureValue(cSamples, &aValues[iFeature * cSamples], iCenter, aScratch);
+            }
+         });
+         DoNotOptimizeAway(sumNth + sumRadix);
+
+         printf("%-14s %9zu %9.2f ns %9.2f ns %8.2f%s\n",
+            GetValueDistributionName(distribution),
+            cSamples,
+            nsNth / static_cast<double>(cValues),
+            nsRadix / static_cast<double>(cValues),
+            nsNth / nsRadix,
+            sumNth == sumRadix ? "" : "  WRONG"
+         );
+      }
+   }
+
+   delete[] aScratch;
+   delete[] aValues;
+   delete[] aOriginal;
+}
@@ -0,0 +1,70 @@
+// Copyright (c) 2018 Microsoft Corporation
+// Licensed under the MIT license.
+// Author: Paul Koch <code@koch.ninja>
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+
+#include "ebm_native.h"
+#include "EbmNativeBenchmark.h"
+
+// from InterpretableNumerics.cpp
+extern void RadixSortFeatureValues(
+   const size_t cSamples,
+   FloatEbmType * const aValues,
+   FloatEbmType * const aScratch
+) noexcept;
+
+// std::sort against our radix sort from below k_cSamplesRadixSortMin up to the tens of millions of samples that large datasets bin.  Small
+// sorts finish too fast to time one at a time, so every measurement sorts enough separate arrays to cover k_cValuesPerMeasurement values.
+// Above that we sort a single array, which no longer fits in any cache.  We report nanoseconds per value
+BENCHMARK_CASE("SortFeatureValues, std::sort vs radix sort") {
+   constexpr size_t k_cValuesPerMeasurement = size_t { 1 } << 20;
+   constexpr size_t k_cSamplesMax = size_t { 1 } << 24;
+   static const size_t k_acSamples[] = { 16, 32, 64, 96, 128, 192, 256, 512, 1024, 2048, 4096, 16384, 65536, 262144, 1048576, 
+      4194304, k_cSamplesMax };
+
+   FloatEbmType * const aOriginal = new FloatEbmType[k_cSamplesMax];
+   FloatEbmType * const aValues = new FloatEbmType[k_cSamplesMax];
+   FloatEbmType * const aScratch = new FloatEbmType[k_cSamplesMax];
+
+   printf("%-14s %9s %12s %12s %8s\n", "distribution", "samples", "std::sort", "radix", "ratio");
+   for(const ValueDistribution distribution : k_aValueDistributions) {
+      FillValues(distribution, 42, k_cSamplesMax, aOriginal);
+      for(const size_t cSamples : k_acSamples) {
+         const size_t cArrays = cSamples < k_cValuesPerMeasurement ? k_cValuesPerMeasurement / cSamples : size_t { 1 };
+         const size_t cValues = cArrays * cSamples;
+         auto prepare = [&]() {
+            memcpy(aValues, aOriginal, sizeof(*aValues) * cValues);
+         };
+
+         const double stdSort = MeasureBestNanoseconds(prepare, [&]() {
+            for(size_t iArray = 0; iArray < cArrays; ++iArray) {
+               FloatEbmType * const aArray = &aValues[iArray * cSamples];
+               std::sort(aArray, aArray + cSamples);
+            }
+         });
+         DoNotOptimizeAway(aValues[cValues - 1]);
+
+         const double radixSort = MeasureBestNanoseconds(prepare, [&]() {
+            for(size_t iArray = 0; iArray < cArrays; ++iArray) {
+               RadixSortFeatureValues(cSamples, &aValues[iArray * cSamples], aScratch);
+            }
+         });
+         DoNotOptimizeAway(aValues[cValues - 1]);
+
+         printf("%-14s %9zu %9.2f ns %9.2f ns %8.2f\n",
+            GetValueDistributionName(distribution),
+            cSamples,
+            stdSort / static_cast<double>(cValues),
+            radixSort / static_cast<double>(cValues),
+            stdSort / radixSort
+         );
+      }
+   }
+
+   delete[] aScratch;
+   delete[] aValues;
+   delete[] aOriginal;
+}
@@ -0,0 +1,65 @@
+#!/bin/sh
+
+# Builds and runs our benchmarks.  Any arguments are passed to the benchmark, so "ebm_native_benchmark.sh SortFeatureValues" runs just the
+# benchmarks whose description contains "SortFeatureValues".  The benchmarks are compiled together with the library sources, with the same
+# optimization flags as our release build, so that they can call internal functions directly
+
+clang_pp_bin=clang++
+g_pp_bin=g++
+os_type=`uname`
+script_path=`dirname "$0"`
+root_path="$script_path/../../../.."
+src_path="$script_path"
+lib_path="$root_path/shared/ebm_native"
+bin_path="$root_path/tmp/benchmark"
+bin_file="ebm_native_benchmark"
+
+compile_all=""
+compile_all="$compile_all \"$src_path/EbmNativeBenchmark.cpp\""
+
+compile_all="$compile_all \"$src_path/BoostingPairs.cpp\""
+compile_all="$compile_all \"$src_path/Discretize.cpp\""
+compile_all="$compile_all \"$src_path/InteractionPruning.cpp\""
+compile_all="$compile_all \"$src_path/InteractionSampling.cpp\""
+compile_all="$compile_all \"$src_path/QuantileCuts.cpp\""
+compile_all="$compile_all \"$src_path/SelectFeatureValue.cpp\""
+compile_all="$compile_all \"$src_path/SortFeatureValues.cpp\""
+
+# take the library sources from build.sh so that we don't have another list to keep up to date
+for lib_file in `grep -o 'src_path/[A-Za-z]*\.cpp' "$root_path/build.sh" | sed 's#src_path/##'`; do
+   compile_all="$compile_all \"$lib_path/$lib_file\""
+done
+
+compile_all="$compile_all -I\"$src_path\""
+compile_all="$compile_all -I\"$lib_path\""
+compile_all="$compile_all -I\"$lib_path/inc\""
+compile_all="$compile_all -std=c++11"
+compile_all="$compile_all -fno-math-errno -fno-trapping-math"
+compile_all="$compile_all -march=core2"
+compile_all="$compile_all -pthread"
+compile_all="$compile_all -m64 -DNDEBUG -O3"
+
+if [ "$os_type" = "Darwin" ]; then
+   compile_command="$clang_pp_bin $compile_all -o \"$bin_path/$bin_file\" 2>&1"
+elif [ "$os_type" = "Linux" ]; then
+   compile_command="$g_pp_bin $compile_all -o \"$bin_path/$bin_file\" 2>&1"
+else
+   echo "OS $os_type not recognized.  We support clang/clang++ on macOS and gcc/g++ on Linux"
+   exit 1
+fi
+
+echo "Compiling $bin_file"
+[ -d "$bin_path" ] || mkdir -p "$bin_path"
+ret_code=$?
+if [ $ret_code -ne 0 ]; then
+   exit $ret_code
+fi
+compile_out=`eval $compile_command`
+ret_code=$?
+echo -n "$compile_out"
+if [ $ret_code -ne 0 ]; then
+   exit $ret_code
+fi
+
+"$bin_path/$bin_file" "$@"
+exit $?
@@ -31,13 +31,16 @@ compile_all="$compile_all \"$src_path/EbmNativeTest.cpp\""
 
 compile_all="$compile_all \"$src_path/BitPackingExtremes.cpp\""
 compile_all="$compile_all \"$src_path/BoostingUnusualInputs.cpp\""
+compile_all="$compile_all \"$src_path/CategoricalEncoder.cpp\""
 compile_all="$compile_all \"$src_path/Discretize.cpp\""
 compile_all="$compile_all \"$src_path/GenerateQuantileCuts.cpp\""
 compile_all="$compile_all \"$src_path/GenerateUniformCuts.cpp\""
 compile_all="$compile_all \"$src_path/GenerateWinsorizedCuts.cpp\""
+compile_all="$compile_all \"$src_path/GenerateCoarseCuts.cpp\""
 compile_all="$compile_all \"$src_path/InteractionUnusualInputs.cpp\""
 compile_all="$compile_all \"$src_path/RandomNumbers.cpp\""
 compile_all="$compile_all \"$src_path/Rehydration.cpp\""
+compile_all="$compile_all \"$src_path/StreamingBinning.cpp\""
 compile_all="$compile_all \"$src_path/SuggestGraphBounds.cpp\""
 compile_all="$compile_all -I\"$src_path\""
 compile_all="$compile_all -I\"$root_path/shared/ebm_native/inc\""
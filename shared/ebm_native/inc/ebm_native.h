@@ -15,10 +15,12 @@ extern "C" {
 #define EBM_BOOL_CAST(EBM_VAL) (static_cast<BoolEbmType>(EBM_VAL))
 #define EBM_TRACE_CAST(EBM_VAL) (static_cast<TraceEbmType>(EBM_VAL))
 #define EBM_GENERATE_UPDATE_OPTIONS_CAST(EBM_VAL) (static_cast<GenerateUpdateOptionsType>(EBM_VAL))
+#define EBM_CATEGORY_TYPE_CAST(EBM_VAL) (static_cast<CategoryTypeType>(EBM_VAL))
 #else // __cplusplus
 #define EBM_BOOL_CAST(EBM_VAL) ((BoolEbmType)(EBM_VAL))
 #define EBM_TRACE_CAST(EBM_VAL) ((TraceEbmType)(EBM_VAL))
 #define EBM_GENERATE_UPDATE_OPTIONS_CAST(EBM_VAL) ((GenerateUpdateOptionsType)(EBM_VAL))
+#define EBM_CATEGORY_TYPE_CAST(EBM_VAL) ((CategoryTypeType)(EBM_VAL))
 #endif // __cplusplus
 
 //#define EXPAND_BINARY_LOGITS
@@ -100,6 +102,30 @@ typedef struct _InteractionDetectorHandle {
    char unused;
 } * InteractionDetectorHandle;
 
+typedef struct _ThreadStateInteractionHandle {
+   // this struct exists to enforce that our caller doesn't mix handle types.
+   // In C/C++ languages the caller will get an error if they try to mix these pointer types.
+   char unused;
+} * ThreadStateInteractionHandle;
+
+typedef struct _QuantileSketchHandle {
+   // this struct exists to enforce that our caller doesn't mix handle types.
+   // In C/C++ languages the caller will get an error if they try to mix these pointer types.
+   char unused;
+} * QuantileSketchHandle;
+
+typedef struct _StreamingBinningHandle {
+   // this struct exists to enforce that our caller doesn't mix handle types.
+   // In C/C++ languages the caller will get an error if they try to mix these pointer types.
+   char unused;
+} * StreamingBinningHandle;
+
+typedef struct _CategoricalEncoderHandle {
+   // this struct exists to enforce that our caller doesn't mix handle types.
+   // In C/C++ languages the caller will get an error if they try to mix these pointer types.
+   char unused;
+} * CategoricalEncoderHandle;
+
 #ifndef PRId32
 // this should really be defined, but some compilers aren't compliant
 #define PRId32 "d"
@@ -135,6 +161,8 @@ typedef IntEbmType GenerateUpdateOptionsType;
 // technically printf hexidecimals are unsigned, so convert it first to unsigned before calling printf
 typedef UIntEbmType UGenerateUpdateOptionsType;
 #define UGenerateUpdateOptionsTypePrintf PRIx64
+typedef IntEbmType CategoryTypeType;
+#define CategoryTypeTypePrintf IntEbmTypePrintf
 
 #define EBM_FALSE          (EBM_BOOL_CAST(0))
 #define EBM_TRUE           (EBM_BOOL_CAST(1))
@@ -145,6 +173,14 @@ typedef UIntEbmType UGenerateUpdateOptionsType;
 #define GenerateUpdateOptions_GradientSums         (EBM_GENERATE_UPDATE_OPTIONS_CAST(0x0000000000000004))
 #define GenerateUpdateOptions_RandomSplits         (EBM_GENERATE_UPDATE_OPTIONS_CAST(0x0000000000000008))
 
+// each category is an 8 byte signed integer
+#define CategoryType_Int64         (EBM_CATEGORY_TYPE_CAST(0))
+// each category is an 8 byte double.  -0.0 matches 0.0 and all NaN values match eachother
+#define CategoryType_Float64       (EBM_CATEGORY_TYPE_CAST(1))
+// each category is a fixed width string of bytes padded with zero bytes, like numpy's "S" and "U" arrays.  Trailing
+// zero bytes are ignored, so arrays of different widths can be compared
+#define CategoryType_Bytes         (EBM_CATEGORY_TYPE_CAST(2))
+
  // no messages will be output
 #define TraceLevelOff      (EBM_TRACE_CAST(0))
 // invalid inputs to the C library or assert failure before exit
@@ -346,6 +382,63 @@ EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION Genera
    FloatEbmType * maxNonInfinityValueOut,
    IntEbmType * countPositiveInfinityOut
 );
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION GenerateQuantileCutsResolutions(
+   IntEbmType countSamples,
+   const FloatEbmType * featureValues,
+   IntEbmType countSamplesPerBinMin,
+   BoolEbmType isHumanized,
+   IntEbmType countResolutions,
+   IntEbmType * countCutsInOut,
+   FloatEbmType * cutsLowerBoundInclusiveOut,
+   IntEbmType * countMissingValuesOut,
+   FloatEbmType * minNonInfinityValueOut,
+   IntEbmType * countNegativeInfinityOut,
+   FloatEbmType * maxNonInfinityValueOut,
+   IntEbmType * countPositiveInfinityOut
+);
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION GenerateQuantileCutsBatch(
+   IntEbmType countSamples,
+   IntEbmType countFeatures,
+   const FloatEbmType * featureValues,
+   BoolEbmType isColumnMajor,
+   const IntEbmType * countSamplesPerBinMin,
+   BoolEbmType isHumanized,
+   IntEbmType * countCutsInOut,
+   FloatEbmType * cutsLowerBoundInclusiveOut,
+   IntEbmType * countMissingValuesOut,
+   FloatEbmType * minNonInfinityValueOut,
+   IntEbmType * countNegativeInfinityOut,
+   FloatEbmType * maxNonInfinityValueOut,
+   IntEbmType * countPositiveInfinityOut
+);
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE QuantileSketchHandle EBM_NATIVE_CALLING_CONVENTION CreateQuantileSketch(
+   SeedEbmType randomSeed,
+   IntEbmType countItemsPerLevelMax
+);
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION AddToQuantileSketch(
+   QuantileSketchHandle quantileSketchHandle,
+   IntEbmType countSamples,
+   const FloatEbmType * featureValues
+);
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION MergeQuantileSketch(
+   QuantileSketchHandle quantileSketchHandleInto,
+   QuantileSketchHandle quantileSketchHandleFrom
+);
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION GenerateQuantileCutsFromSketch(
+   QuantileSketchHandle quantileSketchHandle,
+   IntEbmType countSamplesPerBinMin,
+   BoolEbmType isHumanized,
+   IntEbmType * countCutsInOut,
+   FloatEbmType * cutsLowerBoundInclusiveOut,
+   IntEbmType * countMissingValuesOut,
+   FloatEbmType * minNonInfinityValueOut,
+   IntEbmType * countNegativeInfinityOut,
+   FloatEbmType * maxNonInfinityValueOut,
+   IntEbmType * countPositiveInfinityOut
+);
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE void EBM_NATIVE_CALLING_CONVENTION FreeQuantileSketch(
+   QuantileSketchHandle quantileSketchHandle
+);
 EBM_NATIVE_IMPORT_EXPORT_INCLUDE void EBM_NATIVE_CALLING_CONVENTION GenerateUniformCuts(
    IntEbmType countSamples,
    const FloatEbmType * featureValues,
@@ -368,6 +461,65 @@ EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION Genera
    FloatEbmType * maxNonInfinityValueOut,
    IntEbmType * countPositiveInfinityOut
 );
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE StreamingBinningHandle EBM_NATIVE_CALLING_CONVENTION BeginStreamingBinning(
+   SeedEbmType randomSeed,
+   IntEbmType countFeatures,
+   IntEbmType countItemsPerLevelMax
+);
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION AddStreamingBinningChunk(
+   StreamingBinningHandle streamingBinningHandle,
+   IntEbmType countSamples,
+   const FloatEbmType * featureValues,
+   BoolEbmType isColumnMajor
+);
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION FinishStreamingQuantileCuts(
+   StreamingBinningHandle streamingBinningHandle,
+   IntEbmType indexFeature,
+   IntEbmType countSamplesPerBinMin,
+   BoolEbmType isHumanized,
+   IntEbmType * countCutsInOut,
+   FloatEbmType * cutsLowerBoundInclusiveOut,
+   IntEbmType * countMissingValuesOut,
+   FloatEbmType * minNonInfinityValueOut,
+   IntEbmType * countNegativeInfinityOut,
+   FloatEbmType * maxNonInfinityValueOut,
+   IntEbmType * countPositiveInfinityOut
+);
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION FinishStreamingUniformCuts(
+   StreamingBinningHandle streamingBinningHandle,
+   IntEbmType indexFeature,
+   IntEbmType * countCutsInOut,
+   FloatEbmType * cutsLowerBoundInclusiveOut,
+   IntEbmType * countMissingValuesOut,
+   FloatEbmType * minNonInfinityValueOut,
+   IntEbmType * countNegativeInfinityOut,
+   FloatEbmType * maxNonInfinityValueOut,
+   IntEbmType * countPositiveInfinityOut
+);
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION FinishStreamingWinsorizedCuts(
+   StreamingBinningHandle streamingBinningHandle,
+   IntEbmType indexFeature,
+   IntEbmType * countCutsInOut,
+   FloatEbmType * cutsLowerBoundInclusiveOut,
+   IntEbmType * countMissingValuesOut,
+   FloatEbmType * minNonInfinityValueOut,
+   IntEbmType * countNegativeInfinityOut,
+   FloatEbmType * maxNonInfinityValueOut,
+   IntEbmType * countPositiveInfinityOut
+);
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE void EBM_NATIVE_CALLING_CONVENTION FreeStreamingBinning(
+   StreamingBinningHandle streamingBinningHandle
+);
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION GenerateCoarseCuts(
+   IntEbmType countSamples,
+   const IntEbmType * discretized,
+   IntEbmType countCuts,
+   const FloatEbmType * cutsLowerBoundInclusive,
+   IntEbmType countSamplesPerBinMin,
+   IntEbmType * countCoarseCutsInOut,
+   FloatEbmType * coarseCutsLowerBoundInclusiveOut,
+   IntEbmType * coarseDiscretizedOut
+);
 
 EBM_NATIVE_IMPORT_EXPORT_INCLUDE void EBM_NATIVE_CALLING_CONVENTION SuggestGraphBounds(
    IntEbmType countCuts,
@@ -386,6 +538,35 @@ EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION Discre
    const FloatEbmType * cutsLowerBoundInclusive,
    IntEbmType * discretizedOut
 );
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION DiscretizeMatrix(
+   IntEbmType countSamples,
+   IntEbmType countFeatures,
+   const FloatEbmType * featureValues,
+   BoolEbmType isColumnMajor,
+   const IntEbmType * countCutsPerFeature,
+   const FloatEbmType * cutsLowerBoundInclusive,
+   IntEbmType countBytesPerBinIndex,
+   void * discretizedOut
+);
+
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE CategoricalEncoderHandle EBM_NATIVE_CALLING_CONVENTION CreateCategoricalEncoder(
+   CategoryTypeType categoryType,
+   IntEbmType countBytesPerCategory,
+   IntEbmType countCategories,
+   const void * categories,
+   const IntEbmType * binIndexes
+);
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION EncodeCategories(
+   CategoricalEncoderHandle categoricalEncoderHandle,
+   IntEbmType countSamples,
+   IntEbmType countBytesPerValue,
+   const void * values,
+   IntEbmType unknownBinIndex,
+   IntEbmType * binIndexesOut
+);
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE void EBM_NATIVE_CALLING_CONVENTION FreeCategoricalEncoder(
+   CategoricalEncoderHandle categoricalEncoderHandle
+);
 
 EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION Softmax(
    IntEbmType countTargetClasses,
@@ -482,6 +663,24 @@ EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION GetCur
    IntEbmType indexFeatureGroup,
    FloatEbmType * modelFeatureGroupTensorOut
 );
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION SetCoarseBinSchedule(
+   BoosterHandle boosterHandle,
+   IntEbmType countRoundsCoarse,
+   IntEbmType countBinsCoarseMax
+);
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION SetFeatureGroupSchedule(
+   BoosterHandle boosterHandle,
+   FloatEbmType gainThreshold,
+   IntEbmType countRoundsSkipMax
+);
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION GetScheduledFeatureGroups(
+   BoosterHandle boosterHandle,
+   IntEbmType * countFeatureGroupsOut,
+   IntEbmType * featureGroupIndexesOut
+);
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION AdvanceFeatureGroupSchedule(
+   BoosterHandle boosterHandle
+);
 EBM_NATIVE_IMPORT_EXPORT_INCLUDE void EBM_NATIVE_CALLING_CONVENTION FreeBooster(
    BoosterHandle boosterHandle
 );
@@ -517,6 +716,15 @@ EBM_NATIVE_IMPORT_EXPORT_INCLUDE InteractionDetectorHandle EBM_NATIVE_CALLING_CO
    const FloatEbmType * predictorScores,
    const FloatEbmType * optionalTempParams
 );
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE InteractionDetectorHandle EBM_NATIVE_CALLING_CONVENTION CreateInteractionDetectorFromBooster(
+   BoosterHandle boosterHandle,
+   BoolEbmType useBestModel,
+   IntEbmType countFeatures,
+   const BoolEbmType * featuresCategorical,
+   const IntEbmType * featuresBinCount,
+   const IntEbmType * binnedData,
+   const FloatEbmType * optionalTempParams
+);
 EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION CalculateInteractionScore(
    InteractionDetectorHandle interactionDetectorHandle, 
    IntEbmType countFeaturesInGroup,
@@ -524,10 +732,75 @@ EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION Calcul
    IntEbmType countSamplesRequiredForChildSplitMin,
    FloatEbmType * interactionScoreOut
 );
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION CalculateInteractionScoreThreadState(
+   ThreadStateInteractionHandle threadStateInteractionHandle,
+   IntEbmType countFeaturesInGroup,
+   const IntEbmType * featureIndexes,
+   IntEbmType countSamplesRequiredForChildSplitMin,
+   FloatEbmType * interactionScoreOut
+);
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION CalculateInteractionScores(
+   InteractionDetectorHandle interactionDetectorHandle,
+   IntEbmType countFeatureGroups,
+   IntEbmType countFeaturesInGroup,
+   const IntEbmType * featureIndexes,
+   IntEbmType countSamplesRequiredForChildSplitMin,
+   IntEbmType countFeatureGroupsTop,
+   FloatEbmType * interactionScoresOut,
+   IntEbmType * featureGroupIndexesOut
+);
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION CalculateInteractionScoresApproximate(
+   InteractionDetectorHandle interactionDetectorHandle,
+   IntEbmType countFeatureGroups,
+   IntEbmType countFeaturesInGroup,
+   const IntEbmType * featureIndexes,
+   IntEbmType countSamplesRequiredForChildSplitMin,
+   SeedEbmType randomSeed,
+   IntEbmType countSamplesScreen,
+   IntEbmType countFeatureGroupsRefine,
+   IntEbmType countFeatureGroupsTop,
+   FloatEbmType * interactionScoresOut,
+   IntEbmType * featureGroupIndexesOut
+);
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION CalculateInteractionScoresPruned(
+   InteractionDetectorHandle interactionDetectorHandle,
+   IntEbmType countFeatureGroups,
+   IntEbmType countFeaturesInGroup,
+   const IntEbmType * featureIndexes,
+   IntEbmType countSamplesRequiredForChildSplitMin,
+   IntEbmType countFeatureGroupsTop,
+   FloatEbmType * interactionScoresOut,
+   IntEbmType * featureGroupIndexesOut,
+   IntEbmType * countFeatureGroupsSkippedOut,
+   IntEbmType * countFeatureGroupsPrunedOut
+);
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION CalculateInteractionScoresTriples(
+   InteractionDetectorHandle interactionDetectorHandle,
+   IntEbmType countPairs,
+   const IntEbmType * pairFeatureIndexes,
+   IntEbmType countSamplesRequiredForChildSplitMin,
+   IntEbmType countTriplesTop,
+   FloatEbmType * interactionScoresOut,
+   IntEbmType * tripleFeatureIndexesOut,
+   IntEbmType * countTriplesOut
+);
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE IntEbmType EBM_NATIVE_CALLING_CONVENTION SetInteractionSampling(
+   InteractionDetectorHandle interactionDetectorHandle,
+   SeedEbmType randomSeed,
+   FloatEbmType sampleFraction,
+   BoolEbmType isBootstrap
+);
 EBM_NATIVE_IMPORT_EXPORT_INCLUDE void EBM_NATIVE_CALLING_CONVENTION FreeInteractionDetector(
    InteractionDetectorHandle interactionDetectorHandle
 );
 
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE ThreadStateInteractionHandle EBM_NATIVE_CALLING_CONVENTION CreateThreadStateInteraction(
+   InteractionDetectorHandle interactionDetectorHandle
+);
+EBM_NATIVE_IMPORT_EXPORT_INCLUDE void EBM_NATIVE_CALLING_CONVENTION FreeThreadStateInteraction(
+   ThreadStateInteractionHandle threadStateInteractionHandle
+);
+
 // TODO PK Implement the following for memory efficiency and speed of initialization :
 //   - NOTE: FOR RawArray ->  import multiprocessing ++ from multiprocessing import RawArray ++ RawArray(ct.c_ubyte, memory_size) ++ ct.POINTER(ct.c_ubyte)
 //   - OBSERVATION: passing in data one feature at a time is also nice since some languages (C# for instance) in some configurations don't like arrays 